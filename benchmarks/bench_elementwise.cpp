@@ -0,0 +1,52 @@
+// benchmarks/bench_elementwise.cpp
+//
+// Débit des noyaux binaires float32 pour chaque niveau SIMD disponible.
+// Usage : bench_elementwise [nombre d'éléments] [répétitions]
+
+#include "napcas/cpu.h"
+#include "napcas/kernels/elementwise_isa.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+using namespace napcas;
+using namespace napcas::kernels;
+
+int main(int argc, char** argv) {
+    const std::size_t n    = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : (1u << 20);
+    const int         reps = argc > 2 ? std::atoi(argv[2]) : 200;
+    const char* names[] = {"add", "sub", "mul", "div"};
+
+    std::vector<float> a(n, 1.5f), b(n, 0.75f), c(n);
+    std::printf("elements=%zu reps=%d detected=%s\n", n, reps,
+                cpu_capability_to_string(detected_cpu_capability()).c_str());
+    std::printf("%-8s %-4s %10s %10s\n", "isa", "op", "GB/s", "Gelem/s");
+
+    const CpuCapability levels[] = {
+        CpuCapability::Scalar, CpuCapability::SSE2,
+        CpuCapability::AVX2,   CpuCapability::AVX512
+    };
+    for (CpuCapability level : levels) {
+        if (level > detected_cpu_capability()) continue;
+        set_cpu_capability(level);
+        const auto& k = binary_kernels().f32;
+        for (int op = 0; op < 4; ++op) {
+            k.vv[op](c.data(), a.data(), b.data(), n);   // échauffement
+            double best = 1e30;
+            for (int r = 0; r < reps; ++r) {
+                auto t0 = std::chrono::steady_clock::now();
+                k.vv[op](c.data(), a.data(), b.data(), n);
+                auto t1 = std::chrono::steady_clock::now();
+                best = std::min(best, std::chrono::duration<double>(t1 - t0).count());
+            }
+            // deux lectures + une écriture par élément
+            const double bytes = 3.0 * double(n) * sizeof(float);
+            std::printf("%-8s %-4s %10.2f %10.2f\n",
+                        cpu_capability_to_string(level).c_str(), names[op],
+                        bytes / best * 1e-9, double(n) / best * 1e-9);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,723 @@
+// benchmarks/napcas_bench.cpp
+//
+// Suite Google Benchmark couvrant les chemins de Tensor (élément par
+// élément, réductions, matmul, manipulations de forme, copies, allocation,
+// surcoût par opération, backward), les couches Linear (float32 et int8),
+// la convolution, les optimiseurs et le chargeur de données.
+//
+// Chaque mesure rapporte GFLOP/s et GB/s (octets lus + écrits une fois),
+// et `roofline` : la fraction du plafond atteignable, min(crête de calcul,
+// intensité × bande passante), mesurés au démarrage (voir
+// measure_roofline) ou fixés par NAPCAS_PEAK_GFLOPS / NAPCAS_PEAK_GBS.
+//
+// Usage :
+//   napcas_bench --benchmark_filter=Matmul
+//   napcas_bench --benchmark_out=v1.json --benchmark_out_format=json
+// puis, pour comparer deux versions, tools/compare.py de Google Benchmark :
+//   compare.py benchmarks v1.json v2.json
+
+#include "napcas/allocator.h"
+#include "napcas/architecture/conv.h"
+#include "napcas/architecture/linear.h"
+#include "napcas/architecture/quantized_linear.h"
+#include "napcas/cpu.h"
+#include "napcas/data.h"
+#include "napcas/graph.h"
+#include "napcas/kernels/gemm.h"
+#include "napcas/kernels/qgemm.h"
+#include "napcas/optim.h"
+#include "napcas/parallel.h"
+#include "napcas/tensor.h"
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace napcas;
+using benchmark::Counter;
+using kernels::Activation;
+using kernels::ConvAlgorithm;
+
+namespace {
+
+struct Roofline {
+    double gflops = 0.0;   // crête de calcul float32
+    double gbs    = 0.0;   // bande passante mémoire
+};
+Roofline g_roof;
+
+template<typename Fn>
+double best_seconds(int reps, Fn&& fn) {
+    double best = 1e30;
+    for (int r = 0; r < reps; ++r) {
+        auto t0 = std::chrono::steady_clock::now();
+        fn();
+        auto t1 = std::chrono::steady_clock::now();
+        best = std::min(best, std::chrono::duration<double>(t1 - t0).count());
+    }
+    return best;
+}
+
+double env_or(const char* name, double fallback) {
+    const char* v = std::getenv(name);
+    return v ? std::strtod(v, nullptr) : fallback;
+}
+
+// Bande passante : copie parallèle de 128 Mo (hors caches) ; calcul : GEMM
+// float32 1024³ (crête atteignable par le micro-noyau, pas la crête
+// théorique du processeur)
+Roofline measure_roofline() {
+    Roofline r;
+    r.gbs = env_or("NAPCAS_PEAK_GBS", 0.0);
+    if (r.gbs <= 0.0) {
+        const std::size_t n = std::size_t(32) << 20;
+        std::vector<float> src(n, 1.0f), dst(n);
+        const double s = best_seconds(5, [&] {
+            parallel_for(0, n, grain_size(n, 2 * sizeof(float)), [&](std::size_t b, std::size_t e) {
+                std::copy(src.data() + b, src.data() + e, dst.data() + b);
+            });
+        });
+        r.gbs = 2.0 * double(n) * sizeof(float) / s * 1e-9;
+    }
+    r.gflops = env_or("NAPCAS_PEAK_GFLOPS", 0.0);
+    if (r.gflops <= 0.0) {
+        const std::size_t n = 1024;
+        std::vector<float> a(n * n, 1.0f), b(n * n, 1.0f), c(n * n);
+        const double s = best_seconds(3, [&] {
+            kernels::gemm(n, n, n, kernels::MatrixRef{a.data(), std::ptrdiff_t(n), 1},
+                          kernels::MatrixRef{b.data(), std::ptrdiff_t(n), 1},
+                          c.data(), std::ptrdiff_t(n));
+        });
+        r.gflops = 2.0 * double(n) * double(n) * double(n) / s * 1e-9;
+    }
+    return r;
+}
+
+// Compteurs d'une itération : `flops` opérations et `bytes` octets de trafic
+// minimal. Un compteur en taux sur le temps minimal du roofline donne la
+// fraction atteinte.
+void report(benchmark::State& st, double flops, double bytes) {
+    const double it = double(st.iterations());
+    if (flops > 0) st.counters["GFLOP/s"] = Counter(flops * it * 1e-9, Counter::kIsRate);
+    if (bytes > 0) st.counters["GB/s"]    = Counter(bytes * it * 1e-9, Counter::kIsRate);
+    const double t_min = std::max(flops / (g_roof.gflops * 1e9), bytes / (g_roof.gbs * 1e9));
+    if (t_min > 0) st.counters["roofline"] = Counter(t_min * it, Counter::kIsRate);
+}
+
+Tensor random(const std::vector<std::size_t>& shape, unsigned seed = 0,
+              DType dtype = DType::Float32) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> u(-1.0f, 1.0f);
+    std::size_t n = 1;
+    for (auto s : shape) n *= s;
+    std::vector<float> v(n);
+    for (auto& e : v) e = u(rng);
+    return Tensor(shape, v, dtype);
+}
+
+constexpr double f32 = sizeof(float);
+
+// ===================== Élément par élément =====================
+
+using BinaryFn = Tensor (Tensor::*)(const Tensor&) const;
+
+void BM_Binary(benchmark::State& st, BinaryFn op) {
+    const std::size_t n = std::size_t(st.range(0));
+    Tensor a = random({n}, 1), b = random({n}, 2);
+    for (auto _ : st) benchmark::DoNotOptimize((a.*op)(b));
+    report(st, double(n), 3 * n * f32);
+}
+BENCHMARK_CAPTURE(BM_Binary, add, &Tensor::operator+)
+    ->RangeMultiplier(16)->Range(1 << 10, 1 << 24)->UseRealTime();
+BENCHMARK_CAPTURE(BM_Binary, mul, &Tensor::operator*)
+    ->RangeMultiplier(16)->Range(1 << 10, 1 << 24)->UseRealTime();
+BENCHMARK_CAPTURE(BM_Binary, div, &Tensor::operator/)
+    ->RangeMultiplier(16)->Range(1 << 10, 1 << 24)->UseRealTime();
+
+// Sans allocation du résultat : le noyau seul
+void BM_AddOut(benchmark::State& st) {
+    const std::size_t n = std::size_t(st.range(0));
+    Tensor a = random({n}, 1), b = random({n}, 2), out({n});
+    for (auto _ : st) benchmark::DoNotOptimize(add_out(out, a, b));
+    report(st, double(n), 3 * n * f32);
+}
+BENCHMARK(BM_AddOut)->RangeMultiplier(16)->Range(1 << 10, 1 << 24)->UseRealTime();
+
+void BM_AddInPlace(benchmark::State& st) {
+    const std::size_t n = std::size_t(st.range(0));
+    Tensor a = random({n}, 1), b = random({n}, 2);
+    for (auto _ : st) benchmark::DoNotOptimize(a.add_(b));
+    report(st, double(n), 3 * n * f32);
+}
+BENCHMARK(BM_AddInPlace)->RangeMultiplier(16)->Range(1 << 10, 1 << 24)->UseRealTime();
+
+// [rows, cols] + [cols] : la ligne reste en cache
+void BM_BroadcastAdd(benchmark::State& st) {
+    const std::size_t rows = std::size_t(st.range(0)), cols = std::size_t(st.range(1));
+    Tensor a = random({rows, cols}, 1), b = random({cols}, 2);
+    for (auto _ : st) benchmark::DoNotOptimize(a + b);
+    report(st, double(rows * cols), (2 * rows * cols + cols) * f32);
+}
+BENCHMARK(BM_BroadcastAdd)
+    ->Args({4096, 1024})->Args({1024, 4096})->Args({65536, 16})->UseRealTime();
+
+void BM_TransposedAdd(benchmark::State& st) {
+    const std::size_t n = std::size_t(st.range(0));
+    Tensor a = random({n, n}, 1).transpose(0, 1), b = random({n, n}, 2);
+    for (auto _ : st) benchmark::DoNotOptimize(a + b);
+    report(st, double(n * n), 3 * n * n * f32);
+}
+BENCHMARK(BM_TransposedAdd)->Arg(256)->Arg(1024)->Arg(2048)->UseRealTime();
+
+using UnaryFn = Tensor (Tensor::*)() const;
+
+void BM_Unary(benchmark::State& st, UnaryFn op) {
+    const std::size_t n = std::size_t(st.range(0));
+    Tensor a = random({n}, 1);
+    for (auto _ : st) benchmark::DoNotOptimize((a.*op)());
+    report(st, double(n), 2 * n * f32);
+}
+BENCHMARK_CAPTURE(BM_Unary, exp,  &Tensor::exp )
+    ->RangeMultiplier(16)->Range(1 << 12, 1 << 24)->UseRealTime();
+BENCHMARK_CAPTURE(BM_Unary, relu, &Tensor::relu)
+    ->RangeMultiplier(16)->Range(1 << 12, 1 << 24)->UseRealTime();
+BENCHMARK_CAPTURE(BM_Unary, gelu, &Tensor::gelu)
+    ->RangeMultiplier(16)->Range(1 << 12, 1 << 24)->UseRealTime();
+BENCHMARK_CAPTURE(BM_Unary, silu, &Tensor::silu)
+    ->RangeMultiplier(16)->Range(1 << 12, 1 << 24)->UseRealTime();
+
+// ===================== Réductions et normalisations =====================
+
+void BM_Sum(benchmark::State& st) {
+    const std::size_t rows = std::size_t(st.range(0)), cols = std::size_t(st.range(1));
+    const std::vector<int> dims = st.range(2) < 0 ? std::vector<int>{}
+                                                  : std::vector<int>{int(st.range(2))};
+    Tensor a = random({rows, cols}, 1);
+    for (auto _ : st) benchmark::DoNotOptimize(a.sum(dims));
+    report(st, double(rows * cols), rows * cols * f32);
+}
+// Troisième argument : dimension réduite, -1 pour toutes
+BENCHMARK(BM_Sum)->Args({4096, 4096, -1})->Args({4096, 4096, 0})->Args({4096, 4096, 1})
+                 ->Args({65536, 16, 1})->UseRealTime();
+
+void BM_Softmax(benchmark::State& st) {
+    const std::size_t rows = std::size_t(st.range(0)), cols = std::size_t(st.range(1));
+    Tensor a = random({rows, cols}, 1);
+    for (auto _ : st) benchmark::DoNotOptimize(a.softmax());
+    report(st, 4.0 * double(rows * cols), 2 * rows * cols * f32);
+}
+BENCHMARK(BM_Softmax)->Args({4096, 1024})->Args({256, 32768})->UseRealTime();
+
+void BM_LayerNorm(benchmark::State& st) {
+    const std::size_t rows = std::size_t(st.range(0)), cols = std::size_t(st.range(1));
+    Tensor a = random({rows, cols}, 1), w = random({cols}, 2), b = random({cols}, 3);
+    for (auto _ : st) benchmark::DoNotOptimize(a.layer_norm(w, b));
+    report(st, 6.0 * double(rows * cols), 2 * rows * cols * f32);
+}
+BENCHMARK(BM_LayerNorm)->Args({4096, 1024})->Args({256, 8192})->UseRealTime();
+
+// ===================== matmul =====================
+
+void run_matmul(benchmark::State& st, const Tensor& a, const Tensor& b,
+                std::size_t batch, std::size_t m, std::size_t n, std::size_t k) {
+    for (auto _ : st) benchmark::DoNotOptimize(a.matmul(b));
+    report(st, 2.0 * double(batch * m * n * k), batch * (m * k + k * n + m * n) * f32);
+}
+
+void BM_MatmulSquare(benchmark::State& st) {
+    const std::size_t n = std::size_t(st.range(0));
+    run_matmul(st, random({n, n}, 1), random({n, n}, 2), 1, n, n, n);
+}
+BENCHMARK(BM_MatmulSquare)->RangeMultiplier(2)->Range(32, 2048)->UseRealTime();
+
+// (M, N, K) : vecteur-matrice, matrices plates, K profond
+void BM_MatmulShape(benchmark::State& st) {
+    const std::size_t m = std::size_t(st.range(0)), n = std::size_t(st.range(1)),
+                      k = std::size_t(st.range(2));
+    run_matmul(st, random({m, k}, 1), random({k, n}, 2), 1, m, n, k);
+}
+BENCHMARK(BM_MatmulShape)->Args({1, 4096, 4096})->Args({16, 4096, 4096})
+                         ->Args({4096, 64, 4096})->Args({4096, 4096, 64})
+                         ->Args({512, 512, 8192})->Args({127, 129, 131})->UseRealTime();
+
+// Opérande droit transposé, lu via ses strides
+void BM_MatmulTransposed(benchmark::State& st) {
+    const std::size_t n = std::size_t(st.range(0));
+    run_matmul(st, random({n, n}, 1), random({n, n}, 2).transpose(0, 1), 1, n, n, n);
+}
+BENCHMARK(BM_MatmulTransposed)->Arg(256)->Arg(1024)->UseRealTime();
+
+void BM_MatmulBatched(benchmark::State& st) {
+    const std::size_t batch = std::size_t(st.range(0)), n = std::size_t(st.range(1));
+    run_matmul(st, random({batch, n, n}, 1), random({batch, n, n}, 2), batch, n, n, n);
+}
+BENCHMARK(BM_MatmulBatched)->Args({64, 64})->Args({16, 256})->UseRealTime();
+
+void BM_MatmulF64(benchmark::State& st) {
+    const std::size_t n = std::size_t(st.range(0));
+    Tensor a = random({n, n}, 1, DType::Float64), b = random({n, n}, 2, DType::Float64);
+    for (auto _ : st) benchmark::DoNotOptimize(a.matmul(b));
+    report(st, 2.0 * double(n * n * n), 3 * n * n * sizeof(double));
+}
+BENCHMARK(BM_MatmulF64)->Arg(256)->Arg(1024)->UseRealTime();
+
+// ===================== Forme, copies, allocation =====================
+
+// Vues : coût des métadonnées seules (pas de trafic mémoire)
+void BM_ViewOps(benchmark::State& st) {
+    Tensor a = random({64, 32, 16}, 1);
+    for (auto _ : st) {
+        benchmark::DoNotOptimize(a.reshape({2048, 16}));
+        benchmark::DoNotOptimize(a.transpose(0, 2));
+        benchmark::DoNotOptimize(a.permute({1, 2, 0}));
+        benchmark::DoNotOptimize(a.unsqueeze(1).squeeze(1));
+        benchmark::DoNotOptimize(a.expand({4, 64, 32, 16}));
+    }
+}
+BENCHMARK(BM_ViewOps)->UseRealTime();
+
+void BM_Clone(benchmark::State& st) {
+    const std::size_t n = std::size_t(st.range(0));
+    Tensor a = random({n}, 1);
+    for (auto _ : st) benchmark::DoNotOptimize(a.clone());
+    report(st, 0.0, 2 * n * f32);
+}
+BENCHMARK(BM_Clone)->RangeMultiplier(16)->Range(1 << 10, 1 << 24)->UseRealTime();
+
+// contiguous() d'une vue transposée : copie par tuiles
+void BM_ContiguousTransposed(benchmark::State& st) {
+    const std::size_t n = std::size_t(st.range(0));
+    Tensor a = random({n, n}, 1).transpose(0, 1);
+    for (auto _ : st) benchmark::DoNotOptimize(a.contiguous());
+    report(st, 0.0, 2 * n * n * f32);
+}
+BENCHMARK(BM_ContiguousTransposed)->Arg(256)->Arg(1024)->Arg(4096)->UseRealTime();
+
+void BM_Astype(benchmark::State& st, DType to) {
+    const std::size_t n = std::size_t(st.range(0));
+    Tensor a = random({n}, 1);
+    for (auto _ : st) benchmark::DoNotOptimize(a.astype(to));
+    report(st, 0.0, n * (f32 + double(dtype_size(to))));
+}
+BENCHMARK_CAPTURE(BM_Astype, f16,  DType::Float16 )->Arg(1 << 16)->Arg(1 << 22)->UseRealTime();
+BENCHMARK_CAPTURE(BM_Astype, bf16, DType::BFloat16)->Arg(1 << 16)->Arg(1 << 22)->UseRealTime();
+BENCHMARK_CAPTURE(BM_Astype, f64,  DType::Float64 )->Arg(1 << 16)->Arg(1 << 22)->UseRealTime();
+
+// Allocation non initialisée : cache de l'allocateur ; taille en octets
+void BM_Allocate(benchmark::State& st) {
+    const std::size_t n = std::size_t(st.range(0)) / sizeof(float);
+    const AllocatorStats before = allocator_stats();
+    for (auto _ : st) benchmark::DoNotOptimize(Tensor({n}));
+    const AllocatorStats after = allocator_stats();
+    const std::size_t allocs = after.num_allocs - before.num_allocs;
+    st.counters["hit_rate"] = allocs ? double(after.cache_hits - before.cache_hits) / double(allocs)
+                                     : 0.0;
+}
+BENCHMARK(BM_Allocate)->RangeMultiplier(64)->Range(64, 64 << 20)->UseRealTime();
+
+void BM_Zeros(benchmark::State& st) {
+    const std::size_t n = std::size_t(st.range(0));
+    for (auto _ : st) benchmark::DoNotOptimize(Tensor::zeros({n}));
+    report(st, 0.0, n * f32);
+}
+BENCHMARK(BM_Zeros)->RangeMultiplier(16)->Range(1 << 10, 1 << 24)->UseRealTime();
+
+// ===================== Surcoût par opération =====================
+
+// Tenseurs minuscules : le temps mesuré est celui du dispatch, des
+// métadonnées (Shape / Strides) et de l'allocation, pas du calcul
+void BM_TinyOps(benchmark::State& st) {
+    Tensor a = random({2, 2}, 1), b = random({2, 2}, 2);
+    for (auto _ : st) {
+        benchmark::DoNotOptimize(a + b);
+        benchmark::DoNotOptimize(a.relu());
+        benchmark::DoNotOptimize(a.sum());
+        benchmark::DoNotOptimize(a.transpose(0, 1));
+    }
+    st.SetItemsProcessed(std::int64_t(st.iterations()) * 4);
+}
+BENCHMARK(BM_TinyOps)->UseRealTime();
+
+// Copie et déplacement d'un Tensor : métadonnées et compteurs de référence
+void BM_TensorCopy(benchmark::State& st) {
+    Tensor a = random({8, 4, 2}, 1);
+    for (auto _ : st) {
+        Tensor b = a;
+        Tensor c = std::move(b);
+        benchmark::DoNotOptimize(c);
+    }
+}
+BENCHMARK(BM_TensorCopy)->UseRealTime();
+
+// Requêtes de géométrie d'une vue non contiguë (mises en cache)
+void BM_GeometryQueries(benchmark::State& st) {
+    Tensor a = random({8, 4, 2}, 1).transpose(0, 2);
+    for (auto _ : st) {
+        benchmark::DoNotOptimize(a.is_contiguous());
+        benchmark::DoNotOptimize(a.numel());
+    }
+}
+BENCHMARK(BM_GeometryQueries)->UseRealTime();
+
+// Création de vues selon le rang ; au-delà de kInlineDims, les
+// métadonnées passent sur le tas
+void BM_ViewByRank(benchmark::State& st) {
+    const std::size_t rank = std::size_t(st.range(0));
+    Tensor a = random(std::vector<std::size_t>(rank, 2), 1);
+    Shape flat{a.numel()};
+    for (auto _ : st) {
+        benchmark::DoNotOptimize(a.transpose(0, 1));
+        benchmark::DoNotOptimize(a.view(flat));
+    }
+}
+BENCHMARK(BM_ViewByRank)->DenseRange(2, 10, 2)->UseRealTime();
+
+// ===================== Autograd =====================
+
+// Chaîne de `depth` couples (mul, relu) puis sum().backward() : forward,
+// construction du graphe et rétropropagation
+void BM_BackwardChain(benchmark::State& st) {
+    const std::size_t n = std::size_t(st.range(0));
+    const int depth = int(st.range(1));
+    Tensor x = random({n}, 1), c = random({n}, 2);
+    x.requires_grad_(true);
+    for (auto _ : st) {
+        Tensor y = x;
+        for (int i = 0; i < depth; ++i) y = (y * c).relu();
+        y.sum().backward();
+        x.zero_grad();
+    }
+    // forward : 3 passes par couple ; backward : environ le double
+    report(st, 6.0 * depth * double(n), 9.0 * depth * n * f32);
+}
+BENCHMARK(BM_BackwardChain)->Args({1 << 10, 32})->Args({1 << 20, 8})->UseRealTime();
+
+// Un tenseur lu par `width` branches : accumulation des gradients
+void BM_BackwardFanout(benchmark::State& st) {
+    const std::size_t n = std::size_t(st.range(0));
+    const int width = int(st.range(1));
+    Tensor x = random({n}, 1);
+    x.requires_grad_(true);
+    for (auto _ : st) {
+        Tensor y = x * x;
+        for (int i = 1; i < width; ++i) y = y + x * x;
+        y.sum().backward();
+        x.zero_grad();
+    }
+    report(st, 4.0 * width * double(n), 6.0 * width * n * f32);
+}
+BENCHMARK(BM_BackwardFanout)->Args({1 << 10, 16})->Args({1 << 20, 4})->UseRealTime();
+
+// ===================== Linear =====================
+
+// (batch, in, out, activation)
+void BM_LinearForward(benchmark::State& st) {
+    const std::size_t b = std::size_t(st.range(0)), in = std::size_t(st.range(1)),
+                      out = std::size_t(st.range(2));
+    architecture::Linear fc(int(in), int(out), true, DType::Float32,
+                            Device{DeviceType::CPU, 0}, Activation(st.range(3)));
+    Tensor x = random({b, in}, 1);
+    for (auto _ : st) benchmark::DoNotOptimize(fc(x));
+    report(st, 2.0 * double(b * in * out), (b * in + in * out + b * out) * f32);
+}
+BENCHMARK(BM_LinearForward)
+    ->Args({1, 4096, 4096, int(Activation::None)})
+    ->Args({64, 1024, 1024, int(Activation::ReLU)})
+    ->Args({256, 1024, 4096, int(Activation::GELU)})
+    ->Args({4096, 512, 512, int(Activation::SiLU)})
+    ->UseRealTime();
+
+// Forward + backward : dX, dW, db (trois GEMM)
+void BM_LinearBackward(benchmark::State& st) {
+    const std::size_t b = std::size_t(st.range(0)), in = std::size_t(st.range(1)),
+                      out = std::size_t(st.range(2));
+    architecture::Linear fc(int(in), int(out), true, DType::Float32,
+                            Device{DeviceType::CPU, 0}, Activation(st.range(3)));
+    Tensor x = random({b, in}, 1);
+    x.requires_grad_(true);
+    for (auto _ : st) {
+        fc(x).sum().backward();
+        x.zero_grad();
+        for (Tensor& p : fc.parameters()) p.zero_grad();
+    }
+    report(st, 6.0 * double(b * in * out), 3 * (b * in + in * out + b * out) * f32);
+}
+BENCHMARK(BM_LinearBackward)
+    ->Args({64, 1024, 1024, int(Activation::ReLU)})
+    ->Args({256, 1024, 4096, int(Activation::GELU)})
+    ->UseRealTime();
+
+// Pile de Linear : eager contre rejeu d'un graphe capturé (graph.h)
+class Stack : public Module {
+public:
+    Stack(int width, int depth) {
+        for (int i = 0; i < depth; ++i) {
+            layers_.push_back(std::make_shared<architecture::Linear>(
+                width, width, true, DType::Float32, Device{DeviceType::CPU, 0},
+                Activation::ReLU));
+            register_module("fc" + std::to_string(i), layers_.back());
+        }
+    }
+    Tensor forward(const Tensor& x) override {
+        Tensor h = x;
+        for (auto& l : layers_) h = (*l)(h);
+        return h;
+    }
+
+private:
+    std::vector<std::shared_ptr<architecture::Linear>> layers_;
+};
+
+void BM_LinearStack(benchmark::State& st) {
+    const std::size_t b = std::size_t(st.range(0)), w = std::size_t(st.range(1));
+    const int depth = 4;
+    Stack model(int(w), depth);
+    Tensor x = random({b, w}, 1);
+    if (st.range(2)) {
+        Graph g = Graph::capture(model, x);
+        for (auto _ : st) benchmark::DoNotOptimize(g.replay({x}));
+    } else {
+        for (auto _ : st) benchmark::DoNotOptimize(model(x));
+    }
+    report(st, 2.0 * depth * double(b * w * w), depth * (2 * b * w + w * w) * f32);
+}
+// Troisième argument : 1 pour le rejeu du graphe
+BENCHMARK(BM_LinearStack)->Args({8, 256, 0})->Args({8, 256, 1})
+                         ->Args({128, 1024, 0})->Args({128, 1024, 1})->UseRealTime();
+
+// ===================== Linear int8 =====================
+
+// (batch, in, out, int8) : x · Wᵀ par Tensor::matmul (float32, W transposé
+// lu via ses strides) contre QuantizedLinear (sans biais), sur le jeu
+// d'instructions de la capture. `rel_error` : ‖y_int8 - y_f32‖ / ‖y_f32‖.
+// Le roofline reste celui du float32 : le chemin int8 peut dépasser 1.
+void BM_LinearInt8(benchmark::State& st, CpuCapability cap) {
+    const CpuCapability saved = cpu_capability();
+    set_cpu_capability(cap);
+    const std::size_t b = std::size_t(st.range(0)), in = std::size_t(st.range(1)),
+                      out = std::size_t(st.range(2));
+    architecture::Linear fc(int(in), int(out), false);
+    const Tensor wt = fc.weight().detach().transpose(0, 1);
+    Tensor x = random({b, in}, 1);
+    if (st.range(3)) {
+        architecture::QuantizedLinear qfc(fc);
+        for (auto _ : st) benchmark::DoNotOptimize(qfc(x));
+        const Tensor yq = qfc(x), yf = x.matmul(wt);
+        double num = 0.0, den = 0.0;
+        for (std::size_t i = 0; i < yf.numel(); ++i) {
+            const double d = double(yq.data<float>()[i]) - yf.data<float>()[i];
+            num += d * d;
+            den += double(yf.data<float>()[i]) * yf.data<float>()[i];
+        }
+        st.counters["rel_error"] = std::sqrt(num / den);
+        st.SetLabel(kernels::qgemm_kernel_name());
+        report(st, 2.0 * double(b * in * out), (b * in + b * out) * f32 + in * out);
+    } else {
+        for (auto _ : st) benchmark::DoNotOptimize(x.matmul(wt));
+        report(st, 2.0 * double(b * in * out), (b * in + in * out + b * out) * f32);
+    }
+    set_cpu_capability(saved);
+}
+#define NAPCAS_INT8_SHAPES                                                    \
+    ->Args({1, 4096, 4096, 0})->Args({1, 4096, 4096, 1})                      \
+    ->Args({32, 1024, 1024, 0})->Args({32, 1024, 1024, 1})                    \
+    ->Args({256, 1024, 4096, 0})->Args({256, 1024, 4096, 1})                  \
+    ->UseRealTime()
+BENCHMARK_CAPTURE(BM_LinearInt8, native, cpu_capability())     NAPCAS_INT8_SHAPES;
+BENCHMARK_CAPTURE(BM_LinearInt8, avx2,   CpuCapability::AVX2)   NAPCAS_INT8_SHAPES;
+BENCHMARK_CAPTURE(BM_LinearInt8, scalar, CpuCapability::Scalar) NAPCAS_INT8_SHAPES;
+
+// ===================== Convolution =====================
+
+// Formes de ResNet-50 / MobileNet en channels-last :
+// (N, C, HW, K, RS, pas, groups). Les FLOP sont ceux de la convolution
+// directe pour tous les algorithmes (Winograd en effectue moins).
+void BM_Conv2d(benchmark::State& st, ConvAlgorithm algo) {
+    const std::size_t N = std::size_t(st.range(0)), C = std::size_t(st.range(1)),
+                      HW = std::size_t(st.range(2)), K = std::size_t(st.range(3)),
+                      RS = std::size_t(st.range(4)), stride = std::size_t(st.range(5)),
+                      groups = std::size_t(st.range(6));
+    const std::size_t pad = RS / 2, OHW = (HW + 2 * pad - RS) / stride + 1;
+    Tensor x = architecture::to_channels_last(random({N, C, HW, HW}, 1));
+    Tensor w = random({K, C / groups, RS, RS}, 2), b = random({K}, 3);
+    try {
+        benchmark::DoNotOptimize(architecture::conv2d(x, w, b, {stride, stride}, {pad, pad},
+                                                      {1, 1}, groups, algo));
+    } catch (const std::runtime_error&) {
+        st.SkipWithError("algorithm not supported for this shape");
+        return;
+    }
+    for (auto _ : st)
+        benchmark::DoNotOptimize(architecture::conv2d(x, w, b, {stride, stride}, {pad, pad},
+                                                      {1, 1}, groups, algo));
+    report(st, 2.0 * double(N * OHW * OHW * K * RS * RS * (C / groups)),
+           (N * HW * HW * C + K * RS * RS * (C / groups) + N * OHW * OHW * K) * f32);
+}
+#define NAPCAS_CONV_SHAPES                                                    \
+    ->Args({8, 3, 224, 64, 7, 2, 1})      /* stem 7x7/2 */                    \
+    ->Args({8, 64, 56, 64, 3, 1, 1})      /* conv2_x 3x3 */                   \
+    ->Args({8, 128, 28, 128, 3, 1, 1})    /* conv3_x 3x3 */                   \
+    ->Args({8, 256, 14, 256, 3, 1, 1})    /* conv4_x 3x3 */                   \
+    ->Args({8, 512, 7, 512, 3, 1, 1})     /* conv5_x 3x3 */                   \
+    ->Args({8, 256, 56, 64, 1, 1, 1})     /* bottleneck 1x1 */                \
+    ->Args({8, 128, 56, 128, 3, 2, 1})    /* 3x3/2 */                         \
+    ->Args({8, 144, 56, 144, 3, 1, 144})  /* depthwise 3x3 */                 \
+    ->Args({8, 16, 56, 16, 3, 1, 1})      /* 3x3, peu de canaux */            \
+    ->UseRealTime()
+BENCHMARK_CAPTURE(BM_Conv2d, auto,      ConvAlgorithm::Auto)      NAPCAS_CONV_SHAPES;
+BENCHMARK_CAPTURE(BM_Conv2d, im2col,    ConvAlgorithm::Im2col)    NAPCAS_CONV_SHAPES;
+BENCHMARK_CAPTURE(BM_Conv2d, depthwise, ConvAlgorithm::Depthwise) NAPCAS_CONV_SHAPES;
+BENCHMARK_CAPTURE(BM_Conv2d, winograd,  ConvAlgorithm::Winograd)  NAPCAS_CONV_SHAPES;
+
+// Forward + backward (dX, dW, db) ; même convention de FLOP, ×3
+void BM_Conv2dBackward(benchmark::State& st) {
+    const std::size_t N = std::size_t(st.range(0)), C = std::size_t(st.range(1)),
+                      HW = std::size_t(st.range(2)), K = std::size_t(st.range(3)),
+                      groups = std::size_t(st.range(4));
+    architecture::Conv2d conv(int(C), int(K), {3, 3}, {1, 1}, {1, 1}, {1, 1}, int(groups));
+    Tensor x = architecture::to_channels_last(random({N, C, HW, HW}, 1));
+    x.requires_grad_(true);
+    for (auto _ : st) {
+        conv(x).sum().backward();
+        x.zero_grad();
+        for (Tensor& p : conv.parameters()) p.zero_grad();
+    }
+    report(st, 6.0 * double(N * HW * HW * K * 9 * (C / groups)),
+           3 * (2 * N * HW * HW * C + K * 9 * (C / groups)) * f32);
+}
+BENCHMARK(BM_Conv2dBackward)->Args({8, 64, 56, 64, 1})->Args({8, 256, 14, 256, 1})
+                            ->Args({8, 144, 56, 144, 144})->UseRealTime();
+
+void BM_MaxPool2d(benchmark::State& st) {
+    const std::size_t N = std::size_t(st.range(0)), C = std::size_t(st.range(1)),
+                      HW = std::size_t(st.range(2));
+    Tensor x = architecture::to_channels_last(random({N, C, HW, HW}, 1));
+    for (auto _ : st) benchmark::DoNotOptimize(architecture::max_pool2d(x, {3, 3}, {2, 2}, {1, 1}));
+    const std::size_t OHW = (HW - 1) / 2 + 1;
+    report(st, 0.0, (N * C * HW * HW + N * C * OHW * OHW) * f32);
+}
+BENCHMARK(BM_MaxPool2d)->Args({8, 64, 112})->UseRealTime();
+
+// ===================== Optimiseurs =====================
+
+enum OptimBench { kSgdUnfused, kSgdFused, kAdamFused, kAdamFusedClip };
+
+// (paramètres, éléments par paramètre, variante) : un pas sur des
+// gradients fixés. kSgdUnfused écrit SGD à moment en opérations de Tensor
+// (trois passes et un temporaire par paramètre, comme une boucle Python sur
+// parameters()) ; les autres variantes passent par optim.h. Les octets
+// sont le trafic minimal d'un pas fusionné.
+void BM_OptimizerStep(benchmark::State& st) {
+    const std::size_t count = std::size_t(st.range(0)), size = std::size_t(st.range(1));
+    std::vector<Tensor> params;
+    for (std::size_t i = 0; i < count; ++i) {
+        Tensor p = random({size}, unsigned(i));
+        p.requires_grad_(true);
+        p.grad() = random({size}, unsigned(100 + i)) * Tensor(Shape{}, std::vector<double>{1e-3});
+        params.push_back(p);
+    }
+    const double n = double(count * size);
+    switch (st.range(2)) {
+        case kSgdUnfused: {
+            const Tensor lr(Shape{}, std::vector<double>{0.01}), mu(Shape{}, std::vector<double>{0.9});
+            std::vector<Tensor> bufs;
+            for (const Tensor& p : params) bufs.push_back(Tensor::zeros(p.shape()));
+            for (auto _ : st)
+                for (std::size_t i = 0; i < count; ++i) {
+                    Tensor p = params[i].detach();
+                    bufs[i].mul_(mu).add_(params[i].grad());
+                    p.sub_(bufs[i] * lr);
+                }
+            report(st, 3.0 * n, 5.0 * n * f32);
+            break;
+        }
+        case kSgdFused: {
+            optim::SGD opt(params, 0.01f, 0.9f);
+            for (auto _ : st) opt.step();
+            report(st, 3.0 * n, 5.0 * n * f32);
+            break;
+        }
+        default: {
+            const bool clip = st.range(2) == kAdamFusedClip;
+            optim::Adam opt(params, 1e-3f, 0.9f, 0.999f, 1e-8f, 0.0f, clip ? 1.0f : 0.0f);
+            for (auto _ : st) benchmark::DoNotOptimize(opt.step());
+            report(st, (clip ? 14.0 : 12.0) * n, (clip ? 8.0 : 7.0) * n * f32);
+            break;
+        }
+    }
+}
+BENCHMARK(BM_OptimizerStep)
+    ->Args({256, 4096, kSgdUnfused})->Args({256, 4096, kSgdFused})
+    ->Args({256, 4096, kAdamFused})->Args({256, 4096, kAdamFusedClip})
+    ->Args({8, 1 << 22, kSgdUnfused})->Args({8, 1 << 22, kSgdFused})
+    ->Args({8, 1 << 22, kAdamFused})->Args({8, 1 << 22, kAdamFusedClip})
+    ->UseRealTime();
+
+// ===================== Chargeur de données =====================
+
+// 8192 enregistrements { uint8[3, 32, 32], int64 } (~25 Mo), écrits une fois
+const std::string& record_file() {
+    static const std::string path = [] {
+        const std::string p = "/tmp/napcas_bench_records.bin";
+        std::ofstream out(p, std::ios::binary | std::ios::trunc);
+        std::vector<char> rec(3 * 32 * 32 + sizeof(std::int64_t));
+        for (std::int64_t i = 0; i < 8192; ++i) {
+            std::fill(rec.begin(), rec.end() - sizeof(i), char(i));
+            std::memcpy(rec.data() + rec.size() - sizeof(i), &i, sizeof(i));
+            out.write(rec.data(), std::streamsize(rec.size()));
+        }
+        return p;
+    }();
+    return path;
+}
+
+// Une itération = un lot de 64 ; range(0) workers, range(1) = ReadMode.
+// `stall` : fraction du temps passée dans next() à attendre un lot
+void BM_DataLoader(benchmark::State& st) {
+    auto ds = std::make_shared<data::RecordDataset>(
+        std::vector<std::string>{record_file()},
+        std::vector<data::Field>{{"image", DType::UInt8, {3, 32, 32}}, {"label", DType::Int64, {}}},
+        0, data::ReadMode(st.range(1)));
+    data::LoaderOptions opt;
+    opt.batch_size  = 64;
+    opt.num_workers = std::size_t(st.range(0));
+    data::DataLoader loader(ds, opt);
+    for (auto _ : st) {
+        auto batch = loader.next();
+        if (batch.empty()) {
+            loader.start_epoch();
+            batch = loader.next();
+        }
+        benchmark::DoNotOptimize(batch[0].data_ptr());
+    }
+    const data::LoaderStats s = loader.stats();
+    report(st, 0.0, double(opt.batch_size * ds->record_bytes()) * 2.0);
+    st.counters["stall"] = s.elapsed_ns ? double(s.stall_ns) / double(s.elapsed_ns) : 0.0;
+}
+BENCHMARK(BM_DataLoader)
+    ->Args({1, int(data::ReadMode::Mmap)})->Args({4, int(data::ReadMode::Mmap)})
+    ->Args({1, int(data::ReadMode::Pread)})->Args({4, int(data::ReadMode::Pread)})
+    ->UseRealTime();
+
+} // namespace
+
+int main(int argc, char** argv) {
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) return 1;
+    g_roof = measure_roofline();
+    benchmark::AddCustomContext("napcas_cpu_capability", cpu_capability_to_string(cpu_capability()));
+    benchmark::AddCustomContext("napcas_num_threads", std::to_string(get_num_threads()));
+    benchmark::AddCustomContext("roofline_peak_gflops", std::to_string(g_roof.gflops));
+    benchmark::AddCustomContext("roofline_peak_gbs", std::to_string(g_roof.gbs));
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
@@ -0,0 +1,39 @@
+# cpp/cmake/napcas_simd.cmake
+#
+# Drapeaux par fichier pour les noyaux spécialisés par jeu d'instructions.
+# Seules ces unités sont compilées avec AVX2/AVX-512 ; le choix du noyau se
+# fait à l'exécution (voir napcas/cpu.h), le binaire reste donc portable.
+
+include(CheckCXXCompilerFlag)
+check_cxx_compiler_flag("-mavx2 -mfma" NAPCAS_COMPILER_HAS_AVX2)
+check_cxx_compiler_flag("-mavx512f"    NAPCAS_COMPILER_HAS_AVX512)
+check_cxx_compiler_flag("-mavx512f -mavx512bw -mavx512vnni" NAPCAS_COMPILER_HAS_AVX512_VNNI)
+
+# napcas_simd_sources(<racine cpp/src>) : applique les drapeaux dans le
+# répertoire CMake appelant (les propriétés de source y sont locales)
+function(napcas_simd_sources SRC_ROOT)
+    if (NAPCAS_COMPILER_HAS_AVX2)
+        set_source_files_properties(
+            ${SRC_ROOT}/kernels/elementwise_avx2.cpp
+            ${SRC_ROOT}/kernels/gemm_avx2.cpp
+            ${SRC_ROOT}/kernels/qgemm_avx2.cpp
+            ${SRC_ROOT}/kernels/optim_avx2.cpp
+            PROPERTIES COMPILE_OPTIONS "-mavx2;-mfma")
+        set_source_files_properties(
+            ${SRC_ROOT}/kernels/convert_avx2.cpp
+            PROPERTIES COMPILE_OPTIONS "-mavx2;-mfma;-mf16c")
+    endif()
+    if (NAPCAS_COMPILER_HAS_AVX512)
+        set_source_files_properties(
+            ${SRC_ROOT}/kernels/elementwise_avx512.cpp
+            ${SRC_ROOT}/kernels/gemm_avx512.cpp
+            ${SRC_ROOT}/kernels/convert_avx512.cpp
+            ${SRC_ROOT}/kernels/optim_avx512.cpp
+            PROPERTIES COMPILE_OPTIONS "-mavx512f")
+    endif()
+    if (NAPCAS_COMPILER_HAS_AVX512_VNNI)
+        set_source_files_properties(
+            ${SRC_ROOT}/kernels/qgemm_avx512.cpp
+            PROPERTIES COMPILE_OPTIONS "-mavx512f;-mavx512bw;-mavx512vnni")
+    endif()
+endfunction()
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstddef>
+
+namespace napcas {
+
+/// Alignement garanti des blocs CPU (une ligne de cache, un registre AVX-512)
+constexpr std::size_t kCpuAlignment = 64;
+
+/// Statistiques de l'allocateur CPU (en octets de classe, pas demandés)
+struct AllocatorStats {
+    std::size_t bytes_in_use      = 0;   // blocs actuellement prêtés
+    std::size_t peak_bytes_in_use = 0;
+    std::size_t bytes_cached      = 0;   // blocs libres conservés pour réemploi
+    std::size_t num_allocs        = 0;
+    std::size_t cache_hits        = 0;   // allocations servies sans le système
+
+    double hit_rate() const noexcept {
+        return num_allocs ? double(cache_hits) / double(num_allocs) : 0.0;
+    }
+};
+
+/// Allocateur CPU avec cache : classes de taille en puissances de deux
+/// (jusqu'à 32 MiB, multiples de 2 MiB au-delà), listes libres par thread
+/// puis pool global. NAPCAS_ALLOCATOR=system désactive le cache.
+void* cpu_malloc(std::size_t bytes);
+void  cpu_free(void* ptr);
+
+AllocatorStats allocator_stats();
+void reset_peak_stats();
+
+/// Rend au système tous les blocs libres en cache (pool global et caches
+/// de chaque thread)
+void empty_cache();
+
+} // namespace napcas
@@ -0,0 +1,106 @@
+#pragma once
+
+#include "napcas/module.h"
+#include "napcas/kernels/conv.h"
+#include <array>
+#include <cstddef>
+
+namespace napcas {
+namespace architecture {
+
+/// Paire (hauteur, largeur) : pas, padding, dilatation, taille de fenêtre
+using Size2 = std::array<std::size_t, 2>;
+
+// ----- Format mémoire -----
+// Les tenseurs d'images ont la forme logique [N, C, H, W]. Rangés en
+// channels-last (strides de NHWC), la dimension contiguë est celle des
+// canaux : c'est le format des noyaux de convolution et de pooling, qui
+// évitent alors toute transposition de l'entrée et de la sortie.
+
+/// Vrai si `t` (4-D) est rangé en channels-last dense
+bool is_channels_last(const Tensor& t);
+/// Copie de `t` [N, C, H, W] rangée en channels-last (sans copie si elle
+/// l'est déjà) ; forme logique et autograd inchangés
+Tensor to_channels_last(const Tensor& t);
+
+/// Convolution 2-D : input [N, C, H, W], weight [K, C/groups, R, S], bias
+/// [K] optionnel ; sortie [N, K, OH, OW]. L'algorithme est choisi selon la
+/// forme (voir kernels::ConvAlgorithm) ; le backward passe par im2col et
+/// GEMM (noyau direct pour une convolution depthwise). Calcul en float32
+/// (float64 si un opérande l'est), résultat du type promu. La sortie est
+/// en channels-last si l'entrée l'est, contiguë sinon.
+Tensor conv2d(const Tensor& input, const Tensor& weight, const Tensor& bias = Tensor(),
+              Size2 stride = {1, 1}, Size2 padding = {0, 0}, Size2 dilation = {1, 1},
+              std::size_t groups = 1,
+              kernels::ConvAlgorithm algorithm = kernels::ConvAlgorithm::Auto);
+
+/// Pooling sur des fenêtres `kernel` ; `stride` vaut `kernel` s'il est nul.
+/// Le padding ne dépasse pas la moitié de la fenêtre. Même format de sortie
+/// que conv2d.
+Tensor max_pool2d(const Tensor& input, Size2 kernel, Size2 stride = {0, 0},
+                  Size2 padding = {0, 0});
+/// `count_include_pad` : le padding compte dans le diviseur
+Tensor avg_pool2d(const Tensor& input, Size2 kernel, Size2 stride = {0, 0},
+                  Size2 padding = {0, 0}, bool count_include_pad = true);
+
+/// Couche de convolution (voir conv2d)
+class Conv2d : public Module {
+public:
+    Conv2d(int in_channels, int out_channels, Size2 kernel_size,
+           Size2 stride = {1, 1}, Size2 padding = {0, 0}, Size2 dilation = {1, 1},
+           int groups = 1, bool bias = true,
+           DType dtype = DType::Float32,
+           Device device = Device{DeviceType::CPU, 0});
+
+    Tensor forward(const Tensor& input) override;
+
+    /// U(-1/√fan_in, 1/√fan_in), fan_in = C/groups · R · S, en place
+    void reset_parameters();
+
+    int in_channels()  const noexcept { return in_channels_; }
+    int out_channels() const noexcept { return out_channels_; }
+    Size2 kernel_size() const noexcept { return kernel_size_; }
+    Size2 stride()      const noexcept { return stride_; }
+    Size2 padding()     const noexcept { return padding_; }
+    Size2 dilation()    const noexcept { return dilation_; }
+    int groups()        const noexcept { return groups_; }
+    const Tensor& weight() const noexcept { return weight_; }
+    // Non défini si la couche n'a pas de biais
+    const Tensor& bias()   const noexcept { return bias_; }
+
+    /// Algorithme imposé au forward (Auto par défaut)
+    kernels::ConvAlgorithm algorithm() const noexcept { return algorithm_; }
+    void set_algorithm(kernels::ConvAlgorithm algorithm) { algorithm_ = algorithm; }
+
+private:
+    int    in_channels_;
+    int    out_channels_;
+    Size2  kernel_size_, stride_, padding_, dilation_;
+    int    groups_;
+    Tensor weight_;
+    Tensor bias_;
+    kernels::ConvAlgorithm algorithm_ = kernels::ConvAlgorithm::Auto;
+};
+
+class MaxPool2d : public Module {
+public:
+    explicit MaxPool2d(Size2 kernel_size, Size2 stride = {0, 0}, Size2 padding = {0, 0});
+    Tensor forward(const Tensor& input) override;
+
+private:
+    Size2 kernel_size_, stride_, padding_;
+};
+
+class AvgPool2d : public Module {
+public:
+    explicit AvgPool2d(Size2 kernel_size, Size2 stride = {0, 0}, Size2 padding = {0, 0},
+                       bool count_include_pad = true);
+    Tensor forward(const Tensor& input) override;
+
+private:
+    Size2 kernel_size_, stride_, padding_;
+    bool  count_include_pad_;
+};
+
+} // namespace architecture
+} // namespace napcas
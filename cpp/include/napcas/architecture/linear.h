@@ -0,0 +1,50 @@
+#pragma once
+
+#include "napcas/module.h"
+#include "napcas/kernels/activation.h"
+
+namespace napcas {
+namespace architecture {
+
+/// y = act(x · weightᵀ + bias) sur la dernière dimension de `input`
+/// (weight [out, in], bias [out] optionnel). Un seul GEMM : le biais et
+/// l'activation sont appliqués en épilogue, tuile par tuile, avant que la
+/// sortie ne quitte le cache. Calcul en float32 (float64 si un opérande
+/// l'est) ; le résultat a le type promu des opérandes.
+///
+/// Avec autograd, ReLU garde la sortie ; GELU et SiLU ont besoin de la
+/// pré-activation : l'épilogue s'arrête alors au biais et l'activation est
+/// une passe séparée.
+Tensor linear(const Tensor& input, const Tensor& weight, const Tensor& bias = Tensor(),
+              kernels::Activation activation = kernels::Activation::None);
+
+/// Couche dense ; `activation` est fusionnée au GEMM (voir linear())
+class Linear : public Module {
+public:
+    Linear(int in_features, int out_features, bool bias = true,
+           DType dtype = DType::Float32,
+           Device device = Device{DeviceType::CPU, 0},
+           kernels::Activation activation = kernels::Activation::None);
+
+    Tensor forward(const Tensor& input) override;
+
+    /// U(-1/√in, 1/√in) pour weight et bias, en place
+    void reset_parameters();
+
+    int in_features()  const noexcept { return in_features_; }
+    int out_features() const noexcept { return out_features_; }
+    const Tensor& weight() const noexcept { return weight_; }
+    // Non défini si la couche n'a pas de biais
+    const Tensor& bias()   const noexcept { return bias_; }
+    kernels::Activation activation() const noexcept { return activation_; }
+
+private:
+    int                 in_features_;
+    int                 out_features_;
+    Tensor              weight_;
+    Tensor              bias_;
+    kernels::Activation activation_;
+};
+
+} // namespace architecture
+} // namespace napcas
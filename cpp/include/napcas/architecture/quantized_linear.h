@@ -0,0 +1,47 @@
+#pragma once
+
+#include "napcas/architecture/linear.h"
+#include "napcas/kernels/qgemm.h"
+#include <memory>
+
+namespace napcas {
+namespace architecture {
+
+/// y = act(x · Wᵀ + bias) avec W quantifié en int8 (voir kernels::qgemm) :
+/// les activations sont quantifiées en u8 sur tout le lot à chaque appel,
+/// le produit est accumulé en int32, et la déquantification, le biais et
+/// l'activation forment l'épilogue du GEMM. Inférence seulement (pas de
+/// gradient) ; entrée convertie en float32, sortie float32.
+Tensor quantized_linear(const Tensor& input,
+                        const std::shared_ptr<const kernels::QuantizedWeight>& weight,
+                        const Tensor& bias = Tensor(),
+                        kernels::Activation activation = kernels::Activation::None);
+
+/// Quantification post-entraînement d'une couche Linear : poids int8
+/// symétriques par canal de sortie, figés à la construction ; activations
+/// quantifiées dynamiquement par lot. Le biais (float32) et l'activation
+/// sont repris de la couche, qui n'est plus référencée ensuite.
+class QuantizedLinear : public Module {
+public:
+    explicit QuantizedLinear(const Linear& linear);
+
+    Tensor forward(const Tensor& input) override;
+
+    int in_features()  const noexcept { return int(weight_->K); }
+    int out_features() const noexcept { return int(weight_->N); }
+    const kernels::QuantizedWeight& packed_weight() const noexcept { return *weight_; }
+    // Non défini si la couche n'a pas de biais
+    const Tensor& bias() const noexcept { return bias_; }
+    kernels::Activation activation() const noexcept { return activation_; }
+
+    /// Poids déquantifiés [out, in] float32 (erreur de quantification)
+    Tensor dequantized_weight() const;
+
+private:
+    std::shared_ptr<const kernels::QuantizedWeight> weight_;
+    Tensor                                          bias_;
+    kernels::Activation                             activation_;
+};
+
+} // namespace architecture
+} // namespace napcas
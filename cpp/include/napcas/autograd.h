@@ -0,0 +1,25 @@
+#pragma once
+
+#include "napcas/tensor.h"
+
+namespace napcas {
+namespace autograd {
+
+/// Rétropropage `grad_output` (même forme que `root`) à travers le graphe de
+/// `root`. Les nœuds atteignables sont d'abord dénombrés (nombre d'arêtes
+/// entrantes), puis exécutés dans un ordre topologique : un nœud ne passe
+/// qu'une fois que tous ses consommateurs ont accumulé leur contribution
+/// dans son tampon d'entrée. Chaque tampon est libéré dès que son nœud a
+/// été exécuté, de même que les tenseurs sauvegardés par le nœud sauf si
+/// `retain_graph` est vrai. Les feuilles accumulent dans Tensor::grad().
+void backward(const Tensor& root, const Tensor& grad_output, bool retain_graph = false);
+
+} // namespace autograd
+
+/// Point d'entrée objet (exposé en Python)
+class Autograd {
+public:
+    void backward(const Tensor& tensor, bool retain_graph = false) const;
+};
+
+} // namespace napcas
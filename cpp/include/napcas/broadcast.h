@@ -0,0 +1,49 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+#include "napcas/small_vector.h"
+
+namespace napcas {
+
+/// Forme résultante du broadcasting NumPy de `a` et `b` (alignement à droite,
+/// une dimension de taille 1 s'étend). Lève une exception si incompatible.
+inline Shape broadcast_shapes(const Shape& a, const Shape& b) {
+    const std::size_t nd = std::max(a.size(), b.size());
+    Shape out(nd);
+    for (std::size_t i = 0; i < nd; ++i) {
+        std::size_t da = i < nd - a.size() ? 1 : a[i - (nd - a.size())];
+        std::size_t db = i < nd - b.size() ? 1 : b[i - (nd - b.size())];
+        if (da != db && da != 1 && db != 1) {
+            std::ostringstream oss;
+            oss << "Shape mismatch: cannot broadcast dimension " << i
+                << " (" << da << " vs " << db << ")";
+            throw std::runtime_error(oss.str());
+        }
+        out[i] = da == 1 ? db : da;
+    }
+    return out;
+}
+
+/// Strides de (shape, strides) vus sous `out_shape` : 0 sur les dimensions
+/// ajoutées ou diffusées, inchangés ailleurs.
+inline Strides broadcast_strides(const Shape&   shape,
+                                 const Strides& strides,
+                                 const Shape&   out_shape) {
+    if (shape.size() > out_shape.size())
+        throw std::runtime_error("broadcast_strides: rank larger than target");
+    const std::size_t lead = out_shape.size() - shape.size();
+    Strides out(out_shape.size(), 0);
+    for (std::size_t i = 0; i < shape.size(); ++i) {
+        if (shape[i] == out_shape[lead + i])
+            out[lead + i] = strides[i];
+        else if (shape[i] != 1)
+            throw std::runtime_error("broadcast_strides: incompatible shape");
+    }
+    return out;
+}
+
+} // namespace napcas
@@ -0,0 +1,39 @@
+#pragma once
+
+#include "napcas/tensor.h"
+#include <map>
+#include <string>
+
+namespace napcas {
+namespace checkpoint {
+
+/// Fichier de points de contrôle (octets dans l'ordre de l'hôte) :
+///
+///     "NAPCKPT1" | u64 taille de l'en-tête | u64 nombre d'entrées
+///     par entrée : u32 longueur du nom, nom, u8 dtype, u32 ndim,
+///                  u64 shape[ndim], u64 offset, u64 nbytes
+///     bourrage, puis données brutes row-major, chaque tenseur commençant
+///     à un offset (depuis le début du fichier) multiple de kAlignment
+///
+/// L'en-tête ne contient que des métadonnées : il est calculé avant
+/// d'écrire la moindre donnée, ce qui permet l'écriture en flux.
+constexpr std::size_t kAlignment = 64;
+
+/// Écrit `tensors` (ex. Module::state_dict(), qui ne copie rien) dans
+/// `path`. Les tenseurs contigus sont écrits directement depuis leur
+/// Storage ; les autres par tranches d'au plus quelques Mo, sans jamais
+/// matérialiser une seconde copie du modèle. Le fichier est écrit à côté
+/// puis renommé sur `path` : réécrire un point de contrôle encore chargé
+/// (load() puis save() au même chemin) est sûr, et une erreur laisse
+/// l'ancien fichier intact.
+void save(const std::string& path, const std::map<std::string, Tensor>& tensors);
+
+/// Projette `path` en mémoire (mmap privé, copie à l'écriture) et renvoie
+/// des Tensor dont le Storage pointe directement dans la projection : rien
+/// n'est lu avant le premier accès aux pages. La projection est libérée
+/// avec le dernier Storage qui la référence. Les tenseurs sont modifiables
+/// sans que le fichier change.
+std::map<std::string, Tensor> load(const std::string& path);
+
+} // namespace checkpoint
+} // namespace napcas
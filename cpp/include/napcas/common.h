@@ -11,25 +11,82 @@ namespace napcas {
 // === Types de données ===
 enum class DType {
     Float32,
-    Int32
+    Int32,
+    Float16,
+    BFloat16,
+    Float64,
+    Int8,
+    UInt8,
+    Int64
 };
 
 inline std::string dtype_to_string(DType dtype) {
     switch (dtype) {
-        case DType::Float32: return "float32";
-        case DType::Int32:   return "int32";
-        default:             return "unknown";
+        case DType::Float32:  return "float32";
+        case DType::Int32:    return "int32";
+        case DType::Float16:  return "float16";
+        case DType::BFloat16: return "bfloat16";
+        case DType::Float64:  return "float64";
+        case DType::Int8:     return "int8";
+        case DType::UInt8:    return "uint8";
+        case DType::Int64:    return "int64";
+        default:              return "unknown";
     }
 }
 
 inline std::size_t dtype_size(DType dtype) {
     switch (dtype) {
-        case DType::Float32: return sizeof(float);
-        case DType::Int32:   return sizeof(int);
-        default:             throw std::runtime_error("Unknown dtype");
+        case DType::Float32:  return 4;
+        case DType::Int32:    return 4;
+        case DType::Float16:  return 2;
+        case DType::BFloat16: return 2;
+        case DType::Float64:  return 8;
+        case DType::Int8:     return 1;
+        case DType::UInt8:    return 1;
+        case DType::Int64:    return 8;
+        default:              throw std::runtime_error("Unknown dtype");
     }
 }
 
+inline bool is_floating_point(DType dtype) {
+    return dtype == DType::Float32 || dtype == DType::Float64 ||
+           dtype == DType::Float16 || dtype == DType::BFloat16;
+}
+
+/// Type du résultat d'une opération binaire entre `a` et `b` :
+/// un flottant l'emporte sur un entier, le plus large l'emporte à
+/// catégorie égale. Float16 + BFloat16 et Int8 + UInt8 n'ont pas de type
+/// commun exact et donnent respectivement Float32 et Int32.
+inline DType promote_types(DType a, DType b) {
+    if (a == b) return a;
+    auto float_rank = [](DType t) {
+        switch (t) {
+            case DType::Float16:
+            case DType::BFloat16: return 1;
+            case DType::Float32:  return 2;
+            case DType::Float64:  return 3;
+            default:              return 0;
+        }
+    };
+    auto int_rank = [](DType t) {
+        switch (t) {
+            case DType::Int8:
+            case DType::UInt8: return 1;
+            case DType::Int32: return 2;
+            case DType::Int64: return 3;
+            default:           return 0;
+        }
+    };
+    const int fa = float_rank(a), fb = float_rank(b);
+    if (fa || fb) {
+        if (fa == fb) return DType::Float32;   // Float16 vs BFloat16
+        return fa > fb ? a : b;
+    }
+    const int ia = int_rank(a), ib = int_rank(b);
+    if (ia == ib) return DType::Int32;         // Int8 vs UInt8
+    return ia > ib ? a : b;
+}
+
 // === Types de devices ===
 enum class DeviceType {
     CPU,
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <string>
+
+namespace napcas {
+
+/// Jeux d'instructions vectoriels reconnus, du moins au plus large
+enum class CpuCapability {
+    Scalar,
+    SSE2,
+    AVX2,     // AVX2 + FMA + F16C
+    AVX512    // AVX-512F
+};
+
+/// Niveau utilisé par les noyaux : détecté via CPUID/XGETBV au premier
+/// appel, éventuellement abaissé par la variable d'environnement
+/// NAPCAS_CPU_CAPABILITY (scalar, sse2, avx2, avx512).
+CpuCapability cpu_capability();
+
+/// Niveau maximal supporté par le processeur et l'OS
+CpuCapability detected_cpu_capability();
+
+/// Force un niveau (borné par detected_cpu_capability()), p. ex. pour comparer
+/// les noyaux dans un benchmark
+void set_cpu_capability(CpuCapability cap);
+
+std::string cpu_capability_to_string(CpuCapability cap);
+
+/// Vrai si cpu_capability() vaut AVX512 et que le processeur a AVX512-BW
+/// et AVX512-VNNI (produits int8 vpdpbusd, voir kernels/qgemm.h)
+bool cpu_has_avx512_vnni();
+
+} // namespace napcas
@@ -0,0 +1,127 @@
+#pragma once
+
+#include "napcas/tensor.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace napcas {
+namespace data {
+
+/// Champ d'un enregistrement : `shape` est la forme d'un échantillon, le
+/// lot a la forme [B, shape...]
+struct Field {
+    std::string name;
+    DType       dtype = DType::Float32;
+    Shape       shape;
+
+    std::size_t bytes() const;
+};
+
+enum class ReadMode {
+    Mmap,    // projection en lecture seule, copiée page par page à la demande
+    Pread    // pread() par suite d'enregistrements consécutifs, sans projection
+};
+
+/// Fichiers d'enregistrements de taille fixe : après `header_bytes`
+/// octets d'en-tête, chaque fichier est une suite d'enregistrements dont
+/// les champs sont contigus, dans l'ordre de `fields`, sans bourrage
+/// (octets dans l'ordre de l'hôte). Les fichiers sont concaténés dans
+/// l'ordre donné. Lecture thread-safe.
+class RecordDataset {
+public:
+    RecordDataset(std::vector<std::string> paths, std::vector<Field> fields,
+                  std::size_t header_bytes = 0, ReadMode mode = ReadMode::Mmap);
+    ~RecordDataset();
+    RecordDataset(const RecordDataset&)            = delete;
+    RecordDataset& operator=(const RecordDataset&) = delete;
+
+    std::size_t size() const noexcept { return size_; }
+    std::size_t record_bytes() const noexcept { return record_bytes_; }
+    const std::vector<Field>& fields() const noexcept { return fields_; }
+    ReadMode mode() const noexcept { return mode_; }
+
+    /// Enregistrements [index, index + count), consécutifs et dans un même
+    /// fichier (count ≤ run_length(index)) : pointeur dans la projection
+    /// (Mmap) ou dans `scratch` (Pread, count · record_bytes() octets)
+    const char* read(std::size_t index, std::size_t count, char* scratch) const;
+    /// Enregistrements lisibles d'un seul read() à partir de `index`
+    std::size_t run_length(std::size_t index) const;
+
+private:
+    struct File;
+    const File& file_of(std::size_t index) const;
+    void close_files() noexcept;
+
+    std::vector<File>  files_;
+    std::vector<Field> fields_;
+    std::size_t        record_bytes_ = 0;
+    std::size_t        header_bytes_;
+    std::size_t        size_ = 0;
+    ReadMode           mode_;
+};
+
+struct LoaderOptions {
+    std::size_t   batch_size  = 32;
+    bool          shuffle     = true;
+    std::uint64_t seed        = 0;      // permutation de l'époque e : f(seed, e)
+    bool          drop_last   = false;  // écarte le dernier lot incomplet
+    std::size_t   num_workers = 2;
+    std::size_t   prefetch    = 4;      // lots préparés d'avance
+    bool          pin_memory  = false;  // mlock() des tampons (au mieux)
+};
+
+/// Compteurs cumulés depuis la construction ou reset_stats(). Un
+/// `stall_ns` proche de `elapsed_ns` signale un entraînement limité par
+/// les données ; un `worker_idle_ns` élevé, des workers en avance.
+struct LoaderStats {
+    std::size_t  batches = 0, samples = 0, bytes = 0;
+    std::int64_t elapsed_ns     = 0;   // depuis le premier next()
+    std::int64_t stall_ns       = 0;   // next() en attente d'un lot
+    std::int64_t read_ns        = 0;   // workers : lecture et assemblage
+    std::int64_t worker_idle_ns = 0;   // workers : attente d'un tampon libre
+    std::size_t  ring_size      = 0;   // tampons de lot alloués
+};
+
+/// Chargeur multi-thread : `num_workers` threads lisent les échantillons de
+/// chaque lot (dans l'ordre d'une permutation tirée par époque) et les
+/// assemblent dans un tampon préalloué d'un anneau, jusqu'à `prefetch`
+/// lots d'avance. Les lots sont livrés dans l'ordre.
+///
+/// Les Tensor d'un lot pointent directement dans son tampon, sans copie ;
+/// le tampon retourne à l'anneau quand le dernier d'entre eux est détruit.
+/// Conserver des lots retarde donc leur réemploi : si l'appelant garde
+/// tous les tampons, l'anneau grandit d'un tampon au lieu de bloquer.
+class DataLoader {
+public:
+    DataLoader(std::shared_ptr<const RecordDataset> dataset, LoaderOptions options = {});
+    ~DataLoader();
+    DataLoader(const DataLoader&)            = delete;
+    DataLoader& operator=(const DataLoader&) = delete;
+
+    /// Commence l'époque suivante (abandonne ce qui reste de la courante)
+    void start_epoch();
+    /// Lot suivant de l'époque courante, un Tensor par champ ; vide à la
+    /// fin de l'époque. Relance l'exception d'un worker.
+    std::vector<Tensor> next();
+
+    /// Lots par époque
+    std::size_t num_batches() const noexcept;
+    /// Numéro de l'époque courante (0 pour la première)
+    std::size_t epoch() const noexcept;
+    const LoaderOptions& options() const noexcept;
+    const RecordDataset& dataset() const noexcept;
+
+    LoaderStats stats() const;
+    void reset_stats();
+
+    struct State;
+
+private:
+    std::shared_ptr<State> state_;
+};
+
+} // namespace data
+} // namespace napcas
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "napcas/common.h"
+#include "napcas/allocator.h"
 #include <cstdlib>
 #include <stdexcept>
 
@@ -8,7 +9,7 @@ namespace napcas {
 
 inline void* device_malloc(std::size_t bytes, const Device& device) {
     if (device.type == DeviceType::CPU)
-        return std::malloc(bytes);
+        return cpu_malloc(bytes);
 #ifdef USE_CUDA
     else if (device.type == DeviceType::CUDA) {
         void* ptr = nullptr;
@@ -22,7 +23,7 @@ inline void* device_malloc(std::size_t bytes, const Device& device) {
 inline void device_free(void* ptr, const Device& device) {
     if (!ptr) return;
     if (device.type == DeviceType::CPU)
-        std::free(ptr);
+        cpu_free(ptr);
 #ifdef USE_CUDA
     else if (device.type == DeviceType::CUDA)
         cudaFree(ptr);
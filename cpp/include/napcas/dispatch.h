@@ -0,0 +1,86 @@
+#pragma once
+
+// Correspondance DType <-> type C++ et macros de dispatch : le corps est une
+// lambda instanciée pour chaque type, où `scalar_t` désigne le type courant.
+//
+//     NAPCAS_DISPATCH_ALL_TYPES(t.dtype(), "ones", [&] {
+//         scalar_t one = scalar_t(1);
+//         ...
+//     });
+
+#include "napcas/common.h"
+#include "napcas/half.h"
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+namespace napcas {
+
+template<typename T> struct dtype_of;
+template<> struct dtype_of<float>        { static constexpr DType value = DType::Float32;  };
+template<> struct dtype_of<std::int32_t> { static constexpr DType value = DType::Int32;    };
+template<> struct dtype_of<Half>         { static constexpr DType value = DType::Float16;  };
+template<> struct dtype_of<BFloat16>     { static constexpr DType value = DType::BFloat16; };
+template<> struct dtype_of<double>       { static constexpr DType value = DType::Float64;  };
+template<> struct dtype_of<std::int8_t>  { static constexpr DType value = DType::Int8;     };
+template<> struct dtype_of<std::uint8_t> { static constexpr DType value = DType::UInt8;    };
+template<> struct dtype_of<std::int64_t> { static constexpr DType value = DType::Int64;    };
+
+template<typename T>
+constexpr DType dtype_of_v = dtype_of<T>::value;
+
+/// Type d'accumulation : float pour les types 16 bits, int64 pour les
+/// entiers, le type lui-même sinon
+template<typename T> struct acc_type { using type = T; };
+template<> struct acc_type<Half>         { using type = float; };
+template<> struct acc_type<BFloat16>     { using type = float; };
+template<> struct acc_type<std::int8_t>  { using type = std::int64_t; };
+template<> struct acc_type<std::uint8_t> { using type = std::int64_t; };
+template<> struct acc_type<std::int32_t> { using type = std::int64_t; };
+
+template<typename T>
+using acc_type_t = typename acc_type<T>::type;
+
+/// Type de calcul des fonctions transcendantes (exp, log, erf, ...) :
+/// float64 pour double, float32 pour tous les autres types
+template<typename T>
+using compute_type_t = std::conditional_t<std::is_same<T, double>::value, double, float>;
+
+[[noreturn]] inline void throw_unsupported_dtype(const char* name, DType dtype) {
+    throw std::runtime_error(std::string(name) + ": unsupported dtype " +
+                             dtype_to_string(dtype));
+}
+
+#define NAPCAS_DISPATCH_CASE(ENUM, TYPE, ...)                                   \
+    case DType::ENUM: { using scalar_t = TYPE; return __VA_ARGS__(); }
+
+#define NAPCAS_DISPATCH_ALL_TYPES(DTYPE, NAME, ...)                             \
+    [&] {                                                                       \
+        const ::napcas::DType _dt = (DTYPE);                                    \
+        switch (_dt) {                                                          \
+            NAPCAS_DISPATCH_CASE(Float32,  float,                __VA_ARGS__)   \
+            NAPCAS_DISPATCH_CASE(Float64,  double,               __VA_ARGS__)   \
+            NAPCAS_DISPATCH_CASE(Float16,  ::napcas::Half,       __VA_ARGS__)   \
+            NAPCAS_DISPATCH_CASE(BFloat16, ::napcas::BFloat16,   __VA_ARGS__)   \
+            NAPCAS_DISPATCH_CASE(Int8,     std::int8_t,          __VA_ARGS__)   \
+            NAPCAS_DISPATCH_CASE(UInt8,    std::uint8_t,         __VA_ARGS__)   \
+            NAPCAS_DISPATCH_CASE(Int32,    std::int32_t,         __VA_ARGS__)   \
+            NAPCAS_DISPATCH_CASE(Int64,    std::int64_t,         __VA_ARGS__)   \
+            default: ::napcas::throw_unsupported_dtype(NAME, _dt);              \
+        }                                                                       \
+    }()
+
+#define NAPCAS_DISPATCH_FLOATING_TYPES(DTYPE, NAME, ...)                        \
+    [&] {                                                                       \
+        const ::napcas::DType _dt = (DTYPE);                                    \
+        switch (_dt) {                                                          \
+            NAPCAS_DISPATCH_CASE(Float32,  float,                __VA_ARGS__)   \
+            NAPCAS_DISPATCH_CASE(Float64,  double,               __VA_ARGS__)   \
+            NAPCAS_DISPATCH_CASE(Float16,  ::napcas::Half,       __VA_ARGS__)   \
+            NAPCAS_DISPATCH_CASE(BFloat16, ::napcas::BFloat16,   __VA_ARGS__)   \
+            default: ::napcas::throw_unsupported_dtype(NAME, _dt);              \
+        }                                                                       \
+    }()
+
+} // namespace napcas
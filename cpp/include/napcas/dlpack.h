@@ -0,0 +1,63 @@
+#pragma once
+
+#include "napcas/tensor.h"
+#include <cstdint>
+
+// Structures de l'ABI DLPack (https://github.com/dmlc/dlpack, v0.8), à
+// l'identique de dlpack.h pour échanger des tenseurs sans copie avec NumPy,
+// PyTorch, JAX, ...
+extern "C" {
+
+typedef enum {
+    kDLCPU  = 1,
+    kDLCUDA = 2,
+} DLDeviceType;
+
+typedef struct {
+    DLDeviceType device_type;
+    int32_t      device_id;
+} DLDevice;
+
+typedef enum {
+    kDLInt    = 0U,
+    kDLUInt   = 1U,
+    kDLFloat  = 2U,
+    kDLBfloat = 4U,
+} DLDataTypeCode;
+
+typedef struct {
+    uint8_t  code;
+    uint8_t  bits;
+    uint16_t lanes;
+} DLDataType;
+
+typedef struct {
+    void*      data;
+    DLDevice   device;
+    int32_t    ndim;
+    DLDataType dtype;
+    int64_t*   shape;
+    int64_t*   strides;       // en éléments ; NULL = dense row-major
+    uint64_t   byte_offset;
+} DLTensor;
+
+typedef struct DLManagedTensor {
+    DLTensor dl_tensor;
+    void*    manager_ctx;
+    void   (*deleter)(struct DLManagedTensor* self);
+} DLManagedTensor;
+
+} // extern "C"
+
+namespace napcas {
+
+/// Exporte `tensor` sans copie. Le DLManagedTensor garde le Storage vivant
+/// jusqu'à l'appel de son deleter par le consommateur.
+DLManagedTensor* to_dlpack(const Tensor& tensor);
+
+/// Importe un DLManagedTensor sans copie : le Tensor en prend possession et
+/// appelle son deleter à la libération du Storage. En cas d'exception
+/// (type, device ou strides non supportés), `managed` n'est pas consommé.
+Tensor from_dlpack(DLManagedTensor* managed);
+
+} // namespace napcas
@@ -0,0 +1,387 @@
+#pragma once
+
+#include "napcas/tensor.h"
+#include "napcas/kernels/activation.h"
+#include "napcas/kernels/conv.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace napcas {
+
+/// État autograd d'un Tensor, partagé par ses copies superficielles.
+/// `grad` est le tampon d'accumulation (non défini tant qu'aucun gradient
+/// n'a été calculé) ; `grad_fn` est nul pour une feuille. `mutex` protège
+/// `grad` et `accumulator` : une même feuille (ex. un poids) peut servir à
+/// plusieurs forward/backward concurrents.
+struct AutogradMeta {
+    bool                    requires_grad = false;
+    Tensor                  grad;
+    std::shared_ptr<GradFn> grad_fn;
+    std::weak_ptr<GradFn>   accumulator;   // AccumulateGrad de la feuille
+    std::mutex              mutex;
+};
+
+/// Nœud du graphe de rétropropagation. Un nœud possède ce dont il a besoin
+/// (tenseurs détachés partageant le Storage, formes) et une arête par entrée
+/// de l'opération : le nœud producteur de cette entrée, ou nul si elle ne
+/// requiert pas de gradient. apply() reçoit le gradient de la sortie et
+/// renvoie un gradient par arête (Tensor vide pour une arête nulle).
+class GradFn {
+public:
+    explicit GradFn(std::vector<std::shared_ptr<GradFn>> next)
+        : next_(std::move(next)) {}
+    virtual ~GradFn() = default;
+
+    GradFn(const GradFn&)            = delete;
+    GradFn& operator=(const GradFn&) = delete;
+
+    virtual const char* name() const = 0;
+    virtual std::vector<Tensor> apply(const Tensor& grad_output) = 0;
+
+    const std::vector<std::shared_ptr<GradFn>>& next() const noexcept { return next_; }
+
+    /// Libère les tenseurs sauvegardés ; un second apply() lève alors une
+    /// exception (utiliser retain_graph pour rétropropager plusieurs fois).
+    void release_saved() {
+        release_saved_impl();
+        saved_versions_.clear();
+        released_ = true;
+    }
+
+protected:
+    virtual void release_saved_impl() {}
+    /// Lève une exception si les tenseurs sauvegardés ont été libérés, ou
+    /// modifiés en place depuis leur sauvegarde (compteur de version du
+    /// Storage, voir Tensor::add_)
+    void check_not_released() const;
+    /// Tenseur détaché à garder pour apply() ; la version de son Storage
+    /// est relevée. Un Tensor non défini est rendu tel quel.
+    Tensor save(const Tensor& t);
+    bool needs_grad(std::size_t i) const noexcept { return i < next_.size() && next_[i] != nullptr; }
+
+private:
+    struct SavedVersion {
+        std::weak_ptr<Storage> storage;   // gardé vivant par le tenseur sauvegardé
+        std::uint64_t          version;
+    };
+
+    std::vector<std::shared_ptr<GradFn>> next_;
+    std::vector<SavedVersion> saved_versions_;
+    std::atomic<bool> released_{false};   // un AccumulateGrad est partagé entre graphes
+};
+
+/// Accumule le gradient reçu dans AutogradMeta::grad d'une feuille.
+class AccumulateGrad : public GradFn {
+public:
+    explicit AccumulateGrad(std::shared_ptr<AutogradMeta> meta)
+        : GradFn({}), meta_(std::move(meta)) {}
+    const char* name() const override { return "AccumulateGrad"; }
+    std::vector<Tensor> apply(const Tensor& grad_output) override;
+
+private:
+    std::shared_ptr<AutogradMeta> meta_;
+};
+
+// ----- Opérations de forme : seules les métadonnées sont gardées -----
+
+class ReshapeBackward : public GradFn {
+public:
+    ReshapeBackward(const Tensor& input, Shape input_shape);
+    const char* name() const override { return "ReshapeBackward"; }
+    std::vector<Tensor> apply(const Tensor& grad_output) override;
+private:
+    Shape input_shape_;
+};
+
+class PermuteBackward : public GradFn {
+public:
+    PermuteBackward(const Tensor& input, std::vector<int> inverse);
+    const char* name() const override { return "PermuteBackward"; }
+    std::vector<Tensor> apply(const Tensor& grad_output) override;
+private:
+    std::vector<int> inverse_;
+};
+
+class SqueezeBackward : public GradFn {
+public:
+    SqueezeBackward(const Tensor& input, int dim);
+    const char* name() const override { return "SqueezeBackward"; }
+    std::vector<Tensor> apply(const Tensor& grad_output) override;
+private:
+    int dim_;
+};
+
+class UnsqueezeBackward : public GradFn {
+public:
+    UnsqueezeBackward(const Tensor& input, int dim);
+    const char* name() const override { return "UnsqueezeBackward"; }
+    std::vector<Tensor> apply(const Tensor& grad_output) override;
+private:
+    int dim_;
+};
+
+// ----- Opérations binaires (broadcasting : gradients réduits par sum_to_size) -----
+
+/// Base des nœuds binaires : formes et types des deux entrées
+class BinaryBackward : public GradFn {
+public:
+    BinaryBackward(const Tensor& a, const Tensor& b);
+protected:
+    Shape a_shape_, b_shape_;
+    DType a_dtype_, b_dtype_;
+};
+
+class AddBackward : public BinaryBackward {
+public:
+    using BinaryBackward::BinaryBackward;
+    const char* name() const override { return "AddBackward"; }
+    std::vector<Tensor> apply(const Tensor& grad_output) override;
+};
+
+class SubBackward : public BinaryBackward {
+public:
+    using BinaryBackward::BinaryBackward;
+    const char* name() const override { return "SubBackward"; }
+    std::vector<Tensor> apply(const Tensor& grad_output) override;
+};
+
+/// Sauvegarde chaque entrée seulement si l'autre requiert un gradient
+class MulBackward : public BinaryBackward {
+public:
+    MulBackward(const Tensor& a, const Tensor& b);
+    const char* name() const override { return "MulBackward"; }
+    std::vector<Tensor> apply(const Tensor& grad_output) override;
+protected:
+    void release_saved_impl() override;
+private:
+    Tensor a_, b_;
+};
+
+class DivBackward : public BinaryBackward {
+public:
+    DivBackward(const Tensor& a, const Tensor& b);
+    const char* name() const override { return "DivBackward"; }
+    std::vector<Tensor> apply(const Tensor& grad_output) override;
+protected:
+    void release_saved_impl() override;
+private:
+    Tensor a_, b_;
+};
+
+class MatMulBackward : public BinaryBackward {
+public:
+    MatMulBackward(const Tensor& a, const Tensor& b);
+    const char* name() const override { return "MatMulBackward"; }
+    std::vector<Tensor> apply(const Tensor& grad_output) override;
+protected:
+    void release_saved_impl() override;
+private:
+    Tensor a_, b_;
+};
+
+/// exp : le gradient réutilise la sortie
+class ExpBackward : public GradFn {
+public:
+    ExpBackward(const Tensor& input, const Tensor& result);
+    const char* name() const override { return "ExpBackward"; }
+    std::vector<Tensor> apply(const Tensor& grad_output) override;
+protected:
+    void release_saved_impl() override;
+private:
+    Tensor result_;
+};
+
+// ----- Activations et normalisations fusionnées -----
+
+/// ReLU garde sa sortie, GELU et SiLU leur entrée
+class ActivationBackward : public GradFn {
+public:
+    ActivationBackward(const Tensor& input, const Tensor& saved, kernels::Activation act);
+    const char* name() const override;
+    std::vector<Tensor> apply(const Tensor& grad_output) override;
+protected:
+    void release_saved_impl() override;
+private:
+    Tensor              saved_;
+    kernels::Activation act_;
+};
+
+/// softmax / log-softmax : seule la sortie est gardée, dense avec `dim`
+/// ramené en dernière position
+class SoftmaxBackward : public GradFn {
+public:
+    SoftmaxBackward(const Tensor& input, const Tensor& rows_out, int dim, bool log);
+    const char* name() const override { return log_ ? "LogSoftmaxBackward" : "SoftmaxBackward"; }
+    std::vector<Tensor> apply(const Tensor& grad_output) override;
+protected:
+    void release_saved_impl() override;
+private:
+    Tensor out_;
+    int    dim_;
+    bool   log_;
+};
+
+/// Arêtes : entrée, weight, bias. Garde l'entrée, weight et les
+/// statistiques par ligne (moyenne, rstd) ; pas la sortie normalisée.
+class LayerNormBackward : public GradFn {
+public:
+    LayerNormBackward(const Tensor& input, const Tensor& weight, const Tensor& bias,
+                      const Tensor& mean, const Tensor& rstd);
+    const char* name() const override { return "LayerNormBackward"; }
+    std::vector<Tensor> apply(const Tensor& grad_output) override;
+protected:
+    void release_saved_impl() override;
+private:
+    Tensor input_, weight_, mean_, rstd_;
+};
+
+/// Arêtes : entrée, weight. Garde l'entrée, weight et rstd par ligne.
+class RMSNormBackward : public GradFn {
+public:
+    RMSNormBackward(const Tensor& input, const Tensor& weight, const Tensor& rstd);
+    const char* name() const override { return "RMSNormBackward"; }
+    std::vector<Tensor> apply(const Tensor& grad_output) override;
+protected:
+    void release_saved_impl() override;
+private:
+    Tensor input_, weight_, rstd_;
+};
+
+/// Couche dense fusionnée act(x·Wᵀ + b) (voir architecture::linear).
+/// Arêtes : entrée, weight, bias. Garde x (matrice [M, K] dans le type de
+/// calcul) si weight requiert un gradient, W si l'entrée en requiert, et
+/// la sortie (ReLU) ou la pré-activation (GELU, SiLU). apply() fait une
+/// passe sur le gradient (dZ et db ensemble) puis deux GEMM (dX, dW).
+class LinearBackward : public GradFn {
+public:
+    LinearBackward(const Tensor& input, const Tensor& weight, const Tensor& bias,
+                   const Tensor& x, const Tensor& w, const Tensor& saved,
+                   kernels::Activation act);
+    const char* name() const override { return "LinearBackward"; }
+    std::vector<Tensor> apply(const Tensor& grad_output) override;
+protected:
+    void release_saved_impl() override;
+private:
+    Shape               input_shape_;
+    DType               input_dtype_, weight_dtype_, bias_dtype_, compute_dtype_;
+    std::size_t         in_features_, out_features_;
+    Tensor              x_, w_, saved_;
+    kernels::Activation act_;
+};
+
+/// Convolution 2-D (voir architecture::conv2d). Arêtes : entrée, weight,
+/// bias. Garde l'entrée en NHWC (type de calcul) si weight requiert un
+/// gradient, et les poids en KRSC si l'entrée en requiert. Le gradient de
+/// l'entrée reprend son format mémoire (channels-last ou contigu).
+class Conv2dBackward : public GradFn {
+public:
+    Conv2dBackward(const Tensor& input, const Tensor& weight, const Tensor& bias,
+                   const Tensor& x, const Tensor& w, const kernels::Conv2dShape& shape,
+                   bool channels_last);
+    const char* name() const override { return "Conv2dBackward"; }
+    std::vector<Tensor> apply(const Tensor& grad_output) override;
+protected:
+    void release_saved_impl() override;
+private:
+    kernels::Conv2dShape shape_;
+    DType                input_dtype_, weight_dtype_, bias_dtype_, compute_dtype_;
+    bool                 channels_last_;
+    Tensor               x_, w_;
+};
+
+/// max_pool2d (indices du maximum sauvegardés) ou avg_pool2d (géométrie
+/// seule). Arête : l'entrée.
+class Pool2dBackward : public GradFn {
+public:
+    Pool2dBackward(const Tensor& input, const kernels::Pool2dShape& shape, DType compute_dtype,
+                   bool channels_last, const Tensor& indices, bool count_include_pad = true);
+    const char* name() const override { return is_max_ ? "MaxPool2dBackward" : "AvgPool2dBackward"; }
+    std::vector<Tensor> apply(const Tensor& grad_output) override;
+protected:
+    void release_saved_impl() override;
+private:
+    kernels::Pool2dShape shape_;
+    DType                input_dtype_, compute_dtype_;
+    bool                 channels_last_;
+    bool                 is_max_;
+    bool                 count_include_pad_;
+    Tensor               indices_;
+};
+
+// ----- Réductions : le gradient est rediffusé sur les axes réduits -----
+
+/// Base des réductions : forme et axes réduits de l'entrée
+class ReduceBackward : public GradFn {
+public:
+    ReduceBackward(const Tensor& input, std::vector<bool> axes);
+protected:
+    // Gradient de sortie remis à la forme keepdim (axes réduits de taille 1)
+    Tensor keepdim_grad(const Tensor& grad_output) const;
+    std::size_t reduced_numel() const;
+
+    Shape                    input_shape_;
+    std::vector<bool>        axes_;
+    DType                    input_dtype_;
+};
+
+class SumBackward : public ReduceBackward {
+public:
+    using ReduceBackward::ReduceBackward;
+    const char* name() const override { return "SumBackward"; }
+    std::vector<Tensor> apply(const Tensor& grad_output) override;
+};
+
+class MeanBackward : public ReduceBackward {
+public:
+    using ReduceBackward::ReduceBackward;
+    const char* name() const override { return "MeanBackward"; }
+    std::vector<Tensor> apply(const Tensor& grad_output) override;
+};
+
+/// max/min : tout le gradient va au premier extremum (indices sauvegardés)
+class MaxMinBackward : public ReduceBackward {
+public:
+    MaxMinBackward(const Tensor& input, std::vector<bool> axes, Tensor indices, bool is_max);
+    const char* name() const override { return is_max_ ? "MaxBackward" : "MinBackward"; }
+    std::vector<Tensor> apply(const Tensor& grad_output) override;
+protected:
+    void release_saved_impl() override;
+private:
+    Tensor indices_;
+    bool   is_max_;
+};
+
+/// var/std : d var = 2 (x - moyenne) / (N - correction) ; d std = d var / (2 std)
+class VarBackward : public ReduceBackward {
+public:
+    VarBackward(const Tensor& input, std::vector<bool> axes, std::size_t correction,
+                const Tensor& std_result = Tensor());
+    const char* name() const override { return is_std_ ? "StdBackward" : "VarBackward"; }
+    std::vector<Tensor> apply(const Tensor& grad_output) override;
+protected:
+    void release_saved_impl() override;
+private:
+    Tensor      input_;
+    Tensor      std_;
+    std::size_t correction_;
+    bool        is_std_;
+};
+
+/// logsumexp : d lse / dx = exp(x - lse) (softmax)
+class LogSumExpBackward : public ReduceBackward {
+public:
+    LogSumExpBackward(const Tensor& input, std::vector<bool> axes, const Tensor& result);
+    const char* name() const override { return "LogSumExpBackward"; }
+    std::vector<Tensor> apply(const Tensor& grad_output) override;
+protected:
+    void release_saved_impl() override;
+private:
+    Tensor input_;
+    Tensor result_;
+};
+
+} // namespace napcas
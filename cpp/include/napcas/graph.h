@@ -0,0 +1,115 @@
+#pragma once
+
+#include "napcas/tensor.h"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace napcas {
+
+class Module;
+
+namespace graph {
+
+/// Noyau rejouable d'une opération : écrit dans `output` à partir de
+/// `inputs`, tous de la géométrie observée à la capture. Les vérifications
+/// (formes, types, devices) ont été faites une fois pour toutes.
+using Kernel = std::function<void(const std::vector<Tensor>& inputs, Tensor& output)>;
+
+/// Portée d'une opération capturable : seule l'opération la plus externe
+/// est enregistrée, pas celles qu'elle appelle (astype, contiguous, ...).
+///
+///     graph::CaptureScope scope;
+///     ... calcul ...
+///     if (scope.active()) graph::record("relu", {x}, out, kernel);
+class CaptureScope {
+public:
+    CaptureScope() noexcept;
+    ~CaptureScope();
+    CaptureScope(const CaptureScope&)            = delete;
+    CaptureScope& operator=(const CaptureScope&) = delete;
+
+    bool active() const noexcept { return active_; }
+
+private:
+    bool capturing_;
+    bool active_;
+};
+
+/// Vrai si une capture est en cours sur ce thread
+bool capturing() noexcept;
+
+/// Enregistre une opération exécutée pendant la capture. Chaque entrée est
+/// une valeur du graphe (entrée, résultat d'une opération enregistrée, ou
+/// vue de l'un d'eux), une constante (tenseur antérieur à la capture,
+/// ex. paramètre : lu à chaque rejeu, une mise à jour en place est vue), ou
+/// non définie. `output` est un nouveau résultat, ou une valeur existante
+/// écrite en place. Un tenseur créé pendant la capture par une opération
+/// non capturable lève une exception.
+void record(const char* name, const std::vector<Tensor>& inputs, const Tensor& output,
+            Kernel kernel);
+
+/// Noyau de repli : réexécute `op` sur les entrées puis copie son résultat
+/// dans la sortie (dense). Alloue à chaque rejeu ; réservé aux cas rares
+/// (conversions de type, géométries inhabituelles).
+Kernel eager_kernel(std::function<Tensor(const std::vector<Tensor>&)> op);
+
+} // namespace graph
+
+/// Plan statique d'une exécution : `capture` exécute une fois la fonction
+/// en enregistrant chaque opération, puis affecte à chaque résultat
+/// intermédiaire une zone d'une arène unique. Deux valeurs dont les durées
+/// de vie (de l'opération qui la produit à son dernier lecteur) sont
+/// disjointes partagent la même zone. replay() n'exécute plus que les
+/// noyaux, dans les buffers préalloués : ni dispatch, ni vérification de
+/// forme, ni allocation, ni graphe autograd.
+///
+///     Graph g = Graph::capture(model, Tensor::zeros({32, 512}));
+///     for (...) {
+///         const Tensor& y = g.replay({batch})[0];
+///     }
+///
+/// Les entrées sont copiées dans des buffers statiques (inputs(), qu'on
+/// peut aussi remplir en place) ; les sorties sont des vues de l'arène,
+/// écrasées par le rejeu suivant (clone() pour les conserver). Un Graph
+/// n'est pas rejouable par plusieurs threads à la fois.
+class Graph {
+public:
+    using Function = std::function<std::vector<Tensor>(const std::vector<Tensor>&)>;
+
+    Graph(Graph&&) noexcept;
+    Graph& operator=(Graph&&) noexcept;
+    ~Graph();
+
+    /// Exécute `fn` sur des copies de `example_inputs` (formes et types fixés)
+    static Graph capture(const Function& fn, const std::vector<Tensor>& example_inputs);
+    /// module.forward(input)
+    static Graph capture(Module& module, const Tensor& example_input);
+
+    /// Copie `inputs` (formes et types de la capture) puis rejoue
+    const std::vector<Tensor>& replay(const std::vector<Tensor>& inputs);
+    /// Rejoue sur le contenu actuel de inputs()
+    const std::vector<Tensor>& replay();
+
+    const std::vector<Tensor>& inputs()  const noexcept;
+    const std::vector<Tensor>& outputs() const noexcept;
+
+    /// Noms des opérations, dans l'ordre d'exécution
+    std::vector<std::string> ops() const;
+    std::size_t num_ops() const noexcept;
+    /// Taille de l'arène des intermédiaires, et somme de leurs tailles sans
+    /// réemploi
+    std::size_t arena_bytes()   const noexcept;
+    std::size_t unpooled_bytes() const noexcept;
+
+    struct Impl;
+
+private:
+    explicit Graph(std::unique_ptr<Impl> impl);
+    std::unique_ptr<Impl> impl_;
+};
+
+} // namespace napcas
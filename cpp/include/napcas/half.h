@@ -0,0 +1,103 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+
+namespace napcas {
+
+// === Conversions binaires float32 <-> float16 / bfloat16 ===
+// Arrondi au plus proche, égalité vers le pair ; NaN et infinis préservés.
+
+inline std::uint16_t float_to_half_bits(float f) {
+    std::uint32_t x;
+    std::memcpy(&x, &f, sizeof(x));
+    const std::uint32_t sign = (x >> 16) & 0x8000u;
+    std::uint32_t mant = x & 0x7fffffu;
+    const std::int32_t exp = std::int32_t((x >> 23) & 0xffu);
+    if (exp == 0xff)
+        return std::uint16_t(sign | 0x7c00u | (mant ? 0x200u | (mant >> 13) : 0u));
+    const std::int32_t e = exp - 127 + 15;
+    if (e >= 0x1f)
+        return std::uint16_t(sign | 0x7c00u);                 // dépassement -> inf
+    if (e <= 0) {                                             // sous-normal ou zéro
+        if (e < -10) return std::uint16_t(sign);
+        mant |= 0x800000u;
+        const std::uint32_t shift   = std::uint32_t(14 - e);
+        std::uint32_t half_mant     = mant >> shift;
+        const std::uint32_t rem     = mant & ((1u << shift) - 1u);
+        const std::uint32_t halfway = 1u << (shift - 1);
+        if (rem > halfway || (rem == halfway && (half_mant & 1u))) ++half_mant;
+        return std::uint16_t(sign | half_mant);
+    }
+    std::uint32_t half = sign | (std::uint32_t(e) << 10) | (mant >> 13);
+    const std::uint32_t rem = mant & 0x1fffu;
+    if (rem > 0x1000u || (rem == 0x1000u && (half & 1u))) ++half;   // la retenue peut passer dans l'exposant
+    return std::uint16_t(half);
+}
+
+inline float half_bits_to_float(std::uint16_t h) {
+    const std::uint32_t sign = std::uint32_t(h & 0x8000u) << 16;
+    std::uint32_t exp  = (h >> 10) & 0x1fu;
+    std::uint32_t mant = h & 0x3ffu;
+    std::uint32_t bits;
+    if (exp == 0) {
+        if (mant == 0) {
+            bits = sign;
+        } else {                                              // sous-normal : normalisation
+            exp = 127 - 15 + 1;
+            while (!(mant & 0x400u)) { mant <<= 1; --exp; }
+            mant &= 0x3ffu;
+            bits = sign | (exp << 23) | (mant << 13);
+        }
+    } else if (exp == 0x1f) {
+        bits = sign | 0x7f800000u | (mant << 13);
+    } else {
+        bits = sign | ((exp + 112) << 23) | (mant << 13);
+    }
+    float f;
+    std::memcpy(&f, &bits, sizeof(f));
+    return f;
+}
+
+inline std::uint16_t float_to_bfloat16_bits(float f) {
+    std::uint32_t x;
+    std::memcpy(&x, &f, sizeof(x));
+    if ((x & 0x7fffffffu) > 0x7f800000u)
+        return std::uint16_t((x >> 16) | 0x40u);              // NaN silencieux
+    x += 0x7fffu + ((x >> 16) & 1u);
+    return std::uint16_t(x >> 16);
+}
+
+inline float bfloat16_bits_to_float(std::uint16_t b) {
+    const std::uint32_t x = std::uint32_t(b) << 16;
+    float f;
+    std::memcpy(&f, &x, sizeof(f));
+    return f;
+}
+
+// === Types de stockage 16 bits ===
+// L'arithmétique passe par float32 (conversions implicites dans les deux sens).
+
+struct Half {
+    std::uint16_t bits = 0;
+
+    Half() = default;
+    Half(float f) : bits(float_to_half_bits(f)) {}
+    operator float() const { return half_bits_to_float(bits); }
+
+    static Half from_bits(std::uint16_t b) { Half h; h.bits = b; return h; }
+};
+
+struct BFloat16 {
+    std::uint16_t bits = 0;
+
+    BFloat16() = default;
+    BFloat16(float f) : bits(float_to_bfloat16_bits(f)) {}
+    operator float() const { return bfloat16_bits_to_float(bits); }
+
+    static BFloat16 from_bits(std::uint16_t b) { BFloat16 h; h.bits = b; return h; }
+};
+
+static_assert(sizeof(Half) == 2 && sizeof(BFloat16) == 2, "16-bit storage types");
+
+} // namespace napcas
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+
+namespace napcas {
+namespace kernels {
+
+enum class Activation { None, ReLU, GELU, SiLU };
+
+/// f(x) en un point, en précision C (float ou double) ; sert aussi aux
+/// épilogues d'autres noyaux. GELU est la forme exacte x·Φ(x).
+template<typename C>
+inline C apply_activation(Activation act, C x) {
+    switch (act) {
+        case Activation::ReLU: return x > C(0) ? x : C(0);
+        case Activation::GELU: return C(0.5) * x * (C(1) + std::erf(x * C(0.70710678118654752440)));
+        case Activation::SiLU: return x / (C(1) + std::exp(-x));
+        case Activation::None: break;
+    }
+    return x;
+}
+
+/// out[i] = f(in[i]) sur `n` éléments denses, en une passe parallèle
+/// (float32 pour les types 16 bits). `out` peut être égal à `in`.
+template<typename T>
+void activation(Activation act, T* out, const T* in, std::size_t n);
+
+/// grad_in[i] = grad_out[i] · f'(x[i]). `saved` est la sortie de la passe
+/// avant pour ReLU (seul son signe compte), l'entrée pour GELU et SiLU.
+template<typename T>
+void activation_backward(Activation act, T* grad_in, const T* grad_out,
+                         const T* saved, std::size_t n);
+
+/// Rétropropagation d'une couche dense act(x·Wᵀ + b), matrice rows x cols
+/// dense : grad_in = grad_out · f'(saved) et grad_bias[j] = Σ_r grad_in[r, j]
+/// en une seule passe. Avec Activation::None, grad_in peut être nul (le
+/// gradient est grad_out lui-même) ; grad_bias nul omet la somme. Les
+/// sommes partielles par blocs de lignes sont combinées dans un ordre fixe.
+template<typename T>
+void activation_backward_bias(Activation act, T* grad_in, T* grad_bias, const T* grad_out,
+                              const T* saved, std::size_t rows, std::size_t cols);
+
+} // namespace kernels
+} // namespace napcas
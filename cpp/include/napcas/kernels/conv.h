@@ -0,0 +1,91 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace napcas {
+namespace kernels {
+
+/// Géométrie d'une convolution 2-D. Les noyaux travaillent en channels-last
+/// dense : entrée x [N, H, W, C], sortie y [N, OH, OW, K], poids
+/// [K, R, S, C/groups] (KRSC). La dimension contiguë est celle des canaux.
+struct Conv2dShape {
+    std::size_t N = 0, H = 0, W = 0, C = 0;   // entrée
+    std::size_t K = 0, R = 1, S = 1;          // K filtres de R x S
+    std::size_t stride_h = 1, stride_w = 1;
+    std::size_t pad_h    = 0, pad_w    = 0;
+    std::size_t dil_h    = 1, dil_w    = 1;
+    std::size_t groups   = 1;
+
+    std::size_t out_h() const noexcept { return (H + 2 * pad_h - dil_h * (R - 1) - 1) / stride_h + 1; }
+    std::size_t out_w() const noexcept { return (W + 2 * pad_w - dil_w * (S - 1) - 1) / stride_w + 1; }
+    std::size_t group_in()  const noexcept { return C / groups; }
+    std::size_t group_out() const noexcept { return K / groups; }
+};
+
+/// Algorithme du forward :
+///  - Im2col    : patchs empaquetés par lots d'images puis GEMM bloqué par
+///                groupe, biais en épilogue ; une convolution 1x1 sans pas
+///                ni padding lit l'entrée directement (pas d'im2col) ;
+///  - Depthwise : noyau direct NHWC (groups == C == K), boucle interne sur
+///                les canaux contigus ;
+///  - Winograd  : F(2x2, 3x3), pour 3x3, pas 1, dilatation 1, groups 1 :
+///                16 GEMM [tuiles, C] x [C, K] au lieu de 36 produits par
+///                tuile 2x2 (2,25 fois moins de multiplications).
+/// Auto choisit d'après la forme (voir select_conv_algorithm).
+enum class ConvAlgorithm { Auto, Im2col, Depthwise, Winograd };
+
+/// Vrai si `algo` sait traiter `p` (Im2col : toujours)
+bool conv_algorithm_supported(ConvAlgorithm algo, const Conv2dShape& p) noexcept;
+
+/// Résout Auto : Depthwise s'il s'applique, Winograd pour un 3x3 de pas 1
+/// avec assez de canaux pour amortir les transformées et assez de tuiles
+/// (N · ⌈OH/2⌉ · ⌈OW/2⌉) pour des GEMM bien remplis, Im2col sinon
+ConvAlgorithm select_conv_algorithm(const Conv2dShape& p) noexcept;
+
+/// y = conv(x, w) + bias (bias [K] facultatif). `algo` doit être supporté
+/// (Auto est résolu ici). T = float ou double.
+template<typename T>
+void conv2d_forward(const Conv2dShape& p, ConvAlgorithm algo,
+                    const T* x, const T* w, const T* bias, T* y);
+
+/// dx [N, H, W, C] = gradient de l'entrée (écrasé) à partir de dy et w
+template<typename T>
+void conv2d_backward_input(const Conv2dShape& p, const T* dy, const T* w, T* dx);
+
+/// dw [K, R, S, C/groups] (écrasé) à partir de dy et x ; db [K] (écrasé).
+/// Chacun est ignoré s'il est nul.
+template<typename T>
+void conv2d_backward_weight(const Conv2dShape& p, const T* dy, const T* x, T* dw, T* db);
+
+/// Géométrie d'un pooling 2-D, NHWC dense comme Conv2dShape ; le padding
+/// ne dépasse pas la moitié de la fenêtre (toute fenêtre a un élément réel)
+struct Pool2dShape {
+    std::size_t N = 0, H = 0, W = 0, C = 0;
+    std::size_t R = 1, S = 1;
+    std::size_t stride_h = 1, stride_w = 1;
+    std::size_t pad_h    = 0, pad_w    = 0;
+
+    std::size_t out_h() const noexcept { return (H + 2 * pad_h - R) / stride_h + 1; }
+    std::size_t out_w() const noexcept { return (W + 2 * pad_w - S) / stride_w + 1; }
+};
+
+/// Maximum par fenêtre (NaN propagé). `indices` (facultatif) reçoit la
+/// position ih * W + iw du maximum dans son image.
+template<typename T>
+void max_pool2d(const Pool2dShape& p, const T* x, T* y, std::int64_t* indices);
+
+/// dx (écrasé) : chaque gradient va à la position retenue par max_pool2d
+template<typename T>
+void max_pool2d_backward(const Pool2dShape& p, const T* dy, const std::int64_t* indices, T* dx);
+
+/// Moyenne par fenêtre ; le diviseur compte le padding si
+/// `count_include_pad`, sinon les seuls éléments réels
+template<typename T>
+void avg_pool2d(const Pool2dShape& p, bool count_include_pad, const T* x, T* y);
+
+template<typename T>
+void avg_pool2d_backward(const Pool2dShape& p, bool count_include_pad, const T* dy, T* dx);
+
+} // namespace kernels
+} // namespace napcas
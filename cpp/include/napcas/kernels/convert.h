@@ -0,0 +1,18 @@
+#pragma once
+
+#include "napcas/common.h"
+#include <cstddef>
+
+namespace napcas {
+namespace kernels {
+
+/// Convertit `n` éléments denses de `src` (type `src_dtype`) vers `dst`
+/// (type `dst_dtype`), en parallèle. float32 <-> float16/bfloat16 passe par
+/// des noyaux vectorisés (F16C/AVX-512 selon cpu_capability()) ; les autres
+/// couples avec un type 16 bits transitent par float32 par blocs. Flottant
+/// vers entier tronque vers zéro et sature aux bornes du type (NaN : 0).
+void convert(void* dst, DType dst_dtype,
+             const void* src, DType src_dtype, std::size_t n);
+
+} // namespace kernels
+} // namespace napcas
@@ -0,0 +1,27 @@
+#pragma once
+
+// Noyaux de conversion float32 <-> 16 bits par jeu d'instructions, définis
+// dans convert_<isa>.cpp (même organisation que elementwise_isa.h).
+
+#include "napcas/half.h"
+#include <cstddef>
+
+namespace napcas {
+namespace kernels {
+
+struct ConvertKernels {
+    void (*f32_to_f16) (const float* src, Half* dst,     std::size_t n);
+    void (*f16_to_f32) (const Half* src,  float* dst,    std::size_t n);
+    void (*f32_to_bf16)(const float* src, BFloat16* dst, std::size_t n);
+    void (*bf16_to_f32)(const BFloat16* src, float* dst, std::size_t n);
+};
+
+const ConvertKernels& convert_kernels_scalar();
+const ConvertKernels& convert_kernels_avx2();
+const ConvertKernels& convert_kernels_avx512();
+
+/// Table correspondant à cpu_capability()
+const ConvertKernels& convert_kernels();
+
+} // namespace kernels
+} // namespace napcas
@@ -0,0 +1,26 @@
+#pragma once
+
+#include "napcas/small_vector.h"
+#include <cstddef>
+#include <vector>
+
+namespace napcas {
+namespace kernels {
+
+/// Copie les éléments d'une géométrie (shape, src_strides) quelconque vers
+/// un buffer dense row-major `dst`. Les strides sont en éléments de
+/// `elem_size` octets.
+///
+/// Les dimensions compatibles sont d'abord fusionnées, puis le noyau choisit :
+///  - memcpy par lignes si la dimension interne source est contiguë ;
+///  - transposition par tuiles si une autre dimension est contiguë
+///    (cas 2D et des deux dernières dimensions permutées) ;
+///  - boucle à pas constant sinon.
+/// Les grandes copies sont réparties sur plusieurs threads.
+void strided_copy(void* dst, const void* src,
+                  const Shape&   shape,
+                  const Strides& src_strides,
+                  std::size_t elem_size);
+
+} // namespace kernels
+} // namespace napcas
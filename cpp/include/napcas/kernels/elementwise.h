@@ -0,0 +1,49 @@
+#pragma once
+
+#include "napcas/small_vector.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace napcas {
+namespace kernels {
+
+enum class BinaryOp { Add, Sub, Mul, Div };
+
+/// out = a op b avec broadcasting. `a_strides` et `b_strides` sont alignés
+/// sur `out_shape` (stride 0 pour une dimension diffusée) et `out` est dense.
+/// Les dimensions sont fusionnées puis chaque ligne interne passe par un
+/// noyau vectorisé (SSE2/AVX2/AVX-512 selon cpu_capability()) :
+/// vecteur/vecteur, vecteur/scalaire ou scalaire/vecteur ; une boucle à pas
+/// quelconque sinon. Instancié pour chaque type de dispatch.h : float16 et
+/// bfloat16 calculent en float32 par blocs, les entiers débordent en
+/// complément à deux.
+template<typename T>
+void binary_op(BinaryOp op, T* out, const T* a, const T* b,
+               const Shape&   out_shape,
+               const Strides& a_strides,
+               const Strides& b_strides);
+
+/// Variante à sortie quelconque (vue, opération en place) : `out_strides`
+/// est aligné sur `out_shape`. `out` peut désigner les mêmes éléments que
+/// `a` ou `b` (même géométrie) ; un recouvrement partiel n'est pas détecté.
+template<typename T>
+void binary_op(BinaryOp op, T* out, const T* a, const T* b,
+               const Shape&   out_shape,
+               const Strides& out_strides,
+               const Strides& a_strides,
+               const Strides& b_strides);
+
+/// Remplit `n` éléments de `elem_size` octets avec `value` (en parallèle)
+void fill(void* dst, const void* value, std::size_t n, std::size_t elem_size);
+
+/// Réduction inverse du broadcasting : `out` (dense, initialisé à zéro)
+/// accumule `in` (dense, de forme `in_shape`). `out_strides` est aligné sur
+/// `in_shape` avec 0 sur chaque dimension qui doit être sommée.
+template<typename T>
+void sum_to(T* out, const T* in,
+            const Shape&   in_shape,
+            const Strides& out_strides);
+
+} // namespace kernels
+} // namespace napcas
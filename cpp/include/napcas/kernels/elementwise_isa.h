@@ -0,0 +1,58 @@
+#pragma once
+
+// Tables de noyaux 1D par jeu d'instructions. Chaque table est définie dans
+// sa propre unité de compilation (elementwise_<isa>.cpp) compilée avec les
+// drapeaux correspondants ; elle ne doit être utilisée que si
+// cpu_capability() l'autorise.
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace napcas {
+namespace kernels {
+
+/// Division entière définie pour toutes les entrées, partagée par les
+/// tables de chaque jeu d'instructions : x / 0 vaut 0 et MIN / -1 déborde
+/// en complément à deux (MIN), au lieu d'un SIGFPE
+template<typename T>
+inline T int_div(T x, T y) {
+    if (y == T(0)) return T(0);
+    if constexpr (std::is_signed_v<T>) {
+        using U = std::make_unsigned_t<T>;
+        if (y == T(-1)) return T(U(0) - U(x));
+    }
+    return T(x / y);
+}
+
+/// `c` peut être exactement `a` ou `b` (écriture en place), pas un
+/// recouvrement partiel
+template<typename T>
+struct BinaryRowKernels {
+    // index = BinaryOp (Add, Sub, Mul, Div)
+    void (*vv[4])(T* c, const T* a, const T* b, std::size_t n);
+    void (*vs[4])(T* c, const T* a, T s,        std::size_t n);
+    void (*sv[4])(T* c, T s,        const T* b, std::size_t n);
+};
+
+struct BinaryKernels {
+    BinaryRowKernels<float>        f32;
+    BinaryRowKernels<std::int32_t> i32;
+};
+
+const BinaryKernels& binary_kernels_scalar();
+const BinaryKernels& binary_kernels_sse2();
+const BinaryKernels& binary_kernels_avx2();
+const BinaryKernels& binary_kernels_avx512();
+
+/// Table correspondant à cpu_capability()
+const BinaryKernels& binary_kernels();
+
+/// Noyaux 1D pour n'importe quel type de dispatch.h (instanciés dans
+/// elementwise.cpp) : table SIMD courante pour float32/int32, blocs
+/// convertis en float32 pour float16/bfloat16, boucles portables sinon.
+template<typename T>
+const BinaryRowKernels<T>& binary_row_kernels();
+
+} // namespace kernels
+} // namespace napcas
@@ -0,0 +1,45 @@
+#pragma once
+
+#include "napcas/common.h"
+#include "napcas/kernels/elementwise.h"
+#include <cstddef>
+#include <vector>
+
+namespace napcas {
+namespace kernels {
+
+/// Opérande d'un programme fusionné : strides alignés sur la forme de sortie
+/// (0 sur les dimensions diffusées), type quelconque.
+struct FusedOperand {
+    const void*                 data;
+    DType                       dtype;
+    Strides                     strides;
+};
+
+/// Registres : [0, operands) pour les opérandes, puis les constantes, puis
+/// le résultat de chaque instruction dans l'ordre. Le résultat du programme
+/// est le dernier registre.
+struct FusedInstr {
+    BinaryOp op;
+    int      lhs;
+    int      rhs;
+};
+
+struct FusedProgram {
+    std::vector<FusedOperand> operands;
+    std::vector<double>       constants;
+    std::vector<FusedInstr>   code;
+};
+
+/// Évalue `prog` en une seule passe sur `out` (dense, de type `out_dtype`).
+/// Les dimensions sont fusionnées pour tous les opérandes à la fois, puis
+/// chaque segment de ligne est traité par blocs tenant en L1 : un opérande
+/// contigu du bon type est lu en place, les autres sont rassemblés et
+/// convertis dans un tampon, et chaque instruction passe par les noyaux 1D
+/// vectorisés. Le calcul se fait en float32 pour float16/bfloat16, dans le
+/// type de sortie sinon.
+void fused_eval(const FusedProgram& prog, void* out, DType out_dtype,
+                const Shape& out_shape);
+
+} // namespace kernels
+} // namespace napcas
@@ -0,0 +1,75 @@
+#pragma once
+
+#include "napcas/kernels/activation.h"
+#include <cstddef>
+#include <type_traits>
+
+namespace napcas {
+namespace kernels {
+
+/// Épilogue d'un GEMM : C = act(C + bias[j]), appliqué à chaque tuile
+/// juste après son dernier panneau K, tant qu'elle est encore en L1 (pas
+/// de seconde passe sur C). `bias` (N valeurs, une par colonne) est
+/// facultatif.
+template<typename T>
+struct GemmEpilogue {
+    const T*   bias = nullptr;
+    Activation act  = Activation::None;
+
+    bool empty() const noexcept { return bias == nullptr && act == Activation::None; }
+};
+
+/// Description d'une matrice float32 par ses strides (en éléments) : un
+/// opérande transposé ou issu d'une vue se décrit sans être matérialisé.
+struct MatrixRef {
+    const float*   data;
+    std::ptrdiff_t row_stride;
+    std::ptrdiff_t col_stride;
+};
+
+/// C[M,N] (row-major, pas de ligne ldc) = A[M,K] * B[K,N], ou C += A*B si
+/// `accumulate`. Bloquage de type BLIS : panneaux de A et B empaquetés,
+/// micro-noyau MRxNR vectorisé (AVX2/AVX-512 selon cpu_capability()) et
+/// tuiles MCxNC réparties sur le pool de threads.
+void gemm(std::size_t M, std::size_t N, std::size_t K,
+          MatrixRef A, MatrixRef B,
+          float* C, std::ptrdiff_t ldc, bool accumulate = false,
+          const GemmEpilogue<float>& epilogue = {});
+
+/// Produit par lot : `batch` produits indépendants, les offsets (en
+/// éléments) de chaque opérande étant donnés par lot. Parallélise sur les
+/// lots quand ils sont assez nombreux, sinon à l'intérieur de chaque GEMM.
+void gemm_batched(std::size_t batch, std::size_t M, std::size_t N, std::size_t K,
+                  MatrixRef A, const std::ptrdiff_t* a_offsets,
+                  MatrixRef B, const std::ptrdiff_t* b_offsets,
+                  float* C, std::ptrdiff_t ldc, std::ptrdiff_t c_batch_stride,
+                  const GemmEpilogue<float>& epilogue = {});
+
+/// Matrice float64 décrite par ses strides
+struct MatrixRefF64 {
+    const double*  data;
+    std::ptrdiff_t row_stride;
+    std::ptrdiff_t col_stride;
+};
+
+/// MatrixRef ou MatrixRefF64 selon le type de calcul
+template<typename T>
+using matrix_ref_t = std::conditional_t<std::is_same<T, double>::value, MatrixRefF64, MatrixRef>;
+
+/// Variante float64 de gemm, sans empaquetage (voir gemm_batched float64)
+void gemm(std::size_t M, std::size_t N, std::size_t K,
+          MatrixRefF64 A, MatrixRefF64 B,
+          double* C, std::ptrdiff_t ldc, bool accumulate = false,
+          const GemmEpilogue<double>& epilogue = {});
+
+/// Variante float64 de gemm_batched, sans empaquetage : boucles i-p-j
+/// (ligne de B parcourue contiguëment quand col_stride == 1), lignes de C
+/// réparties sur le pool de threads.
+void gemm_batched(std::size_t batch, std::size_t M, std::size_t N, std::size_t K,
+                  MatrixRefF64 A, const std::ptrdiff_t* a_offsets,
+                  MatrixRefF64 B, const std::ptrdiff_t* b_offsets,
+                  double* C, std::ptrdiff_t ldc, std::ptrdiff_t c_batch_stride,
+                  const GemmEpilogue<double>& epilogue = {});
+
+} // namespace kernels
+} // namespace napcas
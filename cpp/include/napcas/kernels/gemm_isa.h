@@ -0,0 +1,28 @@
+#pragma once
+
+// Micro-noyaux GEMM par jeu d'instructions (voir gemm_<isa>.cpp).
+// Un micro-noyau calcule une tuile MRxNR de C à partir d'un panneau de A
+// empaqueté (kc x MR, MR contigus) et d'un panneau de B (kc x NR).
+
+#include <cstddef>
+
+namespace napcas {
+namespace kernels {
+
+struct GemmMicroKernel {
+    std::size_t mr;
+    std::size_t nr;
+    // c[i*ldc + j] (+)= sum_p a[p*mr + i] * b[p*nr + j]
+    void (*fn)(std::size_t kc, const float* a, const float* b,
+               float* c, std::ptrdiff_t ldc, bool accumulate);
+};
+
+GemmMicroKernel gemm_kernel_scalar();
+GemmMicroKernel gemm_kernel_avx2();
+GemmMicroKernel gemm_kernel_avx512();
+
+/// Micro-noyau correspondant à cpu_capability()
+GemmMicroKernel gemm_kernel();
+
+} // namespace kernels
+} // namespace napcas
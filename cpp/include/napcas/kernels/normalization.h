@@ -0,0 +1,52 @@
+#pragma once
+
+#include "napcas/dispatch.h"
+#include <cstddef>
+
+namespace napcas {
+namespace kernels {
+
+// Noyaux par ligne : `rows` lignes denses de `cols` éléments (dernière
+// dimension). Calcul en compute_type_t<T> ; les statistiques par ligne
+// sauvegardées pour la rétropropagation sont de ce type.
+
+/// softmax (ou log-softmax) de chaque ligne : maximum et somme des
+/// exponentielles obtenus en une passe (maximum courant par blocs), puis une
+/// passe d'écriture.
+template<typename T>
+void softmax(T* out, const T* in, std::size_t rows, std::size_t cols, bool log);
+
+/// À partir de la sortie y : dx = y·(dy - Σ dy·y) pour softmax,
+/// dx = dy - exp(y)·Σ dy pour log-softmax.
+template<typename T>
+void softmax_backward(T* grad_in, const T* grad_out, const T* out,
+                      std::size_t rows, std::size_t cols, bool log);
+
+/// y = (x - moyenne)·rstd·weight + bias ; weight et bias peuvent être nuls.
+/// Moyenne et variance en deux passes sur la ligne ; `mean` et `rstd`
+/// reçoivent une valeur par ligne.
+template<typename T>
+void layer_norm(T* out, compute_type_t<T>* mean, compute_type_t<T>* rstd,
+                const T* in, const T* weight, const T* bias,
+                std::size_t rows, std::size_t cols, double eps);
+
+/// grad_weight et grad_bias (nuls si non demandés) sont sommés sur les
+/// lignes par blocs fixes, dans un ordre indépendant du nombre de threads.
+template<typename T>
+void layer_norm_backward(T* grad_in, T* grad_weight, T* grad_bias,
+                         const T* grad_out, const T* in, const T* weight,
+                         const compute_type_t<T>* mean, const compute_type_t<T>* rstd,
+                         std::size_t rows, std::size_t cols);
+
+/// y = x·rstd·weight avec rstd = 1 / sqrt(moyenne(x²) + eps)
+template<typename T>
+void rms_norm(T* out, compute_type_t<T>* rstd, const T* in, const T* weight,
+              std::size_t rows, std::size_t cols, double eps);
+
+template<typename T>
+void rms_norm_backward(T* grad_in, T* grad_weight, const T* grad_out,
+                       const T* in, const T* weight, const compute_type_t<T>* rstd,
+                       std::size_t rows, std::size_t cols);
+
+} // namespace kernels
+} // namespace napcas
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstddef>
+
+namespace napcas {
+namespace kernels {
+
+/// Hyperparamètres d'un pas de SGD, appliqués élément par élément :
+///
+///     g = grad_scale · g + weight_decay · p
+///     b = momentum · b + g ;  g = nesterov ? g + momentum · b : b
+///     p = p - lr · g
+///
+/// (sans tampon de moment, g est appliqué directement)
+struct SgdStep {
+    float lr           = 0.01f;
+    float momentum     = 0.0f;
+    float weight_decay = 0.0f;
+    float grad_scale   = 1.0f;   // écrêtage par norme globale
+    bool  nesterov     = false;
+};
+
+/// Hyperparamètres d'un pas d'Adam, corrections de biais précalculées :
+///
+///     g = grad_scale · g + l2 · p
+///     m = β1 · m + (1 - β1) · g ;  v = β2 · v + (1 - β2) · g²
+///     p = decay · p - step_size · m / (√v · inv_sqrt_bc2 + eps)
+///
+/// avec step_size = lr / (1 - β1ᵗ), inv_sqrt_bc2 = 1 / √(1 - β2ᵗ). Adam
+/// met la pénalité dans le gradient (l2 = weight_decay, decay = 1), AdamW
+/// la découple (l2 = 0, decay = 1 - lr · weight_decay).
+struct AdamStep {
+    float beta1        = 0.9f;
+    float beta2        = 0.999f;
+    float eps          = 1e-8f;
+    float step_size    = 1e-3f;
+    float inv_sqrt_bc2 = 1.0f;
+    float l2           = 0.0f;
+    float decay        = 1.0f;
+    float grad_scale   = 1.0f;
+};
+
+/// Mise à jour fusionnée de `n` paramètres float32 en une passe : p et
+/// l'état sont lus et écrits une fois, g lu une fois. `momentum_buf` est
+/// ignoré (et peut être nul) si s.momentum == 0.
+void sgd_update(float* p, const float* g, float* momentum_buf, std::size_t n, const SgdStep& s);
+void adam_update(float* p, const float* g, float* m, float* v, std::size_t n, const AdamStep& s);
+
+/// Σ x² sur `n` éléments (accumulateurs float32 par voie, total en double)
+double sum_squares(const float* x, std::size_t n);
+
+} // namespace kernels
+} // namespace napcas
@@ -0,0 +1,26 @@
+#pragma once
+
+// Noyaux des optimiseurs par jeu d'instructions (voir optim_<isa>.cpp),
+// à n'utiliser que si cpu_capability() l'autorise.
+
+#include "napcas/kernels/optim.h"
+#include <cstddef>
+
+namespace napcas {
+namespace kernels {
+
+struct OptimKernels {
+    void   (*sgd)(float* p, const float* g, float* buf, std::size_t n, const SgdStep& s);
+    void   (*adam)(float* p, const float* g, float* m, float* v, std::size_t n, const AdamStep& s);
+    double (*sum_squares)(const float* x, std::size_t n);
+};
+
+const OptimKernels& optim_kernels_scalar();
+const OptimKernels& optim_kernels_avx2();
+const OptimKernels& optim_kernels_avx512();
+
+/// Table correspondant à cpu_capability() (SSE2 utilise la version portable)
+const OptimKernels& optim_kernels();
+
+} // namespace kernels
+} // namespace napcas
@@ -0,0 +1,66 @@
+#pragma once
+
+#include "napcas/kernels/gemm.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace napcas {
+namespace kernels {
+
+/// Poids int8 d'une couche linéaire W [N, K], quantifiés par canal de
+/// sortie (symétrique : w ≈ scale[n] · q, q ∈ [-127, 127]) et empaquetés
+/// pour les micro-noyaux : panneaux de kQGemmNR colonnes n, puis groupes
+/// de 4 k consécutifs, soit 4 octets contigus par (groupe, colonne) :
+///
+///     packed[((n / NR) · Kp / 4 + k / 4) · NR · 4 + (n % NR) · 4 + k % 4]
+///
+/// K est complété à Kp (multiple de 4) et N au panneau par des zéros.
+struct QuantizedWeight {
+    std::size_t N = 0, K = 0, Kp = 0;
+    std::vector<std::int8_t>  packed;
+    std::vector<float>        scales;     // [N]
+    std::vector<std::int32_t> col_sums;   // [N] Σ_k q[n, k] (point zéro)
+};
+
+/// Colonnes par panneau : une ligne de 16 accumulateurs int32 (un ZMM,
+/// deux YMM)
+constexpr std::size_t kQGemmNR = 16;
+/// Borne de K : |Σ a · q| ≤ K · 255 · 127 doit tenir sur un int32
+constexpr std::size_t kQGemmMaxK = 65536;
+
+/// Quantifie et empaquette W [N, K] (lu via ses strides)
+QuantizedWeight quantize_weight(std::size_t N, std::size_t K, MatrixRef W);
+
+/// W déquantifié [N, K] row-major (scale[n] · q), pour mesurer l'erreur
+void dequantize_weight(const QuantizedWeight& w, float* out);
+
+/// Quantification asymétrique des activations, choisie dynamiquement sur
+/// le lot : a = round(clamp(x / scale + zero_point, 0, qmax)). L'intervalle
+/// [min, max] du lot, étendu à 0, couvre [0, qmax].
+struct ActivationQuant {
+    float        scale      = 1.0f;
+    std::int32_t zero_point = 0;
+    std::int32_t qmax       = 255;
+};
+
+/// Valeur maximale des activations quantifiées pour le micro-noyau courant :
+/// 255 (VNNI, portable) ou 127 (AVX2 : vpmaddubsw additionne deux produits
+/// u8 · s8 en int16 saturé ; sur 7 bits, 2 · 127 · 127 ne sature pas)
+std::int32_t qgemm_activation_max();
+
+/// Nom du micro-noyau courant : "avx512_vnni", "avx2" ou "scalar"
+const char* qgemm_kernel_name();
+
+/// C[M, N] = act(dequant(quant(A) · Wᵀ) + bias) : A [M, K] float32 est
+/// quantifié sur tout le lot (ActivationQuant), le produit accumulé en
+/// int32, puis chaque tuile est déquantifiée (scale_a · scale_w[n] ·
+/// (acc - zero_point · col_sums[n])), biaisée et activée tant qu'elle est
+/// en cache (épilogue fusionné, voir GemmEpilogue). `quant`, s'il est non
+/// nul, reçoit les paramètres choisis.
+void qgemm(std::size_t M, MatrixRef A, const QuantizedWeight& W,
+           float* C, std::ptrdiff_t ldc, const GemmEpilogue<float>& epilogue = {},
+           ActivationQuant* quant = nullptr);
+
+} // namespace kernels
+} // namespace napcas
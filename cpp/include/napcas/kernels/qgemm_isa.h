@@ -0,0 +1,31 @@
+#pragma once
+
+// Micro-noyaux GEMM int8 par jeu d'instructions (voir qgemm_<isa>.cpp).
+// Un micro-noyau calcule une tuile rows x kQGemmNR (rows ≤ mr) d'entiers
+// int32 à partir de lignes de A quantifiées (u8, lda octets entre lignes)
+// et d'un panneau de W empaqueté (kg groupes de 4 k, voir QuantizedWeight).
+
+#include <cstddef>
+#include <cstdint>
+
+namespace napcas {
+namespace kernels {
+
+struct QGemmMicroKernel {
+    std::size_t  mr;
+    std::int32_t a_max;   // borne des activations u8 acceptée par le noyau
+    // c[i*16 + j] = sum_k a[i*lda + k] * b[(k/4)*64 + j*4 + k%4], i < rows
+    void (*fn)(std::size_t rows, std::size_t kg, const std::uint8_t* a,
+               std::ptrdiff_t lda, const std::int8_t* b, std::int32_t* c);
+    const char* name;
+};
+
+QGemmMicroKernel qgemm_kernel_scalar();
+QGemmMicroKernel qgemm_kernel_avx2();
+QGemmMicroKernel qgemm_kernel_avx512_vnni();
+
+/// Micro-noyau correspondant à cpu_capability() (et à cpu_has_avx512_vnni)
+QGemmMicroKernel qgemm_kernel();
+
+} // namespace kernels
+} // namespace napcas
@@ -0,0 +1,72 @@
+#pragma once
+
+#include "napcas/small_vector.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace napcas {
+namespace kernels {
+
+enum class ReduceOp { Sum, Mean, Max, Min, LogSumExp };
+
+/// Réduction de `in` (géométrie quelconque) sur les axes où `reduce_axes`
+/// est vrai ; `out` est dense sur les axes conservés, dans leur ordre.
+///
+/// Les axes conservés et réduits sont fusionnés séparément, puis :
+///  - axe réduit interne contigu : chaque sortie réduit des segments
+///    contigus (sommes par paires sur 8 accumulateurs, vectorisables) ;
+///  - axe conservé interne contigu : les lignes réduites sont accumulées
+///    dans un bloc de sorties (par blocs de lignes pour la précision) ;
+///  - boucle à pas quelconque sinon.
+/// Les sorties sont réparties entre threads ; s'il y en a trop peu (ex.
+/// réduction complète), l'ensemble réduit est découpé et les résultats
+/// partiels sont fusionnés dans l'ordre. Max/Min propagent NaN et lèvent
+/// une exception sur un ensemble vide ; Mean/LogSumExp calculent en float32
+/// (float64 pour double).
+template<typename T>
+void reduce(ReduceOp op, T* out, const T* in,
+            const Shape&   shape,
+            const Strides& strides,
+            const std::vector<bool>&           reduce_axes);
+
+/// Somme d'un type entier, accumulée et écrite en int64 : le résultat ne
+/// déborde pas le type d'entrée (ex. 200 × int8 100)
+template<typename T>
+void sum_int64(std::int64_t* out, const T* in,
+               const Shape&   shape,
+               const Strides& strides,
+               const std::vector<bool>&           reduce_axes);
+
+/// Indice (linéaire dans les axes réduits, ordre row-major) du maximum ou
+/// du minimum ; la première occurrence l'emporte, NaN compte comme maximum.
+template<typename T>
+void arg_reduce(bool is_max, std::int64_t* out, const T* in,
+                const Shape&   shape,
+                const Strides& strides,
+                const std::vector<bool>&           reduce_axes);
+
+/// Variance (ou écart-type si `take_sqrt`) avec `correction` degrés de
+/// liberté retirés : moyenne et écart quadratique par blocs en deux passes,
+/// blocs fusionnés par la formule de Chan. Accumulation en float64.
+template<typename T>
+void variance(T* out, const T* in,
+              const Shape&   shape,
+              const Strides& strides,
+              const std::vector<bool>&           reduce_axes,
+              std::size_t correction, bool take_sqrt);
+
+/// Inverse de arg_reduce pour le gradient : `grad_in` (dense de forme
+/// `shape`, initialisé à zéro) reçoit g[o] à la position idx[o].
+template<typename T>
+void scatter_reduced(T* grad_in, const T* g, const std::int64_t* idx,
+                     const Shape& shape,
+                     const std::vector<bool>&        reduce_axes);
+
+/// out[i] = exp(in[i]) sur `n` éléments denses (calcul en float32 pour les
+/// types 16 bits), en parallèle
+template<typename T>
+void exp(T* out, const T* in, std::size_t n);
+
+} // namespace kernels
+} // namespace napcas
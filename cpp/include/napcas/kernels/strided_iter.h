@@ -0,0 +1,105 @@
+#pragma once
+
+#include "napcas/small_vector.h"
+#include <array>
+#include <cstddef>
+#include <vector>
+
+namespace napcas {
+namespace kernels {
+
+/// Géométrie partagée par N opérandes de même forme logique
+template<std::size_t N>
+struct StridedGeometry {
+    Shape shape;
+    std::array<Strides, N> strides;
+
+    std::size_t ndim() const noexcept { return shape.size(); }
+    std::size_t inner() const noexcept { return shape.empty() ? 1 : shape.back(); }
+    std::size_t rows() const noexcept {
+        std::size_t n = 1;
+        for (std::size_t d = 0; d + 1 < shape.size(); ++d) n *= shape[d];
+        return n;
+    }
+    std::ptrdiff_t inner_stride(std::size_t k) const noexcept {
+        return shape.empty() ? 0 : strides[k].back();
+    }
+};
+
+/// Supprime les dimensions de taille 1 et fusionne deux dimensions voisines
+/// lorsqu'elles sont contiguës pour les N opérandes à la fois.
+template<std::size_t N>
+StridedGeometry<N> coalesce(const Shape& shape,
+                            const std::array<const Strides*, N>& strides) {
+    StridedGeometry<N> g;
+    for (std::size_t d = 0; d < shape.size(); ++d) {
+        if (shape[d] == 1) continue;
+        bool merge = !g.shape.empty();
+        for (std::size_t k = 0; k < N && merge; ++k)
+            merge = g.strides[k].back() ==
+                    (*strides[k])[d] * std::ptrdiff_t(shape[d]);
+        if (merge) {
+            g.shape.back() *= shape[d];
+            for (std::size_t k = 0; k < N; ++k)
+                g.strides[k].back() = (*strides[k])[d];
+            continue;
+        }
+        g.shape.push_back(shape[d]);
+        for (std::size_t k = 0; k < N; ++k)
+            g.strides[k].push_back((*strides[k])[d]);
+    }
+    return g;
+}
+
+/// Appelle fn(offsets) pour chaque ligne d'indice [begin, end), une ligne
+/// couvrant la dernière dimension ; offsets[k] est l'offset (en éléments)
+/// du début de ligne pour l'opérande k.
+template<std::size_t N, typename F>
+void for_each_row(const StridedGeometry<N>& g, std::size_t begin, std::size_t end, F&& fn) {
+    if (begin >= end) return;
+    const int outer = int(g.shape.size()) - 1;
+    Shape idx(outer > 0 ? outer : 0, 0);
+    std::array<std::ptrdiff_t, N> off{};
+    std::size_t lin = begin;
+    for (int d = outer - 1; d >= 0; --d) {
+        idx[d] = lin % g.shape[d];
+        lin /= g.shape[d];
+        for (std::size_t k = 0; k < N; ++k)
+            off[k] += std::ptrdiff_t(idx[d]) * g.strides[k][d];
+    }
+    for (std::size_t r = begin; r < end; ++r) {
+        fn(off);
+        for (int d = outer - 1; d >= 0; --d) {
+            if (++idx[d] < g.shape[d]) {
+                for (std::size_t k = 0; k < N; ++k) off[k] += g.strides[k][d];
+                break;
+            }
+            for (std::size_t k = 0; k < N; ++k)
+                off[k] -= g.strides[k][d] * std::ptrdiff_t(g.shape[d] - 1);
+            idx[d] = 0;
+        }
+    }
+}
+
+/// Variante par éléments : parcourt les éléments d'indice linéaire
+/// [begin, end) ligne par ligne et appelle fn(offsets, col, len) pour chaque
+/// segment de ligne (colonnes [col, col + len)). Permet de découper une
+/// seule longue ligne entre plusieurs threads.
+template<std::size_t N, typename F>
+void for_each_segment(const StridedGeometry<N>& g, std::size_t begin, std::size_t end, F&& fn) {
+    if (begin >= end) return;
+    const std::size_t n = g.inner();
+    const std::size_t row_begin = begin / n;
+    const std::size_t row_end   = (end + n - 1) / n;
+    std::size_t row = row_begin;
+    for_each_row(g, row_begin, row_end, [&](const std::array<std::ptrdiff_t, N>& off) {
+        const std::size_t first = row * n;
+        const std::size_t col   = begin > first ? begin - first : 0;
+        const std::size_t stop  = end < first + n ? end - first : n;
+        fn(off, col, stop - col);
+        ++row;
+    });
+}
+
+} // namespace kernels
+} // namespace napcas
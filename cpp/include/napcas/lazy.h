@@ -0,0 +1,61 @@
+#pragma once
+
+#include "napcas/common.h"
+#include "napcas/tensor.h"
+#include "napcas/kernels/elementwise.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace napcas {
+
+/// Expression élément par élément différée. Les opérateurs construisent un
+/// graphe (feuilles Tensor, constantes, opérations binaires) sans rien
+/// calculer ; eval() le compile en un programme fusionné exécuté en une
+/// seule passe, avec une seule allocation pour le résultat :
+///
+///     Tensor y = ((LazyTensor(a) + b) * c - d).eval();
+///
+/// Broadcasting et promotion de type suivent les opérateurs de Tensor ; une
+/// constante ne change pas le type d'un tenseur, sauf une constante flottante
+/// (`2.0`, pas `2`) appliquée à un tenseur entier (résultat float32). Les
+/// résultats intermédiaires du type final sont calculés dans ce type
+/// (float32 pour float16/bfloat16), sans arrondi à chaque étape ; un
+/// sous-graphe d'un autre type (ex. `i / j` entiers dans une expression
+/// float) est évalué à part dans son propre type, comme par les opérateurs
+/// de Tensor. Le résultat est alloué sur le périphérique des feuilles. Si
+/// une feuille requiert un gradient, eval() rejoue les opérations de façon
+/// classique pour que l'autograd enregistre le graphe.
+class LazyTensor {
+public:
+    LazyTensor(const Tensor& tensor);
+    LazyTensor(int value);
+    LazyTensor(std::int64_t value);
+    LazyTensor(double value);
+
+    const Shape& shape() const noexcept;
+    DType dtype() const noexcept;
+    bool  requires_grad() const noexcept;
+
+    Tensor eval() const;
+
+    friend LazyTensor operator+(const LazyTensor& a, const LazyTensor& b);
+    friend LazyTensor operator-(const LazyTensor& a, const LazyTensor& b);
+    friend LazyTensor operator*(const LazyTensor& a, const LazyTensor& b);
+    friend LazyTensor operator/(const LazyTensor& a, const LazyTensor& b);
+
+private:
+    struct Node;
+    explicit LazyTensor(std::shared_ptr<const Node> node);
+    static LazyTensor binary(kernels::BinaryOp op, const LazyTensor& a, const LazyTensor& b);
+
+    std::shared_ptr<const Node> node_;
+};
+
+LazyTensor operator+(const LazyTensor& a, const LazyTensor& b);
+LazyTensor operator-(const LazyTensor& a, const LazyTensor& b);
+LazyTensor operator*(const LazyTensor& a, const LazyTensor& b);
+LazyTensor operator/(const LazyTensor& a, const LazyTensor& b);
+
+} // namespace napcas
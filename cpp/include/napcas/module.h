@@ -0,0 +1,56 @@
+#pragma once
+
+#include "napcas/tensor.h"
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace napcas {
+
+/// Base des couches : paramètres et sous-modules nommés, dans l'ordre
+/// d'enregistrement. Les paramètres sont des Tensor partageant le Storage
+/// des membres de la couche : une mise à jour en place (optimiseur,
+/// load_state_dict) est vue par forward().
+class Module {
+public:
+    virtual ~Module() = default;
+
+    virtual Tensor forward(const Tensor& input) = 0;
+    Tensor operator()(const Tensor& input) { return forward(input); }
+
+    void register_parameter(const std::string& name, const Tensor& tensor);
+    void register_module(const std::string& name, std::shared_ptr<Module> module);
+
+    /// Paramètres de ce module puis ceux des sous-modules, récursivement
+    std::vector<Tensor> parameters() const;
+    /// Sous-modules directs
+    std::vector<std::shared_ptr<Module>> modules() const;
+
+    /// Noms qualifiés ("fc1.weight") -> paramètre détaché, sans copie
+    std::map<std::string, Tensor> state_dict() const;
+    /// Copie en place chaque entrée dans le paramètre de même nom (forme
+    /// identique, type converti) ; une clé manquante ou inconnue lève une
+    /// exception
+    void load_state_dict(const std::map<std::string, Tensor>& state);
+
+    /// state_dict() écrit en flux au format checkpoint.h, sans copie
+    void save(const std::string& path) const;
+    /// Projette le fichier (checkpoint::load) et fait pointer le Storage de
+    /// chaque paramètre sur ses pages, sans copie : mêmes vérifications que
+    /// load_state_dict(), dont la copie ne sert qu'aux paramètres d'un autre
+    /// type ou ne couvrant pas tout leur Storage. La projection est privée :
+    /// une mise à jour en place ne modifie pas le fichier.
+    void load(const std::string& path);
+
+protected:
+    // Paires (nom qualifié, paramètre) de tout le sous-arbre
+    void named_parameters(const std::string& prefix,
+                          std::vector<std::pair<std::string, Tensor>>& out) const;
+
+    std::vector<std::pair<std::string, Tensor>>                  params_;
+    std::vector<std::pair<std::string, std::shared_ptr<Module>>> children_;
+};
+
+} // namespace napcas
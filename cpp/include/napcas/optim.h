@@ -0,0 +1,159 @@
+#pragma once
+
+#include "napcas/kernels/optim.h"
+#include "napcas/tensor.h"
+#include <cstddef>
+#include <vector>
+
+namespace napcas {
+namespace optim {
+
+/// Base des optimiseurs « multi-tenseurs » : tous les paramètres sont mis
+/// à jour par un seul parallel_for par pas. Les paramètres sont découpés
+/// en blocs de kChunk éléments ; chaque bloc lit son gradient et son état
+/// et écrit le paramètre et l'état en une passe vectorisée (voir
+/// kernels/optim.h), sans tenseur temporaire.
+///
+/// L'état (moments) est stocké dans un tampon float32 plat par grandeur,
+/// chaque paramètre y occupant une tranche alignée sur 64 octets.
+///
+/// Les paramètres doivent être float32, contigus et sur CPU ; ils sont
+/// modifiés en place (le Storage de la couche est partagé, forward() voit
+/// la mise à jour) et leur version est incrémentée. Un paramètre sans
+/// gradient est ignoré pendant le pas.
+class Optimizer {
+public:
+    virtual ~Optimizer() = default;
+    Optimizer(const Optimizer&)            = delete;
+    Optimizer& operator=(const Optimizer&) = delete;
+
+    /// Applique un pas. Si max_grad_norm() > 0, la norme L2 globale des
+    /// gradients est d'abord calculée (passe en lecture seule sur les
+    /// mêmes blocs) et, si elle dépasse la borne, le facteur
+    /// max_grad_norm / norme est appliqué dans le noyau de mise à jour :
+    /// les gradients eux-mêmes ne sont pas réécrits. Renvoie la norme
+    /// globale avant écrêtage, ou 0 si l'écrêtage est désactivé.
+    double step();
+
+    /// Remet à zéro, en place et sans allocation, les gradients existants :
+    /// ils restent définis et le backward suivant y accumule directement
+    /// (AccumulateGrad). Un gradient non contigu est oublié.
+    void zero_grad();
+
+    const std::vector<Tensor>& parameters() const noexcept { return params_; }
+
+    float lr() const noexcept { return lr_; }
+    void  set_lr(float lr);
+    float max_grad_norm() const noexcept { return max_grad_norm_; }
+    /// 0 désactive l'écrêtage
+    void  set_max_grad_norm(float max_norm);
+
+    /// Nombre de pas effectués
+    std::size_t steps() const noexcept { return steps_; }
+    /// Taille des tampons d'état
+    std::size_t state_bytes() const noexcept;
+
+    /// Éléments par bloc de travail
+    static constexpr std::size_t kChunk = 16384;
+
+protected:
+    Optimizer(std::vector<Tensor> params, float lr, float max_grad_norm,
+              std::size_t num_state, const char* name);
+
+    /// Fixe les hyperparamètres du pas steps() (déjà incrémenté) ;
+    /// `grad_scale` est le facteur d'écrêtage (1 sans écrêtage)
+    virtual void prepare(float grad_scale) = 0;
+    /// Met à jour p[0, n) ; state[s] pointe sur le tampon d'état s au même
+    /// décalage. Appelé en parallèle sur des blocs disjoints.
+    virtual void update(float* p, const float* g, float* const* state, std::size_t n) const = 0;
+
+    /// Tranche du tampon d'état `buffer` pour le paramètre i, de la forme
+    /// du paramètre (vue, sans copie)
+    Tensor state_view(std::size_t buffer, std::size_t i) const;
+
+private:
+    struct Chunk {
+        std::size_t param, begin, end;
+    };
+    static constexpr std::size_t kMaxState = 2;
+
+    std::size_t grain() const noexcept;
+
+    std::vector<Tensor>      params_;
+    std::vector<std::size_t> offsets_;   // début de chaque tranche d'état
+    std::vector<Tensor>      state_;     // un tampon plat par grandeur
+    std::vector<Chunk>       chunks_;
+    const char*              name_;
+    float                    lr_;
+    float                    max_grad_norm_;
+    std::size_t              steps_ = 0;
+    std::size_t              total_ = 0;   // éléments des paramètres
+
+    // Tampons réutilisés d'un pas à l'autre (step() n'alloue pas)
+    std::vector<Tensor>       grads_;      // gradients contigus du pas
+    std::vector<float*>       grad_ptrs_;  // nul : paramètre ignoré
+    std::vector<double>       partial_;    // Σ g² par bloc
+    float                     grad_scale_ = 1.0f;
+};
+
+/// Descente de gradient stochastique, avec moment (tampon plat) et
+/// variante de Nesterov, pénalité L2 ajoutée au gradient
+class SGD : public Optimizer {
+public:
+    SGD(std::vector<Tensor> params, float lr, float momentum = 0.0f,
+        float weight_decay = 0.0f, bool nesterov = false, float max_grad_norm = 0.0f);
+
+    float momentum()     const noexcept { return momentum_; }
+    float weight_decay() const noexcept { return weight_decay_; }
+    bool  nesterov()     const noexcept { return nesterov_; }
+    /// Tampon de moment du paramètre i (exception sans moment)
+    Tensor momentum_buffer(std::size_t i) const;
+
+protected:
+    void prepare(float grad_scale) override;
+    void update(float* p, const float* g, float* const* state, std::size_t n) const override;
+
+private:
+    float            momentum_, weight_decay_;
+    bool             nesterov_;
+    kernels::SgdStep step_;
+};
+
+/// Adam (Kingma & Ba), pénalité L2 ajoutée au gradient ; voir AdamW pour
+/// la version découplée
+class Adam : public Optimizer {
+public:
+    Adam(std::vector<Tensor> params, float lr = 1e-3f, float beta1 = 0.9f, float beta2 = 0.999f,
+         float eps = 1e-8f, float weight_decay = 0.0f, float max_grad_norm = 0.0f);
+
+    float beta1()        const noexcept { return beta1_; }
+    float beta2()        const noexcept { return beta2_; }
+    float eps()          const noexcept { return eps_; }
+    float weight_decay() const noexcept { return weight_decay_; }
+    /// Premier et second moments du paramètre i
+    Tensor exp_avg(std::size_t i)    const { return state_view(0, i); }
+    Tensor exp_avg_sq(std::size_t i) const { return state_view(1, i); }
+
+protected:
+    Adam(std::vector<Tensor> params, float lr, float beta1, float beta2, float eps,
+         float weight_decay, float max_grad_norm, bool decoupled, const char* name);
+
+    void prepare(float grad_scale) override;
+    void update(float* p, const float* g, float* const* state, std::size_t n) const override;
+
+private:
+    float             beta1_, beta2_, eps_, weight_decay_;
+    bool              decoupled_;
+    kernels::AdamStep step_;
+};
+
+/// Adam à pénalité découplée (Loshchilov & Hutter) : p ← (1 - lr·λ) · p
+/// avant le pas d'Adam
+class AdamW : public Adam {
+public:
+    AdamW(std::vector<Tensor> params, float lr = 1e-3f, float beta1 = 0.9f, float beta2 = 0.999f,
+          float eps = 1e-8f, float weight_decay = 1e-2f, float max_grad_norm = 0.0f);
+};
+
+} // namespace optim
+} // namespace napcas
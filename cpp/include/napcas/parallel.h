@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+
+namespace napcas {
+
+/// Nombre de threads utilisés par les noyaux parallèles (thread appelant
+/// compris). Par défaut : NAPCAS_NUM_THREADS s'il est défini, sinon le
+/// nombre de cœurs.
+std::size_t get_num_threads();
+
+/// Redimensionne le pool partagé. À appeler hors de toute région parallèle.
+void set_num_threads(std::size_t n);
+
+/// Vrai à l'intérieur d'un bloc exécuté par parallel_for
+bool in_parallel_region();
+
+/// Taille de bloc pour `n` items de `item_bytes` octets : un seul bloc (donc
+/// exécution série) sous kMinChunkBytes de travail, puis environ quatre
+/// blocs par thread pour l'équilibrage.
+std::size_t grain_size(std::size_t n, std::size_t item_bytes);
+
+constexpr std::size_t kMinChunkBytes = 1 << 16;
+
+/// Découpe [begin, end) en blocs d'au moins `grain` itérations et appelle
+/// fn(b, e) sur chacun via le pool de threads (work stealing). Le thread
+/// appelant participe. Exécution série si la plage tient dans un bloc ou si
+/// l'on est déjà dans une région parallèle. La première exception levée par
+/// un bloc est propagée.
+void parallel_for(std::size_t begin, std::size_t end, std::size_t grain,
+                  const std::function<void(std::size_t, std::size_t)>& fn);
+
+} // namespace napcas
@@ -0,0 +1,120 @@
+#pragma once
+
+#include "napcas/tensor.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace napcas {
+namespace profiler {
+
+/// Catégorie d'un événement : opération de Tensor (ou noyau rejoué par un
+/// Graph), GradFn::apply pendant backward, forward d'un module,
+/// allocation ou libération (cpu_malloc / cpu_free)
+enum class EventKind : std::uint8_t { Op, Backward, Module, Alloc, Free };
+
+const char* event_kind_name(EventKind kind);
+
+/// Événement terminé. Les instants sont en nanosecondes depuis l'origine
+/// (négatifs pour une portée ouverte avant elle) ; `self_ns` exclut les événements imbriqués du même thread (ex.
+/// les allocations d'une opération, les opérations d'un module).
+/// Les FLOP sont estimés : 2·M·N·K pour les produits matriciels et les
+/// convolutions, un par élément lu pour les réductions et élémentaires.
+struct Event {
+    std::string        name;
+    EventKind          kind = EventKind::Op;
+    std::uint32_t      thread = 0;          // numéro de thread, 0 pour le premier vu
+    std::uint32_t      depth  = 0;          // imbrication sur ce thread
+    std::int64_t       start_ns    = 0;
+    std::int64_t       duration_ns = 0;
+    std::int64_t       self_ns     = 0;
+    std::vector<Shape> input_shapes;
+    std::size_t        bytes_read    = 0;   // entrées lues une fois
+    std::size_t        bytes_written = 0;   // sorties (ou bloc alloué / libéré)
+    double             flops = 0.0;
+    std::size_t        bytes_in_use = 0;    // Alloc / Free : allocateur après l'appel
+};
+
+/// Agrégat des événements de même nom et de même catégorie
+struct OpStats {
+    std::string  name;
+    EventKind    kind = EventKind::Op;
+    std::size_t  count = 0;
+    std::int64_t total_ns = 0;
+    std::int64_t self_ns  = 0;
+    std::int64_t max_ns   = 0;
+    std::size_t  bytes_read = 0, bytes_written = 0;
+    double       flops = 0.0;
+};
+
+namespace detail {
+extern std::atomic<bool> g_enabled;
+}
+
+/// Vrai entre start() et stop() ; c'est le seul test payé par opération
+/// quand le profileur est désactivé
+inline bool enabled() noexcept { return detail::g_enabled.load(std::memory_order_relaxed); }
+
+/// Active l'enregistrement ; l'origine des temps est ce premier appel
+/// après clear(). Les événements déjà enregistrés sont conservés.
+void start();
+void stop();
+/// Oublie les événements enregistrés. Pendant l'enregistrement, l'origine
+/// des temps est conservée : une portée encore ouverte garde un début et
+/// une durée exacts.
+void clear();
+
+/// Copie des événements terminés, dans l'ordre de fin
+std::vector<Event> events();
+
+/// Un agrégat par (nom, catégorie), trié par temps propre décroissant
+std::vector<OpStats> summarize(const std::vector<Event>& events);
+/// Tableau texte de `stats` (max_rows = 0 : toutes les lignes)
+std::string format_table(const std::vector<OpStats>& stats, std::size_t max_rows = 0);
+
+/// JSON « trace_event » de Chrome (chrome://tracing, Perfetto) : un
+/// événement complet ("X") par entrée, arguments formes / octets / FLOP,
+/// et un compteur "bytes_in_use" suivant les allocations
+std::string chrome_trace(const std::vector<Event>& events);
+void export_chrome_trace(const std::vector<Event>& events, const std::string& path);
+
+/// Portée d'un événement : l'horloge n'est lue, et l'événement enregistré,
+/// que si le profileur est actif à la construction. Les arguments coûteux
+/// se renseignent sous `if (scope.active())`.
+///
+///     profiler::RecordScope prof("matmul");
+///     ... calcul ...
+///     if (prof.active()) prof.record_io({*this, rhs}, out, 2.0 * M * N * K);
+class RecordScope {
+public:
+    explicit RecordScope(const char* name, EventKind kind = EventKind::Op)
+        : active_(enabled()) {
+        if (active_) begin(name, kind);
+    }
+    ~RecordScope() {
+        if (active_) end();
+    }
+    RecordScope(const RecordScope&)            = delete;
+    RecordScope& operator=(const RecordScope&) = delete;
+
+    bool active() const noexcept { return active_; }
+
+    /// Formes et octets des entrées (non définies ignorées), octets de la
+    /// sortie, FLOP estimés
+    void record_io(const std::vector<Tensor>& inputs, const Tensor& output, double flops = 0.0);
+    void record_io(const std::vector<Tensor>& inputs, const std::vector<Tensor>& outputs,
+                   double flops = 0.0);
+    /// Octets d'un bloc alloué ou libéré et occupation de l'allocateur
+    void record_alloc(std::size_t bytes, std::size_t bytes_in_use);
+
+private:
+    void begin(const char* name, EventKind kind);
+    void end();
+
+    bool active_;
+};
+
+} // namespace profiler
+} // namespace napcas
@@ -0,0 +1,215 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <initializer_list>
+#include <iterator>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+namespace napcas {
+
+/// Vecteur à capacité en ligne : les N premiers éléments sont stockés dans
+/// l'objet, le tas n'est utilisé qu'au-delà. Réservé aux types trivialement
+/// copiables (dimensions, strides) : copies et déplacements sont des memcpy.
+template<typename T, std::size_t N>
+class SmallVector {
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "SmallVector: element type must be trivially copyable");
+
+public:
+    using value_type      = T;
+    using size_type       = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference       = T&;
+    using const_reference = const T&;
+    using pointer         = T*;
+    using const_pointer   = const T*;
+    using iterator        = T*;
+    using const_iterator  = const T*;
+
+    SmallVector() noexcept = default;
+    explicit SmallVector(size_type n, const T& value = T()) { assign(n, value); }
+    SmallVector(std::initializer_list<T> init) { assign(init.begin(), init.end()); }
+    template<typename It, typename = typename std::iterator_traits<It>::iterator_category>
+    SmallVector(It first, It last) { assign(first, last); }
+    // Conversion depuis std::vector : l'API publique accepte encore des
+    // formes std::vector (une copie, pas de partage)
+    SmallVector(const std::vector<T>& v) { assign(v.begin(), v.end()); }
+
+    SmallVector(const SmallVector& other) { assign(other.begin(), other.end()); }
+    SmallVector(SmallVector&& other) noexcept { steal(other); }
+    SmallVector& operator=(const SmallVector& other) {
+        if (this != &other) assign(other.begin(), other.end());
+        return *this;
+    }
+    SmallVector& operator=(SmallVector&& other) noexcept {
+        if (this != &other) {
+            release();
+            steal(other);
+        }
+        return *this;
+    }
+    SmallVector& operator=(std::initializer_list<T> init) {
+        assign(init.begin(), init.end());
+        return *this;
+    }
+    ~SmallVector() { release(); }
+
+    // ----- Accès -----
+    size_type size()     const noexcept { return size_; }
+    size_type capacity() const noexcept { return is_inline() ? N : capacity_; }
+    bool      empty()    const noexcept { return size_ == 0; }
+    /// Vrai tant que les éléments tiennent dans le stockage en ligne
+    bool      is_inline() const noexcept { return data_ == inline_; }
+
+    T*       data()       noexcept { return data_; }
+    const T* data() const noexcept { return data_; }
+    T&       operator[](size_type i)       noexcept { return data_[i]; }
+    const T& operator[](size_type i) const noexcept { return data_[i]; }
+    T&       front()       noexcept { return data_[0]; }
+    const T& front() const noexcept { return data_[0]; }
+    T&       back()        noexcept { return data_[size_ - 1]; }
+    const T& back()  const noexcept { return data_[size_ - 1]; }
+
+    iterator       begin()        noexcept { return data_; }
+    const_iterator begin()  const noexcept { return data_; }
+    const_iterator cbegin() const noexcept { return data_; }
+    iterator       end()          noexcept { return data_ + size_; }
+    const_iterator end()    const noexcept { return data_ + size_; }
+    const_iterator cend()   const noexcept { return data_ + size_; }
+    std::reverse_iterator<iterator>       rbegin()       noexcept { return std::reverse_iterator<iterator>(end()); }
+    std::reverse_iterator<const_iterator> rbegin() const noexcept { return std::reverse_iterator<const_iterator>(end()); }
+    std::reverse_iterator<iterator>       rend()         noexcept { return std::reverse_iterator<iterator>(begin()); }
+    std::reverse_iterator<const_iterator> rend()   const noexcept { return std::reverse_iterator<const_iterator>(begin()); }
+
+    // ----- Modification -----
+    void reserve(size_type n) {
+        if (n <= capacity()) return;
+        T* heap = static_cast<T*>(::operator new(n * sizeof(T)));
+        if (size_) std::memcpy(heap, data_, size_ * sizeof(T));
+        release();
+        data_     = heap;
+        capacity_ = n;
+    }
+
+    void resize(size_type n, const T& value = T()) {
+        reserve(n);
+        for (size_type i = size_; i < n; ++i) data_[i] = value;
+        size_ = n;
+    }
+
+    void assign(size_type n, const T& value) {
+        size_ = 0;
+        resize(n, value);
+    }
+
+    template<typename It, typename = typename std::iterator_traits<It>::iterator_category>
+    void assign(It first, It last) {
+        const size_type n = size_type(std::distance(first, last));
+        size_ = 0;
+        reserve(n);
+        std::copy(first, last, data_);
+        size_ = n;
+    }
+
+    void clear() noexcept { size_ = 0; }
+
+    void push_back(const T& value) {
+        if (size_ == capacity())
+            grow_and_push(value);
+        else
+            data_[size_++] = value;
+    }
+    void pop_back() noexcept { --size_; }
+
+    iterator insert(const_iterator pos, const T& value) {
+        const size_type i = size_type(pos - data_);
+        push_back(value);
+        std::rotate(data_ + i, data_ + size_ - 1, data_ + size_);
+        return data_ + i;
+    }
+    template<typename It, typename = typename std::iterator_traits<It>::iterator_category>
+    iterator insert(const_iterator pos, It first, It last) {
+        const size_type i = size_type(pos - data_);
+        const size_type old = size_;
+        for (; first != last; ++first) push_back(*first);
+        std::rotate(data_ + i, data_ + old, data_ + size_);
+        return data_ + i;
+    }
+    iterator erase(const_iterator pos) {
+        const size_type i = size_type(pos - data_);
+        std::copy(data_ + i + 1, data_ + size_, data_ + i);
+        --size_;
+        return data_ + i;
+    }
+
+    /// Copie vers un std::vector (code appelant qui en attend un)
+    std::vector<T> vec() const { return std::vector<T>(begin(), end()); }
+    operator std::vector<T>() const { return vec(); }
+
+private:
+    // Hors ligne : garde push_back court pour l'inlining. Par valeur :
+    // `value` peut désigner un élément de l'ancien bloc
+    [[gnu::noinline]] void grow_and_push(T value) {
+        reserve(capacity() * 2);
+        data_[size_++] = value;
+    }
+
+    void release() noexcept {
+        if (!is_inline()) ::operator delete(data_);
+        data_     = inline_;
+        capacity_ = N;
+    }
+
+    // `other` doit être vide de tout bloc (après release() ou construction)
+    void steal(SmallVector& other) noexcept {
+        if (other.is_inline()) {
+            std::memcpy(inline_, other.inline_, other.size_ * sizeof(T));
+            data_ = inline_;
+        } else {
+            data_      = other.data_;
+            capacity_  = other.capacity_;
+            other.data_     = other.inline_;
+            other.capacity_ = N;
+        }
+        size_ = other.size_;
+        other.size_ = 0;
+    }
+
+    T*        data_     = inline_;
+    size_type size_     = 0;
+    size_type capacity_ = N;
+    T         inline_[N];
+};
+
+template<typename T, std::size_t N, std::size_t M>
+bool operator==(const SmallVector<T, N>& a, const SmallVector<T, M>& b) noexcept {
+    return std::equal(a.begin(), a.end(), b.begin(), b.end());
+}
+template<typename T, std::size_t N, std::size_t M>
+bool operator!=(const SmallVector<T, N>& a, const SmallVector<T, M>& b) noexcept {
+    return !(a == b);
+}
+template<typename T, std::size_t N>
+bool operator==(const SmallVector<T, N>& a, const std::vector<T>& b) noexcept {
+    return std::equal(a.begin(), a.end(), b.begin(), b.end());
+}
+template<typename T, std::size_t N>
+bool operator==(const std::vector<T>& a, const SmallVector<T, N>& b) noexcept { return b == a; }
+template<typename T, std::size_t N>
+bool operator!=(const SmallVector<T, N>& a, const std::vector<T>& b) noexcept { return !(a == b); }
+template<typename T, std::size_t N>
+bool operator!=(const std::vector<T>& a, const SmallVector<T, N>& b) noexcept { return !(b == a); }
+
+/// Nombre de dimensions stockées en ligne dans Shape et Strides : au-delà,
+/// les métadonnées d'un Tensor passent sur le tas
+constexpr std::size_t kInlineDims = 6;
+
+/// Forme et strides (en éléments) d'un tenseur
+using Shape   = SmallVector<std::size_t, kInlineDims>;
+using Strides = SmallVector<std::ptrdiff_t, kInlineDims>;
+
+} // namespace napcas
@@ -0,0 +1,106 @@
+#pragma once
+
+#include "napcas/common.h"
+#include "napcas/device.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+
+namespace napcas {
+
+/// Bloc mémoire brut partagé par un ou plusieurs Tensor.
+/// Le comptage de références passe par std::shared_ptr<Storage> : les vues
+/// (reshape, permute, squeeze, ...) gardent le bloc vivant sans le copier.
+class Storage {
+public:
+    using Deleter = std::function<void(void*)>;
+
+    // Alloue `nbytes` octets sur `device` (libérés par device_free)
+    Storage(std::size_t nbytes, Device device)
+        : data_(device_malloc(nbytes, device)),
+          nbytes_(nbytes),
+          device_(device),
+          serial_(next_serial())
+    {}
+
+    // Adopte un buffer externe, libéré par `deleter` (peut être vide)
+    Storage(void* data, std::size_t nbytes, Device device, Deleter deleter)
+        : data_(data),
+          nbytes_(nbytes),
+          device_(device),
+          deleter_(std::move(deleter)),
+          external_(true),
+          serial_(next_serial())
+    {}
+
+    ~Storage() {
+        if (external_) {
+            if (deleter_) deleter_(data_);
+        } else {
+            device_free(data_, device_);
+        }
+    }
+
+    Storage(const Storage&)            = delete;
+    Storage& operator=(const Storage&) = delete;
+
+    void*       data()         noexcept { return data_; }
+    const void* data()   const noexcept { return data_; }
+    std::size_t nbytes() const noexcept { return nbytes_; }
+    Device      device() const noexcept { return device_; }
+
+    // Compteur de version, partagé par toutes les vues : incrémenté par
+    // chaque écriture en place (add_, variantes out=, load_state_dict) ;
+    // l'autograd le compare à la valeur relevée à la sauvegarde d'un tenseur
+    std::uint64_t version() const noexcept { return version_.load(std::memory_order_relaxed); }
+    void bump_version() noexcept { version_.fetch_add(1, std::memory_order_relaxed); }
+
+    // Numéro de création, croissant : la capture de graphe (graph.h)
+    // distingue ainsi les blocs antérieurs à la capture (constantes)
+    std::uint64_t serial() const noexcept { return serial_; }
+    static std::uint64_t current_serial() noexcept {
+        return serial_counter_.load(std::memory_order_relaxed);
+    }
+
+    // Remplace le buffer par celui de `source` (même taille, même
+    // périphérique), gardé vivant tant que ce bloc y pointe ; l'ancien est
+    // libéré. Toutes les vues le voient, sans copie. Ni l'ancien buffer ni
+    // ce bloc ne doivent être utilisés par un autre thread pendant l'appel.
+    void rebind(std::shared_ptr<Storage> source) {
+        if (!source || source.get() == this) return;
+        if (source->nbytes_ != nbytes_ || source->device_ != device_)
+            throw std::runtime_error("Storage::rebind: size or device mismatch");
+        if (external_) {
+            if (deleter_) deleter_(data_);
+        } else {
+            device_free(data_, device_);
+        }
+        data_     = source->data_;
+        deleter_  = [keep = std::move(source)](void*) {};
+        external_ = true;
+        bump_version();
+    }
+
+    static std::shared_ptr<Storage> allocate(std::size_t nbytes, Device device) {
+        return std::make_shared<Storage>(nbytes, device);
+    }
+
+private:
+    void*       data_;
+    std::size_t nbytes_;
+    Device      device_;
+    Deleter     deleter_;
+    bool        external_ = false;
+    std::atomic<std::uint64_t> version_{0};
+    std::uint64_t serial_;
+
+    static std::uint64_t next_serial() noexcept {
+        return serial_counter_.fetch_add(1, std::memory_order_relaxed);
+    }
+    static inline std::atomic<std::uint64_t> serial_counter_{0};
+};
+
+} // namespace napcas
@@ -3,6 +3,7 @@
 #include <vector>
 #include <memory>
 #include <cstddef>
+#include <cstdint>
 #include <string>
 #include <iostream>
 #include <numeric>
@@ -10,108 +11,220 @@
 #include <initializer_list>
 #include "napcas/common.h"
 #include "napcas/device.h"
-#include "napcas/grad_fn.h"
+#include "napcas/half.h"
+#include "napcas/small_vector.h"
+#include "napcas/storage.h"
 
 namespace napcas {
 
 // Forward‐declare pour éviter d’inclure grad_fn.h ici
-class Function;
+class GradFn;
+struct AutogradMeta;
+namespace kernels { enum class BinaryOp; }
 
 class Tensor {
 public:
     // ----- Constructeurs -----
     Tensor();
-    Tensor(const std::vector<std::size_t>& shape,
+    Tensor(const Shape& shape,
            DType dtype = DType::Float32,
            Device device = Device{DeviceType::CPU, 0});
 
     template<typename Scalar>
-    Tensor(const std::vector<std::size_t>& shape,
+    Tensor(const Shape& shape,
            const std::vector<Scalar>& data,
            DType dtype = DType::Float32,
            Device device = Device{DeviceType::CPU, 0});
 
-    // **ON PERMET LA COPIE PROFONDE**
+    // La copie partage le Storage (copie superficielle) ; utiliser clone()
+    // pour dupliquer les données.
     Tensor(const Tensor& other);
     Tensor& operator=(const Tensor& other);
 
     Tensor(Tensor&&) noexcept;
     Tensor& operator=(Tensor&&) noexcept;
 
+    // Tensor sur un Storage existant (ex. buffer externe adopté), sans
+    // copie ; la géométrie doit tenir dans le Storage (offset en éléments)
+    static Tensor from_storage(std::shared_ptr<Storage> storage,
+                               const Shape&   shape,
+                               const Strides& strides,
+                               DType dtype,
+                               std::size_t storage_offset = 0);
+    // Strides d'une géométrie contiguë (row-major) de forme `shape`
+    static Strides contiguous_strides(const Shape& shape);
+
     // ----- Accès aux métadonnées -----
-    const std::vector<std::size_t>&    shape()   const noexcept { return shape_; }
-    const std::vector<std::ptrdiff_t>& strides() const noexcept { return strides_; }
+    const Shape&   shape()   const noexcept { return shape_; }
+    const Strides& strides() const noexcept { return strides_; }
     DType   dtype()   const noexcept { return dtype_; }
     Device  device()  const noexcept { return device_; }
     std::size_t ndim()   const noexcept { return shape_.size(); }
-    std::size_t numel()  const noexcept;
-    bool    is_contiguous() const noexcept;
+    // Mis en cache à chaque changement de géométrie : O(1), sans allocation
+    std::size_t numel()  const noexcept { return numel_; }
+    bool    is_contiguous() const noexcept { return is_contiguous_; }
+    // Vue d'un autre Tensor (view, permute, expand, ...) : l'autograd refuse
+    // de la modifier en place
+    bool    is_view() const noexcept { return is_view_; }
+    std::size_t storage_offset() const noexcept { return storage_offset_; }
+    const std::shared_ptr<Storage>& storage() const noexcept { return storage_; }
+    // Compteur de version du Storage (voir Storage::version)
+    std::uint64_t version() const noexcept { return storage_ ? storage_->version() : 0; }
+    // Faux pour un Tensor construit par défaut (ex. gradient absent)
+    bool    defined() const noexcept { return storage_ != nullptr; }
 
     // ----- Autograd interface -----
-    void    requires_grad_(bool flag) noexcept { requires_grad_flag_ = flag; }
-    bool    requires_grad() const noexcept    { return requires_grad_flag_; }
+    // L'état autograd (drapeau, gradient, grad_fn) est partagé par les
+    // copies superficielles, comme le Storage.
+    void    requires_grad_(bool flag);
+    bool    requires_grad() const noexcept;
 
+    // Tampon d'accumulation ; la version non-const l'initialise à zéro
     Tensor&       grad();
     const Tensor& grad() const;
+    bool          has_grad() const noexcept;
+    void          zero_grad();
 
+    // Rétropropagation depuis ce tenseur (voir autograd.h). Sans argument,
+    // le gradient initial vaut 1 partout.
     void    backward();
+    void    backward(const Tensor& grad_output, bool retain_graph = false);
+
+    const std::shared_ptr<GradFn>& grad_fn() const noexcept;
+    // Nœud qui reçoit le gradient de ce tenseur : grad_fn, l'AccumulateGrad
+    // d'une feuille qui requiert un gradient, ou nul
+    std::shared_ptr<GradFn> gradient_edge() const;
 
     // ----- Accès aux données -----
     template<typename T>       T* data();
     template<typename T> const T* data() const;
+    // Adresse du premier élément (Storage + offset), sans typage
+    void*       data_ptr()       noexcept;
+    const void* data_ptr() const noexcept;
 
     // ----- Transformations -----
     Tensor clone()   const;
     Tensor detach()  const;
     Tensor to(Device new_device) const;
     Tensor astype(DType new_dtype) const;
-    Tensor reshape(const std::vector<std::size_t>& new_shape) const;
-    Tensor view   (const std::vector<std::size_t>& new_shape) const;
+    Tensor reshape(const Shape& new_shape) const;
+    Tensor view   (const Shape& new_shape) const;
     Tensor permute(const std::vector<int>& dims) const;
     Tensor transpose(int dim0, int dim1) const;
     Tensor squeeze(int dim = -1) const;
     Tensor unsqueeze(int dim) const;
     Tensor contiguous() const;
+    // Vue diffusée vers `new_shape` (stride 0 sur les dimensions étendues)
+    Tensor expand(const Shape& new_shape) const;
+    // Somme sur les dimensions diffusées pour revenir à `shape` (inverse de expand)
+    Tensor sum_to_size(const Shape& shape) const;
+    // Vue sur le même Storage avec une géométrie arbitraire (offset en éléments)
+    Tensor as_strided(const Shape&   shape,
+                      const Strides& strides,
+                      std::size_t storage_offset) const;
 
     // setter pour le gradient function
     void set_grad_fn(std::shared_ptr<GradFn> fn);
 
     // ----- Initialisateurs statiques -----
-    static Tensor zeros(const std::vector<std::size_t>& shape,
+    static Tensor zeros(const Shape& shape,
                         DType dtype = DType::Float32,
                         Device device = Device{DeviceType::CPU, 0});
-    static Tensor ones (const std::vector<std::size_t>& shape,
+    static Tensor ones (const Shape& shape,
                         DType dtype = DType::Float32,
                         Device device = Device{DeviceType::CPU, 0});
 
-    // ----- Opérations élémentaires -----
+    // ----- Opérations élémentaires (broadcasting NumPy) -----
+    // Division entière : x / 0 vaut 0 et MIN / -1 vaut MIN (pas de SIGFPE)
     Tensor operator+(const Tensor& other) const;
     Tensor operator-(const Tensor& other) const;
     Tensor operator*(const Tensor& other) const;
     Tensor operator/(const Tensor& other) const;
     Tensor matmul(const Tensor& other) const;
+    Tensor exp() const;
+
+    // ----- Opérations en place (aucune allocation du résultat) -----
+    // `other` est diffusé vers la forme de *this, et le type promu doit
+    // être celui de *this. Le compteur de version du Storage est
+    // incrémenté : un tenseur sauvegardé par l'autograd puis modifié est
+    // détecté au backward. Avec autograd, *this est rebranché sur le nœud
+    // de l'opération ; une feuille qui requiert un gradient, ou une vue
+    // (is_view()), est refusée.
+    Tensor& add_(const Tensor& other);
+    Tensor& sub_(const Tensor& other);
+    Tensor& mul_(const Tensor& other);
+    Tensor& div_(const Tensor& other);
+    Tensor& operator+=(const Tensor& other) { return add_(other); }
+    Tensor& operator-=(const Tensor& other) { return sub_(other); }
+    Tensor& operator*=(const Tensor& other) { return mul_(other); }
+    Tensor& operator/=(const Tensor& other) { return div_(other); }
+
+    // ----- Réductions (voir kernels/reduce.h) -----
+    // `dims` vide : toutes les dimensions ; indices négatifs comptés depuis
+    // la fin. `keepdim` garde les dimensions réduites avec une taille 1.
+    // La somme d'un tenseur entier est de type Int64.
+    Tensor sum (const std::vector<int>& dims = {}, bool keepdim = false) const;
+    Tensor mean(const std::vector<int>& dims = {}, bool keepdim = false) const;
+    Tensor max (const std::vector<int>& dims = {}, bool keepdim = false) const;
+    Tensor min (const std::vector<int>& dims = {}, bool keepdim = false) const;
+    // Indices Int64, linéaires (row-major) dans les dimensions réduites
+    Tensor argmax(const std::vector<int>& dims = {}, bool keepdim = false) const;
+    Tensor argmin(const std::vector<int>& dims = {}, bool keepdim = false) const;
+    // Divisé par N - correction (1 : estimateur non biaisé)
+    Tensor var(const std::vector<int>& dims = {}, std::size_t correction = 1,
+               bool keepdim = false) const;
+    Tensor std(const std::vector<int>& dims = {}, std::size_t correction = 1,
+               bool keepdim = false) const;
+    Tensor logsumexp(const std::vector<int>& dims = {}, bool keepdim = false) const;
+
+    // ----- Activations et normalisations fusionnées (une passe chacune) -----
+    Tensor relu() const;
+    Tensor gelu() const;
+    Tensor silu() const;
+    Tensor softmax(int dim = -1) const;
+    Tensor log_softmax(int dim = -1) const;
+    // Sur la dernière dimension ; weight et bias (forme [shape().back()])
+    // sont optionnels : un Tensor non défini les omet
+    Tensor layer_norm(const Tensor& weight = Tensor(), const Tensor& bias = Tensor(),
+                      double eps = 1e-5) const;
+    Tensor rms_norm(const Tensor& weight = Tensor(), double eps = 1e-6) const;
 
     // ----- Debug / affichage -----
     void print_shape()  const;
     void print_summary() const;
 
 private:
-    std::vector<std::size_t>    shape_;
-    std::vector<std::ptrdiff_t> strides_;
+    Shape   shape_;
+    Strides strides_;
+    std::size_t numel_         = 1;      // produit de shape_
+    bool        is_contiguous_ = true;   // strides_ row-major denses
     DType     dtype_;
     Device    device_;
-    std::unique_ptr<void, void(*)(void*)> storage_;
+    std::shared_ptr<Storage> storage_;
+    std::size_t storage_offset_ = 0;   // en éléments
+    bool        is_view_        = false;   // issu de as_strided (vues), sauf detach()
 
-    // Autograd
-    std::shared_ptr<Tensor> grad_ptr_;
-    std::shared_ptr<GradFn> grad_fn_;
-    bool requires_grad_flag_ = false;
+    // Autograd (alloué au premier requires_grad_/set_grad_fn)
+    std::shared_ptr<AutogradMeta> autograd_;
+    AutogradMeta& autograd_meta();
+    Tensor& binary_inplace(kernels::BinaryOp op, const Tensor& other, const char* name);
 
     // Utilitaires internes
     void compute_strides();
+    // Recalcule numel_ et is_contiguous_ après modification de shape_/strides_
+    void update_geometry() noexcept;
     void check_device_consistency(const Tensor& other) const;
-    void check_shape_broadcast   (const Tensor& other) const;
+    Shape check_shape_broadcast(const Tensor& other) const;
 };
 
+// ----- Variantes out= : a op b écrit dans `out`, qui est renvoyé -----
+// `out` doit avoir la forme diffusée et le type promu de (a, b) ; il peut
+// être une vue, ou a / b eux-mêmes. Pas d'autograd : une entrée qui
+// requiert un gradient est refusée.
+Tensor& add_out(Tensor& out, const Tensor& a, const Tensor& b);
+Tensor& sub_out(Tensor& out, const Tensor& a, const Tensor& b);
+Tensor& mul_out(Tensor& out, const Tensor& a, const Tensor& b);
+Tensor& div_out(Tensor& out, const Tensor& a, const Tensor& b);
+
 } // namespace napcas
 
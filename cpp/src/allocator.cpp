@@ -0,0 +1,305 @@
+// cpp/src/allocator.cpp
+
+#include "napcas/allocator.h"
+#include "napcas/profiler.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <new>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace napcas {
+
+namespace {
+    // Classes 2^6 (64 o) .. 2^25 (32 MiB) ; au-delà, arrondi à 2 MiB
+    constexpr int         kMinClassLog  = 6;
+    constexpr int         kMaxClassLog  = 25;
+    constexpr int         kNumClasses   = kMaxClassLog - kMinClassLog + 1;
+    constexpr int         kLargeClass   = -1;
+    constexpr std::size_t kLargeRound   = std::size_t(2) << 20;
+    // Capacité d'une liste par thread et par classe ; les blocs de plus
+    // de 1 MiB passent directement par le pool global
+    constexpr std::size_t kThreadCacheBytes = std::size_t(4) << 20;
+    constexpr std::size_t kThreadCacheMaxBlock = std::size_t(1) << 20;
+    constexpr std::uint32_t kMagic = 0x6e617063;   // "napc"
+
+    // En-tête de kCpuAlignment octets placé devant chaque bloc
+    struct alignas(kCpuAlignment) BlockHeader {
+        std::uint32_t magic;
+        std::int32_t  cls;
+        std::size_t   bytes;   // taille utile du bloc
+    };
+    static_assert(sizeof(BlockHeader) == kCpuAlignment, "header must keep alignment");
+
+    BlockHeader* header_of(void* p) {
+        return reinterpret_cast<BlockHeader*>(static_cast<char*>(p) - kCpuAlignment);
+    }
+
+    int class_of(std::size_t bytes) {
+        if (bytes > (std::size_t(1) << kMaxClassLog)) return kLargeClass;
+        int log = kMinClassLog;
+        while ((std::size_t(1) << log) < bytes) ++log;
+        return log - kMinClassLog;
+    }
+
+    std::size_t class_bytes(int cls, std::size_t requested) {
+        if (cls == kLargeClass)
+            return (requested + kLargeRound - 1) / kLargeRound * kLargeRound;
+        return std::size_t(1) << (cls + kMinClassLog);
+    }
+
+    struct Counters {
+        std::atomic<std::size_t> in_use{0};
+        std::atomic<std::size_t> peak{0};
+        std::atomic<std::size_t> cached{0};
+        std::atomic<std::size_t> allocs{0};
+        std::atomic<std::size_t> hits{0};
+    };
+
+    Counters& counters() {
+        static Counters* c = new Counters();
+        return *c;
+    }
+
+    void note_in_use(std::size_t bytes) {
+        auto& c = counters();
+        std::size_t now = c.in_use.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+        std::size_t peak = c.peak.load(std::memory_order_relaxed);
+        while (now > peak &&
+               !c.peak.compare_exchange_weak(peak, now, std::memory_order_relaxed)) {}
+    }
+
+    void* system_alloc(int cls, std::size_t bytes) {
+        void* raw = std::aligned_alloc(kCpuAlignment, bytes + kCpuAlignment);
+        if (!raw) return nullptr;
+        auto* h = static_cast<BlockHeader*>(raw);
+        h->magic = kMagic;
+        h->cls   = cls;
+        h->bytes = bytes;
+        return static_cast<char*>(raw) + kCpuAlignment;
+    }
+
+    void system_free(void* p) {
+        std::free(header_of(p));
+    }
+
+    // Pool global : une liste par classe, et les gros blocs par taille exacte
+    struct GlobalPool {
+        std::mutex mutex;
+        std::vector<void*> classes[kNumClasses];
+        std::unordered_map<std::size_t, std::vector<void*>> large;
+    };
+
+    GlobalPool& global_pool() {
+        static GlobalPool* p = new GlobalPool();   // jamais détruit (threads encore actifs à la sortie)
+        return *p;
+    }
+
+    // Cache par thread. Le mutex n'est contesté que par empty_cache().
+    struct ThreadCache;
+    struct Registry {
+        std::mutex mutex;
+        std::unordered_set<ThreadCache*> caches;
+    };
+
+    Registry& registry() {
+        static Registry* r = new Registry();
+        return *r;
+    }
+
+    thread_local bool tls_cache_destroyed = false;
+
+    struct ThreadCache {
+        std::mutex mutex;
+        std::vector<void*> classes[kNumClasses];
+
+        ThreadCache() {
+            std::lock_guard<std::mutex> lock(registry().mutex);
+            registry().caches.insert(this);
+        }
+
+        ~ThreadCache() {
+            tls_cache_destroyed = true;
+            {
+                std::lock_guard<std::mutex> lock(registry().mutex);
+                registry().caches.erase(this);
+            }
+            // Les blocs restants rejoignent le pool global
+            GlobalPool& g = global_pool();
+            std::lock_guard<std::mutex> lock(g.mutex);
+            for (int c = 0; c < kNumClasses; ++c)
+                for (void* p : classes[c]) g.classes[c].push_back(p);
+        }
+
+        // Appelé avec `mutex` tenu
+        std::size_t drain_to_system() {
+            std::size_t freed = 0;
+            for (int c = 0; c < kNumClasses; ++c) {
+                for (void* p : classes[c]) {
+                    freed += class_bytes(c, 0);
+                    system_free(p);
+                }
+                classes[c].clear();
+            }
+            return freed;
+        }
+    };
+
+    // nullptr pendant la destruction des thread_local du thread courant
+    ThreadCache* thread_cache() {
+        if (tls_cache_destroyed) return nullptr;
+        static thread_local ThreadCache cache;
+        return &cache;
+    }
+
+    bool caching_enabled() {
+        static const bool enabled = [] {
+            const char* env = std::getenv("NAPCAS_ALLOCATOR");
+            return !(env && std::strcmp(env, "system") == 0);
+        }();
+        return enabled;
+    }
+
+    void* take_cached(int cls, std::size_t bytes) {
+        ThreadCache* tc = cls != kLargeClass && bytes <= kThreadCacheMaxBlock
+                        ? thread_cache() : nullptr;
+        if (tc) {
+            std::lock_guard<std::mutex> lock(tc->mutex);
+            auto& list = tc->classes[cls];
+            if (!list.empty()) {
+                void* p = list.back();
+                list.pop_back();
+                return p;
+            }
+        }
+        GlobalPool& g = global_pool();
+        std::lock_guard<std::mutex> lock(g.mutex);
+        std::vector<void*>* list = nullptr;
+        if (cls == kLargeClass) {
+            auto it = g.large.find(bytes);
+            if (it != g.large.end()) list = &it->second;
+        } else {
+            list = &g.classes[cls];
+        }
+        if (!list || list->empty()) return nullptr;
+        void* p = list->back();
+        list->pop_back();
+        return p;
+    }
+
+    void give_back(void* p, int cls, std::size_t bytes) {
+        ThreadCache* tc = cls != kLargeClass && bytes <= kThreadCacheMaxBlock
+                        ? thread_cache() : nullptr;
+        if (tc) {
+            std::lock_guard<std::mutex> lock(tc->mutex);
+            auto& list = tc->classes[cls];
+            if (list.size() * bytes < kThreadCacheBytes) {
+                list.push_back(p);
+                return;
+            }
+        }
+        GlobalPool& g = global_pool();
+        std::lock_guard<std::mutex> lock(g.mutex);
+        if (cls == kLargeClass) g.large[bytes].push_back(p);
+        else                    g.classes[cls].push_back(p);
+    }
+}
+
+void* cpu_malloc(std::size_t bytes) {
+    profiler::RecordScope prof("cpu_malloc", profiler::EventKind::Alloc);
+    const int cls = class_of(std::max<std::size_t>(bytes, 1));
+    const std::size_t block = class_bytes(cls, bytes);
+    auto& c = counters();
+    c.allocs.fetch_add(1, std::memory_order_relaxed);
+
+    if (caching_enabled()) {
+        if (void* p = take_cached(cls, block)) {
+            c.hits.fetch_add(1, std::memory_order_relaxed);
+            c.cached.fetch_sub(block, std::memory_order_relaxed);
+            note_in_use(block);
+            if (prof.active()) prof.record_alloc(block, c.in_use.load(std::memory_order_relaxed));
+            return p;
+        }
+    }
+    void* p = system_alloc(cls, block);
+    if (!p && caching_enabled()) {
+        // Plus de mémoire : rendre le cache au système et réessayer
+        empty_cache();
+        p = system_alloc(cls, block);
+    }
+    if (!p) throw std::bad_alloc();
+    note_in_use(block);
+    if (prof.active()) prof.record_alloc(block, c.in_use.load(std::memory_order_relaxed));
+    return p;
+}
+
+void cpu_free(void* ptr) {
+    if (!ptr) return;
+    BlockHeader* h = header_of(ptr);
+    if (h->magic != kMagic) {
+        // Bloc non issu de cpu_malloc : on ne peut pas le libérer sans risque
+        std::abort();
+    }
+    const std::size_t block = h->bytes;
+    auto& c = counters();
+    profiler::RecordScope prof("cpu_free", profiler::EventKind::Free);
+    const std::size_t in_use = c.in_use.fetch_sub(block, std::memory_order_relaxed) - block;
+    if (prof.active()) prof.record_alloc(block, in_use);
+    if (!caching_enabled()) {
+        system_free(ptr);
+        return;
+    }
+    c.cached.fetch_add(block, std::memory_order_relaxed);
+    give_back(ptr, h->cls, block);
+}
+
+AllocatorStats allocator_stats() {
+    auto& c = counters();
+    AllocatorStats s;
+    s.bytes_in_use      = c.in_use.load(std::memory_order_relaxed);
+    s.peak_bytes_in_use = c.peak.load(std::memory_order_relaxed);
+    s.bytes_cached      = c.cached.load(std::memory_order_relaxed);
+    s.num_allocs        = c.allocs.load(std::memory_order_relaxed);
+    s.cache_hits        = c.hits.load(std::memory_order_relaxed);
+    return s;
+}
+
+void reset_peak_stats() {
+    auto& c = counters();
+    c.peak.store(c.in_use.load(std::memory_order_relaxed), std::memory_order_relaxed);
+}
+
+void empty_cache() {
+    std::size_t freed = 0;
+    {
+        std::lock_guard<std::mutex> lock(registry().mutex);
+        for (ThreadCache* tc : registry().caches) {
+            std::lock_guard<std::mutex> tc_lock(tc->mutex);
+            freed += tc->drain_to_system();
+        }
+    }
+    GlobalPool& g = global_pool();
+    std::lock_guard<std::mutex> lock(g.mutex);
+    for (int cls = 0; cls < kNumClasses; ++cls) {
+        for (void* p : g.classes[cls]) {
+            freed += class_bytes(cls, 0);
+            system_free(p);
+        }
+        g.classes[cls].clear();
+    }
+    for (auto& kv : g.large) {
+        for (void* p : kv.second) {
+            freed += kv.first;
+            system_free(p);
+        }
+    }
+    g.large.clear();
+    counters().cached.fetch_sub(freed, std::memory_order_relaxed);
+}
+
+} // namespace napcas
@@ -0,0 +1,323 @@
+// cpp/src/architecture/conv.cpp
+
+#include "napcas/architecture/conv.h"
+#include "napcas/dispatch.h"
+#include "napcas/grad_fn.h"
+#include "napcas/graph.h"
+#include "napcas/kernels/copy.h"
+#include "napcas/profiler.h"
+#include <cmath>
+#include <random>
+#include <stdexcept>
+#include <string>
+
+namespace napcas {
+namespace architecture {
+
+namespace {
+    Tensor as_dtype(const Tensor& t, DType dtype) {
+        return t.dtype() == dtype ? t : t.astype(dtype);
+    }
+
+    // Générateur des initialisations, un par thread
+    std::mt19937& init_rng() {
+        thread_local std::mt19937 rng{std::random_device{}()};
+        return rng;
+    }
+
+    void fill_uniform(Tensor& t, double bound) {
+        std::uniform_real_distribution<double> u(-bound, bound);
+        NAPCAS_DISPATCH_FLOATING_TYPES(t.dtype(), "reset_parameters", [&] {
+            scalar_t* p = t.data<scalar_t>();
+            for (std::size_t i = 0; i < t.numel(); ++i) p[i] = scalar_t(u(init_rng()));
+        });
+    }
+
+    // Vue NHWC dense de `t` [N, C, H, W] dans le type de calcul : sans copie
+    // si `t` est déjà channels-last et du bon type. Hors autograd.
+    Tensor nhwc(const Tensor& t, DType dtype) {
+        return as_dtype(t.detach().permute({0, 2, 3, 1}), dtype).contiguous();
+    }
+
+    // La sortie suit l'entrée en channels-last ; un tenseur qui est à la
+    // fois contigu et channels-last (C == 1, H == W == 1) donne une sortie
+    // contiguë
+    bool wants_channels_last(const Tensor& input) {
+        return !input.is_contiguous() && is_channels_last(input);
+    }
+
+    // y [N, OH, OW, K] dense -> résultat [N, K, OH, OW] de type `dtype`
+    Tensor from_nhwc(const Tensor& y, DType dtype, bool channels_last) {
+        const Tensor t = as_dtype(y, dtype).permute({0, 3, 1, 2});
+        return channels_last ? t : t.contiguous();
+    }
+
+    // Copie de `r` dans `o` (même forme logique) selon le format mémoire de
+    // `o` : channels-last dense ou contigu
+    void copy_to_layout(const Tensor& r, Tensor& o) {
+        const Tensor src = is_channels_last(o) && !o.is_contiguous()
+                               ? r.permute({0, 2, 3, 1})
+                               : r;
+        kernels::strided_copy(o.data_ptr(), src.data_ptr(), src.shape(), src.strides(),
+                              dtype_size(src.dtype()));
+    }
+
+    void check_image(const Tensor& input, const char* op) {
+        if (input.ndim() != 4)
+            throw std::runtime_error(std::string(op) + ": input must be 4-D [N, C, H, W]");
+    }
+
+    DType compute_dtype(DType out_dtype, const char* op) {
+        if (!is_floating_point(out_dtype))
+            throw std::runtime_error(std::string(op) + ": integer dtypes not supported");
+        return out_dtype == DType::Float64 ? DType::Float64 : DType::Float32;
+    }
+
+    kernels::Pool2dShape pool_shape(const Tensor& input, Size2 kernel, Size2 stride,
+                                    Size2 padding, const char* op) {
+        check_image(input, op);
+        if (stride[0] == 0) stride[0] = kernel[0];
+        if (stride[1] == 0) stride[1] = kernel[1];
+        if (kernel[0] == 0 || kernel[1] == 0)
+            throw std::runtime_error(std::string(op) + ": kernel size must be positive");
+        if (2 * padding[0] > kernel[0] || 2 * padding[1] > kernel[1])
+            throw std::runtime_error(std::string(op) + ": padding must be at most half the kernel size");
+        kernels::Pool2dShape p;
+        p.N = input.shape()[0]; p.C = input.shape()[1];
+        p.H = input.shape()[2]; p.W = input.shape()[3];
+        p.R = kernel[0];        p.S = kernel[1];
+        p.stride_h = stride[0]; p.stride_w = stride[1];
+        p.pad_h = padding[0];   p.pad_w = padding[1];
+        if (p.H + 2 * p.pad_h < p.R || p.W + 2 * p.pad_w < p.S)
+            throw std::runtime_error(std::string(op) + ": kernel larger than padded input");
+        return p;
+    }
+
+    // Pooling commun à max_pool2d et avg_pool2d : `run(x, y, indices, T())`
+    // appelle le noyau ; `indices` n'est alloué que pour le backward du max
+    template<typename Run>
+    Tensor pool2d(const Tensor& input, const kernels::Pool2dShape& p, bool is_max,
+                  bool count_include_pad, const char* op, Run run) {
+        const DType cdt = compute_dtype(input.dtype(), op);
+        profiler::RecordScope prof(op);
+        graph::CaptureScope scope;
+        const bool channels_last = wants_channels_last(input);
+        const Tensor x = nhwc(input, cdt);
+        Tensor y({p.N, p.out_h(), p.out_w(), p.C}, cdt, input.device());
+        Tensor indices;
+        if (is_max && input.requires_grad())
+            indices = Tensor({p.N, p.out_h(), p.out_w(), p.C}, DType::Int64, input.device());
+        if (cdt == DType::Float64) run(x, y, indices, double());
+        else                       run(x, y, indices, float());
+
+        Tensor result = from_nhwc(y, input.dtype(), channels_last);
+        if (scope.active()) {
+            graph::record(op, {input}, result,
+                [p, cdt, run](const std::vector<Tensor>& in, Tensor& o) {
+                    const Tensor xr = nhwc(in[0], cdt);
+                    Tensor yr({p.N, p.out_h(), p.out_w(), p.C}, cdt, in[0].device());
+                    Tensor none;
+                    if (cdt == DType::Float64) run(xr, yr, none, double());
+                    else                       run(xr, yr, none, float());
+                    copy_to_layout(from_nhwc(yr, o.dtype(), false), o);
+                });
+        }
+        if (input.requires_grad())
+            result.set_grad_fn(std::make_shared<Pool2dBackward>(input, p, cdt, channels_last,
+                                                                indices, count_include_pad));
+        if (prof.active())
+            prof.record_io({input}, result, double(p.N * p.out_h() * p.out_w() * p.C * p.R * p.S));
+        return result;
+    }
+}
+
+bool is_channels_last(const Tensor& t) {
+    if (t.ndim() != 4) return false;
+    const Shape& s = t.shape();
+    const std::size_t C = s[1], H = s[2], W = s[3];
+    const std::ptrdiff_t expected[4] = {std::ptrdiff_t(H * W * C), 1, std::ptrdiff_t(W * C),
+                                        std::ptrdiff_t(C)};
+    // Le pas d'une dimension de taille 1 est indifférent
+    for (std::size_t d = 0; d < 4; ++d)
+        if (s[d] > 1 && t.strides()[d] != expected[d]) return false;
+    return true;
+}
+
+Tensor to_channels_last(const Tensor& t) {
+    check_image(t, "to_channels_last");
+    if (is_channels_last(t)) return t;
+    profiler::RecordScope prof("to_channels_last");
+    graph::CaptureScope scope;
+    Tensor out = t.detach().permute({0, 2, 3, 1}).contiguous().permute({0, 3, 1, 2});
+    if (scope.active())
+        graph::record("to_channels_last", {t}, out,
+                      [](const std::vector<Tensor>& in, Tensor& o) { copy_to_layout(in[0], o); });
+    // Même forme logique : gradient identité
+    if (t.requires_grad())
+        out.set_grad_fn(std::make_shared<ReshapeBackward>(t, t.shape()));
+    if (prof.active()) prof.record_io({t}, out);
+    return out;
+}
+
+Tensor conv2d(const Tensor& input, const Tensor& weight, const Tensor& bias,
+              Size2 stride, Size2 padding, Size2 dilation, std::size_t groups,
+              kernels::ConvAlgorithm algorithm) {
+    check_image(input, "conv2d");
+    if (weight.ndim() != 4)
+        throw std::runtime_error("conv2d: weight must be 4-D [out_channels, in_channels/groups, kH, kW]");
+    if (groups == 0 || stride[0] == 0 || stride[1] == 0 || dilation[0] == 0 || dilation[1] == 0)
+        throw std::runtime_error("conv2d: groups, stride and dilation must be positive");
+
+    kernels::Conv2dShape p;
+    p.N = input.shape()[0];  p.C = input.shape()[1];
+    p.H = input.shape()[2];  p.W = input.shape()[3];
+    p.K = weight.shape()[0]; p.R = weight.shape()[2]; p.S = weight.shape()[3];
+    p.stride_h = stride[0];  p.stride_w = stride[1];
+    p.pad_h = padding[0];    p.pad_w = padding[1];
+    p.dil_h = dilation[0];   p.dil_w = dilation[1];
+    p.groups = groups;
+    if (p.C % groups != 0 || p.K % groups != 0)
+        throw std::runtime_error("conv2d: channels not divisible by groups");
+    if (weight.shape()[1] != p.group_in())
+        throw std::runtime_error("conv2d: weight in_channels does not match input channels / groups");
+    if (p.R == 0 || p.S == 0 ||
+        p.H + 2 * p.pad_h < p.dil_h * (p.R - 1) + 1 || p.W + 2 * p.pad_w < p.dil_w * (p.S - 1) + 1)
+        throw std::runtime_error("conv2d: kernel larger than padded input");
+    if (bias.defined() && (bias.ndim() != 1 || bias.shape()[0] != p.K))
+        throw std::runtime_error("conv2d: bias must be 1-D [out_channels]");
+    if (input.device() != weight.device() || (bias.defined() && bias.device() != weight.device()))
+        throw std::runtime_error("conv2d: operands on different devices");
+    if (!kernels::conv_algorithm_supported(algorithm, p))
+        throw std::runtime_error("conv2d: algorithm not supported for this shape");
+    if (algorithm == kernels::ConvAlgorithm::Auto) algorithm = kernels::select_conv_algorithm(p);
+
+    DType out_dtype = promote_types(input.dtype(), weight.dtype());
+    if (bias.defined()) out_dtype = promote_types(out_dtype, bias.dtype());
+    const DType cdt = compute_dtype(out_dtype, "conv2d");
+
+    profiler::RecordScope prof("conv2d");
+    graph::CaptureScope scope;
+    const bool channels_last = wants_channels_last(input);
+    // Poids KRSC : [K, C/groups, R, S] -> [K, R, S, C/groups]
+    const Tensor x = nhwc(input, cdt);
+    const Tensor w = nhwc(weight, cdt);
+    const Tensor b = bias.defined() ? as_dtype(bias.detach(), cdt).contiguous() : Tensor();
+
+    auto run = [p, algorithm, cdt](const Tensor& xs, const Tensor& ws, const Tensor& bs,
+                                   Tensor& ys) {
+        auto typed = [&](auto tag) {
+            using T = decltype(tag);
+            kernels::conv2d_forward(p, algorithm, xs.data<T>(), ws.data<T>(),
+                                    bs.defined() ? bs.data<T>() : nullptr, ys.data<T>());
+        };
+        if (cdt == DType::Float64) typed(double());
+        else                       typed(float());
+    };
+    Tensor y({p.N, p.out_h(), p.out_w(), p.K}, cdt, input.device());
+    run(x, w, b, y);
+
+    Tensor result = from_nhwc(y, out_dtype, channels_last);
+    if (scope.active()) {
+        // Rejeu : même algorithme ; la sortie est écrite directement si elle
+        // est channels-last du type de calcul, sinon via un tampon NHWC
+        graph::record("conv2d", {input, weight, bias}, result,
+            [p, cdt, run](const std::vector<Tensor>& in, Tensor& o) {
+                const Tensor xr = nhwc(in[0], cdt);
+                const Tensor wr = nhwc(in[1], cdt);
+                const Tensor br = in[2].defined() ? as_dtype(in[2], cdt).contiguous() : Tensor();
+                if (o.dtype() == cdt && !o.is_contiguous() && is_channels_last(o)) {
+                    Tensor yo = o.permute({0, 2, 3, 1});
+                    run(xr, wr, br, yo);
+                    return;
+                }
+                Tensor yr({p.N, p.out_h(), p.out_w(), p.K}, cdt, in[0].device());
+                run(xr, wr, br, yr);
+                copy_to_layout(from_nhwc(yr, o.dtype(), false), o);
+            });
+    }
+    if (input.requires_grad() || weight.requires_grad() ||
+        (bias.defined() && bias.requires_grad()))
+        result.set_grad_fn(std::make_shared<Conv2dBackward>(input, weight, bias, x, w, p,
+                                                            channels_last));
+    if (prof.active())
+        prof.record_io({input, weight, bias}, result,
+                       2.0 * double(p.N * p.out_h() * p.out_w() * p.K * p.R * p.S * p.group_in()));
+    return result;
+}
+
+Tensor max_pool2d(const Tensor& input, Size2 kernel, Size2 stride, Size2 padding) {
+    const kernels::Pool2dShape p = pool_shape(input, kernel, stride, padding, "max_pool2d");
+    return pool2d(input, p, true, true, "max_pool2d",
+        [p](const Tensor& x, Tensor& y, Tensor& indices, auto tag) {
+            using T = decltype(tag);
+            kernels::max_pool2d(p, x.data<T>(), y.data<T>(),
+                                indices.defined() ? indices.data<std::int64_t>() : nullptr);
+        });
+}
+
+Tensor avg_pool2d(const Tensor& input, Size2 kernel, Size2 stride, Size2 padding,
+                  bool count_include_pad) {
+    const kernels::Pool2dShape p = pool_shape(input, kernel, stride, padding, "avg_pool2d");
+    return pool2d(input, p, false, count_include_pad, "avg_pool2d",
+        [p, count_include_pad](const Tensor& x, Tensor& y, Tensor&, auto tag) {
+            using T = decltype(tag);
+            kernels::avg_pool2d(p, count_include_pad, x.data<T>(), y.data<T>());
+        });
+}
+
+Conv2d::Conv2d(int in_channels, int out_channels, Size2 kernel_size, Size2 stride,
+               Size2 padding, Size2 dilation, int groups, bool bias, DType dtype,
+               Device device)
+    : in_channels_(in_channels), out_channels_(out_channels), kernel_size_(kernel_size),
+      stride_(stride), padding_(padding), dilation_(dilation), groups_(groups) {
+    if (in_channels < 0 || out_channels < 0)
+        throw std::runtime_error("Conv2d: negative channel count");
+    if (groups <= 0 || in_channels % groups != 0 || out_channels % groups != 0)
+        throw std::runtime_error("Conv2d: channels not divisible by groups");
+    if (!is_floating_point(dtype))
+        throw std::runtime_error("Conv2d: dtype must be floating point");
+    weight_ = Tensor({std::size_t(out_channels), std::size_t(in_channels / groups),
+                      kernel_size[0], kernel_size[1]}, dtype, device);
+    weight_.requires_grad_(true);
+    register_parameter("weight", weight_);
+    if (bias) {
+        bias_ = Tensor({std::size_t(out_channels)}, dtype, device);
+        bias_.requires_grad_(true);
+        register_parameter("bias", bias_);
+    }
+    reset_parameters();
+}
+
+Tensor Conv2d::forward(const Tensor& input) {
+    profiler::RecordScope prof("Conv2d", profiler::EventKind::Module);
+    return conv2d(input, weight_, bias_, stride_, padding_, dilation_, std::size_t(groups_),
+                  algorithm_);
+}
+
+void Conv2d::reset_parameters() {
+    const std::size_t fan_in = std::size_t(in_channels_ / groups_) * kernel_size_[0] *
+                               kernel_size_[1];
+    const double bound = fan_in > 0 ? 1.0 / std::sqrt(double(fan_in)) : 0.0;
+    fill_uniform(weight_, bound);
+    if (bias_.defined()) fill_uniform(bias_, bound);
+}
+
+MaxPool2d::MaxPool2d(Size2 kernel_size, Size2 stride, Size2 padding)
+    : kernel_size_(kernel_size), stride_(stride), padding_(padding) {}
+
+Tensor MaxPool2d::forward(const Tensor& input) {
+    profiler::RecordScope prof("MaxPool2d", profiler::EventKind::Module);
+    return max_pool2d(input, kernel_size_, stride_, padding_);
+}
+
+AvgPool2d::AvgPool2d(Size2 kernel_size, Size2 stride, Size2 padding, bool count_include_pad)
+    : kernel_size_(kernel_size), stride_(stride), padding_(padding),
+      count_include_pad_(count_include_pad) {}
+
+Tensor AvgPool2d::forward(const Tensor& input) {
+    profiler::RecordScope prof("AvgPool2d", profiler::EventKind::Module);
+    return avg_pool2d(input, kernel_size_, stride_, padding_, count_include_pad_);
+}
+
+} // namespace architecture
+} // namespace napcas
@@ -0,0 +1,163 @@
+// cpp/src/architecture/linear.cpp
+
+#include "napcas/architecture/linear.h"
+#include "napcas/dispatch.h"
+#include "napcas/grad_fn.h"
+#include "napcas/graph.h"
+#include "napcas/kernels/gemm.h"
+#include "napcas/profiler.h"
+#include <cmath>
+#include <random>
+#include <stdexcept>
+
+namespace napcas {
+namespace architecture {
+
+namespace {
+    Tensor as_dtype(const Tensor& t, DType dtype) {
+        return t.dtype() == dtype ? t : t.astype(dtype);
+    }
+
+    // Générateur des initialisations, un par thread
+    std::mt19937& init_rng() {
+        thread_local std::mt19937 rng{std::random_device{}()};
+        return rng;
+    }
+
+    void fill_uniform(Tensor& t, double bound) {
+        std::uniform_real_distribution<double> u(-bound, bound);
+        NAPCAS_DISPATCH_FLOATING_TYPES(t.dtype(), "reset_parameters", [&] {
+            scalar_t* p = t.data<scalar_t>();
+            for (std::size_t i = 0; i < t.numel(); ++i) p[i] = scalar_t(u(init_rng()));
+        });
+    }
+}
+
+Tensor linear(const Tensor& input, const Tensor& weight, const Tensor& bias,
+              kernels::Activation activation) {
+    if (weight.ndim() != 2)
+        throw std::runtime_error("linear: weight must be 2-D [out_features, in_features]");
+    const std::size_t N = weight.shape()[0], K = weight.shape()[1];
+    if (input.ndim() == 0 || input.shape().back() != K)
+        throw std::runtime_error("linear: input features do not match weight");
+    if (bias.defined() && (bias.ndim() != 1 || bias.shape()[0] != N))
+        throw std::runtime_error("linear: bias must be 1-D [out_features]");
+    if (input.device() != weight.device() || (bias.defined() && bias.device() != weight.device()))
+        throw std::runtime_error("linear: operands on different devices");
+
+    DType out_dtype = promote_types(input.dtype(), weight.dtype());
+    if (bias.defined()) out_dtype = promote_types(out_dtype, bias.dtype());
+    if (!is_floating_point(out_dtype))
+        throw std::runtime_error("linear: integer dtypes not supported");
+    const DType cdt = out_dtype == DType::Float64 ? DType::Float64 : DType::Float32;
+
+    profiler::RecordScope prof("linear");
+    graph::CaptureScope scope;
+    std::size_t M = 1;
+    for (std::size_t d = 0; d + 1 < input.ndim(); ++d) M *= input.shape()[d];
+    // x [M, K] et W lus via leurs strides : Wᵀ n'est pas matérialisé
+    const Tensor x = as_dtype(input, cdt).reshape({M, K});
+    const Tensor w = as_dtype(weight, cdt);
+    const Tensor b = bias.defined() ? as_dtype(bias, cdt).contiguous() : Tensor();
+
+    Shape out_shape = input.shape();
+    out_shape.back() = N;
+    Tensor out(out_shape, cdt, input.device());
+
+    const bool grad = input.requires_grad() || weight.requires_grad() ||
+                      (bias.defined() && bias.requires_grad());
+    const bool keep_pre = grad && (activation == kernels::Activation::GELU ||
+                                   activation == kernels::Activation::SiLU);
+
+    auto run = [&](auto tag) {
+        using T   = decltype(tag);
+        using Ref = kernels::matrix_ref_t<T>;
+        kernels::GemmEpilogue<T> ep;
+        ep.bias = b.defined() ? b.data<T>() : nullptr;
+        ep.act  = keep_pre ? kernels::Activation::None : activation;
+        kernels::gemm(M, N, K, Ref{x.data<T>(), x.strides()[0], x.strides()[1]},
+                      Ref{w.data<T>(), w.strides()[1], w.strides()[0]},
+                      out.data<T>(), std::ptrdiff_t(N), false, ep);
+    };
+    if (cdt == DType::Float64) run(double());
+    else                       run(float());
+
+    Tensor saved;
+    if (keep_pre) {
+        saved = out;
+        out = Tensor(out_shape, cdt, input.device());
+        NAPCAS_DISPATCH_FLOATING_TYPES(cdt, "linear", [&] {
+            kernels::activation(activation, out.data<scalar_t>(), saved.data<scalar_t>(), out.numel());
+        });
+    } else if (activation != kernels::Activation::None) {
+        saved = out;
+    }
+
+    Tensor result = as_dtype(out, out_dtype);
+    if (scope.active()) {
+        // Rejeu : GEMM et épilogue complet (pas d'autograd), directement sur
+        // les opérandes si aucune conversion ni copie n'a été nécessaire
+        graph::Kernel kernel;
+        if (x.storage() == input.storage() && w.storage() == weight.storage() &&
+            (!bias.defined() || b.storage() == bias.storage()) && out_dtype == cdt) {
+            const std::ptrdiff_t xs0 = x.strides()[0], xs1 = x.strides()[1];
+            const std::ptrdiff_t ws0 = w.strides()[0], ws1 = w.strides()[1];
+            kernel = [=](const std::vector<Tensor>& in, Tensor& o) {
+                auto replay = [&](auto tag) {
+                    using T   = decltype(tag);
+                    using Ref = kernels::matrix_ref_t<T>;
+                    kernels::GemmEpilogue<T> ep;
+                    ep.bias = in[2].defined() ? in[2].data<T>() : nullptr;
+                    ep.act  = activation;
+                    kernels::gemm(M, N, K, Ref{in[0].data<T>(), xs0, xs1},
+                                  Ref{in[1].data<T>(), ws1, ws0},
+                                  o.data<T>(), std::ptrdiff_t(N), false, ep);
+                };
+                if (cdt == DType::Float64) replay(double());
+                else                       replay(float());
+            };
+        } else {
+            kernel = graph::eager_kernel([activation](const std::vector<Tensor>& in) {
+                return linear(in[0], in[1], in[2], activation);
+            });
+        }
+        graph::record("linear", {input, weight, bias}, result, std::move(kernel));
+    }
+    if (grad)
+        result.set_grad_fn(std::make_shared<LinearBackward>(input, weight, bias, x, w, saved,
+                                                            activation));
+    if (prof.active()) prof.record_io({input, weight, bias}, result, 2.0 * double(M * N * K));
+    return result;
+}
+
+Linear::Linear(int in_features, int out_features, bool bias, DType dtype, Device device,
+               kernels::Activation activation)
+    : in_features_(in_features), out_features_(out_features), activation_(activation) {
+    if (in_features < 0 || out_features < 0)
+        throw std::runtime_error("Linear: negative feature count");
+    if (!is_floating_point(dtype))
+        throw std::runtime_error("Linear: dtype must be floating point");
+    weight_ = Tensor({std::size_t(out_features), std::size_t(in_features)}, dtype, device);
+    weight_.requires_grad_(true);
+    register_parameter("weight", weight_);
+    if (bias) {
+        bias_ = Tensor({std::size_t(out_features)}, dtype, device);
+        bias_.requires_grad_(true);
+        register_parameter("bias", bias_);
+    }
+    reset_parameters();
+}
+
+Tensor Linear::forward(const Tensor& input) {
+    profiler::RecordScope prof("Linear", profiler::EventKind::Module);
+    return linear(input, weight_, bias_, activation_);
+}
+
+void Linear::reset_parameters() {
+    const double bound = in_features_ > 0 ? 1.0 / std::sqrt(double(in_features_)) : 0.0;
+    fill_uniform(weight_, bound);
+    if (bias_.defined()) fill_uniform(bias_, bound);
+}
+
+} // namespace architecture
+} // namespace napcas
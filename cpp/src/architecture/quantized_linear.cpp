@@ -0,0 +1,91 @@
+// cpp/src/architecture/quantized_linear.cpp
+
+#include "napcas/architecture/quantized_linear.h"
+#include "napcas/graph.h"
+#include "napcas/profiler.h"
+#include <stdexcept>
+
+namespace napcas {
+namespace architecture {
+
+namespace {
+    Tensor as_float(const Tensor& t) {
+        return t.dtype() == DType::Float32 ? t : t.astype(DType::Float32);
+    }
+}
+
+Tensor quantized_linear(const Tensor& input,
+                        const std::shared_ptr<const kernels::QuantizedWeight>& weight,
+                        const Tensor& bias, kernels::Activation activation) {
+    if (!weight) throw std::runtime_error("quantized_linear: missing weight");
+    const std::size_t N = weight->N, K = weight->K;
+    if (input.ndim() == 0 || input.shape().back() != K)
+        throw std::runtime_error("quantized_linear: input features do not match weight");
+    if (!is_floating_point(input.dtype()))
+        throw std::runtime_error("quantized_linear: input must be floating point");
+    if (bias.defined() && (bias.ndim() != 1 || bias.shape()[0] != N || bias.dtype() != DType::Float32))
+        throw std::runtime_error("quantized_linear: bias must be 1-D float32 [out_features]");
+
+    profiler::RecordScope prof("quantized_linear");
+    graph::CaptureScope scope;
+    std::size_t M = 1;
+    for (std::size_t d = 0; d + 1 < input.ndim(); ++d) M *= input.shape()[d];
+    const Tensor x = as_float(input).reshape({M, K});
+    const Tensor b = bias.defined() ? bias.contiguous() : Tensor();
+
+    Shape out_shape = input.shape();
+    out_shape.back() = N;
+    Tensor out(out_shape, DType::Float32, input.device());
+
+    kernels::GemmEpilogue<float> ep;
+    ep.bias = b.defined() ? b.data<float>() : nullptr;
+    ep.act  = activation;
+    kernels::qgemm(M, kernels::MatrixRef{x.data<float>(), x.strides()[0], x.strides()[1]},
+                   *weight, out.data<float>(), std::ptrdiff_t(N), ep);
+
+    if (scope.active()) {
+        // Rejeu : quantification du lot et GEMM int8 directement sur
+        // l'entrée si aucune conversion ni copie n'a été nécessaire
+        graph::Kernel kernel;
+        if (x.storage() == input.storage() && (!bias.defined() || b.storage() == bias.storage())) {
+            const std::ptrdiff_t xs0 = x.strides()[0], xs1 = x.strides()[1];
+            kernel = [=](const std::vector<Tensor>& in, Tensor& o) {
+                kernels::GemmEpilogue<float> e;
+                e.bias = in[1].defined() ? in[1].data<float>() : nullptr;
+                e.act  = activation;
+                kernels::qgemm(M, kernels::MatrixRef{in[0].data<float>(), xs0, xs1},
+                               *weight, o.data<float>(), std::ptrdiff_t(N), e);
+            };
+        } else {
+            kernel = graph::eager_kernel([weight, activation](const std::vector<Tensor>& in) {
+                return quantized_linear(in[0], weight, in[1], activation);
+            });
+        }
+        graph::record("quantized_linear", {input, bias}, out, std::move(kernel));
+    }
+    if (prof.active()) prof.record_io({input, bias}, out, 2.0 * double(M * N * K));
+    return out;
+}
+
+QuantizedLinear::QuantizedLinear(const Linear& linear) : activation_(linear.activation()) {
+    const Tensor w = as_float(linear.weight().detach());
+    weight_ = std::make_shared<const kernels::QuantizedWeight>(kernels::quantize_weight(
+        w.shape()[0], w.shape()[1],
+        kernels::MatrixRef{w.data<float>(), w.strides()[0], w.strides()[1]}));
+    // Copie : la couche d'origine peut continuer à s'entraîner
+    if (linear.bias().defined()) bias_ = as_float(linear.bias().detach()).clone();
+}
+
+Tensor QuantizedLinear::forward(const Tensor& input) {
+    profiler::RecordScope prof("QuantizedLinear", profiler::EventKind::Module);
+    return quantized_linear(input, weight_, bias_, activation_);
+}
+
+Tensor QuantizedLinear::dequantized_weight() const {
+    Tensor w({weight_->N, weight_->K}, DType::Float32);
+    kernels::dequantize_weight(*weight_, w.data<float>());
+    return w;
+}
+
+} // namespace architecture
+} // namespace napcas
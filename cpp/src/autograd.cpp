@@ -0,0 +1,88 @@
+// cpp/src/autograd.cpp
+
+#include "napcas/autograd.h"
+#include "napcas/grad_fn.h"
+#include "napcas/profiler.h"
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
+
+namespace napcas {
+namespace autograd {
+
+void backward(const Tensor& root, const Tensor& grad_output, bool retain_graph) {
+    if (!root.requires_grad())
+        throw std::runtime_error(
+            "Cannot call backward() on a tensor that does not require grad");
+    if (grad_output.shape() != root.shape())
+        throw std::runtime_error("backward: grad_output shape mismatch");
+
+    std::shared_ptr<GradFn> start = root.gradient_edge();
+
+    // 1) Dépendances : nombre d'arêtes entrantes de chaque nœud atteignable
+    std::unordered_map<GradFn*, std::size_t> deps;
+    {
+        std::vector<GradFn*> stack{start.get()};
+        deps.emplace(start.get(), 0);
+        while (!stack.empty()) {
+            GradFn* fn = stack.back();
+            stack.pop_back();
+            for (const auto& next : fn->next()) {
+                if (!next) continue;
+                auto it = deps.find(next.get());
+                if (it == deps.end()) {
+                    deps.emplace(next.get(), 1);
+                    stack.push_back(next.get());
+                } else {
+                    ++it->second;
+                }
+            }
+        }
+    }
+
+    // 2) Exécution : un nœud est prêt quand tous ses consommateurs ont
+    //    contribué ; son tampon d'entrée accumule ces contributions.
+    std::unordered_map<GradFn*, Tensor> buffers;
+    buffers.emplace(start.get(), grad_output);
+    std::vector<std::shared_ptr<GradFn>> ready{start};
+    while (!ready.empty()) {
+        std::shared_ptr<GradFn> fn = std::move(ready.back());
+        ready.pop_back();
+
+        // Sans tampon, aucun consommateur n'a produit de gradient : le nœud
+        // ne s'exécute pas mais libère quand même ses dépendances
+        std::vector<Tensor> grads;
+        auto buf = buffers.find(fn.get());
+        if (buf != buffers.end()) {
+            Tensor grad = std::move(buf->second);
+            buffers.erase(buf);
+            profiler::RecordScope prof(fn->name(), profiler::EventKind::Backward);
+            grads = fn->apply(grad);
+            if (prof.active()) prof.record_io({grad}, grads);
+        }
+        if (!retain_graph) fn->release_saved();
+
+        const auto& next = fn->next();
+        for (std::size_t i = 0; i < next.size(); ++i) {
+            if (!next[i]) continue;
+            GradFn* n = next[i].get();
+            if (i < grads.size() && grads[i].defined()) {
+                auto it = buffers.find(n);
+                if (it == buffers.end())
+                    buffers.emplace(n, std::move(grads[i]));
+                else
+                    it->second = it->second + grads[i];
+            }
+            if (--deps[n] == 0) ready.push_back(next[i]);
+        }
+    }
+}
+
+} // namespace autograd
+
+void Autograd::backward(const Tensor& tensor, bool retain_graph) const {
+    autograd::backward(tensor, Tensor::ones(tensor.shape(), tensor.dtype(), tensor.device()),
+                       retain_graph);
+}
+
+} // namespace napcas
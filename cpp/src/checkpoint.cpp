@@ -0,0 +1,272 @@
+// cpp/src/checkpoint.cpp
+
+#include "napcas/checkpoint.h"
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace napcas {
+namespace checkpoint {
+
+namespace {
+    constexpr char kMagic[8] = {'N', 'A', 'P', 'C', 'K', 'P', 'T', '1'};
+    // Taille maximale d'une tranche de tenseur non contigu copiée avant écriture
+    constexpr std::size_t kChunkBytes = std::size_t(4) << 20;
+
+    std::size_t align_up(std::size_t n) {
+        return (n + kAlignment - 1) / kAlignment * kAlignment;
+    }
+
+    [[noreturn]] void fail(const std::string& path, const std::string& what) {
+        throw std::runtime_error("checkpoint: " + what + " (" + path + ")");
+    }
+
+    template<typename T>
+    void put(std::string& buf, T value) {
+        buf.append(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    // Lecture bornée de l'en-tête projeté
+    class HeaderReader {
+    public:
+        HeaderReader(const char* begin, const char* end, const std::string& path)
+            : p_(begin), end_(end), path_(path) {}
+
+        template<typename T>
+        T get() {
+            T value;
+            std::memcpy(&value, take(sizeof(T)), sizeof(T));
+            return value;
+        }
+
+        std::string get_string(std::size_t n) { return std::string(take(n), n); }
+
+        std::size_t remaining() const noexcept { return std::size_t(end_ - p_); }
+
+    private:
+        const char* take(std::size_t n) {
+            if (std::size_t(end_ - p_) < n) fail(path_, "truncated header");
+            const char* r = p_;
+            p_ += n;
+            return r;
+        }
+
+        const char*        p_;
+        const char*        end_;
+        const std::string& path_;
+    };
+
+    // Écrit les éléments de `t` en ordre row-major. Un tenseur non contigu
+    // est découpé selon sa première dimension jusqu'à ce que chaque tranche
+    // tienne dans kChunkBytes.
+    void write_tensor(std::ofstream& f, const Tensor& t) {
+        const std::size_t es = dtype_size(t.dtype());
+        if (t.numel() == 0) return;
+        if (t.is_contiguous() || t.numel() * es <= kChunkBytes) {
+            const Tensor c = t.contiguous();
+            f.write(static_cast<const char*>(c.data_ptr()), std::streamsize(c.numel() * es));
+            return;
+        }
+        Shape   shape(t.shape());
+        Strides strides(t.strides());
+        if (shape[0] == 1) {
+            shape.erase(shape.begin());
+            strides.erase(strides.begin());
+            write_tensor(f, t.as_strided(shape, strides, t.storage_offset()));
+            return;
+        }
+        const std::size_t row  = t.numel() / shape[0];
+        const std::size_t rows = std::max<std::size_t>(1, kChunkBytes / (row * es));
+        const std::size_t n    = shape[0];
+        for (std::size_t i = 0; i < n; i += rows) {
+            shape[0] = std::min(rows, n - i);
+            write_tensor(f, t.as_strided(shape, strides,
+                                         t.storage_offset() + i * std::size_t(strides[0])));
+        }
+    }
+
+    // Projection du fichier, partagée par les Storage qui pointent dedans
+    struct Mapping {
+        void*       base;
+        std::size_t size;
+        Mapping(void* b, std::size_t s) : base(b), size(s) {}
+        ~Mapping() { munmap(base, size); }
+        Mapping(const Mapping&) = delete;
+        Mapping& operator=(const Mapping&) = delete;
+    };
+
+    // Fichier temporaire voisin de `target`, supprimé s'il n'a pas été
+    // renommé (path vidé) ; créé exclusif, droits par défaut (umask)
+    struct TempFile {
+        std::string path;
+        int         fd = -1;
+
+        explicit TempFile(const std::string& target) {
+            static std::atomic<unsigned> counter{0};
+            for (int attempt = 0; fd < 0; ++attempt) {
+                path = target + ".tmp." + std::to_string(::getpid()) + "." +
+                       std::to_string(counter.fetch_add(1, std::memory_order_relaxed));
+                fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_EXCL | O_CLOEXEC, 0666);
+                if (fd < 0 && (errno != EEXIST || attempt == 100))
+                    fail(target, std::strerror(errno));
+            }
+        }
+        ~TempFile() {
+            ::close(fd);
+            if (!path.empty()) ::unlink(path.c_str());
+        }
+        TempFile(const TempFile&) = delete;
+        TempFile& operator=(const TempFile&) = delete;
+    };
+}
+
+void save(const std::string& path, const std::map<std::string, Tensor>& tensors) {
+    // En-tête complet (offsets compris) avant toute donnée
+    std::size_t header_size = sizeof(kMagic) + 2 * sizeof(std::uint64_t);
+    for (const auto& kv : tensors) {
+        if (!kv.second.defined())
+            fail(path, "tensor '" + kv.first + "' is undefined");
+        if (kv.second.device().type != DeviceType::CPU)
+            fail(path, "tensor '" + kv.first + "' is not on the CPU");
+        header_size += sizeof(std::uint32_t) + kv.first.size() + sizeof(std::uint8_t) +
+                       sizeof(std::uint32_t) + kv.second.ndim() * sizeof(std::uint64_t) +
+                       2 * sizeof(std::uint64_t);
+    }
+    std::string header(kMagic, sizeof(kMagic));
+    put<std::uint64_t>(header, header_size);
+    put<std::uint64_t>(header, tensors.size());
+    std::vector<std::size_t> offsets;
+    std::size_t offset = align_up(header_size);
+    for (const auto& kv : tensors) {
+        const Tensor& t = kv.second;
+        const std::size_t nbytes = t.numel() * dtype_size(t.dtype());
+        put<std::uint32_t>(header, std::uint32_t(kv.first.size()));
+        header += kv.first;
+        put<std::uint8_t>(header, std::uint8_t(t.dtype()));
+        put<std::uint32_t>(header, std::uint32_t(t.ndim()));
+        for (std::size_t s : t.shape()) put<std::uint64_t>(header, s);
+        put<std::uint64_t>(header, offset);
+        put<std::uint64_t>(header, nbytes);
+        offsets.push_back(offset);
+        offset = align_up(offset + nbytes);
+    }
+
+    // Écrit dans un fichier temporaire du même répertoire puis le renomme :
+    // `path` peut être projeté par un load() dont les tenseurs sont en
+    // cours d'écriture ici, et un fichier tronqué ne doit jamais le remplacer
+    TempFile tmp(path);
+    {
+        std::ofstream f(tmp.path, std::ios::binary);
+        if (!f) fail(path, "cannot open for writing");
+        f.write(header.data(), std::streamsize(header.size()));
+        std::size_t pos = header.size();
+        static const char kZeros[kAlignment] = {};
+        std::size_t i = 0;
+        for (const auto& kv : tensors) {
+            f.write(kZeros, std::streamsize(offsets[i] - pos));
+            write_tensor(f, kv.second);
+            pos = offsets[i] + kv.second.numel() * dtype_size(kv.second.dtype());
+            ++i;
+        }
+        f.close();
+        if (!f) fail(path, "write error");
+    }
+    if (::fsync(tmp.fd) != 0) fail(path, std::strerror(errno));
+    if (::rename(tmp.path.c_str(), path.c_str()) != 0) fail(path, std::strerror(errno));
+    tmp.path.clear();
+    // Au mieux : rend le renommage durable
+    const auto slash = path.rfind('/');
+    const std::string dir = slash == std::string::npos ? "." : path.substr(0, slash + 1);
+    const int dfd = ::open(dir.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (dfd >= 0) {
+        ::fsync(dfd);
+        ::close(dfd);
+    }
+}
+
+std::map<std::string, Tensor> load(const std::string& path) {
+    const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) fail(path, std::strerror(errno));
+    struct stat st;
+    if (::fstat(fd, &st) != 0) {
+        const int err = errno;
+        ::close(fd);
+        fail(path, std::strerror(err));
+    }
+    const std::size_t size = std::size_t(st.st_size);
+    if (size < sizeof(kMagic) + 2 * sizeof(std::uint64_t)) {
+        ::close(fd);
+        fail(path, "not a checkpoint file");
+    }
+    // Privée : les pages écrites sont copiées, le fichier reste intact
+    void* base = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (base == MAP_FAILED) fail(path, std::strerror(errno));
+    auto mapping = std::make_shared<Mapping>(base, size);
+
+    const char* bytes = static_cast<const char*>(base);
+    if (std::memcmp(bytes, kMagic, sizeof(kMagic)) != 0)
+        fail(path, "not a checkpoint file");
+    HeaderReader header(bytes + sizeof(kMagic), bytes + size, path);
+    const auto header_size = header.get<std::uint64_t>();
+    const auto count       = header.get<std::uint64_t>();
+    if (header_size > size) fail(path, "truncated header");
+
+    std::map<std::string, Tensor> out;
+    for (std::uint64_t e = 0; e < count; ++e) {
+        const std::string name = header.get_string(header.get<std::uint32_t>());
+        const auto code = header.get<std::uint8_t>();
+        if (code > std::uint8_t(DType::Int64))
+            fail(path, "unknown dtype for '" + name + "'");
+        const DType dtype = DType(code);
+        // ndim vient du fichier : borné par l'en-tête restant (une dimension,
+        // puis offset et nbytes, sur 8 octets chacun) avant toute allocation
+        const auto ndim = header.get<std::uint32_t>();
+        if (header.remaining() < 2 * sizeof(std::uint64_t) ||
+            ndim > (header.remaining() - 2 * sizeof(std::uint64_t)) / sizeof(std::uint64_t))
+            fail(path, "truncated header");
+        Shape shape(ndim);
+        for (auto& s : shape) s = std::size_t(header.get<std::uint64_t>());
+        const auto offset = header.get<std::uint64_t>();
+        const auto nbytes = header.get<std::uint64_t>();
+
+        // Produit vérifié : une forme choisie pour déborder ne doit pas
+        // retomber sur nbytes
+        std::size_t expected = dtype_size(dtype);
+        bool overflow = false;
+        if (std::find(shape.begin(), shape.end(), std::size_t(0)) != shape.end()) {
+            expected = 0;
+        } else {
+            for (auto s : shape) {
+                if (expected > SIZE_MAX / s) overflow = true;
+                expected *= s;
+            }
+        }
+        if (overflow || nbytes != expected || offset % kAlignment != 0 ||
+            offset < header_size || offset > size || nbytes > size - offset)
+            fail(path, "corrupt entry '" + name + "'");
+
+        // Un Storage par tenseur (compteurs de version distincts), tous
+        // gardant la projection vivante
+        auto storage = std::make_shared<Storage>(
+            const_cast<char*>(bytes) + offset, std::size_t(nbytes), Device{DeviceType::CPU, 0},
+            [mapping](void*) {});
+        out.emplace(name, Tensor::from_storage(std::move(storage), shape,
+                                              Tensor::contiguous_strides(shape), dtype));
+    }
+    return out;
+}
+
+} // namespace checkpoint
+} // namespace napcas
@@ -0,0 +1,115 @@
+// cpp/src/cpu.cpp
+
+#include "napcas/cpu.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <cpuid.h>
+#define NAPCAS_X86 1
+#endif
+
+namespace napcas {
+
+namespace {
+#ifdef NAPCAS_X86
+    std::uint64_t read_xcr0() {
+        std::uint32_t eax, edx;
+        __asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+        return (std::uint64_t(edx) << 32) | eax;
+    }
+#endif
+
+    CpuCapability detect() {
+#ifdef NAPCAS_X86
+        unsigned eax, ebx, ecx, edx;
+        if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx))
+            return CpuCapability::Scalar;
+        CpuCapability cap = (edx & bit_SSE2) ? CpuCapability::SSE2
+                                             : CpuCapability::Scalar;
+        const bool osxsave = ecx & bit_OSXSAVE;
+        const bool avx     = ecx & bit_AVX;
+        const bool fma     = ecx & bit_FMA;
+        const bool f16c    = ecx & bit_F16C;
+        if (!osxsave || !avx)
+            return cap;
+        // L'OS doit sauvegarder les registres YMM (bits 1-2) et ZMM (5-7)
+        const std::uint64_t xcr0 = read_xcr0();
+        const bool ymm_state = (xcr0 & 0x06) == 0x06;
+        const bool zmm_state = (xcr0 & 0xe6) == 0xe6;
+        if (!__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx))
+            return cap;
+        const bool avx2    = ebx & bit_AVX2;
+        const bool avx512f = ebx & bit_AVX512F;
+        if (ymm_state && avx2 && fma && f16c)
+            cap = CpuCapability::AVX2;
+        if (cap == CpuCapability::AVX2 && zmm_state && avx512f)
+            cap = CpuCapability::AVX512;
+        return cap;
+#else
+        return CpuCapability::Scalar;
+#endif
+    }
+
+    // Extensions int8 d'AVX-512 (CPUID 7.0 : EBX bit 30, ECX bit 11)
+    bool detect_avx512_vnni() {
+#ifdef NAPCAS_X86
+        if (detected_cpu_capability() != CpuCapability::AVX512) return false;
+        unsigned eax, ebx, ecx, edx;
+        if (!__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx)) return false;
+        return (ebx & (1u << 30)) && (ecx & (1u << 11));
+#else
+        return false;
+#endif
+    }
+
+    CpuCapability from_env(CpuCapability detected) {
+        const char* env = std::getenv("NAPCAS_CPU_CAPABILITY");
+        if (!env) return detected;
+        CpuCapability wanted = detected;
+        if      (!std::strcmp(env, "scalar")) wanted = CpuCapability::Scalar;
+        else if (!std::strcmp(env, "sse2"))   wanted = CpuCapability::SSE2;
+        else if (!std::strcmp(env, "avx2"))   wanted = CpuCapability::AVX2;
+        else if (!std::strcmp(env, "avx512")) wanted = CpuCapability::AVX512;
+        return std::min(wanted, detected);
+    }
+
+    std::atomic<int>& current() {
+        static std::atomic<int> cap{int(from_env(detected_cpu_capability()))};
+        return cap;
+    }
+}
+
+CpuCapability detected_cpu_capability() {
+    static const CpuCapability cap = detect();
+    return cap;
+}
+
+CpuCapability cpu_capability() {
+    return CpuCapability(current().load(std::memory_order_relaxed));
+}
+
+void set_cpu_capability(CpuCapability cap) {
+    current().store(int(std::min(cap, detected_cpu_capability())),
+                    std::memory_order_relaxed);
+}
+
+bool cpu_has_avx512_vnni() {
+    static const bool vnni = detect_avx512_vnni();
+    return vnni && cpu_capability() == CpuCapability::AVX512;
+}
+
+std::string cpu_capability_to_string(CpuCapability cap) {
+    switch (cap) {
+        case CpuCapability::Scalar: return "scalar";
+        case CpuCapability::SSE2:   return "sse2";
+        case CpuCapability::AVX2:   return "avx2";
+        case CpuCapability::AVX512: return "avx512";
+        default:                    return "unknown";
+    }
+}
+
+} // namespace napcas
@@ -0,0 +1,449 @@
+// cpp/src/data.cpp
+
+#include "napcas/data.h"
+#include "napcas/allocator.h"
+#include "napcas/profiler.h"
+#include "napcas/storage.h"
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <exception>
+#include <map>
+#include <mutex>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <thread>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace napcas {
+namespace data {
+
+namespace {
+    [[noreturn]] void fail(const std::string& path, const std::string& what) {
+        throw std::runtime_error("data: " + path + ": " + what);
+    }
+
+    std::int64_t now_ns() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    // Régions des champs d'un tampon de lot alignées sur une ligne de cache
+    constexpr std::size_t kAlign = 64;
+    std::size_t align_up(std::size_t n) { return (n + kAlign - 1) / kAlign * kAlign; }
+
+    // Tirage uniforme dans [0, n) : les valeurs sous 2^64 mod n sont
+    // rejetées, sinon rng() % n favoriserait les petits indices
+    std::uint64_t uniform_below(std::mt19937_64& rng, std::uint64_t n) {
+        const std::uint64_t threshold = (0 - n) % n;
+        for (;;) {
+            const std::uint64_t r = rng();
+            if (r >= threshold) return r % n;
+        }
+    }
+}
+
+std::size_t Field::bytes() const {
+    std::size_t n = dtype_size(dtype);
+    for (std::size_t s : shape) n *= s;
+    return n;
+}
+
+// ============================== RecordDataset ==============================
+
+struct RecordDataset::File {
+    std::string path;
+    int         fd    = -1;        // Pread
+    const char* map   = nullptr;   // Mmap : fichier entier
+    std::size_t map_bytes = 0;
+    std::size_t first = 0;         // indice global du premier enregistrement
+    std::size_t count = 0;
+};
+
+RecordDataset::RecordDataset(std::vector<std::string> paths, std::vector<Field> fields,
+                             std::size_t header_bytes, ReadMode mode)
+    : fields_(std::move(fields)), header_bytes_(header_bytes), mode_(mode) {
+    if (paths.empty())
+        throw std::runtime_error("RecordDataset: no file");
+    if (fields_.empty())
+        throw std::runtime_error("RecordDataset: no field");
+    for (const Field& f : fields_) {
+        if (f.bytes() == 0)
+            throw std::runtime_error("RecordDataset: field '" + f.name + "' is empty");
+        record_bytes_ += f.bytes();
+    }
+    try {
+        for (std::string& path : paths) {
+            File file;
+            file.path = std::move(path);
+            file.fd   = ::open(file.path.c_str(), O_RDONLY | O_CLOEXEC);
+            if (file.fd < 0) fail(file.path, std::strerror(errno));
+            files_.push_back(file);
+            File& f = files_.back();
+            struct stat st;
+            if (::fstat(f.fd, &st) != 0) fail(f.path, std::strerror(errno));
+            const std::size_t size = std::size_t(st.st_size);
+            if (size < header_bytes_ || (size - header_bytes_) % record_bytes_ != 0)
+                fail(f.path, "size is not the header plus a whole number of " +
+                             std::to_string(record_bytes_) + "-byte records");
+            f.first = size_;
+            f.count = (size - header_bytes_) / record_bytes_;
+            size_  += f.count;
+            if (mode_ == ReadMode::Mmap && size > 0) {
+                void* base = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, f.fd, 0);
+                if (base == MAP_FAILED) fail(f.path, std::strerror(errno));
+                f.map       = static_cast<const char*>(base);
+                f.map_bytes = size;
+                ::close(f.fd);
+                f.fd = -1;
+            }
+        }
+    } catch (...) {
+        close_files();
+        throw;
+    }
+}
+
+RecordDataset::~RecordDataset() { close_files(); }
+
+void RecordDataset::close_files() noexcept {
+    for (File& f : files_) {
+        if (f.map) ::munmap(const_cast<char*>(f.map), f.map_bytes);
+        if (f.fd >= 0) ::close(f.fd);
+        f.map = nullptr;
+        f.fd  = -1;
+    }
+}
+
+const RecordDataset::File& RecordDataset::file_of(std::size_t index) const {
+    if (index >= size_)
+        throw std::runtime_error("RecordDataset: index " + std::to_string(index) + " out of range");
+    // Dernier fichier commençant avant `index` (les fichiers vides sont sautés)
+    auto it = std::upper_bound(files_.begin(), files_.end(), index,
+                               [](std::size_t i, const File& f) { return i < f.first; });
+    while ((it - 1)->count == 0) --it;
+    return *(it - 1);
+}
+
+std::size_t RecordDataset::run_length(std::size_t index) const {
+    const File& f = file_of(index);
+    return f.first + f.count - index;
+}
+
+const char* RecordDataset::read(std::size_t index, std::size_t count, char* scratch) const {
+    const File& f = file_of(index);
+    if (count > f.first + f.count - index)
+        throw std::runtime_error("RecordDataset: read crosses the end of " + f.path);
+    const std::size_t offset = header_bytes_ + (index - f.first) * record_bytes_;
+    if (f.map) return f.map + offset;
+    std::size_t done = 0, len = count * record_bytes_;
+    while (done < len) {
+        const ssize_t r = ::pread(f.fd, scratch + done, len - done, off_t(offset + done));
+        if (r < 0) {
+            if (errno == EINTR) continue;
+            fail(f.path, std::strerror(errno));
+        }
+        if (r == 0) fail(f.path, "unexpected end of file");
+        done += std::size_t(r);
+    }
+    return scratch;
+}
+
+// ============================== DataLoader ==============================
+
+struct DataLoader::State {
+    std::shared_ptr<const RecordDataset> dataset;
+    LoaderOptions            opt;
+    std::vector<std::size_t> field_offset;   // dans un tampon de lot
+    std::vector<std::size_t> record_offset;  // dans un enregistrement
+    std::size_t              slot_bytes  = 0;
+    std::size_t              num_batches = 0;
+    std::size_t              epoch_samples = 0;
+
+    std::mutex               mutex;
+    std::condition_variable  work_cv;    // workers : lot à préparer et tampon libre
+    std::condition_variable  ready_cv;   // next() et start_epoch()
+    std::vector<char*>       slots;      // tous les tampons, libérés par ~State
+    std::vector<char*>       free_slots;
+    std::map<std::size_t, char*> ready;  // lots terminés, par numéro
+    std::vector<std::size_t> order;      // permutation de l'époque
+    std::size_t              epoch = 0;
+    bool                     epoch_begun = false;
+    bool                     active = false;
+    std::uint64_t            generation = 0;   // change à chaque époque
+    std::size_t              next_claim = 0, next_deliver = 0, in_flight = 0;
+    bool                     stop = false;
+    std::exception_ptr       error;
+    std::vector<std::thread> workers;
+
+    LoaderStats              stats;
+    std::int64_t             first_next_ns = 0;
+
+    ~State() {
+        for (char* s : slots) {
+            if (opt.pin_memory) ::munlock(s, slot_bytes);
+            cpu_free(s);
+        }
+    }
+
+    // Sous le verrou. Pages touchées d'avance : pas de faute de page au
+    // premier remplissage.
+    char* new_slot() {
+        char* s = static_cast<char*>(cpu_malloc(slot_bytes));
+        std::memset(s, 0, slot_bytes);
+        if (opt.pin_memory) (void)::mlock(s, slot_bytes);
+        slots.push_back(s);
+        return s;
+    }
+
+    void release(char* slot) {
+        std::lock_guard<std::mutex> lock(mutex);
+        free_slots.push_back(slot);
+        work_cv.notify_one();
+    }
+
+    std::size_t rows_of(std::size_t batch) const {
+        return std::min(opt.batch_size, epoch_samples - batch * opt.batch_size);
+    }
+
+    // Sous le verrou, aucun worker en cours (in_flight == 0)
+    void begin_epoch(std::unique_lock<std::mutex>& lock) {
+        if (epoch_begun) ++epoch;
+        epoch_begun = true;
+        active = false;
+        ++generation;
+        ready_cv.wait(lock, [&] { return in_flight == 0; });
+        for (auto& kv : ready) free_slots.push_back(kv.second);
+        ready.clear();
+        error = nullptr;
+        std::iota(order.begin(), order.end(), std::size_t(0));
+        if (opt.shuffle) {
+            // Fisher-Yates explicite : même permutation quelle que soit la
+            // bibliothèque standard
+            std::mt19937_64 rng(opt.seed + 0x9E3779B97F4A7C15ull * (epoch + 1));
+            for (std::size_t i = order.size(); i > 1; --i)
+                std::swap(order[i - 1], order[uniform_below(rng, i)]);
+        }
+        next_claim = next_deliver = 0;
+        active = true;
+        work_cv.notify_all();
+    }
+
+    // Assemble le lot `batch` dans `slot` ; les suites d'indices consécutifs
+    // d'un même fichier sont lues d'un bloc
+    void fill(char* slot, std::size_t batch, std::vector<char>& scratch) {
+        profiler::RecordScope prof("dataloader_fill");
+        const RecordDataset& ds = *dataset;
+        const auto& fields = ds.fields();
+        const std::size_t rb = ds.record_bytes(), rows = rows_of(batch);
+        const std::size_t* idx = order.data() + batch * opt.batch_size;
+        if (ds.mode() == ReadMode::Pread && scratch.size() < opt.batch_size * rb)
+            scratch.resize(opt.batch_size * rb);
+        for (std::size_t i = 0; i < rows;) {
+            const std::size_t limit = std::min(rows - i, ds.run_length(idx[i]));
+            std::size_t run = 1;
+            while (run < limit && idx[i + run] == idx[i] + run) ++run;
+            const char* src = ds.read(idx[i], run, scratch.data());
+            if (fields.size() == 1) {
+                std::memcpy(slot + i * rb, src, run * rb);
+            } else {
+                for (std::size_t r = 0; r < run; ++r)
+                    for (std::size_t f = 0; f < fields.size(); ++f) {
+                        const std::size_t fb = fields[f].bytes();
+                        std::memcpy(slot + field_offset[f] + (i + r) * fb,
+                                    src + r * rb + record_offset[f], fb);
+                    }
+            }
+            i += run;
+        }
+    }
+
+    void worker() {
+        std::vector<char> scratch;
+        std::unique_lock<std::mutex> lock(mutex);
+        auto has_work = [&] { return active && next_claim < num_batches; };
+        for (;;) {
+            if (!stop && !(has_work() && !free_slots.empty())) {
+                // Travail restant mais aucun tampon : le consommateur est en retard
+                const bool starved = has_work();
+                const std::int64_t t0 = now_ns();
+                work_cv.wait(lock, [&] { return stop || (has_work() && !free_slots.empty()); });
+                if (starved) stats.worker_idle_ns += now_ns() - t0;
+            }
+            if (stop) return;
+            const std::size_t batch = next_claim++;
+            char* slot = free_slots.back();
+            free_slots.pop_back();
+            const std::uint64_t gen = generation;
+            ++in_flight;
+            lock.unlock();
+
+            std::exception_ptr err;
+            const std::int64_t t0 = now_ns();
+            try {
+                fill(slot, batch, scratch);
+            } catch (...) {
+                err = std::current_exception();
+            }
+            const std::int64_t dt = now_ns() - t0;
+
+            lock.lock();
+            --in_flight;
+            stats.read_ns += dt;
+            if (gen != generation || err) {
+                if (gen == generation && !error) error = err;
+                free_slots.push_back(slot);
+                work_cv.notify_one();
+            } else {
+                ready.emplace(batch, slot);
+            }
+            ready_cv.notify_all();
+        }
+    }
+};
+
+namespace {
+    // Rend le tampon à l'anneau à la destruction du dernier Storage du lot
+    struct SlotLease {
+        std::shared_ptr<DataLoader::State> state;
+        char*                              slot;
+        SlotLease(std::shared_ptr<DataLoader::State> s, char* p) : state(std::move(s)), slot(p) {}
+        ~SlotLease() { state->release(slot); }
+        SlotLease(const SlotLease&)            = delete;
+        SlotLease& operator=(const SlotLease&) = delete;
+    };
+}
+
+DataLoader::DataLoader(std::shared_ptr<const RecordDataset> dataset, LoaderOptions options)
+    : state_(std::make_shared<State>()) {
+    if (!dataset)
+        throw std::runtime_error("DataLoader: null dataset");
+    if (options.batch_size == 0 || options.num_workers == 0 || options.prefetch == 0)
+        throw std::runtime_error("DataLoader: batch_size, num_workers and prefetch must be positive");
+    State& s = *state_;
+    s.dataset = std::move(dataset);
+    s.opt     = options;
+    const RecordDataset& ds = *s.dataset;
+    std::size_t rec = 0;
+    for (const Field& f : ds.fields()) {
+        s.field_offset.push_back(s.slot_bytes);
+        s.record_offset.push_back(rec);
+        s.slot_bytes += align_up(options.batch_size * f.bytes());
+        rec += f.bytes();
+    }
+    s.num_batches   = options.drop_last ? ds.size() / options.batch_size
+                                        : (ds.size() + options.batch_size - 1) / options.batch_size;
+    s.epoch_samples = options.drop_last ? s.num_batches * options.batch_size : ds.size();
+    s.order.resize(ds.size());
+    // Un tampon par lot d'avance, plus celui que l'appelant tient
+    for (std::size_t i = 0; i <= options.prefetch; ++i) s.free_slots.push_back(s.new_slot());
+    for (std::size_t i = 0; i < options.num_workers; ++i)
+        s.workers.emplace_back([st = state_.get()] { st->worker(); });
+}
+
+DataLoader::~DataLoader() {
+    {
+        std::lock_guard<std::mutex> lock(state_->mutex);
+        state_->stop = true;
+    }
+    state_->work_cv.notify_all();
+    for (std::thread& t : state_->workers) t.join();
+}
+
+void DataLoader::start_epoch() {
+    std::unique_lock<std::mutex> lock(state_->mutex);
+    state_->begin_epoch(lock);
+}
+
+std::vector<Tensor> DataLoader::next() {
+    profiler::RecordScope prof("dataloader_next");
+    State& s = *state_;
+    std::unique_lock<std::mutex> lock(s.mutex);
+    if (!s.epoch_begun) s.begin_epoch(lock);
+    const std::int64_t t0 = now_ns();
+    if (s.first_next_ns == 0) s.first_next_ns = t0;
+    bool waited = false;
+    char* slot = nullptr;
+    for (;;) {
+        if (s.error) {
+            std::exception_ptr err = s.error;
+            s.error  = nullptr;
+            s.active = false;
+            std::rethrow_exception(err);
+        }
+        if (!s.active || s.next_deliver == s.num_batches) {
+            s.active = false;
+            return {};
+        }
+        auto it = s.ready.find(s.next_deliver);
+        if (it != s.ready.end()) {
+            slot = it->second;
+            s.ready.erase(it);
+            break;
+        }
+        // Aucun tampon libre et rien en préparation : l'appelant garde tous
+        // les lots livrés, l'anneau grandit plutôt que de bloquer
+        if (s.free_slots.empty() && s.next_claim == s.next_deliver) {
+            s.free_slots.push_back(s.new_slot());
+            s.work_cv.notify_one();
+        }
+        waited = true;
+        s.ready_cv.wait(lock);
+    }
+    const std::size_t rows = s.rows_of(s.next_deliver++);
+    s.stats.batches += 1;
+    s.stats.samples += rows;
+    s.stats.bytes   += rows * s.dataset->record_bytes();
+    if (waited) s.stats.stall_ns += now_ns() - t0;
+    lock.unlock();
+
+    auto lease = std::make_shared<SlotLease>(state_, slot);
+    std::vector<Tensor> out;
+    const auto& fields = s.dataset->fields();
+    out.reserve(fields.size());
+    for (std::size_t f = 0; f < fields.size(); ++f) {
+        Shape shape;
+        shape.push_back(rows);
+        for (std::size_t d : fields[f].shape) shape.push_back(d);
+        auto storage = std::make_shared<Storage>(slot + s.field_offset[f], rows * fields[f].bytes(),
+                                                 Device{DeviceType::CPU, 0}, [lease](void*) {});
+        out.push_back(Tensor::from_storage(std::move(storage), shape,
+                                           Tensor::contiguous_strides(shape), fields[f].dtype));
+    }
+    return out;
+}
+
+std::size_t DataLoader::num_batches() const noexcept { return state_->num_batches; }
+
+std::size_t DataLoader::epoch() const noexcept {
+    std::lock_guard<std::mutex> lock(state_->mutex);
+    return state_->epoch;
+}
+
+const LoaderOptions& DataLoader::options() const noexcept { return state_->opt; }
+
+const RecordDataset& DataLoader::dataset() const noexcept { return *state_->dataset; }
+
+LoaderStats DataLoader::stats() const {
+    std::lock_guard<std::mutex> lock(state_->mutex);
+    LoaderStats out = state_->stats;
+    out.elapsed_ns = state_->first_next_ns ? now_ns() - state_->first_next_ns : 0;
+    out.ring_size  = state_->slots.size();
+    return out;
+}
+
+void DataLoader::reset_stats() {
+    std::lock_guard<std::mutex> lock(state_->mutex);
+    state_->stats         = LoaderStats();
+    state_->first_next_ns = 0;
+}
+
+} // namespace data
+} // namespace napcas
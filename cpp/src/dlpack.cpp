@@ -0,0 +1,122 @@
+// cpp/src/dlpack.cpp
+
+#include "napcas/dlpack.h"
+#include <stdexcept>
+#include <vector>
+
+namespace napcas {
+
+namespace {
+    DLDataType to_dl_dtype(DType dtype) {
+        const uint8_t bits = uint8_t(dtype_size(dtype) * 8);
+        switch (dtype) {
+            case DType::Float16:
+            case DType::Float32:
+            case DType::Float64:  return {kDLFloat, bits, 1};
+            case DType::BFloat16: return {kDLBfloat, bits, 1};
+            case DType::Int8:
+            case DType::Int32:
+            case DType::Int64:    return {kDLInt, bits, 1};
+            case DType::UInt8:    return {kDLUInt, bits, 1};
+        }
+        throw std::runtime_error("to_dlpack: unsupported dtype");
+    }
+
+    DType from_dl_dtype(DLDataType t) {
+        if (t.lanes != 1)
+            throw std::runtime_error("from_dlpack: vector dtypes are not supported");
+        switch (t.code) {
+            case kDLFloat:
+                if (t.bits == 16) return DType::Float16;
+                if (t.bits == 32) return DType::Float32;
+                if (t.bits == 64) return DType::Float64;
+                break;
+            case kDLBfloat:
+                if (t.bits == 16) return DType::BFloat16;
+                break;
+            case kDLInt:
+                if (t.bits == 8)  return DType::Int8;
+                if (t.bits == 32) return DType::Int32;
+                if (t.bits == 64) return DType::Int64;
+                break;
+            case kDLUInt:
+                if (t.bits == 8)  return DType::UInt8;
+                break;
+        }
+        throw std::runtime_error("from_dlpack: unsupported dtype (code " +
+                                 std::to_string(t.code) + ", " +
+                                 std::to_string(t.bits) + " bits)");
+    }
+
+    // Contexte de l'export : une copie superficielle garde le Storage vivant
+    struct ExportContext {
+        Tensor               tensor;
+        std::vector<int64_t> shape;
+        std::vector<int64_t> strides;
+        DLManagedTensor      managed;
+    };
+}
+
+DLManagedTensor* to_dlpack(const Tensor& tensor) {
+    if (tensor.device().type != DeviceType::CPU)
+        throw std::runtime_error("to_dlpack: only CPU tensors are supported");
+    auto* ctx = new ExportContext{tensor.detach(), {}, {}, {}};
+    ctx->shape.assign(tensor.shape().begin(), tensor.shape().end());
+    ctx->strides.assign(tensor.strides().begin(), tensor.strides().end());
+
+    DLTensor& dl  = ctx->managed.dl_tensor;
+    dl.data        = ctx->tensor.storage() ? ctx->tensor.storage()->data() : nullptr;
+    dl.device      = {kDLCPU, 0};
+    dl.ndim        = int32_t(ctx->shape.size());
+    dl.dtype       = to_dl_dtype(tensor.dtype());
+    dl.shape       = ctx->shape.data();
+    dl.strides     = ctx->strides.data();
+    dl.byte_offset = uint64_t(tensor.storage_offset() * dtype_size(tensor.dtype()));
+    ctx->managed.manager_ctx = ctx;
+    ctx->managed.deleter = [](DLManagedTensor* self) {
+        delete static_cast<ExportContext*>(self->manager_ctx);
+    };
+    return &ctx->managed;
+}
+
+Tensor from_dlpack(DLManagedTensor* managed) {
+    if (!managed)
+        throw std::runtime_error("from_dlpack: null tensor");
+    const DLTensor& dl = managed->dl_tensor;
+    if (dl.device.device_type != kDLCPU)
+        throw std::runtime_error("from_dlpack: only CPU tensors are supported");
+    const DType dtype = from_dl_dtype(dl.dtype);
+    const std::size_t es = dtype_size(dtype);
+    if (dl.byte_offset % es != 0)
+        throw std::runtime_error("from_dlpack: byte_offset is not a multiple of the element size");
+
+    Shape   shape(dl.shape, dl.shape + dl.ndim);
+    Strides strides(shape.size());
+    std::size_t numel = 1;
+    for (auto s : shape) numel *= s;
+    if (dl.strides) {
+        for (int d = 0; d < dl.ndim; ++d) {
+            if (dl.strides[d] < 0)
+                throw std::runtime_error("from_dlpack: negative strides are not supported");
+            strides[d] = std::ptrdiff_t(dl.strides[d]);
+        }
+    } else {
+        std::ptrdiff_t s = 1;
+        for (int d = dl.ndim - 1; d >= 0; --d) {
+            strides[d] = s;
+            s *= std::ptrdiff_t(shape[d]);
+        }
+    }
+    const std::size_t offset = std::size_t(dl.byte_offset) / es;
+    std::size_t extent = numel == 0 ? 0 : offset + 1;
+    for (std::size_t d = 0; d < shape.size() && extent; ++d)
+        extent += (shape[d] - 1) * std::size_t(strides[d]);
+
+    // Le Storage adopte le buffer ; son deleter rend la main au producteur
+    auto storage = std::make_shared<Storage>(
+        dl.data, extent * es, Device{DeviceType::CPU, 0},
+        [managed](void*) { if (managed->deleter) managed->deleter(managed); });
+    return Tensor::from_storage(std::move(storage), shape, strides, dtype, offset);
+}
+
+} // namespace napcas
@@ -0,0 +1,578 @@
+// cpp/src/grad_fn.cpp
+
+#include "napcas/grad_fn.h"
+#include "napcas/dispatch.h"
+#include "napcas/kernels/gemm.h"
+#include "napcas/kernels/normalization.h"
+#include "napcas/kernels/reduce.h"
+#include <stdexcept>
+#include <string>
+
+namespace napcas {
+
+namespace {
+    // Gradient d'une entrée diffusée : somme sur les dimensions ajoutées,
+    // puis conversion vers le type de l'entrée (promotion)
+    Tensor reduce_grad(const Tensor& g, const Shape& shape, DType dtype) {
+        Tensor r = g.shape() == shape ? g : g.sum_to_size(shape);
+        return r.dtype() == dtype ? r : r.astype(dtype);
+    }
+
+    Tensor scalar_like(double value, const Tensor& t) {
+        return Tensor({}, std::vector<double>{value}, t.dtype(), t.device());
+    }
+}
+
+void GradFn::check_not_released() const {
+    if (released_)
+        throw std::runtime_error(
+            std::string(name()) + ": trying to backward through the graph a second time "
+            "(saved tensors were released), use retain_graph=true");
+    for (const auto& v : saved_versions_) {
+        const std::shared_ptr<Storage> storage = v.storage.lock();
+        if (storage && storage->version() != v.version)
+            throw std::runtime_error(
+                std::string(name()) + ": a tensor saved for backward has been modified by an "
+                "in-place operation (version " + std::to_string(storage->version()) +
+                ", expected " + std::to_string(v.version) + ")");
+    }
+}
+
+Tensor GradFn::save(const Tensor& t) {
+    if (!t.defined()) return Tensor();
+    saved_versions_.push_back({t.storage(), t.storage()->version()});
+    return t.detach();
+}
+
+// ===================== AccumulateGrad =====================
+
+std::vector<Tensor> AccumulateGrad::apply(const Tensor& grad_output) {
+    // Première contribution copiée : le gradient ne partage jamais le
+    // Storage d'un autre tenseur (ex. celui d'une autre feuille via Add)
+    std::lock_guard<std::mutex> lock(meta_->mutex);
+    // Contributions suivantes ajoutées en place dans le tampon
+    if (!meta_->grad.defined())
+        meta_->grad = grad_output.clone();
+    else if (meta_->grad.dtype() == promote_types(meta_->grad.dtype(), grad_output.dtype()) &&
+             meta_->grad.shape() == grad_output.shape())
+        meta_->grad.add_(grad_output);
+    else
+        meta_->grad = meta_->grad + grad_output;
+    return {};
+}
+
+// ===================== Opérations de forme =====================
+
+ReshapeBackward::ReshapeBackward(const Tensor& input, Shape input_shape)
+    : GradFn({input.gradient_edge()}), input_shape_(std::move(input_shape)) {}
+
+std::vector<Tensor> ReshapeBackward::apply(const Tensor& grad_output) {
+    return {grad_output.reshape(input_shape_)};
+}
+
+PermuteBackward::PermuteBackward(const Tensor& input, std::vector<int> inverse)
+    : GradFn({input.gradient_edge()}), inverse_(std::move(inverse)) {}
+
+std::vector<Tensor> PermuteBackward::apply(const Tensor& grad_output) {
+    return {grad_output.permute(inverse_)};
+}
+
+SqueezeBackward::SqueezeBackward(const Tensor& input, int dim)
+    : GradFn({input.gradient_edge()}), dim_(dim) {}
+
+std::vector<Tensor> SqueezeBackward::apply(const Tensor& grad_output) {
+    return {grad_output.unsqueeze(dim_)};
+}
+
+UnsqueezeBackward::UnsqueezeBackward(const Tensor& input, int dim)
+    : GradFn({input.gradient_edge()}), dim_(dim) {}
+
+std::vector<Tensor> UnsqueezeBackward::apply(const Tensor& grad_output) {
+    return {grad_output.squeeze(dim_)};
+}
+
+// ===================== Opérations binaires =====================
+
+BinaryBackward::BinaryBackward(const Tensor& a, const Tensor& b)
+    : GradFn({a.gradient_edge(), b.gradient_edge()}),
+      a_shape_(a.shape()), b_shape_(b.shape()),
+      a_dtype_(a.dtype()), b_dtype_(b.dtype()) {}
+
+std::vector<Tensor> AddBackward::apply(const Tensor& g) {
+    std::vector<Tensor> out(2);
+    if (needs_grad(0)) out[0] = reduce_grad(g, a_shape_, a_dtype_);
+    if (needs_grad(1)) out[1] = reduce_grad(g, b_shape_, b_dtype_);
+    return out;
+}
+
+std::vector<Tensor> SubBackward::apply(const Tensor& g) {
+    std::vector<Tensor> out(2);
+    if (needs_grad(0)) out[0] = reduce_grad(g, a_shape_, a_dtype_);
+    if (needs_grad(1)) out[1] = reduce_grad(scalar_like(-1.0, g) * g, b_shape_, b_dtype_);
+    return out;
+}
+
+MulBackward::MulBackward(const Tensor& a, const Tensor& b) : BinaryBackward(a, b) {
+    if (needs_grad(1)) a_ = save(a);
+    if (needs_grad(0)) b_ = save(b);
+}
+
+std::vector<Tensor> MulBackward::apply(const Tensor& g) {
+    check_not_released();
+    std::vector<Tensor> out(2);
+    if (needs_grad(0)) out[0] = reduce_grad(g * b_, a_shape_, a_dtype_);
+    if (needs_grad(1)) out[1] = reduce_grad(g * a_, b_shape_, b_dtype_);
+    return out;
+}
+
+void MulBackward::release_saved_impl() {
+    a_ = Tensor();
+    b_ = Tensor();
+}
+
+DivBackward::DivBackward(const Tensor& a, const Tensor& b) : BinaryBackward(a, b) {
+    if (needs_grad(1)) a_ = save(a);
+    b_ = save(b);
+}
+
+// d(a/b)/da = 1/b ; d(a/b)/db = -a/b²
+std::vector<Tensor> DivBackward::apply(const Tensor& g) {
+    check_not_released();
+    std::vector<Tensor> out(2);
+    const Tensor ga = g / b_;
+    if (needs_grad(0)) out[0] = reduce_grad(ga, a_shape_, a_dtype_);
+    if (needs_grad(1))
+        out[1] = reduce_grad(scalar_like(-1.0, ga) * ga * a_ / b_, b_shape_, b_dtype_);
+    return out;
+}
+
+void DivBackward::release_saved_impl() {
+    a_ = Tensor();
+    b_ = Tensor();
+}
+
+MatMulBackward::MatMulBackward(const Tensor& a, const Tensor& b) : BinaryBackward(a, b) {
+    if (needs_grad(1)) a_ = save(a);
+    if (needs_grad(0)) b_ = save(b);
+}
+
+// Les opérandes 1D et la dimension correspondante de g sont d'abord remis
+// sous forme matricielle ; les dimensions de lot diffusées sont sommées.
+std::vector<Tensor> MatMulBackward::apply(const Tensor& g) {
+    check_not_released();
+    const bool a_vec = a_shape_.size() == 1;
+    const bool b_vec = b_shape_.size() == 1;
+    Tensor g2 = g;
+    if (b_vec) g2 = g2.unsqueeze(int(g2.ndim()));
+    if (a_vec) g2 = g2.unsqueeze(int(g2.ndim()) - 1);
+
+    std::vector<Tensor> out(2);
+    if (needs_grad(0)) {
+        Tensor b2 = b_vec ? b_.unsqueeze(1) : b_;
+        const int bl = int(b2.ndim()) - 1;
+        Tensor ga = g2.matmul(b2.transpose(bl - 1, bl));
+        Shape a2_shape = a_shape_;
+        if (a_vec) a2_shape.insert(a2_shape.begin(), 1);
+        ga = ga.sum_to_size(a2_shape);
+        if (a_vec) ga = ga.reshape(a_shape_);
+        out[0] = reduce_grad(ga, a_shape_, a_dtype_);
+    }
+    if (needs_grad(1)) {
+        Tensor a2 = a_vec ? a_.unsqueeze(0) : a_;
+        const int al = int(a2.ndim()) - 1;
+        Tensor gb = a2.transpose(al - 1, al).matmul(g2);
+        Shape b2_shape = b_shape_;
+        if (b_vec) b2_shape.push_back(1);
+        gb = gb.sum_to_size(b2_shape);
+        if (b_vec) gb = gb.reshape(b_shape_);
+        out[1] = reduce_grad(gb, b_shape_, b_dtype_);
+    }
+    return out;
+}
+
+void MatMulBackward::release_saved_impl() {
+    a_ = Tensor();
+    b_ = Tensor();
+}
+
+ExpBackward::ExpBackward(const Tensor& input, const Tensor& result)
+    : GradFn({input.gradient_edge()}), result_(save(result)) {}
+
+std::vector<Tensor> ExpBackward::apply(const Tensor& g) {
+    check_not_released();
+    return {g * result_};
+}
+
+void ExpBackward::release_saved_impl() {
+    result_ = Tensor();
+}
+
+// ===================== Activations et normalisations =====================
+
+namespace {
+    // Gradient de sortie dense, du type des tenseurs sauvegardés
+    Tensor dense_grad(const Tensor& g, DType dtype) {
+        const Tensor c = g.dtype() == dtype ? g : g.astype(dtype);
+        return c.contiguous();
+    }
+
+    // Tensor nul pour une arête sans gradient, sinon un tampon de `shape`
+    Tensor grad_buffer(bool needed, const Shape& shape, const Tensor& like) {
+        return needed ? Tensor(shape, like.dtype(), like.device()) : Tensor();
+    }
+
+    template<typename T>
+    T* data_or_null(Tensor& t) { return t.defined() ? t.data<T>() : nullptr; }
+
+    template<typename T>
+    const T* data_or_null(const Tensor& t) { return t.defined() ? t.data<T>() : nullptr; }
+}
+
+ActivationBackward::ActivationBackward(const Tensor& input, const Tensor& saved,
+                                       kernels::Activation act)
+    : GradFn({input.gradient_edge()}), saved_(save(saved)), act_(act) {}
+
+const char* ActivationBackward::name() const {
+    switch (act_) {
+        case kernels::Activation::ReLU: return "ReluBackward";
+        case kernels::Activation::GELU: return "GeluBackward";
+        case kernels::Activation::SiLU: return "SiluBackward";
+        case kernels::Activation::None: break;
+    }
+    return "ActivationBackward";
+}
+
+std::vector<Tensor> ActivationBackward::apply(const Tensor& g) {
+    check_not_released();
+    const Tensor gc = dense_grad(g, saved_.dtype());
+    Tensor out(saved_.shape(), saved_.dtype(), saved_.device());
+    NAPCAS_DISPATCH_FLOATING_TYPES(saved_.dtype(), name(), [&] {
+        kernels::activation_backward(act_, out.data<scalar_t>(), gc.data<scalar_t>(),
+                                     saved_.data<scalar_t>(), out.numel());
+    });
+    return {out};
+}
+
+void ActivationBackward::release_saved_impl() {
+    saved_ = Tensor();
+}
+
+SoftmaxBackward::SoftmaxBackward(const Tensor& input, const Tensor& rows_out, int dim, bool log)
+    : GradFn({input.gradient_edge()}), out_(save(rows_out)), dim_(dim), log_(log) {}
+
+std::vector<Tensor> SoftmaxBackward::apply(const Tensor& g) {
+    check_not_released();
+    const int last = int(out_.ndim()) - 1;
+    const Tensor gt = dense_grad(dim_ == last ? g : g.transpose(dim_, last), out_.dtype());
+    Tensor gi(out_.shape(), out_.dtype(), out_.device());
+    const std::size_t cols = out_.shape().back();
+    const std::size_t rows = cols ? out_.numel() / cols : 0;
+    NAPCAS_DISPATCH_FLOATING_TYPES(out_.dtype(), name(), [&] {
+        kernels::softmax_backward(gi.data<scalar_t>(), gt.data<scalar_t>(),
+                                  out_.data<scalar_t>(), rows, cols, log_);
+    });
+    return {dim_ == last ? gi : gi.transpose(dim_, last)};
+}
+
+void SoftmaxBackward::release_saved_impl() {
+    out_ = Tensor();
+}
+
+LayerNormBackward::LayerNormBackward(const Tensor& input, const Tensor& weight, const Tensor& bias,
+                                     const Tensor& mean, const Tensor& rstd)
+    : GradFn({input.gradient_edge(), weight.gradient_edge(), bias.gradient_edge()}),
+      input_(save(input.contiguous())),
+      weight_(weight.defined() ? save(weight.contiguous()) : Tensor()),
+      mean_(mean), rstd_(rstd) {}
+
+std::vector<Tensor> LayerNormBackward::apply(const Tensor& g) {
+    check_not_released();
+    const Tensor gc = dense_grad(g, input_.dtype());
+    const std::size_t cols = input_.shape().back();
+    const std::size_t rows = cols ? input_.numel() / cols : 0;
+    Tensor dx(input_.shape(), input_.dtype(), input_.device());
+    Tensor dw = grad_buffer(needs_grad(1), {cols}, input_);
+    Tensor db = grad_buffer(needs_grad(2), {cols}, input_);
+    NAPCAS_DISPATCH_FLOATING_TYPES(input_.dtype(), name(), [&] {
+        using stat_t = compute_type_t<scalar_t>;
+        kernels::layer_norm_backward(dx.data<scalar_t>(), data_or_null<scalar_t>(dw),
+                                     data_or_null<scalar_t>(db), gc.data<scalar_t>(),
+                                     input_.data<scalar_t>(), data_or_null<scalar_t>(weight_),
+                                     mean_.data<stat_t>(), rstd_.data<stat_t>(), rows, cols);
+    });
+    return {needs_grad(0) ? dx : Tensor(), dw, db};
+}
+
+void LayerNormBackward::release_saved_impl() {
+    input_  = Tensor();
+    weight_ = Tensor();
+    mean_   = Tensor();
+    rstd_   = Tensor();
+}
+
+RMSNormBackward::RMSNormBackward(const Tensor& input, const Tensor& weight, const Tensor& rstd)
+    : GradFn({input.gradient_edge(), weight.gradient_edge()}),
+      input_(save(input.contiguous())),
+      weight_(weight.defined() ? save(weight.contiguous()) : Tensor()),
+      rstd_(rstd) {}
+
+std::vector<Tensor> RMSNormBackward::apply(const Tensor& g) {
+    check_not_released();
+    const Tensor gc = dense_grad(g, input_.dtype());
+    const std::size_t cols = input_.shape().back();
+    const std::size_t rows = cols ? input_.numel() / cols : 0;
+    Tensor dx(input_.shape(), input_.dtype(), input_.device());
+    Tensor dw = grad_buffer(needs_grad(1), {cols}, input_);
+    NAPCAS_DISPATCH_FLOATING_TYPES(input_.dtype(), name(), [&] {
+        using stat_t = compute_type_t<scalar_t>;
+        kernels::rms_norm_backward(dx.data<scalar_t>(), data_or_null<scalar_t>(dw),
+                                   gc.data<scalar_t>(), input_.data<scalar_t>(),
+                                   data_or_null<scalar_t>(weight_), rstd_.data<stat_t>(),
+                                   rows, cols);
+    });
+    return {needs_grad(0) ? dx : Tensor(), dw};
+}
+
+void RMSNormBackward::release_saved_impl() {
+    input_  = Tensor();
+    weight_ = Tensor();
+    rstd_   = Tensor();
+}
+
+LinearBackward::LinearBackward(const Tensor& input, const Tensor& weight, const Tensor& bias,
+                               const Tensor& x, const Tensor& w, const Tensor& saved,
+                               kernels::Activation act)
+    : GradFn({input.gradient_edge(), weight.gradient_edge(), bias.gradient_edge()}),
+      input_shape_(input.shape()), input_dtype_(input.dtype()), weight_dtype_(weight.dtype()),
+      bias_dtype_(bias.defined() ? bias.dtype() : x.dtype()), compute_dtype_(x.dtype()),
+      in_features_(w.shape()[1]), out_features_(w.shape()[0]),
+      x_(needs_grad(1) ? save(x) : Tensor()),
+      w_(needs_grad(0) ? save(w) : Tensor()),
+      saved_(save(saved)), act_(act) {}
+
+std::vector<Tensor> LinearBackward::apply(const Tensor& g) {
+    check_not_released();
+    const Tensor gc = dense_grad(g, compute_dtype_);
+    const std::size_t N = out_features_, K = in_features_;
+    const std::size_t M = N ? gc.numel() / N : 0;
+    std::vector<Tensor> out(3);
+    // Sans activation, dZ est le gradient de sortie lui-même
+    const bool act = act_ != kernels::Activation::None;
+    Tensor dz = act ? Tensor(gc.shape(), compute_dtype_, gc.device()) : gc;
+    Tensor db = grad_buffer(needs_grad(2), {N}, gc);
+
+    auto run = [&](auto tag) {
+        using T   = decltype(tag);
+        using Ref = kernels::matrix_ref_t<T>;
+        if (act || db.defined())
+            kernels::activation_backward_bias(act_, act ? dz.data<T>() : nullptr,
+                                              data_or_null<T>(db), gc.data<T>(),
+                                              data_or_null<T>(saved_), M, N);
+        const T* dzp = dz.data<T>();
+        if (needs_grad(0)) {
+            // dX[M, K] = dZ[M, N] · W[N, K]
+            Tensor dx({M, K}, compute_dtype_, gc.device());
+            kernels::gemm(M, K, N, Ref{dzp, std::ptrdiff_t(N), 1},
+                          Ref{w_.data<T>(), w_.strides()[0], w_.strides()[1]},
+                          dx.data<T>(), std::ptrdiff_t(K));
+            dx = dx.reshape(input_shape_);
+            out[0] = dx.dtype() == input_dtype_ ? dx : dx.astype(input_dtype_);
+        }
+        if (needs_grad(1)) {
+            // dW[N, K] = dZᵀ[N, M] · X[M, K]
+            Tensor dw({N, K}, compute_dtype_, gc.device());
+            kernels::gemm(N, K, M, Ref{dzp, 1, std::ptrdiff_t(N)},
+                          Ref{x_.data<T>(), x_.strides()[0], x_.strides()[1]},
+                          dw.data<T>(), std::ptrdiff_t(K));
+            out[1] = dw.dtype() == weight_dtype_ ? dw : dw.astype(weight_dtype_);
+        }
+    };
+    if (compute_dtype_ == DType::Float64) run(double());
+    else                                  run(float());
+    if (db.defined())
+        out[2] = db.dtype() == bias_dtype_ ? db : db.astype(bias_dtype_);
+    return out;
+}
+
+void LinearBackward::release_saved_impl() {
+    x_     = Tensor();
+    w_     = Tensor();
+    saved_ = Tensor();
+}
+
+namespace {
+    // NHWC dense -> forme logique [N, C, H, W] : vue channels-last ou copie
+    // contiguë selon le format de l'entrée
+    Tensor nchw_grad(const Tensor& nhwc, bool channels_last, DType dtype) {
+        const Tensor t = (nhwc.dtype() == dtype ? nhwc : nhwc.astype(dtype)).permute({0, 3, 1, 2});
+        return channels_last ? t : t.contiguous();
+    }
+}
+
+Conv2dBackward::Conv2dBackward(const Tensor& input, const Tensor& weight, const Tensor& bias,
+                               const Tensor& x, const Tensor& w,
+                               const kernels::Conv2dShape& shape, bool channels_last)
+    : GradFn({input.gradient_edge(), weight.gradient_edge(), bias.gradient_edge()}),
+      shape_(shape), input_dtype_(input.dtype()), weight_dtype_(weight.dtype()),
+      bias_dtype_(bias.defined() ? bias.dtype() : x.dtype()), compute_dtype_(x.dtype()),
+      channels_last_(channels_last),
+      x_(needs_grad(1) ? save(x) : Tensor()),
+      w_(needs_grad(0) ? save(w) : Tensor()) {}
+
+std::vector<Tensor> Conv2dBackward::apply(const Tensor& g) {
+    check_not_released();
+    const kernels::Conv2dShape& p = shape_;
+    // dY en NHWC dense : aucune copie si la sortie était channels-last
+    const Tensor gc = dense_grad(g.permute({0, 2, 3, 1}), compute_dtype_);
+    std::vector<Tensor> out(3);
+    Tensor dx = grad_buffer(needs_grad(0), {p.N, p.H, p.W, p.C}, gc);
+    Tensor dw = grad_buffer(needs_grad(1), {p.K, p.R, p.S, p.group_in()}, gc);
+    Tensor db = grad_buffer(needs_grad(2), {p.K}, gc);
+
+    auto run = [&](auto tag) {
+        using T = decltype(tag);
+        if (dx.defined())
+            kernels::conv2d_backward_input(p, gc.data<T>(), w_.data<T>(), dx.data<T>());
+        if (dw.defined() || db.defined())
+            kernels::conv2d_backward_weight(p, gc.data<T>(), data_or_null<T>(x_),
+                                            data_or_null<T>(dw), data_or_null<T>(db));
+    };
+    if (compute_dtype_ == DType::Float64) run(double());
+    else                                  run(float());
+    if (dx.defined()) out[0] = nchw_grad(dx, channels_last_, input_dtype_);
+    // KRSC -> [K, C/groups, R, S]
+    if (dw.defined()) out[1] = nchw_grad(dw, false, weight_dtype_);
+    if (db.defined())
+        out[2] = db.dtype() == bias_dtype_ ? db : db.astype(bias_dtype_);
+    return out;
+}
+
+void Conv2dBackward::release_saved_impl() {
+    x_ = Tensor();
+    w_ = Tensor();
+}
+
+Pool2dBackward::Pool2dBackward(const Tensor& input, const kernels::Pool2dShape& shape,
+                               DType compute_dtype, bool channels_last,
+                               const Tensor& indices, bool count_include_pad)
+    : GradFn({input.gradient_edge()}), shape_(shape), input_dtype_(input.dtype()),
+      compute_dtype_(compute_dtype), channels_last_(channels_last),
+      is_max_(indices.defined()), count_include_pad_(count_include_pad),
+      indices_(save(indices)) {}
+
+std::vector<Tensor> Pool2dBackward::apply(const Tensor& g) {
+    check_not_released();
+    const kernels::Pool2dShape& p = shape_;
+    const Tensor gc = dense_grad(g.permute({0, 2, 3, 1}), compute_dtype_);
+    Tensor dx({p.N, p.H, p.W, p.C}, compute_dtype_, gc.device());
+    auto run = [&](auto tag) {
+        using T = decltype(tag);
+        if (is_max_)
+            kernels::max_pool2d_backward(p, gc.data<T>(), indices_.data<std::int64_t>(),
+                                         dx.data<T>());
+        else
+            kernels::avg_pool2d_backward(p, count_include_pad_, gc.data<T>(), dx.data<T>());
+    };
+    if (compute_dtype_ == DType::Float64) run(double());
+    else                                  run(float());
+    return {nchw_grad(dx, channels_last_, input_dtype_)};
+}
+
+void Pool2dBackward::release_saved_impl() {
+    indices_ = Tensor();
+}
+
+// ===================== Réductions =====================
+
+ReduceBackward::ReduceBackward(const Tensor& input, std::vector<bool> axes)
+    : GradFn({input.gradient_edge()}), input_shape_(input.shape()),
+      axes_(std::move(axes)), input_dtype_(input.dtype()) {}
+
+Tensor ReduceBackward::keepdim_grad(const Tensor& g) const {
+    Shape shape = input_shape_;
+    for (std::size_t d = 0; d < shape.size(); ++d)
+        if (axes_[d]) shape[d] = 1;
+    return g.reshape(shape);
+}
+
+std::size_t ReduceBackward::reduced_numel() const {
+    std::size_t n = 1;
+    for (std::size_t d = 0; d < input_shape_.size(); ++d)
+        if (axes_[d]) n *= input_shape_[d];
+    return n;
+}
+
+namespace {
+    std::vector<int> axes_to_dims(const std::vector<bool>& axes) {
+        std::vector<int> dims;
+        for (std::size_t d = 0; d < axes.size(); ++d)
+            if (axes[d]) dims.push_back(int(d));
+        return dims;
+    }
+}
+
+std::vector<Tensor> SumBackward::apply(const Tensor& g) {
+    return {keepdim_grad(g).expand(input_shape_)};
+}
+
+std::vector<Tensor> MeanBackward::apply(const Tensor& g) {
+    const Tensor gk = keepdim_grad(g);
+    return {(gk * scalar_like(1.0 / double(reduced_numel()), gk)).expand(input_shape_)};
+}
+
+MaxMinBackward::MaxMinBackward(const Tensor& input, std::vector<bool> axes,
+                               Tensor indices, bool is_max)
+    : ReduceBackward(input, std::move(axes)), indices_(std::move(indices)), is_max_(is_max) {}
+
+std::vector<Tensor> MaxMinBackward::apply(const Tensor& g) {
+    check_not_released();
+    Tensor out = Tensor::zeros(input_shape_, g.dtype(), g.device());
+    const Tensor gc = g.contiguous();
+    NAPCAS_DISPATCH_ALL_TYPES(g.dtype(), name(), [&] {
+        kernels::scatter_reduced(out.data<scalar_t>(), gc.data<scalar_t>(),
+                                 indices_.data<std::int64_t>(), input_shape_, axes_);
+    });
+    return {out};
+}
+
+void MaxMinBackward::release_saved_impl() {
+    indices_ = Tensor();
+}
+
+VarBackward::VarBackward(const Tensor& input, std::vector<bool> axes,
+                         std::size_t correction, const Tensor& std_result)
+    : ReduceBackward(input, std::move(axes)), input_(save(input)),
+      std_(save(std_result)),
+      correction_(correction), is_std_(std_result.defined()) {}
+
+std::vector<Tensor> VarBackward::apply(const Tensor& g) {
+    check_not_released();
+    const Tensor diff = input_ - input_.mean(axes_to_dims(axes_), true);
+    const double dof = double(reduced_numel()) - double(correction_);
+    const Tensor gk = keepdim_grad(g);
+    if (is_std_)
+        return {diff * (gk * scalar_like(1.0 / dof, gk) / keepdim_grad(std_))};
+    return {diff * (gk * scalar_like(2.0 / dof, gk))};
+}
+
+void VarBackward::release_saved_impl() {
+    input_ = Tensor();
+    std_   = Tensor();
+}
+
+LogSumExpBackward::LogSumExpBackward(const Tensor& input, std::vector<bool> axes,
+                                     const Tensor& result)
+    : ReduceBackward(input, std::move(axes)), input_(save(input)),
+      result_(save(result)) {}
+
+std::vector<Tensor> LogSumExpBackward::apply(const Tensor& g) {
+    check_not_released();
+    return {keepdim_grad(g) * (input_ - keepdim_grad(result_)).exp()};
+}
+
+void LogSumExpBackward::release_saved_impl() {
+    input_  = Tensor();
+    result_ = Tensor();
+}
+
+} // namespace napcas
@@ -0,0 +1,371 @@
+// cpp/src/graph.cpp
+
+#include "napcas/graph.h"
+#include "napcas/allocator.h"
+#include "napcas/module.h"
+#include "napcas/profiler.h"
+#include "napcas/kernels/copy.h"
+#include <algorithm>
+#include <map>
+#include <stdexcept>
+#include <unordered_map>
+
+namespace napcas {
+
+namespace {
+    // Valeur du graphe : entrée statique ou résultat d'une opération
+    struct Root {
+        enum class Kind { Input, Intermediate };
+        Kind kind;
+        std::shared_ptr<Storage> storage;   // bloc observé à la capture
+        std::size_t first = 0;              // opération qui la produit
+        std::size_t last  = 0;              // dernier lecteur
+        std::size_t offset = 0;             // dans l'arène, en octets
+    };
+
+    // Argument d'une opération : vue d'une valeur, constante ou absent
+    struct Ref {
+        int root = -1;
+        Tensor constant;                    // root < 0 : constante ou non défini
+        Shape   shape;
+        Strides strides;
+        DType       dtype = DType::Float32;
+        std::size_t offset = 0;             // dans le bloc, en éléments
+    };
+
+    struct Node {
+        std::string      name;
+        std::vector<Ref> inputs;
+        Ref              output;
+        graph::Kernel    kernel;
+    };
+
+    struct Recorder {
+        std::uint64_t start_serial;
+        std::unordered_map<const Storage*, int> roots_by_storage;
+        std::vector<Root> roots;
+        std::vector<Node> nodes;
+
+        int add_root(Root::Kind kind, const Tensor& t) {
+            Root r;
+            r.kind    = kind;
+            r.storage = t.storage();
+            r.first   = nodes.size();
+            r.last    = nodes.size();
+            roots.push_back(std::move(r));
+            roots_by_storage[t.storage().get()] = int(roots.size() - 1);
+            return int(roots.size() - 1);
+        }
+
+        // Un bloc inconnu antérieur à la capture est une constante ; créé
+        // pendant la capture, il vient d'une opération non enregistrée
+        Ref make_ref(const Tensor& t, const char* what) const {
+            Ref ref;
+            if (!t.defined()) return ref;
+            auto it = roots_by_storage.find(t.storage().get());
+            if (it == roots_by_storage.end()) {
+                if (t.storage()->serial() >= start_serial)
+                    throw std::runtime_error(std::string("Graph::capture: ") + what +
+                                             " was produced by an operation that cannot be "
+                                             "captured (create constants before the capture)");
+                ref.constant = t.detach();
+                return ref;
+            }
+            ref.root    = it->second;
+            ref.shape   = t.shape();
+            ref.strides = t.strides();
+            ref.dtype   = t.dtype();
+            ref.offset  = t.storage_offset();
+            return ref;
+        }
+    };
+
+    thread_local Recorder* t_recorder = nullptr;
+    thread_local int       t_depth    = 0;
+
+    // Installe l'enregistreur du thread le temps de la capture
+    struct RecorderGuard {
+        explicit RecorderGuard(Recorder& r) { t_recorder = &r; t_depth = 0; }
+        ~RecorderGuard() { t_recorder = nullptr; t_depth = 0; }
+    };
+
+    constexpr std::size_t align_up(std::size_t n) {
+        return (n + kCpuAlignment - 1) / kCpuAlignment * kCpuAlignment;
+    }
+
+    // Zones libres de l'arène (offset -> taille) : meilleur ajustement,
+    // fusion des voisines à la libération, extension par le haut sinon
+    class ArenaPlanner {
+    public:
+        std::size_t allocate(std::size_t nbytes) {
+            const std::size_t size = align_up(std::max<std::size_t>(nbytes, 1));
+            auto best = free_.end();
+            for (auto it = free_.begin(); it != free_.end(); ++it)
+                if (it->second >= size && (best == free_.end() || it->second < best->second))
+                    best = it;
+            if (best != free_.end()) {
+                const std::size_t off = best->first, rest = best->second - size;
+                free_.erase(best);
+                if (rest) free_[off + size] = rest;
+                return off;
+            }
+            // Une zone libre au sommet est étendue plutôt que laissée vide
+            if (!free_.empty()) {
+                auto last = std::prev(free_.end());
+                if (last->first + last->second == top_) {
+                    const std::size_t off = last->first;
+                    free_.erase(last);
+                    top_ = off + size;
+                    return off;
+                }
+            }
+            const std::size_t off = top_;
+            top_ += size;
+            return off;
+        }
+
+        void release(std::size_t offset, std::size_t nbytes) {
+            std::size_t size = align_up(std::max<std::size_t>(nbytes, 1));
+            auto next = free_.lower_bound(offset);
+            if (next != free_.end() && offset + size == next->first) {
+                size += next->second;
+                next = free_.erase(next);
+            }
+            if (next != free_.begin()) {
+                auto prev = std::prev(next);
+                if (prev->first + prev->second == offset) {
+                    prev->second += size;
+                    return;
+                }
+            }
+            free_[offset] = size;
+        }
+
+        std::size_t size() const noexcept { return top_; }
+
+    private:
+        std::map<std::size_t, std::size_t> free_;
+        std::size_t top_ = 0;
+    };
+}
+
+// ===================== Enregistrement =====================
+
+namespace graph {
+
+CaptureScope::CaptureScope() noexcept
+    : capturing_(t_recorder != nullptr),
+      active_(capturing_ && t_depth == 0) {
+    if (capturing_) ++t_depth;
+}
+
+CaptureScope::~CaptureScope() {
+    if (capturing_) --t_depth;
+}
+
+bool capturing() noexcept { return t_recorder != nullptr; }
+
+void record(const char* name, const std::vector<Tensor>& inputs, const Tensor& output,
+            Kernel kernel) {
+    Recorder* rec = t_recorder;
+    if (!rec)
+        throw std::runtime_error("graph::record: no capture in progress");
+    if (!output.defined())
+        throw std::runtime_error(std::string("graph::record: ") + name + " has no output");
+    Node node;
+    node.name   = name;
+    node.kernel = std::move(kernel);
+    for (const Tensor& t : inputs)
+        node.inputs.push_back(rec->make_ref(t, "an input"));
+
+    // Bloc neuf : nouvelle valeur ; sinon écriture en place
+    if (!rec->roots_by_storage.count(output.storage().get()) &&
+        output.storage()->serial() >= rec->start_serial)
+        rec->add_root(Root::Kind::Intermediate, output);
+    node.output = rec->make_ref(output, "the output");
+    rec->nodes.push_back(std::move(node));
+}
+
+Kernel eager_kernel(std::function<Tensor(const std::vector<Tensor>&)> op) {
+    return [op = std::move(op)](const std::vector<Tensor>& inputs, Tensor& output) {
+        const Tensor r = op(inputs);
+        kernels::strided_copy(output.data_ptr(), r.data_ptr(), r.shape(), r.strides(),
+                              dtype_size(r.dtype()));
+    };
+}
+
+} // namespace graph
+
+// ===================== Plan et rejeu =====================
+
+struct Graph::Impl {
+    struct Step {
+        graph::Kernel       kernel;
+        std::vector<Tensor> inputs;
+        Tensor              output;
+    };
+
+    std::vector<std::string> names;
+    std::vector<Step>        steps;
+    std::vector<Tensor>      inputs;
+    std::vector<Tensor>      outputs;
+    std::shared_ptr<Storage> arena;
+    std::size_t arena_bytes    = 0;
+    std::size_t unpooled_bytes = 0;
+};
+
+Graph::Graph(std::unique_ptr<Impl> impl) : impl_(std::move(impl)) {}
+Graph::Graph(Graph&&) noexcept            = default;
+Graph& Graph::operator=(Graph&&) noexcept = default;
+Graph::~Graph()                           = default;
+
+Graph Graph::capture(const Function& fn, const std::vector<Tensor>& example_inputs) {
+    if (t_recorder)
+        throw std::runtime_error("Graph::capture: a capture is already in progress");
+    auto impl = std::make_unique<Impl>();
+    Recorder rec;
+    rec.start_serial = Storage::current_serial();
+    for (const Tensor& e : example_inputs) {
+        if (!e.defined())
+            throw std::runtime_error("Graph::capture: undefined example input");
+        impl->inputs.push_back(e.detach().clone());
+        rec.add_root(Root::Kind::Input, impl->inputs.back());
+    }
+
+    std::vector<Tensor> results;
+    {
+        RecorderGuard guard(rec);
+        results = fn(impl->inputs);
+    }
+    std::vector<Ref> outputs;
+    for (const Tensor& t : results) {
+        if (!t.defined())
+            throw std::runtime_error("Graph::capture: undefined output");
+        outputs.push_back(rec.make_ref(t, "an output"));
+    }
+
+    // Opérations mortes, dont le résultat n'est jamais lu (ex. indices
+    // calculés pour l'autograd pendant la capture) : retirées du plan
+    const std::size_t n = rec.nodes.size();
+    std::vector<bool> needed(rec.roots.size(), false), alive(n, false);
+    for (const Ref& r : outputs)
+        if (r.root >= 0) needed[r.root] = true;
+    for (std::size_t i = n; i-- > 0;) {
+        const Ref& out = rec.nodes[i].output;
+        alive[i] = out.root < 0 || rec.roots[out.root].kind == Root::Kind::Input ||
+                   needed[out.root];
+        if (!alive[i]) continue;
+        for (const Ref& r : rec.nodes[i].inputs)
+            if (r.root >= 0) needed[r.root] = true;
+    }
+
+    // Durées de vie : de l'opération productrice au dernier lecteur ; les
+    // sorties vivent jusqu'à la fin
+    auto touch = [&](const Ref& r, std::size_t i) {
+        if (r.root >= 0) rec.roots[r.root].last = std::max(rec.roots[r.root].last, i);
+    };
+    for (std::size_t i = 0; i < n; ++i) {
+        if (!alive[i]) continue;
+        for (const Ref& r : rec.nodes[i].inputs) touch(r, i);
+        touch(rec.nodes[i].output, i);
+    }
+    for (const Ref& r : outputs) touch(r, n);
+
+    // Affectation des zones : la sortie d'une opération est placée avant de
+    // libérer ses entrées mortes, elle ne recouvre donc jamais ses entrées
+    std::vector<std::vector<int>> dying(n + 1);
+    std::vector<std::vector<int>> born(n);
+    for (std::size_t r = 0; r < rec.roots.size(); ++r) {
+        const Root& root = rec.roots[r];
+        if (root.kind != Root::Kind::Intermediate || !alive[root.first]) continue;
+        born[root.first].push_back(int(r));
+        dying[root.last].push_back(int(r));
+        impl->unpooled_bytes += align_up(root.storage->nbytes());
+    }
+    ArenaPlanner planner;
+    for (std::size_t i = 0; i < n; ++i) {
+        for (int r : born[i])
+            rec.roots[r].offset = planner.allocate(rec.roots[r].storage->nbytes());
+        for (int r : dying[i])
+            planner.release(rec.roots[r].offset, rec.roots[r].storage->nbytes());
+    }
+    impl->arena_bytes = planner.size();
+    if (impl->arena_bytes)
+        impl->arena = Storage::allocate(impl->arena_bytes, impl->inputs.empty()
+                                                               ? Device{DeviceType::CPU, 0}
+                                                               : impl->inputs[0].device());
+
+    // Vues figées sur les buffers définitifs
+    auto materialize = [&](const Ref& ref) {
+        if (ref.root < 0) return ref.constant;
+        const Root& root = rec.roots[ref.root];
+        if (root.kind == Root::Kind::Input)
+            return Tensor::from_storage(root.storage, ref.shape, ref.strides, ref.dtype,
+                                        ref.offset);
+        return Tensor::from_storage(impl->arena, ref.shape, ref.strides, ref.dtype,
+                                    root.offset / dtype_size(ref.dtype) + ref.offset);
+    };
+    for (std::size_t i = 0; i < n; ++i) {
+        if (!alive[i]) continue;
+        Node& node = rec.nodes[i];
+        Impl::Step step;
+        step.kernel = std::move(node.kernel);
+        for (const Ref& r : node.inputs) step.inputs.push_back(materialize(r));
+        step.output = materialize(node.output);
+        impl->steps.push_back(std::move(step));
+        impl->names.push_back(std::move(node.name));
+    }
+    for (const Ref& r : outputs) impl->outputs.push_back(materialize(r));
+    return Graph(std::move(impl));
+}
+
+Graph Graph::capture(Module& module, const Tensor& example_input) {
+    return capture([&module](const std::vector<Tensor>& in) {
+        return std::vector<Tensor>{module.forward(in[0])};
+    }, {example_input});
+}
+
+const std::vector<Tensor>& Graph::replay(const std::vector<Tensor>& inputs) {
+    if (inputs.size() != impl_->inputs.size())
+        throw std::runtime_error("Graph::replay: expected " +
+                                 std::to_string(impl_->inputs.size()) + " inputs");
+    for (std::size_t i = 0; i < inputs.size(); ++i) {
+        const Tensor& src = inputs[i];
+        Tensor& dst = impl_->inputs[i];
+        if (src.shape() != dst.shape() || src.dtype() != dst.dtype())
+            throw std::runtime_error("Graph::replay: input " + std::to_string(i) +
+                                     " does not match the captured shape and dtype");
+        if (src.data_ptr() == dst.data_ptr()) continue;
+        kernels::strided_copy(dst.data_ptr(), src.data_ptr(), src.shape(), src.strides(),
+                              dtype_size(src.dtype()));
+    }
+    return replay();
+}
+
+const std::vector<Tensor>& Graph::replay() {
+    // Les résultats d'un rejeu seraient pris pour des constantes
+    if (t_recorder)
+        throw std::runtime_error("Graph::replay: cannot replay during a capture");
+    if (!profiler::enabled()) {
+        for (Impl::Step& s : impl_->steps)
+            s.kernel(s.inputs, s.output);
+        return impl_->outputs;
+    }
+    for (std::size_t i = 0; i < impl_->steps.size(); ++i) {
+        Impl::Step& s = impl_->steps[i];
+        profiler::RecordScope prof(impl_->names[i].c_str());
+        s.kernel(s.inputs, s.output);
+        prof.record_io(s.inputs, s.output);
+    }
+    return impl_->outputs;
+}
+
+const std::vector<Tensor>& Graph::inputs()  const noexcept { return impl_->inputs; }
+const std::vector<Tensor>& Graph::outputs() const noexcept { return impl_->outputs; }
+
+std::vector<std::string> Graph::ops() const { return impl_->names; }
+std::size_t Graph::num_ops()        const noexcept { return impl_->steps.size(); }
+std::size_t Graph::arena_bytes()    const noexcept { return impl_->arena_bytes; }
+std::size_t Graph::unpooled_bytes() const noexcept { return impl_->unpooled_bytes; }
+
+} // namespace napcas
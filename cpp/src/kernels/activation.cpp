@@ -0,0 +1,143 @@
+// cpp/src/kernels/activation.cpp
+
+#include "napcas/kernels/activation.h"
+#include "napcas/dispatch.h"
+#include "napcas/parallel.h"
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+
+namespace napcas {
+namespace kernels {
+
+namespace {
+    // Sommes de biais : au plus kMaxRowChunks blocs de lignes
+    constexpr std::size_t kMaxRowChunks = 64;
+    constexpr std::size_t kMinChunkRows = 16;
+
+    // g · f'(s), `s` étant la sortie pour ReLU (seul son signe compte),
+    // l'entrée pour GELU et SiLU
+    template<typename C>
+    inline C activation_grad(Activation act, C g, C s) {
+        switch (act) {
+            case Activation::ReLU: return s > C(0) ? g : C(0);
+            case Activation::GELU: {
+                // d/dx x·Φ(x) = Φ(x) + x·φ(x)
+                const C cdf = C(0.5) * (C(1) + std::erf(s * C(0.70710678118654752440)));
+                const C pdf = std::exp(C(-0.5) * s * s) * C(0.39894228040143267794);
+                return g * (cdf + s * pdf);
+            }
+            case Activation::SiLU: {
+                // d/dx x·σ(x) = σ(x)·(1 + x·(1 - σ(x)))
+                const C sig = C(1) / (C(1) + std::exp(-s));
+                return g * sig * (C(1) + s * (C(1) - sig));
+            }
+            case Activation::None: break;
+        }
+        return g;
+    }
+
+    template<typename T, typename F>
+    void map(T* out, const T* in, std::size_t n, F f) {
+        using C = compute_type_t<T>;
+        parallel_for(0, n, grain_size(n, 8 * sizeof(T)), [&](std::size_t b, std::size_t e) {
+            for (std::size_t i = b; i < e; ++i) out[i] = T(f(C(in[i])));
+        });
+    }
+
+    template<typename T, typename F>
+    void map2(T* out, const T* a, const T* x, std::size_t n, F f) {
+        using C = compute_type_t<T>;
+        parallel_for(0, n, grain_size(n, 8 * sizeof(T)), [&](std::size_t b, std::size_t e) {
+            for (std::size_t i = b; i < e; ++i) out[i] = T(f(C(a[i]), C(x[i])));
+        });
+    }
+}
+
+template<typename T>
+void activation(Activation act, T* out, const T* in, std::size_t n) {
+    using C = compute_type_t<T>;
+    // Une lambda par cas : la boucle interne ne teste pas `act`
+    switch (act) {
+        case Activation::ReLU: return map(out, in, n, [](C x) { return apply_activation(Activation::ReLU, x); });
+        case Activation::GELU: return map(out, in, n, [](C x) { return apply_activation(Activation::GELU, x); });
+        case Activation::SiLU: return map(out, in, n, [](C x) { return apply_activation(Activation::SiLU, x); });
+        case Activation::None: return map(out, in, n, [](C x) { return x; });
+    }
+    throw std::runtime_error("activation: unknown activation");
+}
+
+template<typename T>
+void activation_backward(Activation act, T* grad_in, const T* grad_out,
+                         const T* saved, std::size_t n) {
+    using C = compute_type_t<T>;
+    switch (act) {
+        case Activation::ReLU:
+            return map2(grad_in, grad_out, saved, n, [](C g, C y) { return activation_grad(Activation::ReLU, g, y); });
+        case Activation::GELU:
+            return map2(grad_in, grad_out, saved, n, [](C g, C x) { return activation_grad(Activation::GELU, g, x); });
+        case Activation::SiLU:
+            return map2(grad_in, grad_out, saved, n, [](C g, C x) { return activation_grad(Activation::SiLU, g, x); });
+        case Activation::None:
+            return map2(grad_in, grad_out, saved, n, [](C g, C) { return g; });
+    }
+    throw std::runtime_error("activation_backward: unknown activation");
+}
+
+template<typename T>
+void activation_backward_bias(Activation act, T* grad_in, T* grad_bias, const T* grad_out,
+                              const T* saved, std::size_t rows, std::size_t cols) {
+    using C = compute_type_t<T>;
+    if (act == Activation::None && grad_in == nullptr && grad_bias == nullptr) return;
+    const std::size_t chunk_rows = std::max(kMinChunkRows, (rows + kMaxRowChunks - 1) / kMaxRowChunks);
+    const std::size_t chunks = rows == 0 ? 0 : (rows + chunk_rows - 1) / chunk_rows;
+    std::vector<C> part(grad_bias ? chunks * cols : 0, C(0));
+
+    auto run = [&](auto df) {
+        parallel_for(0, chunks, 1, [&](std::size_t cb, std::size_t ce) {
+            for (std::size_t c = cb; c < ce; ++c) {
+                C* db = grad_bias ? part.data() + c * cols : nullptr;
+                for (std::size_t r = c * chunk_rows; r < std::min(rows, (c + 1) * chunk_rows); ++r) {
+                    const T* g = grad_out + r * cols;
+                    const T* s = saved ? saved + r * cols : nullptr;
+                    T*       d = grad_in ? grad_in + r * cols : nullptr;
+                    for (std::size_t j = 0; j < cols; ++j) {
+                        const C v = df(C(g[j]), s ? C(s[j]) : C(0));
+                        if (d)  d[j] = T(v);
+                        if (db) db[j] += v;
+                    }
+                }
+            }
+        });
+    };
+    switch (act) {
+        case Activation::ReLU: run([](C g, C y) { return activation_grad(Activation::ReLU, g, y); }); break;
+        case Activation::GELU: run([](C g, C x) { return activation_grad(Activation::GELU, g, x); }); break;
+        case Activation::SiLU: run([](C g, C x) { return activation_grad(Activation::SiLU, g, x); }); break;
+        case Activation::None: run([](C g, C)   { return g; }); break;
+    }
+    if (!grad_bias) return;
+    for (std::size_t j = 0; j < cols; ++j) {
+        C acc = C(0);
+        for (std::size_t c = 0; c < chunks; ++c) acc += part[c * cols + j];
+        grad_bias[j] = T(acc);
+    }
+}
+
+#define NAPCAS_INSTANTIATE_ACTIVATION(T)                                        \
+    template void activation<T>(Activation, T*, const T*, std::size_t);        \
+    template void activation_backward<T>(Activation, T*, const T*, const T*,   \
+                                         std::size_t);                         \
+    template void activation_backward_bias<T>(Activation, T*, T*, const T*,    \
+                                              const T*, std::size_t,           \
+                                              std::size_t);
+
+NAPCAS_INSTANTIATE_ACTIVATION(float)
+NAPCAS_INSTANTIATE_ACTIVATION(double)
+NAPCAS_INSTANTIATE_ACTIVATION(Half)
+NAPCAS_INSTANTIATE_ACTIVATION(BFloat16)
+
+#undef NAPCAS_INSTANTIATE_ACTIVATION
+
+} // namespace kernels
+} // namespace napcas
@@ -0,0 +1,655 @@
+// cpp/src/kernels/conv.cpp
+
+#include "napcas/kernels/conv.h"
+#include "napcas/allocator.h"
+#include "napcas/kernels/gemm.h"
+#include "napcas/parallel.h"
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+namespace napcas {
+namespace kernels {
+
+namespace {
+    // Taille visée des tampons de travail (im2col, transformées de
+    // Winograd) d'un lot d'images : assez pour des GEMM bien remplis, sans
+    // matérialiser tout le batch
+    constexpr std::size_t kWorkspaceBytes = std::size_t(16) << 20;
+    // Winograd : en deçà, les transformées coûtent plus que le gain du GEMM
+    constexpr std::size_t kWinogradMinChannels = 16;
+    // ... et les 16 GEMM [tuiles, C] x [C, K] sont trop étroits (mesuré :
+    // perdant sous 32 tuiles, ou sous max(C, K) / 6 tuiles, ex. 7x7 x 512)
+    constexpr std::size_t kWinogradMinTiles = 32;
+    constexpr std::size_t kWinogradChannelsPerTile = 6;
+    // Canaux traités par bloc dans les transformées de Winograd
+    constexpr std::size_t kWinogradBlock = 64;
+    // Sommes partielles des gradients de poids : au plus kMaxRowChunks blocs
+    constexpr std::size_t kMaxRowChunks = 64;
+
+    template<typename T>
+    using Ref = matrix_ref_t<T>;
+
+    // Tampon de travail pris à l'allocateur (cache : pas de nouvelles
+    // pages à chaque appel, contrairement à new[] au-delà du seuil mmap)
+    template<typename T>
+    struct Workspace {
+        T* data;
+        explicit Workspace(std::size_t n) : data(static_cast<T*>(cpu_malloc(n * sizeof(T)))) {}
+        ~Workspace() { cpu_free(data); }
+        Workspace(const Workspace&) = delete;
+        Workspace& operator=(const Workspace&) = delete;
+        T* get() const noexcept { return data; }
+    };
+
+    std::size_t images_per_chunk(std::size_t n, std::size_t bytes_per_image) {
+        return std::max<std::size_t>(1, std::min(n, kWorkspaceBytes / std::max<std::size_t>(1, bytes_per_image)));
+    }
+
+    // 1x1 sans pas ni padding : la matrice des patchs est l'entrée elle-même
+    bool is_pointwise(const Conv2dShape& p) {
+        return p.R == 1 && p.S == 1 && p.stride_h == 1 && p.stride_w == 1 &&
+               p.pad_h == 0 && p.pad_w == 0;
+    }
+
+    // Coordonnée d'entrée o * stride - pad + k * dil (négative dans le padding)
+    std::ptrdiff_t in_pos(std::size_t o, std::size_t k, std::size_t stride, std::size_t pad,
+                          std::size_t dil) {
+        return std::ptrdiff_t(o * stride + k * dil) - std::ptrdiff_t(pad);
+    }
+
+    // Coordonnée de sortie dont le tap k lit l'entrée i, ou -1
+    std::ptrdiff_t out_pos(std::size_t i, std::size_t k, std::size_t stride, std::size_t pad,
+                           std::size_t dil, std::size_t extent) {
+        const std::ptrdiff_t t = std::ptrdiff_t(i + pad) - std::ptrdiff_t(k * dil);
+        if (t < 0 || t % std::ptrdiff_t(stride)) return -1;
+        const std::size_t o = std::size_t(t) / stride;
+        return o < extent ? std::ptrdiff_t(o) : -1;
+    }
+
+    // Patchs du groupe g pour les images [n0, n1) : ligne (n, oh, ow),
+    // colonnes (r, s, c) ; le padding est écrit à zéro
+    template<typename T>
+    void im2col(const Conv2dShape& p, std::size_t g, std::size_t n0, std::size_t n1,
+                const T* x, T* cols) {
+        const std::size_t OH = p.out_h(), OW = p.out_w(), Cg = p.group_in();
+        const std::size_t row_len = p.R * p.S * Cg;
+        const std::size_t rows = (n1 - n0) * OH;
+        parallel_for(0, rows, grain_size(rows, OW * row_len * sizeof(T)), [&](std::size_t b, std::size_t e) {
+            for (std::size_t i = b; i < e; ++i) {
+                const std::size_t n = n0 + i / OH, oh = i % OH;
+                T* dst = cols + i * OW * row_len;
+                for (std::size_t ow = 0; ow < OW; ++ow) {
+                    for (std::size_t r = 0; r < p.R; ++r) {
+                        const std::ptrdiff_t ih = in_pos(oh, r, p.stride_h, p.pad_h, p.dil_h);
+                        for (std::size_t s = 0; s < p.S; ++s, dst += Cg) {
+                            const std::ptrdiff_t iw = in_pos(ow, s, p.stride_w, p.pad_w, p.dil_w);
+                            if (ih < 0 || ih >= std::ptrdiff_t(p.H) || iw < 0 || iw >= std::ptrdiff_t(p.W))
+                                std::fill(dst, dst + Cg, T(0));
+                            else
+                                std::memcpy(dst, x + ((n * p.H + std::size_t(ih)) * p.W + std::size_t(iw)) * p.C + g * Cg,
+                                            Cg * sizeof(T));
+                        }
+                    }
+                }
+            }
+        });
+    }
+
+    // Inverse d'im2col par collecte : chaque pixel d'entrée somme les
+    // colonnes qui le lisent (pas d'écritures concurrentes). Écrit les
+    // canaux du groupe g des images [n0, n1).
+    template<typename T>
+    void col2im(const Conv2dShape& p, std::size_t g, std::size_t n0, std::size_t n1,
+                const T* cols, T* dx) {
+        const std::size_t OH = p.out_h(), OW = p.out_w(), Cg = p.group_in();
+        const std::size_t row_len = p.R * p.S * Cg;
+        const std::size_t rows = (n1 - n0) * p.H;
+        parallel_for(0, rows, grain_size(rows, p.W * row_len * sizeof(T)), [&](std::size_t b, std::size_t e) {
+            for (std::size_t i = b; i < e; ++i) {
+                const std::size_t n = n0 + i / p.H, ih = i % p.H;
+                for (std::size_t iw = 0; iw < p.W; ++iw) {
+                    T* out = dx + ((n * p.H + ih) * p.W + iw) * p.C + g * Cg;
+                    std::fill(out, out + Cg, T(0));
+                    for (std::size_t r = 0; r < p.R; ++r) {
+                        const std::ptrdiff_t oh = out_pos(ih, r, p.stride_h, p.pad_h, p.dil_h, OH);
+                        if (oh < 0) continue;
+                        for (std::size_t s = 0; s < p.S; ++s) {
+                            const std::ptrdiff_t ow = out_pos(iw, s, p.stride_w, p.pad_w, p.dil_w, OW);
+                            if (ow < 0) continue;
+                            const T* src = cols + (((n - n0) * OH + std::size_t(oh)) * OW + std::size_t(ow)) * row_len
+                                                + (r * p.S + s) * Cg;
+                            for (std::size_t c = 0; c < Cg; ++c) out[c] += src[c];
+                        }
+                    }
+                }
+            }
+        });
+    }
+
+    // ----- im2col + GEMM -----
+
+    template<typename T>
+    void conv_im2col(const Conv2dShape& p, const T* x, const T* w, const T* bias, T* y) {
+        const std::size_t OH = p.out_h(), OW = p.out_w();
+        const std::size_t Cg = p.group_in(), Kg = p.group_out(), row_len = p.R * p.S * Cg;
+        GemmEpilogue<T> ep;
+        if (is_pointwise(p)) {
+            const std::size_t M = p.N * p.H * p.W;
+            for (std::size_t g = 0; g < p.groups; ++g) {
+                ep.bias = bias ? bias + g * Kg : nullptr;
+                gemm(M, Kg, Cg, Ref<T>{x + g * Cg, std::ptrdiff_t(p.C), 1},
+                     Ref<T>{w + g * Kg * Cg, 1, std::ptrdiff_t(Cg)},
+                     y + g * Kg, std::ptrdiff_t(p.K), false, ep);
+            }
+            return;
+        }
+        const std::size_t chunk = images_per_chunk(p.N, OH * OW * row_len * sizeof(T));
+        Workspace<T> cols(chunk * OH * OW * row_len);
+        for (std::size_t n0 = 0; n0 < p.N; n0 += chunk) {
+            const std::size_t n1 = std::min(p.N, n0 + chunk);
+            const std::size_t M  = (n1 - n0) * OH * OW;
+            for (std::size_t g = 0; g < p.groups; ++g) {
+                im2col(p, g, n0, n1, x, cols.get());
+                ep.bias = bias ? bias + g * Kg : nullptr;
+                gemm(M, Kg, row_len, Ref<T>{cols.get(), std::ptrdiff_t(row_len), 1},
+                     Ref<T>{w + g * Kg * row_len, 1, std::ptrdiff_t(row_len)},
+                     y + n0 * OH * OW * p.K + g * Kg, std::ptrdiff_t(p.K), false, ep);
+            }
+        }
+    }
+
+    // ----- Depthwise direct -----
+
+    // Poids [C, R, S] (KRSC avec C/groups = 1) transposés en [R, S, C]
+    template<typename T>
+    std::vector<T> depthwise_taps(const Conv2dShape& p, const T* w) {
+        const std::size_t taps = p.R * p.S;
+        std::vector<T> wt(taps * p.C);
+        for (std::size_t c = 0; c < p.C; ++c)
+            for (std::size_t t = 0; t < taps; ++t) wt[t * p.C + c] = w[c * taps + t];
+        return wt;
+    }
+
+    template<typename T>
+    void conv_depthwise(const Conv2dShape& p, const T* x, const T* w, const T* bias, T* y) {
+        const std::size_t OH = p.out_h(), OW = p.out_w(), C = p.C;
+        const std::vector<T> wt = depthwise_taps(p, w);
+        const std::size_t rows = p.N * OH;
+        parallel_for(0, rows, grain_size(rows, OW * p.R * p.S * C * sizeof(T)), [&](std::size_t b, std::size_t e) {
+            for (std::size_t i = b; i < e; ++i) {
+                const std::size_t n = i / OH, oh = i % OH;
+                for (std::size_t ow = 0; ow < OW; ++ow) {
+                    T* out = y + ((n * OH + oh) * OW + ow) * C;
+                    if (bias) std::copy(bias, bias + C, out);
+                    else      std::fill(out, out + C, T(0));
+                    for (std::size_t r = 0; r < p.R; ++r) {
+                        const std::ptrdiff_t ih = in_pos(oh, r, p.stride_h, p.pad_h, p.dil_h);
+                        if (ih < 0 || ih >= std::ptrdiff_t(p.H)) continue;
+                        for (std::size_t s = 0; s < p.S; ++s) {
+                            const std::ptrdiff_t iw = in_pos(ow, s, p.stride_w, p.pad_w, p.dil_w);
+                            if (iw < 0 || iw >= std::ptrdiff_t(p.W)) continue;
+                            const T* in = x + ((n * p.H + std::size_t(ih)) * p.W + std::size_t(iw)) * C;
+                            const T* wp = wt.data() + (r * p.S + s) * C;
+                            for (std::size_t c = 0; c < C; ++c) out[c] += in[c] * wp[c];
+                        }
+                    }
+                }
+            }
+        });
+    }
+
+    template<typename T>
+    void depthwise_backward_input(const Conv2dShape& p, const T* dy, const T* w, T* dx) {
+        const std::size_t OH = p.out_h(), OW = p.out_w(), C = p.C;
+        const std::vector<T> wt = depthwise_taps(p, w);
+        const std::size_t rows = p.N * p.H;
+        parallel_for(0, rows, grain_size(rows, p.W * p.R * p.S * C * sizeof(T)), [&](std::size_t b, std::size_t e) {
+            for (std::size_t i = b; i < e; ++i) {
+                const std::size_t n = i / p.H, ih = i % p.H;
+                for (std::size_t iw = 0; iw < p.W; ++iw) {
+                    T* out = dx + ((n * p.H + ih) * p.W + iw) * C;
+                    std::fill(out, out + C, T(0));
+                    for (std::size_t r = 0; r < p.R; ++r) {
+                        const std::ptrdiff_t oh = out_pos(ih, r, p.stride_h, p.pad_h, p.dil_h, OH);
+                        if (oh < 0) continue;
+                        for (std::size_t s = 0; s < p.S; ++s) {
+                            const std::ptrdiff_t ow = out_pos(iw, s, p.stride_w, p.pad_w, p.dil_w, OW);
+                            if (ow < 0) continue;
+                            const T* g  = dy + ((n * OH + std::size_t(oh)) * OW + std::size_t(ow)) * C;
+                            const T* wp = wt.data() + (r * p.S + s) * C;
+                            for (std::size_t c = 0; c < C; ++c) out[c] += g[c] * wp[c];
+                        }
+                    }
+                }
+            }
+        });
+    }
+
+    // Sommes partielles par blocs de lignes fixés par `rows` seul : le
+    // résultat ne dépend pas du nombre de threads
+    template<typename T, typename F>
+    void sum_row_chunks(std::size_t rows, std::size_t len, T* out, F&& fn) {
+        const std::size_t chunk_rows = std::max<std::size_t>(1, (rows + kMaxRowChunks - 1) / kMaxRowChunks);
+        const std::size_t chunks = rows ? (rows + chunk_rows - 1) / chunk_rows : 0;
+        std::vector<T> part(chunks * len, T(0));
+        parallel_for(0, chunks, 1, [&](std::size_t b, std::size_t e) {
+            for (std::size_t c = b; c < e; ++c)
+                fn(part.data() + c * len, c * chunk_rows, std::min(rows, (c + 1) * chunk_rows));
+        });
+        std::fill(out, out + len, T(0));
+        for (std::size_t c = 0; c < chunks; ++c)
+            for (std::size_t i = 0; i < len; ++i) out[i] += part[c * len + i];
+    }
+
+    template<typename T>
+    void depthwise_backward_weight(const Conv2dShape& p, const T* dy, const T* x, T* dw) {
+        const std::size_t OH = p.out_h(), OW = p.out_w(), C = p.C, taps = p.R * p.S;
+        std::vector<T> acc(taps * C);
+        sum_row_chunks(p.N * OH, taps * C, acc.data(), [&](T* part, std::size_t b, std::size_t e) {
+            for (std::size_t i = b; i < e; ++i) {
+                const std::size_t n = i / OH, oh = i % OH;
+                for (std::size_t ow = 0; ow < OW; ++ow) {
+                    const T* g = dy + ((n * OH + oh) * OW + ow) * C;
+                    for (std::size_t r = 0; r < p.R; ++r) {
+                        const std::ptrdiff_t ih = in_pos(oh, r, p.stride_h, p.pad_h, p.dil_h);
+                        if (ih < 0 || ih >= std::ptrdiff_t(p.H)) continue;
+                        for (std::size_t s = 0; s < p.S; ++s) {
+                            const std::ptrdiff_t iw = in_pos(ow, s, p.stride_w, p.pad_w, p.dil_w);
+                            if (iw < 0 || iw >= std::ptrdiff_t(p.W)) continue;
+                            const T* in = x + ((n * p.H + std::size_t(ih)) * p.W + std::size_t(iw)) * C;
+                            T* a = part + (r * p.S + s) * C;
+                            for (std::size_t c = 0; c < C; ++c) a[c] += g[c] * in[c];
+                        }
+                    }
+                }
+            }
+        });
+        for (std::size_t c = 0; c < C; ++c)
+            for (std::size_t t = 0; t < taps; ++t) dw[c * taps + t] = acc[t * C + c];
+    }
+
+    // ----- Winograd F(2x2, 3x3) -----
+    //
+    // Y = Aᵀ [ (G g Gᵀ) ⊙ (Bᵀ d B) ] A sur des tuiles d'entrée 4x4 de pas 2 ;
+    // la somme sur les canaux d'entrée devient, pour chacune des 16
+    // positions ξ de la tuile transformée, un GEMM [tuiles, C] x [C, K].
+
+    template<typename T>
+    void conv_winograd(const Conv2dShape& p, const T* x, const T* w, const T* bias, T* y) {
+        const std::size_t C = p.C, K = p.K, OH = p.out_h(), OW = p.out_w();
+        const std::size_t TH = (OH + 1) / 2, TW = (OW + 1) / 2, tiles = TH * TW;
+
+        // U[ξ][k][c] = G g Gᵀ, contigu en c comme w : le GEMM lit Uᵀ via ses
+        // strides (comme Wᵀ dans linear). Par blocs de canaux : les 16 plans
+        // de U (et de V), distants d'une puissance de deux, sont écrits par
+        // rafales d'un bloc plutôt qu'élément par élément, ce qui évitait
+        // les conflits de cache.
+        Workspace<T> U(16 * K * C);
+        parallel_for(0, K, grain_size(K, 16 * C * sizeof(T)), [&](std::size_t b, std::size_t e) {
+            T t[4][3][kWinogradBlock], u[16][kWinogradBlock];
+            for (std::size_t k = b; k < e; ++k) {
+                const T* g = w + k * 9 * C;
+                for (std::size_t c0 = 0; c0 < C; c0 += kWinogradBlock) {
+                    const std::size_t cb = std::min(kWinogradBlock, C - c0);
+                    for (std::size_t j = 0; j < 3; ++j) {
+                        const T* g0 = g + j * C + c0;
+                        const T* g1 = g + (3 + j) * C + c0;
+                        const T* g2 = g + (6 + j) * C + c0;
+                        for (std::size_t c = 0; c < cb; ++c) {
+                            t[0][j][c] = g0[c];
+                            t[1][j][c] = T(0.5) * (g0[c] + g1[c] + g2[c]);
+                            t[2][j][c] = T(0.5) * (g0[c] - g1[c] + g2[c]);
+                            t[3][j][c] = g2[c];
+                        }
+                    }
+                    for (std::size_t i = 0; i < 4; ++i) {
+                        for (std::size_t c = 0; c < cb; ++c) {
+                            u[i * 4][c]     = t[i][0][c];
+                            u[i * 4 + 1][c] = T(0.5) * (t[i][0][c] + t[i][1][c] + t[i][2][c]);
+                            u[i * 4 + 2][c] = T(0.5) * (t[i][0][c] - t[i][1][c] + t[i][2][c]);
+                            u[i * 4 + 3][c] = t[i][2][c];
+                        }
+                    }
+                    for (std::size_t xi = 0; xi < 16; ++xi)
+                        std::copy(u[xi], u[xi] + cb, U.get() + xi * K * C + k * C + c0);
+                }
+            }
+        });
+
+        const std::size_t chunk = images_per_chunk(p.N, 16 * tiles * (C + K) * sizeof(T));
+        Workspace<T> V(16 * chunk * tiles * C);
+        Workspace<T> Mt(16 * chunk * tiles * K);
+        const std::vector<T> zeros(C, T(0));
+        for (std::size_t n0 = 0; n0 < p.N; n0 += chunk) {
+            const std::size_t n1 = std::min(p.N, n0 + chunk);
+            const std::size_t P  = (n1 - n0) * tiles;
+
+            // V[ξ][tuile][c] = Bᵀ d B ; le padding lit une ligne de zéros
+            parallel_for(0, P, grain_size(P, 16 * C * sizeof(T)), [&](std::size_t b, std::size_t e) {
+                const T* src[4][4];
+                T t[4][4][kWinogradBlock], v[16][kWinogradBlock];
+                for (std::size_t q = b; q < e; ++q) {
+                    const std::size_t n = n0 + q / tiles, th = (q % tiles) / TW, tw = q % TW;
+                    for (std::size_t i = 0; i < 4; ++i) {
+                        const std::ptrdiff_t ih = std::ptrdiff_t(2 * th + i) - std::ptrdiff_t(p.pad_h);
+                        for (std::size_t j = 0; j < 4; ++j) {
+                            const std::ptrdiff_t iw = std::ptrdiff_t(2 * tw + j) - std::ptrdiff_t(p.pad_w);
+                            const bool inside = ih >= 0 && ih < std::ptrdiff_t(p.H) &&
+                                                iw >= 0 && iw < std::ptrdiff_t(p.W);
+                            src[i][j] = inside ? x + ((n * p.H + std::size_t(ih)) * p.W + std::size_t(iw)) * C
+                                               : zeros.data();
+                        }
+                    }
+                    for (std::size_t c0 = 0; c0 < C; c0 += kWinogradBlock) {
+                        const std::size_t cb = std::min(kWinogradBlock, C - c0);
+                        for (std::size_t j = 0; j < 4; ++j) {
+                            const T* d0 = src[0][j] + c0;
+                            const T* d1 = src[1][j] + c0;
+                            const T* d2 = src[2][j] + c0;
+                            const T* d3 = src[3][j] + c0;
+                            for (std::size_t c = 0; c < cb; ++c) {
+                                t[0][j][c] = d0[c] - d2[c];
+                                t[1][j][c] = d1[c] + d2[c];
+                                t[2][j][c] = d2[c] - d1[c];
+                                t[3][j][c] = d1[c] - d3[c];
+                            }
+                        }
+                        for (std::size_t i = 0; i < 4; ++i) {
+                            for (std::size_t c = 0; c < cb; ++c) {
+                                v[i * 4][c]     = t[i][0][c] - t[i][2][c];
+                                v[i * 4 + 1][c] = t[i][1][c] + t[i][2][c];
+                                v[i * 4 + 2][c] = t[i][2][c] - t[i][1][c];
+                                v[i * 4 + 3][c] = t[i][1][c] - t[i][3][c];
+                            }
+                        }
+                        for (std::size_t xi = 0; xi < 16; ++xi)
+                            std::copy(v[xi], v[xi] + cb, V.get() + (xi * P + q) * C + c0);
+                    }
+                }
+            });
+
+            for (std::size_t xi = 0; xi < 16; ++xi)
+                gemm(P, K, C, Ref<T>{V.get() + xi * P * C, std::ptrdiff_t(C), 1},
+                     Ref<T>{U.get() + xi * K * C, 1, std::ptrdiff_t(C)},
+                     Mt.get() + xi * P * K, std::ptrdiff_t(K));
+
+            // y = Aᵀ m A : tuile de sortie 2x2, tronquée au bord
+            parallel_for(0, P, grain_size(P, 16 * K * sizeof(T)), [&](std::size_t b, std::size_t e) {
+                for (std::size_t q = b; q < e; ++q) {
+                    const std::size_t n = n0 + q / tiles, th = (q % tiles) / TW, tw = q % TW;
+                    const std::size_t rows = std::min<std::size_t>(2, OH - 2 * th);
+                    const std::size_t cols = std::min<std::size_t>(2, OW - 2 * tw);
+                    const T* m = Mt.get() + q * K;
+                    T* out = y + ((n * OH + 2 * th) * OW + 2 * tw) * K;
+                    for (std::size_t k = 0; k < K; ++k) {
+                        T t[2][4];
+                        for (std::size_t j = 0; j < 4; ++j) {
+                            const T m0 = m[j * P * K + k],       m1 = m[(4 + j) * P * K + k];
+                            const T m2 = m[(8 + j) * P * K + k], m3 = m[(12 + j) * P * K + k];
+                            t[0][j] = m0 + m1 + m2;
+                            t[1][j] = m1 - m2 - m3;
+                        }
+                        const T bk = bias ? bias[k] : T(0);
+                        for (std::size_t a = 0; a < rows; ++a) {
+                            T* o = out + a * OW * K + k;
+                            o[0] = t[a][0] + t[a][1] + t[a][2] + bk;
+                            if (cols > 1) o[K] = t[a][1] - t[a][2] - t[a][3] + bk;
+                        }
+                    }
+                }
+            });
+        }
+    }
+}
+
+bool conv_algorithm_supported(ConvAlgorithm algo, const Conv2dShape& p) noexcept {
+    switch (algo) {
+        case ConvAlgorithm::Auto:
+        case ConvAlgorithm::Im2col:
+            return true;
+        case ConvAlgorithm::Depthwise:
+            return p.groups == p.C && p.K == p.C;
+        case ConvAlgorithm::Winograd:
+            return p.R == 3 && p.S == 3 && p.stride_h == 1 && p.stride_w == 1 &&
+                   p.dil_h == 1 && p.dil_w == 1 && p.groups == 1;
+    }
+    return false;
+}
+
+ConvAlgorithm select_conv_algorithm(const Conv2dShape& p) noexcept {
+    if (p.groups > 1 && conv_algorithm_supported(ConvAlgorithm::Depthwise, p))
+        return ConvAlgorithm::Depthwise;
+    if (conv_algorithm_supported(ConvAlgorithm::Winograd, p) &&
+        p.C >= kWinogradMinChannels && p.K >= kWinogradMinChannels) {
+        const std::size_t tiles = p.N * ((p.out_h() + 1) / 2) * ((p.out_w() + 1) / 2);
+        if (tiles >= kWinogradMinTiles &&
+            tiles * kWinogradChannelsPerTile >= std::max(p.C, p.K))
+            return ConvAlgorithm::Winograd;
+    }
+    return ConvAlgorithm::Im2col;
+}
+
+template<typename T>
+void conv2d_forward(const Conv2dShape& p, ConvAlgorithm algo,
+                    const T* x, const T* w, const T* bias, T* y) {
+    if (algo == ConvAlgorithm::Auto) algo = select_conv_algorithm(p);
+    switch (algo) {
+        case ConvAlgorithm::Depthwise: conv_depthwise(p, x, w, bias, y); break;
+        case ConvAlgorithm::Winograd:  conv_winograd(p, x, w, bias, y);  break;
+        default:                       conv_im2col(p, x, w, bias, y);    break;
+    }
+}
+
+template<typename T>
+void conv2d_backward_input(const Conv2dShape& p, const T* dy, const T* w, T* dx) {
+    if (p.groups > 1 && conv_algorithm_supported(ConvAlgorithm::Depthwise, p))
+        return depthwise_backward_input(p, dy, w, dx);
+    const std::size_t OH = p.out_h(), OW = p.out_w();
+    const std::size_t Cg = p.group_in(), Kg = p.group_out(), row_len = p.R * p.S * Cg;
+    if (is_pointwise(p)) {
+        // dX_g [M, Cg] = dY_g [M, Kg] · W_g [Kg, Cg]
+        const std::size_t M = p.N * p.H * p.W;
+        for (std::size_t g = 0; g < p.groups; ++g)
+            gemm(M, Cg, Kg, Ref<T>{dy + g * Kg, std::ptrdiff_t(p.K), 1},
+                 Ref<T>{w + g * Kg * Cg, std::ptrdiff_t(Cg), 1},
+                 dx + g * Cg, std::ptrdiff_t(p.C));
+        return;
+    }
+    // Colonnes dC_g [M, R·S·Cg] = dY_g · W_g, puis col2im
+    const std::size_t chunk = images_per_chunk(p.N, OH * OW * row_len * sizeof(T));
+    Workspace<T> cols(chunk * OH * OW * row_len);
+    for (std::size_t n0 = 0; n0 < p.N; n0 += chunk) {
+        const std::size_t n1 = std::min(p.N, n0 + chunk);
+        const std::size_t M  = (n1 - n0) * OH * OW;
+        for (std::size_t g = 0; g < p.groups; ++g) {
+            gemm(M, row_len, Kg, Ref<T>{dy + n0 * OH * OW * p.K + g * Kg, std::ptrdiff_t(p.K), 1},
+                 Ref<T>{w + g * Kg * row_len, std::ptrdiff_t(row_len), 1},
+                 cols.get(), std::ptrdiff_t(row_len));
+            col2im(p, g, n0, n1, cols.get(), dx);
+        }
+    }
+}
+
+template<typename T>
+void conv2d_backward_weight(const Conv2dShape& p, const T* dy, const T* x, T* dw, T* db) {
+    const std::size_t OH = p.out_h(), OW = p.out_w();
+    if (db) {
+        sum_row_chunks(p.N * OH * OW, p.K, db, [&](T* part, std::size_t b, std::size_t e) {
+            for (std::size_t i = b; i < e; ++i) {
+                const T* g = dy + i * p.K;
+                for (std::size_t k = 0; k < p.K; ++k) part[k] += g[k];
+            }
+        });
+    }
+    if (!dw) return;
+    if (p.groups > 1 && conv_algorithm_supported(ConvAlgorithm::Depthwise, p))
+        return depthwise_backward_weight(p, dy, x, dw);
+    const std::size_t Cg = p.group_in(), Kg = p.group_out(), row_len = p.R * p.S * Cg;
+    if (is_pointwise(p)) {
+        // dW_g [Kg, Cg] = dY_gᵀ [Kg, M] · X_g [M, Cg]
+        const std::size_t M = p.N * p.H * p.W;
+        for (std::size_t g = 0; g < p.groups; ++g)
+            gemm(Kg, Cg, M, Ref<T>{dy + g * Kg, 1, std::ptrdiff_t(p.K)},
+                 Ref<T>{x + g * Cg, std::ptrdiff_t(p.C), 1},
+                 dw + g * Kg * Cg, std::ptrdiff_t(Cg));
+        return;
+    }
+    // dW_g [Kg, R·S·Cg] = Σ_lots dY_gᵀ · im2col(x)_g
+    const std::size_t chunk = images_per_chunk(p.N, OH * OW * row_len * sizeof(T));
+    Workspace<T> cols(chunk * OH * OW * row_len);
+    if (p.N == 0) std::fill(dw, dw + p.K * row_len, T(0));
+    for (std::size_t n0 = 0; n0 < p.N; n0 += chunk) {
+        const std::size_t n1 = std::min(p.N, n0 + chunk);
+        const std::size_t M  = (n1 - n0) * OH * OW;
+        for (std::size_t g = 0; g < p.groups; ++g) {
+            im2col(p, g, n0, n1, x, cols.get());
+            gemm(Kg, row_len, M, Ref<T>{dy + n0 * OH * OW * p.K + g * Kg, 1, std::ptrdiff_t(p.K)},
+                 Ref<T>{cols.get(), std::ptrdiff_t(row_len), 1},
+                 dw + g * Kg * row_len, std::ptrdiff_t(row_len), n0 > 0);
+        }
+    }
+}
+
+// ===================== Pooling =====================
+
+template<typename T>
+void max_pool2d(const Pool2dShape& p, const T* x, T* y, std::int64_t* indices) {
+    const std::size_t OH = p.out_h(), OW = p.out_w(), C = p.C;
+    const std::size_t rows = p.N * OH;
+    parallel_for(0, rows, grain_size(rows, OW * p.R * p.S * C * sizeof(T)), [&](std::size_t b, std::size_t e) {
+        for (std::size_t i = b; i < e; ++i) {
+            const std::size_t n = i / OH, oh = i % OH;
+            for (std::size_t ow = 0; ow < OW; ++ow) {
+                const std::size_t o = ((n * OH + oh) * OW + ow) * C;
+                T* out = y + o;
+                std::int64_t* idx = indices ? indices + o : nullptr;
+                std::fill(out, out + C, -std::numeric_limits<T>::infinity());
+                for (std::size_t r = 0; r < p.R; ++r) {
+                    const std::ptrdiff_t ih = in_pos(oh, r, p.stride_h, p.pad_h, 1);
+                    if (ih < 0 || ih >= std::ptrdiff_t(p.H)) continue;
+                    for (std::size_t s = 0; s < p.S; ++s) {
+                        const std::ptrdiff_t iw = in_pos(ow, s, p.stride_w, p.pad_w, 1);
+                        if (iw < 0 || iw >= std::ptrdiff_t(p.W)) continue;
+                        const std::size_t pos = std::size_t(ih) * p.W + std::size_t(iw);
+                        const T* in = x + (n * p.H * p.W + pos) * C;
+                        if (idx) {
+                            for (std::size_t c = 0; c < C; ++c)
+                                if (in[c] > out[c] || in[c] != in[c]) {
+                                    out[c] = in[c];
+                                    idx[c] = std::int64_t(pos);
+                                }
+                        } else {
+                            for (std::size_t c = 0; c < C; ++c)
+                                out[c] = (in[c] > out[c] || in[c] != in[c]) ? in[c] : out[c];
+                        }
+                    }
+                }
+            }
+        }
+    });
+}
+
+template<typename T>
+void max_pool2d_backward(const Pool2dShape& p, const T* dy, const std::int64_t* indices, T* dx) {
+    const std::size_t OH = p.out_h(), OW = p.out_w(), C = p.C, HW = p.H * p.W;
+    // Les fenêtres se recouvrent : une image par tâche
+    parallel_for(0, p.N, 1, [&](std::size_t b, std::size_t e) {
+        for (std::size_t n = b; n < e; ++n) {
+            T* img = dx + n * HW * C;
+            std::fill(img, img + HW * C, T(0));
+            for (std::size_t o = n * OH * OW; o < (n + 1) * OH * OW; ++o) {
+                const T* g = dy + o * C;
+                const std::int64_t* idx = indices + o * C;
+                for (std::size_t c = 0; c < C; ++c) img[std::size_t(idx[c]) * C + c] += g[c];
+            }
+        }
+    });
+}
+
+namespace {
+    // Diviseur de la fenêtre (oh, ow)
+    std::size_t pool_divisor(const Pool2dShape& p, std::size_t oh, std::size_t ow, bool count_include_pad) {
+        if (count_include_pad) return p.R * p.S;
+        const std::ptrdiff_t h0 = in_pos(oh, 0, p.stride_h, p.pad_h, 1);
+        const std::ptrdiff_t w0 = in_pos(ow, 0, p.stride_w, p.pad_w, 1);
+        const std::ptrdiff_t h1 = std::min(h0 + std::ptrdiff_t(p.R), std::ptrdiff_t(p.H));
+        const std::ptrdiff_t w1 = std::min(w0 + std::ptrdiff_t(p.S), std::ptrdiff_t(p.W));
+        return std::size_t(h1 - std::max<std::ptrdiff_t>(h0, 0)) * std::size_t(w1 - std::max<std::ptrdiff_t>(w0, 0));
+    }
+}
+
+template<typename T>
+void avg_pool2d(const Pool2dShape& p, bool count_include_pad, const T* x, T* y) {
+    const std::size_t OH = p.out_h(), OW = p.out_w(), C = p.C;
+    const std::size_t rows = p.N * OH;
+    parallel_for(0, rows, grain_size(rows, OW * p.R * p.S * C * sizeof(T)), [&](std::size_t b, std::size_t e) {
+        for (std::size_t i = b; i < e; ++i) {
+            const std::size_t n = i / OH, oh = i % OH;
+            for (std::size_t ow = 0; ow < OW; ++ow) {
+                T* out = y + ((n * OH + oh) * OW + ow) * C;
+                std::fill(out, out + C, T(0));
+                for (std::size_t r = 0; r < p.R; ++r) {
+                    const std::ptrdiff_t ih = in_pos(oh, r, p.stride_h, p.pad_h, 1);
+                    if (ih < 0 || ih >= std::ptrdiff_t(p.H)) continue;
+                    for (std::size_t s = 0; s < p.S; ++s) {
+                        const std::ptrdiff_t iw = in_pos(ow, s, p.stride_w, p.pad_w, 1);
+                        if (iw < 0 || iw >= std::ptrdiff_t(p.W)) continue;
+                        const T* in = x + ((n * p.H + std::size_t(ih)) * p.W + std::size_t(iw)) * C;
+                        for (std::size_t c = 0; c < C; ++c) out[c] += in[c];
+                    }
+                }
+                const T inv = T(1) / T(pool_divisor(p, oh, ow, count_include_pad));
+                for (std::size_t c = 0; c < C; ++c) out[c] *= inv;
+            }
+        }
+    });
+}
+
+template<typename T>
+void avg_pool2d_backward(const Pool2dShape& p, bool count_include_pad, const T* dy, T* dx) {
+    const std::size_t OH = p.out_h(), OW = p.out_w(), C = p.C;
+    parallel_for(0, p.N, 1, [&](std::size_t b, std::size_t e) {
+        for (std::size_t n = b; n < e; ++n) {
+            T* img = dx + n * p.H * p.W * C;
+            std::fill(img, img + p.H * p.W * C, T(0));
+            for (std::size_t oh = 0; oh < OH; ++oh) {
+                for (std::size_t ow = 0; ow < OW; ++ow) {
+                    const T* g = dy + ((n * OH + oh) * OW + ow) * C;
+                    const T inv = T(1) / T(pool_divisor(p, oh, ow, count_include_pad));
+                    for (std::size_t r = 0; r < p.R; ++r) {
+                        const std::ptrdiff_t ih = in_pos(oh, r, p.stride_h, p.pad_h, 1);
+                        if (ih < 0 || ih >= std::ptrdiff_t(p.H)) continue;
+                        for (std::size_t s = 0; s < p.S; ++s) {
+                            const std::ptrdiff_t iw = in_pos(ow, s, p.stride_w, p.pad_w, 1);
+                            if (iw < 0 || iw >= std::ptrdiff_t(p.W)) continue;
+                            T* d = img + (std::size_t(ih) * p.W + std::size_t(iw)) * C;
+                            for (std::size_t c = 0; c < C; ++c) d[c] += g[c] * inv;
+                        }
+                    }
+                }
+            }
+        }
+    });
+}
+
+#define NAPCAS_INSTANTIATE_CONV(T)                                              \
+    template void conv2d_forward<T>(const Conv2dShape&, ConvAlgorithm,          \
+                                    const T*, const T*, const T*, T*);          \
+    template void conv2d_backward_input<T>(const Conv2dShape&, const T*,        \
+                                           const T*, T*);                       \
+    template void conv2d_backward_weight<T>(const Conv2dShape&, const T*,       \
+                                            const T*, T*, T*);                  \
+    template void max_pool2d<T>(const Pool2dShape&, const T*, T*,               \
+                                std::int64_t*);                                 \
+    template void max_pool2d_backward<T>(const Pool2dShape&, const T*,          \
+                                         const std::int64_t*, T*);              \
+    template void avg_pool2d<T>(const Pool2dShape&, bool, const T*, T*);        \
+    template void avg_pool2d_backward<T>(const Pool2dShape&, bool, const T*, T*);
+
+NAPCAS_INSTANTIATE_CONV(float)
+NAPCAS_INSTANTIATE_CONV(double)
+
+} // namespace kernels
+} // namespace napcas
@@ -0,0 +1,126 @@
+// cpp/src/kernels/convert.cpp
+
+#include "napcas/kernels/convert.h"
+#include "napcas/kernels/convert_isa.h"
+#include "napcas/cpu.h"
+#include "napcas/dispatch.h"
+#include "napcas/parallel.h"
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+
+namespace napcas {
+namespace kernels {
+
+namespace {
+    // --- noyaux portables (table "scalar") ---
+
+    void f32_to_f16_scalar(const float* src, Half* dst, std::size_t n) {
+        for (std::size_t i = 0; i < n; ++i) dst[i] = Half(src[i]);
+    }
+    void f16_to_f32_scalar(const Half* src, float* dst, std::size_t n) {
+        for (std::size_t i = 0; i < n; ++i) dst[i] = float(src[i]);
+    }
+    void f32_to_bf16_scalar(const float* src, BFloat16* dst, std::size_t n) {
+        for (std::size_t i = 0; i < n; ++i) dst[i] = BFloat16(src[i]);
+    }
+    void bf16_to_f32_scalar(const BFloat16* src, float* dst, std::size_t n) {
+        for (std::size_t i = 0; i < n; ++i) dst[i] = float(src[i]);
+    }
+
+    const ConvertKernels kScalarKernels = {
+        f32_to_f16_scalar, f16_to_f32_scalar,
+        f32_to_bf16_scalar, bf16_to_f32_scalar,
+    };
+
+    // Les types 16 bits se lisent via float (une seule conversion
+    // utilisateur par static_cast)
+    template<typename T> auto to_value(T x) { return x; }
+    float to_value(Half x)     { return float(x); }
+    float to_value(BFloat16 x) { return float(x); }
+
+    // Flottant vers entier : troncature vers zéro, saturée aux bornes du
+    // type (NaN donne 0) ; static_cast seul serait indéfini hors de la plage
+    template<typename D, typename V>
+    D cast_value(V v) {
+        if constexpr (std::is_integral_v<D> && std::is_floating_point_v<V>) {
+            using L = std::numeric_limits<D>;
+            // Bornes exactes en V : lowest() vaut 0 ou -2^k, max() + 1 vaut 2^k
+            constexpr V lo = V(L::lowest());
+            constexpr V hi = V(2) * V(L::max() / 2 + 1);
+            if (v != v) return D(0);
+            if (v <= lo) return L::lowest();
+            if (v >= hi) return L::max();
+        }
+        return static_cast<D>(v);
+    }
+
+    template<typename D, typename S>
+    void cast_rows(D* __restrict dst, const S* __restrict src, std::size_t n) {
+        for (std::size_t i = 0; i < n; ++i) dst[i] = cast_value<D>(to_value(src[i]));
+    }
+
+    bool is_16bit(DType t) { return t == DType::Float16 || t == DType::BFloat16; }
+
+    // Taille des blocs float32 intermédiaires (tient en L1)
+    constexpr std::size_t kChunk = 1024;
+
+    void convert_serial(void* dst, DType dt, const void* src, DType st, std::size_t n) {
+        if (dt == st) {
+            std::memcpy(dst, src, n * dtype_size(dt));
+            return;
+        }
+        const ConvertKernels& k = convert_kernels();
+        if (st == DType::Float32 && dt == DType::Float16)
+            return k.f32_to_f16(static_cast<const float*>(src), static_cast<Half*>(dst), n);
+        if (st == DType::Float16 && dt == DType::Float32)
+            return k.f16_to_f32(static_cast<const Half*>(src), static_cast<float*>(dst), n);
+        if (st == DType::Float32 && dt == DType::BFloat16)
+            return k.f32_to_bf16(static_cast<const float*>(src), static_cast<BFloat16*>(dst), n);
+        if (st == DType::BFloat16 && dt == DType::Float32)
+            return k.bf16_to_f32(static_cast<const BFloat16*>(src), static_cast<float*>(dst), n);
+
+        if (is_16bit(st) || is_16bit(dt)) {
+            float buf[kChunk];
+            const std::size_t ss = dtype_size(st), ds = dtype_size(dt);
+            for (std::size_t off = 0; off < n; off += kChunk) {
+                const std::size_t len = std::min(kChunk, n - off);
+                convert_serial(buf, DType::Float32,
+                               static_cast<const char*>(src) + off * ss, st, len);
+                convert_serial(static_cast<char*>(dst) + off * ds, dt,
+                               buf, DType::Float32, len);
+            }
+            return;
+        }
+
+        NAPCAS_DISPATCH_ALL_TYPES(dt, "convert", [&] {
+            using D = scalar_t;
+            NAPCAS_DISPATCH_ALL_TYPES(st, "convert", [&] {
+                cast_rows(static_cast<D*>(dst), static_cast<const scalar_t*>(src), n);
+            });
+        });
+    }
+}
+
+const ConvertKernels& convert_kernels_scalar() { return kScalarKernels; }
+
+const ConvertKernels& convert_kernels() {
+    switch (cpu_capability()) {
+        case CpuCapability::AVX512: return convert_kernels_avx512();
+        case CpuCapability::AVX2:   return convert_kernels_avx2();
+        default:                    return convert_kernels_scalar();
+    }
+}
+
+void convert(void* dst, DType dst_dtype,
+             const void* src, DType src_dtype, std::size_t n) {
+    const std::size_t ss = dtype_size(src_dtype), ds = dtype_size(dst_dtype);
+    parallel_for(0, n, grain_size(n, ss + ds), [&](std::size_t b, std::size_t e) {
+        convert_serial(static_cast<char*>(dst) + b * ds, dst_dtype,
+                       static_cast<const char*>(src) + b * ss, src_dtype, e - b);
+    });
+}
+
+} // namespace kernels
+} // namespace napcas
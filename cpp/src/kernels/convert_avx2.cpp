@@ -0,0 +1,116 @@
+// cpp/src/kernels/convert_avx2.cpp
+//
+// Compilé avec -mavx2 -mfma -mf16c. Les fonctions inline de half.h ne sont
+// pas appelées ici (elles seraient instanciées avec ces drapeaux) : les
+// restes passent par un tampon complété à la largeur du vecteur.
+
+#include "napcas/kernels/convert_isa.h"
+
+#if defined(__AVX2__) && defined(__F16C__)
+#include <immintrin.h>
+#include <cstring>
+
+namespace napcas {
+namespace kernels {
+
+namespace {
+    constexpr std::size_t W = 8;
+
+    inline __m128i load8(const void* p)  { return _mm_loadu_si128(static_cast<const __m128i*>(p)); }
+    inline void store8(void* p, __m128i v) { _mm_storeu_si128(static_cast<__m128i*>(p), v); }
+
+    // Arrondi au plus proche pair vers bfloat16 (16 bits de poids fort dans
+    // chaque voie 32 bits) ; NaN rendu silencieux
+    inline __m256i round_bf16(__m256 f) {
+        const __m256i x   = _mm256_castps_si256(f);
+        const __m256i hi  = _mm256_srli_epi32(x, 16);
+        const __m256i lsb = _mm256_and_si256(hi, _mm256_set1_epi32(1));
+        const __m256i r   = _mm256_srli_epi32(
+            _mm256_add_epi32(x, _mm256_add_epi32(_mm256_set1_epi32(0x7fff), lsb)), 16);
+        const __m256i nan = _mm256_or_si256(hi, _mm256_set1_epi32(0x40));
+        const __m256  un  = _mm256_cmp_ps(f, f, _CMP_UNORD_Q);
+        return _mm256_blendv_epi8(r, nan, _mm256_castps_si256(un));
+    }
+
+    inline __m128i pack_bf16(__m256 f) {
+        const __m256i r = round_bf16(f);
+        // packus travaille par demi-registre : on regroupe les deux moitiés
+        const __m256i p = _mm256_permute4x64_epi64(_mm256_packus_epi32(r, r), 0x08);
+        return _mm256_castsi256_si128(p);
+    }
+
+    inline __m256 unpack_bf16(__m128i h) {
+        return _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_cvtepu16_epi32(h), 16));
+    }
+
+    void f32_to_f16(const float* src, Half* dst, std::size_t n) {
+        std::size_t i = 0;
+        for (; i + W <= n; i += W)
+            store8(dst + i, _mm256_cvtps_ph(_mm256_loadu_ps(src + i), _MM_FROUND_TO_NEAREST_INT));
+        if (i < n) {
+            float in[W] = {};
+            std::uint16_t out[W];
+            std::memcpy(in, src + i, (n - i) * sizeof(float));
+            store8(out, _mm256_cvtps_ph(_mm256_loadu_ps(in), _MM_FROUND_TO_NEAREST_INT));
+            std::memcpy(dst + i, out, (n - i) * sizeof(Half));
+        }
+    }
+
+    void f16_to_f32(const Half* src, float* dst, std::size_t n) {
+        std::size_t i = 0;
+        for (; i + W <= n; i += W)
+            _mm256_storeu_ps(dst + i, _mm256_cvtph_ps(load8(src + i)));
+        if (i < n) {
+            std::uint16_t in[W] = {};
+            float out[W];
+            std::memcpy(in, src + i, (n - i) * sizeof(Half));
+            _mm256_storeu_ps(out, _mm256_cvtph_ps(load8(in)));
+            std::memcpy(dst + i, out, (n - i) * sizeof(float));
+        }
+    }
+
+    void f32_to_bf16(const float* src, BFloat16* dst, std::size_t n) {
+        std::size_t i = 0;
+        for (; i + W <= n; i += W)
+            store8(dst + i, pack_bf16(_mm256_loadu_ps(src + i)));
+        if (i < n) {
+            float in[W] = {};
+            std::uint16_t out[W];
+            std::memcpy(in, src + i, (n - i) * sizeof(float));
+            store8(out, pack_bf16(_mm256_loadu_ps(in)));
+            std::memcpy(dst + i, out, (n - i) * sizeof(BFloat16));
+        }
+    }
+
+    void bf16_to_f32(const BFloat16* src, float* dst, std::size_t n) {
+        std::size_t i = 0;
+        for (; i + W <= n; i += W)
+            _mm256_storeu_ps(dst + i, unpack_bf16(load8(src + i)));
+        if (i < n) {
+            std::uint16_t in[W] = {};
+            float out[W];
+            std::memcpy(in, src + i, (n - i) * sizeof(BFloat16));
+            _mm256_storeu_ps(out, unpack_bf16(load8(in)));
+            std::memcpy(dst + i, out, (n - i) * sizeof(float));
+        }
+    }
+
+    constexpr ConvertKernels kKernels = {
+        f32_to_f16, f16_to_f32, f32_to_bf16, bf16_to_f32,
+    };
+}
+
+const ConvertKernels& convert_kernels_avx2() { return kKernels; }
+
+} // namespace kernels
+} // namespace napcas
+
+#else
+
+namespace napcas {
+namespace kernels {
+const ConvertKernels& convert_kernels_avx2() { return convert_kernels_scalar(); }
+} // namespace kernels
+} // namespace napcas
+
+#endif
@@ -0,0 +1,106 @@
+// cpp/src/kernels/convert_avx512.cpp
+//
+// Compilé avec -mavx512f (vcvtps2ph/vcvtph2ps et vpmovdw en font partie).
+// Même organisation que convert_avx2.cpp.
+
+#include "napcas/kernels/convert_isa.h"
+
+#if defined(__AVX512F__)
+#include <immintrin.h>
+#include <cstring>
+
+namespace napcas {
+namespace kernels {
+
+namespace {
+    constexpr std::size_t W = 16;
+
+    inline __m256i load16(const void* p)   { return _mm256_loadu_si256(static_cast<const __m256i*>(p)); }
+    inline void store16(void* p, __m256i v) { _mm256_storeu_si256(static_cast<__m256i*>(p), v); }
+
+    inline __m256i to_f16(__m512 f) {
+        return _mm512_cvtps_ph(f, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+    }
+
+    inline __m256i to_bf16(__m512 f) {
+        const __m512i x   = _mm512_castps_si512(f);
+        const __m512i hi  = _mm512_srli_epi32(x, 16);
+        const __m512i lsb = _mm512_and_si512(hi, _mm512_set1_epi32(1));
+        const __m512i r   = _mm512_srli_epi32(
+            _mm512_add_epi32(x, _mm512_add_epi32(_mm512_set1_epi32(0x7fff), lsb)), 16);
+        const __m512i nan = _mm512_or_si512(hi, _mm512_set1_epi32(0x40));
+        const __mmask16 un = _mm512_cmp_ps_mask(f, f, _CMP_UNORD_Q);
+        return _mm512_cvtepi32_epi16(_mm512_mask_blend_epi32(un, r, nan));
+    }
+
+    inline __m512 from_bf16(__m256i h) {
+        return _mm512_castsi512_ps(_mm512_slli_epi32(_mm512_cvtepu16_epi32(h), 16));
+    }
+
+    void f32_to_f16(const float* src, Half* dst, std::size_t n) {
+        std::size_t i = 0;
+        for (; i + W <= n; i += W)
+            store16(dst + i, to_f16(_mm512_loadu_ps(src + i)));
+        if (i < n) {
+            const __mmask16 m = __mmask16((1u << (n - i)) - 1);
+            std::uint16_t out[W];
+            store16(out, to_f16(_mm512_maskz_loadu_ps(m, src + i)));
+            std::memcpy(dst + i, out, (n - i) * sizeof(Half));
+        }
+    }
+
+    void f16_to_f32(const Half* src, float* dst, std::size_t n) {
+        std::size_t i = 0;
+        for (; i + W <= n; i += W)
+            _mm512_storeu_ps(dst + i, _mm512_cvtph_ps(load16(src + i)));
+        if (i < n) {
+            const __mmask16 m = __mmask16((1u << (n - i)) - 1);
+            std::uint16_t in[W] = {};
+            std::memcpy(in, src + i, (n - i) * sizeof(Half));
+            _mm512_mask_storeu_ps(dst + i, m, _mm512_cvtph_ps(load16(in)));
+        }
+    }
+
+    void f32_to_bf16(const float* src, BFloat16* dst, std::size_t n) {
+        std::size_t i = 0;
+        for (; i + W <= n; i += W)
+            store16(dst + i, to_bf16(_mm512_loadu_ps(src + i)));
+        if (i < n) {
+            const __mmask16 m = __mmask16((1u << (n - i)) - 1);
+            std::uint16_t out[W];
+            store16(out, to_bf16(_mm512_maskz_loadu_ps(m, src + i)));
+            std::memcpy(dst + i, out, (n - i) * sizeof(BFloat16));
+        }
+    }
+
+    void bf16_to_f32(const BFloat16* src, float* dst, std::size_t n) {
+        std::size_t i = 0;
+        for (; i + W <= n; i += W)
+            _mm512_storeu_ps(dst + i, from_bf16(load16(src + i)));
+        if (i < n) {
+            const __mmask16 m = __mmask16((1u << (n - i)) - 1);
+            std::uint16_t in[W] = {};
+            std::memcpy(in, src + i, (n - i) * sizeof(BFloat16));
+            _mm512_mask_storeu_ps(dst + i, m, from_bf16(load16(in)));
+        }
+    }
+
+    constexpr ConvertKernels kKernels = {
+        f32_to_f16, f16_to_f32, f32_to_bf16, bf16_to_f32,
+    };
+}
+
+const ConvertKernels& convert_kernels_avx512() { return kKernels; }
+
+} // namespace kernels
+} // namespace napcas
+
+#else
+
+namespace napcas {
+namespace kernels {
+const ConvertKernels& convert_kernels_avx512() { return convert_kernels_avx2(); }
+} // namespace kernels
+} // namespace napcas
+
+#endif
@@ -0,0 +1,203 @@
+// cpp/src/kernels/copy.cpp
+
+#include "napcas/kernels/copy.h"
+#include "napcas/parallel.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+namespace napcas {
+namespace kernels {
+
+namespace {
+    // Tuile de transposition : 32x32 éléments de 4 octets = 4 KiB par côté
+    constexpr std::size_t kTile = 32;
+
+    struct Geometry {
+        Shape   shape;
+        Strides src;
+        Strides dst;
+    };
+
+    // Supprime les dimensions de taille 1 et fusionne les dimensions voisines
+    // contiguës à la fois côté source et destination.
+    Geometry coalesce(const Shape&   shape,
+                      const Strides& src_strides) {
+        Strides dst_strides(shape.size());
+        std::ptrdiff_t stride = 1;
+        for (int d = int(shape.size()) - 1; d >= 0; --d) {
+            dst_strides[d] = stride;
+            stride *= std::ptrdiff_t(shape[d]);
+        }
+        Geometry g;
+        for (std::size_t d = 0; d < shape.size(); ++d) {
+            if (shape[d] == 1) continue;
+            if (!g.shape.empty() &&
+                g.src.back() == src_strides[d] * std::ptrdiff_t(shape[d]) &&
+                g.dst.back() == dst_strides[d] * std::ptrdiff_t(shape[d])) {
+                g.shape.back() *= shape[d];
+                g.src.back() = src_strides[d];
+                g.dst.back() = dst_strides[d];
+                continue;
+            }
+            g.shape.push_back(shape[d]);
+            g.src.push_back(src_strides[d]);
+            g.dst.push_back(dst_strides[d]);
+        }
+        return g;
+    }
+
+    // Offsets source / destination de l'indice linéaire `lin` sur les
+    // dimensions `dims` (ordre row-major)
+    void offsets_of(std::size_t lin, const Geometry& g,
+                    const std::vector<int>& dims,
+                    std::ptrdiff_t& src_off, std::ptrdiff_t& dst_off) {
+        src_off = 0;
+        dst_off = 0;
+        for (int i = int(dims.size()) - 1; i >= 0; --i) {
+            std::size_t n = g.shape[dims[i]];
+            std::size_t idx = lin % n;
+            lin /= n;
+            src_off += std::ptrdiff_t(idx) * g.src[dims[i]];
+            dst_off += std::ptrdiff_t(idx) * g.dst[dims[i]];
+        }
+    }
+
+    std::size_t product(const Geometry& g, const std::vector<int>& dims) {
+        std::size_t n = 1;
+        for (int d : dims) n *= g.shape[d];
+        return n;
+    }
+
+    template<typename T>
+    void copy_typed(T* dst, const T* src, const Geometry& g) {
+        const int nd = int(g.shape.size());
+        std::size_t numel = 1;
+        for (auto n : g.shape) numel *= n;
+        const std::size_t bytes = numel * sizeof(T);
+        const int q = nd - 1;
+
+        // 1) dimension interne contiguë : memcpy par segments de ligne,
+        //    découpés par éléments pour qu'une seule ligne soit parallèle
+        if (g.src[q] == 1) {
+            std::vector<int> outer;
+            for (int d = 0; d < q; ++d) outer.push_back(d);
+            const std::size_t len = g.shape[q];
+            parallel_for(0, numel, grain_size(numel, 2 * sizeof(T)),
+                [&](std::size_t b, std::size_t e) {
+                    while (b < e) {
+                        const std::size_t r   = b / len;
+                        const std::size_t col = b % len;
+                        const std::size_t n   = std::min(len - col, e - b);
+                        std::ptrdiff_t so, dof;
+                        offsets_of(r, g, outer, so, dof);
+                        std::memcpy(dst + dof + std::ptrdiff_t(col),
+                                    src + so + std::ptrdiff_t(col), n * sizeof(T));
+                        b += n;
+                    }
+                });
+            return;
+        }
+
+        // 2) une autre dimension est contiguë côté source : transposition
+        //    par tuiles entre cette dimension `p` et la dimension interne `q`
+        int p = -1;
+        for (int d = 0; d < q; ++d)
+            if (g.src[d] == 1) p = d;
+        if (p >= 0) {
+            std::vector<int> outer;
+            for (int d = 0; d < q; ++d)
+                if (d != p) outer.push_back(d);
+            const std::size_t n_outer = product(g, outer);
+            const std::size_t P = g.shape[p], Q = g.shape[q];
+            const std::size_t p_tiles = (P + kTile - 1) / kTile;
+            const std::ptrdiff_t src_q = g.src[q];
+            const std::ptrdiff_t dst_p = g.dst[p];
+            const std::size_t work = n_outer * p_tiles;
+            parallel_for(0, work, grain_size(work, 2 * bytes / work),
+                [&](std::size_t b, std::size_t e) {
+                    for (std::size_t w = b; w < e; ++w) {
+                        std::ptrdiff_t so, dof;
+                        offsets_of(w / p_tiles, g, outer, so, dof);
+                        const std::size_t i0 = (w % p_tiles) * kTile;
+                        const std::size_t i1 = std::min(P, i0 + kTile);
+                        for (std::size_t j0 = 0; j0 < Q; j0 += kTile) {
+                            const std::size_t j1 = std::min(Q, j0 + kTile);
+                            for (std::size_t i = i0; i < i1; ++i) {
+                                const T* s = src + so + std::ptrdiff_t(i);
+                                T*       o = dst + dof + std::ptrdiff_t(i) * dst_p;
+                                for (std::size_t j = j0; j < j1; ++j)
+                                    o[j] = s[std::ptrdiff_t(j) * src_q];
+                            }
+                        }
+                    }
+                });
+            return;
+        }
+
+        // 3) cas général : boucle interne à pas constant
+        std::vector<int> outer;
+        for (int d = 0; d < q; ++d) outer.push_back(d);
+        const std::size_t rows = product(g, outer);
+        const std::size_t len  = g.shape[q];
+        const std::ptrdiff_t src_q = g.src[q];
+        parallel_for(0, rows, grain_size(rows, 2 * bytes / rows),
+            [&](std::size_t b, std::size_t e) {
+                for (std::size_t r = b; r < e; ++r) {
+                    std::ptrdiff_t so, dof;
+                    offsets_of(r, g, outer, so, dof);
+                    const T* s = src + so;
+                    T*       o = dst + dof;
+                    for (std::size_t j = 0; j < len; ++j)
+                        o[j] = s[std::ptrdiff_t(j) * src_q];
+                }
+            });
+    }
+
+    // Élément de taille arbitraire (copié octet par octet)
+    void copy_bytes(char* dst, const char* src, const Geometry& g,
+                    std::size_t elem_size) {
+        std::size_t numel = 1;
+        for (auto n : g.shape) numel *= n;
+        Shape idx(g.shape.size(), 0);
+        std::ptrdiff_t off = 0;
+        for (std::size_t i = 0; i < numel; ++i) {
+            std::memcpy(dst + i * elem_size,
+                        src + off * std::ptrdiff_t(elem_size), elem_size);
+            for (int d = int(g.shape.size()) - 1; d >= 0; --d) {
+                if (++idx[d] < g.shape[d]) { off += g.src[d]; break; }
+                off -= g.src[d] * std::ptrdiff_t(g.shape[d] - 1);
+                idx[d] = 0;
+            }
+        }
+    }
+}
+
+void strided_copy(void* dst, const void* src,
+                  const Shape&   shape,
+                  const Strides& src_strides,
+                  std::size_t elem_size) {
+    for (auto n : shape)
+        if (n == 0) return;
+    Geometry g = coalesce(shape, src_strides);
+    if (g.shape.empty()) {
+        std::memcpy(dst, src, elem_size);
+        return;
+    }
+    switch (elem_size) {
+        case 1: copy_typed(static_cast<std::uint8_t*>(dst),
+                           static_cast<const std::uint8_t*>(src), g); break;
+        case 2: copy_typed(static_cast<std::uint16_t*>(dst),
+                           static_cast<const std::uint16_t*>(src), g); break;
+        case 4: copy_typed(static_cast<std::uint32_t*>(dst),
+                           static_cast<const std::uint32_t*>(src), g); break;
+        case 8: copy_typed(static_cast<std::uint64_t*>(dst),
+                           static_cast<const std::uint64_t*>(src), g); break;
+        default:
+            copy_bytes(static_cast<char*>(dst),
+                       static_cast<const char*>(src), g, elem_size);
+    }
+}
+
+} // namespace kernels
+} // namespace napcas
@@ -0,0 +1,354 @@
+// cpp/src/kernels/elementwise.cpp
+
+#include "napcas/kernels/elementwise.h"
+#include "napcas/kernels/elementwise_isa.h"
+#include "napcas/kernels/convert_isa.h"
+#include "napcas/kernels/strided_iter.h"
+#include "napcas/cpu.h"
+#include "napcas/dispatch.h"
+#include "napcas/parallel.h"
+#include <cstring>
+#include <stdexcept>
+#include <algorithm>
+#include <type_traits>
+
+namespace napcas {
+namespace kernels {
+
+namespace {
+    struct AddOp {
+        template<typename T> static T apply(T x, T y) { return x + y; }
+    };
+    struct SubOp {
+        template<typename T> static T apply(T x, T y) { return x - y; }
+    };
+    struct MulOp {
+        template<typename T> static T apply(T x, T y) { return x * y; }
+    };
+    struct DivOp {
+        template<typename T> static T apply(T x, T y) { return x / y; }
+    };
+
+    // Les entiers débordent en complément à deux, comme les noyaux SIMD ;
+    // la division entière suit int_div (x / 0 = 0, MIN / -1 = MIN) ;
+    // les types 16 bits calculent en float32
+    template<typename Op, typename T>
+    T apply_op(T x, T y) {
+        if constexpr (std::is_integral_v<T>) {
+            if constexpr (std::is_same_v<Op, DivOp>) {
+                return int_div(x, y);
+            } else {
+                using U = std::make_unsigned_t<T>;
+                return T(Op::template apply<U>(U(x), U(y)));
+            }
+        } else if constexpr (std::is_floating_point_v<T>) {
+            return Op::template apply<T>(x, y);
+        } else {
+            return T(Op::template apply<float>(float(x), float(y)));
+        }
+    }
+
+    // --- noyaux 1D portables (table "scalar") ---
+    // Pas de __restrict : c peut être a ou b (add_, variantes out=) ;
+    // chaque élément est lu avant d'être écrit, comme dans les tables SIMD
+
+    template<typename Op, typename T>
+    void row_vv(T* c, const T* a, const T* b, std::size_t n) {
+        for (std::size_t i = 0; i < n; ++i) c[i] = apply_op<Op>(a[i], b[i]);
+    }
+
+    template<typename Op, typename T>
+    void row_vs(T* c, const T* a, T s, std::size_t n) {
+        for (std::size_t i = 0; i < n; ++i) c[i] = apply_op<Op>(a[i], s);
+    }
+
+    template<typename Op, typename T>
+    void row_sv(T* c, T s, const T* b, std::size_t n) {
+        for (std::size_t i = 0; i < n; ++i) c[i] = apply_op<Op>(s, b[i]);
+    }
+
+    template<typename Op, typename T>
+    void row_strided(T* c, std::ptrdiff_t sc, const T* a, std::ptrdiff_t sa,
+                     const T* b, std::ptrdiff_t sb, std::size_t n) {
+        for (std::size_t i = 0; i < n; ++i)
+            c[std::ptrdiff_t(i) * sc] = apply_op<Op>(a[std::ptrdiff_t(i) * sa],
+                                                     b[std::ptrdiff_t(i) * sb]);
+    }
+
+    template<typename T>
+    constexpr BinaryRowKernels<T> scalar_rows() {
+        return {
+            { row_vv<AddOp, T>, row_vv<SubOp, T>, row_vv<MulOp, T>, row_vv<DivOp, T> },
+            { row_vs<AddOp, T>, row_vs<SubOp, T>, row_vs<MulOp, T>, row_vs<DivOp, T> },
+            { row_sv<AddOp, T>, row_sv<SubOp, T>, row_sv<MulOp, T>, row_sv<DivOp, T> },
+        };
+    }
+
+    const BinaryKernels kScalarKernels = {
+        scalar_rows<float>(),
+        scalar_rows<std::int32_t>(),
+    };
+
+    // --- float16 / bfloat16 : blocs convertis en float32, noyau float32 ---
+
+    constexpr std::size_t kHalfChunk = 256;
+
+    void to_f32(const Half* s, float* d, std::size_t n)     { convert_kernels().f16_to_f32(s, d, n); }
+    void to_f32(const BFloat16* s, float* d, std::size_t n) { convert_kernels().bf16_to_f32(s, d, n); }
+    void from_f32(const float* s, Half* d, std::size_t n)     { convert_kernels().f32_to_f16(s, d, n); }
+    void from_f32(const float* s, BFloat16* d, std::size_t n) { convert_kernels().f32_to_bf16(s, d, n); }
+
+    template<int K, typename H>
+    void row_vv_16(H* c, const H* a, const H* b, std::size_t n) {
+        float fa[kHalfChunk], fb[kHalfChunk], fc[kHalfChunk];
+        auto fn = binary_kernels().f32.vv[K];
+        for (std::size_t i = 0; i < n; i += kHalfChunk) {
+            const std::size_t len = std::min(kHalfChunk, n - i);
+            to_f32(a + i, fa, len);
+            to_f32(b + i, fb, len);
+            fn(fc, fa, fb, len);
+            from_f32(fc, c + i, len);
+        }
+    }
+
+    template<int K, typename H>
+    void row_vs_16(H* c, const H* a, H s, std::size_t n) {
+        float fa[kHalfChunk], fc[kHalfChunk];
+        auto fn = binary_kernels().f32.vs[K];
+        for (std::size_t i = 0; i < n; i += kHalfChunk) {
+            const std::size_t len = std::min(kHalfChunk, n - i);
+            to_f32(a + i, fa, len);
+            fn(fc, fa, float(s), len);
+            from_f32(fc, c + i, len);
+        }
+    }
+
+    template<int K, typename H>
+    void row_sv_16(H* c, H s, const H* b, std::size_t n) {
+        float fb[kHalfChunk], fc[kHalfChunk];
+        auto fn = binary_kernels().f32.sv[K];
+        for (std::size_t i = 0; i < n; i += kHalfChunk) {
+            const std::size_t len = std::min(kHalfChunk, n - i);
+            to_f32(b + i, fb, len);
+            fn(fc, float(s), fb, len);
+            from_f32(fc, c + i, len);
+        }
+    }
+
+    template<typename H>
+    constexpr BinaryRowKernels<H> half_rows() {
+        return {
+            { row_vv_16<0, H>, row_vv_16<1, H>, row_vv_16<2, H>, row_vv_16<3, H> },
+            { row_vs_16<0, H>, row_vs_16<1, H>, row_vs_16<2, H>, row_vs_16<3, H> },
+            { row_sv_16<0, H>, row_sv_16<1, H>, row_sv_16<2, H>, row_sv_16<3, H> },
+        };
+    }
+
+    template<typename Op, typename T>
+    void strided_segments(T* out, const T* a, const T* b, const StridedGeometry<3>& g,
+                          std::size_t begin, std::size_t end) {
+        const std::ptrdiff_t so = g.inner_stride(0);
+        const std::ptrdiff_t sa = g.inner_stride(1);
+        const std::ptrdiff_t sb = g.inner_stride(2);
+        for_each_segment(g, begin, end,
+            [&](const std::array<std::ptrdiff_t, 3>& off, std::size_t col, std::size_t len) {
+                row_strided<Op>(out + off[0] + std::ptrdiff_t(col) * so, so,
+                                a + off[1] + std::ptrdiff_t(col) * sa, sa,
+                                b + off[2] + std::ptrdiff_t(col) * sb, sb, len);
+            });
+    }
+
+    template<typename T>
+    void binary_impl(BinaryOp op, T* out, const T* a, const T* b,
+                     const Shape&   out_shape,
+                     const Strides& out_strides,
+                     const Strides& a_strides,
+                     const Strides& b_strides) {
+        for (auto n : out_shape)
+            if (n == 0) return;
+        auto g = coalesce<3>(out_shape, {&out_strides, &a_strides, &b_strides});
+        const std::ptrdiff_t so = g.inner_stride(0);
+        const std::ptrdiff_t sa = g.inner_stride(1);
+        const std::ptrdiff_t sb = g.inner_stride(2);
+        const int k = int(op);
+        const std::size_t numel = g.rows() * g.inner();
+        const auto& rows = binary_row_kernels<T>();
+
+        // Découpage par éléments : une seule ligne (cas contigu) est aussi
+        // répartie entre les threads.
+        parallel_for(0, numel, grain_size(numel, 3 * sizeof(T)),
+            [&](std::size_t begin, std::size_t end) {
+                using Off = std::array<std::ptrdiff_t, 3>;
+                // Noyaux vectorisés si la sortie est contiguë sur la ligne
+                if (so == 1 && sa == 1 && sb == 1) {
+                    auto fn = rows.vv[k];
+                    for_each_segment(g, begin, end, [&](const Off& off, std::size_t c, std::size_t len) {
+                        fn(out + off[0] + c, a + off[1] + c, b + off[2] + c, len);
+                    });
+                } else if (so == 1 && sa == 1 && sb == 0) {
+                    auto fn = rows.vs[k];
+                    for_each_segment(g, begin, end, [&](const Off& off, std::size_t c, std::size_t len) {
+                        fn(out + off[0] + c, a + off[1] + c, b[off[2]], len);
+                    });
+                } else if (so == 1 && sa == 0 && sb == 1) {
+                    auto fn = rows.sv[k];
+                    for_each_segment(g, begin, end, [&](const Off& off, std::size_t c, std::size_t len) {
+                        fn(out + off[0] + c, a[off[1]], b + off[2] + c, len);
+                    });
+                } else {
+                    switch (op) {
+                        case BinaryOp::Add: strided_segments<AddOp>(out, a, b, g, begin, end); break;
+                        case BinaryOp::Sub: strided_segments<SubOp>(out, a, b, g, begin, end); break;
+                        case BinaryOp::Mul: strided_segments<MulOp>(out, a, b, g, begin, end); break;
+                        case BinaryOp::Div: strided_segments<DivOp>(out, a, b, g, begin, end); break;
+                        default: throw std::runtime_error("binary_op: unknown op");
+                    }
+                }
+            });
+    }
+}
+
+const BinaryKernels& binary_kernels_scalar() { return kScalarKernels; }
+
+const BinaryKernels& binary_kernels() {
+    switch (cpu_capability()) {
+        case CpuCapability::AVX512: return binary_kernels_avx512();
+        case CpuCapability::AVX2:   return binary_kernels_avx2();
+        case CpuCapability::SSE2:   return binary_kernels_sse2();
+        default:                    return binary_kernels_scalar();
+    }
+}
+
+// Tables SIMD pour float32/int32, noyaux par blocs float32 pour les types
+// 16 bits, noyaux portables (auto-vectorisés) pour les autres types
+template<typename T>
+const BinaryRowKernels<T>& binary_row_kernels() {
+    if constexpr (std::is_same_v<T, float>) {
+        return binary_kernels().f32;
+    } else if constexpr (std::is_same_v<T, std::int32_t>) {
+        return binary_kernels().i32;
+    } else if constexpr (std::is_same_v<T, Half> || std::is_same_v<T, BFloat16>) {
+        static constexpr BinaryRowKernels<T> kRows = half_rows<T>();
+        return kRows;
+    } else {
+        static constexpr BinaryRowKernels<T> kRows = scalar_rows<T>();
+        return kRows;
+    }
+}
+
+template<typename T>
+void binary_op(BinaryOp op, T* out, const T* a, const T* b,
+               const Shape&   out_shape,
+               const Strides& a_strides,
+               const Strides& b_strides) {
+    Strides out_strides(out_shape.size());
+    std::ptrdiff_t stride = 1;
+    for (int d = int(out_shape.size()) - 1; d >= 0; --d) {
+        out_strides[d] = stride;
+        stride *= std::ptrdiff_t(out_shape[d]);
+    }
+    binary_impl(op, out, a, b, out_shape, out_strides, a_strides, b_strides);
+}
+
+template<typename T>
+void binary_op(BinaryOp op, T* out, const T* a, const T* b,
+               const Shape&   out_shape,
+               const Strides& out_strides,
+               const Strides& a_strides,
+               const Strides& b_strides) {
+    binary_impl(op, out, a, b, out_shape, out_strides, a_strides, b_strides);
+}
+
+void fill(void* dst, const void* value, std::size_t n, std::size_t elem_size) {
+    char* d = static_cast<char*>(dst);
+    bool all_zero = true;
+    for (std::size_t i = 0; i < elem_size; ++i)
+        all_zero = all_zero && static_cast<const char*>(value)[i] == 0;
+    parallel_for(0, n, grain_size(n, elem_size), [&](std::size_t b, std::size_t e) {
+        if (all_zero) {
+            std::memset(d + b * elem_size, 0, (e - b) * elem_size);
+            return;
+        }
+        switch (elem_size) {
+            case 4: {
+                std::uint32_t v;
+                std::memcpy(&v, value, 4);
+                std::fill(reinterpret_cast<std::uint32_t*>(d) + b,
+                          reinterpret_cast<std::uint32_t*>(d) + e, v);
+                break;
+            }
+            case 8: {
+                std::uint64_t v;
+                std::memcpy(&v, value, 8);
+                std::fill(reinterpret_cast<std::uint64_t*>(d) + b,
+                          reinterpret_cast<std::uint64_t*>(d) + e, v);
+                break;
+            }
+            default:
+                for (std::size_t i = b; i < e; ++i)
+                    std::memcpy(d + i * elem_size, value, elem_size);
+        }
+    });
+}
+
+template<typename T>
+void sum_to(T* out, const T* in,
+            const Shape&   in_shape,
+            const Strides& out_strides) {
+    for (auto n : in_shape)
+        if (n == 0) return;
+    Strides in_strides(in_shape.size());
+    std::ptrdiff_t stride = 1;
+    for (int d = int(in_shape.size()) - 1; d >= 0; --d) {
+        in_strides[d] = stride;
+        stride *= std::ptrdiff_t(in_shape[d]);
+    }
+    auto g = coalesce<2>(in_shape, {&out_strides, &in_strides});
+    const std::size_t n = g.inner();
+    const std::ptrdiff_t so = g.inner_stride(0);
+    using Acc = acc_type_t<T>;
+    for_each_row(g, 0, g.rows(), [&](const std::array<std::ptrdiff_t, 2>& off) {
+        T*       o = out + off[0];
+        const T* x = in + off[1];
+        if (so == 0) {
+            Acc acc = Acc(0);
+            for (std::size_t i = 0; i < n; ++i) acc += Acc(x[i]);
+            *o = T(Acc(*o) + acc);
+        } else if (so == 1) {
+            for (std::size_t i = 0; i < n; ++i) o[i] = T(Acc(o[i]) + Acc(x[i]));
+        } else {
+            for (std::size_t i = 0; i < n; ++i) {
+                T& y = o[std::ptrdiff_t(i) * so];
+                y = T(Acc(y) + Acc(x[i]));
+            }
+        }
+    });
+}
+
+#define NAPCAS_INSTANTIATE_ELEMENTWISE(T)                                      \
+    template const BinaryRowKernels<T>& binary_row_kernels<T>();               \
+    template void binary_op<T>(BinaryOp, T*, const T*, const T*,               \
+                               const Shape&,                                   \
+                               const Strides&,                                 \
+                               const Strides&);                                \
+    template void binary_op<T>(BinaryOp, T*, const T*, const T*,               \
+                               const Shape&,                                   \
+                               const Strides&,                                 \
+                               const Strides&,                                 \
+                               const Strides&);                                \
+    template void sum_to<T>(T*, const T*, const Shape&,                        \
+                            const Strides&);
+
+NAPCAS_INSTANTIATE_ELEMENTWISE(float)
+NAPCAS_INSTANTIATE_ELEMENTWISE(double)
+NAPCAS_INSTANTIATE_ELEMENTWISE(Half)
+NAPCAS_INSTANTIATE_ELEMENTWISE(BFloat16)
+NAPCAS_INSTANTIATE_ELEMENTWISE(std::int8_t)
+NAPCAS_INSTANTIATE_ELEMENTWISE(std::uint8_t)
+NAPCAS_INSTANTIATE_ELEMENTWISE(std::int32_t)
+NAPCAS_INSTANTIATE_ELEMENTWISE(std::int64_t)
+
+#undef NAPCAS_INSTANTIATE_ELEMENTWISE
+
+} // namespace kernels
+} // namespace napcas
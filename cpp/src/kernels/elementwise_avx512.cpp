@@ -0,0 +1,191 @@
+// cpp/src/kernels/elementwise_avx512.cpp
+//
+// Compilé avec -mavx512f : tout le code reste dans un namespace anonyme
+// pour que le linker ne puisse pas réutiliser ces instanciations ailleurs.
+// Les fins de boucle passent par des chargements/écritures masqués.
+
+#include "napcas/kernels/elementwise_isa.h"
+
+#if defined(__AVX512F__)
+#include <immintrin.h>
+
+namespace napcas {
+namespace kernels {
+
+namespace {
+    using V  = __m512;
+    using VI = __m512i;
+    constexpr std::size_t W = 16;
+
+    inline __mmask16 tail_mask(std::size_t r) { return __mmask16((1u << r) - 1u); }
+
+    struct Add {
+        static constexpr bool kIntVector = true;
+        static V  vf(V a, V b)   { return _mm512_add_ps(a, b); }
+        static VI vi(VI a, VI b) { return _mm512_add_epi32(a, b); }
+        static std::int32_t si(std::int32_t a, std::int32_t b) {
+            return std::int32_t(std::uint32_t(a) + std::uint32_t(b));
+        }
+    };
+    struct Sub {
+        static constexpr bool kIntVector = true;
+        static V  vf(V a, V b)   { return _mm512_sub_ps(a, b); }
+        static VI vi(VI a, VI b) { return _mm512_sub_epi32(a, b); }
+        static std::int32_t si(std::int32_t a, std::int32_t b) {
+            return std::int32_t(std::uint32_t(a) - std::uint32_t(b));
+        }
+    };
+    struct Mul {
+        static constexpr bool kIntVector = true;
+        static V  vf(V a, V b)   { return _mm512_mul_ps(a, b); }
+        static VI vi(VI a, VI b) { return _mm512_mullo_epi32(a, b); }
+        static std::int32_t si(std::int32_t a, std::int32_t b) {
+            return std::int32_t(std::uint32_t(a) * std::uint32_t(b));
+        }
+    };
+    struct Div {
+        static constexpr bool kIntVector = false;   // pas de division entière SIMD
+        static V  vf(V a, V b)   { return _mm512_div_ps(a, b); }
+        static VI vi(VI a, VI)   { return a; }
+        static std::int32_t si(std::int32_t a, std::int32_t b) { return int_div(a, b); }
+    };
+
+    // --- float32 ---
+
+    template<typename Op>
+    void vv_f32(float* c, const float* a, const float* b, std::size_t n) {
+        std::size_t i = 0;
+        for (; i + 2 * W <= n; i += 2 * W) {
+            V x0 = Op::vf(_mm512_loadu_ps(a + i),     _mm512_loadu_ps(b + i));
+            V x1 = Op::vf(_mm512_loadu_ps(a + i + W), _mm512_loadu_ps(b + i + W));
+            _mm512_storeu_ps(c + i, x0);
+            _mm512_storeu_ps(c + i + W, x1);
+        }
+        for (; i + W <= n; i += W)
+            _mm512_storeu_ps(c + i, Op::vf(_mm512_loadu_ps(a + i), _mm512_loadu_ps(b + i)));
+        if (i < n) {
+            const __mmask16 m = tail_mask(n - i);
+            // lanes masquées à 1 pour ne pas lever d'exception FP sur Div
+            V x = _mm512_mask_loadu_ps(_mm512_set1_ps(1.0f), m, a + i);
+            V y = _mm512_mask_loadu_ps(_mm512_set1_ps(1.0f), m, b + i);
+            _mm512_mask_storeu_ps(c + i, m, Op::vf(x, y));
+        }
+    }
+
+    template<typename Op>
+    void vs_f32(float* c, const float* a, float s, std::size_t n) {
+        const V vs = _mm512_set1_ps(s);
+        std::size_t i = 0;
+        for (; i + 2 * W <= n; i += 2 * W) {
+            V x0 = Op::vf(_mm512_loadu_ps(a + i),     vs);
+            V x1 = Op::vf(_mm512_loadu_ps(a + i + W), vs);
+            _mm512_storeu_ps(c + i, x0);
+            _mm512_storeu_ps(c + i + W, x1);
+        }
+        for (; i + W <= n; i += W)
+            _mm512_storeu_ps(c + i, Op::vf(_mm512_loadu_ps(a + i), vs));
+        if (i < n) {
+            const __mmask16 m = tail_mask(n - i);
+            V x = _mm512_mask_loadu_ps(_mm512_set1_ps(1.0f), m, a + i);
+            _mm512_mask_storeu_ps(c + i, m, Op::vf(x, vs));
+        }
+    }
+
+    template<typename Op>
+    void sv_f32(float* c, float s, const float* b, std::size_t n) {
+        const V vs = _mm512_set1_ps(s);
+        std::size_t i = 0;
+        for (; i + 2 * W <= n; i += 2 * W) {
+            V x0 = Op::vf(vs, _mm512_loadu_ps(b + i));
+            V x1 = Op::vf(vs, _mm512_loadu_ps(b + i + W));
+            _mm512_storeu_ps(c + i, x0);
+            _mm512_storeu_ps(c + i + W, x1);
+        }
+        for (; i + W <= n; i += W)
+            _mm512_storeu_ps(c + i, Op::vf(vs, _mm512_loadu_ps(b + i)));
+        if (i < n) {
+            const __mmask16 m = tail_mask(n - i);
+            V y = _mm512_mask_loadu_ps(_mm512_set1_ps(1.0f), m, b + i);
+            _mm512_mask_storeu_ps(c + i, m, Op::vf(vs, y));
+        }
+    }
+
+    // --- int32 ---
+
+    template<typename Op>
+    void vv_i32(std::int32_t* c, const std::int32_t* a, const std::int32_t* b, std::size_t n) {
+        std::size_t i = 0;
+        if constexpr (Op::kIntVector) {
+            for (; i + W <= n; i += W)
+                _mm512_storeu_si512(c + i, Op::vi(_mm512_loadu_si512(a + i),
+                                                  _mm512_loadu_si512(b + i)));
+            if (i < n) {
+                const __mmask16 m = tail_mask(n - i);
+                VI x = _mm512_maskz_loadu_epi32(m, a + i);
+                VI y = _mm512_maskz_loadu_epi32(m, b + i);
+                _mm512_mask_storeu_epi32(c + i, m, Op::vi(x, y));
+                return;
+            }
+        }
+        for (; i < n; ++i) c[i] = Op::si(a[i], b[i]);
+    }
+
+    template<typename Op>
+    void vs_i32(std::int32_t* c, const std::int32_t* a, std::int32_t s, std::size_t n) {
+        std::size_t i = 0;
+        if constexpr (Op::kIntVector) {
+            const VI vs = _mm512_set1_epi32(s);
+            for (; i + W <= n; i += W)
+                _mm512_storeu_si512(c + i, Op::vi(_mm512_loadu_si512(a + i), vs));
+            if (i < n) {
+                const __mmask16 m = tail_mask(n - i);
+                _mm512_mask_storeu_epi32(c + i, m,
+                    Op::vi(_mm512_maskz_loadu_epi32(m, a + i), vs));
+                return;
+            }
+        }
+        for (; i < n; ++i) c[i] = Op::si(a[i], s);
+    }
+
+    template<typename Op>
+    void sv_i32(std::int32_t* c, std::int32_t s, const std::int32_t* b, std::size_t n) {
+        std::size_t i = 0;
+        if constexpr (Op::kIntVector) {
+            const VI vs = _mm512_set1_epi32(s);
+            for (; i + W <= n; i += W)
+                _mm512_storeu_si512(c + i, Op::vi(vs, _mm512_loadu_si512(b + i)));
+            if (i < n) {
+                const __mmask16 m = tail_mask(n - i);
+                _mm512_mask_storeu_epi32(c + i, m,
+                    Op::vi(vs, _mm512_maskz_loadu_epi32(m, b + i)));
+                return;
+            }
+        }
+        for (; i < n; ++i) c[i] = Op::si(s, b[i]);
+    }
+
+    const BinaryKernels kKernels = {
+        { { vv_f32<Add>, vv_f32<Sub>, vv_f32<Mul>, vv_f32<Div> },
+          { vs_f32<Add>, vs_f32<Sub>, vs_f32<Mul>, vs_f32<Div> },
+          { sv_f32<Add>, sv_f32<Sub>, sv_f32<Mul>, sv_f32<Div> } },
+        { { vv_i32<Add>, vv_i32<Sub>, vv_i32<Mul>, vv_i32<Div> },
+          { vs_i32<Add>, vs_i32<Sub>, vs_i32<Mul>, vs_i32<Div> },
+          { sv_i32<Add>, sv_i32<Sub>, sv_i32<Mul>, sv_i32<Div> } },
+    };
+}
+
+const BinaryKernels& binary_kernels_avx512() { return kKernels; }
+
+} // namespace kernels
+} // namespace napcas
+
+#else
+
+namespace napcas {
+namespace kernels {
+// Compilateur sans support AVX-512 : le dispatch retombe sur AVX2
+const BinaryKernels& binary_kernels_avx512() { return binary_kernels_avx2(); }
+} // namespace kernels
+} // namespace napcas
+
+#endif
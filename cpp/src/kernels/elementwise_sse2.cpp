@@ -0,0 +1,156 @@
+// cpp/src/kernels/elementwise_sse2.cpp
+//
+// SSE2 fait partie de la base x86-64 : aucun drapeau supplémentaire requis.
+
+#include "napcas/kernels/elementwise_isa.h"
+
+#if defined(__SSE2__)
+#include <immintrin.h>
+
+namespace napcas {
+namespace kernels {
+
+namespace {
+    using V  = __m128;
+    using VI = __m128i;
+    constexpr std::size_t W = 4;
+
+    inline V   loadf(const float* p)        { return _mm_loadu_ps(p); }
+    inline void storef(float* p, V v)       { _mm_storeu_ps(p, v); }
+    inline VI  loadi(const std::int32_t* p) { return _mm_loadu_si128(reinterpret_cast<const VI*>(p)); }
+    inline void storei(std::int32_t* p, VI v) { _mm_storeu_si128(reinterpret_cast<VI*>(p), v); }
+
+    struct Add {
+        static constexpr bool kIntVector = true;
+        static V  vf(V a, V b)   { return _mm_add_ps(a, b); }
+        static VI vi(VI a, VI b) { return _mm_add_epi32(a, b); }
+        static float sf(float a, float b) { return a + b; }
+        static std::int32_t si(std::int32_t a, std::int32_t b) {
+            return std::int32_t(std::uint32_t(a) + std::uint32_t(b));
+        }
+    };
+    struct Sub {
+        static constexpr bool kIntVector = true;
+        static V  vf(V a, V b)   { return _mm_sub_ps(a, b); }
+        static VI vi(VI a, VI b) { return _mm_sub_epi32(a, b); }
+        static float sf(float a, float b) { return a - b; }
+        static std::int32_t si(std::int32_t a, std::int32_t b) {
+            return std::int32_t(std::uint32_t(a) - std::uint32_t(b));
+        }
+    };
+    struct Mul {
+        static constexpr bool kIntVector = false;   // _mm_mullo_epi32 requiert SSE4.1
+        static V  vf(V a, V b)   { return _mm_mul_ps(a, b); }
+        static VI vi(VI a, VI)   { return a; }
+        static float sf(float a, float b) { return a * b; }
+        static std::int32_t si(std::int32_t a, std::int32_t b) {
+            return std::int32_t(std::uint32_t(a) * std::uint32_t(b));
+        }
+    };
+    struct Div {
+        static constexpr bool kIntVector = false;   // pas de division entière SIMD
+        static V  vf(V a, V b)   { return _mm_div_ps(a, b); }
+        static VI vi(VI a, VI)   { return a; }
+        static float sf(float a, float b) { return a / b; }
+        static std::int32_t si(std::int32_t a, std::int32_t b) { return int_div(a, b); }
+    };
+
+    // --- float32 ---
+
+    template<typename Op>
+    void vv_f32(float* c, const float* a, const float* b, std::size_t n) {
+        std::size_t i = 0;
+        for (; i + 2 * W <= n; i += 2 * W) {
+            V x0 = Op::vf(loadf(a + i),     loadf(b + i));
+            V x1 = Op::vf(loadf(a + i + W), loadf(b + i + W));
+            storef(c + i, x0);
+            storef(c + i + W, x1);
+        }
+        for (; i + W <= n; i += W) storef(c + i, Op::vf(loadf(a + i), loadf(b + i)));
+        for (; i < n; ++i) c[i] = Op::sf(a[i], b[i]);
+    }
+
+    template<typename Op>
+    void vs_f32(float* c, const float* a, float s, std::size_t n) {
+        const V vs = _mm_set1_ps(s);
+        std::size_t i = 0;
+        for (; i + 2 * W <= n; i += 2 * W) {
+            V x0 = Op::vf(loadf(a + i),     vs);
+            V x1 = Op::vf(loadf(a + i + W), vs);
+            storef(c + i, x0);
+            storef(c + i + W, x1);
+        }
+        for (; i + W <= n; i += W) storef(c + i, Op::vf(loadf(a + i), vs));
+        for (; i < n; ++i) c[i] = Op::sf(a[i], s);
+    }
+
+    template<typename Op>
+    void sv_f32(float* c, float s, const float* b, std::size_t n) {
+        const V vs = _mm_set1_ps(s);
+        std::size_t i = 0;
+        for (; i + 2 * W <= n; i += 2 * W) {
+            V x0 = Op::vf(vs, loadf(b + i));
+            V x1 = Op::vf(vs, loadf(b + i + W));
+            storef(c + i, x0);
+            storef(c + i + W, x1);
+        }
+        for (; i + W <= n; i += W) storef(c + i, Op::vf(vs, loadf(b + i)));
+        for (; i < n; ++i) c[i] = Op::sf(s, b[i]);
+    }
+
+    // --- int32 ---
+
+    template<typename Op>
+    void vv_i32(std::int32_t* c, const std::int32_t* a, const std::int32_t* b, std::size_t n) {
+        std::size_t i = 0;
+        if constexpr (Op::kIntVector) {
+            for (; i + W <= n; i += W) storei(c + i, Op::vi(loadi(a + i), loadi(b + i)));
+        }
+        for (; i < n; ++i) c[i] = Op::si(a[i], b[i]);
+    }
+
+    template<typename Op>
+    void vs_i32(std::int32_t* c, const std::int32_t* a, std::int32_t s, std::size_t n) {
+        std::size_t i = 0;
+        if constexpr (Op::kIntVector) {
+            const VI vs = _mm_set1_epi32(s);
+            for (; i + W <= n; i += W) storei(c + i, Op::vi(loadi(a + i), vs));
+        }
+        for (; i < n; ++i) c[i] = Op::si(a[i], s);
+    }
+
+    template<typename Op>
+    void sv_i32(std::int32_t* c, std::int32_t s, const std::int32_t* b, std::size_t n) {
+        std::size_t i = 0;
+        if constexpr (Op::kIntVector) {
+            const VI vs = _mm_set1_epi32(s);
+            for (; i + W <= n; i += W) storei(c + i, Op::vi(vs, loadi(b + i)));
+        }
+        for (; i < n; ++i) c[i] = Op::si(s, b[i]);
+    }
+
+    const BinaryKernels kKernels = {
+        { { vv_f32<Add>, vv_f32<Sub>, vv_f32<Mul>, vv_f32<Div> },
+          { vs_f32<Add>, vs_f32<Sub>, vs_f32<Mul>, vs_f32<Div> },
+          { sv_f32<Add>, sv_f32<Sub>, sv_f32<Mul>, sv_f32<Div> } },
+        { { vv_i32<Add>, vv_i32<Sub>, vv_i32<Mul>, vv_i32<Div> },
+          { vs_i32<Add>, vs_i32<Sub>, vs_i32<Mul>, vs_i32<Div> },
+          { sv_i32<Add>, sv_i32<Sub>, sv_i32<Mul>, sv_i32<Div> } },
+    };
+}
+
+const BinaryKernels& binary_kernels_sse2() { return kKernels; }
+
+} // namespace kernels
+} // namespace napcas
+
+#else
+
+namespace napcas {
+namespace kernels {
+// Architecture sans SSE2 : le dispatch retombe sur les boucles scalaires
+const BinaryKernels& binary_kernels_sse2() { return binary_kernels_scalar(); }
+} // namespace kernels
+} // namespace napcas
+
+#endif
@@ -0,0 +1,222 @@
+// cpp/src/kernels/fused.cpp
+
+#include "napcas/kernels/fused.h"
+#include "napcas/kernels/convert.h"
+#include "napcas/kernels/elementwise_isa.h"
+#include "napcas/dispatch.h"
+#include "napcas/parallel.h"
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+namespace napcas {
+namespace kernels {
+
+namespace {
+    // Éléments par bloc : quelques registres de ce type tiennent en L1
+    constexpr std::size_t kBlock = 512;
+
+    // Géométrie commune à la sortie (dense) et à tous les opérandes
+    struct Geometry {
+        Shape shape;
+        std::vector<Strides> strides;   // [opérande][dim]
+
+        std::size_t inner() const { return shape.empty() ? 1 : shape.back(); }
+        std::ptrdiff_t inner_stride(std::size_t k) const {
+            return shape.empty() ? 0 : strides[k].back();
+        }
+    };
+
+    Geometry coalesce_all(const FusedProgram& prog, const Shape& out_shape) {
+        const std::size_t n = prog.operands.size();
+        Geometry g;
+        g.strides.resize(n);
+        for (std::size_t d = 0; d < out_shape.size(); ++d) {
+            if (out_shape[d] == 1) continue;
+            bool merge = !g.shape.empty();
+            for (std::size_t k = 0; k < n && merge; ++k)
+                merge = g.strides[k].back() ==
+                        prog.operands[k].strides[d] * std::ptrdiff_t(out_shape[d]);
+            if (merge) {
+                g.shape.back() *= out_shape[d];
+                for (std::size_t k = 0; k < n; ++k)
+                    g.strides[k].back() = prog.operands[k].strides[d];
+                continue;
+            }
+            g.shape.push_back(out_shape[d]);
+            for (std::size_t k = 0; k < n; ++k)
+                g.strides[k].push_back(prog.operands[k].strides[d]);
+        }
+        return g;
+    }
+
+    template<typename C>
+    struct Reg {
+        const C* ptr    = nullptr;
+        C        scalar = C(0);
+        bool     is_scalar = false;
+    };
+
+    template<typename C>
+    void gather(C* dst, const void* src, DType dtype, std::ptrdiff_t stride, std::size_t n) {
+        if (stride == 1) {
+            convert(dst, dtype_of_v<C>, src, dtype, n);
+            return;
+        }
+        NAPCAS_DISPATCH_ALL_TYPES(dtype, "fused_eval", [&] {
+            const scalar_t* s = static_cast<const scalar_t*>(src);
+            for (std::size_t i = 0; i < n; ++i)
+                dst[i] = static_cast<C>(s[std::ptrdiff_t(i) * stride]);
+        });
+    }
+
+    template<typename C>
+    C load_scalar(const void* src, DType dtype) {
+        return NAPCAS_DISPATCH_ALL_TYPES(dtype, "fused_eval", [&] {
+            return static_cast<C>(*static_cast<const scalar_t*>(src));
+        });
+    }
+
+    template<typename C>
+    void run(const FusedProgram& prog, void* out, DType out_dtype,
+             const Shape& out_shape) {
+        const Geometry g = coalesce_all(prog, out_shape);
+        const std::size_t numel = [&] {
+            std::size_t n = 1;
+            for (auto s : g.shape) n *= s;
+            return n;
+        }();
+        if (numel == 0) return;
+
+        const std::size_t n_ops   = prog.operands.size();
+        const std::size_t n_const = prog.constants.size();
+        const std::size_t n_regs  = n_ops + n_const + prog.code.size();
+        const std::size_t inner   = g.inner();
+        const std::size_t outer   = g.shape.empty() ? 0 : g.shape.size() - 1;
+        const bool direct_out     = out_dtype == dtype_of_v<C>;
+        const auto& rows          = binary_row_kernels<C>();
+        const std::size_t out_es  = dtype_size(out_dtype);
+
+        std::size_t item_bytes = out_es;
+        for (const auto& op : prog.operands) item_bytes += dtype_size(op.dtype);
+
+        parallel_for(0, numel, grain_size(numel, item_bytes), [&](std::size_t begin, std::size_t end) {
+            // Un tampon par registre (les opérandes lus en place n'y touchent pas)
+            std::vector<C> buffers(n_regs * kBlock);
+            std::vector<Reg<C>> regs(n_regs);
+            for (std::size_t c = 0; c < n_const; ++c) {
+                regs[n_ops + c].is_scalar = true;
+                regs[n_ops + c].scalar    = static_cast<C>(prog.constants[c]);
+            }
+
+            // Position de départ : ligne, colonne et offsets de chaque opérande
+            std::size_t row = begin / inner, col = begin % inner;
+            Shape idx(outer, 0);
+            std::vector<std::ptrdiff_t> base(n_ops, 0);
+            {
+                std::size_t rem = row;
+                for (int d = int(outer) - 1; d >= 0; --d) {
+                    idx[d] = rem % g.shape[d];
+                    rem /= g.shape[d];
+                    for (std::size_t k = 0; k < n_ops; ++k)
+                        base[k] += std::ptrdiff_t(idx[d]) * g.strides[k][d];
+                }
+            }
+
+            std::size_t pos = begin;
+            while (pos < end) {
+                const std::size_t seg = std::min(inner - col, end - pos);
+                for (std::size_t j = 0; j < seg; j += kBlock) {
+                    const std::size_t len = std::min(kBlock, seg - j);
+                    const std::size_t c0  = col + j;
+
+                    for (std::size_t k = 0; k < n_ops; ++k) {
+                        const FusedOperand& op = prog.operands[k];
+                        const std::ptrdiff_t s = g.inner_stride(k);
+                        const char* p = static_cast<const char*>(op.data) +
+                            (base[k] + std::ptrdiff_t(c0) * s) * std::ptrdiff_t(dtype_size(op.dtype));
+                        Reg<C>& r = regs[k];
+                        if (s == 0) {
+                            r.is_scalar = true;
+                            r.scalar    = load_scalar<C>(p, op.dtype);
+                        } else if (s == 1 && op.dtype == dtype_of_v<C>) {
+                            r.ptr = reinterpret_cast<const C*>(p);
+                        } else {
+                            C* buf = buffers.data() + k * kBlock;
+                            gather(buf, p, op.dtype, s, len);
+                            r.ptr = buf;
+                        }
+                    }
+
+                    char* dst_bytes = static_cast<char*>(out) + (pos + j) * out_es;
+                    for (std::size_t i = 0; i < prog.code.size(); ++i) {
+                        const FusedInstr& ins = prog.code[i];
+                        const std::size_t ri  = n_ops + n_const + i;
+                        const Reg<C>& a = regs[std::size_t(ins.lhs)];
+                        const Reg<C>& b = regs[std::size_t(ins.rhs)];
+                        Reg<C>& r = regs[ri];
+                        const int op = int(ins.op);
+                        if (a.is_scalar && b.is_scalar) {
+                            r.is_scalar = true;
+                            rows.vs[op](&r.scalar, &a.scalar, b.scalar, 1);
+                            continue;
+                        }
+                        // La dernière instruction écrit directement dans la sortie
+                        C* dst = (direct_out && i + 1 == prog.code.size())
+                                     ? reinterpret_cast<C*>(dst_bytes)
+                                     : buffers.data() + ri * kBlock;
+                        if (a.is_scalar)      rows.sv[op](dst, a.scalar, b.ptr, len);
+                        else if (b.is_scalar) rows.vs[op](dst, a.ptr, b.scalar, len);
+                        else                  rows.vv[op](dst, a.ptr, b.ptr, len);
+                        r.is_scalar = false;
+                        r.ptr = dst;
+                    }
+
+                    const Reg<C>& res = regs[n_regs - 1];
+                    if (res.is_scalar) {
+                        C* tmp = buffers.data() + (n_regs - 1) * kBlock;
+                        std::fill(tmp, tmp + len, res.scalar);
+                        convert(dst_bytes, out_dtype, tmp, dtype_of_v<C>, len);
+                    } else if (res.ptr != reinterpret_cast<const C*>(dst_bytes)) {
+                        convert(dst_bytes, out_dtype, res.ptr, dtype_of_v<C>, len);
+                    }
+                }
+                pos += seg;
+                col = 0;
+                // Ligne suivante
+                for (int d = int(outer) - 1; d >= 0; --d) {
+                    if (++idx[d] < g.shape[d]) {
+                        for (std::size_t k = 0; k < n_ops; ++k) base[k] += g.strides[k][d];
+                        break;
+                    }
+                    for (std::size_t k = 0; k < n_ops; ++k)
+                        base[k] -= g.strides[k][d] * std::ptrdiff_t(g.shape[d] - 1);
+                    idx[d] = 0;
+                }
+            }
+        });
+    }
+}
+
+void fused_eval(const FusedProgram& prog, void* out, DType out_dtype,
+                const Shape& out_shape) {
+    for (const auto& op : prog.operands)
+        if (op.strides.size() != out_shape.size())
+            throw std::runtime_error("fused_eval: operand strides rank mismatch");
+    if (prog.operands.size() + prog.constants.size() + prog.code.size() == 0)
+        throw std::runtime_error("fused_eval: empty program");
+    switch (out_dtype) {
+        case DType::Float32:
+        case DType::Float16:
+        case DType::BFloat16: return run<float>(prog, out, out_dtype, out_shape);
+        case DType::Float64:  return run<double>(prog, out, out_dtype, out_shape);
+        case DType::Int8:     return run<std::int8_t>(prog, out, out_dtype, out_shape);
+        case DType::UInt8:    return run<std::uint8_t>(prog, out, out_dtype, out_shape);
+        case DType::Int32:    return run<std::int32_t>(prog, out, out_dtype, out_shape);
+        case DType::Int64:    return run<std::int64_t>(prog, out, out_dtype, out_shape);
+        default: throw_unsupported_dtype("fused_eval", out_dtype);
+    }
+}
+
+} // namespace kernels
+} // namespace napcas
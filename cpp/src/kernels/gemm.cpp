@@ -0,0 +1,310 @@
+// cpp/src/kernels/gemm.cpp
+
+#include "napcas/kernels/gemm.h"
+#include "napcas/kernels/gemm_isa.h"
+#include "napcas/allocator.h"
+#include "napcas/cpu.h"
+#include "napcas/parallel.h"
+#include <algorithm>
+#include <cstring>
+
+namespace napcas {
+namespace kernels {
+
+namespace {
+    // Blocs de cache : A (MC x KC) tient en L2, B (KC x NC) en L3
+    constexpr std::size_t KC = 256;
+    constexpr std::size_t MC = 120;      // multiple de 4, 6 et 8
+    constexpr std::size_t NC = 4096;     // multiple de 8, 16 et 32
+    constexpr std::size_t NG = 256;      // colonnes par tâche parallèle
+    // En dessous de ce volume (M*N*K), l'empaquetage coûte plus qu'il ne rapporte
+    constexpr std::size_t kSmallGemm = 32 * 32 * 32;
+    // Travail minimal (M*N*K) par tâche parallèle
+    constexpr std::size_t kParallelWork = 1 << 18;
+
+    constexpr std::size_t MR_SCALAR = 4;
+    constexpr std::size_t NR_SCALAR = 8;
+
+    void ukernel_scalar(std::size_t kc, const float* a, const float* b,
+                        float* c, std::ptrdiff_t ldc, bool accumulate) {
+        float acc[MR_SCALAR][NR_SCALAR] = {};
+        for (std::size_t p = 0; p < kc; ++p) {
+            for (std::size_t i = 0; i < MR_SCALAR; ++i) {
+                const float ai = a[i];
+                for (std::size_t j = 0; j < NR_SCALAR; ++j)
+                    acc[i][j] += ai * b[j];
+            }
+            a += MR_SCALAR;
+            b += NR_SCALAR;
+        }
+        for (std::size_t i = 0; i < MR_SCALAR; ++i) {
+            float* ci = c + std::ptrdiff_t(i) * ldc;
+            for (std::size_t j = 0; j < NR_SCALAR; ++j)
+                ci[j] = accumulate ? ci[j] + acc[i][j] : acc[i][j];
+        }
+    }
+
+    // Buffer d'empaquetage aligné sur 64 octets
+    struct PackBuffer {
+        float* data;
+        explicit PackBuffer(std::size_t n)
+            : data(static_cast<float*>(cpu_malloc(n * sizeof(float)))) {}
+        ~PackBuffer() { cpu_free(data); }
+        PackBuffer(const PackBuffer&) = delete;
+        PackBuffer& operator=(const PackBuffer&) = delete;
+    };
+
+    inline float at(const MatrixRef& m, std::size_t i, std::size_t j) {
+        return m.data[std::ptrdiff_t(i) * m.row_stride + std::ptrdiff_t(j) * m.col_stride];
+    }
+
+    // Panneaux de A : lignes [i0, i0+MR) x colonnes [pc, pc+kc), MR contigus
+    void pack_a(float* dst, const MatrixRef& A, std::size_t M,
+                std::size_t i0, std::size_t pc, std::size_t kc, std::size_t mr) {
+        const std::size_t rows = std::min(mr, M - i0);
+        for (std::size_t p = 0; p < kc; ++p) {
+            float* d = dst + p * mr;
+            for (std::size_t i = 0; i < rows; ++i) d[i] = at(A, i0 + i, pc + p);
+            for (std::size_t i = rows; i < mr; ++i) d[i] = 0.0f;
+        }
+    }
+
+    // Panneaux de B : lignes [pc, pc+kc) x colonnes [j0, j0+NR), NR contigus
+    void pack_b(float* dst, const MatrixRef& B, std::size_t N,
+                std::size_t pc, std::size_t kc, std::size_t j0, std::size_t nr) {
+        const std::size_t cols = std::min(nr, N - j0);
+        for (std::size_t p = 0; p < kc; ++p) {
+            float* d = dst + p * nr;
+            if (B.col_stride == 1) {
+                std::memcpy(d, B.data + std::ptrdiff_t(pc + p) * B.row_stride
+                                      + std::ptrdiff_t(j0), cols * sizeof(float));
+            } else {
+                for (std::size_t j = 0; j < cols; ++j) d[j] = at(B, pc + p, j0 + j);
+            }
+            for (std::size_t j = cols; j < nr; ++j) d[j] = 0.0f;
+        }
+    }
+
+    // Épilogue sur un segment de ligne de C commençant à la colonne j0 ;
+    // une boucle par activation, sans test dans la boucle interne
+    template<typename T>
+    void epilogue_row(const GemmEpilogue<T>& ep, T* c, std::size_t n, std::size_t j0) {
+        const T* bias = ep.bias ? ep.bias + j0 : nullptr;
+        auto run = [&](auto f) {
+            if (bias) { for (std::size_t j = 0; j < n; ++j) c[j] = f(c[j] + bias[j]); }
+            else      { for (std::size_t j = 0; j < n; ++j) c[j] = f(c[j]); }
+        };
+        switch (ep.act) {
+            case Activation::ReLU: return run([](T x) { return apply_activation(Activation::ReLU, x); });
+            case Activation::GELU: return run([](T x) { return apply_activation(Activation::GELU, x); });
+            case Activation::SiLU: return run([](T x) { return apply_activation(Activation::SiLU, x); });
+            case Activation::None: return run([](T x) { return x; });
+        }
+    }
+
+    // Petits produits : boucle i-p-j directe (ligne de B contiguë si possible)
+    void gemm_small(std::size_t M, std::size_t N, std::size_t K,
+                    const MatrixRef& A, const MatrixRef& B,
+                    float* C, std::ptrdiff_t ldc, bool accumulate,
+                    const GemmEpilogue<float>& ep) {
+        for (std::size_t i = 0; i < M; ++i) {
+            float* ci = C + std::ptrdiff_t(i) * ldc;
+            if (!accumulate) std::fill(ci, ci + N, 0.0f);
+            for (std::size_t p = 0; p < K; ++p) {
+                const float a = at(A, i, p);
+                const float* bp = B.data + std::ptrdiff_t(p) * B.row_stride;
+                if (B.col_stride == 1) {
+                    for (std::size_t j = 0; j < N; ++j) ci[j] += a * bp[j];
+                } else {
+                    for (std::size_t j = 0; j < N; ++j)
+                        ci[j] += a * bp[std::ptrdiff_t(j) * B.col_stride];
+                }
+            }
+            if (!ep.empty()) epilogue_row(ep, ci, N, 0);
+        }
+    }
+
+    // Une ligne de C en float64 : boucle p-j, ligne de B contiguë si possible
+    void gemm_row_f64(const double* a, std::ptrdiff_t a_col_stride, const MatrixRefF64& B,
+                      double* c, std::size_t N, std::size_t K, bool accumulate,
+                      const GemmEpilogue<double>& ep) {
+        if (!accumulate) std::fill(c, c + N, 0.0);
+        for (std::size_t p = 0; p < K; ++p) {
+            const double  ap   = a[std::ptrdiff_t(p) * a_col_stride];
+            const double* brow = B.data + std::ptrdiff_t(p) * B.row_stride;
+            if (B.col_stride == 1) {
+                for (std::size_t j = 0; j < N; ++j) c[j] += ap * brow[j];
+            } else {
+                for (std::size_t j = 0; j < N; ++j)
+                    c[j] += ap * brow[std::ptrdiff_t(j) * B.col_stride];
+            }
+        }
+        if (!ep.empty()) epilogue_row(ep, c, N, 0);
+    }
+
+    void gemm_blocked(std::size_t M, std::size_t N, std::size_t K,
+                      const MatrixRef& A, const MatrixRef& B,
+                      float* C, std::ptrdiff_t ldc, bool accumulate,
+                      const GemmEpilogue<float>& ep) {
+        const GemmMicroKernel uk = gemm_kernel();
+        const std::size_t mr = uk.mr, nr = uk.nr;
+        const std::size_t m_panels = (M + mr - 1) / mr;
+        PackBuffer a_pack(m_panels * mr * KC);
+        PackBuffer b_pack(((std::min(N, NC) + nr - 1) / nr) * nr * KC);
+
+        for (std::size_t jc = 0; jc < N; jc += NC) {
+            const std::size_t nc = std::min(NC, N - jc);
+            const std::size_t n_panels = (nc + nr - 1) / nr;
+            for (std::size_t pc = 0; pc < K; pc += KC) {
+                const std::size_t kc = std::min(KC, K - pc);
+                const bool acc = accumulate || pc > 0;
+                const bool last = pc + kc == K && !ep.empty();
+
+                parallel_for(0, n_panels, grain_size(n_panels, 2 * kc * nr * sizeof(float)),
+                    [&](std::size_t b, std::size_t e) {
+                        for (std::size_t jp = b; jp < e; ++jp)
+                            pack_b(b_pack.data + jp * nr * kc, B, N, pc, kc, jc + jp * nr, nr);
+                    });
+                parallel_for(0, m_panels, grain_size(m_panels, 2 * kc * mr * sizeof(float)),
+                    [&](std::size_t b, std::size_t e) {
+                        for (std::size_t ip = b; ip < e; ++ip)
+                            pack_a(a_pack.data + ip * mr * kc, A, M, ip * mr, pc, kc, mr);
+                    });
+
+                // Tâches : blocs MC de lignes x groupes NG de colonnes
+                const std::size_t m_blocks = (M + MC - 1) / MC;
+                const std::size_t n_groups = (nc + NG - 1) / NG;
+                const std::size_t units = m_blocks * n_groups;
+                const std::size_t work_per_unit = std::min(M, MC) * std::min(nc, NG) * kc;
+                const std::size_t grain = work_per_unit >= kParallelWork
+                    ? 1 : std::max<std::size_t>(1, kParallelWork / std::max<std::size_t>(1, work_per_unit));
+                parallel_for(0, units, grain, [&](std::size_t ub, std::size_t ue) {
+                    float tile[8 * 32];
+                    for (std::size_t u = ub; u < ue; ++u) {
+                        const std::size_t i_begin = (u / n_groups) * MC;
+                        const std::size_t i_end   = std::min(M, i_begin + MC);
+                        const std::size_t j_begin = (u % n_groups) * NG;
+                        const std::size_t j_end   = std::min(nc, j_begin + NG);
+                        for (std::size_t jr = j_begin; jr < j_end; jr += nr) {
+                            const std::size_t nr_eff = std::min(nr, nc - jr);
+                            const float* bp = b_pack.data + (jr / nr) * nr * kc;
+                            for (std::size_t ir = i_begin; ir < i_end; ir += mr) {
+                                const std::size_t mr_eff = std::min(mr, M - ir);
+                                const float* ap = a_pack.data + (ir / mr) * mr * kc;
+                                float* c = C + std::ptrdiff_t(ir) * ldc + std::ptrdiff_t(jc + jr);
+                                if (mr_eff == mr && nr_eff == nr) {
+                                    uk.fn(kc, ap, bp, c, ldc, acc);
+                                    if (last)
+                                        for (std::size_t i = 0; i < mr; ++i)
+                                            epilogue_row(ep, c + std::ptrdiff_t(i) * ldc, nr, jc + jr);
+                                    continue;
+                                }
+                                // Tuile de bord : calcul complet puis recopie partielle
+                                uk.fn(kc, ap, bp, tile, std::ptrdiff_t(nr), false);
+                                for (std::size_t i = 0; i < mr_eff; ++i) {
+                                    float* ci = c + std::ptrdiff_t(i) * ldc;
+                                    const float* ti = tile + i * nr;
+                                    for (std::size_t j = 0; j < nr_eff; ++j)
+                                        ci[j] = acc ? ci[j] + ti[j] : ti[j];
+                                    if (last) epilogue_row(ep, ci, nr_eff, jc + jr);
+                                }
+                            }
+                        }
+                    }
+                });
+            }
+        }
+    }
+}
+
+GemmMicroKernel gemm_kernel_scalar() {
+    return {MR_SCALAR, NR_SCALAR, ukernel_scalar};
+}
+
+GemmMicroKernel gemm_kernel() {
+    switch (cpu_capability()) {
+        case CpuCapability::AVX512: return gemm_kernel_avx512();
+        case CpuCapability::AVX2:   return gemm_kernel_avx2();
+        default:                    return gemm_kernel_scalar();
+    }
+}
+
+void gemm(std::size_t M, std::size_t N, std::size_t K,
+          MatrixRef A, MatrixRef B,
+          float* C, std::ptrdiff_t ldc, bool accumulate,
+          const GemmEpilogue<float>& epilogue) {
+    if (M == 0 || N == 0) return;
+    if (K == 0) {
+        for (std::size_t i = 0; i < M; ++i) {
+            float* ci = C + std::ptrdiff_t(i) * ldc;
+            if (!accumulate) std::fill(ci, ci + N, 0.0f);
+            if (!epilogue.empty()) epilogue_row(epilogue, ci, N, 0);
+        }
+        return;
+    }
+    if (M * N * K <= kSmallGemm) {
+        gemm_small(M, N, K, A, B, C, ldc, accumulate, epilogue);
+        return;
+    }
+    gemm_blocked(M, N, K, A, B, C, ldc, accumulate, epilogue);
+}
+
+void gemm_batched(std::size_t batch, std::size_t M, std::size_t N, std::size_t K,
+                  MatrixRef A, const std::ptrdiff_t* a_offsets,
+                  MatrixRef B, const std::ptrdiff_t* b_offsets,
+                  float* C, std::ptrdiff_t ldc, std::ptrdiff_t c_batch_stride,
+                  const GemmEpilogue<float>& epilogue) {
+    auto run = [&](std::size_t b) {
+        MatrixRef a = A, bm = B;
+        a.data  += a_offsets[b];
+        bm.data += b_offsets[b];
+        gemm(M, N, K, a, bm, C + std::ptrdiff_t(b) * c_batch_stride, ldc, false, epilogue);
+    };
+    // Beaucoup de lots : un lot par tâche (chaque GEMM reste série).
+    // Sinon les GEMM se suivent et se parallélisent en interne.
+    if (batch > 1 && batch >= get_num_threads()) {
+        const std::size_t work = std::max<std::size_t>(1, M * N * K);
+        const std::size_t grain = std::max<std::size_t>(1, kParallelWork / work);
+        parallel_for(0, batch, grain, [&](std::size_t b, std::size_t e) {
+            for (std::size_t i = b; i < e; ++i) run(i);
+        });
+    } else {
+        for (std::size_t i = 0; i < batch; ++i) run(i);
+    }
+}
+
+void gemm(std::size_t M, std::size_t N, std::size_t K,
+          MatrixRefF64 A, MatrixRefF64 B,
+          double* C, std::ptrdiff_t ldc, bool accumulate,
+          const GemmEpilogue<double>& epilogue) {
+    const std::size_t work = std::max<std::size_t>(1, N * K);
+    parallel_for(0, M, std::max<std::size_t>(1, kParallelWork / work),
+        [&](std::size_t begin, std::size_t end) {
+            for (std::size_t i = begin; i < end; ++i)
+                gemm_row_f64(A.data + std::ptrdiff_t(i) * A.row_stride, A.col_stride, B,
+                             C + std::ptrdiff_t(i) * ldc, N, K, accumulate, epilogue);
+        });
+}
+
+void gemm_batched(std::size_t batch, std::size_t M, std::size_t N, std::size_t K,
+                  MatrixRefF64 A, const std::ptrdiff_t* a_offsets,
+                  MatrixRefF64 B, const std::ptrdiff_t* b_offsets,
+                  double* C, std::ptrdiff_t ldc, std::ptrdiff_t c_batch_stride,
+                  const GemmEpilogue<double>& epilogue) {
+    const std::size_t rows = batch * M;
+    const std::size_t work = std::max<std::size_t>(1, N * K);
+    const std::size_t grain = std::max<std::size_t>(1, kParallelWork / work);
+    parallel_for(0, rows, grain, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t r = begin; r < end; ++r) {
+            const std::size_t b = r / M, i = r % M;
+            MatrixRefF64 bm = B;
+            bm.data += b_offsets[b];
+            gemm_row_f64(A.data + a_offsets[b] + std::ptrdiff_t(i) * A.row_stride, A.col_stride, bm,
+                         C + std::ptrdiff_t(b) * c_batch_stride + std::ptrdiff_t(i) * ldc,
+                         N, K, false, epilogue);
+        }
+    });
+}
+
+} // namespace kernels
+} // namespace napcas
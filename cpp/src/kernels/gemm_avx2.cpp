@@ -0,0 +1,59 @@
+// cpp/src/kernels/gemm_avx2.cpp
+//
+// Micro-noyau 6x16 AVX2/FMA : 12 accumulateurs YMM. Compilé avec
+// -mavx2 -mfma, tout reste dans un namespace anonyme.
+
+#include "napcas/kernels/gemm_isa.h"
+
+#if defined(__AVX2__) && defined(__FMA__)
+#include <immintrin.h>
+
+namespace napcas {
+namespace kernels {
+
+namespace {
+    constexpr std::size_t MR = 6;
+    constexpr std::size_t NR = 16;
+
+    void ukernel(std::size_t kc, const float* a, const float* b,
+                 float* c, std::ptrdiff_t ldc, bool accumulate) {
+        __m256 acc[MR][2];
+        for (std::size_t i = 0; i < MR; ++i)
+            acc[i][0] = acc[i][1] = _mm256_setzero_ps();
+        for (std::size_t p = 0; p < kc; ++p) {
+            const __m256 b0 = _mm256_loadu_ps(b);
+            const __m256 b1 = _mm256_loadu_ps(b + 8);
+            for (std::size_t i = 0; i < MR; ++i) {
+                const __m256 ai = _mm256_broadcast_ss(a + i);
+                acc[i][0] = _mm256_fmadd_ps(ai, b0, acc[i][0]);
+                acc[i][1] = _mm256_fmadd_ps(ai, b1, acc[i][1]);
+            }
+            a += MR;
+            b += NR;
+        }
+        for (std::size_t i = 0; i < MR; ++i) {
+            float* ci = c + std::ptrdiff_t(i) * ldc;
+            if (accumulate) {
+                acc[i][0] = _mm256_add_ps(acc[i][0], _mm256_loadu_ps(ci));
+                acc[i][1] = _mm256_add_ps(acc[i][1], _mm256_loadu_ps(ci + 8));
+            }
+            _mm256_storeu_ps(ci,     acc[i][0]);
+            _mm256_storeu_ps(ci + 8, acc[i][1]);
+        }
+    }
+}
+
+GemmMicroKernel gemm_kernel_avx2() { return {MR, NR, ukernel}; }
+
+} // namespace kernels
+} // namespace napcas
+
+#else
+
+namespace napcas {
+namespace kernels {
+GemmMicroKernel gemm_kernel_avx2() { return gemm_kernel_scalar(); }
+} // namespace kernels
+} // namespace napcas
+
+#endif
@@ -0,0 +1,59 @@
+// cpp/src/kernels/gemm_avx512.cpp
+//
+// Micro-noyau 8x32 AVX-512 : 16 accumulateurs ZMM. Compilé avec
+// -mavx512f, tout reste dans un namespace anonyme.
+
+#include "napcas/kernels/gemm_isa.h"
+
+#if defined(__AVX512F__)
+#include <immintrin.h>
+
+namespace napcas {
+namespace kernels {
+
+namespace {
+    constexpr std::size_t MR = 8;
+    constexpr std::size_t NR = 32;
+
+    void ukernel(std::size_t kc, const float* a, const float* b,
+                 float* c, std::ptrdiff_t ldc, bool accumulate) {
+        __m512 acc[MR][2];
+        for (std::size_t i = 0; i < MR; ++i)
+            acc[i][0] = acc[i][1] = _mm512_setzero_ps();
+        for (std::size_t p = 0; p < kc; ++p) {
+            const __m512 b0 = _mm512_loadu_ps(b);
+            const __m512 b1 = _mm512_loadu_ps(b + 16);
+            for (std::size_t i = 0; i < MR; ++i) {
+                const __m512 ai = _mm512_set1_ps(a[i]);
+                acc[i][0] = _mm512_fmadd_ps(ai, b0, acc[i][0]);
+                acc[i][1] = _mm512_fmadd_ps(ai, b1, acc[i][1]);
+            }
+            a += MR;
+            b += NR;
+        }
+        for (std::size_t i = 0; i < MR; ++i) {
+            float* ci = c + std::ptrdiff_t(i) * ldc;
+            if (accumulate) {
+                acc[i][0] = _mm512_add_ps(acc[i][0], _mm512_loadu_ps(ci));
+                acc[i][1] = _mm512_add_ps(acc[i][1], _mm512_loadu_ps(ci + 16));
+            }
+            _mm512_storeu_ps(ci,      acc[i][0]);
+            _mm512_storeu_ps(ci + 16, acc[i][1]);
+        }
+    }
+}
+
+GemmMicroKernel gemm_kernel_avx512() { return {MR, NR, ukernel}; }
+
+} // namespace kernels
+} // namespace napcas
+
+#else
+
+namespace napcas {
+namespace kernels {
+GemmMicroKernel gemm_kernel_avx512() { return gemm_kernel_avx2(); }
+} // namespace kernels
+} // namespace napcas
+
+#endif
@@ -0,0 +1,248 @@
+// cpp/src/kernels/normalization.cpp
+
+#include "napcas/kernels/normalization.h"
+#include "napcas/parallel.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+namespace napcas {
+namespace kernels {
+
+namespace {
+    // Bloc du maximum courant de softmax
+    constexpr std::size_t kSoftmaxBlock = 256;
+    // Au plus kMaxRowChunks blocs de lignes pour les gradients des poids
+    constexpr std::size_t kMaxRowChunks = 64;
+    constexpr std::size_t kMinChunkRows = 16;
+
+    void for_rows(std::size_t rows, std::size_t cols, std::size_t elem_size,
+                  const std::function<void(std::size_t, std::size_t)>& fn) {
+        parallel_for(0, rows, grain_size(rows, 4 * cols * elem_size), fn);
+    }
+
+    // Découpe des lignes qui ne dépend que de `rows` : les sommes partielles
+    // des gradients de poids sont donc fusionnées toujours dans le même ordre
+    template<typename C, typename F>
+    void for_row_chunks(std::size_t rows, std::size_t cols, std::size_t partials,
+                        std::vector<C>& acc, F&& fn) {
+        const std::size_t chunk_rows = std::max(kMinChunkRows, (rows + kMaxRowChunks - 1) / kMaxRowChunks);
+        const std::size_t chunks = (rows + chunk_rows - 1) / chunk_rows;
+        std::vector<C> part(chunks * partials * cols, C(0));
+        parallel_for(0, chunks, 1, [&](std::size_t b, std::size_t e) {
+            for (std::size_t c = b; c < e; ++c)
+                fn(part.data() + c * partials * cols, c * chunk_rows,
+                   std::min(rows, (c + 1) * chunk_rows));
+        });
+        acc.assign(partials * cols, C(0));
+        for (std::size_t c = 0; c < chunks; ++c)
+            for (std::size_t i = 0; i < partials * cols; ++i)
+                acc[i] += part[c * partials * cols + i];
+    }
+}
+
+template<typename T>
+void softmax(T* out, const T* in, std::size_t rows, std::size_t cols, bool log) {
+    using C = compute_type_t<T>;
+    for_rows(rows, cols, sizeof(T), [&](std::size_t rb, std::size_t re) {
+        for (std::size_t r = rb; r < re; ++r) {
+            const T* x = in + r * cols;
+            T*       y = out + r * cols;
+            // État (m, s) : s = Σ exp(x - m), m rehaussé bloc par bloc
+            C m = -std::numeric_limits<C>::infinity();
+            C s = C(0);
+            for (std::size_t b = 0; b < cols; b += kSoftmaxBlock) {
+                const std::size_t e = std::min(cols, b + kSoftmaxBlock);
+                C bm = -std::numeric_limits<C>::infinity();
+                for (std::size_t i = b; i < e; ++i) {
+                    const C v = C(x[i]);
+                    bm = (v > bm || v != v) ? v : bm;
+                }
+                if (bm != bm) { m = bm; continue; }     // NaN : toute la ligne
+                if (bm == -std::numeric_limits<C>::infinity()) continue;
+                const C nm = bm > m ? bm : m;
+                C bs = C(0);
+                for (std::size_t i = b; i < e; ++i) bs += std::exp(C(x[i]) - nm);
+                s = s * std::exp(m - nm) + bs;
+                m = nm;
+            }
+            if (log) {
+                const C lse = m + std::log(s);
+                for (std::size_t i = 0; i < cols; ++i) y[i] = T(C(x[i]) - lse);
+            } else {
+                const C inv = C(1) / s;
+                for (std::size_t i = 0; i < cols; ++i) y[i] = T(std::exp(C(x[i]) - m) * inv);
+            }
+        }
+    });
+}
+
+template<typename T>
+void softmax_backward(T* grad_in, const T* grad_out, const T* out,
+                      std::size_t rows, std::size_t cols, bool log) {
+    using C = compute_type_t<T>;
+    for_rows(rows, cols, sizeof(T), [&](std::size_t rb, std::size_t re) {
+        for (std::size_t r = rb; r < re; ++r) {
+            const T* dy = grad_out + r * cols;
+            const T* y  = out + r * cols;
+            T*       dx = grad_in + r * cols;
+            C acc = C(0);
+            if (log) {
+                for (std::size_t i = 0; i < cols; ++i) acc += C(dy[i]);
+                for (std::size_t i = 0; i < cols; ++i)
+                    dx[i] = T(C(dy[i]) - std::exp(C(y[i])) * acc);
+            } else {
+                for (std::size_t i = 0; i < cols; ++i) acc += C(dy[i]) * C(y[i]);
+                for (std::size_t i = 0; i < cols; ++i)
+                    dx[i] = T(C(y[i]) * (C(dy[i]) - acc));
+            }
+        }
+    });
+}
+
+template<typename T>
+void layer_norm(T* out, compute_type_t<T>* mean, compute_type_t<T>* rstd,
+                const T* in, const T* weight, const T* bias,
+                std::size_t rows, std::size_t cols, double eps) {
+    using C = compute_type_t<T>;
+    for_rows(rows, cols, sizeof(T), [&](std::size_t rb, std::size_t re) {
+        for (std::size_t r = rb; r < re; ++r) {
+            const T* x = in + r * cols;
+            T*       y = out + r * cols;
+            C sum = C(0);
+            for (std::size_t i = 0; i < cols; ++i) sum += C(x[i]);
+            const C mu = sum / C(cols);
+            C sq = C(0);
+            for (std::size_t i = 0; i < cols; ++i) {
+                const C d = C(x[i]) - mu;
+                sq += d * d;
+            }
+            const C rs = C(1) / std::sqrt(sq / C(cols) + C(eps));
+            mean[r] = mu;
+            rstd[r] = rs;
+            for (std::size_t i = 0; i < cols; ++i) {
+                C v = (C(x[i]) - mu) * rs;
+                if (weight) v *= C(weight[i]);
+                if (bias)   v += C(bias[i]);
+                y[i] = T(v);
+            }
+        }
+    });
+}
+
+// xhat = (x - moyenne)·rstd, ĝ = dy·weight :
+// dx = rstd·(ĝ - moyenne(ĝ) - xhat·moyenne(ĝ·xhat)), dweight = Σ dy·xhat, dbias = Σ dy
+template<typename T>
+void layer_norm_backward(T* grad_in, T* grad_weight, T* grad_bias,
+                         const T* grad_out, const T* in, const T* weight,
+                         const compute_type_t<T>* mean, const compute_type_t<T>* rstd,
+                         std::size_t rows, std::size_t cols) {
+    using C = compute_type_t<T>;
+    std::vector<C> acc;
+    for_row_chunks<C>(rows, cols, 2, acc, [&](C* part, std::size_t rb, std::size_t re) {
+        C* dw = part;
+        C* db = part + cols;
+        for (std::size_t r = rb; r < re; ++r) {
+            const T* x  = in + r * cols;
+            const T* dy = grad_out + r * cols;
+            T*       dx = grad_in + r * cols;
+            const C mu = mean[r], rs = rstd[r];
+            C s1 = C(0), s2 = C(0);
+            for (std::size_t i = 0; i < cols; ++i) {
+                const C xhat = (C(x[i]) - mu) * rs;
+                const C g    = weight ? C(dy[i]) * C(weight[i]) : C(dy[i]);
+                s1 += g;
+                s2 += g * xhat;
+                dw[i] += C(dy[i]) * xhat;
+                db[i] += C(dy[i]);
+            }
+            s1 /= C(cols);
+            s2 /= C(cols);
+            for (std::size_t i = 0; i < cols; ++i) {
+                const C xhat = (C(x[i]) - mu) * rs;
+                const C g    = weight ? C(dy[i]) * C(weight[i]) : C(dy[i]);
+                dx[i] = T(rs * (g - s1 - xhat * s2));
+            }
+        }
+    });
+    for (std::size_t i = 0; i < cols; ++i) {
+        if (grad_weight) grad_weight[i] = T(acc[i]);
+        if (grad_bias)   grad_bias[i]   = T(acc[cols + i]);
+    }
+}
+
+template<typename T>
+void rms_norm(T* out, compute_type_t<T>* rstd, const T* in, const T* weight,
+              std::size_t rows, std::size_t cols, double eps) {
+    using C = compute_type_t<T>;
+    for_rows(rows, cols, sizeof(T), [&](std::size_t rb, std::size_t re) {
+        for (std::size_t r = rb; r < re; ++r) {
+            const T* x = in + r * cols;
+            T*       y = out + r * cols;
+            C sq = C(0);
+            for (std::size_t i = 0; i < cols; ++i) sq += C(x[i]) * C(x[i]);
+            const C rs = C(1) / std::sqrt(sq / C(cols) + C(eps));
+            rstd[r] = rs;
+            for (std::size_t i = 0; i < cols; ++i)
+                y[i] = T(weight ? C(x[i]) * rs * C(weight[i]) : C(x[i]) * rs);
+        }
+    });
+}
+
+// ĝ = dy·weight : dx = rstd·ĝ - x·rstd³·moyenne(ĝ·x), dweight = Σ dy·x·rstd
+template<typename T>
+void rms_norm_backward(T* grad_in, T* grad_weight, const T* grad_out,
+                       const T* in, const T* weight, const compute_type_t<T>* rstd,
+                       std::size_t rows, std::size_t cols) {
+    using C = compute_type_t<T>;
+    std::vector<C> acc;
+    for_row_chunks<C>(rows, cols, 1, acc, [&](C* dw, std::size_t rb, std::size_t re) {
+        for (std::size_t r = rb; r < re; ++r) {
+            const T* x  = in + r * cols;
+            const T* dy = grad_out + r * cols;
+            T*       dx = grad_in + r * cols;
+            const C rs = rstd[r];
+            C dot = C(0);
+            for (std::size_t i = 0; i < cols; ++i) {
+                const C g = weight ? C(dy[i]) * C(weight[i]) : C(dy[i]);
+                dot += g * C(x[i]);
+                dw[i] += C(dy[i]) * C(x[i]) * rs;
+            }
+            const C k = rs * rs * rs * dot / C(cols);
+            for (std::size_t i = 0; i < cols; ++i) {
+                const C g = weight ? C(dy[i]) * C(weight[i]) : C(dy[i]);
+                dx[i] = T(rs * g - C(x[i]) * k);
+            }
+        }
+    });
+    if (grad_weight)
+        for (std::size_t i = 0; i < cols; ++i) grad_weight[i] = T(acc[i]);
+}
+
+#define NAPCAS_INSTANTIATE_NORMALIZATION(T)                                     \
+    template void softmax<T>(T*, const T*, std::size_t, std::size_t, bool);    \
+    template void softmax_backward<T>(T*, const T*, const T*, std::size_t,     \
+                                      std::size_t, bool);                      \
+    template void layer_norm<T>(T*, compute_type_t<T>*, compute_type_t<T>*,    \
+                                const T*, const T*, const T*, std::size_t,     \
+                                std::size_t, double);                          \
+    template void layer_norm_backward<T>(T*, T*, T*, const T*, const T*,       \
+                                         const T*, const compute_type_t<T>*,   \
+                                         const compute_type_t<T>*,             \
+                                         std::size_t, std::size_t);            \
+    template void rms_norm<T>(T*, compute_type_t<T>*, const T*, const T*,      \
+                              std::size_t, std::size_t, double);               \
+    template void rms_norm_backward<T>(T*, T*, const T*, const T*, const T*,   \
+                                       const compute_type_t<T>*,               \
+                                       std::size_t, std::size_t);
+
+NAPCAS_INSTANTIATE_NORMALIZATION(float)
+NAPCAS_INSTANTIATE_NORMALIZATION(double)
+NAPCAS_INSTANTIATE_NORMALIZATION(Half)
+NAPCAS_INSTANTIATE_NORMALIZATION(BFloat16)
+
+#undef NAPCAS_INSTANTIATE_NORMALIZATION
+
+} // namespace kernels
+} // namespace napcas
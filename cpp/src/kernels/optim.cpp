@@ -0,0 +1,77 @@
+// cpp/src/kernels/optim.cpp
+
+#include "napcas/kernels/optim.h"
+#include "napcas/kernels/optim_isa.h"
+#include "napcas/cpu.h"
+#include <cmath>
+
+namespace napcas {
+namespace kernels {
+
+namespace {
+    void sgd_scalar(float* p, const float* g, float* buf, std::size_t n, const SgdStep& s) {
+        if (s.momentum == 0.0f) {
+            for (std::size_t i = 0; i < n; ++i)
+                p[i] -= s.lr * (s.grad_scale * g[i] + s.weight_decay * p[i]);
+            return;
+        }
+        for (std::size_t i = 0; i < n; ++i) {
+            const float gi = s.grad_scale * g[i] + s.weight_decay * p[i];
+            const float b  = s.momentum * buf[i] + gi;
+            buf[i] = b;
+            p[i] -= s.lr * (s.nesterov ? gi + s.momentum * b : b);
+        }
+    }
+
+    void adam_scalar(float* p, const float* g, float* m, float* v, std::size_t n,
+                     const AdamStep& s) {
+        const float c1 = 1.0f - s.beta1, c2 = 1.0f - s.beta2;
+        for (std::size_t i = 0; i < n; ++i) {
+            const float gi = s.grad_scale * g[i] + s.l2 * p[i];
+            const float mi = s.beta1 * m[i] + c1 * gi;
+            const float vi = s.beta2 * v[i] + c2 * gi * gi;
+            m[i] = mi;
+            v[i] = vi;
+            p[i] = s.decay * p[i] - s.step_size * mi / (std::sqrt(vi) * s.inv_sqrt_bc2 + s.eps);
+        }
+    }
+
+    double sum_squares_scalar(const float* x, std::size_t n) {
+        // Huit accumulateurs, comme une voie AVX2 : même ordre de sommation
+        float acc[8] = {};
+        std::size_t i = 0;
+        for (; i + 8 <= n; i += 8)
+            for (int j = 0; j < 8; ++j) acc[j] += x[i + j] * x[i + j];
+        double total = 0.0;
+        for (float a : acc) total += a;
+        for (; i < n; ++i) total += double(x[i]) * x[i];
+        return total;
+    }
+
+    const OptimKernels kScalarKernels = { sgd_scalar, adam_scalar, sum_squares_scalar };
+}
+
+const OptimKernels& optim_kernels_scalar() { return kScalarKernels; }
+
+const OptimKernels& optim_kernels() {
+    switch (cpu_capability()) {
+        case CpuCapability::AVX512: return optim_kernels_avx512();
+        case CpuCapability::AVX2:   return optim_kernels_avx2();
+        default:                    return optim_kernels_scalar();
+    }
+}
+
+void sgd_update(float* p, const float* g, float* momentum_buf, std::size_t n, const SgdStep& s) {
+    optim_kernels().sgd(p, g, momentum_buf, n, s);
+}
+
+void adam_update(float* p, const float* g, float* m, float* v, std::size_t n, const AdamStep& s) {
+    optim_kernels().adam(p, g, m, v, n, s);
+}
+
+double sum_squares(const float* x, std::size_t n) {
+    return optim_kernels().sum_squares(x, n);
+}
+
+} // namespace kernels
+} // namespace napcas
@@ -0,0 +1,114 @@
+// cpp/src/kernels/optim_avx2.cpp
+//
+// Compilé avec -mavx2 -mfma (voir napcas_simd.cmake).
+
+#include "napcas/kernels/optim_isa.h"
+
+#if defined(__AVX2__)
+#include <cmath>
+#include <immintrin.h>
+
+namespace napcas {
+namespace kernels {
+
+namespace {
+    using V = __m256;
+    constexpr std::size_t W = 8;
+
+    void sgd_avx2(float* p, const float* g, float* buf, std::size_t n, const SgdStep& s) {
+        const V lr = _mm256_set1_ps(s.lr), wd = _mm256_set1_ps(s.weight_decay);
+        const V gs = _mm256_set1_ps(s.grad_scale), mu = _mm256_set1_ps(s.momentum);
+        const bool momentum = s.momentum != 0.0f;
+        std::size_t i = 0;
+        for (; i + W <= n; i += W) {
+            V pi = _mm256_loadu_ps(p + i);
+            V gi = _mm256_fmadd_ps(gs, _mm256_loadu_ps(g + i), _mm256_mul_ps(wd, pi));
+            if (momentum) {
+                const V b = _mm256_fmadd_ps(mu, _mm256_loadu_ps(buf + i), gi);
+                _mm256_storeu_ps(buf + i, b);
+                gi = s.nesterov ? _mm256_fmadd_ps(mu, b, gi) : b;
+            }
+            _mm256_storeu_ps(p + i, _mm256_fnmadd_ps(lr, gi, pi));
+        }
+        for (; i < n; ++i) {
+            float gi = s.grad_scale * g[i] + s.weight_decay * p[i];
+            if (momentum) {
+                const float b = s.momentum * buf[i] + gi;
+                buf[i] = b;
+                gi = s.nesterov ? gi + s.momentum * b : b;
+            }
+            p[i] -= s.lr * gi;
+        }
+    }
+
+    void adam_avx2(float* p, const float* g, float* m, float* v, std::size_t n, const AdamStep& s) {
+        const V b1 = _mm256_set1_ps(s.beta1), c1 = _mm256_set1_ps(1.0f - s.beta1);
+        const V b2 = _mm256_set1_ps(s.beta2), c2 = _mm256_set1_ps(1.0f - s.beta2);
+        const V eps = _mm256_set1_ps(s.eps), step = _mm256_set1_ps(s.step_size);
+        const V bc2 = _mm256_set1_ps(s.inv_sqrt_bc2), l2 = _mm256_set1_ps(s.l2);
+        const V decay = _mm256_set1_ps(s.decay), gs = _mm256_set1_ps(s.grad_scale);
+        std::size_t i = 0;
+        for (; i + W <= n; i += W) {
+            const V pi = _mm256_loadu_ps(p + i);
+            const V gi = _mm256_fmadd_ps(gs, _mm256_loadu_ps(g + i), _mm256_mul_ps(l2, pi));
+            const V mi = _mm256_fmadd_ps(b1, _mm256_loadu_ps(m + i), _mm256_mul_ps(c1, gi));
+            const V vi = _mm256_fmadd_ps(b2, _mm256_loadu_ps(v + i),
+                                         _mm256_mul_ps(c2, _mm256_mul_ps(gi, gi)));
+            _mm256_storeu_ps(m + i, mi);
+            _mm256_storeu_ps(v + i, vi);
+            const V den = _mm256_fmadd_ps(_mm256_sqrt_ps(vi), bc2, eps);
+            const V upd = _mm256_div_ps(_mm256_mul_ps(step, mi), den);
+            _mm256_storeu_ps(p + i, _mm256_fmsub_ps(decay, pi, upd));
+        }
+        for (; i < n; ++i) {
+            const float gi = s.grad_scale * g[i] + s.l2 * p[i];
+            const float mi = s.beta1 * m[i] + (1.0f - s.beta1) * gi;
+            const float vi = s.beta2 * v[i] + (1.0f - s.beta2) * gi * gi;
+            m[i] = mi;
+            v[i] = vi;
+            p[i] = s.decay * p[i] - s.step_size * mi / (std::sqrt(vi) * s.inv_sqrt_bc2 + s.eps);
+        }
+    }
+
+    double sum_squares_avx2(const float* x, std::size_t n) {
+        V a0 = _mm256_setzero_ps(), a1 = _mm256_setzero_ps();
+        V a2 = _mm256_setzero_ps(), a3 = _mm256_setzero_ps();
+        std::size_t i = 0;
+        for (; i + 4 * W <= n; i += 4 * W) {
+            const V x0 = _mm256_loadu_ps(x + i),         x1 = _mm256_loadu_ps(x + i + W);
+            const V x2 = _mm256_loadu_ps(x + i + 2 * W), x3 = _mm256_loadu_ps(x + i + 3 * W);
+            a0 = _mm256_fmadd_ps(x0, x0, a0);
+            a1 = _mm256_fmadd_ps(x1, x1, a1);
+            a2 = _mm256_fmadd_ps(x2, x2, a2);
+            a3 = _mm256_fmadd_ps(x3, x3, a3);
+        }
+        for (; i + W <= n; i += W) {
+            const V x0 = _mm256_loadu_ps(x + i);
+            a0 = _mm256_fmadd_ps(x0, x0, a0);
+        }
+        alignas(32) float lanes[W];
+        _mm256_store_ps(lanes, _mm256_add_ps(_mm256_add_ps(a0, a1), _mm256_add_ps(a2, a3)));
+        double total = 0.0;
+        for (float l : lanes) total += l;
+        for (; i < n; ++i) total += double(x[i]) * x[i];
+        return total;
+    }
+
+    const OptimKernels kKernels = { sgd_avx2, adam_avx2, sum_squares_avx2 };
+}
+
+const OptimKernels& optim_kernels_avx2() { return kKernels; }
+
+} // namespace kernels
+} // namespace napcas
+
+#else
+
+namespace napcas {
+namespace kernels {
+// Compilateur sans support AVX2 : version portable
+const OptimKernels& optim_kernels_avx2() { return optim_kernels_scalar(); }
+} // namespace kernels
+} // namespace napcas
+
+#endif
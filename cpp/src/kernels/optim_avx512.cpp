@@ -0,0 +1,100 @@
+// cpp/src/kernels/optim_avx512.cpp
+//
+// Compilé avec -mavx512f (voir napcas_simd.cmake). Les fins de lignes sont
+// traitées par masque : aucune boucle scalaire.
+
+#include "napcas/kernels/optim_isa.h"
+
+#if defined(__AVX512F__)
+#include <immintrin.h>
+
+namespace napcas {
+namespace kernels {
+
+namespace {
+    using V = __m512;
+    constexpr std::size_t W = 16;
+
+    inline __mmask16 tail_mask(std::size_t len) {
+        return len >= W ? __mmask16(0xFFFF) : __mmask16((1u << len) - 1);
+    }
+
+    void sgd_avx512(float* p, const float* g, float* buf, std::size_t n, const SgdStep& s) {
+        const V lr = _mm512_set1_ps(s.lr), wd = _mm512_set1_ps(s.weight_decay);
+        const V gs = _mm512_set1_ps(s.grad_scale), mu = _mm512_set1_ps(s.momentum);
+        const bool momentum = s.momentum != 0.0f;
+        for (std::size_t i = 0; i < n; i += W) {
+            const __mmask16 k = tail_mask(n - i);
+            const V pi = _mm512_maskz_loadu_ps(k, p + i);
+            V gi = _mm512_fmadd_ps(gs, _mm512_maskz_loadu_ps(k, g + i), _mm512_mul_ps(wd, pi));
+            if (momentum) {
+                const V b = _mm512_fmadd_ps(mu, _mm512_maskz_loadu_ps(k, buf + i), gi);
+                _mm512_mask_storeu_ps(buf + i, k, b);
+                gi = s.nesterov ? _mm512_fmadd_ps(mu, b, gi) : b;
+            }
+            _mm512_mask_storeu_ps(p + i, k, _mm512_fnmadd_ps(lr, gi, pi));
+        }
+    }
+
+    void adam_avx512(float* p, const float* g, float* m, float* v, std::size_t n, const AdamStep& s) {
+        const V b1 = _mm512_set1_ps(s.beta1), c1 = _mm512_set1_ps(1.0f - s.beta1);
+        const V b2 = _mm512_set1_ps(s.beta2), c2 = _mm512_set1_ps(1.0f - s.beta2);
+        const V eps = _mm512_set1_ps(s.eps), step = _mm512_set1_ps(s.step_size);
+        const V bc2 = _mm512_set1_ps(s.inv_sqrt_bc2), l2 = _mm512_set1_ps(s.l2);
+        const V decay = _mm512_set1_ps(s.decay), gs = _mm512_set1_ps(s.grad_scale);
+        for (std::size_t i = 0; i < n; i += W) {
+            const __mmask16 k = tail_mask(n - i);
+            const V pi = _mm512_maskz_loadu_ps(k, p + i);
+            const V gi = _mm512_fmadd_ps(gs, _mm512_maskz_loadu_ps(k, g + i), _mm512_mul_ps(l2, pi));
+            const V mi = _mm512_fmadd_ps(b1, _mm512_maskz_loadu_ps(k, m + i), _mm512_mul_ps(c1, gi));
+            const V vi = _mm512_fmadd_ps(b2, _mm512_maskz_loadu_ps(k, v + i),
+                                         _mm512_mul_ps(c2, _mm512_mul_ps(gi, gi)));
+            _mm512_mask_storeu_ps(m + i, k, mi);
+            _mm512_mask_storeu_ps(v + i, k, vi);
+            const V den = _mm512_fmadd_ps(_mm512_sqrt_ps(vi), bc2, eps);
+            const V upd = _mm512_div_ps(_mm512_mul_ps(step, mi), den);
+            _mm512_mask_storeu_ps(p + i, k, _mm512_fmsub_ps(decay, pi, upd));
+        }
+    }
+
+    double sum_squares_avx512(const float* x, std::size_t n) {
+        V a0 = _mm512_setzero_ps(), a1 = _mm512_setzero_ps();
+        std::size_t i = 0;
+        for (; i + 2 * W <= n; i += 2 * W) {
+            const V x0 = _mm512_loadu_ps(x + i), x1 = _mm512_loadu_ps(x + i + W);
+            a0 = _mm512_fmadd_ps(x0, x0, a0);
+            a1 = _mm512_fmadd_ps(x1, x1, a1);
+        }
+        if (i < n) {
+            const V x0 = _mm512_maskz_loadu_ps(tail_mask(n - i), x + i);
+            a0 = _mm512_fmadd_ps(x0, x0, a0);
+            if (n - i > W) {
+                const V x1 = _mm512_maskz_loadu_ps(tail_mask(n - i - W), x + i + W);
+                a1 = _mm512_fmadd_ps(x1, x1, a1);
+            }
+        }
+        alignas(64) float lanes[W];
+        _mm512_store_ps(lanes, _mm512_add_ps(a0, a1));
+        double total = 0.0;
+        for (float l : lanes) total += l;
+        return total;
+    }
+
+    const OptimKernels kKernels = { sgd_avx512, adam_avx512, sum_squares_avx512 };
+}
+
+const OptimKernels& optim_kernels_avx512() { return kKernels; }
+
+} // namespace kernels
+} // namespace napcas
+
+#else
+
+namespace napcas {
+namespace kernels {
+// Compilateur sans support AVX-512 : le dispatch retombe sur AVX2
+const OptimKernels& optim_kernels_avx512() { return optim_kernels_avx2(); }
+} // namespace kernels
+} // namespace napcas
+
+#endif
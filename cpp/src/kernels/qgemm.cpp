@@ -0,0 +1,244 @@
+// cpp/src/kernels/qgemm.cpp
+
+#include "napcas/kernels/qgemm.h"
+#include "napcas/kernels/qgemm_isa.h"
+#include "napcas/allocator.h"
+#include "napcas/cpu.h"
+#include "napcas/parallel.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace napcas {
+namespace kernels {
+
+namespace {
+    constexpr std::size_t NR = kQGemmNR;
+    constexpr std::size_t MC = 96;       // lignes par tâche, multiple de 4 et 8
+    constexpr std::size_t NG = 4 * NR;   // colonnes par tâche parallèle
+    constexpr std::size_t kMaxMR = 16;   // taille de la tuile int32 locale
+    // Travail minimal (M*N*K) par tâche parallèle
+    constexpr std::size_t kParallelWork = 1 << 18;
+
+    constexpr std::size_t MR_SCALAR = 4;
+
+    void ukernel_scalar(std::size_t rows, std::size_t kg, const std::uint8_t* a,
+                        std::ptrdiff_t lda, const std::int8_t* b, std::int32_t* c) {
+        std::int32_t acc[MR_SCALAR][NR] = {};
+        for (std::size_t g = 0; g < kg; ++g) {
+            const std::int8_t* bg = b + g * NR * 4;
+            for (std::size_t i = 0; i < rows; ++i) {
+                const std::uint8_t* ai = a + std::ptrdiff_t(i) * lda + g * 4;
+                for (std::size_t j = 0; j < NR; ++j) {
+                    const std::int8_t* bj = bg + j * 4;
+                    acc[i][j] += ai[0] * bj[0] + ai[1] * bj[1] + ai[2] * bj[2] + ai[3] * bj[3];
+                }
+            }
+        }
+        for (std::size_t i = 0; i < rows; ++i)
+            std::copy(acc[i], acc[i] + NR, c + i * NR);
+    }
+
+    // Buffer d'octets aligné sur 64 octets
+    struct ByteBuffer {
+        std::uint8_t* data;
+        explicit ByteBuffer(std::size_t n)
+            : data(static_cast<std::uint8_t*>(cpu_malloc(std::max<std::size_t>(n, 1)))) {}
+        ~ByteBuffer() { cpu_free(data); }
+        ByteBuffer(const ByteBuffer&) = delete;
+        ByteBuffer& operator=(const ByteBuffer&) = delete;
+    };
+
+    inline float at(const MatrixRef& m, std::size_t i, std::size_t j) {
+        return m.data[std::ptrdiff_t(i) * m.row_stride + std::ptrdiff_t(j) * m.col_stride];
+    }
+
+    // fn(k, A[i, k]) pour k < K ; boucle sur pointeur si la ligne est contiguë
+    template<typename F>
+    void for_row(const MatrixRef& A, std::size_t i, std::size_t K, F&& fn) {
+        const float* row = A.data + std::ptrdiff_t(i) * A.row_stride;
+        if (A.col_stride == 1) {
+            for (std::size_t k = 0; k < K; ++k) fn(k, row[k]);
+        } else {
+            for (std::size_t k = 0; k < K; ++k) fn(k, row[std::ptrdiff_t(k) * A.col_stride]);
+        }
+    }
+
+    // Intervalle [min, max] de A étendu à 0 : min/max par ligne en
+    // parallèle, puis réduction série (résultat indépendant du découpage)
+    ActivationQuant choose_activation_quant(std::size_t M, std::size_t K, const MatrixRef& A,
+                                            std::int32_t qmax) {
+        std::vector<float> lo(M, 0.0f), hi(M, 0.0f);
+        parallel_for(0, M, grain_size(M, K * sizeof(float)), [&](std::size_t b, std::size_t e) {
+            for (std::size_t i = b; i < e; ++i) {
+                float l = 0.0f, h = 0.0f;
+                for_row(A, i, K, [&](std::size_t, float x) {
+                    l = std::min(l, x);
+                    h = std::max(h, x);
+                });
+                lo[i] = l;
+                hi[i] = h;
+            }
+        });
+        const float l = *std::min_element(lo.begin(), lo.end());
+        const float h = *std::max_element(hi.begin(), hi.end());
+        if (!std::isfinite(l) || !std::isfinite(h))
+            throw std::runtime_error("qgemm: activations must be finite");
+
+        ActivationQuant q;
+        q.qmax = qmax;
+        if (h > l) {
+            q.scale = (h - l) / float(qmax);
+            q.zero_point = std::int32_t(std::clamp(std::nearbyint(-l / q.scale), 0.0f, float(qmax)));
+        }
+        return q;
+    }
+
+    // Lignes de A quantifiées, complétées à Kp par des zéros (les poids y
+    // sont nuls). Arrondi au plus proche par troncature de x + 0.5 après
+    // saturation (valeur positive) : pas d'appel à nearbyint par élément.
+    void quantize_activations(std::uint8_t* dst, std::size_t M, std::size_t K, std::size_t Kp,
+                              const MatrixRef& A, const ActivationQuant& q) {
+        const float inv = 1.0f / q.scale;
+        const float zp = float(q.zero_point), qmax = float(q.qmax);
+        parallel_for(0, M, grain_size(M, K * sizeof(float)), [&](std::size_t b, std::size_t e) {
+            for (std::size_t i = b; i < e; ++i) {
+                std::uint8_t* d = dst + i * Kp;
+                for_row(A, i, K, [&](std::size_t k, float x) {
+                    d[k] = std::uint8_t(std::clamp(x * inv + zp, 0.0f, qmax) + 0.5f);
+                });
+                std::fill(d + K, d + Kp, std::uint8_t(0));
+            }
+        });
+    }
+
+    // Épilogue fusionné sur un segment de ligne : déquantification, biais et
+    // activation en une passe ; une boucle par activation
+    void dequant_row(const GemmEpilogue<float>& ep, float* c, const std::int32_t* acc,
+                     const float* scale, const std::int64_t* offset, std::size_t n,
+                     std::size_t j0) {
+        const float* bias = ep.bias ? ep.bias + j0 : nullptr;
+        auto run = [&](auto f) {
+            for (std::size_t j = 0; j < n; ++j) {
+                const float y = scale[j] * float(std::int64_t(acc[j]) - offset[j]);
+                c[j] = f(bias ? y + bias[j] : y);
+            }
+        };
+        switch (ep.act) {
+            case Activation::ReLU: return run([](float x) { return apply_activation(Activation::ReLU, x); });
+            case Activation::GELU: return run([](float x) { return apply_activation(Activation::GELU, x); });
+            case Activation::SiLU: return run([](float x) { return apply_activation(Activation::SiLU, x); });
+            case Activation::None: return run([](float x) { return x; });
+        }
+    }
+}
+
+QuantizedWeight quantize_weight(std::size_t N, std::size_t K, MatrixRef W) {
+    if (K > kQGemmMaxK) throw std::runtime_error("quantize_weight: in_features too large for int32 accumulation");
+    QuantizedWeight q;
+    q.N = N;
+    q.K = K;
+    q.Kp = (K + 3) / 4 * 4;
+    const std::size_t panels = (N + NR - 1) / NR;
+    q.packed.assign(panels * NR * q.Kp, 0);
+    q.scales.assign(N, 0.0f);
+    q.col_sums.assign(N, 0);
+
+    parallel_for(0, N, grain_size(N, K * sizeof(float)), [&](std::size_t b, std::size_t e) {
+        for (std::size_t n = b; n < e; ++n) {
+            float amax = 0.0f;
+            for (std::size_t k = 0; k < K; ++k) amax = std::max(amax, std::fabs(at(W, n, k)));
+            if (!std::isfinite(amax)) throw std::runtime_error("quantize_weight: weights must be finite");
+            if (amax == 0.0f) continue;
+            const float scale = amax / 127.0f, inv = 127.0f / amax;
+            std::int8_t* panel = q.packed.data() + (n / NR) * NR * q.Kp + (n % NR) * 4;
+            std::int32_t sum = 0;
+            for (std::size_t k = 0; k < K; ++k) {
+                const auto v = std::int8_t(std::clamp(std::nearbyint(at(W, n, k) * inv), -127.0f, 127.0f));
+                panel[(k / 4) * NR * 4 + k % 4] = v;
+                sum += v;
+            }
+            q.scales[n] = scale;
+            q.col_sums[n] = sum;
+        }
+    });
+    return q;
+}
+
+void dequantize_weight(const QuantizedWeight& w, float* out) {
+    for (std::size_t n = 0; n < w.N; ++n) {
+        const std::int8_t* panel = w.packed.data() + (n / NR) * NR * w.Kp + (n % NR) * 4;
+        for (std::size_t k = 0; k < w.K; ++k)
+            out[n * w.K + k] = w.scales[n] * float(panel[(k / 4) * NR * 4 + k % 4]);
+    }
+}
+
+QGemmMicroKernel qgemm_kernel_scalar() {
+    return {MR_SCALAR, 255, ukernel_scalar, "scalar"};
+}
+
+QGemmMicroKernel qgemm_kernel() {
+    if (cpu_has_avx512_vnni()) return qgemm_kernel_avx512_vnni();
+    switch (cpu_capability()) {
+        case CpuCapability::AVX512:
+        case CpuCapability::AVX2:   return qgemm_kernel_avx2();
+        default:                    return qgemm_kernel_scalar();
+    }
+}
+
+std::int32_t qgemm_activation_max() { return qgemm_kernel().a_max; }
+
+const char* qgemm_kernel_name() { return qgemm_kernel().name; }
+
+void qgemm(std::size_t M, MatrixRef A, const QuantizedWeight& W,
+           float* C, std::ptrdiff_t ldc, const GemmEpilogue<float>& epilogue,
+           ActivationQuant* quant) {
+    const std::size_t N = W.N, K = W.K, Kp = W.Kp;
+    const QGemmMicroKernel uk = qgemm_kernel();
+    const ActivationQuant q = M > 0 ? choose_activation_quant(M, K, A, uk.a_max) : ActivationQuant{};
+    if (quant) *quant = q;
+    if (M == 0 || N == 0) return;
+
+    ByteBuffer a_quant(M * Kp);
+    quantize_activations(a_quant.data, M, K, Kp, A, q);
+
+    // Par colonne : scale_a · scale_w[n] et zero_point · Σ_k q[n, k]
+    std::vector<float> scale(N);
+    std::vector<std::int64_t> offset(N);
+    for (std::size_t n = 0; n < N; ++n) {
+        scale[n]  = q.scale * W.scales[n];
+        offset[n] = std::int64_t(q.zero_point) * W.col_sums[n];
+    }
+
+    // Tâches : blocs MC de lignes x groupes NG de colonnes ; le panneau de
+    // W (Kp x NR octets) reste en L2 pendant le parcours du bloc de lignes
+    const std::size_t mr = uk.mr, kg = Kp / 4;
+    const std::size_t m_blocks = (M + MC - 1) / MC;
+    const std::size_t n_groups = (N + NG - 1) / NG;
+    const std::size_t work_per_unit = std::min(M, MC) * std::min(N, NG) * std::max<std::size_t>(K, 1);
+    const std::size_t grain = work_per_unit >= kParallelWork
+        ? 1 : std::max<std::size_t>(1, kParallelWork / work_per_unit);
+    parallel_for(0, m_blocks * n_groups, grain, [&](std::size_t ub, std::size_t ue) {
+        alignas(64) std::int32_t tile[kMaxMR * NR];
+        for (std::size_t u = ub; u < ue; ++u) {
+            const std::size_t i_begin = (u / n_groups) * MC;
+            const std::size_t i_end   = std::min(M, i_begin + MC);
+            const std::size_t j_begin = (u % n_groups) * NG;
+            const std::size_t j_end   = std::min(N, j_begin + NG);
+            for (std::size_t jr = j_begin; jr < j_end; jr += NR) {
+                const std::size_t cols = std::min(NR, N - jr);
+                const std::int8_t* bp = W.packed.data() + (jr / NR) * NR * Kp;
+                for (std::size_t ir = i_begin; ir < i_end; ir += mr) {
+                    const std::size_t rows = std::min(mr, i_end - ir);
+                    uk.fn(rows, kg, a_quant.data + ir * Kp, std::ptrdiff_t(Kp), bp, tile);
+                    for (std::size_t i = 0; i < rows; ++i)
+                        dequant_row(epilogue, C + std::ptrdiff_t(ir + i) * ldc + std::ptrdiff_t(jr),
+                                    tile + i * NR, scale.data() + jr, offset.data() + jr, cols, jr);
+                }
+            }
+        }
+    });
+}
+
+} // namespace kernels
+} // namespace napcas
@@ -0,0 +1,72 @@
+// cpp/src/kernels/qgemm_avx2.cpp
+//
+// Micro-noyau int8 4x16 AVX2 : vpmaddubsw (u8 · s8, paires sommées en
+// int16 saturé) puis vpmaddwd par 1 vers int32, 8 accumulateurs YMM.
+// Les activations sont limitées à 7 bits (a_max = 127) pour que la paire
+// 2 · 127 · 127 ne sature jamais. Compilé avec -mavx2 -mfma.
+
+#include "napcas/kernels/qgemm_isa.h"
+
+#if defined(__AVX2__) && defined(__FMA__)
+#include <immintrin.h>
+#include <cstring>
+
+namespace napcas {
+namespace kernels {
+
+namespace {
+    constexpr std::size_t MR = 4;
+    constexpr std::size_t NR = 16;
+
+    template<std::size_t R>
+    void tile(std::size_t kg, const std::uint8_t* a, std::ptrdiff_t lda,
+              const std::int8_t* b, std::int32_t* c) {
+        const __m256i ones = _mm256_set1_epi16(1);
+        __m256i acc[R][2];
+        for (std::size_t i = 0; i < R; ++i)
+            acc[i][0] = acc[i][1] = _mm256_setzero_si256();
+        for (std::size_t g = 0; g < kg; ++g) {
+            const __m256i b0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b));
+            const __m256i b1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + 32));
+            for (std::size_t i = 0; i < R; ++i) {
+                std::int32_t a4;
+                std::memcpy(&a4, a + std::ptrdiff_t(i) * lda + g * 4, sizeof(a4));
+                const __m256i ai = _mm256_set1_epi32(a4);
+                acc[i][0] = _mm256_add_epi32(acc[i][0],
+                    _mm256_madd_epi16(_mm256_maddubs_epi16(ai, b0), ones));
+                acc[i][1] = _mm256_add_epi32(acc[i][1],
+                    _mm256_madd_epi16(_mm256_maddubs_epi16(ai, b1), ones));
+            }
+            b += NR * 4;
+        }
+        for (std::size_t i = 0; i < R; ++i) {
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(c + i * NR),     acc[i][0]);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(c + i * NR + 8), acc[i][1]);
+        }
+    }
+
+    void ukernel(std::size_t rows, std::size_t kg, const std::uint8_t* a,
+                 std::ptrdiff_t lda, const std::int8_t* b, std::int32_t* c) {
+        switch (rows) {
+            case 1:  return tile<1>(kg, a, lda, b, c);
+            case 2:  return tile<2>(kg, a, lda, b, c);
+            case 3:  return tile<3>(kg, a, lda, b, c);
+            default: return tile<4>(kg, a, lda, b, c);
+        }
+    }
+}
+
+QGemmMicroKernel qgemm_kernel_avx2() { return {MR, 127, ukernel, "avx2"}; }
+
+} // namespace kernels
+} // namespace napcas
+
+#else
+
+namespace napcas {
+namespace kernels {
+QGemmMicroKernel qgemm_kernel_avx2() { return qgemm_kernel_scalar(); }
+} // namespace kernels
+} // namespace napcas
+
+#endif
@@ -0,0 +1,66 @@
+// cpp/src/kernels/qgemm_avx512.cpp
+//
+// Micro-noyau int8 8x16 AVX-512 VNNI : vpdpbusd accumule directement
+// quatre produits u8 · s8 en int32 (pas de saturation intermédiaire,
+// activations sur 8 bits), 8 accumulateurs ZMM. Compilé avec -mavx512f
+// -mavx512bw -mavx512vnni ; n'est choisi que si cpu_has_avx512_vnni().
+
+#include "napcas/kernels/qgemm_isa.h"
+
+#if defined(__AVX512F__) && defined(__AVX512VNNI__)
+#include <immintrin.h>
+#include <cstring>
+
+namespace napcas {
+namespace kernels {
+
+namespace {
+    constexpr std::size_t MR = 8;
+    constexpr std::size_t NR = 16;
+
+    template<std::size_t R>
+    void tile(std::size_t kg, const std::uint8_t* a, std::ptrdiff_t lda,
+              const std::int8_t* b, std::int32_t* c) {
+        __m512i acc[R];
+        for (std::size_t i = 0; i < R; ++i) acc[i] = _mm512_setzero_si512();
+        for (std::size_t g = 0; g < kg; ++g) {
+            const __m512i bg = _mm512_loadu_si512(b);
+            for (std::size_t i = 0; i < R; ++i) {
+                std::int32_t a4;
+                std::memcpy(&a4, a + std::ptrdiff_t(i) * lda + g * 4, sizeof(a4));
+                acc[i] = _mm512_dpbusd_epi32(acc[i], _mm512_set1_epi32(a4), bg);
+            }
+            b += NR * 4;
+        }
+        for (std::size_t i = 0; i < R; ++i) _mm512_storeu_si512(c + i * NR, acc[i]);
+    }
+
+    void ukernel(std::size_t rows, std::size_t kg, const std::uint8_t* a,
+                 std::ptrdiff_t lda, const std::int8_t* b, std::int32_t* c) {
+        switch (rows) {
+            case 1:  return tile<1>(kg, a, lda, b, c);
+            case 2:  return tile<2>(kg, a, lda, b, c);
+            case 3:  return tile<3>(kg, a, lda, b, c);
+            case 4:  return tile<4>(kg, a, lda, b, c);
+            case 5:  return tile<5>(kg, a, lda, b, c);
+            case 6:  return tile<6>(kg, a, lda, b, c);
+            case 7:  return tile<7>(kg, a, lda, b, c);
+            default: return tile<8>(kg, a, lda, b, c);
+        }
+    }
+}
+
+QGemmMicroKernel qgemm_kernel_avx512_vnni() { return {MR, 255, ukernel, "avx512_vnni"}; }
+
+} // namespace kernels
+} // namespace napcas
+
+#else
+
+namespace napcas {
+namespace kernels {
+QGemmMicroKernel qgemm_kernel_avx512_vnni() { return qgemm_kernel_avx2(); }
+} // namespace kernels
+} // namespace napcas
+
+#endif
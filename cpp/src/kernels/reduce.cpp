@@ -0,0 +1,512 @@
+// cpp/src/kernels/reduce.cpp
+
+#include "napcas/kernels/reduce.h"
+#include "napcas/kernels/strided_iter.h"
+#include "napcas/dispatch.h"
+#include "napcas/parallel.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+namespace napcas {
+namespace kernels {
+
+namespace {
+    // Sommes par paires : feuilles de kPairwiseBlock éléments sur 8
+    // accumulateurs (erreur en O(log n) au lieu de O(n))
+    constexpr std::size_t kPairwiseBlock = 128;
+    // Colonnes accumulées ensemble quand l'axe conservé est contigu
+    constexpr std::size_t kColumnBlock = 256;
+    // Lignes accumulées dans un tampon partiel avant fusion dans le total
+    constexpr std::size_t kRowBlock = 64;
+    // Bloc des passes doubles (variance, logsumexp)
+    constexpr std::size_t kTwoPassBlock = 256;
+
+    template<typename A, typename T>
+    A pairwise_sum(const T* x, std::size_t n, std::ptrdiff_t s) {
+        if (n <= kPairwiseBlock) {
+            A r[8] = {};
+            std::size_t i = 0;
+            if (s == 1) {
+                for (; i + 8 <= n; i += 8)
+                    for (int k = 0; k < 8; ++k) r[k] += A(x[i + k]);
+            } else {
+                for (; i + 8 <= n; i += 8)
+                    for (int k = 0; k < 8; ++k) r[k] += A(x[std::ptrdiff_t(i + k) * s]);
+            }
+            A res = ((r[0] + r[1]) + (r[2] + r[3])) + ((r[4] + r[5]) + (r[6] + r[7]));
+            for (; i < n; ++i) res += A(x[std::ptrdiff_t(i) * s]);
+            return res;
+        }
+        const std::size_t half = (n / 2 + 7) / 8 * 8;
+        return pairwise_sum<A>(x, half, s) +
+               pairwise_sum<A>(x + std::ptrdiff_t(half) * s, n - half, s);
+    }
+
+    // ----- Opérations : identity / reduce_run / accumulate / merge / finish -----
+    // reduce_run(a, x, n, s, first) réduit n éléments de pas s dont le
+    // premier a l'indice réduit `first` ; merge(a, b) fusionne un état b
+    // qui suit a dans l'ordre des indices.
+
+    template<typename T, typename O = T>
+    struct SumOp {
+        using Acc = acc_type_t<T>;
+        using Out = O;
+        bool divide;
+        Acc identity() const { return Acc(0); }
+        void reduce_run(Acc& a, const T* x, std::size_t n, std::ptrdiff_t s, std::int64_t) const {
+            a += pairwise_sum<Acc>(x, n, s);
+        }
+        void accumulate(Acc& a, T v, std::int64_t) const { a += Acc(v); }
+        void merge(Acc& a, const Acc& b) const { a += b; }
+        Out finish(const Acc& a, std::size_t count) const {
+            return divide ? Out(a / Acc(count)) : Out(a);
+        }
+    };
+
+    template<typename T>
+    struct MinMaxOp {
+        using Acc = acc_type_t<T>;
+        using Out = T;
+        bool is_max;
+        Acc identity() const {
+            if (std::numeric_limits<Acc>::has_infinity)
+                return is_max ? -std::numeric_limits<Acc>::infinity()
+                              :  std::numeric_limits<Acc>::infinity();
+            return is_max ? std::numeric_limits<Acc>::lowest()
+                          : std::numeric_limits<Acc>::max();
+        }
+        // NaN l'emporte : une fois retenu, plus aucune comparaison ne le remplace
+        static Acc pick_max(Acc a, Acc v) { return (v > a || v != v) ? v : a; }
+        static Acc pick_min(Acc a, Acc v) { return (v < a || v != v) ? v : a; }
+        void reduce_run(Acc& a, const T* x, std::size_t n, std::ptrdiff_t s, std::int64_t) const {
+            Acc r[8];
+            for (auto& v : r) v = a;
+            std::size_t i = 0;
+            if (is_max) {
+                for (; i + 8 <= n; i += 8)
+                    for (int k = 0; k < 8; ++k) r[k] = pick_max(r[k], Acc(x[std::ptrdiff_t(i + k) * s]));
+                for (; i < n; ++i) r[0] = pick_max(r[0], Acc(x[std::ptrdiff_t(i) * s]));
+                for (int k = 0; k < 8; ++k) a = pick_max(a, r[k]);
+            } else {
+                for (; i + 8 <= n; i += 8)
+                    for (int k = 0; k < 8; ++k) r[k] = pick_min(r[k], Acc(x[std::ptrdiff_t(i + k) * s]));
+                for (; i < n; ++i) r[0] = pick_min(r[0], Acc(x[std::ptrdiff_t(i) * s]));
+                for (int k = 0; k < 8; ++k) a = pick_min(a, r[k]);
+            }
+        }
+        void accumulate(Acc& a, T v, std::int64_t) const {
+            a = is_max ? pick_max(a, Acc(v)) : pick_min(a, Acc(v));
+        }
+        void merge(Acc& a, const Acc& b) const { a = is_max ? pick_max(a, b) : pick_min(a, b); }
+        Out finish(const Acc& a, std::size_t) const { return T(a); }
+    };
+
+    template<typename T>
+    struct ArgOp {
+        using V = acc_type_t<T>;
+        struct Acc { V value; std::int64_t index; };
+        using Out = std::int64_t;
+        bool is_max;
+        Acc identity() const { return {V(0), -1}; }
+        // Strictement meilleur : NaN bat tout sauf un NaN antérieur
+        bool better(V v, V a) const {
+            if (a != a) return false;
+            if (v != v) return true;
+            return is_max ? v > a : v < a;
+        }
+        void accumulate(Acc& a, T x, std::int64_t idx) const {
+            const V v = V(x);
+            if (a.index < 0 || better(v, a.value)) a = {v, idx};
+        }
+        void reduce_run(Acc& a, const T* x, std::size_t n, std::ptrdiff_t s, std::int64_t first) const {
+            for (std::size_t i = 0; i < n; ++i)
+                accumulate(a, x[std::ptrdiff_t(i) * s], first + std::int64_t(i));
+        }
+        void merge(Acc& a, const Acc& b) const {
+            if (b.index >= 0 && (a.index < 0 || better(b.value, a.value))) a = b;
+        }
+        Out finish(const Acc& a, std::size_t) const { return a.index; }
+    };
+
+    template<typename T>
+    struct VarOp {
+        struct Acc { double n, mean, m2; };
+        using Out = T;
+        std::size_t correction;
+        bool take_sqrt;
+        Acc identity() const { return {0.0, 0.0, 0.0}; }
+        // Formule de Chan pour deux ensembles disjoints
+        void merge(Acc& a, const Acc& b) const {
+            if (b.n == 0) return;
+            if (a.n == 0) { a = b; return; }
+            const double n = a.n + b.n;
+            const double delta = b.mean - a.mean;
+            a.m2  += b.m2 + delta * delta * (a.n * b.n / n);
+            a.mean += delta * (b.n / n);
+            a.n = n;
+        }
+        void accumulate(Acc& a, T x, std::int64_t) const {
+            const double v = double(x);
+            a.n += 1;
+            const double delta = v - a.mean;
+            a.mean += delta / a.n;
+            a.m2 += delta * (v - a.mean);
+        }
+        void reduce_run(Acc& a, const T* x, std::size_t n, std::ptrdiff_t s, std::int64_t) const {
+            for (std::size_t b = 0; b < n; b += kTwoPassBlock) {
+                const std::size_t m = std::min(kTwoPassBlock, n - b);
+                const T* xb = x + std::ptrdiff_t(b) * s;
+                const double mean = pairwise_sum<double>(xb, m, s) / double(m);
+                double m2 = 0.0;
+                for (std::size_t i = 0; i < m; ++i) {
+                    const double d = double(xb[std::ptrdiff_t(i) * s]) - mean;
+                    m2 += d * d;
+                }
+                merge(a, Acc{double(m), mean, m2});
+            }
+        }
+        Out finish(const Acc& a, std::size_t) const {
+            const double dof = a.n - double(correction);
+            double v = dof > 0 ? a.m2 / dof : std::numeric_limits<double>::quiet_NaN();
+            if (take_sqrt) v = std::sqrt(v);
+            return T(static_cast<compute_type_t<T>>(v));
+        }
+    };
+
+    // État {m, s} : logsumexp = m + log(s), s relatif au maximum courant
+    template<typename T>
+    struct LogSumExpOp {
+        using C = compute_type_t<T>;
+        struct Acc { C m, s; };
+        using Out = T;
+        Acc identity() const { return {-std::numeric_limits<C>::infinity(), C(0)}; }
+        void merge(Acc& a, const Acc& b) const {
+            if (b.s == C(0)) return;
+            if (a.s == C(0)) { a = b; return; }
+            if (b.m > a.m)       { a.s = a.s * std::exp(a.m - b.m) + b.s; a.m = b.m; }
+            else if (b.m == a.m) { a.s += b.s; }
+            else                 { a.s += b.s * std::exp(b.m - a.m); }
+        }
+        void accumulate(Acc& a, T x, std::int64_t) const {
+            const C v = C(x);
+            if (v == -std::numeric_limits<C>::infinity()) return;
+            merge(a, Acc{v, C(1)});
+        }
+        // Deux passes par bloc : maximum puis somme des exponentielles
+        void reduce_run(Acc& a, const T* x, std::size_t n, std::ptrdiff_t s, std::int64_t) const {
+            for (std::size_t b = 0; b < n; b += kTwoPassBlock) {
+                const std::size_t m = std::min(kTwoPassBlock, n - b);
+                const T* xb = x + std::ptrdiff_t(b) * s;
+                C mx = -std::numeric_limits<C>::infinity();
+                bool nan = false;
+                for (std::size_t i = 0; i < m; ++i) {
+                    const C v = C(xb[std::ptrdiff_t(i) * s]);
+                    mx = v > mx ? v : mx;
+                    nan |= v != v;
+                }
+                if (nan || std::isinf(mx)) {
+                    for (std::size_t i = 0; i < m; ++i) accumulate(a, xb[std::ptrdiff_t(i) * s], 0);
+                    continue;
+                }
+                C sum = C(0);
+                for (std::size_t i = 0; i < m; ++i)
+                    sum += std::exp(C(xb[std::ptrdiff_t(i) * s]) - mx);
+                merge(a, Acc{mx, sum});
+            }
+        }
+        Out finish(const Acc& a, std::size_t) const {
+            if (a.m != a.m) return T(a.m);
+            if (a.s == C(0)) return T(-std::numeric_limits<C>::infinity());
+            return T(a.m + std::log(a.s));
+        }
+    };
+
+    // ----- Moteur commun -----
+
+    struct ReduceGeometry {
+        StridedGeometry<1> kept;      // axes conservés (ordre de la sortie dense)
+        StridedGeometry<1> reduced;   // axes réduits (ordre row-major des indices)
+        std::size_t num_out = 1;
+        std::size_t num_reduced = 1;
+    };
+
+    ReduceGeometry make_geometry(const Shape&   shape,
+                                 const Strides& strides,
+                                 const std::vector<bool>&           reduce_axes) {
+        if (strides.size() != shape.size() || reduce_axes.size() != shape.size())
+            throw std::runtime_error("reduce: shape/strides/axes rank mismatch");
+        Shape   ks, rs;
+        Strides kst, rst;
+        ReduceGeometry g;
+        for (std::size_t d = 0; d < shape.size(); ++d) {
+            if (reduce_axes[d]) {
+                rs.push_back(shape[d]);
+                rst.push_back(strides[d]);
+                g.num_reduced *= shape[d];
+            } else {
+                ks.push_back(shape[d]);
+                kst.push_back(strides[d]);
+                g.num_out *= shape[d];
+            }
+        }
+        g.kept    = coalesce<1>(ks, {&kst});
+        g.reduced = coalesce<1>(rs, {&rst});
+        if (g.reduced.shape.empty()) {
+            g.reduced.shape.push_back(1);
+            g.reduced.strides[0].push_back(1);
+        }
+        return g;
+    }
+
+    /// Fusionne dans acc[0 .. oe-ob) les éléments réduits [rb, re) des
+    /// sorties [ob, oe).
+    template<typename T, typename Op>
+    void accumulate_range(const Op& op, typename Op::Acc* acc, const T* in,
+                          const ReduceGeometry& g,
+                          std::size_t ob, std::size_t oe,
+                          std::size_t rb, std::size_t re) {
+        using Acc = typename Op::Acc;
+        const std::ptrdiff_t ks = g.kept.inner_stride(0);
+        const std::ptrdiff_t rs = g.reduced.inner_stride(0);
+        const bool single_run = g.reduced.ndim() == 1;
+
+        // Réduit [rb, re) pour un point de départ donné, segment par segment
+        auto reduce_one = [&](Acc& a, const T* base) {
+            if (single_run) {
+                op.reduce_run(a, base + std::ptrdiff_t(rb) * rs, re - rb, rs, std::int64_t(rb));
+                return;
+            }
+            std::size_t pos = rb;
+            for_each_segment(g.reduced, rb, re,
+                [&](const std::array<std::ptrdiff_t, 1>& off, std::size_t col, std::size_t len) {
+                    op.reduce_run(a, base + off[0] + std::ptrdiff_t(col) * rs, len, rs,
+                                  std::int64_t(pos));
+                    pos += len;
+                });
+        };
+
+        std::size_t o = 0;
+        for_each_segment(g.kept, ob, oe,
+            [&](const std::array<std::ptrdiff_t, 1>& koff, std::size_t kcol, std::size_t klen) {
+                const T* base = in + koff[0] + std::ptrdiff_t(kcol) * ks;
+                // Axe conservé contigu, axe réduit à pas : on balaie les lignes
+                // réduites sur un bloc de colonnes (accès contigus, vectorisables)
+                if (ks == 1 && rs != 1 && klen >= 8) {
+                    Acc part[kColumnBlock];
+                    for (std::size_t c0 = 0; c0 < klen; c0 += kColumnBlock) {
+                        const std::size_t nc = std::min(kColumnBlock, klen - c0);
+                        Acc* total = acc + o + c0;
+                        std::fill(part, part + nc, op.identity());
+                        std::size_t rows = 0;
+                        std::size_t pos = rb;
+                        auto flush = [&] {
+                            for (std::size_t c = 0; c < nc; ++c) {
+                                op.merge(total[c], part[c]);
+                                part[c] = op.identity();
+                            }
+                            rows = 0;
+                        };
+                        for_each_segment(g.reduced, rb, re,
+                            [&](const std::array<std::ptrdiff_t, 1>& roff, std::size_t col, std::size_t len) {
+                                const T* x = base + c0 + roff[0] + std::ptrdiff_t(col) * rs;
+                                for (std::size_t i = 0; i < len; ++i, ++pos, x += rs) {
+                                    for (std::size_t c = 0; c < nc; ++c)
+                                        op.accumulate(part[c], x[c], std::int64_t(pos));
+                                    if (++rows == kRowBlock) flush();
+                                }
+                            });
+                        if (rows) flush();
+                    }
+                } else {
+                    for (std::size_t j = 0; j < klen; ++j)
+                        reduce_one(acc[o + j], base + std::ptrdiff_t(j) * ks);
+                }
+                o += klen;
+            });
+    }
+
+    template<typename T, typename Op>
+    void run_reduce(const Op& op, typename Op::Out* out, const T* in,
+                    const Shape&   shape,
+                    const Strides& strides,
+                    const std::vector<bool>&           reduce_axes,
+                    bool needs_elements, const char* name) {
+        using Acc = typename Op::Acc;
+        const ReduceGeometry g = make_geometry(shape, strides, reduce_axes);
+        const std::size_t no = g.num_out;
+        const std::size_t nr = g.num_reduced;
+        if (no == 0) return;
+        if (nr == 0) {
+            if (needs_elements)
+                throw std::runtime_error(std::string(name) + ": reduction over an empty dimension");
+            const auto v = op.finish(op.identity(), 0);
+            std::fill(out, out + no, v);
+            return;
+        }
+
+        // Peu de sorties pour beaucoup de travail (ex. réduction complète) :
+        // on découpe l'ensemble réduit, puis on fusionne les partiels dans
+        // l'ordre (résultat indépendant de l'ordonnancement)
+        const std::size_t threads = get_num_threads();
+        const std::size_t elems_per_chunk = kMinChunkBytes / sizeof(T);
+        const bool split = threads > 1 && !in_parallel_region() && no < threads &&
+                           nr >= 2 * elems_per_chunk;
+        if (!split) {
+            parallel_for(0, no, grain_size(no, nr * sizeof(T)), [&](std::size_t b, std::size_t e) {
+                std::vector<Acc> acc(e - b, op.identity());
+                accumulate_range(op, acc.data(), in, g, b, e, 0, nr);
+                for (std::size_t o = b; o < e; ++o) out[o] = op.finish(acc[o - b], nr);
+            });
+            return;
+        }
+        const std::size_t chunks = std::min(4 * threads, nr / elems_per_chunk);
+        const std::size_t chunk  = (nr + chunks - 1) / chunks;
+        std::vector<Acc> partial(chunks * no, op.identity());
+        parallel_for(0, chunks, 1, [&](std::size_t b, std::size_t e) {
+            for (std::size_t c = b; c < e; ++c)
+                accumulate_range(op, partial.data() + c * no, in, g, 0, no,
+                                 c * chunk, std::min(nr, (c + 1) * chunk));
+        });
+        for (std::size_t o = 0; o < no; ++o) {
+            Acc a = partial[o];
+            for (std::size_t c = 1; c < chunks; ++c) op.merge(a, partial[c * no + o]);
+            out[o] = op.finish(a, nr);
+        }
+    }
+}
+
+template<typename T>
+void reduce(ReduceOp op, T* out, const T* in,
+            const Shape&   shape,
+            const Strides& strides,
+            const std::vector<bool>&           reduce_axes) {
+    switch (op) {
+        case ReduceOp::Sum:
+            return run_reduce(SumOp<T>{false}, out, in, shape, strides, reduce_axes, false, "sum");
+        case ReduceOp::Mean:
+            // Moyenne d'un ensemble vide : NaN (0/0) en flottant, erreur en entier
+            return run_reduce(SumOp<T>{true}, out, in, shape, strides, reduce_axes,
+                              std::is_integral<acc_type_t<T>>::value, "mean");
+        case ReduceOp::Max:
+            return run_reduce(MinMaxOp<T>{true}, out, in, shape, strides, reduce_axes, true, "max");
+        case ReduceOp::Min:
+            return run_reduce(MinMaxOp<T>{false}, out, in, shape, strides, reduce_axes, true, "min");
+        case ReduceOp::LogSumExp:
+            return run_reduce(LogSumExpOp<T>{}, out, in, shape, strides, reduce_axes, false, "logsumexp");
+    }
+    throw std::runtime_error("reduce: unknown op");
+}
+
+template<typename T>
+void sum_int64(std::int64_t* out, const T* in,
+               const Shape&   shape,
+               const Strides& strides,
+               const std::vector<bool>&           reduce_axes) {
+    static_assert(std::is_integral<T>::value, "sum_int64: integer types only");
+    run_reduce(SumOp<T, std::int64_t>{false}, out, in, shape, strides, reduce_axes, false, "sum");
+}
+
+template<typename T>
+void arg_reduce(bool is_max, std::int64_t* out, const T* in,
+                const Shape&   shape,
+                const Strides& strides,
+                const std::vector<bool>&           reduce_axes) {
+    run_reduce(ArgOp<T>{is_max}, out, in, shape, strides, reduce_axes, true,
+               is_max ? "argmax" : "argmin");
+}
+
+template<typename T>
+void variance(T* out, const T* in,
+              const Shape&   shape,
+              const Strides& strides,
+              const std::vector<bool>&           reduce_axes,
+              std::size_t correction, bool take_sqrt) {
+    run_reduce(VarOp<T>{correction, take_sqrt}, out, in, shape, strides, reduce_axes, false,
+               take_sqrt ? "std" : "var");
+}
+
+template<typename T>
+void scatter_reduced(T* grad_in, const T* g, const std::int64_t* idx,
+                     const Shape& shape,
+                     const std::vector<bool>&        reduce_axes) {
+    Shape   ks, rs;
+    Strides kst, rst;
+    std::ptrdiff_t stride = 1;
+    for (int d = int(shape.size()) - 1; d >= 0; --d) {
+        if (reduce_axes[d]) { rs.insert(rs.begin(), shape[d]); rst.insert(rst.begin(), stride); }
+        else                { ks.insert(ks.begin(), shape[d]); kst.insert(kst.begin(), stride); }
+        stride *= std::ptrdiff_t(shape[d]);
+    }
+    std::size_t no = 1;
+    for (auto n : ks) no *= n;
+    // Offset d'un indice linéaire row-major dans une géométrie (shape, strides)
+    auto offset_of = [](std::size_t lin, const Shape& sh,
+                        const Strides& st) {
+        std::ptrdiff_t off = 0;
+        for (int d = int(sh.size()) - 1; d >= 0; --d) {
+            off += std::ptrdiff_t(lin % sh[d]) * st[d];
+            lin /= sh[d];
+        }
+        return off;
+    };
+    parallel_for(0, no, grain_size(no, 64), [&](std::size_t b, std::size_t e) {
+        for (std::size_t o = b; o < e; ++o)
+            grad_in[offset_of(o, ks, kst) + offset_of(std::size_t(idx[o]), rs, rst)] = g[o];
+    });
+}
+
+template<typename T>
+void exp(T* out, const T* in, std::size_t n) {
+    using C = compute_type_t<T>;
+    parallel_for(0, n, grain_size(n, 8 * sizeof(T)), [&](std::size_t b, std::size_t e) {
+        for (std::size_t i = b; i < e; ++i) out[i] = T(std::exp(C(in[i])));
+    });
+}
+
+#define NAPCAS_INSTANTIATE_REDUCE(T)                                            \
+    template void reduce<T>(ReduceOp, T*, const T*,                             \
+                            const Shape&,                                       \
+                            const Strides&,                                     \
+                            const std::vector<bool>&);                          \
+    template void arg_reduce<T>(bool, std::int64_t*, const T*,                  \
+                                const Shape&,                                   \
+                                const Strides&,                                 \
+                                const std::vector<bool>&);                      \
+    template void variance<T>(T*, const T*, const Shape&,                       \
+                              const Strides&,                                   \
+                              const std::vector<bool>&, std::size_t, bool);     \
+    template void scatter_reduced<T>(T*, const T*, const std::int64_t*,         \
+                                     const Shape&,                              \
+                                     const std::vector<bool>&);
+
+NAPCAS_INSTANTIATE_REDUCE(float)
+NAPCAS_INSTANTIATE_REDUCE(double)
+NAPCAS_INSTANTIATE_REDUCE(Half)
+NAPCAS_INSTANTIATE_REDUCE(BFloat16)
+NAPCAS_INSTANTIATE_REDUCE(std::int8_t)
+NAPCAS_INSTANTIATE_REDUCE(std::uint8_t)
+NAPCAS_INSTANTIATE_REDUCE(std::int32_t)
+NAPCAS_INSTANTIATE_REDUCE(std::int64_t)
+
+#undef NAPCAS_INSTANTIATE_REDUCE
+
+template void sum_int64<std::int8_t>(std::int64_t*, const std::int8_t*, const Shape&,
+                                     const Strides&, const std::vector<bool>&);
+template void sum_int64<std::uint8_t>(std::int64_t*, const std::uint8_t*, const Shape&,
+                                      const Strides&, const std::vector<bool>&);
+template void sum_int64<std::int32_t>(std::int64_t*, const std::int32_t*, const Shape&,
+                                      const Strides&, const std::vector<bool>&);
+template void sum_int64<std::int64_t>(std::int64_t*, const std::int64_t*, const Shape&,
+                                      const Strides&, const std::vector<bool>&);
+
+template void exp<float>(float*, const float*, std::size_t);
+template void exp<double>(double*, const double*, std::size_t);
+template void exp<Half>(Half*, const Half*, std::size_t);
+template void exp<BFloat16>(BFloat16*, const BFloat16*, std::size_t);
+
+} // namespace kernels
+} // namespace napcas
@@ -0,0 +1,201 @@
+// cpp/src/lazy.cpp
+
+#include "napcas/lazy.h"
+#include "napcas/broadcast.h"
+#include "napcas/kernels/fused.h"
+#include <optional>
+#include <stdexcept>
+#include <unordered_map>
+
+namespace napcas {
+
+struct LazyTensor::Node {
+    enum class Kind { Leaf, Constant, Binary };
+
+    Kind kind;
+    Shape shape;
+    DType dtype;
+    bool  requires_grad = false;
+
+    Tensor tensor;                               // Leaf
+    double value = 0.0;                          // Constant
+    kernels::BinaryOp op = kernels::BinaryOp::Add;
+    std::shared_ptr<const Node> lhs, rhs;        // Binary
+};
+
+LazyTensor::LazyTensor(std::shared_ptr<const Node> node) : node_(std::move(node)) {}
+
+LazyTensor::LazyTensor(const Tensor& tensor) {
+    auto n = std::make_shared<Node>();
+    n->kind          = Node::Kind::Leaf;
+    n->shape         = tensor.shape();
+    n->dtype         = tensor.dtype();
+    n->requires_grad = tensor.requires_grad();
+    n->tensor        = tensor;
+    node_ = std::move(n);
+}
+
+LazyTensor::LazyTensor(int value) : LazyTensor(std::int64_t(value)) {}
+
+LazyTensor::LazyTensor(std::int64_t value) {
+    auto n = std::make_shared<Node>();
+    n->kind  = Node::Kind::Constant;
+    n->dtype = DType::Int64;
+    n->value = double(value);
+    node_ = std::move(n);
+}
+
+LazyTensor::LazyTensor(double value) {
+    auto n = std::make_shared<Node>();
+    n->kind  = Node::Kind::Constant;
+    n->dtype = DType::Float64;
+    n->value = value;
+    node_ = std::move(n);
+}
+
+const Shape& LazyTensor::shape() const noexcept { return node_->shape; }
+DType LazyTensor::dtype() const noexcept { return node_->dtype; }
+bool  LazyTensor::requires_grad() const noexcept { return node_->requires_grad; }
+
+LazyTensor LazyTensor::binary(kernels::BinaryOp op, const LazyTensor& a, const LazyTensor& b) {
+    const Node& x = *a.node_;
+    const Node& y = *b.node_;
+    auto n = std::make_shared<Node>();
+    n->kind          = Node::Kind::Binary;
+    n->shape         = broadcast_shapes(x.shape, y.shape);
+    n->requires_grad = x.requires_grad || y.requires_grad;
+    n->op            = op;
+    n->lhs           = a.node_;
+    n->rhs           = b.node_;
+
+    // Une constante garde le type du tenseur, sauf flottant sur entier
+    const bool cx = x.kind == Node::Kind::Constant;
+    const bool cy = y.kind == Node::Kind::Constant;
+    if (cx == cy) {
+        n->dtype = promote_types(x.dtype, y.dtype);
+    } else {
+        const Node& t = cx ? y : x;
+        const Node& c = cx ? x : y;
+        n->dtype = (is_floating_point(c.dtype) && !is_floating_point(t.dtype))
+                       ? DType::Float32 : t.dtype;
+    }
+    return LazyTensor(std::shared_ptr<const Node>(std::move(n)));
+}
+
+LazyTensor operator+(const LazyTensor& a, const LazyTensor& b) {
+    return LazyTensor::binary(kernels::BinaryOp::Add, a, b);
+}
+LazyTensor operator-(const LazyTensor& a, const LazyTensor& b) {
+    return LazyTensor::binary(kernels::BinaryOp::Sub, a, b);
+}
+LazyTensor operator*(const LazyTensor& a, const LazyTensor& b) {
+    return LazyTensor::binary(kernels::BinaryOp::Mul, a, b);
+}
+LazyTensor operator/(const LazyTensor& a, const LazyTensor& b) {
+    return LazyTensor::binary(kernels::BinaryOp::Div, a, b);
+}
+
+Tensor LazyTensor::eval() const {
+    const Node& root = *node_;
+    if (root.kind == Node::Kind::Constant)
+        throw std::runtime_error("LazyTensor::eval: expression has no tensor operand");
+    if (root.kind == Node::Kind::Leaf)
+        return root.tensor;
+
+    // Le résultat est alloué sur le périphérique des feuilles
+    std::optional<Device> device;
+    auto find_device = [&](auto&& self, const Node& n) -> void {
+        if (n.kind == Node::Kind::Leaf) {
+            if (!device) device = n.tensor.device();
+            else if (*device != n.tensor.device()) throw std::runtime_error("Device mismatch");
+        } else if (n.kind == Node::Kind::Binary) {
+            self(self, *n.lhs);
+            self(self, *n.rhs);
+        }
+    };
+    find_device(find_device, root);
+
+    // Autograd : rejoue l'expression avec les opérateurs de Tensor
+    if (root.requires_grad) {
+        std::unordered_map<const Node*, Tensor> memo;
+        auto eager = [&](auto&& self, const Node& n, DType constant_dtype) -> Tensor {
+            if (n.kind == Node::Kind::Constant)
+                return Tensor({}, std::vector<double>{n.value}, constant_dtype, *device);
+            if (n.kind == Node::Kind::Leaf)
+                return n.tensor;
+            auto it = memo.find(&n);
+            if (it != memo.end()) return it->second;
+            Tensor a = self(self, *n.lhs, n.dtype);
+            Tensor b = self(self, *n.rhs, n.dtype);
+            Tensor r;
+            switch (n.op) {
+                case kernels::BinaryOp::Add: r = a + b; break;
+                case kernels::BinaryOp::Sub: r = a - b; break;
+                case kernels::BinaryOp::Mul: r = a * b; break;
+                case kernels::BinaryOp::Div: r = a / b; break;
+            }
+            memo.emplace(&n, r);
+            return r;
+        };
+        return eager(eager, root, root.dtype);
+    }
+
+    // Compilation : opérandes et constantes d'abord (registres bas), puis
+    // une instruction par nœud binaire en ordre postfixe ; un sous-graphe
+    // partagé n'est compilé qu'une fois. Un sous-graphe d'un autre type que
+    // le résultat (ex. int / int dans une expression float) est évalué à
+    // part dans son propre type, comme le ferait l'évaluation classique,
+    // puis lu comme un opérande.
+    kernels::FusedProgram prog;
+    std::unordered_map<const Node*, int> operand_reg, constant_reg, instr_reg;
+    std::vector<const Node*> order;
+    std::vector<Tensor> materialized;
+    auto add_operand = [&](const Node* n, const Tensor& t) {
+        operand_reg.emplace(n, int(prog.operands.size()));
+        prog.operands.push_back({t.data_ptr(), t.dtype(),
+                                 broadcast_strides(t.shape(), t.strides(), root.shape)});
+    };
+    auto collect = [&](auto&& self, const std::shared_ptr<const Node>& p) -> void {
+        const Node& n = *p;
+        switch (n.kind) {
+            case Node::Kind::Leaf:
+                if (!operand_reg.count(&n)) add_operand(&n, n.tensor);
+                break;
+            case Node::Kind::Constant:
+                if (!constant_reg.count(&n)) {
+                    constant_reg.emplace(&n, int(prog.constants.size()));
+                    prog.constants.push_back(n.value);
+                }
+                break;
+            case Node::Kind::Binary:
+                if (operand_reg.count(&n) || instr_reg.count(&n)) break;
+                if (n.dtype != root.dtype) {
+                    materialized.push_back(LazyTensor(p).eval());
+                    add_operand(&n, materialized.back());
+                    break;
+                }
+                self(self, n.lhs);
+                self(self, n.rhs);
+                instr_reg.emplace(&n, int(order.size()));
+                order.push_back(&n);
+                break;
+        }
+    };
+    collect(collect, node_);
+
+    const int n_ops = int(prog.operands.size());
+    const int n_const = int(prog.constants.size());
+    auto reg_of = [&](const Node* n) {
+        if (auto it = operand_reg.find(n); it != operand_reg.end()) return it->second;
+        if (n->kind == Node::Kind::Constant) return n_ops + constant_reg.at(n);
+        return n_ops + n_const + instr_reg.at(n);
+    };
+    for (const Node* n : order)
+        prog.code.push_back({n->op, reg_of(n->lhs.get()), reg_of(n->rhs.get())});
+
+    Tensor out(root.shape, root.dtype, *device);
+    kernels::fused_eval(prog, out.data_ptr(), root.dtype, root.shape);
+    return out;
+}
+
+} // namespace napcas
@@ -0,0 +1,137 @@
+// cpp/src/module.cpp
+
+#include "napcas/module.h"
+#include "napcas/checkpoint.h"
+#include "napcas/kernels/copy.h"
+#include <stdexcept>
+
+namespace napcas {
+
+namespace {
+    template<typename Entries>
+    void check_unique(const Entries& entries, const std::string& name) {
+        if (name.empty() || name.find('.') != std::string::npos)
+            throw std::runtime_error("Module: invalid name '" + name + "'");
+        for (const auto& e : entries)
+            if (e.first == name)
+                throw std::runtime_error("Module: '" + name + "' already registered");
+    }
+}
+
+void Module::register_parameter(const std::string& name, const Tensor& tensor) {
+    check_unique(params_, name);
+    check_unique(children_, name);
+    if (!tensor.defined())
+        throw std::runtime_error("Module: parameter '" + name + "' is undefined");
+    params_.emplace_back(name, tensor);
+}
+
+void Module::register_module(const std::string& name, std::shared_ptr<Module> module) {
+    check_unique(params_, name);
+    check_unique(children_, name);
+    if (!module)
+        throw std::runtime_error("Module: submodule '" + name + "' is null");
+    children_.emplace_back(name, std::move(module));
+}
+
+void Module::named_parameters(const std::string& prefix,
+                              std::vector<std::pair<std::string, Tensor>>& out) const {
+    for (const auto& p : params_)
+        out.emplace_back(prefix + p.first, p.second);
+    for (const auto& c : children_)
+        c.second->named_parameters(prefix + c.first + ".", out);
+}
+
+std::vector<Tensor> Module::parameters() const {
+    std::vector<std::pair<std::string, Tensor>> named;
+    named_parameters("", named);
+    std::vector<Tensor> out;
+    out.reserve(named.size());
+    for (auto& p : named) out.push_back(std::move(p.second));
+    return out;
+}
+
+std::vector<std::shared_ptr<Module>> Module::modules() const {
+    std::vector<std::shared_ptr<Module>> out;
+    out.reserve(children_.size());
+    for (const auto& c : children_) out.push_back(c.second);
+    return out;
+}
+
+std::map<std::string, Tensor> Module::state_dict() const {
+    std::vector<std::pair<std::string, Tensor>> named;
+    named_parameters("", named);
+    std::map<std::string, Tensor> out;
+    for (const auto& p : named) out.emplace(p.first, p.second.detach());
+    return out;
+}
+
+namespace {
+    using Named = std::vector<std::pair<std::string, Tensor>>;
+
+    // Vérifications complètes avant toute écriture : pas de chargement partiel
+    void check_state(const Named& named, const std::map<std::string, Tensor>& state,
+                     const char* who) {
+        const std::string prefix = std::string(who) + ": ";
+        for (const auto& p : named) {
+            auto it = state.find(p.first);
+            if (it == state.end())
+                throw std::runtime_error(prefix + "missing key '" + p.first + "'");
+            if (it->second.shape() != p.second.shape())
+                throw std::runtime_error(prefix + "shape mismatch for '" + p.first + "'");
+            if (!p.second.is_contiguous())
+                throw std::runtime_error(prefix + "parameter '" + p.first + "' is not contiguous");
+        }
+        if (state.size() != named.size())
+            for (const auto& s : state) {
+                bool known = false;
+                for (const auto& p : named) known = known || p.first == s.first;
+                if (!known)
+                    throw std::runtime_error(prefix + "unexpected key '" + s.first + "'");
+            }
+    }
+
+    void copy_into(Tensor& dst, const Tensor& src) {
+        const Tensor s = src.dtype() == dst.dtype() ? src : src.astype(dst.dtype());
+        if (s.data_ptr() == dst.data_ptr() && s.strides() == dst.strides())
+            return;   // son propre state_dict
+        kernels::strided_copy(dst.data_ptr(), s.data_ptr(), s.shape(), s.strides(),
+                              dtype_size(s.dtype()));
+        dst.storage()->bump_version();
+    }
+}
+
+void Module::load_state_dict(const std::map<std::string, Tensor>& state) {
+    Named named;
+    named_parameters("", named);
+    check_state(named, state, "load_state_dict");
+    for (auto& p : named) copy_into(p.second, state.at(p.first));
+}
+
+void Module::save(const std::string& path) const {
+    checkpoint::save(path, state_dict());
+}
+
+void Module::load(const std::string& path) {
+    const auto state = checkpoint::load(path);
+    Named named;
+    named_parameters("", named);
+    check_state(named, state, "load");
+    for (auto& p : named) {
+        const Tensor& src = state.at(p.first);
+        Tensor& dst = p.second;
+        // Un paramètre qui occupe tout son Storage y adopte les pages de la
+        // projection ; sinon (type converti, vue dans un bloc plus grand),
+        // copie comme load_state_dict
+        const std::size_t nbytes = dst.numel() * dtype_size(dst.dtype());
+        if (src.dtype() == dst.dtype() && src.device() == dst.device() &&
+            src.is_contiguous() && src.storage_offset() == 0 &&
+            src.storage()->nbytes() == nbytes &&
+            dst.storage_offset() == 0 && dst.storage()->nbytes() == nbytes)
+            dst.storage()->rebind(src.storage());
+        else
+            copy_into(dst, src);
+    }
+}
+
+} // namespace napcas
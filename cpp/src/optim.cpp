@@ -0,0 +1,239 @@
+// cpp/src/optim.cpp
+
+#include "napcas/optim.h"
+#include "napcas/parallel.h"
+#include "napcas/profiler.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+namespace napcas {
+namespace optim {
+
+namespace {
+    // Tranches d'état alignées sur une ligne de cache
+    constexpr std::size_t kAlign = 64 / sizeof(float);
+
+    std::size_t round_up(std::size_t n) { return (n + kAlign - 1) / kAlign * kAlign; }
+
+    void check_lr(const char* name, float lr) {
+        if (!(lr >= 0.0f))
+            throw std::runtime_error(std::string(name) + ": invalid learning rate " + std::to_string(lr));
+    }
+}
+
+Optimizer::Optimizer(std::vector<Tensor> params, float lr, float max_grad_norm,
+                     std::size_t num_state, const char* name)
+    : params_(std::move(params)), name_(name), lr_(lr), max_grad_norm_(0.0f) {
+    if (params_.empty())
+        throw std::runtime_error(std::string(name_) + ": empty parameter list");
+    check_lr(name_, lr);
+    set_max_grad_norm(max_grad_norm);
+    offsets_.reserve(params_.size());
+    for (std::size_t i = 0; i < params_.size(); ++i) {
+        const Tensor& p = params_[i];
+        const std::string what = std::string(name_) + ": parameter " + std::to_string(i);
+        if (!p.defined())
+            throw std::runtime_error(what + " is undefined");
+        if (p.dtype() != DType::Float32)
+            throw std::runtime_error(what + " is not float32");
+        if (p.device().type != DeviceType::CPU)
+            throw std::runtime_error(what + " is not on CPU");
+        if (!p.is_contiguous())
+            throw std::runtime_error(what + " is not contiguous");
+        offsets_.push_back(total_);
+        for (std::size_t b = 0; b < p.numel(); b += kChunk)
+            chunks_.push_back({i, b, std::min(p.numel(), b + kChunk)});
+        total_ += round_up(p.numel());
+    }
+    state_.reserve(num_state);
+    for (std::size_t s = 0; s < num_state; ++s)
+        state_.push_back(Tensor::zeros({total_}, DType::Float32));
+    grads_.resize(params_.size());
+    grad_ptrs_.resize(params_.size());
+    partial_.resize(chunks_.size());
+}
+
+void Optimizer::set_lr(float lr) {
+    check_lr(name_, lr);
+    lr_ = lr;
+}
+
+void Optimizer::set_max_grad_norm(float max_norm) {
+    if (!(max_norm >= 0.0f))
+        throw std::runtime_error(std::string(name_) + ": invalid max_grad_norm " + std::to_string(max_norm));
+    max_grad_norm_ = max_norm;
+}
+
+std::size_t Optimizer::state_bytes() const noexcept {
+    return state_.size() * total_ * sizeof(float);
+}
+
+Tensor Optimizer::state_view(std::size_t buffer, std::size_t i) const {
+    if (buffer >= state_.size() || i >= params_.size())
+        throw std::runtime_error(std::string(name_) + ": state index out of range");
+    const Tensor& p = params_[i];
+    return state_[buffer].as_strided({p.numel()}, {1}, offsets_[i]).reshape(p.shape());
+}
+
+// Exécution série tant que le pas entier tient sous kMinChunkBytes
+// (p, g et deux moments par élément)
+std::size_t Optimizer::grain() const noexcept {
+    return total_ * 4 * sizeof(float) < kMinChunkBytes ? chunks_.size() : 1;
+}
+
+double Optimizer::step() {
+    profiler::RecordScope prof(name_);
+    for (std::size_t i = 0; i < params_.size(); ++i) {
+        const Tensor& p = params_[i];
+        grad_ptrs_[i] = nullptr;
+        if (!p.has_grad()) continue;
+        const Tensor& g = p.grad();
+        if (g.shape() != p.shape() || g.dtype() != DType::Float32)
+            throw std::runtime_error(std::string(name_) + ": gradient of parameter " +
+                                     std::to_string(i) + " does not match it");
+        grads_[i]     = g.is_contiguous() ? g : g.contiguous();
+        grad_ptrs_[i] = grads_[i].data<float>();
+    }
+
+    // Les lambdas ne capturent que `this` : std::function ne les alloue pas
+    double norm = 0.0;
+    grad_scale_ = 1.0f;
+    if (max_grad_norm_ > 0.0f) {
+        parallel_for(0, chunks_.size(), grain(), [this](std::size_t b, std::size_t e) {
+            for (std::size_t c = b; c < e; ++c) {
+                const Chunk& ch = chunks_[c];
+                const float* g  = grad_ptrs_[ch.param];
+                partial_[c] = g ? kernels::sum_squares(g + ch.begin, ch.end - ch.begin) : 0.0;
+            }
+        });
+        // Somme dans l'ordre des blocs : résultat indépendant du découpage
+        double total = 0.0;
+        for (double s : partial_) total += s;
+        norm = std::sqrt(total);
+        if (norm > max_grad_norm_)
+            grad_scale_ = float(max_grad_norm_ / (norm + 1e-6));
+    }
+
+    ++steps_;
+    prepare(grad_scale_);
+    parallel_for(0, chunks_.size(), grain(), [this](std::size_t b, std::size_t e) {
+        float* state[kMaxState];
+        for (std::size_t c = b; c < e; ++c) {
+            const Chunk& ch = chunks_[c];
+            const float* g  = grad_ptrs_[ch.param];
+            if (!g) continue;
+            const std::size_t off = offsets_[ch.param] + ch.begin;
+            for (std::size_t s = 0; s < state_.size(); ++s)
+                state[s] = state_[s].data<float>() + off;
+            update(params_[ch.param].data<float>() + ch.begin, g + ch.begin, state,
+                   ch.end - ch.begin);
+        }
+    });
+
+    for (std::size_t i = 0; i < params_.size(); ++i) {
+        if (!grad_ptrs_[i]) continue;
+        params_[i].storage()->bump_version();
+        grads_[i] = Tensor();
+    }
+    return norm;
+}
+
+void Optimizer::zero_grad() {
+    for (std::size_t i = 0; i < params_.size(); ++i) {
+        Tensor& p = params_[i];
+        grad_ptrs_[i] = nullptr;
+        if (!p.has_grad()) continue;
+        Tensor& g = p.grad();
+        if (!g.is_contiguous() || g.shape() != p.shape() || g.dtype() != DType::Float32) {
+            p.zero_grad();
+            continue;
+        }
+        grad_ptrs_[i] = g.data<float>();
+        g.storage()->bump_version();
+    }
+    parallel_for(0, chunks_.size(), grain(), [this](std::size_t b, std::size_t e) {
+        for (std::size_t c = b; c < e; ++c) {
+            const Chunk& ch = chunks_[c];
+            if (float* g = grad_ptrs_[ch.param])
+                std::memset(g + ch.begin, 0, (ch.end - ch.begin) * sizeof(float));
+        }
+    });
+}
+
+// ============================== SGD ==============================
+
+SGD::SGD(std::vector<Tensor> params, float lr, float momentum, float weight_decay,
+         bool nesterov, float max_grad_norm)
+    : Optimizer(std::move(params), lr, max_grad_norm, momentum != 0.0f ? 1 : 0, "SGD"),
+      momentum_(momentum), weight_decay_(weight_decay), nesterov_(nesterov) {
+    if (!(momentum >= 0.0f))
+        throw std::runtime_error("SGD: invalid momentum " + std::to_string(momentum));
+    if (!(weight_decay >= 0.0f))
+        throw std::runtime_error("SGD: invalid weight_decay " + std::to_string(weight_decay));
+    if (nesterov && momentum == 0.0f)
+        throw std::runtime_error("SGD: nesterov requires a non-zero momentum");
+}
+
+Tensor SGD::momentum_buffer(std::size_t i) const {
+    if (momentum_ == 0.0f)
+        throw std::runtime_error("SGD: no momentum buffer (momentum = 0)");
+    return state_view(0, i);
+}
+
+void SGD::prepare(float grad_scale) {
+    step_.lr           = lr();
+    step_.momentum     = momentum_;
+    step_.weight_decay = weight_decay_;
+    step_.grad_scale   = grad_scale;
+    step_.nesterov     = nesterov_;
+}
+
+void SGD::update(float* p, const float* g, float* const* state, std::size_t n) const {
+    kernels::sgd_update(p, g, momentum_ != 0.0f ? state[0] : nullptr, n, step_);
+}
+
+// ============================== Adam ==============================
+
+Adam::Adam(std::vector<Tensor> params, float lr, float beta1, float beta2, float eps,
+           float weight_decay, float max_grad_norm)
+    : Adam(std::move(params), lr, beta1, beta2, eps, weight_decay, max_grad_norm, false, "Adam") {}
+
+Adam::Adam(std::vector<Tensor> params, float lr, float beta1, float beta2, float eps,
+           float weight_decay, float max_grad_norm, bool decoupled, const char* name)
+    : Optimizer(std::move(params), lr, max_grad_norm, 2, name),
+      beta1_(beta1), beta2_(beta2), eps_(eps), weight_decay_(weight_decay), decoupled_(decoupled) {
+    const std::string n = name;
+    if (!(beta1 >= 0.0f && beta1 < 1.0f) || !(beta2 >= 0.0f && beta2 < 1.0f))
+        throw std::runtime_error(n + ": betas must be in [0, 1)");
+    if (!(eps >= 0.0f))
+        throw std::runtime_error(n + ": invalid eps " + std::to_string(eps));
+    if (!(weight_decay >= 0.0f))
+        throw std::runtime_error(n + ": invalid weight_decay " + std::to_string(weight_decay));
+}
+
+void Adam::prepare(float grad_scale) {
+    // Corrections de biais en double : 1 - β2ᵗ est proche de 0 aux premiers pas
+    const double t = double(steps());
+    step_.beta1        = beta1_;
+    step_.beta2        = beta2_;
+    step_.eps          = eps_;
+    step_.step_size    = float(double(lr()) / (1.0 - std::pow(double(beta1_), t)));
+    step_.inv_sqrt_bc2 = float(1.0 / std::sqrt(1.0 - std::pow(double(beta2_), t)));
+    step_.l2           = decoupled_ ? 0.0f : weight_decay_;
+    step_.decay        = decoupled_ ? 1.0f - lr() * weight_decay_ : 1.0f;
+    step_.grad_scale   = grad_scale;
+}
+
+void Adam::update(float* p, const float* g, float* const* state, std::size_t n) const {
+    kernels::adam_update(p, g, state[0], state[1], n, step_);
+}
+
+AdamW::AdamW(std::vector<Tensor> params, float lr, float beta1, float beta2, float eps,
+             float weight_decay, float max_grad_norm)
+    : Adam(std::move(params), lr, beta1, beta2, eps, weight_decay, max_grad_norm, true, "AdamW") {}
+
+} // namespace optim
+} // namespace napcas
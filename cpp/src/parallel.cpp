@@ -0,0 +1,243 @@
+// cpp/src/parallel.cpp
+
+#include "napcas/parallel.h"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdlib>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace napcas {
+
+namespace {
+    thread_local bool tls_in_parallel_region = false;
+
+    // Un appel à parallel_for : compteur de blocs restants et première erreur
+    struct Job {
+        const std::function<void(std::size_t, std::size_t)>* fn;
+        std::atomic<std::size_t> pending{0};
+        std::exception_ptr       error;
+        std::mutex               mutex;
+        std::condition_variable  done;
+    };
+
+    struct Task {
+        Job*        job;
+        std::size_t begin;
+        std::size_t end;
+    };
+
+    void run_task(const Task& t) {
+        const bool was = tls_in_parallel_region;
+        tls_in_parallel_region = true;
+        try {
+            (*t.job->fn)(t.begin, t.end);
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(t.job->mutex);
+            if (!t.job->error) t.job->error = std::current_exception();
+        }
+        tls_in_parallel_region = was;
+        // Décrément sous verrou : une fois relâché, le Job peut être détruit
+        std::lock_guard<std::mutex> lock(t.job->mutex);
+        if (t.job->pending.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            t.job->done.notify_all();
+    }
+
+    // Pool à files par worker : chacun dépile l'avant de sa file et vole
+    // l'arrière des autres quand la sienne est vide.
+    class ThreadPool {
+    public:
+        explicit ThreadPool(std::size_t n_threads) { start(n_threads); }
+        ~ThreadPool() { stop(); }
+
+        // Lisible sans pool_mutex (grain_size, get_num_threads) pendant
+        // qu'un set_num_threads redimensionne les files
+        std::size_t size() const noexcept { return size_.load(std::memory_order_relaxed); }
+
+        void resize(std::size_t n_threads) {
+            stop();
+            start(n_threads);
+        }
+
+        void submit(std::vector<Task>& tasks) {
+            const std::size_t nq = queues_.size();
+            for (std::size_t i = 0; i < tasks.size(); ++i) {
+                Queue& q = *queues_[i % nq];
+                std::lock_guard<std::mutex> lock(q.mutex);
+                q.tasks.push_back(tasks[i]);
+            }
+            {
+                std::lock_guard<std::mutex> lock(sleep_mutex_);
+                queued_ += tasks.size();
+            }
+            wake_.notify_all();
+        }
+
+        // Vole une tâche dans n'importe quelle file (utilisé par l'appelant)
+        bool steal(Task& out, std::size_t start_at) {
+            const std::size_t nq = queues_.size();
+            for (std::size_t k = 0; k < nq; ++k) {
+                Queue& q = *queues_[(start_at + k) % nq];
+                std::lock_guard<std::mutex> lock(q.mutex);
+                if (!q.tasks.empty()) {
+                    out = q.tasks.back();
+                    q.tasks.pop_back();
+                    taken();
+                    return true;
+                }
+            }
+            return false;
+        }
+
+    private:
+        struct Queue {
+            std::mutex       mutex;
+            std::deque<Task> tasks;
+        };
+
+        void taken() {
+            std::lock_guard<std::mutex> lock(sleep_mutex_);
+            --queued_;
+        }
+
+        bool pop_own(std::size_t id, Task& out) {
+            Queue& q = *queues_[id];
+            std::lock_guard<std::mutex> lock(q.mutex);
+            if (q.tasks.empty()) return false;
+            out = q.tasks.front();
+            q.tasks.pop_front();
+            taken();
+            return true;
+        }
+
+        void worker_loop(std::size_t id) {
+            for (;;) {
+                Task t;
+                if (pop_own(id, t) || steal(t, id + 1)) {
+                    run_task(t);
+                    continue;
+                }
+                std::unique_lock<std::mutex> lock(sleep_mutex_);
+                wake_.wait(lock, [&] { return stopping_ || queued_ > 0; });
+                if (stopping_ && queued_ == 0) return;
+            }
+        }
+
+        void start(std::size_t n_threads) {
+            stopping_ = false;
+            const std::size_t n_workers = std::max<std::size_t>(1, n_threads) - 1;
+            for (std::size_t i = 0; i < n_workers; ++i)
+                queues_.push_back(std::make_unique<Queue>());
+            for (std::size_t i = 0; i < n_workers; ++i)
+                workers_.emplace_back(&ThreadPool::worker_loop, this, i);
+            size_.store(n_workers + 1, std::memory_order_relaxed);
+        }
+
+        void stop() {
+            {
+                std::lock_guard<std::mutex> lock(sleep_mutex_);
+                stopping_ = true;
+            }
+            wake_.notify_all();
+            for (auto& t : workers_) t.join();
+            workers_.clear();
+            queues_.clear();
+        }
+
+        std::vector<std::unique_ptr<Queue>> queues_;
+        std::vector<std::thread>            workers_;
+        std::mutex              sleep_mutex_;
+        std::condition_variable wake_;
+        std::size_t             queued_   = 0;
+        bool                    stopping_ = false;
+        std::atomic<std::size_t> size_{1};
+    };
+
+    std::size_t default_num_threads() {
+        if (const char* env = std::getenv("NAPCAS_NUM_THREADS")) {
+            long n = std::strtol(env, nullptr, 10);
+            if (n > 0) return std::size_t(n);
+        }
+        return std::max<std::size_t>(1, std::thread::hardware_concurrency());
+    }
+
+    // Partagé par parallel_for, exclusif pendant set_num_threads
+    std::shared_mutex pool_mutex;
+
+    ThreadPool& pool() {
+        static ThreadPool instance(default_num_threads());
+        return instance;
+    }
+}
+
+std::size_t get_num_threads() {
+    return pool().size();
+}
+
+void set_num_threads(std::size_t n) {
+    if (tls_in_parallel_region)
+        throw std::runtime_error("set_num_threads: called inside a parallel region");
+    std::unique_lock<std::shared_mutex> lock(pool_mutex);
+    pool().resize(std::max<std::size_t>(1, n));
+}
+
+bool in_parallel_region() {
+    return tls_in_parallel_region;
+}
+
+std::size_t grain_size(std::size_t n, std::size_t item_bytes) {
+    item_bytes = std::max<std::size_t>(1, item_bytes);
+    const std::size_t min_items = (kMinChunkBytes + item_bytes - 1) / item_bytes;
+    const std::size_t balanced  = (n + 4 * get_num_threads() - 1) / (4 * get_num_threads());
+    return std::max<std::size_t>(1, std::max(min_items, balanced));
+}
+
+void parallel_for(std::size_t begin, std::size_t end, std::size_t grain,
+                  const std::function<void(std::size_t, std::size_t)>& fn) {
+    if (begin >= end) return;
+    const std::size_t n = end - begin;
+    grain = std::max<std::size_t>(1, grain);
+    if (n <= grain || tls_in_parallel_region) {
+        fn(begin, end);
+        return;
+    }
+    std::shared_lock<std::shared_mutex> resize_guard(pool_mutex);
+    ThreadPool& p = pool();
+    if (p.size() <= 1) {
+        fn(begin, end);
+        return;
+    }
+
+    const std::size_t chunks = (n + grain - 1) / grain;
+    const std::size_t step   = (n + chunks - 1) / chunks;
+    Job job;
+    job.fn = &fn;
+    std::vector<Task> tasks;
+    tasks.reserve(chunks);
+    for (std::size_t b = begin + step; b < end; b += step)
+        tasks.push_back({&job, b, std::min(end, b + step)});
+    job.pending.store(tasks.size() + 1, std::memory_order_relaxed);
+    p.submit(tasks);
+
+    // L'appelant exécute le premier bloc puis aide à vider les files
+    run_task({&job, begin, std::min(end, begin + step)});
+    Task t;
+    while (job.pending.load(std::memory_order_acquire) > 0 && p.steal(t, 0))
+        run_task(t);
+    {
+        std::unique_lock<std::mutex> lock(job.mutex);
+        job.done.wait(lock, [&] {
+            return job.pending.load(std::memory_order_acquire) == 0;
+        });
+    }
+    if (job.error) std::rethrow_exception(job.error);
+}
+
+} // namespace napcas
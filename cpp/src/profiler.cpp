@@ -0,0 +1,276 @@
+// cpp/src/profiler.cpp
+
+#include "napcas/profiler.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <utility>
+
+namespace napcas {
+namespace profiler {
+
+namespace detail {
+std::atomic<bool> g_enabled{false};
+}
+
+namespace {
+    std::int64_t now_ns() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    // Événements terminés de tous les threads
+    struct Sink {
+        std::mutex         mutex;
+        std::vector<Event> events;
+        std::atomic<std::int64_t> origin{0};   // 0 : pas encore fixée
+    };
+    Sink& sink() {
+        static Sink* s = new Sink();   // jamais détruit (threads encore actifs à la sortie)
+        return *s;
+    }
+
+    // Événement ouvert, instant absolu de début (la durée ne dépend pas de
+    // l'origine) et durée cumulée de ses enfants directs
+    struct Pending {
+        Event        event;
+        std::int64_t begin_ns = 0;
+        std::int64_t child_ns = 0;
+    };
+
+    struct ThreadState {
+        std::uint32_t        id;
+        std::vector<Pending> stack;
+    };
+    std::atomic<std::uint32_t> g_next_thread{0};
+
+    ThreadState& thread_state() {
+        thread_local ThreadState s{g_next_thread.fetch_add(1, std::memory_order_relaxed), {}};
+        return s;
+    }
+
+    std::size_t nbytes(const Tensor& t) { return t.numel() * dtype_size(t.dtype()); }
+
+    std::string format_shape(const Shape& s) {
+        std::string out = "[";
+        for (std::size_t i = 0; i < s.size(); ++i) {
+            if (i) out += ", ";
+            out += std::to_string(s[i]);
+        }
+        return out + "]";
+    }
+
+    void json_string(std::ostringstream& os, const std::string& s) {
+        os << '"';
+        for (char c : s) {
+            switch (c) {
+                case '"':  os << "\\\""; break;
+                case '\\': os << "\\\\"; break;
+                case '\n': os << "\\n";  break;
+                default:
+                    if (static_cast<unsigned char>(c) < 0x20) {
+                        char buf[8];
+                        std::snprintf(buf, sizeof(buf), "\\u%04x", c);
+                        os << buf;
+                    } else {
+                        os << c;
+                    }
+            }
+        }
+        os << '"';
+    }
+
+    // Microsecondes, résolution de la nanoseconde
+    std::string micros(std::int64_t ns) {
+        char buf[32];
+        std::snprintf(buf, sizeof(buf), "%.3f", double(ns) * 1e-3);
+        return buf;
+    }
+}
+
+const char* event_kind_name(EventKind kind) {
+    switch (kind) {
+        case EventKind::Op:       return "op";
+        case EventKind::Backward: return "backward";
+        case EventKind::Module:   return "module";
+        case EventKind::Alloc:    return "alloc";
+        case EventKind::Free:     return "free";
+    }
+    return "unknown";
+}
+
+void start() {
+    std::int64_t unset = 0;
+    sink().origin.compare_exchange_strong(unset, now_ns());
+    detail::g_enabled.store(true, std::memory_order_relaxed);
+}
+
+void stop() {
+    detail::g_enabled.store(false, std::memory_order_relaxed);
+}
+
+void clear() {
+    Sink& s = sink();
+    std::lock_guard<std::mutex> lock(s.mutex);
+    s.events.clear();
+    // Actif : l'origine reste celle de start(), des portées peuvent être
+    // ouvertes ; arrêté : le prochain start() en fixe une nouvelle
+    if (!enabled()) s.origin.store(0);
+}
+
+std::vector<Event> events() {
+    Sink& s = sink();
+    std::lock_guard<std::mutex> lock(s.mutex);
+    return s.events;
+}
+
+void RecordScope::begin(const char* name, EventKind kind) {
+    ThreadState& ts = thread_state();
+    Pending p;
+    p.event.name     = name;
+    p.event.kind     = kind;
+    p.event.thread   = ts.id;
+    p.event.depth    = std::uint32_t(ts.stack.size());
+    p.begin_ns       = now_ns();
+    ts.stack.push_back(std::move(p));
+}
+
+void RecordScope::end() {
+    const std::int64_t t = now_ns();
+    ThreadState& ts = thread_state();
+    Pending p = std::move(ts.stack.back());
+    ts.stack.pop_back();
+    p.event.start_ns    = p.begin_ns - sink().origin.load(std::memory_order_relaxed);
+    p.event.duration_ns = t - p.begin_ns;
+    p.event.self_ns     = p.event.duration_ns - p.child_ns;
+    if (!ts.stack.empty()) ts.stack.back().child_ns += p.event.duration_ns;
+    Sink& s = sink();
+    std::lock_guard<std::mutex> lock(s.mutex);
+    s.events.push_back(std::move(p.event));
+}
+
+void RecordScope::record_io(const std::vector<Tensor>& inputs, const Tensor& output, double flops) {
+    record_io(inputs, std::vector<Tensor>{output}, flops);
+}
+
+void RecordScope::record_io(const std::vector<Tensor>& inputs, const std::vector<Tensor>& outputs,
+                            double flops) {
+    if (!active_) return;
+    Event& e = thread_state().stack.back().event;
+    for (const Tensor& t : inputs) {
+        if (!t.defined()) continue;
+        e.input_shapes.push_back(t.shape());
+        e.bytes_read += nbytes(t);
+    }
+    for (const Tensor& t : outputs)
+        if (t.defined()) e.bytes_written += nbytes(t);
+    e.flops = flops;
+}
+
+void RecordScope::record_alloc(std::size_t bytes, std::size_t bytes_in_use) {
+    if (!active_) return;
+    Event& e = thread_state().stack.back().event;
+    e.bytes_written = bytes;
+    e.bytes_in_use  = bytes_in_use;
+}
+
+std::vector<OpStats> summarize(const std::vector<Event>& events) {
+    std::map<std::pair<EventKind, std::string>, OpStats> by_op;
+    for (const Event& e : events) {
+        OpStats& s = by_op[{e.kind, e.name}];
+        s.name = e.name;
+        s.kind = e.kind;
+        ++s.count;
+        s.total_ns      += e.duration_ns;
+        s.self_ns       += e.self_ns;
+        s.max_ns         = std::max(s.max_ns, e.duration_ns);
+        s.bytes_read    += e.bytes_read;
+        s.bytes_written += e.bytes_written;
+        s.flops         += e.flops;
+    }
+    std::vector<OpStats> out;
+    out.reserve(by_op.size());
+    for (auto& kv : by_op) out.push_back(std::move(kv.second));
+    std::stable_sort(out.begin(), out.end(), [](const OpStats& a, const OpStats& b) {
+        return a.self_ns > b.self_ns;
+    });
+    return out;
+}
+
+std::string format_table(const std::vector<OpStats>& stats, std::size_t max_rows) {
+    std::int64_t all_self = 0;
+    for (const OpStats& s : stats) all_self += s.self_ns;
+    std::ostringstream os;
+    char line[256];
+    std::snprintf(line, sizeof(line), "%-28s %-9s %8s %12s %12s %7s %11s %9s %9s\n",
+                  "name", "kind", "calls", "total (ms)", "self (ms)", "self %",
+                  "avg (us)", "GFLOP/s", "GB/s");
+    os << line << std::string(113, '-') << '\n';
+    const std::size_t rows = max_rows ? std::min(max_rows, stats.size()) : stats.size();
+    for (std::size_t i = 0; i < rows; ++i) {
+        const OpStats& s = stats[i];
+        const double total = double(s.total_ns);
+        const double gflops = total > 0 ? s.flops / total : 0.0;
+        const double gbs = total > 0 ? double(s.bytes_read + s.bytes_written) / total : 0.0;
+        std::snprintf(line, sizeof(line), "%-28.28s %-9s %8zu %12.3f %12.3f %6.1f%% %11.2f %9.2f %9.2f\n",
+                      s.name.c_str(), event_kind_name(s.kind), s.count, total * 1e-6,
+                      double(s.self_ns) * 1e-6,
+                      all_self > 0 ? 100.0 * double(s.self_ns) / double(all_self) : 0.0,
+                      total * 1e-3 / double(s.count), gflops, gbs);
+        os << line;
+    }
+    return os.str();
+}
+
+std::string chrome_trace(const std::vector<Event>& events) {
+    std::ostringstream os;
+    os << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+    bool first = true;
+    auto sep = [&] {
+        if (!first) os << ",\n";
+        first = false;
+    };
+    for (const Event& e : events) {
+        sep();
+        os << "{\"name\":";
+        json_string(os, e.name);
+        os << ",\"cat\":\"" << event_kind_name(e.kind) << "\",\"ph\":\"X\",\"ts\":"
+           << micros(e.start_ns) << ",\"dur\":" << micros(e.duration_ns)
+           << ",\"pid\":0,\"tid\":" << e.thread << ",\"args\":{";
+        if (e.kind == EventKind::Alloc || e.kind == EventKind::Free) {
+            os << "\"bytes\":" << e.bytes_written << ",\"bytes_in_use\":" << e.bytes_in_use << "}}";
+            sep();
+            os << "{\"name\":\"bytes_in_use\",\"ph\":\"C\",\"ts\":"
+               << micros(e.start_ns + e.duration_ns) << ",\"pid\":0,\"args\":{\"bytes\":"
+               << e.bytes_in_use << "}}";
+            continue;
+        }
+        std::string shapes = "[";
+        for (std::size_t i = 0; i < e.input_shapes.size(); ++i) {
+            if (i) shapes += ", ";
+            shapes += format_shape(e.input_shapes[i]);
+        }
+        shapes += "]";
+        os << "\"input_shapes\":";
+        json_string(os, shapes);
+        os << ",\"bytes_read\":" << e.bytes_read << ",\"bytes_written\":" << e.bytes_written
+           << ",\"flops\":" << e.flops << "}}";
+    }
+    os << "]}\n";
+    return os.str();
+}
+
+void export_chrome_trace(const std::vector<Event>& events, const std::string& path) {
+    std::ofstream f(path, std::ios::trunc);
+    if (!f) throw std::runtime_error("profiler: cannot open " + path);
+    f << chrome_trace(events);
+    if (!f) throw std::runtime_error("profiler: write failed (" + path + ")");
+}
+
+} // namespace profiler
+} // namespace napcas
@@ -1,20 +1,233 @@
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>
+#include <pybind11/numpy.h>
+#include <optional>
 
 #include "napcas/tensor.h"
+#include "napcas/lazy.h"
 #include "napcas/common.h"
 #include "napcas/module.h"
+#include "napcas/checkpoint.h"
+#include "napcas/data.h"
+#include "napcas/graph.h"
+#include "napcas/optim.h"
 #include "napcas/autograd.h"
 #include "napcas/grad_fn.h"
 #include "napcas/device.h"
+#include "napcas/dlpack.h"
+#include "napcas/cpu.h"
+#include "napcas/allocator.h"
+#include "napcas/parallel.h"
+#include "napcas/profiler.h"
 #include "napcas/architecture/linear.h"
+#include "napcas/architecture/quantized_linear.h"
+#include "napcas/architecture/conv.h"
 
 namespace py = pybind11;
 using namespace napcas;
 
+// Shape / Strides <-> list Python, comme std::vector
+namespace pybind11 { namespace detail {
+template<typename T, std::size_t N>
+struct type_caster<napcas::SmallVector<T, N>>
+    : list_caster<napcas::SmallVector<T, N>, T> {};
+}} // namespace pybind11::detail
+
+namespace {
+    // Pas, padding, dilatation, fenêtre : entier ou paire (h, w)
+    architecture::Size2 size2(const py::object& v) {
+        if (py::isinstance<py::int_>(v)) {
+            const std::size_t n = v.cast<std::size_t>();
+            return {n, n};
+        }
+        return v.cast<architecture::Size2>();
+    }
+
+    // --- Correspondance DType <-> NumPy / buffer protocol ---
+
+    const char* buffer_format(DType dtype) {
+        switch (dtype) {
+            case DType::Float32: return "f";
+            case DType::Float64: return "d";
+            case DType::Float16: return "e";
+            case DType::Int8:    return "b";
+            case DType::UInt8:   return "B";
+            case DType::Int32:   return "i";
+            case DType::Int64:   return "q";
+            default:
+                throw py::type_error(dtype_to_string(dtype) +
+                    " has no NumPy equivalent; use astype() or DLPack");
+        }
+    }
+
+    // typestr de __array_interface__ (petit-boutiste)
+    std::string array_typestr(DType dtype) {
+        const char kind = dtype == DType::Int8 || dtype == DType::Int32 || dtype == DType::Int64 ? 'i'
+                        : dtype == DType::UInt8 ? 'u' : 'f';
+        buffer_format(dtype);   // rejette bfloat16
+        return std::string(dtype_size(dtype) == 1 ? "|" : "<") + kind +
+               std::to_string(dtype_size(dtype));
+    }
+
+    DType dtype_from_numpy(const py::dtype& dt) {
+        const char kind = dt.kind();
+        const auto size = dt.itemsize();
+        if (kind == 'f' && size == 4) return DType::Float32;
+        if (kind == 'f' && size == 8) return DType::Float64;
+        if (kind == 'f' && size == 2) return DType::Float16;
+        if (kind == 'i' && size == 1) return DType::Int8;
+        if (kind == 'i' && size == 4) return DType::Int32;
+        if (kind == 'i' && size == 8) return DType::Int64;
+        if (kind == 'u' && size == 1) return DType::UInt8;
+        throw py::type_error("from_numpy: unsupported dtype " + py::str(dt).cast<std::string>());
+    }
+
+    std::vector<py::ssize_t> byte_strides(const Tensor& t) {
+        std::vector<py::ssize_t> out(t.ndim());
+        for (std::size_t d = 0; d < t.ndim(); ++d)
+            out[d] = py::ssize_t(t.strides()[d] * std::ptrdiff_t(dtype_size(t.dtype())));
+        return out;
+    }
+
+    void check_cpu(const Tensor& t, const char* what) {
+        if (t.device().type != DeviceType::CPU)
+            throw py::value_error(std::string(what) + ": tensor must be on CPU");
+    }
+
+    // Partage la mémoire de `arr` : le Storage garde une référence au
+    // tableau, relâchée (GIL repris) à sa libération. Seuls les tableaux
+    // inscriptibles et natifs, à strides positifs multiples de l'élément,
+    // sont partagés tels quels ; les autres sont d'abord copiés en C-contigu.
+    // Un tableau en lecture seule (np.frombuffer, memmap 'r') est toujours
+    // copié : add_, out= ou un optimiseur écriraient sinon dans une mémoire
+    // que NumPy garantit constante, voire dans une projection non inscriptible.
+    Tensor tensor_from_numpy(py::array arr) {
+        const DType dtype = dtype_from_numpy(arr.dtype());
+        const auto es = py::ssize_t(dtype_size(dtype));
+        bool shareable = arr.writeable() && arr.dtype().attr("isnative").cast<bool>() &&
+                         reinterpret_cast<std::uintptr_t>(arr.data()) % std::uintptr_t(es) == 0;
+        for (py::ssize_t d = 0; d < arr.ndim() && shareable; ++d)
+            shareable = arr.strides(d) >= 0 && arr.strides(d) % es == 0;
+        if (!shareable) {
+            // np.array(copy=True) : ascontiguousarray rendrait tel quel un
+            // tableau déjà contigu
+            py::object native = arr.dtype().attr("newbyteorder")("=");
+            arr = py::module_::import("numpy").attr("array")(
+                arr, native, py::arg("copy") = true, py::arg("order") = "C");
+        }
+
+        Shape   shape(arr.ndim());
+        Strides strides(arr.ndim());
+        std::size_t numel = 1, extent = 1;
+        for (py::ssize_t d = 0; d < arr.ndim(); ++d) {
+            shape[d]   = std::size_t(arr.shape(d));
+            strides[d] = std::ptrdiff_t(arr.strides(d) / es);
+            numel  *= shape[d];
+            extent += (shape[d] ? shape[d] - 1 : 0) * std::size_t(strides[d]);
+        }
+        if (numel == 0) extent = 0;
+
+        auto* keep = new py::object(arr);
+        auto storage = std::make_shared<Storage>(
+            const_cast<void*>(arr.data()), extent * std::size_t(es), Device{DeviceType::CPU, 0},
+            [keep](void*) {
+                if (!Py_IsInitialized()) return;
+                py::gil_scoped_acquire gil;
+                delete keep;
+            });
+        return Tensor::from_storage(std::move(storage), shape, strides, dtype);
+    }
+
+    // Vue NumPy : le tableau garde une copie superficielle du Tensor
+    py::array tensor_to_numpy(const Tensor& t) {
+        check_cpu(t, "numpy");
+        py::dtype dt(std::string(buffer_format(t.dtype())));
+        auto* keep = new Tensor(t.detach());
+        py::capsule base(keep, [](void* p) { delete static_cast<Tensor*>(p); });
+        std::vector<py::ssize_t> shape(t.shape().begin(), t.shape().end());
+        return py::array(dt, shape, byte_strides(t), keep->data_ptr(), base);
+    }
+
+    void dlpack_capsule_deleter(PyObject* capsule) {
+        // Capsule consommée : le consommateur est responsable du deleter
+        if (PyCapsule_IsValid(capsule, "used_dltensor")) return;
+        auto* managed = static_cast<DLManagedTensor*>(PyCapsule_GetPointer(capsule, "dltensor"));
+        if (!managed) { PyErr_Clear(); return; }
+        if (managed->deleter) managed->deleter(managed);
+    }
+
+    // --- Réductions ---
+
+    // dims Python : None (toutes les dimensions), un entier ou une séquence
+    std::vector<int> reduce_dims(const py::object& dims) {
+        if (dims.is_none()) return {};
+        if (py::isinstance<py::int_>(dims)) return {dims.cast<int>()};
+        return dims.cast<std::vector<int>>();
+    }
+
+    using Reduction = Tensor (Tensor::*)(const std::vector<int>&, bool) const;
+    using Moment    = Tensor (Tensor::*)(const std::vector<int>&, std::size_t, bool) const;
+
+    // Le GIL est relâché une fois `dims` converti
+    auto bind_reduction(Reduction fn) {
+        return [fn](const Tensor& t, const py::object& dims, bool keepdim) {
+            const std::vector<int> d = reduce_dims(dims);
+            py::gil_scoped_release nogil;
+            return (t.*fn)(d, keepdim);
+        };
+    }
+
+    using InPlace = Tensor& (Tensor::*)(const Tensor&);
+    using BinaryOut = Tensor& (*)(Tensor&, const Tensor&, const Tensor&);
+
+    // add_ / __iadd__ ... : renvoient l'objet Python lui-même
+    auto bind_inplace(InPlace fn) {
+        return [fn](py::object self, const Tensor& other) {
+            Tensor& t = self.cast<Tensor&>();
+            {
+                py::gil_scoped_release nogil;
+                (t.*fn)(other);
+            }
+            return self;
+        };
+    }
+
+    // napcas.add(a, b, out=None) ... : nouveau Tensor, ou écrit dans `out`
+    auto bind_binary(Tensor (Tensor::*fn)(const Tensor&) const, BinaryOut out_fn) {
+        return [fn, out_fn](const Tensor& a, const Tensor& b, py::object out) -> py::object {
+            if (out.is_none()) {
+                Tensor r;
+                {
+                    py::gil_scoped_release nogil;
+                    r = (a.*fn)(b);
+                }
+                return py::cast(std::move(r));
+            }
+            Tensor& o = out.cast<Tensor&>();
+            {
+                py::gil_scoped_release nogil;
+                out_fn(o, a, b);
+            }
+            return out;
+        };
+    }
+
+    auto bind_moment(Moment fn) {
+        return [fn](const Tensor& t, const py::object& dims, std::size_t correction, bool keepdim) {
+            const std::vector<int> d = reduce_dims(dims);
+            py::gil_scoped_release nogil;
+            return (t.*fn)(d, correction, keepdim);
+        };
+    }
+}
+
 PYBIND11_MODULE(_napcas, m) {
     m.doc() = "napcas C++ backend";
 
+    // Calcul sans GIL : les points d'entrée coûteux ne touchent à aucun objet
+    // Python pendant l'appel (arguments convertis avant, résultat après).
+    using release_gil = py::call_guard<py::gil_scoped_release>;
+
     // --- DeviceType enum ---
     py::enum_<DeviceType>(m, "DeviceType")
         .value("CPU",  DeviceType::CPU)
@@ -23,10 +236,42 @@ PYBIND11_MODULE(_napcas, m) {
 
     // --- DType enum ---
     py::enum_<DType>(m, "DType")
-        .value("Float32", DType::Float32)
-        .value("Int32",   DType::Int32)
+        .value("Float32",  DType::Float32)
+        .value("Int32",    DType::Int32)
+        .value("Float16",  DType::Float16)
+        .value("BFloat16", DType::BFloat16)
+        .value("Float64",  DType::Float64)
+        .value("Int8",     DType::Int8)
+        .value("UInt8",    DType::UInt8)
+        .value("Int64",    DType::Int64)
         .export_values();
 
+    // --- Binary ops with out= ---
+    m.def("add", bind_binary(&Tensor::operator+, &add_out),
+          py::arg("a"), py::arg("b"), py::arg("out") = py::none());
+    m.def("sub", bind_binary(&Tensor::operator-, &sub_out),
+          py::arg("a"), py::arg("b"), py::arg("out") = py::none());
+    m.def("mul", bind_binary(&Tensor::operator*, &mul_out),
+          py::arg("a"), py::arg("b"), py::arg("out") = py::none());
+    m.def("div", bind_binary(&Tensor::operator/, &div_out),
+          py::arg("a"), py::arg("b"), py::arg("out") = py::none());
+
+    // --- Activation enum (épilogues fusionnés) ---
+    py::enum_<kernels::Activation>(m, "Activation")
+        .value("Identity", kernels::Activation::None)
+        .value("ReLU",     kernels::Activation::ReLU)
+        .value("GELU",     kernels::Activation::GELU)
+        .value("SiLU",     kernels::Activation::SiLU);
+
+    py::enum_<kernels::ConvAlgorithm>(m, "ConvAlgorithm")
+        .value("Auto",      kernels::ConvAlgorithm::Auto)
+        .value("Im2col",    kernels::ConvAlgorithm::Im2col)
+        .value("Depthwise", kernels::ConvAlgorithm::Depthwise)
+        .value("Winograd",  kernels::ConvAlgorithm::Winograd);
+
+    m.def("promote_types", &promote_types, py::arg("a"), py::arg("b"),
+          "Type du résultat d'une opération binaire entre deux dtypes");
+
     // --- Device struct ---
     py::class_<Device>(m, "Device")
         .def(py::init<DeviceType, int>(),
@@ -38,34 +283,192 @@ PYBIND11_MODULE(_napcas, m) {
         .def("__str__",         &Device::to_string)
         ;
 
+    // --- CPU ---
+    m.def("cpu_capability",
+          []() { return cpu_capability_to_string(cpu_capability()); },
+          "Jeu d'instructions SIMD utilisé par les noyaux");
+
+    // --- Threads ---
+    m.def("set_num_threads", &set_num_threads, release_gil(), py::arg("n"),
+          "Nombre de threads du pool partagé (défaut : NAPCAS_NUM_THREADS ou nb de cœurs)");
+    m.def("get_num_threads", &get_num_threads);
+
+    // --- Allocateur CPU ---
+    m.def("allocator_stats", []() {
+        AllocatorStats s = allocator_stats();
+        py::dict d;
+        d["bytes_in_use"]      = s.bytes_in_use;
+        d["peak_bytes_in_use"] = s.peak_bytes_in_use;
+        d["bytes_cached"]      = s.bytes_cached;
+        d["num_allocs"]        = s.num_allocs;
+        d["cache_hits"]        = s.cache_hits;
+        d["hit_rate"]          = s.hit_rate();
+        return d;
+    });
+    m.def("reset_peak_stats", &reset_peak_stats);
+    m.def("empty_cache", &empty_cache, release_gil(),
+          "Rend au système les blocs CPU libres conservés en cache");
+
+    // --- Profileur (enveloppé par napcas.profiler.profile) ---
+    auto m_prof = m.def_submodule("profiler");
+    py::enum_<profiler::EventKind>(m_prof, "EventKind")
+        .value("Op",       profiler::EventKind::Op)
+        .value("Backward", profiler::EventKind::Backward)
+        .value("Module",   profiler::EventKind::Module)
+        .value("Alloc",    profiler::EventKind::Alloc)
+        .value("Free",     profiler::EventKind::Free);
+    py::class_<profiler::Event>(m_prof, "Event")
+        .def_readonly("name",          &profiler::Event::name)
+        .def_readonly("kind",          &profiler::Event::kind)
+        .def_readonly("thread",        &profiler::Event::thread)
+        .def_readonly("depth",         &profiler::Event::depth)
+        .def_readonly("start_ns",      &profiler::Event::start_ns)
+        .def_readonly("duration_ns",   &profiler::Event::duration_ns)
+        .def_readonly("self_ns",       &profiler::Event::self_ns)
+        .def_readonly("input_shapes",  &profiler::Event::input_shapes)
+        .def_readonly("bytes_read",    &profiler::Event::bytes_read)
+        .def_readonly("bytes_written", &profiler::Event::bytes_written)
+        .def_readonly("flops",         &profiler::Event::flops)
+        .def_readonly("bytes_in_use",  &profiler::Event::bytes_in_use)
+        .def("__repr__", [](const profiler::Event& e) {
+            return "<Event " + e.name + " (" + profiler::event_kind_name(e.kind) + ") " +
+                   std::to_string(e.duration_ns) + " ns>";
+        });
+    py::class_<profiler::OpStats>(m_prof, "OpStats")
+        .def_readonly("name",          &profiler::OpStats::name)
+        .def_readonly("kind",          &profiler::OpStats::kind)
+        .def_readonly("count",         &profiler::OpStats::count)
+        .def_readonly("total_ns",      &profiler::OpStats::total_ns)
+        .def_readonly("self_ns",       &profiler::OpStats::self_ns)
+        .def_readonly("max_ns",        &profiler::OpStats::max_ns)
+        .def_readonly("bytes_read",    &profiler::OpStats::bytes_read)
+        .def_readonly("bytes_written", &profiler::OpStats::bytes_written)
+        .def_readonly("flops",         &profiler::OpStats::flops);
+    m_prof.def("start",   &profiler::start);
+    m_prof.def("stop",    &profiler::stop);
+    m_prof.def("clear",   &profiler::clear);
+    m_prof.def("enabled", &profiler::enabled);
+    m_prof.def("events",  &profiler::events);
+    m_prof.def("summarize", &profiler::summarize, py::arg("events"));
+    m_prof.def("format_table", &profiler::format_table,
+               py::arg("stats"), py::arg("max_rows") = 0);
+    m_prof.def("chrome_trace", &profiler::chrome_trace, py::arg("events"));
+    m_prof.def("export_chrome_trace", &profiler::export_chrome_trace, release_gil(),
+               py::arg("events"), py::arg("path"));
+
     // --- Tensor ---
-    py::class_<Tensor, std::shared_ptr<Tensor>>(m, "Tensor")
+    py::class_<Tensor, std::shared_ptr<Tensor>>(m, "Tensor", py::buffer_protocol())
         // constructors
         .def(py::init<>())
+        .def(py::init<const Shape&, const std::vector<double>&, DType, Device>(),
+             release_gil(), py::arg("shape"), py::arg("data"),
+             py::arg("dtype") = DType::Float32, py::arg("device") = Device{DeviceType::CPU,0})
+        .def(py::init<const Shape&, DType, Device>(),
+             release_gil(), py::arg("shape"),
+             py::arg("dtype") = DType::Float32, py::arg("device") = Device{DeviceType::CPU,0})
+        // NumPy / buffer protocol / DLPack (sans copie)
+        .def_static("from_numpy", &tensor_from_numpy, py::arg("array"),
+             "Tensor partageant la mémoire du tableau (copie seulement si non natif/strides négatifs)")
+        .def("numpy", &tensor_to_numpy, "Vue NumPy sur les mêmes données")
+        .def_buffer([](Tensor& t) -> py::buffer_info {
+            check_cpu(t, "buffer");
+            std::vector<py::ssize_t> shape(t.shape().begin(), t.shape().end());
+            return py::buffer_info(t.data_ptr(), py::ssize_t(dtype_size(t.dtype())),
+                                   buffer_format(t.dtype()), py::ssize_t(t.ndim()),
+                                   shape, byte_strides(t));
+        })
+        .def_property_readonly("__array_interface__", [](const Tensor& t) {
+            check_cpu(t, "__array_interface__");
+            py::dict d;
+            d["shape"]   = py::tuple(py::cast(t.shape()));
+            d["typestr"] = array_typestr(t.dtype());
+            d["data"]    = py::make_tuple(reinterpret_cast<std::uintptr_t>(t.data_ptr()), false);
+            d["strides"] = py::tuple(py::cast(byte_strides(t)));
+            d["version"] = 3;
+            return d;
+        })
+        .def("__dlpack__", [](const Tensor& t, py::object /*stream*/) {
+            DLManagedTensor* managed = to_dlpack(t);
+            PyObject* capsule = PyCapsule_New(managed, "dltensor", &dlpack_capsule_deleter);
+            if (!capsule) {
+                managed->deleter(managed);
+                throw py::error_already_set();
+            }
+            return py::reinterpret_steal<py::capsule>(capsule);
+        }, py::arg("stream") = py::none())
+        .def("__dlpack_device__", [](const Tensor& t) {
+            check_cpu(t, "__dlpack_device__");
+            return py::make_tuple(int(kDLCPU), 0);
+        })
         // static factories
-        .def_static("ones",  &Tensor::ones,
+        .def_static("ones",  &Tensor::ones, release_gil(),
              py::arg("shape"), py::arg("dtype") = DType::Float32, py::arg("device") = Device{DeviceType::CPU,0})
-        .def_static("zeros", &Tensor::zeros,
+        .def_static("zeros", &Tensor::zeros, release_gil(),
              py::arg("shape"), py::arg("dtype") = DType::Float32, py::arg("device") = Device{DeviceType::CPU,0})
         // metadata
         .def("shape",        &Tensor::shape)
         .def("numel",        &Tensor::numel)
         .def("is_contiguous", &Tensor::is_contiguous)
+        .def("storage_offset", &Tensor::storage_offset)
         .def("dtype",        &Tensor::dtype)
         .def("device",       &Tensor::device)
         // basic ops
-        .def("__add__",      &Tensor::operator+)
-        .def("__sub__",      &Tensor::operator-)
-        .def("__mul__",      &Tensor::operator*)
-        .def("__truediv__",  &Tensor::operator/)
-        .def("matmul",       &Tensor::matmul)
+        .def("__add__",      &Tensor::operator+, release_gil())
+        .def("__sub__",      &Tensor::operator-, release_gil())
+        .def("__mul__",      &Tensor::operator*, release_gil())
+        .def("__truediv__",  &Tensor::operator/, release_gil())
+        // in-place ops (no allocation; bump the storage version)
+        .def("add_",         bind_inplace(&Tensor::add_))
+        .def("sub_",         bind_inplace(&Tensor::sub_))
+        .def("mul_",         bind_inplace(&Tensor::mul_))
+        .def("div_",         bind_inplace(&Tensor::div_))
+        .def("__iadd__",     bind_inplace(&Tensor::add_))
+        .def("__isub__",     bind_inplace(&Tensor::sub_))
+        .def("__imul__",     bind_inplace(&Tensor::mul_))
+        .def("__itruediv__", bind_inplace(&Tensor::div_))
+        .def_property_readonly("_version", &Tensor::version)
+        .def("matmul",       &Tensor::matmul, release_gil())
+        .def("exp",          &Tensor::exp, release_gil())
+        // reductions
+        .def("sum",       bind_reduction(&Tensor::sum),  py::arg("dims") = py::none(), py::arg("keepdim") = false)
+        .def("mean",      bind_reduction(&Tensor::mean), py::arg("dims") = py::none(), py::arg("keepdim") = false)
+        .def("max",       bind_reduction(&Tensor::max),  py::arg("dims") = py::none(), py::arg("keepdim") = false)
+        .def("min",       bind_reduction(&Tensor::min),  py::arg("dims") = py::none(), py::arg("keepdim") = false)
+        .def("argmax",    bind_reduction(&Tensor::argmax), py::arg("dims") = py::none(), py::arg("keepdim") = false)
+        .def("argmin",    bind_reduction(&Tensor::argmin), py::arg("dims") = py::none(), py::arg("keepdim") = false)
+        .def("logsumexp", bind_reduction(&Tensor::logsumexp), py::arg("dims") = py::none(), py::arg("keepdim") = false)
+        .def("var",       bind_moment(&Tensor::var), py::arg("dims") = py::none(),
+             py::arg("correction") = 1, py::arg("keepdim") = false)
+        .def("std",       bind_moment(&Tensor::std), py::arg("dims") = py::none(),
+             py::arg("correction") = 1, py::arg("keepdim") = false)
+        // fused activations / normalizations
+        .def("relu",        &Tensor::relu, release_gil())
+        .def("gelu",        &Tensor::gelu, release_gil())
+        .def("silu",        &Tensor::silu, release_gil())
+        .def("softmax",     &Tensor::softmax, release_gil(), py::arg("dim") = -1)
+        .def("log_softmax", &Tensor::log_softmax, release_gil(), py::arg("dim") = -1)
+        .def("layer_norm", [](const Tensor& t, const std::optional<Tensor>& weight,
+                              const std::optional<Tensor>& bias, double eps) {
+                 return t.layer_norm(weight.value_or(Tensor()), bias.value_or(Tensor()), eps);
+             }, release_gil(), py::arg("weight") = py::none(), py::arg("bias") = py::none(),
+             py::arg("eps") = 1e-5)
+        .def("rms_norm", [](const Tensor& t, const std::optional<Tensor>& weight, double eps) {
+                 return t.rms_norm(weight.value_or(Tensor()), eps);
+             }, release_gil(), py::arg("weight") = py::none(), py::arg("eps") = 1e-6)
         // transforms
-        .def("clone",        &Tensor::clone)
+        .def("clone",        &Tensor::clone, release_gil())
         .def("detach",       &Tensor::detach)
-        .def("reshape",      &Tensor::reshape)
+        .def("reshape",      &Tensor::reshape, release_gil())
         .def("view",         &Tensor::view)
-        .def("to",           &Tensor::to)
-        .def("astype",       &Tensor::astype)
+        .def("permute",      &Tensor::permute)
+        .def("transpose",    &Tensor::transpose)
+        .def("squeeze",      &Tensor::squeeze, py::arg("dim") = -1)
+        .def("unsqueeze",    &Tensor::unsqueeze)
+        .def("contiguous",   &Tensor::contiguous, release_gil())
+        .def("expand",       &Tensor::expand)
+        .def("sum_to_size",  &Tensor::sum_to_size, release_gil())
+        .def("to",           &Tensor::to, release_gil())
+        .def("astype",       &Tensor::astype, release_gil())
         // autograd interface
         .def("requires_grad_", &Tensor::requires_grad_)
         .def("requires_grad",  &Tensor::requires_grad)
@@ -76,12 +479,53 @@ PYBIND11_MODULE(_napcas, m) {
         .def("grad_", 
              static_cast<const Tensor& (Tensor::*)() const>(&Tensor::grad),
              "Const‐version of grad")
-        .def("backward", &Tensor::backward)
+        .def("has_grad",  &Tensor::has_grad)
+        .def("zero_grad", &Tensor::zero_grad)
+        .def("backward", static_cast<void (Tensor::*)()>(&Tensor::backward), release_gil())
+        .def("backward", static_cast<void (Tensor::*)(const Tensor&, bool)>(&Tensor::backward),
+             release_gil(), py::arg("grad_output"), py::arg("retain_graph") = false)
         // debugging
         .def("print_shape",   &Tensor::print_shape)
         .def("print_summary", &Tensor::print_summary)
+        .def("lazy", [](const Tensor& t) { return LazyTensor(t); },
+             "Expression différée : les opérations suivantes sont fusionnées jusqu'à eval()")
         ;
 
+    m.def("from_dlpack", [](py::object obj) {
+        py::object capsule = py::hasattr(obj, "__dlpack__") ? obj.attr("__dlpack__")() : obj;
+        PyObject* p = capsule.ptr();
+        if (!PyCapsule_IsValid(p, "dltensor"))
+            throw py::value_error("from_dlpack: expected an unconsumed DLPack capsule");
+        auto* managed = static_cast<DLManagedTensor*>(PyCapsule_GetPointer(p, "dltensor"));
+        Tensor t = from_dlpack(managed);   // ne consomme qu'en cas de succès
+        PyCapsule_SetName(p, "used_dltensor");
+        return t;
+    }, py::arg("obj"), "Importe sans copie un objet DLPack (capsule ou objet exposant __dlpack__)");
+
+    // --- LazyTensor ---
+    // Les entiers Python restent des constantes entières (dtype conservé),
+    // les flottants promeuvent un tenseur entier en float32.
+    py::class_<LazyTensor> lazy(m, "LazyTensor");
+    lazy.def(py::init<const Tensor&>(), py::arg("tensor"))
+        .def("shape",         &LazyTensor::shape)
+        .def("dtype",         &LazyTensor::dtype)
+        .def("requires_grad", &LazyTensor::requires_grad)
+        .def("eval",          &LazyTensor::eval, release_gil());
+    auto def_lazy_op = [&](const char* name, const char* rname,
+                           LazyTensor (*op)(const LazyTensor&, const LazyTensor&)) {
+        lazy.def(name,  [op](const LazyTensor& a, const LazyTensor& b)   { return op(a, b); })
+            .def(name,  [op](const LazyTensor& a, const Tensor& b)       { return op(a, b); })
+            .def(name,  [op](const LazyTensor& a, std::int64_t b)        { return op(a, b); })
+            .def(name,  [op](const LazyTensor& a, double b)              { return op(a, b); })
+            .def(rname, [op](const LazyTensor& a, const Tensor& b)       { return op(b, a); })
+            .def(rname, [op](const LazyTensor& a, std::int64_t b)        { return op(b, a); })
+            .def(rname, [op](const LazyTensor& a, double b)              { return op(b, a); });
+    };
+    def_lazy_op("__add__",     "__radd__",     &napcas::operator+);
+    def_lazy_op("__sub__",     "__rsub__",     &napcas::operator-);
+    def_lazy_op("__mul__",     "__rmul__",     &napcas::operator*);
+    def_lazy_op("__truediv__", "__rtruediv__", &napcas::operator/);
+
 
     // --- Module ---
     py::class_<Module, std::shared_ptr<Module>>(m, "Module")
@@ -94,16 +538,175 @@ PYBIND11_MODULE(_napcas, m) {
         .def("modules",            &Module::modules)
         .def("state_dict",         &Module::state_dict)
         .def("load_state_dict",    &Module::load_state_dict)
+        .def("save",               &Module::save, release_gil(), py::arg("path"))
+        .def("load",               &Module::load, release_gil(), py::arg("path"))
+        ;
+
+    // --- Checkpoints (mmap, zero-copy) ---
+    m.def("save_checkpoint", &checkpoint::save, release_gil(),
+          py::arg("path"), py::arg("tensors"));
+    m.def("load_checkpoint", &checkpoint::load, release_gil(), py::arg("path"),
+          "Tensors backed directly by a private memory mapping of the file");
+
+    // --- Capture et rejeu de graphe ---
+    py::class_<Graph>(m, "Graph")
+        .def_static("capture", [](py::function fn, const std::vector<Tensor>& inputs) {
+            // `fn` reçoit la liste des entrées, renvoie un Tensor ou une séquence
+            return Graph::capture([&fn](const std::vector<Tensor>& in) {
+                py::object out = fn(in);
+                if (py::isinstance<Tensor>(out))
+                    return std::vector<Tensor>{out.cast<Tensor>()};
+                return out.cast<std::vector<Tensor>>();
+            }, inputs);
+        }, py::arg("fn"), py::arg("inputs"),
+           "Record one execution of fn(inputs) into a static, memory-planned plan")
+        .def_static("capture", py::overload_cast<Module&, const Tensor&>(&Graph::capture),
+                    py::arg("module"), py::arg("input"))
+        .def("replay", py::overload_cast<const std::vector<Tensor>&>(&Graph::replay),
+             release_gil(), py::arg("inputs"),
+             "Outputs are views of the graph's buffers, overwritten by the next replay")
+        .def("replay", py::overload_cast<>(&Graph::replay), release_gil())
+        .def_property_readonly("inputs",  &Graph::inputs)
+        .def_property_readonly("outputs", &Graph::outputs)
+        .def_property_readonly("ops", &Graph::ops)
+        .def_property_readonly("arena_bytes", &Graph::arena_bytes)
+        .def_property_readonly("unpooled_bytes", &Graph::unpooled_bytes)
         ;
 
     // --- Autograd ---
     py::class_<Autograd, std::shared_ptr<Autograd>>(m, "Autograd")
         .def(py::init<>())
-        .def("backward", &Autograd::backward,
+        .def("backward", &Autograd::backward, release_gil(),
              py::arg("tensor"), py::arg("retain_graph") = false)
         ;
-        
-        
+
+    // --- Optimiseurs fusionnés ---
+    auto m_optim = m.def_submodule("optim");
+    py::class_<optim::Optimizer>(m_optim, "Optimizer")
+        .def("step", &optim::Optimizer::step, release_gil(),
+             "One fused update of every parameter; returns the global grad norm when clipping")
+        .def("zero_grad", &optim::Optimizer::zero_grad, release_gil(),
+             "Zero existing gradients in place (no allocation)")
+        .def("parameters", &optim::Optimizer::parameters)
+        .def_property("lr", &optim::Optimizer::lr, &optim::Optimizer::set_lr)
+        .def_property("max_grad_norm", &optim::Optimizer::max_grad_norm,
+                      &optim::Optimizer::set_max_grad_norm)
+        .def_property_readonly("steps", &optim::Optimizer::steps)
+        .def_property_readonly("state_bytes", &optim::Optimizer::state_bytes)
+        ;
+    py::class_<optim::SGD, optim::Optimizer>(m_optim, "SGD")
+        .def(py::init<std::vector<Tensor>, float, float, float, bool, float>(),
+             py::arg("params"), py::arg("lr"), py::arg("momentum") = 0.0f,
+             py::arg("weight_decay") = 0.0f, py::arg("nesterov") = false,
+             py::arg("max_grad_norm") = 0.0f)
+        .def_property_readonly("momentum",     &optim::SGD::momentum)
+        .def_property_readonly("weight_decay", &optim::SGD::weight_decay)
+        .def_property_readonly("nesterov",     &optim::SGD::nesterov)
+        .def("momentum_buffer", &optim::SGD::momentum_buffer, py::arg("index"))
+        ;
+    py::class_<optim::Adam, optim::Optimizer>(m_optim, "Adam")
+        .def(py::init<std::vector<Tensor>, float, float, float, float, float, float>(),
+             py::arg("params"), py::arg("lr") = 1e-3f, py::arg("beta1") = 0.9f,
+             py::arg("beta2") = 0.999f, py::arg("eps") = 1e-8f, py::arg("weight_decay") = 0.0f,
+             py::arg("max_grad_norm") = 0.0f)
+        .def_property_readonly("beta1",        &optim::Adam::beta1)
+        .def_property_readonly("beta2",        &optim::Adam::beta2)
+        .def_property_readonly("eps",          &optim::Adam::eps)
+        .def_property_readonly("weight_decay", &optim::Adam::weight_decay)
+        .def("exp_avg",    &optim::Adam::exp_avg,    py::arg("index"))
+        .def("exp_avg_sq", &optim::Adam::exp_avg_sq, py::arg("index"))
+        ;
+    py::class_<optim::AdamW, optim::Adam>(m_optim, "AdamW")
+        .def(py::init<std::vector<Tensor>, float, float, float, float, float, float>(),
+             py::arg("params"), py::arg("lr") = 1e-3f, py::arg("beta1") = 0.9f,
+             py::arg("beta2") = 0.999f, py::arg("eps") = 1e-8f, py::arg("weight_decay") = 1e-2f,
+             py::arg("max_grad_norm") = 0.0f)
+        ;
+
+    // --- Chargement de données ---
+    auto m_data = m.def_submodule("data");
+    py::class_<data::Field>(m_data, "Field")
+        .def(py::init([](std::string name, DType dtype, const Shape& shape) {
+                 return data::Field{std::move(name), dtype, shape};
+             }),
+             py::arg("name"), py::arg("dtype") = DType::Float32, py::arg("shape") = Shape{})
+        .def_readonly("name",  &data::Field::name)
+        .def_readonly("dtype", &data::Field::dtype)
+        .def_readonly("shape", &data::Field::shape)
+        .def_property_readonly("nbytes", &data::Field::bytes)
+        ;
+    py::enum_<data::ReadMode>(m_data, "ReadMode")
+        .value("Mmap",  data::ReadMode::Mmap)
+        .value("Pread", data::ReadMode::Pread);
+    py::class_<data::RecordDataset, std::shared_ptr<data::RecordDataset>>(m_data, "RecordDataset")
+        .def(py::init<std::vector<std::string>, std::vector<data::Field>, std::size_t, data::ReadMode>(),
+             py::arg("paths"), py::arg("fields"), py::arg("header_bytes") = 0,
+             py::arg("mode") = data::ReadMode::Mmap)
+        .def("__len__", &data::RecordDataset::size)
+        .def_property_readonly("record_bytes", &data::RecordDataset::record_bytes)
+        .def_property_readonly("fields",       &data::RecordDataset::fields)
+        .def_property_readonly("mode",         &data::RecordDataset::mode)
+        ;
+    py::class_<data::LoaderStats>(m_data, "LoaderStats")
+        .def_readonly("batches",        &data::LoaderStats::batches)
+        .def_readonly("samples",        &data::LoaderStats::samples)
+        .def_readonly("bytes",          &data::LoaderStats::bytes)
+        .def_readonly("elapsed_ns",     &data::LoaderStats::elapsed_ns)
+        .def_readonly("stall_ns",       &data::LoaderStats::stall_ns)
+        .def_readonly("read_ns",        &data::LoaderStats::read_ns)
+        .def_readonly("worker_idle_ns", &data::LoaderStats::worker_idle_ns)
+        .def_readonly("ring_size",      &data::LoaderStats::ring_size)
+        .def("__repr__", [](const data::LoaderStats& s) {
+            return "<LoaderStats " + std::to_string(s.batches) + " batches, stall " +
+                   std::to_string(s.stall_ns / 1000000) + "/" +
+                   std::to_string(s.elapsed_ns / 1000000) + " ms>";
+        });
+    // Itérateur : iter() commence une époque, chaque lot est un tuple de
+    // Tensor (un par champ) qui partagent le tampon du chargeur
+    py::class_<data::DataLoader>(m_data, "DataLoader")
+        .def(py::init([](std::shared_ptr<data::RecordDataset> dataset, std::size_t batch_size,
+                         bool shuffle, std::uint64_t seed, bool drop_last, std::size_t num_workers,
+                         std::size_t prefetch, bool pin_memory) {
+                 data::LoaderOptions opt;
+                 opt.batch_size  = batch_size;
+                 opt.shuffle     = shuffle;
+                 opt.seed        = seed;
+                 opt.drop_last   = drop_last;
+                 opt.num_workers = num_workers;
+                 opt.prefetch    = prefetch;
+                 opt.pin_memory  = pin_memory;
+                 return std::make_unique<data::DataLoader>(std::move(dataset), opt);
+             }),
+             py::arg("dataset"), py::arg("batch_size") = 32, py::arg("shuffle") = true,
+             py::arg("seed") = 0, py::arg("drop_last") = false, py::arg("num_workers") = 2,
+             py::arg("prefetch") = 4, py::arg("pin_memory") = false)
+        .def("__len__", &data::DataLoader::num_batches)
+        .def("__iter__", [](py::object self) {
+            data::DataLoader& loader = self.cast<data::DataLoader&>();
+            {
+                py::gil_scoped_release nogil;
+                loader.start_epoch();
+            }
+            return self;
+        })
+        .def("__next__", [](data::DataLoader& self) {
+            std::vector<Tensor> batch;
+            {
+                py::gil_scoped_release nogil;
+                batch = self.next();
+            }
+            if (batch.empty()) throw py::stop_iteration();
+            py::tuple out(batch.size());
+            for (std::size_t i = 0; i < batch.size(); ++i) out[i] = py::cast(std::move(batch[i]));
+            return out;
+        })
+        .def("start_epoch", &data::DataLoader::start_epoch, release_gil())
+        .def_property_readonly("epoch", &data::DataLoader::epoch)
+        .def("stats", &data::DataLoader::stats)
+        .def("reset_stats", &data::DataLoader::reset_stats)
+        ;
+
+
     // --- architecture submodule ---
      auto m_arch = m.def_submodule("architecture");
  
@@ -111,20 +714,133 @@ PYBIND11_MODULE(_napcas, m) {
      py::class_<napcas::architecture::Linear,
                 Module,
                 std::shared_ptr<architecture::Linear>>(m_arch, "Linear")
-        .def(py::init<int,int,bool, DType,Device>(),
+        .def(py::init<int,int,bool, DType,Device,kernels::Activation>(),
              py::arg("in_features"),
              py::arg("out_features"),
              py::arg("bias")   = true,
              py::arg("dtype")  = DType::Float32,
-             py::arg("device") = Device{DeviceType::CPU,0})
-        .def("forward",        &architecture::Linear::forward)
-        .def("__call__",       &architecture::Linear::operator())
+             py::arg("device") = Device{DeviceType::CPU,0},
+             py::arg("activation") = kernels::Activation::None)
+        .def("forward",        &architecture::Linear::forward, release_gil())
+        .def("__call__",       &architecture::Linear::operator(), release_gil())
         .def("reset_parameters",&architecture::Linear::reset_parameters)
         .def_property_readonly("in_features",  &architecture::Linear::in_features)
         .def_property_readonly("out_features", &architecture::Linear::out_features)
         .def_property_readonly("weight",       &architecture::Linear::weight)
         .def_property_readonly("bias",         &architecture::Linear::bias)
-         ;    
+        .def_property_readonly("activation",   &architecture::Linear::activation)
+         ;
+
+     m_arch.def("linear", [](const Tensor& input, const Tensor& weight,
+                             const std::optional<Tensor>& bias, kernels::Activation activation) {
+             return architecture::linear(input, weight, bias.value_or(Tensor()), activation);
+         }, release_gil(), py::arg("input"), py::arg("weight"), py::arg("bias") = py::none(),
+         py::arg("activation") = kernels::Activation::None);
+
+     // Linear quantifié int8 (inférence), construit depuis une couche Linear
+     py::class_<architecture::QuantizedLinear, Module,
+                std::shared_ptr<architecture::QuantizedLinear>>(m_arch, "QuantizedLinear")
+        .def(py::init<const architecture::Linear&>(), py::arg("linear"))
+        .def("forward",  &architecture::QuantizedLinear::forward, release_gil())
+        .def("__call__", &architecture::QuantizedLinear::operator(), release_gil())
+        .def("dequantized_weight", &architecture::QuantizedLinear::dequantized_weight)
+        .def_property_readonly("in_features",  &architecture::QuantizedLinear::in_features)
+        .def_property_readonly("out_features", &architecture::QuantizedLinear::out_features)
+        .def_property_readonly("bias",         &architecture::QuantizedLinear::bias)
+        .def_property_readonly("activation",   &architecture::QuantizedLinear::activation)
+        .def_property_readonly_static("kernel", [](py::object) {
+             return std::string(kernels::qgemm_kernel_name());
+         })
+         ;
+
+     // Convolution et pooling : tailles entières ou paires (h, w)
+     py::class_<architecture::Conv2d, Module,
+                std::shared_ptr<architecture::Conv2d>>(m_arch, "Conv2d")
+        .def(py::init([](int in_channels, int out_channels, const py::object& kernel_size,
+                         const py::object& stride, const py::object& padding,
+                         const py::object& dilation, int groups, bool bias, DType dtype,
+                         Device device) {
+                 return std::make_shared<architecture::Conv2d>(
+                     in_channels, out_channels, size2(kernel_size), size2(stride),
+                     size2(padding), size2(dilation), groups, bias, dtype, device);
+             }),
+             py::arg("in_channels"), py::arg("out_channels"), py::arg("kernel_size"),
+             py::arg("stride") = 1, py::arg("padding") = 0, py::arg("dilation") = 1,
+             py::arg("groups") = 1, py::arg("bias") = true,
+             py::arg("dtype") = DType::Float32,
+             py::arg("device") = Device{DeviceType::CPU, 0})
+        .def("forward",         &architecture::Conv2d::forward, release_gil())
+        .def("__call__",        &architecture::Conv2d::operator(), release_gil())
+        .def("reset_parameters",&architecture::Conv2d::reset_parameters)
+        .def_property_readonly("in_channels",  &architecture::Conv2d::in_channels)
+        .def_property_readonly("out_channels", &architecture::Conv2d::out_channels)
+        .def_property_readonly("kernel_size",  &architecture::Conv2d::kernel_size)
+        .def_property_readonly("stride",       &architecture::Conv2d::stride)
+        .def_property_readonly("padding",      &architecture::Conv2d::padding)
+        .def_property_readonly("dilation",     &architecture::Conv2d::dilation)
+        .def_property_readonly("groups",       &architecture::Conv2d::groups)
+        .def_property_readonly("weight",       &architecture::Conv2d::weight)
+        .def_property_readonly("bias",         &architecture::Conv2d::bias)
+        .def_property("algorithm", &architecture::Conv2d::algorithm,
+                      &architecture::Conv2d::set_algorithm)
+        ;
+
+     py::class_<architecture::MaxPool2d, Module,
+                std::shared_ptr<architecture::MaxPool2d>>(m_arch, "MaxPool2d")
+        .def(py::init([](const py::object& kernel_size, const py::object& stride,
+                         const py::object& padding) {
+                 return std::make_shared<architecture::MaxPool2d>(
+                     size2(kernel_size), stride.is_none() ? architecture::Size2{0, 0} : size2(stride),
+                     size2(padding));
+             }),
+             py::arg("kernel_size"), py::arg("stride") = py::none(), py::arg("padding") = 0)
+        .def("forward",  &architecture::MaxPool2d::forward, release_gil())
+        .def("__call__", &architecture::MaxPool2d::operator(), release_gil())
+        ;
+
+     py::class_<architecture::AvgPool2d, Module,
+                std::shared_ptr<architecture::AvgPool2d>>(m_arch, "AvgPool2d")
+        .def(py::init([](const py::object& kernel_size, const py::object& stride,
+                         const py::object& padding, bool count_include_pad) {
+                 return std::make_shared<architecture::AvgPool2d>(
+                     size2(kernel_size), stride.is_none() ? architecture::Size2{0, 0} : size2(stride),
+                     size2(padding), count_include_pad);
+             }),
+             py::arg("kernel_size"), py::arg("stride") = py::none(), py::arg("padding") = 0,
+             py::arg("count_include_pad") = true)
+        .def("forward",  &architecture::AvgPool2d::forward, release_gil())
+        .def("__call__", &architecture::AvgPool2d::operator(), release_gil())
+        ;
+
+     m_arch.def("conv2d", [](const Tensor& input, const Tensor& weight,
+                             const std::optional<Tensor>& bias, const py::object& stride,
+                             const py::object& padding, const py::object& dilation,
+                             std::size_t groups, kernels::ConvAlgorithm algorithm) {
+             return architecture::conv2d(input, weight, bias.value_or(Tensor()), size2(stride),
+                                         size2(padding), size2(dilation), groups, algorithm);
+         }, py::arg("input"), py::arg("weight"), py::arg("bias") = py::none(),
+         py::arg("stride") = 1, py::arg("padding") = 0, py::arg("dilation") = 1,
+         py::arg("groups") = 1, py::arg("algorithm") = kernels::ConvAlgorithm::Auto);
+     m_arch.def("max_pool2d", [](const Tensor& input, const py::object& kernel_size,
+                                 const py::object& stride, const py::object& padding) {
+             return architecture::max_pool2d(input, size2(kernel_size),
+                                             stride.is_none() ? architecture::Size2{0, 0}
+                                                              : size2(stride),
+                                             size2(padding));
+         }, py::arg("input"), py::arg("kernel_size"), py::arg("stride") = py::none(),
+         py::arg("padding") = 0);
+     m_arch.def("avg_pool2d", [](const Tensor& input, const py::object& kernel_size,
+                                 const py::object& stride, const py::object& padding,
+                                 bool count_include_pad) {
+             return architecture::avg_pool2d(input, size2(kernel_size),
+                                             stride.is_none() ? architecture::Size2{0, 0}
+                                                              : size2(stride),
+                                             size2(padding), count_include_pad);
+         }, py::arg("input"), py::arg("kernel_size"), py::arg("stride") = py::none(),
+         py::arg("padding") = 0, py::arg("count_include_pad") = true);
+     m_arch.def("is_channels_last", &architecture::is_channels_last, py::arg("tensor"));
+     m_arch.def("to_channels_last", &architecture::to_channels_last, release_gil(),
+                py::arg("tensor"));
         
 }
 
@@ -2,32 +2,69 @@
 
 #include "napcas/tensor.h"
 #include "napcas/grad_fn.h"
-#include <unordered_set>
-#include <Eigen/Dense>
+#include "napcas/autograd.h"
+#include "napcas/broadcast.h"
+#include "napcas/dispatch.h"
+#include "napcas/graph.h"
+#include "napcas/profiler.h"
+#include "napcas/kernels/convert.h"
+#include "napcas/kernels/copy.h"
+#include "napcas/kernels/elementwise.h"
+#include "napcas/kernels/gemm.h"
+#include "napcas/kernels/reduce.h"
+#include "napcas/kernels/activation.h"
+#include "napcas/kernels/normalization.h"
+#include <cstdint>
 #include <cstring>
 #include <stdexcept>
 #include <numeric>
 #include <iostream>
+#include <type_traits>
 
 namespace napcas {
 
 namespace {
-    void default_deleter(void* ptr) {
-        std::free(ptr);
-    }
-
-    size_t compute_numel(const std::vector<std::size_t>& shape) {
+    size_t compute_numel(const Shape& shape) {
         return std::accumulate(shape.begin(), shape.end(), 1UL, std::multiplies<>());
     }
 
-    std::vector<std::ptrdiff_t> compute_strides_generic(const std::vector<std::size_t>& shape) {
-        std::vector<std::ptrdiff_t> strides(shape.size());
-        std::ptrdiff_t stride = 1;
-        for (int i = int(shape.size()) - 1; i >= 0; --i) {
-            strides[i] = stride;
-            stride *= shape[i];
+    // Strides permettant de voir (shape, strides) sous `new_shape` sans copie.
+    // Renvoie false si la géométrie n'est pas compatible (il faut alors copier).
+    // Les dimensions sont regroupées en blocs contigus ; chaque bloc doit être
+    // recouvert exactement par des dimensions de la nouvelle forme.
+    bool compute_view_strides(const Shape&   shape,
+                              const Strides& strides,
+                              const Shape&   new_shape,
+                              Strides&       new_strides) {
+        new_strides.assign(new_shape.size(), 0);
+        if (shape.empty() || compute_numel(shape) == 0) {
+            new_strides = Tensor::contiguous_strides(new_shape);
+            return true;
         }
-        return strides;
+        int view_d = int(new_shape.size()) - 1;
+        std::ptrdiff_t chunk_base_stride = strides.back();
+        std::size_t tensor_numel = 1;
+        std::size_t view_numel   = 1;
+        for (int tensor_d = int(shape.size()) - 1; tensor_d >= 0; --tensor_d) {
+            tensor_numel *= shape[tensor_d];
+            bool chunk_end = tensor_d == 0 ||
+                (shape[tensor_d - 1] != 1 &&
+                 strides[tensor_d - 1] != std::ptrdiff_t(tensor_numel) * chunk_base_stride);
+            if (!chunk_end) continue;
+            while (view_d >= 0 &&
+                   (view_numel < tensor_numel || new_shape[view_d] == 1)) {
+                new_strides[view_d] = std::ptrdiff_t(view_numel) * chunk_base_stride;
+                view_numel *= new_shape[view_d];
+                --view_d;
+            }
+            if (view_numel != tensor_numel) return false;
+            if (tensor_d > 0) {
+                chunk_base_stride = strides[tensor_d - 1];
+                tensor_numel = 1;
+                view_numel   = 1;
+            }
+        }
+        return view_d == -1;
     }
 }
 
@@ -35,91 +72,181 @@ namespace {
 
 Tensor::Tensor()
     : dtype_(DType::Float32),
-      device_(DeviceType::CPU, 0),
-      storage_(nullptr, default_deleter),
-      requires_grad_flag_(false)
+      device_(DeviceType::CPU, 0)
 {}
 
-Tensor::Tensor(const std::vector<std::size_t>& shape,
+Tensor::Tensor(const Shape& shape,
                DType dtype,
                Device device)
     : shape_(shape),
       dtype_(dtype),
-      device_(device),
-      storage_(nullptr, default_deleter),
-      requires_grad_flag_(false)
+      device_(device)
 {
     compute_strides();
     size_t size_bytes = compute_numel(shape_) * dtype_size(dtype_);
-    void* raw = device_malloc(size_bytes, device_);
-    storage_.reset(raw);
+    storage_ = Storage::allocate(size_bytes, device_);
 }
 
 template<typename Scalar>
-Tensor::Tensor(const std::vector<std::size_t>& shape,
+Tensor::Tensor(const Shape& shape,
                const std::vector<Scalar>& data,
                DType dtype,
                Device device)
     : shape_(shape),
       dtype_(dtype),
-      device_(device),
-      storage_(nullptr, default_deleter),
-      requires_grad_flag_(false)
+      device_(device)
 {
     compute_strides();
     size_t expected = compute_numel(shape);
     if (data.size() != expected)
         throw std::runtime_error("Mismatch in shape and data size");
     size_t size_bytes = expected * dtype_size(dtype_);
-    void* raw = device_malloc(size_bytes, device_);
-    std::memcpy(raw, data.data(), size_bytes);
-    storage_.reset(raw);
+    storage_ = Storage::allocate(size_bytes, device_);
+    // Les données sont converties si Scalar ne correspond pas à `dtype`
+    kernels::convert(storage_->data(), dtype_,
+                     data.data(), dtype_of_v<Scalar>, expected);
 }
 
 Tensor::Tensor(Tensor&& other) noexcept
     : shape_(std::move(other.shape_)),
       strides_(std::move(other.strides_)),
+      numel_(other.numel_),
+      is_contiguous_(other.is_contiguous_),
       dtype_(other.dtype_),
       device_(other.device_),
       storage_(std::move(other.storage_)),
-      grad_ptr_(std::move(other.grad_ptr_)),
-      grad_fn_(std::move(other.grad_fn_)),
-      requires_grad_flag_(other.requires_grad_flag_)
+      storage_offset_(other.storage_offset_),
+      is_view_(other.is_view_),
+      autograd_(std::move(other.autograd_))
 {}
 
 Tensor& Tensor::operator=(Tensor&& other) noexcept {
     if (this != &other) {
         shape_               = std::move(other.shape_);
         strides_             = std::move(other.strides_);
+        numel_               = other.numel_;
+        is_contiguous_       = other.is_contiguous_;
         dtype_               = other.dtype_;
         device_              = other.device_;
         storage_             = std::move(other.storage_);
-        grad_ptr_            = std::move(other.grad_ptr_);
-        grad_fn_             = std::move(other.grad_fn_);
-        requires_grad_flag_  = other.requires_grad_flag_;
+        storage_offset_      = other.storage_offset_;
+        is_view_             = other.is_view_;
+        autograd_            = std::move(other.autograd_);
     }
     return *this;
 }
 
+Tensor Tensor::from_storage(std::shared_ptr<Storage> storage,
+                            const Shape&   shape,
+                            const Strides& strides,
+                            DType dtype,
+                            std::size_t storage_offset) {
+    if (!storage)
+        throw std::runtime_error("from_storage: null storage");
+    if (shape.size() != strides.size())
+        throw std::runtime_error("from_storage: shape and strides rank mismatch");
+    // Plus grand élément adressé (les strides négatifs ne sont pas supportés)
+    std::size_t extent = compute_numel(shape) == 0 ? 0 : storage_offset + 1;
+    for (std::size_t d = 0; d < shape.size() && extent; ++d) {
+        if (strides[d] < 0)
+            throw std::runtime_error("from_storage: negative strides are not supported");
+        extent += (shape[d] - 1) * std::size_t(strides[d]);
+    }
+    if (extent * dtype_size(dtype) > storage->nbytes())
+        throw std::runtime_error("from_storage: geometry exceeds storage size");
+    Tensor out;
+    out.shape_          = shape;
+    out.strides_        = strides;
+    out.dtype_          = dtype;
+    out.device_         = storage->device();
+    out.storage_        = std::move(storage);
+    out.storage_offset_ = storage_offset;
+    out.update_geometry();
+    return out;
+}
+
+Strides Tensor::contiguous_strides(const Shape& shape) {
+    Strides strides(shape.size());
+    std::ptrdiff_t stride = 1;
+    for (int i = int(shape.size()) - 1; i >= 0; --i) {
+        strides[i] = stride;
+        stride *= std::ptrdiff_t(shape[i]);
+    }
+    return strides;
+}
+
 // ===================== Autograd setup =====================
 
+AutogradMeta& Tensor::autograd_meta() {
+    if (!autograd_) autograd_ = std::make_shared<AutogradMeta>();
+    return *autograd_;
+}
+
 void Tensor::set_grad_fn(std::shared_ptr<GradFn> fn) {
-    grad_fn_ = std::move(fn);
-    requires_grad_flag_ = true;
+    AutogradMeta& meta = autograd_meta();
+    meta.grad_fn       = std::move(fn);
+    meta.requires_grad = true;
+}
+
+void Tensor::requires_grad_(bool flag) {
+    if (!flag && !autograd_) return;
+    if (!flag && autograd_->grad_fn)
+        throw std::runtime_error(
+            "requires_grad_: cannot clear the flag of a non-leaf tensor, use detach()");
+    autograd_meta().requires_grad = flag;
+}
+
+bool Tensor::requires_grad() const noexcept {
+    return autograd_ && autograd_->requires_grad;
+}
+
+const std::shared_ptr<GradFn>& Tensor::grad_fn() const noexcept {
+    static const std::shared_ptr<GradFn> kNone;
+    return autograd_ ? autograd_->grad_fn : kNone;
+}
+
+std::shared_ptr<GradFn> Tensor::gradient_edge() const {
+    if (!requires_grad()) return nullptr;
+    if (autograd_->grad_fn) return autograd_->grad_fn;
+    // Feuille : un seul AccumulateGrad tant que le graphe le référence
+    std::lock_guard<std::mutex> lock(autograd_->mutex);
+    std::shared_ptr<GradFn> acc = autograd_->accumulator.lock();
+    if (!acc) {
+        acc = std::make_shared<AccumulateGrad>(autograd_);
+        autograd_->accumulator = acc;
+    }
+    return acc;
 }
 
 // ===================== Métadonnées =====================
 
-std::size_t Tensor::numel() const noexcept {
-    return compute_numel(shape_);
+void Tensor::update_geometry() noexcept {
+    numel_         = compute_numel(shape_);
+    is_contiguous_ = true;
+    std::ptrdiff_t expected = 1;
+    for (int i = int(shape_.size()) - 1; i >= 0; --i) {
+        if (strides_[i] != expected) {
+            is_contiguous_ = false;
+            break;
+        }
+        expected *= std::ptrdiff_t(shape_[i]);
+    }
+}
+
+void* Tensor::data_ptr() noexcept {
+    if (!storage_) return nullptr;
+    return static_cast<char*>(storage_->data()) + storage_offset_ * dtype_size(dtype_);
 }
 
-bool Tensor::is_contiguous() const noexcept {
-    return strides_ == compute_strides_generic(shape_);
+const void* Tensor::data_ptr() const noexcept {
+    if (!storage_) return nullptr;
+    return static_cast<const char*>(storage_->data()) + storage_offset_ * dtype_size(dtype_);
 }
 
 void Tensor::compute_strides() {
-    strides_ = compute_strides_generic(shape_);
+    strides_ = contiguous_strides(shape_);
+    numel_         = compute_numel(shape_);
+    is_contiguous_ = true;
 }
 
 void Tensor::check_device_consistency(const Tensor& other) const {
@@ -127,98 +254,145 @@ void Tensor::check_device_consistency(const Tensor& other) const {
         throw std::runtime_error("Device mismatch");
 }
 
-void Tensor::check_shape_broadcast(const Tensor& other) const {
-    if (shape_ != other.shape_)
-        throw std::runtime_error("Shape mismatch: broadcasting not yet supported");
+Shape Tensor::check_shape_broadcast(const Tensor& other) const {
+    if (shape_ == other.shape_)
+        return shape_;
+    return broadcast_shapes(shape_, other.shape_);
 }
 
 // ===================== Manipulations =====================
 
+Tensor Tensor::as_strided(const Shape&   shape,
+                          const Strides& strides,
+                          std::size_t storage_offset) const {
+    if (shape.size() != strides.size())
+        throw std::runtime_error("as_strided: shape and strides rank mismatch");
+    Tensor out;
+    out.shape_          = shape;
+    out.strides_        = strides;
+    out.dtype_          = dtype_;
+    out.device_         = device_;
+    out.storage_        = storage_;
+    out.storage_offset_ = storage_offset;
+    out.is_view_        = true;
+    out.update_geometry();
+    return out;
+}
+
 Tensor Tensor::clone() const {
+    profiler::RecordScope prof("clone");
+    graph::CaptureScope scope;
     Tensor out(shape_, dtype_, device_);
-    std::memcpy(out.storage_.get(), storage_.get(),
-                numel() * dtype_size(dtype_));
+    kernels::strided_copy(out.data_ptr(), data_ptr(),
+                          shape_, strides_, dtype_size(dtype_));
+    if (scope.active())
+        graph::record("clone", {*this}, out, [](const std::vector<Tensor>& in, Tensor& o) {
+            kernels::strided_copy(o.data_ptr(), in[0].data_ptr(), in[0].shape(),
+                                  in[0].strides(), dtype_size(in[0].dtype()));
+        });
+    if (prof.active()) prof.record_io({*this}, out);
     return out;
 }
 
 Tensor Tensor::detach() const {
-    Tensor out = clone();
-    out.requires_grad_flag_ = false;
+    Tensor out = as_strided(shape_, strides_, storage_offset_);
+    out.is_view_ = false;   // hors autograd : écriture en place autorisée
     return out;
 }
 
 Tensor Tensor::astype(DType new_dtype) const {
+    if (new_dtype == dtype_)
+        return clone();
+    profiler::RecordScope prof("astype");
+    graph::CaptureScope scope;
+    Tensor src = contiguous();
     Tensor out(shape_, new_dtype, device_);
-    if (dtype_ != new_dtype)
-        throw std::runtime_error("astype not implemented yet");
-    std::memcpy(out.storage_.get(), storage_.get(),
-                numel() * dtype_size(dtype_));
+    kernels::convert(out.data_ptr(), new_dtype, src.data_ptr(), dtype_, numel());
+    if (scope.active()) {
+        graph::Kernel kernel = [](const std::vector<Tensor>& in, Tensor& o) {
+            kernels::convert(o.data_ptr(), o.dtype(), in[0].data_ptr(), in[0].dtype(),
+                             o.numel());
+        };
+        if (!is_contiguous())
+            kernel = graph::eager_kernel([new_dtype](const std::vector<Tensor>& in) {
+                return in[0].astype(new_dtype);
+            });
+        graph::record("astype", {*this}, out, std::move(kernel));
+    }
+    if (prof.active()) prof.record_io({*this}, out);
     return out;
 }
 
 Tensor Tensor::to(Device new_device) const {
     if (new_device == device_)
         return clone();
+    Tensor src = contiguous();
     Tensor out(shape_, dtype_, new_device);
-    std::memcpy(out.storage_.get(), storage_.get(),
+    std::memcpy(out.data_ptr(), src.data_ptr(),
                 numel() * dtype_size(dtype_));
     return out;
 }
 
-// -- reshape with backward tracking --
+// -- view: zero-copy, échoue si les strides ne le permettent pas --
 
-Tensor Tensor::reshape(const std::vector<std::size_t>& new_shape) const {
+Tensor Tensor::view(const Shape& new_shape) const {
+    if (compute_numel(new_shape) != numel()) {
+        throw std::runtime_error("Invalid view");
+    }
+    Strides new_strides;
+    if (!compute_view_strides(shape_, strides_, new_shape, new_strides)) {
+        throw std::runtime_error(
+            "view: incompatible strides, use reshape() or contiguous()");
+    }
+    Tensor out = as_strided(new_shape, new_strides, storage_offset_);
+    if (requires_grad()) {
+        out.set_grad_fn(std::make_shared<ReshapeBackward>(*this, shape_));
+    }
+    return out;
+}
+
+// -- reshape: vue si possible, copie sinon --
+
+Tensor Tensor::reshape(const Shape& new_shape) const {
     if (compute_numel(new_shape) != numel()) {
         throw std::runtime_error("Invalid reshape");
     }
+    Strides new_strides;
+    if (compute_view_strides(shape_, strides_, new_shape, new_strides))
+        return view(new_shape);
     Tensor out = clone();
-    std::vector<std::size_t> old_shape = shape_;
     out.shape_ = new_shape;
     out.compute_strides();
-    if (requires_grad_flag_) {
-        out.requires_grad_flag_ = true;
-        out.set_grad_fn(
-            std::make_shared<ReshapeBackward>(
-                const_cast<Tensor*>(this),
-                &out,
-                std::move(old_shape)
-            )
-        );
+    if (requires_grad()) {
+        out.set_grad_fn(std::make_shared<ReshapeBackward>(*this, shape_));
     }
     return out;
 }
 
-Tensor Tensor::view(const std::vector<std::size_t>& new_shape) const {
-    return reshape(new_shape);
-}
-
 // -- permute with backward tracking --
 
 Tensor Tensor::permute(const std::vector<int>& dims) const {
     if (dims.size() != shape_.size())
         throw std::runtime_error("Invalid permutation");
-    Tensor out = clone();
-    std::vector<std::size_t> new_shape(shape_.size());
-    std::vector<std::ptrdiff_t> new_strides(strides_.size());
+    std::vector<bool> seen(dims.size(), false);
+    for (int d : dims) {
+        if (d < 0 || d >= int(dims.size()) || seen[d])
+            throw std::runtime_error("Invalid permutation");
+        seen[d] = true;
+    }
+    Shape new_shape(shape_.size());
+    Strides new_strides(strides_.size());
     for (size_t i = 0; i < dims.size(); ++i) {
         new_shape[i]   = shape_[dims[i]];
         new_strides[i] = strides_[dims[i]];
     }
-    out.shape_   = new_shape;
-    out.strides_ = new_strides;
-    if (requires_grad_flag_) {
+    Tensor out = as_strided(new_shape, new_strides, storage_offset_);
+    if (requires_grad()) {
         // compute inverse permutation
         std::vector<int> inv(dims.size());
         for (size_t i = 0; i < dims.size(); ++i)
             inv[dims[i]] = int(i);
-        out.requires_grad_flag_ = true;
-        out.set_grad_fn(
-            std::make_shared<PermuteBackward>(
-                const_cast<Tensor*>(this),
-                &out,
-                std::move(inv)
-            )
-        );
+        out.set_grad_fn(std::make_shared<PermuteBackward>(*this, std::move(inv)));
     }
     return out;
 }
@@ -242,20 +416,15 @@ Tensor Tensor::transpose(int dim0, int dim1) const {
 
 Tensor Tensor::squeeze(int dim) const {
     if (dim < 0 || dim >= int(shape_.size()) || shape_[dim] != 1) {
-        return clone();
+        return *this;
     }
-    Tensor out = clone();
-    out.shape_.erase(out.shape_.begin() + dim);
-    out.compute_strides();
-    if (requires_grad_flag_) {
-        out.requires_grad_flag_ = true;
-        out.set_grad_fn(
-            std::make_shared<SqueezeBackward>(
-                const_cast<Tensor*>(this),
-                &out,
-                dim
-            )
-        );
+    Shape new_shape = shape_;
+    Strides new_strides = strides_;
+    new_shape.erase(new_shape.begin() + dim);
+    new_strides.erase(new_strides.begin() + dim);
+    Tensor out = as_strided(new_shape, new_strides, storage_offset_);
+    if (requires_grad()) {
+        out.set_grad_fn(std::make_shared<SqueezeBackward>(*this, dim));
     }
     return out;
 }
@@ -266,161 +435,799 @@ Tensor Tensor::unsqueeze(int dim) const {
     if (dim < 0 || dim > int(shape_.size())) {
         throw std::runtime_error("unsqueeze: invalid dimension");
     }
-    Tensor out = clone();
-    out.shape_.insert(out.shape_.begin() + dim, 1);
-    out.compute_strides();
-    if (requires_grad_flag_) {
-        out.requires_grad_flag_ = true;
-        out.set_grad_fn(
-            std::make_shared<UnsqueezeBackward>(
-                const_cast<Tensor*>(this),
-                &out,
-                dim
-            )
-        );
+    Shape new_shape = shape_;
+    Strides new_strides = strides_;
+    std::ptrdiff_t stride = dim < int(shape_.size())
+        ? strides_[dim] * std::ptrdiff_t(shape_[dim])
+        : 1;
+    new_shape.insert(new_shape.begin() + dim, 1);
+    new_strides.insert(new_strides.begin() + dim, stride);
+    Tensor out = as_strided(new_shape, new_strides, storage_offset_);
+    if (requires_grad()) {
+        out.set_grad_fn(std::make_shared<UnsqueezeBackward>(*this, dim));
     }
     return out;
 }
 
+// -- expand: vue diffusée (stride 0) sans copie --
+
+Tensor Tensor::expand(const Shape& new_shape) const {
+    if (broadcast_shapes(shape_, new_shape) != new_shape)
+        throw std::runtime_error("expand: shape is not broadcastable");
+    return as_strided(new_shape,
+                      broadcast_strides(shape_, strides_, new_shape),
+                      storage_offset_);
+}
+
+// -- sum_to_size: somme sur les dimensions diffusées (gradient du broadcast) --
+
+Tensor Tensor::sum_to_size(const Shape& target) const {
+    if (target == shape_)
+        return *this;
+    if (broadcast_shapes(target, shape_) != shape_)
+        throw std::runtime_error("sum_to_size: shape is not broadcastable");
+    Tensor out = zeros(target, dtype_, device_);
+    Tensor src = contiguous();
+    const auto out_strides = broadcast_strides(target, out.strides_, shape_);
+    NAPCAS_DISPATCH_ALL_TYPES(dtype_, "sum_to_size", [&] {
+        kernels::sum_to(out.data<scalar_t>(), src.data<scalar_t>(), shape_, out_strides);
+    });
+    return out;
+}
+
 Tensor Tensor::contiguous() const {
     if (is_contiguous())
-        return clone();
-    return clone();  // placeholder
+        return *this;
+    return clone();
 }
 
 // ===================== Initialisateurs =====================
 
-Tensor Tensor::zeros(const std::vector<std::size_t>& shape,
+Tensor Tensor::zeros(const Shape& shape,
                      DType dtype,
                      Device device) {
     Tensor out(shape, dtype, device);
-    std::memset(out.storage_.get(), 0,
-                out.numel() * dtype_size(dtype));
+    const std::uint64_t zero = 0;
+    kernels::fill(out.data_ptr(), &zero, out.numel(), dtype_size(dtype));
     return out;
 }
 
-Tensor Tensor::ones(const std::vector<std::size_t>& shape,
+Tensor Tensor::ones(const Shape& shape,
                     DType dtype,
                     Device device) {
     Tensor out(shape, dtype, device);
-    if (dtype == DType::Float32) {
-        float* ptr = static_cast<float*>(out.storage_.get());
-        std::fill(ptr, ptr + out.numel(), 1.0f);
-    }
+    NAPCAS_DISPATCH_ALL_TYPES(dtype, "ones", [&] {
+        const scalar_t one = scalar_t(1);
+        kernels::fill(out.data_ptr(), &one, out.numel(), sizeof(one));
+    });
     return out;
 }
 
 // ===================== Opérations élémentaires =====================
 
+namespace {
+    // out = a op b : les deux opérandes sont lus via leurs strides étendus à la
+    // forme de `out`, sans copie préalable ni expansion des dimensions diffusées.
+    // Un opérande d'un autre type que `out` (promotion) est d'abord converti.
+    void binary_compute(kernels::BinaryOp op, Tensor& out,
+                        const Tensor& a, const Tensor& b) {
+        const Tensor ca = a.dtype() == out.dtype() ? a : a.astype(out.dtype());
+        const Tensor cb = b.dtype() == out.dtype() ? b : b.astype(out.dtype());
+        auto sa = broadcast_strides(ca.shape(), ca.strides(), out.shape());
+        auto sb = broadcast_strides(cb.shape(), cb.strides(), out.shape());
+        NAPCAS_DISPATCH_ALL_TYPES(out.dtype(), "element-wise op", [&] {
+            kernels::binary_op(op, out.data<scalar_t>(), ca.data<scalar_t>(),
+                               cb.data<scalar_t>(), out.shape(), out.strides(), sa, sb);
+        });
+    }
+
+    const char* binary_name(kernels::BinaryOp op) {
+        switch (op) {
+            case kernels::BinaryOp::Add: return "add";
+            case kernels::BinaryOp::Sub: return "sub";
+            case kernels::BinaryOp::Mul: return "mul";
+            case kernels::BinaryOp::Div: return "div";
+        }
+        return "binary";
+    }
+
+    // Rejeu de binary_compute : strides diffusés calculés une fois ; une
+    // promotion de type repasse par binary_compute (conversion à chaque rejeu)
+    graph::Kernel binary_replay(kernels::BinaryOp op, const Tensor& out,
+                                const Tensor& a, const Tensor& b) {
+        if (a.dtype() != out.dtype() || b.dtype() != out.dtype())
+            return [op](const std::vector<Tensor>& in, Tensor& o) {
+                binary_compute(op, o, in[0], in[1]);
+            };
+        auto sa = broadcast_strides(a.shape(), a.strides(), out.shape());
+        auto sb = broadcast_strides(b.shape(), b.strides(), out.shape());
+        return [op, sa, sb](const std::vector<Tensor>& in, Tensor& o) {
+            NAPCAS_DISPATCH_ALL_TYPES(o.dtype(), "element-wise op", [&] {
+                kernels::binary_op(op, o.data<scalar_t>(), in[0].data<scalar_t>(),
+                                   in[1].data<scalar_t>(), o.shape(), o.strides(), sa, sb);
+            });
+        };
+    }
+
+    void binary_kernel(kernels::BinaryOp op, Tensor& out,
+                       const Tensor& a, const Tensor& b) {
+        profiler::RecordScope prof(binary_name(op));
+        graph::CaptureScope scope;
+        binary_compute(op, out, a, b);
+        if (scope.active())
+            graph::record(binary_name(op), {a, b}, out, binary_replay(op, out, a, b));
+        if (prof.active()) prof.record_io({a, b}, out, double(out.numel()));
+    }
+
+    // Un tenseur écrit en place ne doit pas répéter d'éléments (vue diffusée)
+    void check_writable(const Tensor& out, const char* name) {
+        if (!out.defined())
+            throw std::runtime_error(std::string(name) + ": output is undefined");
+        for (std::size_t d = 0; d < out.ndim(); ++d)
+            if (out.strides()[d] == 0 && out.shape()[d] > 1)
+                throw std::runtime_error(std::string(name) +
+                                         ": output has overlapping elements (expanded view)");
+    }
+
+    // Un opérande lu dans le Storage écrit n'est sûr que s'il désigne
+    // exactement les mêmes éléments que la sortie ; sinon il est copié
+    Tensor unalias(const Tensor& operand, const Tensor& out) {
+        if (operand.storage() != out.storage()) return operand;
+        if (operand.data_ptr() == out.data_ptr() && operand.shape() == out.shape() &&
+            operand.strides() == out.strides())
+            return operand;
+        return operand.clone();
+    }
+
+    Tensor& binary_out(kernels::BinaryOp op, Tensor& out, const Tensor& a, const Tensor& b,
+                       const char* name) {
+        check_writable(out, name);
+        if (a.requires_grad() || b.requires_grad() || out.requires_grad())
+            throw std::runtime_error(std::string(name) +
+                                     ": out= variants do not support autograd");
+        if (a.device() != out.device() || b.device() != out.device())
+            throw std::runtime_error("Device mismatch");
+        if (broadcast_shapes(a.shape(), b.shape()) != out.shape())
+            throw std::runtime_error(std::string(name) + ": output shape mismatch");
+        const DType dtype = promote_types(a.dtype(), b.dtype());
+        if (dtype != out.dtype())
+            throw std::runtime_error(std::string(name) + ": output dtype must be " +
+                                     dtype_to_string(dtype));
+        binary_kernel(op, out, unalias(a, out), unalias(b, out));
+        out.storage()->bump_version();
+        return out;
+    }
+}
+
+Tensor& add_out(Tensor& out, const Tensor& a, const Tensor& b) {
+    return binary_out(kernels::BinaryOp::Add, out, a, b, "add_out");
+}
+
+Tensor& sub_out(Tensor& out, const Tensor& a, const Tensor& b) {
+    return binary_out(kernels::BinaryOp::Sub, out, a, b, "sub_out");
+}
+
+Tensor& mul_out(Tensor& out, const Tensor& a, const Tensor& b) {
+    return binary_out(kernels::BinaryOp::Mul, out, a, b, "mul_out");
+}
+
+Tensor& div_out(Tensor& out, const Tensor& a, const Tensor& b) {
+    return binary_out(kernels::BinaryOp::Div, out, a, b, "div_out");
+}
+
 Tensor Tensor::operator+(const Tensor& rhs) const {
     check_device_consistency(rhs);
-    check_shape_broadcast(rhs);
-    Tensor out(shape_, dtype_, device_);
-    float* a = static_cast<float*>(storage_.get());
-    float* b = static_cast<float*>(rhs.storage_.get());
-    float* c = static_cast<float*>(out.storage_.get());
-    size_t N = numel();
-    for (size_t i = 0; i < N; ++i) c[i] = a[i] + b[i];
-    if (requires_grad_flag_ || rhs.requires_grad_flag_) {
-        out.requires_grad_flag_ = true;
-        out.set_grad_fn(
-            std::make_shared<AddBackward>(
-                const_cast<Tensor*>(this),
-                const_cast<Tensor*>(&rhs),
-                &out
-            )
-        );
-    }
+    Tensor out(check_shape_broadcast(rhs), promote_types(dtype_, rhs.dtype_), device_);
+    binary_kernel(kernels::BinaryOp::Add, out, *this, rhs);
+    if (requires_grad() || rhs.requires_grad())
+        out.set_grad_fn(std::make_shared<AddBackward>(*this, rhs));
     return out;
 }
 
 Tensor Tensor::operator-(const Tensor& rhs) const {
     check_device_consistency(rhs);
-    check_shape_broadcast(rhs);
-    Tensor out(shape_, dtype_, device_);
-    float* a = static_cast<float*>(storage_.get());
-    float* b = static_cast<float*>(rhs.storage_.get());
-    float* c = static_cast<float*>(out.storage_.get());
-    size_t N = numel();
-    for (size_t i = 0; i < N; ++i) c[i] = a[i] - b[i];
-    if (requires_grad_flag_ || rhs.requires_grad_flag_) {
-        out.requires_grad_flag_ = true;
-        out.set_grad_fn(
-            std::make_shared<SubBackward>(
-                const_cast<Tensor*>(this),
-                const_cast<Tensor*>(&rhs),
-                &out
-            )
-        );
-    }
+    Tensor out(check_shape_broadcast(rhs), promote_types(dtype_, rhs.dtype_), device_);
+    binary_kernel(kernels::BinaryOp::Sub, out, *this, rhs);
+    if (requires_grad() || rhs.requires_grad())
+        out.set_grad_fn(std::make_shared<SubBackward>(*this, rhs));
     return out;
 }
 
 Tensor Tensor::operator*(const Tensor& rhs) const {
     check_device_consistency(rhs);
-    check_shape_broadcast(rhs);
-    Tensor out(shape_, dtype_, device_);
-    float* a = static_cast<float*>(storage_.get());
-    float* b = static_cast<float*>(rhs.storage_.get());
-    float* c = static_cast<float*>(out.storage_.get());
-    size_t N = numel();
-    for (size_t i = 0; i < N; ++i) c[i] = a[i] * b[i];
-    if (requires_grad_flag_ || rhs.requires_grad_flag_) {
-        out.requires_grad_flag_ = true;
-        out.set_grad_fn(
-            std::make_shared<MulBackward>(
-                const_cast<Tensor*>(this),
-                const_cast<Tensor*>(&rhs),
-                &out
-            )
-        );
-    }
+    Tensor out(check_shape_broadcast(rhs), promote_types(dtype_, rhs.dtype_), device_);
+    binary_kernel(kernels::BinaryOp::Mul, out, *this, rhs);
+    if (requires_grad() || rhs.requires_grad())
+        out.set_grad_fn(std::make_shared<MulBackward>(*this, rhs));
     return out;
 }
 
 Tensor Tensor::operator/(const Tensor& rhs) const {
     check_device_consistency(rhs);
-    check_shape_broadcast(rhs);
-    Tensor out(shape_, dtype_, device_);
-    float* a = static_cast<float*>(storage_.get());
-    float* b = static_cast<float*>(rhs.storage_.get());
-    float* c = static_cast<float*>(out.storage_.get());
-    size_t N = numel();
-    for (size_t i = 0; i < N; ++i) c[i] = a[i] / b[i];
-    if (requires_grad_flag_ || rhs.requires_grad_flag_) {
-        out.requires_grad_flag_ = true;
-        out.set_grad_fn(
-            std::make_shared<DivBackward>(
-                const_cast<Tensor*>(this),
-                const_cast<Tensor*>(&rhs),
-                &out
-            )
-        );
-    }
+    Tensor out(check_shape_broadcast(rhs), promote_types(dtype_, rhs.dtype_), device_);
+    binary_kernel(kernels::BinaryOp::Div, out, *this, rhs);
+    if (requires_grad() || rhs.requires_grad())
+        out.set_grad_fn(std::make_shared<DivBackward>(*this, rhs));
     return out;
 }
 
+// -- en place : *this = *this op other --
+
+Tensor& Tensor::binary_inplace(kernels::BinaryOp op, const Tensor& rhs, const char* name) {
+    check_device_consistency(rhs);
+    check_writable(*this, name);
+    if (broadcast_shapes(shape_, rhs.shape_) != shape_)
+        throw std::runtime_error(std::string(name) + ": operand is not broadcastable to the "
+                                 "shape of the tensor");
+    const DType dtype = promote_types(dtype_, rhs.dtype_);
+    if (dtype != dtype_)
+        throw std::runtime_error(std::string(name) + ": result type " + dtype_to_string(dtype) +
+                                 " cannot be stored in " + dtype_to_string(dtype_));
+    const bool grad = requires_grad() || rhs.requires_grad();
+    if (requires_grad() && !grad_fn())
+        throw std::runtime_error(std::string(name) + ": a leaf tensor that requires grad is "
+                                 "used in an in-place operation, use detach()");
+    // Le nœud ne serait attaché qu'à la vue : le tenseur de base (feuille
+    // modifiée, ou graphe qui ignorerait l'écriture) donnerait des
+    // gradients faux sans erreur
+    if (grad && is_view_)
+        throw std::runtime_error(std::string(name) + ": in-place operation on a view is not "
+                                 "supported with autograd, use clone() or detach()");
+
+    // Copie des valeurs d'avant l'écriture qui garde l'arête autograd de
+    // l'original : ce que le nœud sauvegarde ne doit pas être écrasé
+    auto snapshot = [](const Tensor& t) {
+        Tensor s = t.clone();
+        s.autograd_ = t.autograd_;
+        return s;
+    };
+    const Tensor other = grad && rhs.storage_ == storage_ ? snapshot(rhs) : unalias(rhs, *this);
+
+    std::shared_ptr<GradFn> fn;
+    if (grad) {
+        // Mul et Div sauvegardent *this si l'autre opérande requiert un gradient
+        const bool saves_self = (op == kernels::BinaryOp::Mul || op == kernels::BinaryOp::Div) &&
+                                other.requires_grad();
+        const Tensor self = saves_self ? snapshot(*this) : *this;
+        switch (op) {
+            case kernels::BinaryOp::Add: fn = std::make_shared<AddBackward>(self, other); break;
+            case kernels::BinaryOp::Sub: fn = std::make_shared<SubBackward>(self, other); break;
+            case kernels::BinaryOp::Mul: fn = std::make_shared<MulBackward>(self, other); break;
+            case kernels::BinaryOp::Div: fn = std::make_shared<DivBackward>(self, other); break;
+        }
+    }
+    binary_kernel(op, *this, *this, other);
+    storage_->bump_version();
+    if (fn) set_grad_fn(std::move(fn));
+    return *this;
+}
+
+Tensor& Tensor::add_(const Tensor& other) {
+    return binary_inplace(kernels::BinaryOp::Add, other, "add_");
+}
+
+Tensor& Tensor::sub_(const Tensor& other) {
+    return binary_inplace(kernels::BinaryOp::Sub, other, "sub_");
+}
+
+Tensor& Tensor::mul_(const Tensor& other) {
+    return binary_inplace(kernels::BinaryOp::Mul, other, "mul_");
+}
+
+Tensor& Tensor::div_(const Tensor& other) {
+    return binary_inplace(kernels::BinaryOp::Div, other, "div_");
+}
+
+// -- matmul: sémantique NumPy (1D promu, dimensions de lot diffusées) --
+
 Tensor Tensor::matmul(const Tensor& rhs) const {
-    if (shape_.size() != 2 || rhs.shape_.size() != 2)
-        throw std::runtime_error("matmul: only 2D supported");
-    if (shape_[1] != rhs.shape_[0])
+    profiler::RecordScope prof("matmul");
+    graph::CaptureScope scope;
+    check_device_consistency(rhs);
+    if (shape_.empty() || rhs.shape_.empty())
+        throw std::runtime_error("matmul: 0-d operands not supported");
+    const DType out_dtype = promote_types(dtype_, rhs.dtype_);
+    if (!is_floating_point(out_dtype))
+        throw std::runtime_error("matmul: integer dtypes not supported");
+    // float16/bfloat16 : produit en float32 puis conversion du résultat
+    const DType compute_dtype = out_dtype == DType::Float64 ? DType::Float64
+                                                            : DType::Float32;
+
+    // Un opérande 1D devient (1, k) à gauche ou (k, 1) à droite ; la
+    // dimension ajoutée est retirée du résultat.
+    Tensor lhs = shape_.size() == 1 ? unsqueeze(0) : *this;
+    Tensor r   = rhs.shape_.size() == 1 ? rhs.unsqueeze(1) : rhs;
+    if (lhs.dtype_ != compute_dtype) lhs = lhs.astype(compute_dtype);
+    if (r.dtype_   != compute_dtype) r   = r.astype(compute_dtype);
+    const std::size_t la = lhs.shape_.size(), lb = r.shape_.size();
+    const std::size_t m = lhs.shape_[la - 2], k = lhs.shape_[la - 1];
+    const std::size_t n = r.shape_[lb - 1];
+    if (r.shape_[lb - 2] != k)
         throw std::runtime_error("matmul: shape mismatch");
-    size_t m = shape_[0], k = shape_[1], n = rhs.shape_[1];
-    Tensor out({m, n}, dtype_, device_);
-    Eigen::Map<Eigen::MatrixXf> A(static_cast<float*>(storage_.get()), m, k);
-    Eigen::Map<Eigen::MatrixXf> B(static_cast<float*>(rhs.storage_.get()), k, n);
-    Eigen::Map<Eigen::MatrixXf> C(static_cast<float*>(out.storage_.get()), m, n);
-    C.noalias() = A * B;
-    if (requires_grad_flag_ || rhs.requires_grad_flag_) {
-        out.requires_grad_flag_ = true;
-        out.set_grad_fn(
-            std::make_shared<MatMulBackward>(
-                const_cast<Tensor*>(this),
-                const_cast<Tensor*>(&rhs),
-                &out
-            )
-        );
+
+    Shape   a_batch(lhs.shape_.begin(), lhs.shape_.end() - 2);
+    Shape   b_batch(r.shape_.begin(), r.shape_.end() - 2);
+    Strides a_batch_str(lhs.strides_.begin(), lhs.strides_.end() - 2);
+    Strides b_batch_str(r.strides_.begin(), r.strides_.end() - 2);
+    Shape batch_shape = broadcast_shapes(a_batch, b_batch);
+    Strides a_bstr = broadcast_strides(a_batch, a_batch_str, batch_shape);
+    Strides b_bstr = broadcast_strides(b_batch, b_batch_str, batch_shape);
+
+    Shape out_shape = batch_shape;
+    if (shape_.size() > 1)     out_shape.push_back(m);
+    if (rhs.shape_.size() > 1) out_shape.push_back(n);
+    Tensor out(out_shape, compute_dtype, device_);
+
+    // Offsets de chaque lot ; les strides des matrices sont passés tels
+    // quels au GEMM (opérandes transposés lus sans copie)
+    const std::size_t batch = compute_numel(batch_shape);
+    std::vector<std::ptrdiff_t> a_off(batch, 0), b_off(batch, 0);
+    for (std::size_t i = 0; i < batch; ++i) {
+        std::size_t rem = i;
+        for (int d = int(batch_shape.size()) - 1; d >= 0; --d) {
+            std::size_t idx = rem % batch_shape[d];
+            rem /= batch_shape[d];
+            a_off[i] += std::ptrdiff_t(idx) * a_bstr[d];
+            b_off[i] += std::ptrdiff_t(idx) * b_bstr[d];
+        }
+    }
+    if (compute_dtype == DType::Float64) {
+        kernels::MatrixRefF64 A{lhs.data<double>(), lhs.strides_[la - 2], lhs.strides_[la - 1]};
+        kernels::MatrixRefF64 B{r.data<double>(),   r.strides_[lb - 2],   r.strides_[lb - 1]};
+        kernels::gemm_batched(batch, m, n, k, A, a_off.data(), B, b_off.data(),
+                              out.data<double>(), std::ptrdiff_t(n),
+                              std::ptrdiff_t(m * n));
+    } else {
+        kernels::MatrixRef A{lhs.data<float>(), lhs.strides_[la - 2], lhs.strides_[la - 1]};
+        kernels::MatrixRef B{r.data<float>(),   r.strides_[lb - 2],   r.strides_[lb - 1]};
+        kernels::gemm_batched(batch, m, n, k, A, a_off.data(), B, b_off.data(),
+                              out.data<float>(), std::ptrdiff_t(n),
+                              std::ptrdiff_t(m * n));
+    }
+    if (scope.active()) {
+        // Sans conversion, lhs et r sont des vues de *this et rhs : mêmes
+        // adresses, mêmes strides de matrice
+        graph::Kernel kernel;
+        if (dtype_ == compute_dtype && rhs.dtype_ == compute_dtype) {
+            const std::ptrdiff_t as0 = lhs.strides_[la - 2], as1 = lhs.strides_[la - 1];
+            const std::ptrdiff_t bs0 = r.strides_[lb - 2],   bs1 = r.strides_[lb - 1];
+            kernel = [=](const std::vector<Tensor>& in, Tensor& o) {
+                auto run = [&](auto tag) {
+                    using T   = decltype(tag);
+                    using Ref = kernels::matrix_ref_t<T>;
+                    kernels::gemm_batched(batch, m, n, k, Ref{in[0].data<T>(), as0, as1},
+                                          a_off.data(), Ref{in[1].data<T>(), bs0, bs1},
+                                          b_off.data(), o.data<T>(), std::ptrdiff_t(n),
+                                          std::ptrdiff_t(m * n));
+                };
+                if (o.dtype() == DType::Float64) run(double());
+                else                             run(float());
+            };
+        } else {
+            kernel = graph::eager_kernel([](const std::vector<Tensor>& in) {
+                return in[0].matmul(in[1]);
+            });
+        }
+        if (out_dtype != compute_dtype)
+            out = out.astype(out_dtype);
+        graph::record("matmul", {*this, rhs}, out, std::move(kernel));
+    } else if (out_dtype != compute_dtype) {
+        out = out.astype(out_dtype);
+    }
+    if (requires_grad() || rhs.requires_grad())
+        out.set_grad_fn(std::make_shared<MatMulBackward>(*this, rhs));
+    if (prof.active()) prof.record_io({*this, rhs}, out, 2.0 * double(batch * m * n * k));
+    return out;
+}
+
+Tensor Tensor::exp() const {
+    if (!is_floating_point(dtype_))
+        throw std::runtime_error("exp: integer dtypes not supported");
+    profiler::RecordScope prof("exp");
+    graph::CaptureScope scope;
+    const Tensor src = contiguous();
+    Tensor out(shape_, dtype_, device_);
+    NAPCAS_DISPATCH_FLOATING_TYPES(dtype_, "exp", [&] {
+        kernels::exp(out.data<scalar_t>(), src.data<scalar_t>(), numel());
+    });
+    if (scope.active()) {
+        graph::Kernel kernel = [](const std::vector<Tensor>& in, Tensor& o) {
+            NAPCAS_DISPATCH_FLOATING_TYPES(o.dtype(), "exp", [&] {
+                kernels::exp(o.data<scalar_t>(), in[0].data<scalar_t>(), o.numel());
+            });
+        };
+        if (!is_contiguous())
+            kernel = graph::eager_kernel([](const std::vector<Tensor>& in) {
+                return in[0].exp();
+            });
+        graph::record("exp", {*this}, out, std::move(kernel));
+    }
+    if (requires_grad())
+        out.set_grad_fn(std::make_shared<ExpBackward>(*this, out));
+    if (prof.active()) prof.record_io({*this}, out, double(out.numel()));
+    return out;
+}
+
+// ===================== Réductions =====================
+
+namespace {
+    // Axes réduits (masque) et forme de sortie ; le résultat dense a le même
+    // ordre linéaire avec ou sans keepdim
+    struct ReducePlan {
+        std::vector<bool>        axes;
+        Shape out_shape;
+    };
+
+    ReducePlan reduce_plan(const char* name, const Shape& shape,
+                           const std::vector<int>& dims, bool keepdim) {
+        const int nd = int(shape.size());
+        ReducePlan p;
+        p.axes.assign(shape.size(), dims.empty());
+        for (int d : dims) {
+            const int a = d < 0 ? d + nd : d;
+            if (a < 0 || a >= nd)
+                throw std::runtime_error(std::string(name) + ": dim " + std::to_string(d) +
+                                         " out of range");
+            if (p.axes[a])
+                throw std::runtime_error(std::string(name) + ": dim " + std::to_string(d) +
+                                         " appears multiple times");
+            p.axes[a] = true;
+        }
+        for (int d = 0; d < nd; ++d) {
+            if (!p.axes[d])   p.out_shape.push_back(shape[d]);
+            else if (keepdim) p.out_shape.push_back(1);
+        }
+        return p;
+    }
+
+    void check_floating(const char* name, DType dtype) {
+        if (!is_floating_point(dtype))
+            throw std::runtime_error(std::string(name) + ": integer dtypes not supported");
+    }
+
+    // La somme d'entiers est en int64 (comme NumPy) : le type d'entrée
+    // déborderait
+    void run_reduce_kernel(kernels::ReduceOp op, const char* name, Tensor& out,
+                           const Tensor& in, const std::vector<bool>& axes) {
+        NAPCAS_DISPATCH_ALL_TYPES(in.dtype(), name, [&] {
+            if constexpr (std::is_integral<scalar_t>::value) {
+                if (op == kernels::ReduceOp::Sum) {
+                    kernels::sum_int64(out.data<std::int64_t>(), in.data<scalar_t>(),
+                                       in.shape(), in.strides(), axes);
+                    return;
+                }
+            }
+            kernels::reduce(op, out.data<scalar_t>(), in.data<scalar_t>(),
+                            in.shape(), in.strides(), axes);
+        });
+    }
+
+    Tensor reduce_op(const Tensor& t, kernels::ReduceOp op, const char* name,
+                     const ReducePlan& p) {
+        profiler::RecordScope prof(name);
+        graph::CaptureScope scope;
+        const DType dtype = op == kernels::ReduceOp::Sum && !is_floating_point(t.dtype())
+                                ? DType::Int64 : t.dtype();
+        Tensor out(p.out_shape, dtype, t.device());
+        run_reduce_kernel(op, name, out, t, p.axes);
+        if (scope.active())
+            graph::record(name, {t}, out,
+                          [op, name, axes = p.axes](const std::vector<Tensor>& in, Tensor& o) {
+                run_reduce_kernel(op, name, o, in[0], axes);
+            });
+        if (prof.active()) prof.record_io({t}, out, double(t.numel()));
+        return out;
+    }
+
+    Tensor arg_reduce_op(const Tensor& t, bool is_max, const ReducePlan& p) {
+        const char* name = is_max ? "argmax" : "argmin";
+        profiler::RecordScope prof(name);
+        graph::CaptureScope scope;
+        Tensor out(p.out_shape, DType::Int64, t.device());
+        NAPCAS_DISPATCH_ALL_TYPES(t.dtype(), name, [&] {
+            kernels::arg_reduce(is_max, out.data<std::int64_t>(), t.data<scalar_t>(),
+                                t.shape(), t.strides(), p.axes);
+        });
+        if (scope.active())
+            graph::record(name, {t}, out,
+                          [is_max, name, axes = p.axes](const std::vector<Tensor>& in, Tensor& o) {
+                NAPCAS_DISPATCH_ALL_TYPES(in[0].dtype(), name, [&] {
+                    kernels::arg_reduce(is_max, o.data<std::int64_t>(), in[0].data<scalar_t>(),
+                                        in[0].shape(), in[0].strides(), axes);
+                });
+            });
+        if (prof.active()) prof.record_io({t}, out, double(t.numel()));
+        return out;
+    }
+
+    // var / std : lecture strided, comme reduce_op
+    Tensor variance_op(const Tensor& t, const ReducePlan& p, std::size_t correction,
+                       bool take_sqrt) {
+        const char* name = take_sqrt ? "std" : "var";
+        profiler::RecordScope prof(name);
+        graph::CaptureScope scope;
+        Tensor out(p.out_shape, t.dtype(), t.device());
+        NAPCAS_DISPATCH_FLOATING_TYPES(t.dtype(), name, [&] {
+            kernels::variance(out.data<scalar_t>(), t.data<scalar_t>(), t.shape(), t.strides(),
+                              p.axes, correction, take_sqrt);
+        });
+        if (scope.active())
+            graph::record(name, {t}, out, [=, axes = p.axes](const std::vector<Tensor>& in,
+                                                             Tensor& o) {
+                NAPCAS_DISPATCH_FLOATING_TYPES(o.dtype(), name, [&] {
+                    kernels::variance(o.data<scalar_t>(), in[0].data<scalar_t>(),
+                                      in[0].shape(), in[0].strides(), axes, correction,
+                                      take_sqrt);
+                });
+            });
+        if (prof.active()) prof.record_io({t}, out, double(t.numel()));
+        return out;
+    }
+}
+
+Tensor Tensor::sum(const std::vector<int>& dims, bool keepdim) const {
+    const ReducePlan p = reduce_plan("sum", shape_, dims, keepdim);
+    Tensor out = reduce_op(*this, kernels::ReduceOp::Sum, "sum", p);
+    if (requires_grad())
+        out.set_grad_fn(std::make_shared<SumBackward>(*this, p.axes));
+    return out;
+}
+
+Tensor Tensor::mean(const std::vector<int>& dims, bool keepdim) const {
+    check_floating("mean", dtype_);
+    const ReducePlan p = reduce_plan("mean", shape_, dims, keepdim);
+    Tensor out = reduce_op(*this, kernels::ReduceOp::Mean, "mean", p);
+    if (requires_grad())
+        out.set_grad_fn(std::make_shared<MeanBackward>(*this, p.axes));
+    return out;
+}
+
+Tensor Tensor::max(const std::vector<int>& dims, bool keepdim) const {
+    const ReducePlan p = reduce_plan("max", shape_, dims, keepdim);
+    Tensor out = reduce_op(*this, kernels::ReduceOp::Max, "max", p);
+    if (requires_grad())
+        out.set_grad_fn(std::make_shared<MaxMinBackward>(
+            *this, p.axes, arg_reduce_op(*this, true, p), true));
+    return out;
+}
+
+Tensor Tensor::min(const std::vector<int>& dims, bool keepdim) const {
+    const ReducePlan p = reduce_plan("min", shape_, dims, keepdim);
+    Tensor out = reduce_op(*this, kernels::ReduceOp::Min, "min", p);
+    if (requires_grad())
+        out.set_grad_fn(std::make_shared<MaxMinBackward>(
+            *this, p.axes, arg_reduce_op(*this, false, p), false));
+    return out;
+}
+
+Tensor Tensor::argmax(const std::vector<int>& dims, bool keepdim) const {
+    return arg_reduce_op(*this, true, reduce_plan("argmax", shape_, dims, keepdim));
+}
+
+Tensor Tensor::argmin(const std::vector<int>& dims, bool keepdim) const {
+    return arg_reduce_op(*this, false, reduce_plan("argmin", shape_, dims, keepdim));
+}
+
+Tensor Tensor::var(const std::vector<int>& dims, std::size_t correction, bool keepdim) const {
+    check_floating("var", dtype_);
+    const ReducePlan p = reduce_plan("var", shape_, dims, keepdim);
+    Tensor out = variance_op(*this, p, correction, false);
+    if (requires_grad())
+        out.set_grad_fn(std::make_shared<VarBackward>(*this, p.axes, correction));
+    return out;
+}
+
+Tensor Tensor::std(const std::vector<int>& dims, std::size_t correction, bool keepdim) const {
+    check_floating("std", dtype_);
+    const ReducePlan p = reduce_plan("std", shape_, dims, keepdim);
+    Tensor out = variance_op(*this, p, correction, true);
+    if (requires_grad())
+        out.set_grad_fn(std::make_shared<VarBackward>(*this, p.axes, correction, out));
+    return out;
+}
+
+Tensor Tensor::logsumexp(const std::vector<int>& dims, bool keepdim) const {
+    check_floating("logsumexp", dtype_);
+    const ReducePlan p = reduce_plan("logsumexp", shape_, dims, keepdim);
+    Tensor out = reduce_op(*this, kernels::ReduceOp::LogSumExp, "logsumexp", p);
+    if (requires_grad())
+        out.set_grad_fn(std::make_shared<LogSumExpBackward>(*this, p.axes, out));
+    return out;
+}
+
+// ===================== Activations et normalisations =====================
+
+namespace {
+    Tensor activation_op(const Tensor& t, kernels::Activation act, const char* name) {
+        check_floating(name, t.dtype());
+        profiler::RecordScope prof(name);
+        graph::CaptureScope scope;
+        const Tensor src = t.contiguous();
+        Tensor out(t.shape(), t.dtype(), t.device());
+        NAPCAS_DISPATCH_FLOATING_TYPES(t.dtype(), name, [&] {
+            kernels::activation(act, out.data<scalar_t>(), src.data<scalar_t>(), t.numel());
+        });
+        if (scope.active()) {
+            graph::Kernel kernel = [act, name](const std::vector<Tensor>& in, Tensor& o) {
+                NAPCAS_DISPATCH_FLOATING_TYPES(o.dtype(), name, [&] {
+                    kernels::activation(act, o.data<scalar_t>(), in[0].data<scalar_t>(),
+                                        o.numel());
+                });
+            };
+            if (!t.is_contiguous())
+                kernel = graph::eager_kernel([act, name](const std::vector<Tensor>& in) {
+                    return activation_op(in[0], act, name);
+                });
+            graph::record(name, {t}, out, std::move(kernel));
+        }
+        if (t.requires_grad())
+            out.set_grad_fn(std::make_shared<ActivationBackward>(
+                t, act == kernels::Activation::ReLU ? out : src, act));
+        if (prof.active()) prof.record_io({t}, out, double(t.numel()));
+        return out;
+    }
+
+    // softmax sur `dim` : la dimension est ramenée en dernière position
+    // (copie dense) puis traitée ligne par ligne
+    Tensor softmax_op(const Tensor& t, int dim, bool log) {
+        const char* name = log ? "log_softmax" : "softmax";
+        check_floating(name, t.dtype());
+        const int nd = int(t.ndim());
+        const int d = dim < 0 ? dim + nd : dim;
+        if (nd == 0 || d < 0 || d >= nd)
+            throw std::runtime_error(std::string(name) + ": dim out of range");
+        const int last = nd - 1;
+        profiler::RecordScope prof(name);
+        graph::CaptureScope scope;
+        const Tensor src = d == last ? t.contiguous() : t.detach().transpose(d, last).contiguous();
+        Tensor rows_out(src.shape(), t.dtype(), t.device());
+        const std::size_t cols = src.shape().back();
+        const std::size_t rows = cols ? src.numel() / cols : 0;
+        NAPCAS_DISPATCH_FLOATING_TYPES(t.dtype(), name, [&] {
+            kernels::softmax(rows_out.data<scalar_t>(), src.data<scalar_t>(), rows, cols, log);
+        });
+        Tensor out = d == last ? rows_out : rows_out.transpose(d, last);
+        if (scope.active()) {
+            // Entrée non contiguë ou dimension interne : recopiée en lignes
+            // denses dans un tampon alloué une fois
+            const bool direct = d == last && t.is_contiguous();
+            Tensor scratch = direct ? Tensor() : Tensor(src.shape(), t.dtype(), t.device());
+            Shape   rshape   = t.shape();
+            Strides rstrides = t.strides();
+            std::swap(rshape[d], rshape[last]);
+            std::swap(rstrides[d], rstrides[last]);
+            graph::record(name, {t}, out, [=](const std::vector<Tensor>& in, Tensor& o) mutable {
+                const void* rows_in = in[0].data_ptr();
+                if (!direct) {
+                    kernels::strided_copy(scratch.data_ptr(), rows_in, rshape, rstrides,
+                                          dtype_size(o.dtype()));
+                    rows_in = scratch.data_ptr();
+                }
+                // `o` est la vue transposée de lignes denses : même adresse
+                NAPCAS_DISPATCH_FLOATING_TYPES(o.dtype(), name, [&] {
+                    kernels::softmax(static_cast<scalar_t*>(o.data_ptr()),
+                                     static_cast<const scalar_t*>(rows_in), rows, cols, log);
+                });
+            });
+        }
+        if (t.requires_grad())
+            out.set_grad_fn(std::make_shared<SoftmaxBackward>(t, rows_out, d, log));
+        if (prof.active()) prof.record_io({t}, out, double(t.numel()));
+        return out;
+    }
+
+    // Paramètre de normalisation : absent, ou de forme [cols] et du type de l'entrée
+    Tensor norm_param(const Tensor& p, const Tensor& x, const char* name, const char* what) {
+        if (!p.defined()) return Tensor();
+        if (p.shape() != Shape{x.shape().back()})
+            throw std::runtime_error(std::string(name) + ": " + what +
+                                     " must have shape [normalized dim]");
+        if (p.dtype() != x.dtype())
+            throw std::runtime_error(std::string(name) + ": " + what + " dtype mismatch");
+        return p.contiguous();
+    }
+
+    DType stat_dtype(DType dtype) {
+        return dtype == DType::Float64 ? DType::Float64 : DType::Float32;
+    }
+}
+
+Tensor Tensor::relu() const { return activation_op(*this, kernels::Activation::ReLU, "relu"); }
+Tensor Tensor::gelu() const { return activation_op(*this, kernels::Activation::GELU, "gelu"); }
+Tensor Tensor::silu() const { return activation_op(*this, kernels::Activation::SiLU, "silu"); }
+
+Tensor Tensor::softmax(int dim) const     { return softmax_op(*this, dim, false); }
+Tensor Tensor::log_softmax(int dim) const { return softmax_op(*this, dim, true); }
+
+Tensor Tensor::layer_norm(const Tensor& weight, const Tensor& bias, double eps) const {
+    check_floating("layer_norm", dtype_);
+    if (shape_.empty())
+        throw std::runtime_error("layer_norm: 0-d input");
+    profiler::RecordScope prof("layer_norm");
+    graph::CaptureScope scope;
+    const Tensor w = norm_param(weight, *this, "layer_norm", "weight");
+    const Tensor b = norm_param(bias, *this, "layer_norm", "bias");
+    const Tensor x = contiguous();
+    const std::size_t cols = shape_.back();
+    const std::size_t rows = cols ? numel() / cols : 0;
+    Tensor out(shape_, dtype_, device_);
+    Tensor mean({rows}, stat_dtype(dtype_), device_);
+    Tensor rstd({rows}, stat_dtype(dtype_), device_);
+    NAPCAS_DISPATCH_FLOATING_TYPES(dtype_, "layer_norm", [&] {
+        using stat_t = compute_type_t<scalar_t>;
+        kernels::layer_norm(out.data<scalar_t>(), mean.data<stat_t>(), rstd.data<stat_t>(),
+                            x.data<scalar_t>(),
+                            w.defined() ? w.data<scalar_t>() : nullptr,
+                            b.defined() ? b.data<scalar_t>() : nullptr,
+                            rows, cols, eps);
+    });
+    if (scope.active()) {
+        graph::Kernel kernel;
+        if (is_contiguous() && (!weight.defined() || weight.is_contiguous()) &&
+            (!bias.defined() || bias.is_contiguous())) {
+            Tensor m(mean.shape(), mean.dtype(), device_), r(rstd.shape(), rstd.dtype(), device_);
+            kernel = [=](const std::vector<Tensor>& in, Tensor& o) mutable {
+                NAPCAS_DISPATCH_FLOATING_TYPES(o.dtype(), "layer_norm", [&] {
+                    using stat_t = compute_type_t<scalar_t>;
+                    kernels::layer_norm(o.data<scalar_t>(), m.data<stat_t>(), r.data<stat_t>(),
+                                        in[0].data<scalar_t>(),
+                                        in[1].defined() ? in[1].data<scalar_t>() : nullptr,
+                                        in[2].defined() ? in[2].data<scalar_t>() : nullptr,
+                                        rows, cols, eps);
+                });
+            };
+        } else {
+            kernel = graph::eager_kernel([eps](const std::vector<Tensor>& in) {
+                return in[0].layer_norm(in[1], in[2], eps);
+            });
+        }
+        graph::record("layer_norm", {*this, weight, bias}, out, std::move(kernel));
+    }
+    if (requires_grad() || weight.requires_grad() || bias.requires_grad())
+        out.set_grad_fn(std::make_shared<LayerNormBackward>(*this, weight, bias, mean, rstd));
+    if (prof.active()) prof.record_io({*this, weight, bias}, out, double(numel()));
+    return out;
+}
+
+Tensor Tensor::rms_norm(const Tensor& weight, double eps) const {
+    check_floating("rms_norm", dtype_);
+    if (shape_.empty())
+        throw std::runtime_error("rms_norm: 0-d input");
+    profiler::RecordScope prof("rms_norm");
+    graph::CaptureScope scope;
+    const Tensor w = norm_param(weight, *this, "rms_norm", "weight");
+    const Tensor x = contiguous();
+    const std::size_t cols = shape_.back();
+    const std::size_t rows = cols ? numel() / cols : 0;
+    Tensor out(shape_, dtype_, device_);
+    Tensor rstd({rows}, stat_dtype(dtype_), device_);
+    NAPCAS_DISPATCH_FLOATING_TYPES(dtype_, "rms_norm", [&] {
+        using stat_t = compute_type_t<scalar_t>;
+        kernels::rms_norm(out.data<scalar_t>(), rstd.data<stat_t>(), x.data<scalar_t>(),
+                          w.defined() ? w.data<scalar_t>() : nullptr, rows, cols, eps);
+    });
+    if (scope.active()) {
+        graph::Kernel kernel;
+        if (is_contiguous() && (!weight.defined() || weight.is_contiguous())) {
+            Tensor r(rstd.shape(), rstd.dtype(), device_);
+            kernel = [=](const std::vector<Tensor>& in, Tensor& o) mutable {
+                NAPCAS_DISPATCH_FLOATING_TYPES(o.dtype(), "rms_norm", [&] {
+                    using stat_t = compute_type_t<scalar_t>;
+                    kernels::rms_norm(o.data<scalar_t>(), r.data<stat_t>(), in[0].data<scalar_t>(),
+                                      in[1].defined() ? in[1].data<scalar_t>() : nullptr,
+                                      rows, cols, eps);
+                });
+            };
+        } else {
+            kernel = graph::eager_kernel([eps](const std::vector<Tensor>& in) {
+                return in[0].rms_norm(in[1], eps);
+            });
+        }
+        graph::record("rms_norm", {*this, weight}, out, std::move(kernel));
     }
+    if (requires_grad() || weight.requires_grad())
+        out.set_grad_fn(std::make_shared<RMSNormBackward>(*this, weight, rstd));
+    if (prof.active()) prof.record_io({*this, weight}, out, double(numel()));
     return out;
 }
 
@@ -433,11 +1240,7 @@ void Tensor::print_summary() const {
         std::cout << shape_[i];
         if (i + 1 < shape_.size()) std::cout << ", ";
     }
-    std::cout << "], dtype=";
-    switch (dtype_) {
-        case DType::Float32: std::cout << "float32"; break;
-        case DType::Int32:   std::cout << "int32";   break;
-    }
+    std::cout << "], dtype=" << dtype_to_string(dtype_);
     std::cout << ", device=";
     switch (device_.type) {
         case DeviceType::CPU:  std::cout << "cpu";  break;
@@ -458,108 +1261,98 @@ void Tensor::print_shape() const {
 // ===================== Autograd access & backward =====================
 
 Tensor& Tensor::grad() {
-    if (!grad_ptr_) {
-        grad_ptr_.reset(new Tensor(Tensor::ones(shape_, dtype_, device_)));
-    }
-    return *grad_ptr_;
+    AutogradMeta& meta = autograd_meta();
+    std::lock_guard<std::mutex> lock(meta.mutex);
+    if (!meta.grad.defined())
+        meta.grad = Tensor::zeros(shape_, dtype_, device_);
+    return meta.grad;
 }
 
 const Tensor& Tensor::grad() const {
-    if (!grad_ptr_) {
+    if (!has_grad()) {
         throw std::runtime_error("Gradient has not been initialized");
     }
-    return *grad_ptr_;
+    return autograd_->grad;
+}
+
+bool Tensor::has_grad() const noexcept {
+    return autograd_ && autograd_->grad.defined();
+}
+
+void Tensor::zero_grad() {
+    if (!autograd_) return;
+    std::lock_guard<std::mutex> lock(autograd_->mutex);
+    autograd_->grad = Tensor();
 }
 
 void Tensor::backward() {
-    if (!requires_grad_flag_) {
-        throw std::runtime_error(
-            "Cannot call backward() on a tensor that does not require grad"
-        );
-    }
-    if (!grad_ptr_) {
-        grad_ptr_.reset(new Tensor(Tensor::ones(shape_, dtype_, device_)));
-    }
-    std::vector<std::shared_ptr<GradFn>> stack;
-    std::unordered_set<GradFn*> visited;
-    if (grad_fn_) {
-        stack.push_back(grad_fn_);
-        visited.insert(grad_fn_.get());
-    }
-    while (!stack.empty()) {
-        auto fn = stack.back(); stack.pop_back();
-        fn->backward();
-        for (Tensor* inp : fn->prev()) {
-            if (inp->grad_fn_) {
-                auto prev_fn = inp->grad_fn_;
-                if (visited.insert(prev_fn.get()).second) {
-                    stack.push_back(prev_fn);
-                }
-            }
-        }
-    }
+    backward(Tensor::ones(shape_, dtype_, device_));
+}
+
+void Tensor::backward(const Tensor& grad_output, bool retain_graph) {
+    autograd::backward(*this, grad_output, retain_graph);
 }
 
 // ===================== Data access =====================
 
 template<typename T>
 T* Tensor::data() {
-    return static_cast<T*>(storage_.get());
+    return static_cast<T*>(data_ptr());
 }
 
 template<typename T>
 const T* Tensor::data() const {
-    return static_cast<const T*>(storage_.get());
+    return static_cast<const T*>(data_ptr());
 }
 
-template float*       Tensor::data<float>();
-template const float* Tensor::data<float>() const;
-
-// Instantiate template constructor
-template Tensor::Tensor(const std::vector<std::size_t>&,
-                        const std::vector<float>&,
-                        DType, Device);
+// Instanciations pour chaque type de dispatch.h
+#define NAPCAS_INSTANTIATE_TENSOR(T)                                           \
+    template T*       Tensor::data<T>();                                       \
+    template const T* Tensor::data<T>() const;                                 \
+    template Tensor::Tensor(const Shape&,                                      \
+                            const std::vector<T>&,                             \
+                            DType, Device);
+
+NAPCAS_INSTANTIATE_TENSOR(float)
+NAPCAS_INSTANTIATE_TENSOR(double)
+NAPCAS_INSTANTIATE_TENSOR(Half)
+NAPCAS_INSTANTIATE_TENSOR(BFloat16)
+NAPCAS_INSTANTIATE_TENSOR(std::int8_t)
+NAPCAS_INSTANTIATE_TENSOR(std::uint8_t)
+NAPCAS_INSTANTIATE_TENSOR(std::int32_t)
+NAPCAS_INSTANTIATE_TENSOR(std::int64_t)
+
+#undef NAPCAS_INSTANTIATE_TENSOR
 
 // ===================== Copy & assignment =====================
 
+// Copie superficielle : les deux Tensor partagent le même Storage.
+
 Tensor::Tensor(const Tensor& other)
   : shape_(other.shape_),
     strides_(other.strides_),
+    numel_(other.numel_),
+    is_contiguous_(other.is_contiguous_),
     dtype_(other.dtype_),
     device_(other.device_),
-    storage_(nullptr, default_deleter),
-    requires_grad_flag_(other.requires_grad_flag_)
-{
-    size_t bytes = numel() * dtype_size(dtype_);
-    void* raw = device_malloc(bytes, device_);
-    std::memcpy(raw, other.storage_.get(), bytes);
-    storage_.reset(raw);
-
-    if (other.grad_ptr_) {
-        grad_ptr_ = std::make_shared<Tensor>(*other.grad_ptr_);
-    }
-    grad_fn_ = other.grad_fn_;
-}
+    storage_(other.storage_),
+    storage_offset_(other.storage_offset_),
+    is_view_(other.is_view_),
+    autograd_(other.autograd_)
+{}
 
 Tensor& Tensor::operator=(const Tensor& other) {
     if (this == &other) return *this;
     shape_              = other.shape_;
     strides_            = other.strides_;
+    numel_              = other.numel_;
+    is_contiguous_      = other.is_contiguous_;
     dtype_              = other.dtype_;
     device_             = other.device_;
-    requires_grad_flag_ = other.requires_grad_flag_;
-
-    size_t bytes = numel() * dtype_size(dtype_);
-    void* raw = device_malloc(bytes, device_);
-    std::memcpy(raw, other.storage_.get(), bytes);
-    storage_.reset(raw);
-
-    if (other.grad_ptr_) {
-        grad_ptr_ = std::make_shared<Tensor>(*other.grad_ptr_);
-    } else {
-        grad_ptr_.reset();
-    }
-    grad_fn_ = other.grad_fn_;
+    storage_            = other.storage_;
+    storage_offset_     = other.storage_offset_;
+    is_view_            = other.is_view_;
+    autograd_           = other.autograd_;
     return *this;
 }
 
@@ -7,5 +7,40 @@ Tensor     = _napcas.Tensor
 Device     = _napcas.Device
 DeviceType = _napcas.DeviceType
 DType      = _napcas.DType
+LazyTensor = _napcas.LazyTensor
+Activation = _napcas.Activation
+ConvAlgorithm = _napcas.ConvAlgorithm
+Module     = _napcas.Module
+Autograd   = _napcas.Autograd
+Graph      = _napcas.Graph
 
-__all__ = ["Tensor", "Device", "DeviceType", "DType"]
+architecture = _napcas.architecture
+optim        = _napcas.optim
+data         = _napcas.data
+
+from . import profiler
+
+promote_types = _napcas.promote_types
+from_dlpack   = _napcas.from_dlpack
+
+add = _napcas.add
+sub = _napcas.sub
+mul = _napcas.mul
+div = _napcas.div
+
+save_checkpoint = _napcas.save_checkpoint
+load_checkpoint = _napcas.load_checkpoint
+
+set_num_threads = _napcas.set_num_threads
+get_num_threads = _napcas.get_num_threads
+cpu_capability  = _napcas.cpu_capability
+
+allocator_stats  = _napcas.allocator_stats
+reset_peak_stats = _napcas.reset_peak_stats
+empty_cache      = _napcas.empty_cache
+
+__all__ = ["Tensor", "LazyTensor", "Device", "DeviceType", "DType", "promote_types", "from_dlpack",
+           "Activation", "ConvAlgorithm", "Module", "Autograd", "Graph", "architecture", "optim", "data", "profiler",
+           "add", "sub", "mul", "div", "save_checkpoint", "load_checkpoint",
+           "set_num_threads", "get_num_threads", "cpu_capability",
+           "allocator_stats", "reset_peak_stats", "empty_cache"]
@@ -0,0 +1,51 @@
+# profiler.py — profileur d'opérations natif (voir cpp/include/napcas/profiler.h)
+import importlib
+
+_profiler = importlib.import_module("napcas._napcas").profiler
+
+EventKind = _profiler.EventKind
+enabled   = _profiler.enabled
+
+
+class profile:
+    """Enregistre les opérations de Tensor, les GradFn du backward, les
+    forward de modules et les allocations exécutés dans le bloc :
+
+        with napcas.profiler.profile() as prof:
+            model(x).sum().backward()
+        print(prof.table(max_rows=20))
+        prof.export_chrome_trace("trace.json")   # chrome://tracing, Perfetto
+
+    Les événements sont copiés à la sortie du bloc ; hors d'un bloc, le coût
+    par opération est un test de booléen.
+    """
+
+    def __init__(self):
+        self.events = []
+
+    def __enter__(self):
+        _profiler.clear()
+        _profiler.start()
+        return self
+
+    def __exit__(self, *exc):
+        _profiler.stop()
+        self.events = _profiler.events()
+        _profiler.clear()
+        return False
+
+    def summary(self):
+        """Un agrégat par (nom, catégorie), trié par temps propre décroissant"""
+        return _profiler.summarize(self.events)
+
+    def table(self, max_rows=0):
+        return _profiler.format_table(self.summary(), max_rows)
+
+    def chrome_trace(self):
+        return _profiler.chrome_trace(self.events)
+
+    def export_chrome_trace(self, path):
+        _profiler.export_chrome_trace(self.events, path)
+
+
+__all__ = ["profile", "EventKind", "enabled"]
@@ -0,0 +1,399 @@
+#include <gtest/gtest.h>
+#include "napcas/architecture/conv.h"
+#include "napcas/grad_fn.h"
+#include "napcas/graph.h"
+#include "napcas/tensor.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+
+using namespace napcas;
+using architecture::Conv2d;
+using architecture::Size2;
+using kernels::ConvAlgorithm;
+
+namespace {
+Tensor random(const std::vector<std::size_t>& shape, unsigned seed, DType dtype = DType::Float32) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> u(-1.0, 1.0);
+    std::size_t n = 1;
+    for (auto s : shape) n *= s;
+    std::vector<double> v(n);
+    for (auto& e : v) e = u(rng);
+    return Tensor(shape, v, dtype);
+}
+
+std::vector<double> values(const Tensor& t) {
+    Tensor c = t.astype(DType::Float64).contiguous();
+    return std::vector<double>(c.data<double>(), c.data<double>() + c.numel());
+}
+
+void expect_close(const Tensor& a, const Tensor& b, double tol) {
+    ASSERT_EQ(a.shape(), b.shape());
+    const auto va = values(a), vb = values(b);
+    for (std::size_t i = 0; i < va.size(); ++i) EXPECT_NEAR(va[i], vb[i], tol) << i;
+}
+
+struct ConvCase {
+    std::size_t N, C, H, W, K, R, S;
+    Size2 stride, padding, dilation;
+    std::size_t groups;
+};
+
+// Convolution directe en float64 sur [N, C, H, W] : sortie et, pour un
+// gradient de sortie gy, gradients de x, w et b
+struct Reference {
+    Tensor y, dx, dw, db;
+};
+
+Reference reference(const ConvCase& c, const Tensor& x, const Tensor& w, const Tensor& gy) {
+    const std::size_t OH = (c.H + 2 * c.padding[0] - c.dilation[0] * (c.R - 1) - 1) / c.stride[0] + 1;
+    const std::size_t OW = (c.W + 2 * c.padding[1] - c.dilation[1] * (c.S - 1) - 1) / c.stride[1] + 1;
+    const std::size_t Cg = c.C / c.groups, Kg = c.K / c.groups;
+    const auto vx = values(x), vw = values(w);
+    const auto vg = gy.defined() ? values(gy) : std::vector<double>(c.N * c.K * OH * OW, 0.0);
+    std::vector<double> y(c.N * c.K * OH * OW, 0.0), dx(vx.size(), 0.0), dw(vw.size(), 0.0),
+                        db(c.K, 0.0);
+    for (std::size_t n = 0; n < c.N; ++n)
+    for (std::size_t k = 0; k < c.K; ++k)
+    for (std::size_t oh = 0; oh < OH; ++oh)
+    for (std::size_t ow = 0; ow < OW; ++ow) {
+        const std::size_t yi = ((n * c.K + k) * OH + oh) * OW + ow;
+        db[k] += vg[yi];
+        const std::size_t g = k / Kg;
+        for (std::size_t ci = 0; ci < Cg; ++ci)
+        for (std::size_t r = 0; r < c.R; ++r)
+        for (std::size_t s = 0; s < c.S; ++s) {
+            const long ih = long(oh * c.stride[0] + r * c.dilation[0]) - long(c.padding[0]);
+            const long iw = long(ow * c.stride[1] + s * c.dilation[1]) - long(c.padding[1]);
+            if (ih < 0 || iw < 0 || ih >= long(c.H) || iw >= long(c.W)) continue;
+            const std::size_t xi = ((n * c.C + g * Cg + ci) * c.H + std::size_t(ih)) * c.W + std::size_t(iw);
+            const std::size_t wi = ((k * Cg + ci) * c.R + r) * c.S + s;
+            y[yi]  += vx[xi] * vw[wi];
+            dx[xi] += vg[yi] * vw[wi];
+            dw[wi] += vg[yi] * vx[xi];
+        }
+    }
+    return {Tensor({c.N, c.K, OH, OW}, y, DType::Float64), Tensor(x.shape(), dx, DType::Float64),
+            Tensor(w.shape(), dw, DType::Float64), Tensor({c.K}, db, DType::Float64)};
+}
+
+Tensor add_bias(const Tensor& y, const Tensor& b) {
+    return y + b.astype(DType::Float64).reshape({1, b.numel(), 1, 1});
+}
+
+const std::vector<ConvCase>& cases() {
+    static const std::vector<ConvCase> all = {
+        {2, 3, 7, 6, 4, 3, 3, {1, 1}, {1, 1}, {1, 1}, 1},     // 3x3 "same"
+        {1, 16, 9, 11, 16, 3, 3, {1, 1}, {1, 1}, {1, 1}, 1},  // éligible Winograd, tuiles de bord
+        {2, 4, 8, 8, 6, 1, 1, {1, 1}, {0, 0}, {1, 1}, 2},     // 1x1 par groupes
+        {1, 3, 9, 9, 5, 1, 1, {2, 2}, {0, 0}, {1, 1}, 1},     // 1x1 avec pas
+        {2, 3, 11, 10, 4, 5, 3, {2, 1}, {2, 1}, {1, 1}, 1},   // rectangulaire, pas 2
+        {1, 4, 10, 10, 4, 3, 3, {1, 1}, {2, 2}, {2, 2}, 1},   // dilatation
+        {2, 8, 7, 7, 8, 3, 3, {1, 1}, {1, 1}, {1, 1}, 8},     // depthwise
+        {1, 6, 9, 8, 12, 3, 3, {2, 2}, {1, 1}, {1, 1}, 6},    // depthwise, multiplicateur 2
+        {1, 6, 8, 8, 6, 3, 3, {1, 1}, {1, 1}, {1, 1}, 3},     // groupes de 2 canaux
+        {3, 2, 4, 4, 3, 4, 4, {1, 1}, {0, 0}, {1, 1}, 1},     // noyau = entrée
+    };
+    return all;
+}
+
+Tensor run_conv(const ConvCase& c, const Tensor& x, const Tensor& w, const Tensor& b,
+                ConvAlgorithm algo = ConvAlgorithm::Auto) {
+    return architecture::conv2d(x, w, b, c.stride, c.padding, c.dilation, c.groups, algo);
+}
+
+kernels::Conv2dShape shape_of(const ConvCase& c) {
+    kernels::Conv2dShape p;
+    p.N = c.N; p.C = c.C; p.H = c.H; p.W = c.W; p.K = c.K; p.R = c.R; p.S = c.S;
+    p.stride_h = c.stride[0]; p.stride_w = c.stride[1];
+    p.pad_h = c.padding[0];   p.pad_w = c.padding[1];
+    p.dil_h = c.dilation[0];  p.dil_w = c.dilation[1];
+    p.groups = c.groups;
+    return p;
+}
+
+// Pooling direct en float64 : sortie et gradient de x pour gy
+std::pair<Tensor, Tensor> pool_reference(const Tensor& x, Size2 k, Size2 st, Size2 pad,
+                                         bool is_max, bool count_include_pad, const Tensor& gy) {
+    const std::size_t N = x.shape()[0], C = x.shape()[1], H = x.shape()[2], W = x.shape()[3];
+    const std::size_t OH = (H + 2 * pad[0] - k[0]) / st[0] + 1, OW = (W + 2 * pad[1] - k[1]) / st[1] + 1;
+    const auto vx = values(x), vg = values(gy);
+    std::vector<double> y(N * C * OH * OW), dx(vx.size(), 0.0);
+    for (std::size_t nc = 0; nc < N * C; ++nc)
+    for (std::size_t oh = 0; oh < OH; ++oh)
+    for (std::size_t ow = 0; ow < OW; ++ow) {
+        const std::size_t yi = (nc * OH + oh) * OW + ow;
+        double best = -std::numeric_limits<double>::infinity(), sum = 0.0;
+        std::size_t arg = 0, count = 0;
+        std::vector<std::size_t> cells;
+        for (std::size_t r = 0; r < k[0]; ++r)
+        for (std::size_t s = 0; s < k[1]; ++s) {
+            const long ih = long(oh * st[0] + r) - long(pad[0]);
+            const long iw = long(ow * st[1] + s) - long(pad[1]);
+            if (ih < 0 || iw < 0 || ih >= long(H) || iw >= long(W)) continue;
+            const std::size_t xi = (nc * H + std::size_t(ih)) * W + std::size_t(iw);
+            if (vx[xi] > best) { best = vx[xi]; arg = xi; }
+            sum += vx[xi];
+            cells.push_back(xi);
+        }
+        count = count_include_pad ? k[0] * k[1] : cells.size();
+        if (is_max) {
+            y[yi] = best;
+            dx[arg] += vg[yi];
+        } else {
+            y[yi] = sum / double(count);
+            for (std::size_t xi : cells) dx[xi] += vg[yi] / double(count);
+        }
+    }
+    return {Tensor({N, C, OH, OW}, y, DType::Float64), Tensor(x.shape(), dx, DType::Float64)};
+}
+}
+
+TEST(Conv, AlgorithmSelection) {
+    kernels::Conv2dShape p = shape_of({1, 64, 56, 56, 64, 3, 3, {1, 1}, {1, 1}, {1, 1}, 1});
+    EXPECT_EQ(kernels::select_conv_algorithm(p), ConvAlgorithm::Winograd);
+    EXPECT_TRUE(kernels::conv_algorithm_supported(ConvAlgorithm::Winograd, p));
+    EXPECT_FALSE(kernels::conv_algorithm_supported(ConvAlgorithm::Depthwise, p));
+
+    p.C = p.K = 3;   // trop peu de canaux pour amortir les transformées
+    EXPECT_EQ(kernels::select_conv_algorithm(p), ConvAlgorithm::Im2col);
+    EXPECT_TRUE(kernels::conv_algorithm_supported(ConvAlgorithm::Winograd, p));
+
+    // 7x7 x 512 : 16 tuiles par image, GEMM trop étroits sauf en gros lot
+    p = shape_of({1, 512, 7, 7, 512, 3, 3, {1, 1}, {1, 1}, {1, 1}, 1});
+    EXPECT_EQ(kernels::select_conv_algorithm(p), ConvAlgorithm::Im2col);
+    p.N = 32;
+    EXPECT_EQ(kernels::select_conv_algorithm(p), ConvAlgorithm::Winograd);
+
+    p = shape_of({1, 32, 28, 28, 32, 3, 3, {2, 2}, {1, 1}, {1, 1}, 32});
+    EXPECT_EQ(kernels::select_conv_algorithm(p), ConvAlgorithm::Depthwise);
+    EXPECT_FALSE(kernels::conv_algorithm_supported(ConvAlgorithm::Winograd, p));
+
+    p = shape_of({1, 32, 28, 28, 32, 3, 3, {1, 1}, {1, 1}, {2, 2}, 1});
+    EXPECT_FALSE(kernels::conv_algorithm_supported(ConvAlgorithm::Winograd, p));
+    EXPECT_EQ(kernels::select_conv_algorithm(p), ConvAlgorithm::Im2col);
+    EXPECT_TRUE(kernels::conv_algorithm_supported(ConvAlgorithm::Im2col, p));
+}
+
+// Chaque algorithme supporté contre la convolution directe, avec et sans
+// biais, en float32 et float64
+TEST(Conv, ForwardMatchesReference) {
+    unsigned seed = 1;
+    for (const ConvCase& c : cases()) {
+        const kernels::Conv2dShape p = shape_of(c);
+        for (DType dt : {DType::Float32, DType::Float64}) {
+            Tensor x = random({c.N, c.C, c.H, c.W}, seed++, dt);
+            Tensor w = random({c.K, c.C / c.groups, c.R, c.S}, seed++, dt);
+            Tensor b = random({c.K}, seed++, dt);
+            const Reference ref = reference(c, x, w, Tensor());
+            const double tol = dt == DType::Float64 ? 1e-10 : 1e-4;
+            for (ConvAlgorithm algo : {ConvAlgorithm::Auto, ConvAlgorithm::Im2col,
+                                       ConvAlgorithm::Depthwise, ConvAlgorithm::Winograd}) {
+                if (!kernels::conv_algorithm_supported(algo, p)) {
+                    EXPECT_THROW(run_conv(c, x, w, b, algo), std::runtime_error);
+                    continue;
+                }
+                SCOPED_TRACE(int(algo));
+                Tensor y = run_conv(c, x, w, b, algo);
+                EXPECT_EQ(y.dtype(), dt);
+                EXPECT_TRUE(y.is_contiguous());
+                expect_close(y, add_bias(ref.y, b), tol);
+                expect_close(run_conv(c, x, w, Tensor(), algo), ref.y, tol);
+            }
+        }
+    }
+}
+
+TEST(Conv, BackwardMatchesReference) {
+    unsigned seed = 100;
+    for (const ConvCase& c : cases()) {
+        for (DType dt : {DType::Float32, DType::Float64}) {
+            Tensor x = random({c.N, c.C, c.H, c.W}, seed++, dt);
+            Tensor w = random({c.K, c.C / c.groups, c.R, c.S}, seed++, dt);
+            Tensor b = random({c.K}, seed++, dt);
+            x.requires_grad_(true);
+            w.requires_grad_(true);
+            b.requires_grad_(true);
+            Tensor y = run_conv(c, x, w, b);
+            ASSERT_NE(y.grad_fn(), nullptr);
+            EXPECT_STREQ(y.grad_fn()->name(), "Conv2dBackward");
+            Tensor gy = random(y.shape(), seed++, dt);
+            y.backward(gy);
+            const Reference ref = reference(c, x.detach(), w.detach(), gy);
+            const double tol = dt == DType::Float64 ? 1e-10 : 1e-4;
+            EXPECT_EQ(x.grad().dtype(), dt);
+            expect_close(x.grad(), ref.dx, tol);
+            expect_close(w.grad(), ref.dw, tol);
+            expect_close(b.grad(), ref.db, tol);
+        }
+    }
+}
+
+TEST(Conv, BackwardOnlyWhereNeeded) {
+    Conv2d conv(3, 4, {3, 3}, {1, 1}, {1, 1});
+    Tensor x = random({2, 3, 5, 5}, 1);
+    conv(x).sum().backward();
+    EXPECT_TRUE(conv.weight().has_grad());
+    EXPECT_TRUE(conv.bias().has_grad());
+    EXPECT_FALSE(x.has_grad());
+
+    // Poids figés : seul le gradient de l'entrée est calculé
+    Tensor xg = random({2, 3, 5, 5}, 2);
+    xg.requires_grad_(true);
+    const ConvCase c{2, 3, 5, 5, 4, 3, 3, {1, 1}, {1, 1}, {1, 1}, 1};
+    Tensor w = conv.weight().detach();
+    Tensor gy = random({2, 4, 5, 5}, 3);
+    architecture::conv2d(xg, w, Tensor(), {1, 1}, {1, 1}).backward(gy);
+    expect_close(xg.grad(), reference(c, xg.detach(), w, gy).dx, 1e-4);
+
+    // Float16 : calcul en float32, gradients rendus dans le type de l'entrée
+    Tensor xh = random({1, 3, 4, 4}, 4, DType::Float16);
+    xh.requires_grad_(true);
+    Tensor yh = architecture::conv2d(xh, w, Tensor(), {1, 1}, {1, 1});
+    EXPECT_EQ(yh.dtype(), DType::Float32);
+    yh.sum().backward();
+    EXPECT_EQ(xh.grad().dtype(), DType::Float16);
+}
+
+// Format mémoire : une entrée channels-last donne une sortie et un
+// gradient channels-last, aux mêmes valeurs
+TEST(Conv, ChannelsLastPropagates) {
+    Tensor x = random({2, 5, 6, 7}, 1);
+    EXPECT_FALSE(architecture::is_channels_last(x));
+    Tensor xl = architecture::to_channels_last(x);
+    EXPECT_TRUE(architecture::is_channels_last(xl));
+    EXPECT_FALSE(xl.is_contiguous());
+    EXPECT_EQ(xl.shape(), x.shape());
+    expect_close(xl, x, 0.0);
+    EXPECT_EQ(architecture::to_channels_last(xl).data_ptr(), xl.data_ptr());
+    EXPECT_THROW(architecture::to_channels_last(random({2, 3}, 2)), std::runtime_error);
+
+    Tensor w = random({8, 5, 3, 3}, 3), b = random({8}, 4);
+    xl.requires_grad_(true);
+    x.requires_grad_(true);
+    Tensor yl = architecture::conv2d(xl, w, b, {1, 1}, {1, 1});
+    Tensor y  = architecture::conv2d(x, w, b, {1, 1}, {1, 1});
+    EXPECT_TRUE(architecture::is_channels_last(yl));
+    EXPECT_FALSE(yl.is_contiguous());
+    EXPECT_TRUE(y.is_contiguous());
+    expect_close(yl, y, 1e-5);
+
+    Tensor gy = random(y.shape(), 5);
+    EXPECT_TRUE(architecture::is_channels_last(
+        yl.grad_fn()->apply(gy.permute({0, 2, 3, 1}).contiguous().permute({0, 3, 1, 2}))[0]));
+    yl.backward(gy);
+    y.backward(gy);
+    expect_close(xl.grad(), x.grad(), 1e-5);
+
+    // Le pooling suit la même règle ; la chaîne reste channels-last
+    Tensor pl = architecture::max_pool2d(yl, {2, 2});
+    EXPECT_TRUE(architecture::is_channels_last(pl));
+    EXPECT_FALSE(pl.is_contiguous());
+    expect_close(pl, architecture::max_pool2d(y, {2, 2}), 0.0);
+
+    // Gradient traversant to_channels_last
+    Tensor xs = random({1, 3, 4, 4}, 6);
+    xs.requires_grad_(true);
+    architecture::to_channels_last(xs).sum().backward();
+    expect_close(xs.grad(), Tensor::ones({1, 3, 4, 4}), 0.0);
+}
+
+TEST(Conv, InvalidArguments) {
+    Tensor x = random({1, 4, 6, 6}, 1);
+    EXPECT_THROW(architecture::conv2d(random({4, 6, 6}, 2), random({2, 4, 3, 3}, 3)), std::runtime_error);
+    EXPECT_THROW(architecture::conv2d(x, random({2, 3, 3, 3}, 3)), std::runtime_error);
+    EXPECT_THROW(architecture::conv2d(x, random({3, 2, 3, 3}, 3), Tensor(), {1, 1}, {0, 0},
+                                      {1, 1}, 2), std::runtime_error);   // K % groups
+    EXPECT_THROW(architecture::conv2d(x, random({2, 4, 7, 7}, 3)), std::runtime_error);
+    EXPECT_THROW(architecture::conv2d(x, random({2, 4, 3, 3}, 3), random({3}, 4)), std::runtime_error);
+    EXPECT_THROW(architecture::conv2d(x, random({2, 4, 3, 3}, 3), Tensor(), {0, 1}), std::runtime_error);
+    EXPECT_THROW(architecture::conv2d(Tensor({1, 4, 6, 6}, DType::Int32),
+                                      Tensor({2, 4, 3, 3}, DType::Int32)), std::runtime_error);
+    EXPECT_THROW(architecture::max_pool2d(x, {2, 2}, {0, 0}, {2, 2}), std::runtime_error);
+    EXPECT_THROW(architecture::avg_pool2d(x, {0, 2}), std::runtime_error);
+    EXPECT_THROW(Conv2d(3, 4, {3, 3}, {1, 1}, {0, 0}, {1, 1}, 2), std::runtime_error);
+}
+
+TEST(Conv, PoolingMatchesReference) {
+    struct PoolCase { std::vector<std::size_t> shape; Size2 k, st, pad; };
+    const std::vector<PoolCase> pcs = {
+        {{2, 3, 8, 8}, {2, 2}, {0, 0}, {0, 0}},
+        {{1, 5, 9, 7}, {3, 3}, {2, 2}, {1, 1}},
+        {{2, 4, 7, 10}, {3, 2}, {1, 2}, {1, 0}},
+    };
+    unsigned seed = 1;
+    for (const PoolCase& pc : pcs) {
+        for (DType dt : {DType::Float32, DType::Float64}) {
+            for (bool is_max : {true, false}) {
+                for (bool include_pad : {true, false}) {
+                    Tensor x = random(pc.shape, seed++, dt);
+                    x.requires_grad_(true);
+                    Tensor y = is_max ? architecture::max_pool2d(x, pc.k, pc.st, pc.pad)
+                                      : architecture::avg_pool2d(x, pc.k, pc.st, pc.pad, include_pad);
+                    EXPECT_EQ(y.dtype(), dt);
+                    EXPECT_STREQ(y.grad_fn()->name(), is_max ? "MaxPool2dBackward" : "AvgPool2dBackward");
+                    Tensor gy = random(y.shape(), seed++, dt);
+                    y.backward(gy);
+                    const Size2 st = {pc.st[0] ? pc.st[0] : pc.k[0], pc.st[1] ? pc.st[1] : pc.k[1]};
+                    auto ref = pool_reference(x.detach(), pc.k, st, pc.pad, is_max, include_pad, gy);
+                    const double tol = dt == DType::Float64 ? 1e-12 : 1e-5;
+                    expect_close(y, ref.first, tol);
+                    expect_close(x.grad(), ref.second, tol);
+                }
+            }
+        }
+    }
+    // NaN propagé par le maximum
+    Tensor xn = Tensor({1, 1, 2, 2}, std::vector<float>{1.0f, std::nanf(""), 3.0f, 2.0f});
+    EXPECT_TRUE(std::isnan(values(architecture::max_pool2d(xn, {2, 2}))[0]));
+}
+
+TEST(Conv, ModuleParameters) {
+    Conv2d conv(4, 6, {3, 5}, {1, 1}, {1, 2}, {1, 1}, 2);
+    EXPECT_EQ(conv.weight().shape(), (std::vector<std::size_t>{6, 2, 3, 5}));
+    EXPECT_EQ(conv.bias().shape(), (std::vector<std::size_t>{6}));
+    EXPECT_EQ(conv.parameters().size(), 2u);
+    const double bound = 1.0 / std::sqrt(2.0 * 3.0 * 5.0);
+    for (double v : values(conv.weight())) EXPECT_LE(std::abs(v), bound);
+    EXPECT_EQ(conv(random({2, 4, 7, 9}, 1)).shape(), (std::vector<std::size_t>{2, 6, 7, 9}));
+
+    Conv2d nb(3, 3, {1, 1}, {1, 1}, {0, 0}, {1, 1}, 1, false);
+    EXPECT_FALSE(nb.bias().defined());
+    EXPECT_EQ(nb.parameters().size(), 1u);
+
+    Conv2d wino(16, 16, {3, 3}, {1, 1}, {1, 1});
+    Tensor x = random({1, 16, 6, 6}, 2);
+    Tensor y = wino(x);
+    wino.set_algorithm(ConvAlgorithm::Im2col);
+    expect_close(wino(x), y, 1e-4);
+    wino.set_algorithm(ConvAlgorithm::Depthwise);
+    EXPECT_THROW(wino(x), std::runtime_error);
+
+    architecture::MaxPool2d mp({2, 2});
+    architecture::AvgPool2d ap({3, 3}, {1, 1}, {1, 1}, false);
+    EXPECT_EQ(mp(x).shape(), (std::vector<std::size_t>{1, 16, 3, 3}));
+    EXPECT_EQ(ap(x).shape(), x.shape());
+    EXPECT_TRUE(mp.parameters().empty());
+}
+
+// Rejeu d'un petit réseau convolutif, en NCHW puis en channels-last
+TEST(Conv, GraphReplay) {
+    Conv2d c1(3, 16, {3, 3}, {1, 1}, {1, 1});
+    Conv2d c2(16, 16, {3, 3}, {1, 1}, {1, 1}, {1, 1}, 16);
+    for (bool channels_last : {false, true}) {
+        auto fn = [&](const std::vector<Tensor>& in) {
+            Tensor h = channels_last ? architecture::to_channels_last(in[0]) : in[0];
+            h = architecture::max_pool2d(c2(c1(h)), {3, 3}, {1, 1}, {1, 1});
+            return std::vector<Tensor>{architecture::avg_pool2d(h, {2, 2})};
+        };
+        Graph g = Graph::capture(fn, {random({2, 3, 8, 8}, 1)});
+        for (unsigned seed = 2; seed < 4; ++seed) {
+            Tensor x = random({2, 3, 8, 8}, seed);
+            const Tensor& y = g.replay({x})[0];
+            EXPECT_EQ(architecture::is_channels_last(y), channels_last);
+            expect_close(y, fn({x})[0], 1e-5);
+        }
+    }
+}
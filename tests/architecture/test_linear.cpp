@@ -0,0 +1,168 @@
+#include <gtest/gtest.h>
+#include "napcas/architecture/linear.h"
+#include "napcas/grad_fn.h"
+#include "napcas/tensor.h"
+#include <cmath>
+#include <random>
+
+using namespace napcas;
+using architecture::Linear;
+using kernels::Activation;
+
+namespace {
+Tensor random(const std::vector<std::size_t>& shape, unsigned seed, DType dtype = DType::Float32) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> u(-1.0, 1.0);
+    std::size_t n = 1;
+    for (auto s : shape) n *= s;
+    std::vector<double> v(n);
+    for (auto& e : v) e = u(rng);
+    return Tensor(shape, v, dtype);
+}
+
+double at(const Tensor& t, std::size_t i) {
+    return t.astype(DType::Float64).contiguous().data<double>()[i];
+}
+
+void expect_close(const Tensor& a, const Tensor& b, double tol) {
+    ASSERT_EQ(a.shape(), b.shape());
+    Tensor ca = a.astype(DType::Float64).contiguous();
+    Tensor cb = b.astype(DType::Float64).contiguous();
+    for (std::size_t i = 0; i < a.numel(); ++i)
+        EXPECT_NEAR(ca.data<double>()[i], cb.data<double>()[i], tol) << i;
+}
+
+// Référence non fusionnée : matmul, addition diffusée, activation
+Tensor reference(const Tensor& x, const Tensor& w, const Tensor& b, Activation act) {
+    Tensor y = x.matmul(w.transpose(0, 1));
+    if (b.defined()) y = y + b;
+    switch (act) {
+        case Activation::ReLU: return y.relu();
+        case Activation::GELU: return y.gelu();
+        case Activation::SiLU: return y.silu();
+        case Activation::None: break;
+    }
+    return y;
+}
+}
+
+TEST(Linear, ModuleParameters) {
+    Linear fc(5, 3);
+    EXPECT_EQ(fc.in_features(), 5);
+    EXPECT_EQ(fc.out_features(), 3);
+    EXPECT_EQ(fc.weight().shape(), (std::vector<std::size_t>{3, 5}));
+    EXPECT_EQ(fc.bias().shape(), (std::vector<std::size_t>{3}));
+    EXPECT_TRUE(fc.weight().requires_grad());
+    EXPECT_EQ(fc.parameters().size(), 2u);
+    const double bound = 1.0 / std::sqrt(5.0);
+    for (std::size_t i = 0; i < 15; ++i)
+        EXPECT_LE(std::abs(at(fc.weight(), i)), bound);
+
+    Linear nb(4, 2, false);
+    EXPECT_FALSE(nb.bias().defined());
+    EXPECT_EQ(nb.parameters().size(), 1u);
+    EXPECT_THROW(nb.register_parameter("weight", Tensor::ones({1})), std::runtime_error);
+}
+
+TEST(Linear, StateDictRoundTrip) {
+    Linear a(4, 3), b(4, 3);
+    auto sd = a.state_dict();
+    ASSERT_EQ(sd.size(), 2u);
+    ASSERT_TRUE(sd.count("weight") && sd.count("bias"));
+    EXPECT_EQ(sd.at("weight").data_ptr(), a.weight().data_ptr());   // sans copie
+    b.load_state_dict(sd);
+    expect_close(b.weight(), a.weight(), 0.0);
+    expect_close(b.bias(), a.bias(), 0.0);
+    EXPECT_NE(b.weight().data_ptr(), a.weight().data_ptr());
+
+    sd.erase("bias");
+    EXPECT_THROW(b.load_state_dict(sd), std::runtime_error);
+    sd["bias"] = Tensor::ones({4});
+    EXPECT_THROW(b.load_state_dict(sd), std::runtime_error);
+}
+
+TEST(Linear, NestedStateDict) {
+    struct Mlp : Module {
+        std::shared_ptr<Linear> fc1 = std::make_shared<Linear>(4, 8, true, DType::Float32,
+                                                               Device{DeviceType::CPU, 0},
+                                                               Activation::ReLU);
+        std::shared_ptr<Linear> fc2 = std::make_shared<Linear>(8, 2);
+        Mlp() { register_module("fc1", fc1); register_module("fc2", fc2); }
+        Tensor forward(const Tensor& x) override { return (*fc2)((*fc1)(x)); }
+    };
+    Mlp m;
+    EXPECT_EQ(m.modules().size(), 2u);
+    EXPECT_EQ(m.parameters().size(), 4u);
+    auto sd = m.state_dict();
+    EXPECT_TRUE(sd.count("fc1.weight") && sd.count("fc2.bias"));
+    EXPECT_EQ(m(Tensor::ones({3, 4})).shape(), (std::vector<std::size_t>{3, 2}));
+}
+
+// Épilogue fusionné (petits et grands GEMM, tuiles de bord) contre la
+// référence non fusionnée
+TEST(Linear, FusedEpilogueMatchesReference) {
+    const std::vector<std::vector<std::size_t>> sizes = {{3, 5, 7}, {67, 131, 300}, {1, 0, 4}};
+    for (const auto& s : sizes) {
+        Tensor x = random({s[0], s[1]}, 1);
+        Tensor w = random({s[2], s[1]}, 2);
+        Tensor b = random({s[2]}, 3);
+        for (Activation act : {Activation::None, Activation::ReLU, Activation::GELU, Activation::SiLU}) {
+            expect_close(architecture::linear(x, w, b, act), reference(x, w, b, act), 1e-4);
+            expect_close(architecture::linear(x, w, Tensor(), act),
+                         reference(x, w, Tensor(), act), 1e-4);
+        }
+    }
+    // Lots, float64 et poids transposé (lu via ses strides)
+    Tensor x3 = random({2, 3, 6}, 4, DType::Float64);
+    Tensor w = random({6, 5}, 5, DType::Float64).transpose(0, 1);
+    Tensor b = random({5}, 6, DType::Float64);
+    Tensor y = architecture::linear(x3, w, b, Activation::GELU);
+    EXPECT_EQ(y.dtype(), DType::Float64);
+    EXPECT_EQ(y.shape(), (std::vector<std::size_t>{2, 3, 5}));
+    expect_close(y, reference(x3, w, b, Activation::GELU), 1e-12);
+    EXPECT_THROW(architecture::linear(random({2, 4}, 7), w, b), std::runtime_error);
+}
+
+// Gradients fusionnés (dX, dW, db) contre ceux du graphe non fusionné
+TEST(Linear, FusedBackwardMatchesReference) {
+    for (Activation act : {Activation::None, Activation::ReLU, Activation::GELU, Activation::SiLU}) {
+        for (DType dt : {DType::Float32, DType::Float64}) {
+            Tensor x = random({2, 37, 19}, 8, dt), w = random({23, 19}, 9, dt), b = random({23}, 10, dt);
+            Tensor gy = random({2, 37, 23}, 11, dt);
+            x.requires_grad_(true);
+            w.requires_grad_(true);
+            b.requires_grad_(true);
+
+            architecture::linear(x, w, b, act).backward(gy);
+            Tensor dx = x.grad().clone(), dw = w.grad().clone(), db = b.grad().clone();
+            x.zero_grad();
+            w.zero_grad();
+            b.zero_grad();
+            reference(x, w, b, act).backward(gy);
+            const double tol = dt == DType::Float64 ? 1e-10 : 1e-4;
+            expect_close(dx, x.grad(), tol);
+            expect_close(dw, w.grad(), tol);
+            expect_close(db, b.grad(), tol);
+        }
+    }
+}
+
+TEST(Linear, BackwardOnlyWhereNeeded) {
+    Linear fc(6, 4, true, DType::Float32, Device{DeviceType::CPU, 0}, Activation::SiLU);
+    Tensor x = random({5, 6}, 12);
+    Tensor y = fc(x);
+    ASSERT_NE(y.grad_fn(), nullptr);
+    EXPECT_STREQ(y.grad_fn()->name(), "LinearBackward");
+    y.sum().backward();
+    EXPECT_TRUE(fc.weight().has_grad());
+    EXPECT_TRUE(fc.bias().has_grad());
+    EXPECT_FALSE(x.has_grad());
+
+    // Float16 : calcul en float32, gradients rendus dans le type des entrées
+    Tensor xh = random({3, 6}, 13, DType::Float16);
+    xh.requires_grad_(true);
+    Tensor yh = architecture::linear(xh, fc.weight().detach());
+    EXPECT_EQ(yh.dtype(), DType::Float32);
+    yh.sum().backward();
+    EXPECT_EQ(xh.grad().dtype(), DType::Float16);
+}
@@ -0,0 +1,174 @@
+#include <gtest/gtest.h>
+#include "napcas/architecture/quantized_linear.h"
+#include "napcas/cpu.h"
+#include "napcas/graph.h"
+#include "napcas/kernels/qgemm.h"
+#include "napcas/tensor.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+
+using namespace napcas;
+using architecture::Linear;
+using architecture::QuantizedLinear;
+using kernels::Activation;
+
+namespace {
+struct RestoreCapability {
+    CpuCapability saved = cpu_capability();
+    ~RestoreCapability() { set_cpu_capability(saved); }
+};
+
+Tensor random(const std::vector<std::size_t>& shape, unsigned seed, double lo = -1.0, double hi = 1.0) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> u(lo, hi);
+    std::size_t n = 1;
+    for (auto s : shape) n *= s;
+    std::vector<double> v(n);
+    for (auto& e : v) e = u(rng);
+    return Tensor(shape, v, DType::Float32);
+}
+
+std::vector<float> values(const Tensor& t) {
+    Tensor c = t.contiguous();
+    return std::vector<float>(c.data<float>(), c.data<float>() + c.numel());
+}
+
+// ‖a - b‖ / ‖b‖
+double relative_error(const Tensor& a, const Tensor& b) {
+    const auto va = values(a), vb = values(b);
+    double num = 0.0, den = 0.0;
+    for (std::size_t i = 0; i < va.size(); ++i) {
+        num += (double(va[i]) - vb[i]) * (double(va[i]) - vb[i]);
+        den += double(vb[i]) * vb[i];
+    }
+    return std::sqrt(num / den);
+}
+
+// Référence entière : mêmes paramètres de quantification que le noyau,
+// produit exact en int64
+std::vector<float> reference(const std::vector<float>& a, std::size_t M,
+                             const kernels::QuantizedWeight& w,
+                             const kernels::ActivationQuant& q, const float* bias) {
+    std::vector<float> dq(w.N * w.K);
+    kernels::dequantize_weight(w, dq.data());
+    std::vector<float> out(M * w.N);
+    for (std::size_t i = 0; i < M; ++i)
+        for (std::size_t n = 0; n < w.N; ++n) {
+            std::int64_t acc = 0;
+            for (std::size_t k = 0; k < w.K; ++k) {
+                const auto qa = std::int64_t(std::clamp(a[i * w.K + k] * (1.0f / q.scale) + float(q.zero_point),
+                                                        0.0f, float(q.qmax)) + 0.5f);
+                const auto qw = std::int64_t(w.scales[n] > 0.0f ? std::nearbyint(dq[n * w.K + k] / w.scales[n]) : 0.0f);
+                acc += (qa - q.zero_point) * qw;
+            }
+            out[i * w.N + n] = q.scale * w.scales[n] * float(acc) + (bias ? bias[n] : 0.0f);
+        }
+    return out;
+}
+}
+
+TEST(QuantizedLinear, WeightQuantizationIsPerChannelSymmetric) {
+    const Tensor w = random({37, 70}, 1);
+    const auto q = kernels::quantize_weight(37, 70, kernels::MatrixRef{w.data<float>(), 70, 1});
+    EXPECT_EQ(q.Kp, 72u);
+    EXPECT_EQ(q.packed.size(), 48u * 72u);
+    std::vector<float> dq(37 * 70);
+    kernels::dequantize_weight(q, dq.data());
+    const auto vw = values(w);
+    for (std::size_t n = 0; n < 37; ++n) {
+        float amax = 0.0f;
+        for (std::size_t k = 0; k < 70; ++k) amax = std::max(amax, std::fabs(vw[n * 70 + k]));
+        EXPECT_FLOAT_EQ(q.scales[n], amax / 127.0f);
+        for (std::size_t k = 0; k < 70; ++k)
+            EXPECT_LE(std::fabs(dq[n * 70 + k] - vw[n * 70 + k]), 0.5f * q.scales[n] * 1.001f);
+    }
+}
+
+// Chaque micro-noyau (portable, AVX2 maddubs, AVX-512 VNNI) donne les mêmes
+// entiers que la référence, y compris sur des tuiles de bord
+TEST(QuantizedLinear, MatchesIntegerReferenceOnEachIsa) {
+    RestoreCapability restore;
+    const std::size_t M = 13, N = 37, K = 70;
+    const Tensor a = random({M, K}, 2, -0.5, 2.0), w = random({N, K}, 3), b = random({N}, 4);
+    const auto q = kernels::quantize_weight(N, K, kernels::MatrixRef{w.data<float>(), K, 1});
+    for (CpuCapability cap : {CpuCapability::Scalar, CpuCapability::AVX2, CpuCapability::AVX512}) {
+        set_cpu_capability(cap);
+        std::vector<float> c(M * N);
+        kernels::GemmEpilogue<float> ep;
+        ep.bias = b.data<float>();
+        kernels::ActivationQuant aq;
+        kernels::qgemm(M, kernels::MatrixRef{a.data<float>(), K, 1}, q, c.data(), N, ep, &aq);
+        EXPECT_EQ(aq.qmax, kernels::qgemm_activation_max()) << kernels::qgemm_kernel_name();
+        EXPECT_GT(aq.zero_point, 0);
+        const auto ref = reference(values(a), M, q, aq, b.data<float>());
+        for (std::size_t i = 0; i < c.size(); ++i)
+            EXPECT_NEAR(c[i], ref[i], 1e-4f * (1.0f + std::fabs(ref[i]))) << kernels::qgemm_kernel_name();
+    }
+}
+
+TEST(QuantizedLinear, CloseToFloatLinear) {
+    RestoreCapability restore;
+    Linear fc(256, 128);
+    QuantizedLinear qfc(fc);
+    EXPECT_EQ(qfc.in_features(), 256);
+    EXPECT_EQ(qfc.out_features(), 128);
+    EXPECT_LT(relative_error(qfc.dequantized_weight(), fc.weight()), 0.01);
+
+    const Tensor x = random({32, 256}, 5);
+    const Tensor expected = fc(x).detach();
+    for (CpuCapability cap : {CpuCapability::Scalar, CpuCapability::AVX2, CpuCapability::AVX512}) {
+        set_cpu_capability(cap);
+        const Tensor y = qfc(x);
+        EXPECT_EQ(y.shape(), expected.shape());
+        EXPECT_FALSE(y.requires_grad());
+        // 7 bits d'activation sur AVX2 : erreur environ double
+        EXPECT_LT(relative_error(y, expected), 0.03) << kernels::qgemm_kernel_name();
+    }
+}
+
+TEST(QuantizedLinear, EdgeSizesAndFusedActivation) {
+    for (std::size_t M : {1, 7, 97, 200})
+    for (std::size_t N : {1, 17, 64})
+    for (std::size_t K : {1, 3, 5, 33}) {
+        Linear fc(int(K), int(N), true, DType::Float32, Device{DeviceType::CPU, 0}, Activation::ReLU);
+        QuantizedLinear qfc(fc);
+        const Tensor x = random({M, K}, unsigned(M * 131 + N * 7 + K));
+        const Tensor y = qfc(x), expected = fc(x).detach();
+        const auto vy = values(y), ve = values(expected);
+        ASSERT_EQ(vy.size(), M * N);
+        for (std::size_t i = 0; i < vy.size(); ++i) {
+            EXPECT_GE(vy[i], 0.0f);
+            EXPECT_NEAR(vy[i], ve[i], 0.05f) << M << "x" << N << "x" << K;
+        }
+    }
+}
+
+TEST(QuantizedLinear, BatchedInputAndErrors) {
+    Linear fc(16, 8, false);
+    QuantizedLinear qfc(fc);
+    EXPECT_FALSE(qfc.bias().defined());
+    const Tensor x = random({2, 3, 16}, 6);
+    EXPECT_EQ(qfc(x).shape(), (std::vector<std::size_t>{2, 3, 8}));
+    EXPECT_LT(relative_error(qfc(x), fc(x).detach()), 0.03);
+    EXPECT_THROW(qfc(random({4, 15}, 7)), std::runtime_error);
+
+    Tensor bad = random({4, 16}, 8);
+    bad.data<float>()[3] = std::numeric_limits<float>::infinity();
+    EXPECT_THROW(qfc(bad), std::runtime_error);
+}
+
+// Rejeu : l'échelle des activations est recalculée sur chaque lot
+TEST(QuantizedLinear, GraphReplay) {
+    Linear fc(64, 32);
+    QuantizedLinear qfc(fc);
+    Graph g = Graph::capture(qfc, random({8, 64}, 9));
+    EXPECT_EQ(g.ops(), (std::vector<std::string>{"quantized_linear"}));
+    for (unsigned seed = 10; seed < 12; ++seed) {
+        const Tensor x = random({8, 64}, seed, -double(seed), double(seed));
+        const auto expected = values(qfc(x));
+        const auto got = values(g.replay({x})[0]);
+        for (std::size_t i = 0; i < got.size(); ++i) EXPECT_FLOAT_EQ(got[i], expected[i]);
+    }
+}
@@ -0,0 +1,138 @@
+#include <gtest/gtest.h>
+#include "napcas/tensor.h"
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <random>
+
+using namespace napcas;
+
+namespace {
+Tensor random(const std::vector<std::size_t>& shape, unsigned seed, DType dtype = DType::Float64) {
+    std::mt19937 rng(seed);
+    std::normal_distribution<double> n(0.0, 1.0);
+    std::size_t count = 1;
+    for (auto s : shape) count *= s;
+    std::vector<double> v(count);
+    for (auto& e : v) e = n(rng);
+    return Tensor(shape, v, dtype);
+}
+
+void expect_close(const Tensor& a, const Tensor& b, double tol) {
+    ASSERT_EQ(a.shape(), b.shape());
+    Tensor ca = a.astype(DType::Float64).contiguous();
+    Tensor cb = b.astype(DType::Float64).contiguous();
+    for (std::size_t i = 0; i < a.numel(); ++i)
+        EXPECT_NEAR(ca.data<double>()[i], cb.data<double>()[i], tol) << i;
+}
+
+// Gradient de sum(f(x) * w) par différences centrées, comparé à backward()
+void check_gradient(const std::function<Tensor(const Tensor&)>& f, Tensor x, double tol = 1e-6) {
+    Tensor w = random(f(x).shape(), 99);
+    x.requires_grad_(true);
+    (f(x) * w).sum().backward();
+    Tensor analytic = x.grad().clone();
+    x.requires_grad_(false);
+
+    const double h = 1e-6;
+    double* p = x.data<double>();
+    for (std::size_t i = 0; i < x.numel(); ++i) {
+        const double saved = p[i];
+        p[i] = saved + h;
+        const double up = (f(x) * w).sum().data<double>()[0];
+        p[i] = saved - h;
+        const double down = (f(x) * w).sum().data<double>()[0];
+        p[i] = saved;
+        EXPECT_NEAR(analytic.data<double>()[i], (up - down) / (2 * h), tol) << i;
+    }
+}
+}
+
+TEST(Activation, ForwardValues) {
+    Tensor x({5}, std::vector<float>{-2.0f, -0.5f, 0.0f, 0.5f, 3.0f});
+    Tensor relu = x.relu();
+    EXPECT_EQ(relu.data<float>()[0], 0.0f);
+    EXPECT_EQ(relu.data<float>()[4], 3.0f);
+    for (std::size_t i = 0; i < 5; ++i) {
+        const double v = x.data<float>()[i];
+        EXPECT_NEAR(x.gelu().data<float>()[i], 0.5 * v * (1 + std::erf(v / std::sqrt(2.0))), 1e-6);
+        EXPECT_NEAR(x.silu().data<float>()[i], v / (1 + std::exp(-v)), 1e-6);
+    }
+    EXPECT_THROW(Tensor::ones({2}, DType::Int32).relu(), std::runtime_error);
+}
+
+TEST(Activation, Gradients) {
+    check_gradient([](const Tensor& t) { return t.relu(); }, random({3, 4}, 1));
+    check_gradient([](const Tensor& t) { return t.gelu(); }, random({3, 4}, 2));
+    check_gradient([](const Tensor& t) { return t.silu(); }, random({3, 4}, 3));
+}
+
+TEST(Softmax, RowsSumToOneAndAreStable) {
+    Tensor x({2, 3}, std::vector<float>{1000, 1001, 1002, -1, 0, 1});
+    Tensor y = x.softmax();
+    const double z = 1 + std::exp(1.0) + std::exp(2.0);
+    expect_close(y, Tensor({2, 3}, std::vector<double>{1 / z, std::exp(1.0) / z, std::exp(2.0) / z,
+                                                       1 / z, std::exp(1.0) / z, std::exp(2.0) / z}), 1e-6);
+    expect_close(x.log_softmax(), Tensor({2, 3}, std::vector<double>{
+        -std::log(z), 1 - std::log(z), 2 - std::log(z), -std::log(z), 1 - std::log(z), 2 - std::log(z)}), 1e-4);
+
+    // Lignes longues : maximum courant sur plusieurs blocs
+    Tensor big = random({3, 1000}, 4, DType::Float32);
+    expect_close(big.softmax().sum({1}), Tensor::ones({3}), 1e-5);
+    expect_close(big.log_softmax().exp(), big.softmax(), 1e-6);
+
+    const float inf = std::numeric_limits<float>::infinity();
+    Tensor masked({3}, std::vector<float>{-inf, 0.0f, -inf});
+    expect_close(masked.softmax(), Tensor({3}, std::vector<float>{0, 1, 0}), 0);
+}
+
+TEST(Softmax, AlongInnerDimMatchesTranspose) {
+    Tensor x = random({4, 5, 6}, 5);
+    expect_close(x.softmax(1), x.transpose(1, 2).softmax().transpose(1, 2), 1e-12);
+    expect_close(x.softmax(0).sum({0}), Tensor::ones({5, 6}, DType::Float64), 1e-12);
+    EXPECT_THROW(x.softmax(3), std::runtime_error);
+}
+
+TEST(Softmax, Gradients) {
+    check_gradient([](const Tensor& t) { return t.softmax(); }, random({3, 5}, 6));
+    check_gradient([](const Tensor& t) { return t.log_softmax(); }, random({3, 5}, 7));
+    check_gradient([](const Tensor& t) { return t.softmax(0); }, random({4, 3}, 8));
+}
+
+TEST(Normalization, LayerNormForward) {
+    Tensor x({2, 4}, std::vector<float>{1, 2, 3, 4, 2, 2, 2, 2});
+    Tensor y = x.layer_norm();
+    const double s = 1 / std::sqrt(1.25 + 1e-5);
+    expect_close(y, Tensor({2, 4}, std::vector<double>{-1.5 * s, -0.5 * s, 0.5 * s, 1.5 * s,
+                                                       0, 0, 0, 0}), 1e-5);
+    Tensor w({4}, std::vector<float>{1, 2, 1, 2});
+    Tensor b({4}, std::vector<float>{0, 0, 1, 1});
+    expect_close(x.layer_norm(w, b), y * w + b, 1e-6);
+    EXPECT_THROW(x.layer_norm(Tensor::ones({3})), std::runtime_error);
+}
+
+TEST(Normalization, RMSNormForward) {
+    Tensor x({1, 4}, std::vector<float>{1, -1, 1, -1});
+    expect_close(x.rms_norm(Tensor(), 0.0), x, 1e-6);
+    Tensor w({4}, std::vector<float>{2, 2, 2, 2});
+    expect_close(x.rms_norm(w, 0.0), x * w, 1e-6);
+}
+
+TEST(Normalization, Gradients) {
+    Tensor w = random({6}, 10);
+    Tensor b = random({6}, 11);
+    check_gradient([&](const Tensor& t) { return t.layer_norm(w, b); }, random({3, 6}, 12), 1e-5);
+    check_gradient([](const Tensor& t) { return t.layer_norm(); }, random({2, 6}, 13), 1e-5);
+    check_gradient([&](const Tensor& t) { return t.rms_norm(w); }, random({3, 6}, 14), 1e-5);
+
+    // Gradients des paramètres (sommés sur les lignes)
+    check_gradient([&](const Tensor& t) { return random({40, 6}, 15).layer_norm(t, b); }, w.clone(), 1e-5);
+    check_gradient([&](const Tensor& t) { return random({40, 6}, 15).layer_norm(w, t); }, b.clone(), 1e-5);
+    check_gradient([&](const Tensor& t) { return random({40, 6}, 16).rms_norm(t); }, w.clone(), 1e-5);
+}
+
+TEST(Normalization, HalfPrecision) {
+    Tensor x = random({4, 64}, 17, DType::Float32);
+    expect_close(x.astype(DType::BFloat16).layer_norm(), x.layer_norm(), 5e-2);
+    expect_close(x.astype(DType::Float16).softmax(), x.softmax(), 1e-3);
+}
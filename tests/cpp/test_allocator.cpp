@@ -0,0 +1,70 @@
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <thread>
+#include "napcas/allocator.h"
+#include "napcas/tensor.h"
+
+using namespace napcas;
+
+TEST(Allocator, BlocksAre64ByteAligned) {
+    for (std::size_t bytes : {1u, 3u, 64u, 100u, 4096u, 1u << 20}) {
+        void* p = cpu_malloc(bytes);
+        EXPECT_EQ(reinterpret_cast<std::uintptr_t>(p) % kCpuAlignment, 0u);
+        cpu_free(p);
+    }
+    Tensor t = Tensor::ones({17});
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(t.data<float>()) % kCpuAlignment, 0u);
+}
+
+TEST(Allocator, FreedBlocksAreReused) {
+    void* p = cpu_malloc(1000);
+    cpu_free(p);
+    AllocatorStats before = allocator_stats();
+    void* q = cpu_malloc(900);   // même classe (1024 octets)
+    AllocatorStats after = allocator_stats();
+    EXPECT_EQ(p, q);
+    EXPECT_EQ(after.cache_hits, before.cache_hits + 1);
+    cpu_free(q);
+}
+
+TEST(Allocator, StatsTrackUsageAndPeak) {
+    empty_cache();
+    reset_peak_stats();
+    AllocatorStats base = allocator_stats();
+    void* p = cpu_malloc(3 << 20);   // 4 MiB
+    AllocatorStats s = allocator_stats();
+    EXPECT_EQ(s.bytes_in_use, base.bytes_in_use + (4u << 20));
+    EXPECT_GE(s.peak_bytes_in_use, s.bytes_in_use);
+    cpu_free(p);
+    s = allocator_stats();
+    EXPECT_EQ(s.bytes_in_use, base.bytes_in_use);
+    EXPECT_GE(s.bytes_cached, 4u << 20);
+    empty_cache();
+    EXPECT_EQ(allocator_stats().bytes_cached, 0u);
+}
+
+TEST(Allocator, LargeBlocksCachedBySize) {
+    const std::size_t big = (64u << 20) + 123;
+    void* p = cpu_malloc(big);
+    cpu_free(p);
+    void* q = cpu_malloc(big);
+    EXPECT_EQ(p, q);
+    cpu_free(q);
+    empty_cache();
+}
+
+TEST(Allocator, CrossThreadFreeAndThreadExit) {
+    void* p = cpu_malloc(256);
+    std::thread t([p] {
+        cpu_free(p);
+        void* q = cpu_malloc(256);
+        cpu_free(q);
+    });
+    t.join();
+    // les blocs du thread terminé sont rendus au pool global
+    void* r = cpu_malloc(256);
+    EXPECT_NE(r, nullptr);
+    cpu_free(r);
+    empty_cache();
+    EXPECT_EQ(allocator_stats().bytes_cached, 0u);
+}
@@ -0,0 +1,113 @@
+#include <gtest/gtest.h>
+#include "napcas/autograd.h"
+#include "napcas/grad_fn.h"
+#include "napcas/tensor.h"
+#include <thread>
+
+using namespace napcas;
+
+namespace {
+Tensor filled(const std::vector<std::size_t>& shape, std::vector<float> v) {
+    return Tensor(shape, v);
+}
+
+void expect_values(const Tensor& t, const std::vector<float>& v) {
+    ASSERT_EQ(t.numel(), v.size());
+    Tensor c = t.contiguous();
+    for (std::size_t i = 0; i < v.size(); ++i)
+        EXPECT_NEAR(c.data<float>()[i], v[i], 1e-5f) << i;
+}
+
+// Les intermédiaires sont détruits au retour : le graphe doit rester valide
+Tensor build_diamond(const Tensor& x) {
+    Tensor y = x * x;      // y = x²
+    Tensor a = y + x;      // deux consommateurs de y et de x
+    Tensor b = y * y;
+    return a + b;          // x + x² + x⁴
+}
+}
+
+TEST(Autograd, DiamondGraphAccumulatesBeforePropagating) {
+    Tensor x = filled({3}, {1.0f, 2.0f, -0.5f});
+    x.requires_grad_(true);
+    Tensor out = build_diamond(x);
+    out.backward();
+    // d/dx = 1 + 2x + 4x³
+    expect_values(x.grad(), {7.0f, 37.0f, -0.5f});
+}
+
+TEST(Autograd, BroadcastGradientsAreReduced) {
+    Tensor a = filled({2, 3}, {1, 2, 3, 4, 5, 6});
+    Tensor b = filled({3}, {1, 2, 4});
+    a.requires_grad_(true);
+    b.requires_grad_(true);
+    Tensor out = (a - b) / b;
+    out.backward();
+    expect_values(a.grad(), {1.0f, 0.5f, 0.25f, 1.0f, 0.5f, 0.25f});
+    // d/db (a - b)/b = -a/b²
+    expect_values(b.grad(), {-5.0f, -7.0f / 4.0f, -9.0f / 16.0f});
+}
+
+TEST(Autograd, MatMulAndViews) {
+    Tensor a = filled({2, 3}, {1, 2, 3, 4, 5, 6});
+    Tensor w = filled({3}, {1, -1, 2});
+    a.requires_grad_(true);
+    w.requires_grad_(true);
+    Tensor out = a.transpose(0, 1).unsqueeze(0).squeeze(0).transpose(0, 1).matmul(w);
+    out.backward();
+    expect_values(a.grad(), {1, -1, 2, 1, -1, 2});
+    expect_values(w.grad(), {5, 7, 9});
+}
+
+TEST(Autograd, SavedTensorsReleasedAfterBackward) {
+    Tensor a = filled({4}, {1, 2, 3, 4});
+    Tensor b = filled({4}, {2, 2, 2, 2});
+    a.requires_grad_(true);
+    Tensor out = a * b;
+    const long before = b.storage().use_count();
+    out.backward();
+    EXPECT_EQ(b.storage().use_count(), before - 1);
+    EXPECT_THROW(out.backward(), std::runtime_error);
+}
+
+TEST(Autograd, RetainGraphAccumulates) {
+    Tensor a = filled({2}, {1, 2});
+    a.requires_grad_(true);
+    Tensor out = a * a;
+    out.backward(Tensor::ones({2}), true);
+    out.backward(Tensor::ones({2}), true);
+    expect_values(a.grad(), {4.0f, 8.0f});
+    a.zero_grad();
+    EXPECT_FALSE(a.has_grad());
+    Autograd().backward(out);
+    expect_values(a.grad(), {2.0f, 4.0f});
+}
+
+TEST(Autograd, SharedLeafHasSingleAccumulator) {
+    Tensor a = filled({2}, {3, 4});
+    a.requires_grad_(true);
+    Tensor copy = a;   // copie superficielle : même état autograd
+    Tensor out = a + copy;
+    EXPECT_EQ(out.grad_fn()->next()[0], out.grad_fn()->next()[1]);
+    out.backward();
+    expect_values(copy.grad(), {2.0f, 2.0f});
+    EXPECT_FALSE(out.grad_fn()->next()[0] == nullptr);
+}
+
+TEST(Autograd, ConcurrentBackwardOnSharedLeaf) {
+    Tensor w = filled({4}, {1, 2, 3, 4});
+    w.requires_grad_(true);
+    constexpr int kThreads = 8, kIters = 50;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreads; ++t) {
+        threads.emplace_back([&] {
+            for (int i = 0; i < kIters; ++i) {
+                Tensor x = filled({4}, {1, 1, 1, 1});
+                (w * x + w).backward();
+            }
+        });
+    }
+    for (auto& th : threads) th.join();
+    const float n = float(kThreads * kIters) * 2.0f;
+    expect_values(w.grad(), {n, n, n, n});
+}
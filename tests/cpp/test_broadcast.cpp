@@ -0,0 +1,87 @@
+#include <gtest/gtest.h>
+#include "napcas/tensor.h"
+#include "napcas/broadcast.h"
+
+using namespace napcas;
+
+namespace {
+Tensor arange(const std::vector<std::size_t>& shape, float start = 0.0f) {
+    std::size_t n = 1;
+    for (auto s : shape) n *= s;
+    std::vector<float> data(n);
+    for (std::size_t i = 0; i < n; ++i) data[i] = start + float(i);
+    return Tensor(shape, data);
+}
+}
+
+TEST(Broadcast, Shapes) {
+    using S = std::vector<std::size_t>;
+    EXPECT_EQ(broadcast_shapes({4, 3}, {3}),       (S{4, 3}));
+    EXPECT_EQ(broadcast_shapes({4, 1}, {1, 5}),    (S{4, 5}));
+    EXPECT_EQ(broadcast_shapes({}, {2, 2}),        (S{2, 2}));
+    EXPECT_EQ(broadcast_shapes({2, 1, 3}, {4, 1}), (S{2, 4, 3}));
+    EXPECT_THROW(broadcast_shapes({4, 3}, {4}), std::runtime_error);
+}
+
+TEST(Broadcast, SameShape) {
+    Tensor c = arange({2, 3}) + arange({2, 3}, 10.0f);
+    for (int i = 0; i < 6; ++i)
+        EXPECT_FLOAT_EQ(c.data<float>()[i], 10.0f + 2.0f * i);
+}
+
+TEST(Broadcast, ScalarTensor) {
+    Tensor s({}, std::vector<float>{2.0f});
+    Tensor a = arange({3, 4});
+    Tensor c = a * s;
+    Tensor d = s - a;
+    ASSERT_EQ(c.shape(), a.shape());
+    for (int i = 0; i < 12; ++i) {
+        EXPECT_FLOAT_EQ(c.data<float>()[i], 2.0f * i);
+        EXPECT_FLOAT_EQ(d.data<float>()[i], 2.0f - i);
+    }
+}
+
+TEST(Broadcast, RowAndColumnVectors) {
+    Tensor m   = arange({3, 4});
+    Tensor row = arange({4}, 100.0f);
+    Tensor col = arange({3, 1}, 1.0f);
+    Tensor r = m + row;
+    Tensor c = m / col;
+    for (int i = 0; i < 3; ++i)
+        for (int j = 0; j < 4; ++j) {
+            EXPECT_FLOAT_EQ(r.data<float>()[i * 4 + j], float(i * 4 + j) + 100.0f + j);
+            EXPECT_FLOAT_EQ(c.data<float>()[i * 4 + j], float(i * 4 + j) / float(i + 1));
+        }
+}
+
+TEST(Broadcast, OuterProductShape) {
+    Tensor c = arange({3, 1}) * arange({1, 5});
+    ASSERT_EQ(c.shape(), (std::vector<std::size_t>{3, 5}));
+    EXPECT_FLOAT_EQ(c.data<float>()[2 * 5 + 4], 8.0f);
+}
+
+TEST(Broadcast, StridedOperand) {
+    Tensor t = arange({4, 3}).transpose(0, 1);   // (3, 4), non contigu
+    Tensor c = t + arange({4});
+    EXPECT_FLOAT_EQ(c.data<float>()[1 * 4 + 2], 7.0f + 2.0f);
+}
+
+TEST(Broadcast, ExpandIsZeroCopy) {
+    Tensor row = arange({4});
+    Tensor e = row.expand({3, 4});
+    EXPECT_EQ(e.storage().get(), row.storage().get());
+    EXPECT_EQ(e.strides()[0], 0);
+    EXPECT_FLOAT_EQ(e.contiguous().data<float>()[9], 1.0f);
+}
+
+TEST(Broadcast, SumToSizeReducesBroadcastDims) {
+    Tensor g = Tensor::ones({2, 3, 4});
+    Tensor a = g.sum_to_size({3, 1});
+    ASSERT_EQ(a.shape(), (std::vector<std::size_t>{3, 1}));
+    for (int i = 0; i < 3; ++i) EXPECT_FLOAT_EQ(a.data<float>()[i], 8.0f);
+    Tensor b = arange({2, 3}).sum_to_size({3});
+    EXPECT_FLOAT_EQ(b.data<float>()[0], 3.0f);
+    EXPECT_FLOAT_EQ(b.data<float>()[2], 7.0f);
+    Tensor s = arange({2, 3}).sum_to_size({});
+    EXPECT_FLOAT_EQ(s.data<float>()[0], 15.0f);
+}
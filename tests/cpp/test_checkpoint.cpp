@@ -0,0 +1,217 @@
+#include <gtest/gtest.h>
+#include "napcas/allocator.h"
+#include "napcas/checkpoint.h"
+#include "napcas/architecture/linear.h"
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+using namespace napcas;
+
+namespace {
+std::string temp_path(const char* name) {
+    return ::testing::TempDir() + name;
+}
+
+void expect_equal(const Tensor& a, const Tensor& b) {
+    ASSERT_EQ(a.shape(), b.shape());
+    ASSERT_EQ(a.dtype(), b.dtype());
+    Tensor ca = a.astype(DType::Float64).contiguous();
+    Tensor cb = b.astype(DType::Float64).contiguous();
+    for (std::size_t i = 0; i < a.numel(); ++i)
+        EXPECT_EQ(ca.data<double>()[i], cb.data<double>()[i]) << i;
+}
+
+// Vrai si `p` tombe dans une projection de `path` (/proc/self/maps)
+bool mapped_from(const void* p, const std::string& path) {
+    std::ifstream maps("/proc/self/maps");
+    const auto addr = reinterpret_cast<std::uintptr_t>(p);
+    for (std::string line; std::getline(maps, line);) {
+        if (line.find(path) == std::string::npos) continue;
+        std::istringstream in(line);
+        std::uintptr_t lo = 0, hi = 0;
+        char dash;
+        in >> std::hex >> lo >> dash >> hi;
+        if (addr >= lo && addr < hi) return true;
+    }
+    return false;
+}
+}
+
+TEST(Checkpoint, RoundTripIsZeroCopyAndAligned) {
+    const std::string path = temp_path("napcas_roundtrip.ckpt");
+    std::map<std::string, Tensor> tensors;
+    tensors["a"]      = Tensor({2, 3}, std::vector<float>{1, 2, 3, 4, 5, 6});
+    tensors["b.half"] = Tensor({5}, std::vector<float>{1, -2, 3.5f, 0, 7}, DType::Float16);
+    tensors["c"]      = Tensor({3}, std::vector<int>{7, 8, 9}, DType::Int64);
+    tensors["empty"]  = Tensor::zeros({0, 4});
+    tensors["scalar"] = Tensor({}, std::vector<double>{3.25}, DType::Float64);
+    // Vue transposée : écrite en ordre row-major
+    tensors["t"]      = Tensor({2, 3}, std::vector<float>{1, 2, 3, 4, 5, 6}).transpose(0, 1);
+    checkpoint::save(path, tensors);
+
+    auto loaded = checkpoint::load(path);
+    ASSERT_EQ(loaded.size(), tensors.size());
+    for (const auto& kv : tensors) {
+        SCOPED_TRACE(kv.first);
+        const Tensor& t = loaded.at(kv.first);
+        expect_equal(t, kv.second);
+        EXPECT_TRUE(t.is_contiguous());
+        if (t.numel()) {
+            EXPECT_EQ(reinterpret_cast<std::uintptr_t>(t.data_ptr()) % checkpoint::kAlignment, 0u);
+        }
+    }
+    // Projection privée : écrire dans un tenseur ne change pas le fichier
+    loaded.at("a").data<float>()[0] = 42.0f;
+    EXPECT_EQ(checkpoint::load(path).at("a").data<float>()[0], 1.0f);
+    // Les tenseurs survivent à la map qui les a produits
+    Tensor keep = loaded.at("c");
+    loaded.clear();
+    EXPECT_EQ(keep.data<std::int64_t>()[2], 9);
+    std::remove(path.c_str());
+}
+
+TEST(Checkpoint, LargeStridedTensorIsStreamed) {
+    const std::string path = temp_path("napcas_strided.ckpt");
+    // 8 Mo, non contigu : écrit par tranches
+    const std::size_t n = 1024, m = 2048;
+    std::vector<float> v(n * m);
+    for (std::size_t i = 0; i < v.size(); ++i) v[i] = float(i % 9973);
+    Tensor base({n, m}, v);
+    checkpoint::save(path, {{"w", base.transpose(0, 1)}});
+    Tensor w = checkpoint::load(path).at("w");
+    ASSERT_EQ(w.shape(), (std::vector<std::size_t>{m, n}));
+    for (std::size_t r : {std::size_t(0), std::size_t(777), m - 1})
+        for (std::size_t c : {std::size_t(0), std::size_t(513), n - 1})
+            EXPECT_EQ(w.data<float>()[r * n + c], v[c * m + r]);
+    std::remove(path.c_str());
+}
+
+TEST(Checkpoint, ModuleSaveAndLoad) {
+    const std::string path = temp_path("napcas_linear.ckpt");
+    architecture::Linear a(16, 8), b(16, 8);
+    a.save(path);
+    b.load(path);
+    expect_equal(b.weight(), a.weight());
+    expect_equal(b.bias(), a.bias());
+    std::remove(path.c_str());
+}
+
+TEST(Checkpoint, ModuleLoadRebindsParametersToTheMapping) {
+    const std::string path = temp_path("napcas_linear_map.ckpt");
+    architecture::Linear a(64, 32), b(64, 32);
+    a.save(path);
+    const Tensor weight = b.weight();   // autre handle, même Storage
+    const std::uint64_t version = weight.storage()->version();
+    const std::size_t allocs = allocator_stats().num_allocs;
+    const std::size_t in_use = allocator_stats().bytes_in_use;
+
+    b.load(path);
+    // Aucun octet copié : pas d'allocation, les anciens buffers sont rendus
+    EXPECT_EQ(allocator_stats().num_allocs, allocs);
+    EXPECT_LT(allocator_stats().bytes_in_use, in_use);
+    EXPECT_EQ(weight.storage(), b.weight().storage());
+    EXPECT_TRUE(mapped_from(b.weight().data_ptr(), path));
+    EXPECT_TRUE(mapped_from(b.bias().data_ptr(), path));
+    EXPECT_GT(weight.storage()->version(), version);
+    expect_equal(b.weight(), a.weight());
+    expect_equal(b.bias(), a.bias());
+
+    // Projection privée : écrire dans le paramètre laisse le fichier intact
+    Tensor w = b.weight();
+    w.data<float>()[0] += 1.0f;
+    const auto reloaded = checkpoint::load(path);
+    EXPECT_EQ(reloaded.at("weight").data<float>()[0], a.weight().data<float>()[0]);
+
+    // Type différent : repli sur la copie
+    architecture::Linear c(64, 32, true, DType::Float64);
+    c.load(path);
+    EXPECT_FALSE(mapped_from(c.weight().data_ptr(), path));
+    expect_equal(c.weight(), a.weight().astype(DType::Float64));
+    std::remove(path.c_str());
+}
+
+TEST(Checkpoint, ResavingALoadedCheckpointKeepsItIntact) {
+    const std::string path = temp_path("napcas_resave.ckpt");
+    std::map<std::string, Tensor> tensors;
+    tensors["w"] = Tensor({300, 70}, std::vector<float>(300 * 70, 0.25f));
+    tensors["i"] = Tensor({3}, std::vector<int>{7, 8, 9}, DType::Int64);
+    checkpoint::save(path, tensors);
+
+    auto loaded = checkpoint::load(path);
+    loaded.at("w").data<float>()[5] = 2.0f;
+    ASSERT_NO_THROW(checkpoint::save(path, loaded));
+    // Les tenseurs chargés restent lisibles, le fichier est complet
+    expect_equal(loaded.at("i"), tensors.at("i"));
+    const auto again = checkpoint::load(path);
+    expect_equal(again.at("w"), loaded.at("w"));
+    expect_equal(again.at("i"), tensors.at("i"));
+    EXPECT_EQ(again.at("w").data<float>()[5], 2.0f);
+
+    // Reprise d'entraînement : load() puis save() du module au même chemin
+    architecture::Linear a(16, 8), b(16, 8);
+    a.save(path);
+    b.load(path);
+    ASSERT_NO_THROW(b.save(path));
+    expect_equal(b.weight(), a.weight());
+    architecture::Linear c(16, 8);
+    c.load(path);
+    expect_equal(c.weight(), a.weight());
+    std::remove(path.c_str());
+}
+
+TEST(Checkpoint, RejectsBadFiles) {
+    EXPECT_THROW(checkpoint::load(temp_path("napcas_missing.ckpt")), std::runtime_error);
+    const std::string path = temp_path("napcas_bad.ckpt");
+    {
+        std::ofstream f(path, std::ios::binary);
+        f << "definitely not a checkpoint file";
+    }
+    EXPECT_THROW(checkpoint::load(path), std::runtime_error);
+
+    // En-tête valide mais données tronquées
+    checkpoint::save(path, {{"x", Tensor::ones({1000})}});
+    {
+        std::ifstream in(path, std::ios::binary);
+        std::string bytes((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        out.write(bytes.data(), std::streamsize(bytes.size() / 2));
+    }
+    EXPECT_THROW(checkpoint::load(path), std::runtime_error);
+    std::remove(path.c_str());
+}
+
+namespace {
+// Réécrit `n` octets à `pos` dans le fichier
+void patch(const std::string& path, std::size_t pos, const void* data, std::size_t n) {
+    std::fstream f(path, std::ios::binary | std::ios::in | std::ios::out);
+    f.seekp(std::streamoff(pos));
+    f.write(static_cast<const char*>(data), std::streamsize(n));
+}
+}
+
+TEST(Checkpoint, RejectsHostileHeaders) {
+    // En-tête : magic, taille, nombre, puis pour "x" : longueur du nom (4),
+    // nom (1), dtype (1), ndim (4) à l'octet 30, dimensions dès l'octet 34
+    const std::string path = temp_path("napcas_hostile.ckpt");
+    constexpr std::size_t kNdim = 8 + 8 + 8 + 4 + 1 + 1, kDims = kNdim + 4;
+
+    // ndim géant : rejeté avant d'allouer la forme
+    checkpoint::save(path, {{"x", Tensor::ones({4})}});
+    const std::uint32_t huge_ndim = 0xFFFFFFFFu;
+    patch(path, kNdim, &huge_ndim, sizeof(huge_ndim));
+    EXPECT_THROW(checkpoint::load(path), std::runtime_error);
+
+    // (2^62 + 1) · 4 · 4 octets déborde sur 16 = nbytes du fichier
+    checkpoint::save(path, {{"x", Tensor::ones({2, 2})}});
+    const std::uint64_t dims[2] = {(std::uint64_t(1) << 62) + 1, 4};
+    patch(path, kDims, dims, sizeof(dims));
+    try {
+        checkpoint::load(path);
+        ADD_FAILURE() << "overflowing shape accepted";
+    } catch (const std::runtime_error& e) {
+        EXPECT_NE(std::string(e.what()).find("corrupt entry"), std::string::npos) << e.what();
+    }
+    std::remove(path.c_str());
+}
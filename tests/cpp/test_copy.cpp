@@ -0,0 +1,77 @@
+#include <gtest/gtest.h>
+#include "napcas/tensor.h"
+#include "napcas/kernels/copy.h"
+
+using namespace napcas;
+
+namespace {
+Tensor arange(const std::vector<std::size_t>& shape) {
+    std::size_t n = 1;
+    for (auto s : shape) n *= s;
+    std::vector<float> data(n);
+    for (std::size_t i = 0; i < n; ++i) data[i] = float(i);
+    return Tensor(shape, data);
+}
+
+// Référence naïve : lecture élément par élément via les strides
+std::vector<float> gather(const Tensor& t) {
+    std::vector<float> out(t.numel());
+    std::vector<std::size_t> idx(t.ndim(), 0);
+    const float* base = t.data<float>();
+    for (std::size_t i = 0; i < out.size(); ++i) {
+        std::ptrdiff_t off = 0;
+        for (std::size_t d = 0; d < t.ndim(); ++d)
+            off += std::ptrdiff_t(idx[d]) * t.strides()[d];
+        out[i] = base[off];
+        for (int d = int(t.ndim()) - 1; d >= 0; --d) {
+            if (++idx[d] < t.shape()[d]) break;
+            idx[d] = 0;
+        }
+    }
+    return out;
+}
+
+void expect_matches(const Tensor& view) {
+    Tensor c = view.contiguous();
+    ASSERT_TRUE(c.is_contiguous());
+    ASSERT_EQ(c.shape(), view.shape());
+    std::vector<float> ref = gather(view);
+    for (std::size_t i = 0; i < ref.size(); ++i)
+        ASSERT_FLOAT_EQ(c.data<float>()[i], ref[i]) << "at " << i;
+}
+}
+
+TEST(StridedCopy, Transpose2D) {
+    expect_matches(arange({7, 13}).transpose(0, 1));
+    expect_matches(arange({64, 33}).transpose(0, 1));
+}
+
+TEST(StridedCopy, LastTwoDimsSwapped) {
+    expect_matches(arange({3, 17, 40}).transpose(1, 2));
+}
+
+TEST(StridedCopy, ArbitraryPermutations) {
+    Tensor a = arange({2, 3, 4, 5});
+    expect_matches(a.permute({3, 1, 0, 2}));
+    expect_matches(a.permute({1, 0, 2, 3}));
+    expect_matches(a.permute({0, 2, 1, 3}));
+    expect_matches(a.permute({2, 3, 0, 1}));
+}
+
+TEST(StridedCopy, NonUnitInnerStride) {
+    Tensor a = arange({6, 8});
+    expect_matches(a.as_strided({3, 4}, {16, 2}, 1));
+}
+
+TEST(StridedCopy, LargeTransposeUsesAllThreads) {
+    expect_matches(arange({512, 768}).transpose(0, 1));
+    expect_matches(arange({4, 300, 200}).permute({2, 0, 1}));
+}
+
+TEST(StridedCopy, SixteenBitElements) {
+    std::vector<std::uint16_t> src(12), dst(12);
+    for (int i = 0; i < 12; ++i) src[i] = std::uint16_t(i);
+    kernels::strided_copy(dst.data(), src.data(), {4, 3}, {1, 4}, 2);
+    const std::uint16_t expected[] = {0, 4, 8, 1, 5, 9, 2, 6, 10, 3, 7, 11};
+    for (int i = 0; i < 12; ++i) EXPECT_EQ(dst[i], expected[i]);
+}
@@ -0,0 +1,268 @@
+#include <gtest/gtest.h>
+#include "napcas/data.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <set>
+#include <unistd.h>
+
+using namespace napcas;
+using namespace napcas::data;
+
+namespace {
+std::string temp_path(const char* name) {
+    return ::testing::TempDir() + name;
+}
+
+// Enregistrement : label int64 = i, x float32[3] = {i, i + 0.5, -i}
+const std::vector<Field> kFields = {{"label", DType::Int64, {}}, {"x", DType::Float32, {3}}};
+
+// Écrit les enregistrements [first, first + count) après `header` octets
+std::string write_records(const char* name, std::size_t first, std::size_t count,
+                          std::size_t header = 0) {
+    const std::string path = temp_path(name);
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    const std::string pad(header, 'h');
+    out.write(pad.data(), std::streamsize(pad.size()));
+    for (std::size_t i = first; i < first + count; ++i) {
+        const std::int64_t label = std::int64_t(i);
+        const float x[3] = {float(i), float(i) + 0.5f, -float(i)};
+        out.write(reinterpret_cast<const char*>(&label), sizeof(label));
+        out.write(reinterpret_cast<const char*>(x), sizeof(x));
+    }
+    return path;
+}
+
+std::shared_ptr<RecordDataset> dataset(std::size_t n, ReadMode mode = ReadMode::Mmap) {
+    // Trois fichiers, dont un vide : les suites s'arrêtent aux frontières
+    const std::size_t a = n / 3;
+    return std::make_shared<RecordDataset>(
+        std::vector<std::string>{write_records("napcas_data_a.bin", 0, a),
+                                 write_records("napcas_data_empty.bin", 0, 0),
+                                 write_records("napcas_data_b.bin", a, n - a)},
+        kFields, 0, mode);
+}
+
+// Vérifie le contenu d'un lot et renvoie ses labels
+std::vector<std::int64_t> check_batch(const std::vector<Tensor>& batch) {
+    EXPECT_EQ(batch.size(), 2u);
+    const Tensor& label = batch[0];
+    const Tensor& x     = batch[1];
+    EXPECT_EQ(label.dtype(), DType::Int64);
+    EXPECT_EQ(x.dtype(), DType::Float32);
+    EXPECT_EQ(x.shape(), (Shape{label.shape()[0], 3}));
+    EXPECT_TRUE(x.is_contiguous());
+    std::vector<std::int64_t> labels(label.data<std::int64_t>(),
+                                     label.data<std::int64_t>() + label.numel());
+    for (std::size_t r = 0; r < labels.size(); ++r) {
+        const float i = float(labels[r]);
+        EXPECT_EQ(x.data<float>()[r * 3 + 0], i);
+        EXPECT_EQ(x.data<float>()[r * 3 + 1], i + 0.5f);
+        EXPECT_EQ(x.data<float>()[r * 3 + 2], -i);
+    }
+    return labels;
+}
+
+std::vector<std::int64_t> run_epoch(DataLoader& loader) {
+    std::vector<std::int64_t> all;
+    for (auto batch = loader.next(); !batch.empty(); batch = loader.next()) {
+        const auto labels = check_batch(batch);
+        all.insert(all.end(), labels.begin(), labels.end());
+    }
+    return all;
+}
+}
+
+TEST(RecordDataset, ReadsAcrossFilesInBothModes) {
+    for (ReadMode mode : {ReadMode::Mmap, ReadMode::Pread}) {
+        auto ds = dataset(10, mode);
+        EXPECT_EQ(ds->size(), 10u);
+        EXPECT_EQ(ds->record_bytes(), 8u + 12u);
+        EXPECT_EQ(ds->run_length(0), 3u);
+        EXPECT_EQ(ds->run_length(2), 1u);
+        EXPECT_EQ(ds->run_length(3), 7u);
+        std::vector<char> scratch(7 * ds->record_bytes());
+        const char* p = ds->read(4, 6, scratch.data());
+        for (std::size_t r = 0; r < 6; ++r) {
+            std::int64_t label;
+            std::memcpy(&label, p + r * ds->record_bytes(), sizeof(label));
+            EXPECT_EQ(label, std::int64_t(4 + r));
+        }
+        EXPECT_EQ(p == scratch.data(), mode == ReadMode::Pread);
+        EXPECT_THROW(ds->read(2, 2, scratch.data()), std::runtime_error);
+        EXPECT_THROW(ds->read(10, 1, scratch.data()), std::runtime_error);
+    }
+}
+
+TEST(RecordDataset, SkipsHeaderAndRejectsBadFiles) {
+    const std::string path = write_records("napcas_data_header.bin", 5, 4, 16);
+    RecordDataset ds({path}, kFields, 16);
+    ASSERT_EQ(ds.size(), 4u);
+    std::int64_t label;
+    std::memcpy(&label, ds.read(0, 1, nullptr), sizeof(label));
+    EXPECT_EQ(label, 5);
+
+    EXPECT_THROW(RecordDataset({path}, kFields, 17), std::runtime_error);   // octets en trop
+    EXPECT_THROW(RecordDataset({path}, kFields, 1000), std::runtime_error); // en-tête trop long
+    EXPECT_THROW(RecordDataset({temp_path("napcas_data_missing.bin")}, kFields), std::runtime_error);
+    EXPECT_THROW(RecordDataset({}, kFields), std::runtime_error);
+    EXPECT_THROW(RecordDataset({path}, {}), std::runtime_error);
+    EXPECT_THROW(RecordDataset({path}, {{"e", DType::Float32, {0}}}), std::runtime_error);
+}
+
+TEST(DataLoader, SequentialBatchesWithPartialOrDroppedTail) {
+    auto ds = dataset(23);
+    for (bool drop_last : {false, true}) {
+        LoaderOptions opt;
+        opt.batch_size = 5;
+        opt.shuffle    = false;
+        opt.drop_last  = drop_last;
+        opt.num_workers = 3;
+        DataLoader loader(ds, opt);
+        EXPECT_EQ(loader.num_batches(), drop_last ? 4u : 5u);
+        std::vector<std::size_t> rows;
+        std::vector<std::int64_t> all;
+        for (auto batch = loader.next(); !batch.empty(); batch = loader.next()) {
+            rows.push_back(batch[0].shape()[0]);
+            const auto labels = check_batch(batch);
+            all.insert(all.end(), labels.begin(), labels.end());
+        }
+        EXPECT_EQ(rows, drop_last ? (std::vector<std::size_t>{5, 5, 5, 5})
+                                  : (std::vector<std::size_t>{5, 5, 5, 5, 3}));
+        for (std::size_t i = 0; i < all.size(); ++i) EXPECT_EQ(all[i], std::int64_t(i));
+        EXPECT_TRUE(loader.next().empty());   // fin d'époque jusqu'au start_epoch()
+    }
+}
+
+TEST(DataLoader, SeededShuffleIsReproducibleAndChangesPerEpoch) {
+    for (ReadMode mode : {ReadMode::Mmap, ReadMode::Pread}) {
+        auto ds = dataset(100, mode);
+        LoaderOptions opt;
+        opt.batch_size = 8;
+        opt.seed       = 42;
+        DataLoader a(ds, opt), b(ds, opt);
+        a.start_epoch();
+        b.start_epoch();
+        const auto a0 = run_epoch(a), b0 = run_epoch(b);
+        EXPECT_EQ(a0, b0);
+        ASSERT_EQ(a0.size(), 100u);
+        EXPECT_EQ(std::set<std::int64_t>(a0.begin(), a0.end()).size(), 100u);
+        std::vector<std::int64_t> sorted = a0;
+        std::sort(sorted.begin(), sorted.end());
+        EXPECT_NE(a0, sorted);
+
+        a.start_epoch();
+        EXPECT_EQ(a.epoch(), 1u);
+        const auto a1 = run_epoch(a);
+        EXPECT_NE(a1, a0);
+        EXPECT_EQ(std::set<std::int64_t>(a1.begin(), a1.end()).size(), 100u);
+
+        opt.seed = 43;
+        DataLoader c(ds, opt);
+        EXPECT_NE(run_epoch(c), a0);
+    }
+}
+
+TEST(DataLoader, HeldBatchesAreNeverOverwrittenAndTheRingGrows) {
+    auto ds = dataset(64);
+    LoaderOptions opt;
+    opt.batch_size = 4;
+    opt.prefetch   = 1;
+    opt.seed       = 7;
+    DataLoader loader(ds, opt);
+    EXPECT_EQ(loader.stats().ring_size, 2u);
+
+    // L'appelant garde tous les lots : sans croissance de l'anneau, le
+    // troisième next() attendrait indéfiniment
+    std::vector<std::vector<Tensor>> held;
+    for (auto batch = loader.next(); !batch.empty(); batch = loader.next()) held.push_back(batch);
+    ASSERT_EQ(held.size(), 16u);
+    EXPECT_GE(loader.stats().ring_size, 16u);
+    std::set<std::int64_t> seen;
+    std::set<const void*> buffers;
+    for (const auto& batch : held) {
+        for (std::int64_t l : check_batch(batch)) seen.insert(l);
+        buffers.insert(batch[0].data_ptr());
+    }
+    EXPECT_EQ(seen.size(), 64u);
+    EXPECT_EQ(buffers.size(), 16u);
+
+    // Lots rendus : l'époque suivante réemploie les tampons sans en allouer
+    held.clear();
+    const std::size_t ring = loader.stats().ring_size;
+    loader.start_epoch();
+    std::set<const void*> reused;
+    for (auto batch = loader.next(); !batch.empty(); batch = loader.next())
+        reused.insert(batch[0].data_ptr());
+    EXPECT_EQ(loader.stats().ring_size, ring);
+    for (const void* p : reused) EXPECT_TRUE(buffers.count(p));
+}
+
+TEST(DataLoader, BatchesOutliveTheLoader) {
+    auto ds = dataset(10);
+    std::vector<Tensor> batch;
+    {
+        LoaderOptions opt;
+        opt.batch_size = 10;
+        opt.shuffle    = false;
+        DataLoader loader(ds, opt);
+        batch = loader.next();
+    }
+    const auto labels = check_batch(batch);
+    ASSERT_EQ(labels.size(), 10u);
+    EXPECT_EQ(labels[9], 9);
+}
+
+TEST(DataLoader, StartEpochAbandonsTheCurrentOne) {
+    auto ds = dataset(50);
+    LoaderOptions opt;
+    opt.batch_size = 5;
+    opt.shuffle    = false;
+    opt.prefetch   = 3;
+    DataLoader loader(ds, opt);
+    for (int k = 0; k < 3; ++k) {
+        loader.start_epoch();
+        ASSERT_EQ(check_batch(loader.next()).front(), 0);
+        ASSERT_EQ(check_batch(loader.next()).front(), 5);
+    }
+    loader.start_epoch();
+    EXPECT_EQ(loader.epoch(), 3u);
+    EXPECT_EQ(run_epoch(loader).size(), 50u);
+    EXPECT_EQ(loader.stats().ring_size, 4u);
+}
+
+TEST(DataLoader, ReportsStats) {
+    auto ds = dataset(30);
+    LoaderOptions opt;
+    opt.batch_size = 4;
+    DataLoader loader(ds, opt);
+    EXPECT_EQ(run_epoch(loader).size(), 30u);
+    const LoaderStats s = loader.stats();
+    EXPECT_EQ(s.batches, 8u);
+    EXPECT_EQ(s.samples, 30u);
+    EXPECT_EQ(s.bytes, 30u * ds->record_bytes());
+    EXPECT_GE(s.stall_ns, 0);
+    EXPECT_LE(s.stall_ns, s.elapsed_ns);
+    EXPECT_GT(s.read_ns, 0);
+    loader.reset_stats();
+    EXPECT_EQ(loader.stats().batches, 0u);
+    EXPECT_EQ(loader.stats().elapsed_ns, 0);
+}
+
+TEST(DataLoader, RethrowsWorkerErrors) {
+    const std::string path = write_records("napcas_data_truncated.bin", 0, 40);
+    auto ds = std::make_shared<RecordDataset>(std::vector<std::string>{path}, kFields, 0,
+                                              ReadMode::Pread);
+    LoaderOptions opt;
+    opt.batch_size = 8;
+    opt.shuffle    = false;
+    DataLoader loader(ds, opt);
+    ASSERT_EQ(::truncate(path.c_str(), 0), 0);   // pread() rencontre la fin du fichier
+    EXPECT_THROW(run_epoch(loader), std::runtime_error);
+
+    EXPECT_THROW(DataLoader(nullptr), std::runtime_error);
+    opt.batch_size = 0;
+    EXPECT_THROW(DataLoader(ds, opt), std::runtime_error);
+}
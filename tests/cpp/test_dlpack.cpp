@@ -0,0 +1,92 @@
+#include <gtest/gtest.h>
+#include "napcas/dlpack.h"
+#include "napcas/tensor.h"
+
+using namespace napcas;
+
+namespace {
+Tensor arange(const std::vector<std::size_t>& shape) {
+    std::size_t n = 1;
+    for (auto s : shape) n *= s;
+    std::vector<float> data(n);
+    for (std::size_t i = 0; i < n; ++i) data[i] = float(i);
+    return Tensor(shape, data);
+}
+}
+
+TEST(DLPack, RoundTripSharesStorage) {
+    Tensor a = arange({3, 4});
+    DLManagedTensor* m = to_dlpack(a);
+    EXPECT_EQ(m->dl_tensor.ndim, 2);
+    EXPECT_EQ(m->dl_tensor.dtype.code, kDLFloat);
+    EXPECT_EQ(m->dl_tensor.dtype.bits, 32);
+    Tensor b = from_dlpack(m);
+    EXPECT_EQ(b.shape(), a.shape());
+    EXPECT_EQ(b.data_ptr(), a.data_ptr());
+    b.data<float>()[5] = -1.0f;
+    EXPECT_FLOAT_EQ(a.data<float>()[5], -1.0f);
+}
+
+TEST(DLPack, StridedViewKeepsGeometry) {
+    Tensor a = arange({4, 6});
+    Tensor v = a.transpose(0, 1).squeeze(0);   // (6, 4) non contigu
+    Tensor w = a.view({2, 12}).unsqueeze(0).squeeze(0).permute({1, 0});
+    for (const Tensor& t : {v, w}) {
+        Tensor b = from_dlpack(to_dlpack(t));
+        EXPECT_EQ(b.shape(), t.shape());
+        EXPECT_EQ(b.strides(), t.strides());
+        EXPECT_EQ(b.storage_offset(), t.storage_offset());
+        Tensor x = b.contiguous(), y = t.contiguous();
+        for (std::size_t i = 0; i < x.numel(); ++i)
+            EXPECT_FLOAT_EQ(x.data<float>()[i], y.data<float>()[i]);
+    }
+}
+
+TEST(DLPack, ImportCallsProducerDeleter) {
+    static int deleted = 0;
+    deleted = 0;
+    std::vector<std::int64_t> buf = {1, 2, 3, 4, 5, 6};
+    std::int64_t shape[2] = {2, 3};
+    auto* m = new DLManagedTensor{};
+    m->dl_tensor.data   = buf.data();
+    m->dl_tensor.device = {kDLCPU, 0};
+    m->dl_tensor.ndim   = 2;
+    m->dl_tensor.dtype  = {kDLInt, 64, 1};
+    m->dl_tensor.shape  = shape;
+    m->deleter = [](DLManagedTensor* self) { ++deleted; delete self; };
+    {
+        Tensor t = from_dlpack(m);
+        EXPECT_EQ(t.dtype(), DType::Int64);
+        EXPECT_EQ(t.strides(), (std::vector<std::ptrdiff_t>{3, 1}));
+        EXPECT_EQ(t.data<std::int64_t>()[4], 5);
+        Tensor view = t.transpose(0, 1);
+        EXPECT_EQ(deleted, 0);
+    }
+    EXPECT_EQ(deleted, 1);
+}
+
+TEST(DLPack, RejectsUnsupportedWithoutConsuming) {
+    float x = 0.0f;
+    std::int64_t shape[1] = {1};
+    DLManagedTensor m{};
+    m.dl_tensor.data   = &x;
+    m.dl_tensor.device = {kDLCUDA, 0};
+    m.dl_tensor.ndim   = 1;
+    m.dl_tensor.dtype  = {kDLFloat, 32, 1};
+    m.dl_tensor.shape  = shape;
+    m.deleter = [](DLManagedTensor*) { FAIL() << "deleter must not run"; };
+    EXPECT_THROW(from_dlpack(&m), std::runtime_error);
+    m.dl_tensor.device = {kDLCPU, 0};
+    m.dl_tensor.dtype  = {kDLFloat, 32, 4};
+    EXPECT_THROW(from_dlpack(&m), std::runtime_error);
+}
+
+TEST(DLPack, FromStorageChecksBounds) {
+    auto storage = Storage::allocate(6 * sizeof(float), Device{DeviceType::CPU, 0});
+    EXPECT_NO_THROW(Tensor::from_storage(storage, {2, 3}, {3, 1}, DType::Float32));
+    EXPECT_NO_THROW(Tensor::from_storage(storage, {3}, {2}, DType::Float32, 1));
+    EXPECT_THROW(Tensor::from_storage(storage, {2, 3}, {3, 1}, DType::Float32, 1),
+                 std::runtime_error);
+    EXPECT_THROW(Tensor::from_storage(storage, {2, 3}, {3, 1}, DType::Float64),
+                 std::runtime_error);
+}
@@ -0,0 +1,230 @@
+#include <gtest/gtest.h>
+#include "napcas/cpu.h"
+#include "napcas/half.h"
+#include "napcas/tensor.h"
+#include "napcas/kernels/convert.h"
+#include <cmath>
+#include <limits>
+
+using namespace napcas;
+
+namespace {
+const CpuCapability kLevels[] = {
+    CpuCapability::Scalar, CpuCapability::SSE2,
+    CpuCapability::AVX2,   CpuCapability::AVX512
+};
+
+struct RestoreCapability {
+    CpuCapability saved = cpu_capability();
+    ~RestoreCapability() { set_cpu_capability(saved); }
+};
+
+const DType kAllTypes[] = {
+    DType::Float32, DType::Int32, DType::Float16, DType::BFloat16,
+    DType::Float64, DType::Int8,  DType::UInt8,   DType::Int64
+};
+}
+
+TEST(DType, HalfBitPatterns) {
+    EXPECT_EQ(float_to_half_bits(1.0f),     0x3c00);
+    EXPECT_EQ(float_to_half_bits(-2.0f),    0xc000);
+    EXPECT_EQ(float_to_half_bits(65504.0f), 0x7bff);
+    EXPECT_EQ(float_to_half_bits(65520.0f), 0x7c00);               // arrondi vers inf
+    EXPECT_EQ(float_to_half_bits(std::ldexp(1.0f, -24)), 0x0001);  // plus petit sous-normal
+    EXPECT_EQ(float_to_half_bits(1.0f + std::ldexp(1.0f, -11)), 0x3c00);  // égalité -> pair
+    EXPECT_TRUE(std::isnan(half_bits_to_float(float_to_half_bits(NAN))));
+    EXPECT_EQ(half_bits_to_float(0x0001), std::ldexp(1.0f, -24));
+    EXPECT_EQ(half_bits_to_float(0x7c00), std::numeric_limits<float>::infinity());
+
+    EXPECT_EQ(float_to_bfloat16_bits(1.0f), 0x3f80);
+    EXPECT_EQ(float_to_bfloat16_bits(1.0f + std::ldexp(1.0f, -8)), 0x3f80);
+    EXPECT_EQ(bfloat16_bits_to_float(0xc040), -3.0f);
+}
+
+TEST(DType, HalfRoundTripsAllFiniteValues) {
+    for (std::uint32_t h = 0; h < 0x10000; ++h) {
+        if ((h & 0x7c00) == 0x7c00) continue;                      // inf / NaN
+        const float f = half_bits_to_float(std::uint16_t(h));
+        EXPECT_EQ(float_to_half_bits(f), h) << std::hex << h;
+    }
+}
+
+TEST(DType, VectorizedConversionMatchesScalarAtEveryLevel) {
+    RestoreCapability restore;
+    std::vector<float> src(1037);
+    for (std::size_t i = 0; i < src.size(); ++i)
+        src[i] = std::ldexp(float(i) * 0.731f - 300.0f, int(i % 40) - 20);
+    src[5] = NAN;
+    src[6] = -INFINITY;
+    src[7] = 1e6f;
+    for (CpuCapability level : kLevels) {
+        if (level > detected_cpu_capability()) continue;
+        set_cpu_capability(level);
+        for (std::size_t n : {std::size_t(0), std::size_t(3), std::size_t(17), src.size()}) {
+            std::vector<Half> h(n);
+            std::vector<BFloat16> b(n);
+            std::vector<float> back(n);
+            kernels::convert(h.data(), DType::Float16, src.data(), DType::Float32, n);
+            kernels::convert(b.data(), DType::BFloat16, src.data(), DType::Float32, n);
+            for (std::size_t i = 0; i < n; ++i) {
+                EXPECT_EQ(h[i].bits, float_to_half_bits(src[i])) << i;
+                EXPECT_EQ(b[i].bits, float_to_bfloat16_bits(src[i])) << i;
+            }
+            kernels::convert(back.data(), DType::Float32, h.data(), DType::Float16, n);
+            for (std::size_t i = 0; i < n; ++i) {
+                if (std::isnan(src[i])) {
+                    EXPECT_TRUE(std::isnan(back[i]));
+                } else {
+                    EXPECT_EQ(back[i], half_bits_to_float(h[i].bits)) << i;
+                }
+            }
+            kernels::convert(back.data(), DType::Float32, b.data(), DType::BFloat16, n);
+            for (std::size_t i = 0; i < n; ++i) {
+                if (!std::isnan(src[i])) {
+                    EXPECT_EQ(back[i], bfloat16_bits_to_float(b[i].bits)) << i;
+                }
+            }
+        }
+    }
+}
+
+TEST(DType, AstypeBetweenAllTypes) {
+    Tensor t({2, 3}, std::vector<std::int32_t>{0, 1, 2, 3, 4, 100}, DType::Int32);
+    for (DType from : kAllTypes) {
+        Tensor a = t.astype(from);
+        EXPECT_EQ(a.dtype(), from);
+        for (DType to : kAllTypes) {
+            Tensor b = a.astype(to).astype(DType::Int64);
+            const std::int64_t* p = b.data<std::int64_t>();
+            EXPECT_EQ(p[0], 0);
+            EXPECT_EQ(p[3], 3);
+            EXPECT_EQ(p[5], 100) << dtype_to_string(from) << " -> " << dtype_to_string(to);
+        }
+    }
+}
+
+TEST(DType, FloatToIntegerSaturates) {
+    const float inf = std::numeric_limits<float>::infinity();
+    const float nan = std::numeric_limits<float>::quiet_NaN();
+    const std::vector<float> v = {300.f, -300.f, 127.9f, -128.9f, -0.7f, 2.5f, nan, inf, -inf,
+                                  3e9f, -3e9f, 1e19f, -1e19f};
+    auto as_int = [](const Tensor& t) {
+        Tensor d = t.astype(DType::Int64);
+        return std::vector<std::int64_t>(d.data<std::int64_t>(), d.data<std::int64_t>() + d.numel());
+    };
+    for (DType from : {DType::Float32, DType::Float64}) {
+        Tensor f = Tensor({v.size()}, v).astype(from);
+        EXPECT_EQ(as_int(f.astype(DType::Int8)),
+                  (std::vector<std::int64_t>{127, -128, 127, -128, 0, 2, 0, 127, -128,
+                                             127, -128, 127, -128}));
+        EXPECT_EQ(as_int(f.astype(DType::UInt8)),
+                  (std::vector<std::int64_t>{255, 0, 127, 0, 0, 2, 0, 255, 0, 255, 0, 255, 0}));
+        const std::int64_t imax = std::numeric_limits<std::int32_t>::max();
+        const std::int64_t imin = std::numeric_limits<std::int32_t>::min();
+        EXPECT_EQ(as_int(f.astype(DType::Int32)),
+                  (std::vector<std::int64_t>{300, -300, 127, -128, 0, 2, 0, imax, imin,
+                                             imax, imin, imax, imin}));
+        const std::int64_t lmax = std::numeric_limits<std::int64_t>::max();
+        const std::int64_t lmin = std::numeric_limits<std::int64_t>::min();
+        EXPECT_EQ(as_int(f),
+                  (std::vector<std::int64_t>{300, -300, 127, -128, 0, 2, 0, lmax, lmin,
+                                             3000000000, -3000000000, lmax, lmin}));
+    }
+    // Par float32 pour les types 16 bits
+    Tensor h = Tensor({3}, std::vector<float>{1000.f, nan, -inf}, DType::Float16);
+    EXPECT_EQ(as_int(h.astype(DType::Int8)), (std::vector<std::int64_t>{127, 0, -128}));
+}
+
+TEST(DType, AstypeReadsStridedViews) {
+    Tensor t({2, 3}, std::vector<float>{1, 2, 3, 4, 5, 6});
+    Tensor h = t.transpose(0, 1).astype(DType::Float16);
+    ASSERT_EQ(h.shape(), (std::vector<std::size_t>{3, 2}));
+    const std::vector<float> expected{1, 4, 2, 5, 3, 6};
+    for (std::size_t i = 0; i < 6; ++i)
+        EXPECT_EQ(float(h.data<Half>()[i]), expected[i]);
+}
+
+TEST(DType, ConstructorConvertsData) {
+    Tensor t({3}, std::vector<float>{1.5f, -2.0f, 7.0f}, DType::Int32);
+    EXPECT_EQ(t.data<std::int32_t>()[0], 1);
+    EXPECT_EQ(t.data<std::int32_t>()[1], -2);
+    Tensor d({2}, std::vector<double>{0.1, 0.2}, DType::Float64);
+    EXPECT_EQ(d.data<double>()[1], 0.2);
+}
+
+TEST(DType, Promotion) {
+    EXPECT_EQ(promote_types(DType::Int32,   DType::Float16),  DType::Float16);
+    EXPECT_EQ(promote_types(DType::Float16, DType::BFloat16), DType::Float32);
+    EXPECT_EQ(promote_types(DType::Float32, DType::Float64),  DType::Float64);
+    EXPECT_EQ(promote_types(DType::Int8,    DType::UInt8),    DType::Int32);
+    EXPECT_EQ(promote_types(DType::Int64,   DType::Int8),     DType::Int64);
+    EXPECT_EQ(promote_types(DType::Int64,   DType::Float32),  DType::Float32);
+
+    Tensor i({3}, std::vector<std::int32_t>{1, 2, 3}, DType::Int32);
+    Tensor f({3}, std::vector<float>{0.5f, 0.5f, 0.5f});
+    Tensor s = i + f;
+    EXPECT_EQ(s.dtype(), DType::Float32);
+    EXPECT_FLOAT_EQ(s.data<float>()[2], 3.5f);
+    Tensor d = Tensor::ones({1}, DType::Float64) / i;          // diffusé
+    EXPECT_EQ(d.dtype(), DType::Float64);
+    EXPECT_DOUBLE_EQ(d.data<double>()[2], 1.0 / 3.0);
+}
+
+TEST(DType, ArithmeticInEveryType) {
+    for (DType t : kAllTypes) {
+        Tensor a = Tensor::ones({4, 33}, t);
+        Tensor b = (a + a) * a - a;                            // 1
+        Tensor c = b + Tensor::ones({33}, t);                  // 2, diffusé
+        Tensor r = c.astype(DType::Float64);
+        for (std::size_t k = 0; k < r.numel(); ++k)
+            ASSERT_EQ(r.data<double>()[k], 2.0) << dtype_to_string(t);
+    }
+}
+
+TEST(DType, IntegerOpsWrap) {
+    Tensor a({2}, std::vector<std::int8_t>{120, -128}, DType::Int8);
+    Tensor b({2}, std::vector<std::int8_t>{10, 1}, DType::Int8);
+    Tensor s = a + b;
+    EXPECT_EQ(s.data<std::int8_t>()[0], std::int8_t(-126));
+    Tensor d = a - b;
+    EXPECT_EQ(d.data<std::int8_t>()[1], std::int8_t(127));
+}
+
+TEST(DType, HalfPrecisionArithmetic) {
+    std::vector<float> x(300), y(300);
+    for (std::size_t i = 0; i < x.size(); ++i) {
+        x[i] = 0.01f * float(i);
+        y[i] = 1.0f + 0.5f * float(i % 7);
+    }
+    for (DType t : {DType::Float16, DType::BFloat16}) {
+        Tensor a = Tensor({300}, x).astype(t);
+        Tensor b = Tensor({300}, y).astype(t);
+        Tensor q = (a / b).astype(DType::Float32);
+        Tensor fa = a.astype(DType::Float32), fb = b.astype(DType::Float32);
+        for (std::size_t i = 0; i < x.size(); ++i) {
+            const float ref = fa.data<float>()[i] / fb.data<float>()[i];
+            EXPECT_NEAR(q.data<float>()[i], ref, std::abs(ref) * 1e-2f + 1e-6f);
+        }
+    }
+}
+
+TEST(DType, MatmulFloat64AndHalf) {
+    std::vector<double> av(6), bv(12);
+    for (std::size_t i = 0; i < av.size(); ++i) av[i] = 0.5 * double(i) - 1.0;
+    for (std::size_t i = 0; i < bv.size(); ++i) bv[i] = 0.25 * double(i);
+    Tensor a({2, 3}, av, DType::Float64);
+    Tensor b({3, 4}, bv, DType::Float64);
+    for (DType t : {DType::Float64, DType::Float32, DType::Float16, DType::BFloat16}) {
+        Tensor c = a.astype(t).matmul(b.astype(t));
+        EXPECT_EQ(c.dtype(), t);
+        Tensor r = c.astype(DType::Float64);
+        for (std::size_t i = 0; i < 2; ++i)
+            for (std::size_t j = 0; j < 4; ++j) {
+                double ref = 0.0;
+                for (std::size_t p = 0; p < 3; ++p) ref += av[i * 3 + p] * bv[p * 4 + j];
+                EXPECT_NEAR(r.data<double>()[i * 4 + j], ref, std::abs(ref) * 1e-2 + 1e-9);
+            }
+    }
+    Tensor ai = a.astype(DType::Int32);
+    EXPECT_THROW(ai.matmul(ai.transpose(0, 1)), std::runtime_error);
+}
@@ -0,0 +1,166 @@
+#include <gtest/gtest.h>
+#include "napcas/graph.h"
+#include "napcas/allocator.h"
+#include "napcas/architecture/linear.h"
+#include "napcas/lazy.h"
+#include "napcas/tensor.h"
+#include <random>
+
+using namespace napcas;
+using architecture::Linear;
+using kernels::Activation;
+
+namespace {
+Tensor random(const std::vector<std::size_t>& shape, unsigned seed, DType dtype = DType::Float32) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> u(-1.0, 1.0);
+    std::size_t n = 1;
+    for (auto s : shape) n *= s;
+    std::vector<double> v(n);
+    for (auto& e : v) e = u(rng);
+    return Tensor(shape, v, dtype);
+}
+
+void expect_close(const Tensor& a, const Tensor& b, double tol = 1e-5) {
+    ASSERT_EQ(a.shape(), b.shape());
+    ASSERT_EQ(a.dtype(), b.dtype());
+    Tensor ca = a.astype(DType::Float64).contiguous();
+    Tensor cb = b.astype(DType::Float64).contiguous();
+    for (std::size_t i = 0; i < a.numel(); ++i)
+        EXPECT_NEAR(ca.data<double>()[i], cb.data<double>()[i], tol) << i;
+}
+
+class MLP : public Module {
+public:
+    MLP()
+        : fc1_(std::make_shared<Linear>(16, 32, true, DType::Float32,
+                                        Device{DeviceType::CPU, 0}, Activation::GELU)),
+          fc2_(std::make_shared<Linear>(32, 8)) {
+        register_module("fc1", fc1_);
+        register_module("fc2", fc2_);
+    }
+    Tensor forward(const Tensor& x) override { return (*fc2_)((*fc1_)(x)).softmax(); }
+
+private:
+    std::shared_ptr<Linear> fc1_, fc2_;
+};
+}
+
+TEST(Graph, ModuleReplayMatchesEager) {
+    MLP model;
+    Graph g = Graph::capture(model, random({4, 16}, 1));
+    EXPECT_EQ(g.ops(), (std::vector<std::string>{"linear", "linear", "softmax"}));
+    for (unsigned seed = 2; seed < 5; ++seed) {
+        Tensor x = random({4, 16}, seed);
+        const Tensor& y = g.replay({x})[0];
+        EXPECT_FALSE(y.requires_grad());
+        expect_close(y, model(x));
+    }
+    EXPECT_THROW(g.replay({random({5, 16}, 1)}), std::runtime_error);
+    EXPECT_THROW(g.replay({}), std::runtime_error);
+}
+
+TEST(Graph, ParametersAreReadAtReplay) {
+    Linear fc(8, 4);
+    Graph g = Graph::capture(fc, random({2, 8}, 1));
+    Tensor w = fc.weight().detach();
+    w.mul_(Tensor({}, std::vector<float>{2.0f}));
+    Tensor x = random({2, 8}, 3);
+    expect_close(g.replay({x})[0], fc(x));
+}
+
+TEST(Graph, IntermediatesShareArena) {
+    const Tensor two = Tensor({}, std::vector<float>{2.0f});
+    auto fn = [&](const std::vector<Tensor>& in) {
+        Tensor h = in[0];
+        for (int i = 0; i < 8; ++i) h = (h * two).relu();
+        return std::vector<Tensor>{h};
+    };
+    Tensor x = random({256, 256}, 1);
+    Graph g = Graph::capture(fn, {x});
+    EXPECT_EQ(g.num_ops(), 16u);
+    const std::size_t bytes = 256 * 256 * 4;
+    EXPECT_EQ(g.unpooled_bytes(), 16 * bytes);
+    // Une opération lit un buffer et écrit dans l'autre ; la sortie finale
+    // garde le sien
+    EXPECT_LE(g.arena_bytes(), 3 * bytes);
+    expect_close(g.replay({x})[0], fn({x})[0]);
+}
+
+TEST(Graph, ReplayDoesNotAllocate) {
+    MLP model;
+    Tensor x = random({4, 16}, 1);
+    Graph g = Graph::capture(model, x);
+    g.replay({x});
+    const std::size_t before = allocator_stats().num_allocs;
+    for (int i = 0; i < 10; ++i) g.replay({x});
+    EXPECT_EQ(allocator_stats().num_allocs, before);
+}
+
+TEST(Graph, ViewsStridedOpsAndReductions) {
+    Tensor w = random({6, 5}, 7);
+    Tensor gamma = random({5}, 8);
+    auto fn = [&](const std::vector<Tensor>& in) {
+        Tensor a = in[0].reshape({3, 2, 5});
+        Tensor b = a.transpose(0, 2).softmax(0);            // vue non contiguë
+        Tensor c = in[0].matmul(w.transpose(0, 1)).exp();  // [6, 6]
+        Tensor d = in[0].layer_norm(gamma) - in[1];          // diffusion
+        return std::vector<Tensor>{b, c.sum({1}), d.rms_norm(), d.max({0}, true),
+                                   in[0].transpose(0, 1).contiguous().var({1})};
+    };
+    Tensor x = random({6, 5}, 1), y = random({5}, 2);
+    Graph g = Graph::capture(fn, {x, y});
+    x = random({6, 5}, 3);
+    y = random({5}, 4);
+    const auto& out = g.replay({x, y});
+    const auto ref = fn({x, y});
+    ASSERT_EQ(out.size(), ref.size());
+    for (std::size_t i = 0; i < out.size(); ++i) {
+        SCOPED_TRACE(i);
+        expect_close(out[i], ref[i], 1e-4);
+    }
+}
+
+TEST(Graph, DeadOpsArePruned) {
+    Tensor w = random({3, 3}, 1);
+    w.requires_grad_(true);
+    auto fn = [&](const std::vector<Tensor>& in) {
+        Tensor unused = in[0].exp();
+        // max avec autograd calcule aussi argmax, jamais lu au rejeu
+        return std::vector<Tensor>{(in[0] * w).max({1})};
+    };
+    Graph g = Graph::capture(fn, {random({3, 3}, 2)});
+    EXPECT_EQ(g.ops(), (std::vector<std::string>{"mul", "max"}));
+}
+
+TEST(Graph, InPlaceAndInputs) {
+    const Tensor one = Tensor::ones({4});
+    auto fn = [&](const std::vector<Tensor>& in) {
+        Tensor h = in[0] + one;
+        h.mul_(in[0]);
+        return std::vector<Tensor>{h};
+    };
+    Graph g = Graph::capture(fn, {Tensor::zeros({4})});
+    // Remplissage direct du buffer d'entrée statique
+    Tensor in = g.inputs()[0];
+    add_out(in, Tensor::zeros({4}), Tensor({4}, std::vector<float>{1, 2, 3, 4}));
+    expect_close(g.replay()[0], Tensor({4}, std::vector<float>{2, 6, 12, 20}));
+}
+
+TEST(Graph, RejectsUncapturableOps) {
+    auto fresh_constant = [](const std::vector<Tensor>& in) {
+        return std::vector<Tensor>{in[0] + Tensor::ones({4})};
+    };
+    EXPECT_THROW(Graph::capture(fresh_constant, {Tensor::zeros({4})}), std::runtime_error);
+    auto lazy = [](const std::vector<Tensor>& in) {
+        Tensor y = (LazyTensor(in[0]) * 2.0).eval();
+        return std::vector<Tensor>{y + in[0]};
+    };
+    EXPECT_THROW(Graph::capture(lazy, {Tensor::zeros({4})}), std::runtime_error);
+    EXPECT_FALSE(graph::capturing());
+
+    Linear fc(4, 4);
+    Graph g = Graph::capture(fc, Tensor::zeros({1, 4}));
+    auto nested = [&](const std::vector<Tensor>& in) { return g.replay(in); };
+    EXPECT_THROW(Graph::capture(nested, {Tensor::zeros({1, 4})}), std::runtime_error);
+}
@@ -0,0 +1,146 @@
+#include <gtest/gtest.h>
+#include "napcas/tensor.h"
+#include "napcas/module.h"
+
+using namespace napcas;
+
+namespace {
+void expect_values(const Tensor& t, const std::vector<double>& v, double tol = 1e-6) {
+    ASSERT_EQ(t.numel(), v.size());
+    Tensor c = t.astype(DType::Float64).contiguous();
+    for (std::size_t i = 0; i < v.size(); ++i)
+        EXPECT_NEAR(c.data<double>()[i], v[i], tol) << i;
+}
+}
+
+TEST(InPlace, WritesIntoExistingStorage) {
+    Tensor a({2, 3}, std::vector<float>{1, 2, 3, 4, 5, 6});
+    const void* p = a.data_ptr();
+    const auto v0 = a.version();
+    a += Tensor({3}, std::vector<float>{10, 20, 30});   // diffusé
+    a.mul_(Tensor({2, 1}, std::vector<float>{2, -1}));
+    EXPECT_EQ(a.data_ptr(), p);
+    EXPECT_EQ(a.version(), v0 + 2);
+    expect_values(a, {22, 44, 66, -14, -25, -36});
+    a -= a;                                            // même géométrie
+    expect_values(a, {0, 0, 0, 0, 0, 0});
+
+    // Le résultat ne peut ni changer de forme ni de type
+    EXPECT_THROW(Tensor::ones({3}).add_(Tensor::ones({2, 3})), std::runtime_error);
+    EXPECT_THROW(Tensor::ones({3}, DType::Int32).add_(Tensor::ones({3})), std::runtime_error);
+    EXPECT_THROW(Tensor::ones({1}).expand({4}).add_(Tensor::ones({4})), std::runtime_error);
+    Tensor i = Tensor::ones({2}, DType::Int64);
+    i += Tensor({2}, std::vector<int>{3, 4}, DType::Int32);
+    expect_values(i, {4, 5});
+}
+
+TEST(InPlace, StridedViewsAndAliasing) {
+    Tensor base({3, 3}, std::vector<float>{0, 1, 2, 3, 4, 5, 6, 7, 8});
+    Tensor t = base.transpose(0, 1);                   // sortie à pas 3
+    t.add_(Tensor({3}, std::vector<float>{100, 200, 300}));
+    expect_values(base, {100, 101, 102, 203, 204, 205, 306, 307, 308});
+
+    // x += xᵀ : l'opérande recouvre partiellement la sortie, il est copié
+    Tensor x({2, 2}, std::vector<float>{1, 2, 3, 4});
+    x += x.transpose(0, 1);
+    expect_values(x, {2, 5, 5, 8});
+}
+
+TEST(InPlace, OutVariants) {
+    Tensor a({2, 2}, std::vector<float>{1, 2, 3, 4});
+    Tensor b({2}, std::vector<float>{10, 20});
+    Tensor out = Tensor::zeros({2, 2});
+    const void* p = out.data_ptr();
+    add_out(out, a, b);
+    EXPECT_EQ(out.data_ptr(), p);
+    expect_values(out, {11, 22, 13, 24});
+    div_out(out, out, Tensor({}, std::vector<float>{2}));
+    expect_values(out, {5.5, 11, 6.5, 12});
+    mul_out(a, a, a);
+    expect_values(a, {1, 4, 9, 16});
+
+    Tensor wrong = Tensor::zeros({2, 3});
+    EXPECT_THROW(add_out(wrong, a, b), std::runtime_error);
+    Tensor wrong_dtype = Tensor::zeros({2, 2}, DType::Float64);
+    EXPECT_THROW(add_out(wrong_dtype, a, b), std::runtime_error);
+    a.requires_grad_(true);
+    EXPECT_THROW(add_out(out, a, b), std::runtime_error);
+}
+
+TEST(InPlace, AutogradRebasesAndChains) {
+    Tensor x({3}, std::vector<float>{1, 2, 3});
+    Tensor w({3}, std::vector<float>{4, 5, 6});
+    x.requires_grad_(true);
+    w.requires_grad_(true);
+
+    Tensor y = x + x;          // y = 2x
+    y.mul_(w);                 // y = 2x·w
+    y += x;                    // y = 2x·w + x
+    y.sum().backward();
+    expect_values(x.grad(), {9, 11, 13});
+    expect_values(w.grad(), {2, 4, 6});   // valeurs de y avant mul_ sauvegardées
+
+    // Une feuille qui requiert un gradient ne se modifie pas en place...
+    EXPECT_THROW(x.add_(w), std::runtime_error);
+    // ... sauf via detach() (mise à jour d'optimiseur)
+    x.detach().sub_(x.grad());
+    expect_values(x, {-8, -9, -10});
+}
+
+TEST(InPlace, VersionCounterDetectsModifiedSavedTensor) {
+    Tensor x({2}, std::vector<float>{1, 2});
+    x.requires_grad_(true);
+    Tensor y = x.exp();        // ExpBackward garde y
+    Tensor z = y.sum();
+    y.detach().add_(Tensor::ones({2}));
+    EXPECT_THROW(z.backward(), std::runtime_error);
+
+    // Un poids mis à jour entre forward et backward est aussi détecté
+    Tensor a({2}, std::vector<float>{1, 2});
+    Tensor w({2}, std::vector<float>{3, 4});
+    a.requires_grad_(true);
+    Tensor loss = (a * w).sum();
+    w.mul_(Tensor({}, std::vector<float>{2}));
+    EXPECT_THROW(loss.backward(), std::runtime_error);
+
+    // Sans modification, le backward passe
+    Tensor a2({2}, std::vector<float>{1, 2});
+    a2.requires_grad_(true);
+    (a2 * w).sum().backward();
+    expect_values(a2.grad(), {6, 8});
+}
+
+TEST(InPlace, ViewsRejectedWhenAutogradIsInvolved) {
+    // Vue d'une feuille qui requiert un gradient : ses données ne changent pas
+    Tensor leaf({4}, std::vector<float>{1, 2, 3, 4});
+    leaf.requires_grad_(true);
+    EXPECT_THROW(leaf.view({2, 2}).add_(Tensor::ones({2, 2})), std::runtime_error);
+    EXPECT_THROW(leaf.transpose(0, 0).mul_(Tensor::ones({4})), std::runtime_error);
+    expect_values(leaf, {1, 2, 3, 4});
+
+    // Vue d'un non-feuille : le nœud ne rejoindrait pas le graphe de x
+    Tensor a({4}, std::vector<float>{1, 2, 3, 4});
+    Tensor y({2, 2}, std::vector<float>{5, 6, 7, 8});
+    a.requires_grad_(true);
+    y.requires_grad_(true);
+    Tensor x = a * Tensor({}, std::vector<float>{1});
+    EXPECT_THROW(x.view({2, 2}).add_(y), std::runtime_error);
+    expect_values(x, {1, 2, 3, 4});
+
+    // Base sans gradient mais opérande qui en requiert un
+    Tensor plain({4}, std::vector<float>{1, 2, 3, 4});
+    EXPECT_THROW(plain.view({2, 2}).add_(y), std::runtime_error);
+
+    // Le même calcul hors vue donne les gradients attendus
+    Tensor z = x + y.view({4});
+    (z * Tensor({}, std::vector<float>{2})).sum().backward();
+    expect_values(y.grad(), {2, 2, 2, 2});
+    expect_values(a.grad(), {2, 2, 2, 2});
+
+    // Sans autograd, ou via detach(), les vues restent modifiables en place
+    plain.view({2, 2}).add_(Tensor::ones({2, 2}));
+    expect_values(plain, {2, 3, 4, 5});
+    EXPECT_FALSE(leaf.view({2, 2}).detach().is_view());
+    leaf.view({2, 2}).detach().sub_(Tensor::ones({2, 2}));
+    expect_values(leaf, {0, 1, 2, 3});
+}
@@ -0,0 +1,115 @@
+#include <gtest/gtest.h>
+#include "napcas/allocator.h"
+#include "napcas/lazy.h"
+#include "napcas/tensor.h"
+
+using namespace napcas;
+
+namespace {
+Tensor ramp(const std::vector<std::size_t>& shape, float scale, float shift) {
+    std::size_t n = 1;
+    for (auto s : shape) n *= s;
+    std::vector<float> v(n);
+    for (std::size_t i = 0; i < n; ++i) v[i] = scale * float(i % 97) + shift;
+    return Tensor(shape, v);
+}
+
+void expect_equal(const Tensor& a, const Tensor& b) {
+    ASSERT_EQ(a.shape(), b.shape());
+    ASSERT_EQ(a.dtype(), b.dtype());
+    Tensor x = a.astype(DType::Float64), y = b.astype(DType::Float64);
+    for (std::size_t i = 0; i < x.numel(); ++i)
+        ASSERT_NEAR(x.data<double>()[i], y.data<double>()[i], 1e-5) << i;
+}
+}
+
+TEST(Lazy, FusedMatchesEagerWithBroadcastAndViews) {
+    Tensor a = ramp({64, 130}, 0.5f, -3.0f);
+    Tensor b = ramp({130}, 0.25f, 1.0f);                   // diffusé sur les lignes
+    Tensor c = ramp({130, 64}, 0.1f, 2.0f).transpose(0, 1);  // vue non contiguë
+    Tensor d = ramp({64, 1}, 1.0f, 0.5f);
+    Tensor eager = (a + b) * c - d;
+    Tensor fused = ((LazyTensor(a) + b) * c - d).eval();
+    expect_equal(fused, eager);
+    EXPECT_TRUE(fused.is_contiguous());
+}
+
+TEST(Lazy, SingleOutputAllocation) {
+    Tensor a = ramp({256, 256}, 0.5f, 1.0f);
+    Tensor b = ramp({256, 256}, 0.25f, 1.0f);
+    LazyTensor expr = (LazyTensor(a) + b) * a - b / a;
+    const std::size_t before = allocator_stats().num_allocs;
+    Tensor out = expr.eval();
+    EXPECT_EQ(allocator_stats().num_allocs - before, 1u);
+}
+
+TEST(Lazy, ConstantsAndPromotion) {
+    Tensor i({4}, std::vector<std::int32_t>{1, 2, 3, 4}, DType::Int32);
+    Tensor twice = (LazyTensor(i) * 2 + 1).eval();
+    EXPECT_EQ(twice.dtype(), DType::Int32);
+    EXPECT_EQ(twice.data<std::int32_t>()[3], 9);
+
+    Tensor half = (LazyTensor(i) / 2.0).eval();
+    EXPECT_EQ(half.dtype(), DType::Float32);
+    EXPECT_FLOAT_EQ(half.data<float>()[0], 0.5f);
+
+    Tensor f = Tensor({4}, std::vector<double>{1, 2, 3, 4}, DType::Float64);
+    Tensor mixed = (LazyTensor(i) + f).eval();
+    EXPECT_EQ(mixed.dtype(), DType::Float64);
+    EXPECT_DOUBLE_EQ(mixed.data<double>()[2], 6.0);
+
+    Tensor h = ramp({1000}, 0.01f, 0.0f).astype(DType::Float16);
+    Tensor hr = (1.0 - LazyTensor(h) * h).eval();
+    EXPECT_EQ(hr.dtype(), DType::Float16);
+    Tensor ref = (Tensor::ones({1000}) - h.astype(DType::Float32) * h.astype(DType::Float32))
+                     .astype(DType::Float16);
+    for (std::size_t k = 0; k < 1000; ++k)
+        EXPECT_EQ(hr.data<Half>()[k].bits, ref.data<Half>()[k].bits) << k;
+}
+
+TEST(Lazy, SharedSubexpressionAndParallelChunks) {
+    Tensor a = ramp({3, 100000}, 0.001f, 0.0f);
+    Tensor b = ramp({100000}, 0.002f, 1.0f);
+    LazyTensor x = LazyTensor(a) + b;
+    Tensor fused = (x * x - x).eval();
+    Tensor e = a + b;
+    expect_equal(fused, e * e - e);
+}
+
+TEST(Lazy, AutogradFallsBackToEagerOps) {
+    Tensor a = ramp({8}, 1.0f, 0.0f);
+    Tensor b = ramp({8}, 0.5f, 1.0f);
+    a.requires_grad_(true);
+    LazyTensor expr = (LazyTensor(a) + b) * 3.0;
+    EXPECT_TRUE(expr.requires_grad());
+    Tensor out = expr.eval();
+    EXPECT_TRUE(out.requires_grad());
+    expect_equal(out.detach(), (a.detach() + b) * Tensor({1}, std::vector<float>{3.0f}));
+}
+
+TEST(Lazy, SubexpressionsKeepTheirOwnDtype) {
+    // i / j entiers (division entière) dans une expression float32 : même
+    // résultat avec ou sans rejeu pour l'autograd
+    Tensor i({4}, std::vector<std::int32_t>{7, 9, -7, 5}, DType::Int32);
+    Tensor j({4}, std::vector<std::int32_t>{2, 4, 2, 0}, DType::Int32);
+    Tensor f = ramp({4}, 0.0f, 1.0f);
+    Tensor eager = (i / j) * f;
+    EXPECT_EQ(eager.dtype(), DType::Float32);
+    Tensor fused = ((LazyTensor(i) / j) * f).eval();
+    expect_equal(fused, eager);
+    EXPECT_FLOAT_EQ(fused.data<float>()[0], 3.0f);
+
+    Tensor g = ramp({4}, 0.0f, 1.0f);
+    g.requires_grad_(true);
+    Tensor replay = ((LazyTensor(i) / j) * g).eval();
+    expect_equal(replay.detach(), fused);
+}
+
+TEST(Lazy, OutputFollowsTheLeavesDevice) {
+    const Device dev{DeviceType::CPU, 1};
+    Tensor a({16}, std::vector<float>(16, 1.5f), DType::Float32, dev);
+    Tensor out = (LazyTensor(a) * 2.0 + a).eval();
+    EXPECT_EQ(out.device(), dev);
+    EXPECT_FLOAT_EQ(out.data<float>()[15], 4.5f);
+    EXPECT_THROW((LazyTensor(a) + ramp({16}, 1.0f, 0.0f)).eval(), std::runtime_error);
+}
@@ -0,0 +1,102 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include "napcas/cpu.h"
+#include "napcas/tensor.h"
+#include "napcas/kernels/gemm.h"
+
+using namespace napcas;
+
+namespace {
+Tensor random_tensor(const std::vector<std::size_t>& shape, unsigned seed) {
+    std::size_t n = 1;
+    for (auto s : shape) n *= s;
+    std::vector<float> data(n);
+    unsigned x = seed;
+    for (auto& v : data) {
+        x = x * 1664525u + 1013904223u;
+        v = float((x >> 8) % 2001) / 1000.0f - 1.0f;
+    }
+    return Tensor(shape, data);
+}
+
+// Référence row-major lue via les strides
+float ref_at(const Tensor& t, std::size_t i, std::size_t j) {
+    return t.data<float>()[std::ptrdiff_t(i) * t.strides()[0] + std::ptrdiff_t(j) * t.strides()[1]];
+}
+
+void expect_matmul_2d(const Tensor& a, const Tensor& b) {
+    Tensor c = a.matmul(b);
+    const std::size_t m = a.shape()[0], k = a.shape()[1], n = b.shape()[1];
+    ASSERT_EQ(c.shape(), (std::vector<std::size_t>{m, n}));
+    for (std::size_t i = 0; i < m; ++i)
+        for (std::size_t j = 0; j < n; ++j) {
+            double ref = 0.0;
+            for (std::size_t p = 0; p < k; ++p) ref += double(ref_at(a, i, p)) * ref_at(b, p, j);
+            ASSERT_NEAR(c.data<float>()[i * n + j], ref, 1e-3 * (1.0 + std::sqrt(double(k))))
+                << "(" << i << ", " << j << ") m=" << m << " n=" << n << " k=" << k;
+        }
+}
+
+struct RestoreCapability {
+    CpuCapability saved = cpu_capability();
+    ~RestoreCapability() { set_cpu_capability(saved); }
+};
+}
+
+TEST(MatMul, RowMajorNonSymmetric) {
+    Tensor a({2, 3}, std::vector<float>{1, 2, 3, 4, 5, 6});
+    Tensor b({3, 2}, std::vector<float>{7, 8, 9, 10, 11, 12});
+    Tensor c = a.matmul(b);
+    const float expected[] = {58, 64, 139, 154};
+    for (int i = 0; i < 4; ++i) EXPECT_FLOAT_EQ(c.data<float>()[i], expected[i]);
+}
+
+TEST(MatMul, BlockedPathAllKernels) {
+    RestoreCapability restore;
+    const CpuCapability levels[] = {CpuCapability::Scalar, CpuCapability::AVX2, CpuCapability::AVX512};
+    for (CpuCapability level : levels) {
+        if (level > detected_cpu_capability()) continue;
+        set_cpu_capability(level);
+        expect_matmul_2d(random_tensor({67, 300}, 1), random_tensor({300, 45}, 2));
+        expect_matmul_2d(random_tensor({130, 19}, 3), random_tensor({19, 129}, 4));
+    }
+}
+
+TEST(MatMul, TransposedOperandsWithoutCopy) {
+    Tensor a = random_tensor({80, 64}, 5).transpose(0, 1);   // (64, 80)
+    Tensor b = random_tensor({50, 80}, 6).transpose(0, 1);   // (80, 50)
+    expect_matmul_2d(a, b);
+}
+
+TEST(MatMul, BatchedWithBroadcast) {
+    Tensor a = random_tensor({2, 3, 5, 7}, 7);
+    Tensor b = random_tensor({3, 7, 4}, 8);
+    Tensor c = a.matmul(b);
+    ASSERT_EQ(c.shape(), (std::vector<std::size_t>{2, 3, 5, 4}));
+    for (std::size_t x = 0; x < 2; ++x)
+        for (std::size_t y = 0; y < 3; ++y)
+            for (std::size_t i = 0; i < 5; ++i)
+                for (std::size_t j = 0; j < 4; ++j) {
+                    float ref = 0.0f;
+                    for (std::size_t p = 0; p < 7; ++p)
+                        ref += a.data<float>()[((x * 3 + y) * 5 + i) * 7 + p] *
+                               b.data<float>()[(y * 7 + p) * 4 + j];
+                    ASSERT_NEAR(c.data<float>()[((x * 3 + y) * 5 + i) * 4 + j], ref, 1e-4);
+                }
+}
+
+TEST(MatMul, VectorOperands) {
+    Tensor v({3}, std::vector<float>{1, 2, 3});
+    Tensor m({3, 2}, std::vector<float>{1, 0, 0, 1, 1, 1});
+    Tensor vm = v.matmul(m);
+    ASSERT_EQ(vm.shape(), (std::vector<std::size_t>{2}));
+    EXPECT_FLOAT_EQ(vm.data<float>()[0], 4.0f);
+    EXPECT_FLOAT_EQ(vm.data<float>()[1], 5.0f);
+    Tensor dot = v.matmul(v);
+    EXPECT_TRUE(dot.shape().empty());
+    EXPECT_FLOAT_EQ(dot.data<float>()[0], 14.0f);
+}
+
+TEST(MatMul, ShapeMismatchThrows) {
+    EXPECT_THROW(Tensor::ones({2, 3}).matmul(Tensor::ones({4, 2})), std::runtime_error);
+}
@@ -0,0 +1,246 @@
+#include <gtest/gtest.h>
+#include "napcas/optim.h"
+#include "napcas/architecture/linear.h"
+#include "napcas/cpu.h"
+#include "napcas/kernels/optim.h"
+#include "napcas/tensor.h"
+#include <cmath>
+#include <random>
+
+using namespace napcas;
+using architecture::Linear;
+
+namespace {
+struct RestoreCapability {
+    CpuCapability saved = cpu_capability();
+    ~RestoreCapability() { set_cpu_capability(saved); }
+};
+
+std::vector<double> random_values(std::size_t n, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> u(-1.0, 1.0);
+    std::vector<double> v(n);
+    for (auto& e : v) e = u(rng);
+    return v;
+}
+
+Tensor parameter(const Shape& shape, unsigned seed) {
+    std::size_t n = 1;
+    for (auto s : shape) n *= s;
+    Tensor p(shape, random_values(n, seed), DType::Float32);
+    p.requires_grad_(true);
+    return p;
+}
+
+std::vector<double> values(const Tensor& t) {
+    Tensor c = t.astype(DType::Float64).contiguous();
+    return std::vector<double>(c.data<double>(), c.data<double>() + c.numel());
+}
+
+void expect_near(const Tensor& t, const std::vector<double>& ref, double tol) {
+    const auto v = values(t);
+    ASSERT_EQ(v.size(), ref.size());
+    for (std::size_t i = 0; i < v.size(); ++i) EXPECT_NEAR(v[i], ref[i], tol) << i;
+}
+
+// Tailles : sous un vecteur, fin de vecteur, plusieurs blocs de kChunk
+const std::vector<Shape> kShapes = {{3}, {7, 5}, {2 * optim::Optimizer::kChunk + 37}};
+
+std::vector<CpuCapability> capabilities() {
+    std::vector<CpuCapability> caps = {CpuCapability::Scalar};
+    if (detected_cpu_capability() >= CpuCapability::AVX2)   caps.push_back(CpuCapability::AVX2);
+    if (detected_cpu_capability() >= CpuCapability::AVX512) caps.push_back(CpuCapability::AVX512);
+    return caps;
+}
+}
+
+TEST(Optim, SgdMatchesReference) {
+    RestoreCapability restore;
+    for (CpuCapability cap : capabilities()) {
+        set_cpu_capability(cap);
+        for (bool nesterov : {false, true}) {
+            std::vector<Tensor> params;
+            for (std::size_t i = 0; i < kShapes.size(); ++i) params.push_back(parameter(kShapes[i], i));
+            std::vector<std::vector<double>> p, buf;
+            for (auto& t : params) {
+                p.push_back(values(t));
+                buf.emplace_back(t.numel(), 0.0);
+            }
+            const double lr = 0.1, mu = 0.9, wd = 0.01;
+            optim::SGD opt(params, float(lr), float(mu), float(wd), nesterov);
+            for (unsigned step = 0; step < 3; ++step) {
+                for (std::size_t i = 0; i < params.size(); ++i) {
+                    const auto g = random_values(params[i].numel(), 100 + step * 10 + i);
+                    params[i].grad() = Tensor(params[i].shape(), g, DType::Float32);
+                    for (std::size_t j = 0; j < g.size(); ++j) {
+                        const double gj = g[j] + wd * p[i][j];
+                        buf[i][j] = mu * buf[i][j] + gj;
+                        p[i][j] -= lr * (nesterov ? gj + mu * buf[i][j] : buf[i][j]);
+                    }
+                }
+                EXPECT_EQ(opt.step(), 0.0);
+            }
+            for (std::size_t i = 0; i < params.size(); ++i) {
+                expect_near(params[i], p[i], 1e-5);
+                expect_near(opt.momentum_buffer(i), buf[i], 1e-5);
+            }
+        }
+    }
+}
+
+TEST(Optim, AdamAndAdamWMatchReference) {
+    RestoreCapability restore;
+    for (CpuCapability cap : capabilities()) {
+        set_cpu_capability(cap);
+        for (bool decoupled : {false, true}) {
+            std::vector<Tensor> params;
+            for (std::size_t i = 0; i < kShapes.size(); ++i) params.push_back(parameter(kShapes[i], i));
+            std::vector<std::vector<double>> p, m, v;
+            for (auto& t : params) {
+                p.push_back(values(t));
+                m.emplace_back(t.numel(), 0.0);
+                v.emplace_back(t.numel(), 0.0);
+            }
+            const double lr = 0.01, b1 = 0.9, b2 = 0.999, eps = 1e-8, wd = 0.1;
+            std::unique_ptr<optim::Adam> opt;
+            if (decoupled) opt = std::make_unique<optim::AdamW>(params, lr, b1, b2, eps, wd);
+            else           opt = std::make_unique<optim::Adam>(params, lr, b1, b2, eps, wd);
+            for (int t = 1; t <= 3; ++t) {
+                for (std::size_t i = 0; i < params.size(); ++i) {
+                    const auto g = random_values(params[i].numel(), 200 + t * 10 + i);
+                    params[i].grad() = Tensor(params[i].shape(), g, DType::Float32);
+                    for (std::size_t j = 0; j < g.size(); ++j) {
+                        const double gj = g[j] + (decoupled ? 0.0 : wd * p[i][j]);
+                        if (decoupled) p[i][j] *= 1.0 - lr * wd;
+                        m[i][j] = b1 * m[i][j] + (1 - b1) * gj;
+                        v[i][j] = b2 * v[i][j] + (1 - b2) * gj * gj;
+                        const double mh = m[i][j] / (1 - std::pow(b1, t));
+                        const double vh = v[i][j] / (1 - std::pow(b2, t));
+                        p[i][j] -= lr * mh / (std::sqrt(vh) + eps);
+                    }
+                }
+                opt->step();
+            }
+            EXPECT_EQ(opt->steps(), 3u);
+            for (std::size_t i = 0; i < params.size(); ++i) {
+                expect_near(params[i], p[i], 1e-5);
+                expect_near(opt->exp_avg(i), m[i], 1e-5);
+                expect_near(opt->exp_avg_sq(i), v[i], 1e-5);
+                EXPECT_EQ(opt->exp_avg(i).shape(), params[i].shape());
+            }
+        }
+    }
+}
+
+TEST(Optim, GlobalNormClippingScalesTheUpdate) {
+    std::vector<Tensor> params = {parameter({4, 4}, 1), parameter({kShapes[2]}, 2)};
+    double sq = 0.0;
+    std::vector<std::vector<double>> p, g;
+    for (std::size_t i = 0; i < params.size(); ++i) {
+        g.push_back(random_values(params[i].numel(), 10 + i));
+        for (double x : g.back()) sq += x * x;
+        params[i].grad() = Tensor(params[i].shape(), g.back(), DType::Float32);
+        p.push_back(values(params[i]));
+    }
+    const double norm = std::sqrt(sq), max_norm = 1.0, lr = 0.5;
+    optim::SGD opt(params, float(lr), 0.0f, 0.0f, false, float(max_norm));
+    EXPECT_NEAR(opt.step(), norm, 1e-6 * norm);
+    const double scale = max_norm / (norm + 1e-6);
+    for (std::size_t i = 0; i < params.size(); ++i) {
+        for (std::size_t j = 0; j < p[i].size(); ++j) p[i][j] -= lr * scale * g[i][j];
+        expect_near(params[i], p[i], 1e-6);
+        expect_near(params[i].grad(), g[i], 1e-6);   // gradients non réécrits
+    }
+
+    // Sous la borne : pas d'écrêtage
+    opt.set_max_grad_norm(float(10 * norm));
+    for (std::size_t i = 0; i < params.size(); ++i)
+        for (std::size_t j = 0; j < p[i].size(); ++j) p[i][j] -= lr * g[i][j];
+    EXPECT_NEAR(opt.step(), norm, 1e-6 * norm);
+    for (std::size_t i = 0; i < params.size(); ++i) expect_near(params[i], p[i], 1e-5);
+}
+
+TEST(Optim, ZeroGradKeepsBuffersAndBackwardAccumulatesInPlace) {
+    Linear fc(8, 4);
+    optim::SGD opt(fc.parameters(), 0.1f);
+    Tensor x(Shape{2, 8}, random_values(16, 1), DType::Float32);
+    fc(x).sum().backward();
+    const void* w_grad = fc.weight().grad().data_ptr();
+
+    opt.zero_grad();
+    ASSERT_TRUE(fc.weight().has_grad());
+    EXPECT_EQ(fc.weight().grad().data_ptr(), w_grad);
+    for (double e : values(fc.weight().grad())) EXPECT_EQ(e, 0.0);
+
+    fc(x).sum().backward();
+    EXPECT_EQ(fc.weight().grad().data_ptr(), w_grad);
+    const auto g = values(fc.weight().grad());
+    // d(sum(x Wᵀ + b)) / dW[n, k] = Σ_i x[i, k]
+    const auto xv = values(x);
+    for (std::size_t n = 0; n < 4; ++n)
+        for (std::size_t k = 0; k < 8; ++k) EXPECT_NEAR(g[n * 8 + k], xv[k] + xv[8 + k], 1e-5);
+}
+
+TEST(Optim, SkipsParametersWithoutGradient) {
+    Tensor a = parameter({5}, 1), b = parameter({5}, 2);
+    const auto b0 = values(b);
+    a.grad() = Tensor::ones({5});
+    const std::uint64_t va = a.storage()->version(), vb = b.storage()->version();
+    optim::Adam opt({a, b}, 0.1f);
+    opt.step();
+    expect_near(b, b0, 0.0);
+    EXPECT_GT(a.storage()->version(), va);
+    EXPECT_EQ(b.storage()->version(), vb);
+    for (double e : values(opt.exp_avg(1))) EXPECT_EQ(e, 0.0);
+    EXPECT_EQ(opt.state_bytes(), 2 * 2 * 16 * sizeof(float));   // tranches alignées
+}
+
+TEST(Optim, TrainsALinearRegression) {
+    Linear fc(4, 1);
+    optim::AdamW opt(fc.parameters(), 0.05f, 0.9f, 0.999f, 1e-8f, 0.0f, 1.0f);
+    const auto xv = random_values(64 * 4, 3);
+    std::vector<double> yv(64);
+    for (std::size_t i = 0; i < 64; ++i)
+        yv[i] = 2 * xv[i * 4] - xv[i * 4 + 1] + 0.5 * xv[i * 4 + 3] + 1;
+    Tensor x(Shape{64, 4}, xv, DType::Float32), y(Shape{64, 1}, yv, DType::Float32);
+    auto loss = [&] {
+        Tensor d = fc(x) - y;
+        return (d * d).mean();
+    };
+    const double first = values(loss())[0];
+    for (int it = 0; it < 300; ++it) {
+        opt.zero_grad();
+        loss().backward();
+        opt.step();
+    }
+    EXPECT_LT(values(loss())[0], first * 1e-3);
+}
+
+TEST(Optim, RejectsInvalidArguments) {
+    Tensor p = parameter({4}, 1);
+    EXPECT_THROW(optim::SGD({}, 0.1f), std::runtime_error);
+    EXPECT_THROW(optim::SGD({p}, -1.0f), std::runtime_error);
+    EXPECT_THROW(optim::SGD({p}, 0.1f, 0.0f, 0.0f, true), std::runtime_error);
+    EXPECT_THROW(optim::Adam({p}, 0.1f, 1.0f), std::runtime_error);
+    EXPECT_THROW(optim::Adam({Tensor(Shape{4}, DType::Float64)}), std::runtime_error);
+    EXPECT_THROW(optim::Adam({parameter({4, 4}, 2).transpose(0, 1)}), std::runtime_error);
+    optim::SGD sgd({p}, 0.1f);
+    EXPECT_THROW(sgd.momentum_buffer(0), std::runtime_error);
+    EXPECT_THROW(sgd.set_max_grad_norm(-1.0f), std::runtime_error);
+    p.grad() = Tensor::ones({2, 2});
+    EXPECT_THROW(sgd.step(), std::runtime_error);
+}
+
+TEST(OptimKernels, SumSquaresMatchesAcrossIsas) {
+    RestoreCapability restore;
+    const auto v = random_values(1000, 4);
+    std::vector<float> x(v.begin(), v.end());
+    for (CpuCapability cap : capabilities()) {
+        set_cpu_capability(cap);
+        for (std::size_t n : {0, 1, 15, 16, 33, 1000}) {
+            double r = 0.0;
+            for (std::size_t i = 0; i < n; ++i) r += double(x[i]) * x[i];
+            EXPECT_NEAR(kernels::sum_squares(x.data(), n), r, 1e-4) << n;
+        }
+    }
+}
@@ -0,0 +1,85 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <thread>
+#include "napcas/parallel.h"
+#include "napcas/tensor.h"
+
+using namespace napcas;
+
+class ParallelTest : public ::testing::Test {
+protected:
+    void SetUp() override    { saved_ = get_num_threads(); set_num_threads(4); }
+    void TearDown() override { set_num_threads(saved_); }
+    std::size_t saved_ = 1;
+};
+
+TEST_F(ParallelTest, CoversRangeExactlyOnce) {
+    std::vector<std::atomic<int>> hits(100000);
+    parallel_for(0, hits.size(), 1000, [&](std::size_t b, std::size_t e) {
+        for (std::size_t i = b; i < e; ++i) hits[i].fetch_add(1);
+    });
+    for (auto& h : hits) ASSERT_EQ(h.load(), 1);
+}
+
+TEST_F(ParallelTest, SmallRangesRunSerially) {
+    int calls = 0;
+    parallel_for(0, 10, grain_size(10, sizeof(float)),
+                 [&](std::size_t b, std::size_t e) { ++calls; EXPECT_EQ(e - b, 10u); });
+    EXPECT_EQ(calls, 1);
+}
+
+TEST_F(ParallelTest, NestedRegionsAreSerial) {
+    std::atomic<int> nested_parallel{0};
+    parallel_for(0, 64, 1, [&](std::size_t, std::size_t) {
+        EXPECT_TRUE(in_parallel_region());
+        parallel_for(0, 1000, 1, [&](std::size_t b, std::size_t e) {
+            if (b != 0 || e != 1000) nested_parallel.fetch_add(1);
+        });
+    });
+    EXPECT_EQ(nested_parallel.load(), 0);
+    EXPECT_FALSE(in_parallel_region());
+}
+
+TEST_F(ParallelTest, PropagatesExceptions) {
+    EXPECT_THROW(
+        parallel_for(0, 1000, 10, [](std::size_t b, std::size_t) {
+            if (b >= 500) throw std::runtime_error("boom");
+        }),
+        std::runtime_error);
+}
+
+TEST_F(ParallelTest, LargeElementwiseAndFill) {
+    const std::size_t n = 1 << 20;
+    Tensor a = Tensor::ones({n});
+    Tensor b = Tensor::ones({n});
+    Tensor c = a + b;
+    for (std::size_t i = 0; i < n; i += 4099) ASSERT_FLOAT_EQ(c.data<float>()[i], 2.0f);
+    ASSERT_FLOAT_EQ(c.data<float>()[n - 1], 2.0f);
+    Tensor z = Tensor::zeros({n});
+    ASSERT_FLOAT_EQ(z.data<float>()[n / 2], 0.0f);
+    Tensor k = c.clone();
+    ASSERT_FLOAT_EQ(k.data<float>()[n - 1], 2.0f);
+}
+
+TEST_F(ParallelTest, ResizeChangesThreadCount) {
+    set_num_threads(2);
+    EXPECT_EQ(get_num_threads(), 2u);
+    set_num_threads(1);
+    EXPECT_EQ(get_num_threads(), 1u);
+}
+
+TEST_F(ParallelTest, ThreadCountIsReadableDuringResize) {
+    // grain_size() lit le nombre de threads sans pool_mutex à chaque
+    // parallel_for : la lecture doit rester sûre pendant set_num_threads
+    std::atomic<bool> stop{false};
+    std::thread reader([&] {
+        while (!stop.load()) {
+            const std::size_t n = get_num_threads();
+            EXPECT_TRUE(n == 2 || n == 3 || n == 4) << n;
+            EXPECT_GE(grain_size(1 << 20, 4), 1u);
+        }
+    });
+    for (int i = 0; i < 50; ++i) set_num_threads(2 + std::size_t(i % 2));
+    stop = true;
+    reader.join();
+}
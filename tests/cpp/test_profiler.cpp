@@ -0,0 +1,227 @@
+#include <gtest/gtest.h>
+#include "napcas/profiler.h"
+#include "napcas/architecture/linear.h"
+#include "napcas/graph.h"
+#include "napcas/tensor.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <random>
+#include <set>
+#include <thread>
+
+using namespace napcas;
+using architecture::Linear;
+using profiler::Event;
+using profiler::EventKind;
+
+namespace {
+Tensor random(const std::vector<std::size_t>& shape, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> u(-1.0, 1.0);
+    std::size_t n = 1;
+    for (auto s : shape) n *= s;
+    std::vector<double> v(n);
+    for (auto& e : v) e = u(rng);
+    return Tensor(shape, v, DType::Float32);
+}
+
+// Enregistre les événements de `fn` seuls
+template <class F>
+std::vector<Event> profile(F&& fn) {
+    profiler::clear();
+    profiler::start();
+    fn();
+    profiler::stop();
+    std::vector<Event> events = profiler::events();
+    profiler::clear();
+    return events;
+}
+
+std::vector<Event> named(const std::vector<Event>& events, const std::string& name) {
+    std::vector<Event> out;
+    std::copy_if(events.begin(), events.end(), std::back_inserter(out),
+                 [&](const Event& e) { return e.name == name; });
+    return out;
+}
+}
+
+TEST(Profiler, DisabledRecordsNothing) {
+    profiler::clear();
+    EXPECT_FALSE(profiler::enabled());
+    Tensor a = random({8, 8}, 1);
+    Tensor b = a.matmul(a) + a;
+    EXPECT_TRUE(profiler::events().empty());
+    profiler::RecordScope scope("unused");
+    EXPECT_FALSE(scope.active());
+}
+
+TEST(Profiler, MatmulShapesBytesAndFlops) {
+    Tensor a = random({4, 8}, 1), b = random({8, 16}, 2);
+    auto events = profile([&] { a.matmul(b); });
+    auto mm = named(events, "matmul");
+    ASSERT_EQ(mm.size(), 1u);
+    const Event& e = mm[0];
+    EXPECT_EQ(e.kind, EventKind::Op);
+    ASSERT_EQ(e.input_shapes.size(), 2u);
+    EXPECT_EQ(e.input_shapes[0], (Shape{4, 8}));
+    EXPECT_EQ(e.input_shapes[1], (Shape{8, 16}));
+    EXPECT_EQ(e.bytes_read, (4 * 8 + 8 * 16) * sizeof(float));
+    EXPECT_EQ(e.bytes_written, 4 * 16 * sizeof(float));
+    EXPECT_DOUBLE_EQ(e.flops, 2.0 * 4 * 16 * 8);
+    EXPECT_GE(e.duration_ns, e.self_ns);
+    EXPECT_GE(e.self_ns, 0);
+}
+
+TEST(Profiler, AllocationsNestUnderTheirOp) {
+    Tensor a = random({64, 64}, 1);
+    auto events = profile([&] { a.matmul(a); });
+    auto mm = named(events, "matmul");
+    auto allocs = named(events, "cpu_malloc");
+    ASSERT_EQ(mm.size(), 1u);
+    ASSERT_FALSE(allocs.empty());
+    bool nested = false;
+    for (const Event& e : allocs) {
+        EXPECT_EQ(e.kind, EventKind::Alloc);
+        EXPECT_GT(e.bytes_written, 0u);
+        EXPECT_GE(e.bytes_in_use, e.bytes_written);
+        if (e.depth == mm[0].depth + 1 && e.start_ns >= mm[0].start_ns &&
+            e.start_ns + e.duration_ns <= mm[0].start_ns + mm[0].duration_ns)
+            nested = true;
+    }
+    EXPECT_TRUE(nested);
+    EXPECT_LE(mm[0].self_ns, mm[0].duration_ns);
+}
+
+TEST(Profiler, ModuleContainsItsOps) {
+    Linear fc(16, 8);
+    Tensor x = random({4, 16}, 3);
+    auto events = profile([&] { fc(x); });
+    auto mod = named(events, "Linear");
+    auto op = named(events, "linear");
+    ASSERT_EQ(mod.size(), 1u);
+    ASSERT_EQ(op.size(), 1u);
+    EXPECT_EQ(mod[0].kind, EventKind::Module);
+    EXPECT_EQ(op[0].depth, mod[0].depth + 1);
+    EXPECT_GE(op[0].start_ns, mod[0].start_ns);
+    EXPECT_LE(mod[0].self_ns, mod[0].duration_ns - op[0].duration_ns);
+    EXPECT_DOUBLE_EQ(op[0].flops, 2.0 * 4 * 8 * 16);
+}
+
+TEST(Profiler, BackwardEvents) {
+    Tensor a = random({4, 8}, 1), b = random({8, 2}, 2);
+    a.requires_grad_(true);
+    b.requires_grad_(true);
+    Tensor loss = a.matmul(b).sum();
+    auto events = profile([&] { loss.backward(); });
+    auto mm = named(events, "MatMulBackward");
+    ASSERT_EQ(mm.size(), 1u);
+    EXPECT_EQ(mm[0].kind, EventKind::Backward);
+    ASSERT_EQ(mm[0].input_shapes.size(), 1u);
+    EXPECT_EQ(mm[0].input_shapes[0], (Shape{4, 2}));
+    EXPECT_EQ(mm[0].bytes_written, (4 * 8 + 8 * 2) * sizeof(float));
+}
+
+TEST(Profiler, SummaryAndTable) {
+    Tensor a = random({32, 32}, 1);
+    auto events = profile([&] {
+        for (int i = 0; i < 3; ++i) a.matmul(a).relu();
+    });
+    auto stats = profiler::summarize(events);
+    ASSERT_FALSE(stats.empty());
+    for (std::size_t i = 1; i < stats.size(); ++i) EXPECT_GE(stats[i - 1].self_ns, stats[i].self_ns);
+    auto mm = std::find_if(stats.begin(), stats.end(),
+                           [](const profiler::OpStats& s) { return s.name == "matmul"; });
+    ASSERT_NE(mm, stats.end());
+    EXPECT_EQ(mm->count, 3u);
+    EXPECT_DOUBLE_EQ(mm->flops, 3 * 2.0 * 32 * 32 * 32);
+    EXPECT_GE(mm->total_ns, mm->max_ns);
+
+    const std::string table = profiler::format_table(stats);
+    EXPECT_NE(table.find("matmul"), std::string::npos);
+    EXPECT_NE(table.find("GFLOP/s"), std::string::npos);
+    const std::string top = profiler::format_table(stats, 1);
+    EXPECT_EQ(std::count(top.begin(), top.end(), '\n'), 3);
+}
+
+TEST(Profiler, ChromeTrace) {
+    Tensor a = random({8, 8}, 1);
+    auto events = profile([&] { a.matmul(a); });
+    const std::string json = profiler::chrome_trace(events);
+    EXPECT_EQ(json.rfind("{\"displayTimeUnit\":\"ns\",\"traceEvents\":[", 0), 0u);
+    EXPECT_NE(json.find("\"name\":\"matmul\",\"cat\":\"op\",\"ph\":\"X\""), std::string::npos);
+    EXPECT_NE(json.find("\"input_shapes\":\"[[8, 8], [8, 8]]\""), std::string::npos);
+    EXPECT_NE(json.find("\"name\":\"bytes_in_use\",\"ph\":\"C\""), std::string::npos);
+
+    const std::string path = ::testing::TempDir() + "napcas_trace.json";
+    profiler::export_chrome_trace(events, path);
+    std::ifstream f(path);
+    const std::string written((std::istreambuf_iterator<char>(f)), std::istreambuf_iterator<char>());
+    EXPECT_EQ(written, json);
+    std::remove(path.c_str());
+    EXPECT_THROW(profiler::export_chrome_trace(events, "/nonexistent/dir/trace.json"),
+                 std::runtime_error);
+}
+
+TEST(Profiler, GraphReplayRecordsSteps) {
+    Linear fc(16, 8);
+    Graph g = Graph::capture(fc, random({4, 16}, 1));
+    Tensor x = random({4, 16}, 2);
+    auto events = profile([&] { g.replay({x}); });
+    auto op = named(events, "linear");
+    ASSERT_EQ(op.size(), 1u);
+    ASSERT_EQ(op[0].input_shapes.size(), 3u);
+    EXPECT_EQ(op[0].input_shapes[0], (Shape{4, 16}));
+    EXPECT_EQ(op[0].bytes_written, 4 * 8 * sizeof(float));
+}
+
+TEST(Profiler, ThreadsAreDistinguished) {
+    auto events = profile([] {
+        auto work = [](unsigned seed) {
+            Tensor a = random({16, 16}, seed);
+            a.matmul(a);
+        };
+        std::thread t1(work, 1), t2(work, 2);
+        t1.join();
+        t2.join();
+    });
+    std::set<std::uint32_t> threads;
+    for (const Event& e : named(events, "matmul")) {
+        threads.insert(e.thread);
+        EXPECT_EQ(e.depth, 0u);
+    }
+    EXPECT_EQ(threads.size(), 2u);
+}
+
+TEST(Profiler, ClearKeepsOpenScopesConsistent) {
+    using namespace std::chrono_literals;
+    profiler::clear();
+    profiler::start();
+    {
+        profiler::RecordScope scope("open");
+        std::this_thread::sleep_for(2ms);
+        profiler::clear();   // pendant l'enregistrement, portée ouverte
+        std::this_thread::sleep_for(1ms);
+    }
+    auto open = named(profiler::events(), "open");
+    ASSERT_EQ(open.size(), 1u);
+    EXPECT_GE(open[0].start_ns, 0);
+    EXPECT_GE(open[0].duration_ns, 3'000'000);
+    EXPECT_EQ(open[0].self_ns, open[0].duration_ns);
+
+    {   // arrêt, clear() puis nouvelle origine pendant une portée ouverte
+        profiler::RecordScope scope("restarted");
+        profiler::stop();
+        profiler::clear();
+        std::this_thread::sleep_for(1ms);
+        profiler::start();
+    }
+    profiler::stop();
+    auto restarted = named(profiler::events(), "restarted");
+    profiler::clear();
+    ASSERT_EQ(restarted.size(), 1u);
+    EXPECT_LT(restarted[0].start_ns, 0);   // commencée avant la nouvelle origine
+    EXPECT_GE(restarted[0].duration_ns, 1'000'000);
+}
@@ -0,0 +1,232 @@
+#include <gtest/gtest.h>
+#include "napcas/tensor.h"
+#include "napcas/parallel.h"
+#include <cmath>
+#include <limits>
+#include <random>
+
+using namespace napcas;
+
+namespace {
+void expect_values(const Tensor& t, const std::vector<double>& v, double tol = 1e-5) {
+    ASSERT_EQ(t.numel(), v.size());
+    Tensor c = t.astype(DType::Float64).contiguous();
+    for (std::size_t i = 0; i < v.size(); ++i)
+        EXPECT_NEAR(c.data<double>()[i], v[i], tol) << i;
+}
+
+void expect_indices(const Tensor& t, const std::vector<std::int64_t>& v) {
+    ASSERT_EQ(t.dtype(), DType::Int64);
+    ASSERT_EQ(t.numel(), v.size());
+    for (std::size_t i = 0; i < v.size(); ++i)
+        EXPECT_EQ(t.data<std::int64_t>()[i], v[i]) << i;
+}
+
+Tensor iota(const std::vector<std::size_t>& shape, DType dtype = DType::Float32) {
+    std::size_t n = 1;
+    for (auto s : shape) n *= s;
+    std::vector<double> v(n);
+    for (std::size_t i = 0; i < n; ++i) v[i] = double(i);
+    return Tensor(shape, v, dtype);
+}
+
+// Réduction naïve en double de `t` (3D) sur l'axe `dim`
+std::vector<double> naive(const Tensor& t, int dim, int kind) {
+    Tensor c = t.astype(DType::Float64).contiguous();
+    const auto& s = t.shape();
+    std::vector<double> out;
+    const std::size_t a = dim == 0 ? s[1] : s[0];
+    const std::size_t b = dim == 2 ? s[1] : s[2];
+    for (std::size_t i = 0; i < a; ++i)
+        for (std::size_t j = 0; j < b; ++j) {
+            double acc = kind == 0 ? 0.0 : -std::numeric_limits<double>::infinity();
+            for (std::size_t r = 0; r < s[dim]; ++r) {
+                std::size_t idx[3];
+                idx[dim] = r;
+                idx[dim == 0 ? 1 : 0] = i;
+                idx[dim == 2 ? 1 : 2] = j;
+                const double v = c.data<double>()[(idx[0] * s[1] + idx[1]) * s[2] + idx[2]];
+                acc = kind == 0 ? acc + v : std::max(acc, v);
+            }
+            out.push_back(acc);
+        }
+    return out;
+}
+}
+
+TEST(Reduce, SumAndMeanOverAxes) {
+    Tensor x = iota({2, 3, 4});
+    expect_values(x.sum(), {276.0});
+    EXPECT_EQ(x.sum().ndim(), 0u);
+    expect_values(x.sum({1}), {12, 15, 18, 21, 48, 51, 54, 57});
+    expect_values(x.sum({0, 2}), {60, 92, 124});
+    expect_values(x.mean({-1}), {1.5, 5.5, 9.5, 13.5, 17.5, 21.5});
+    EXPECT_EQ(x.sum({1}, true).shape(), (std::vector<std::size_t>{2, 1, 4}));
+    EXPECT_EQ(x.mean({0, 2}, true).shape(), (std::vector<std::size_t>{1, 3, 1}));
+    EXPECT_THROW(x.sum({3}), std::runtime_error);
+    EXPECT_THROW(x.sum({1, -2}), std::runtime_error);
+}
+
+// Toutes les géométries : axe réduit contigu, axe conservé contigu, vues
+// transposées ; comparées à une réduction naïve
+TEST(Reduce, MatchesNaiveOnStridedViews) {
+    std::mt19937 rng(3);
+    std::uniform_real_distribution<float> u(-1.0f, 1.0f);
+    std::vector<float> v(7 * 33 * 300);
+    for (auto& e : v) e = u(rng);
+    Tensor base({7, 33, 300}, v);
+    for (const Tensor& x : {base, base.permute({2, 0, 1}), base.transpose(0, 2)}) {
+        for (int d = 0; d < 3; ++d) {
+            expect_values(x.sum({d}), naive(x, d, 0), 1e-3);
+            expect_values(x.max({d}), naive(x, d, 1));
+        }
+    }
+}
+
+TEST(Reduce, PairwiseSumIsAccurate) {
+    // 2^24 + 1 n'est pas représentable : une somme séquentielle en float32
+    // s'arrête à 16777216
+    const std::size_t n = (1u << 24) + 4096;
+    Tensor x = Tensor::ones({n});
+    EXPECT_EQ(x.sum().data<float>()[0], float(n));
+    Tensor y = Tensor::ones({n, 2}).sum({0});
+    expect_values(y, {double(n), double(n)});
+}
+
+TEST(Reduce, ParallelSplitIsDeterministic) {
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<float> u(0.0f, 1.0f);
+    std::vector<float> v(1 << 20);
+    for (auto& e : v) e = u(rng);
+    Tensor x({v.size()}, v);
+    const std::size_t threads = get_num_threads();
+    set_num_threads(1);
+    const float serial = x.sum().data<float>()[0];
+    set_num_threads(4);
+    const float parallel = x.sum().data<float>()[0];
+    const float again    = x.sum().data<float>()[0];
+    set_num_threads(threads);
+    EXPECT_NEAR(parallel, serial, 1e-2f);
+    EXPECT_EQ(parallel, again);
+}
+
+TEST(Reduce, MaxMinArgmax) {
+    Tensor x({2, 3}, std::vector<float>{3, 7, 7, -1, 0, -5});
+    expect_values(x.max({1}), {7, 0});
+    expect_values(x.min({1}), {3, -5});
+    expect_values(x.max(), {7});
+    expect_indices(x.argmax({1}), {1, 1});   // première occurrence
+    expect_indices(x.argmin({1}), {0, 2});
+    expect_indices(x.argmax(), {1});
+    expect_indices(x.argmin({0}), {1, 1, 1});
+    EXPECT_EQ(x.argmax({1}, true).shape(), (std::vector<std::size_t>{2, 1}));
+
+    Tensor i({4}, std::vector<int>{4, -9, 12, 3}, DType::Int32);
+    EXPECT_EQ(i.max().data<std::int32_t>()[0], 12);
+    expect_indices(i.argmin(), {1});
+    EXPECT_THROW(Tensor::zeros({0, 3}).max({0}), std::runtime_error);
+
+    // Réduction découpée entre threads : la première occurrence reste retenue
+    std::vector<float> v(1 << 20, 0.0f);
+    v[777777] = 5.0f;
+    v[900000] = 5.0f;
+    expect_indices(Tensor({v.size()}, v).argmax(), {777777});
+}
+
+TEST(Reduce, NaNPropagates) {
+    const float nan = std::numeric_limits<float>::quiet_NaN();
+    Tensor x({5}, std::vector<float>{1, nan, 3, nan, -2});
+    EXPECT_TRUE(std::isnan(x.max().data<float>()[0]));
+    EXPECT_TRUE(std::isnan(x.min().data<float>()[0]));
+    EXPECT_TRUE(std::isnan(x.sum().data<float>()[0]));
+    expect_indices(x.argmax(), {1});
+}
+
+TEST(Reduce, VarAndStd) {
+    Tensor x({2, 4}, std::vector<float>{1, 2, 3, 4, 2, 4, 6, 8});
+    expect_values(x.var({1}), {5.0 / 3.0, 20.0 / 3.0});
+    expect_values(x.var({1}, 0), {1.25, 5.0});
+    expect_values(x.std({1}), {std::sqrt(5.0 / 3.0), std::sqrt(20.0 / 3.0)});
+    expect_values(x.var({0}, 0), {0.25, 1.0, 2.25, 4.0});
+    EXPECT_TRUE(std::isnan(Tensor::ones({1}).var().data<float>()[0]));
+    EXPECT_THROW(iota({3}, DType::Int32).var(), std::runtime_error);
+
+    // Grand décalage : l'algorithme en deux passes reste exact
+    std::vector<float> v(10000);
+    for (std::size_t k = 0; k < v.size(); ++k) v[k] = 1e4f + float(k % 2);
+    expect_values(Tensor({v.size()}, v).var({}, 0), {0.25}, 1e-6);
+}
+
+TEST(Reduce, LogSumExpIsStable) {
+    Tensor x({2, 3}, std::vector<float>{1000, 1000, 1000, -1, 0, 1});
+    const double l = std::log(std::exp(-1.0) + 1.0 + std::exp(1.0));
+    expect_values(x.logsumexp({1}), {1000 + std::log(3.0), l}, 1e-3);
+    const float inf = std::numeric_limits<float>::infinity();
+    Tensor y({3}, std::vector<float>{-inf, -inf, -inf});
+    EXPECT_EQ(y.logsumexp().data<float>()[0], -inf);
+    Tensor z({2}, std::vector<float>{inf, 0});
+    EXPECT_EQ(z.logsumexp().data<float>()[0], inf);
+}
+
+TEST(Reduce, HalfPrecisionAccumulatesInFloat) {
+    Tensor x = Tensor::ones({4096}, DType::Float16);
+    Tensor s = x.sum();
+    EXPECT_EQ(s.dtype(), DType::Float16);
+    expect_values(s, {4096.0});
+    expect_values(Tensor::ones({3000}, DType::BFloat16).mean(), {1.0});
+}
+
+TEST(Reduce, IntegerSumIsInt64) {
+    // 200 × 100 ne tient pas dans un int8 (32 après débordement)
+    Tensor i8 = Tensor({200}, std::vector<int>(200, 100), DType::Int8);
+    expect_indices(i8.sum(), {20000});
+    Tensor u8 = Tensor({2, 300}, std::vector<int>(600, 255), DType::UInt8);
+    expect_indices(u8.sum({1}), {76500, 76500});
+    Tensor i32 = Tensor({4}, std::vector<double>{2e9, 2e9, -1, 1}, DType::Int32);
+    expect_indices(i32.sum(), {4000000000});
+    expect_indices(i32.transpose(0, 0).sum({0}, true), {4000000000});
+    EXPECT_EQ(Tensor::ones({3}, DType::Int64).sum().dtype(), DType::Int64);
+    // Flottants et max gardent le type d'entrée
+    EXPECT_EQ(Tensor::ones({3}, DType::Float16).sum().dtype(), DType::Float16);
+    EXPECT_EQ(i8.max().dtype(), DType::Int8);
+}
+
+TEST(Reduce, Backward) {
+    Tensor x({2, 3}, std::vector<float>{1, 5, 2, 4, 0, 6});
+    x.requires_grad_(true);
+
+    x.sum({1}).backward();
+    expect_values(x.grad(), {1, 1, 1, 1, 1, 1});
+    x.zero_grad();
+
+    x.mean().backward();
+    expect_values(x.grad(), std::vector<double>(6, 1.0 / 6.0));
+    x.zero_grad();
+
+    x.max({1}, true).backward();
+    expect_values(x.grad(), {0, 1, 0, 0, 0, 1});
+    x.zero_grad();
+
+    x.min({0}).backward();
+    expect_values(x.grad(), {1, 0, 1, 0, 1, 0});
+    x.zero_grad();
+
+    // d var / dx = 2 (x - moyenne) / (N - 1)
+    x.var({1}).backward();
+    expect_values(x.grad(), {-5.0 / 3, 7.0 / 3, -2.0 / 3, 2.0 / 3, -10.0 / 3, 8.0 / 3});
+    x.zero_grad();
+
+    // d std / dx = (x - moyenne) / ((N - 1) std)
+    x.std({1}).backward();
+    const double s0 = std::sqrt(13.0 / 3), s1 = std::sqrt(28.0 / 3);
+    expect_values(x.grad(), {(1 - 8.0 / 3) / 2 / s0, (5 - 8.0 / 3) / 2 / s0, (2 - 8.0 / 3) / 2 / s0,
+                             (4 - 10.0 / 3) / 2 / s1, (0 - 10.0 / 3) / 2 / s1, (6 - 10.0 / 3) / 2 / s1});
+    x.zero_grad();
+
+    // d logsumexp / dx = softmax(x)
+    x.logsumexp({1}).backward();
+    const double z0 = std::exp(1.0) + std::exp(5.0) + std::exp(2.0);
+    const double z1 = std::exp(4.0) + std::exp(0.0) + std::exp(6.0);
+    expect_values(x.grad(), {std::exp(1.0) / z0, std::exp(5.0) / z0, std::exp(2.0) / z0,
+                             std::exp(4.0) / z1, std::exp(0.0) / z1, std::exp(6.0) / z1});
+}
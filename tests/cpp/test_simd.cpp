@@ -0,0 +1,196 @@
+#include <gtest/gtest.h>
+#include "napcas/cpu.h"
+#include "napcas/tensor.h"
+#include "napcas/kernels/elementwise_isa.h"
+#include <limits>
+
+using namespace napcas;
+using namespace napcas::kernels;
+
+namespace {
+const CpuCapability kLevels[] = {
+    CpuCapability::Scalar, CpuCapability::SSE2,
+    CpuCapability::AVX2,   CpuCapability::AVX512
+};
+
+struct RestoreCapability {
+    CpuCapability saved = cpu_capability();
+    ~RestoreCapability() { set_cpu_capability(saved); }
+};
+
+float ref_f(int op, float a, float b) {
+    switch (op) {
+        case 0: return a + b;
+        case 1: return a - b;
+        case 2: return a * b;
+        default: return a / b;
+    }
+}
+
+std::int32_t ref_i(int op, std::int32_t a, std::int32_t b) {
+    switch (op) {
+        case 0: return a + b;
+        case 1: return a - b;
+        case 2: return a * b;
+        default: return a / b;
+    }
+}
+}
+
+TEST(Simd, DetectionIsConsistent) {
+    RestoreCapability restore;
+    EXPECT_LE(cpu_capability(), detected_cpu_capability());
+    set_cpu_capability(CpuCapability::AVX512);
+    EXPECT_EQ(cpu_capability(), detected_cpu_capability());
+}
+
+TEST(Simd, Float32KernelsMatchReferenceAtEveryLevel) {
+    RestoreCapability restore;
+    for (CpuCapability level : kLevels) {
+        if (level > detected_cpu_capability()) continue;
+        set_cpu_capability(level);
+        const auto& k = binary_kernels().f32;
+        for (std::size_t n = 0; n < 70; ++n) {
+            std::vector<float> a(n), b(n), c(n);
+            for (std::size_t i = 0; i < n; ++i) {
+                a[i] = 0.5f * float(i) - 3.0f;
+                b[i] = 1.0f + 0.25f * float(i);
+            }
+            for (int op = 0; op < 4; ++op) {
+                k.vv[op](c.data(), a.data(), b.data(), n);
+                for (std::size_t i = 0; i < n; ++i)
+                    ASSERT_FLOAT_EQ(c[i], ref_f(op, a[i], b[i]))
+                        << cpu_capability_to_string(level) << " op " << op << " n " << n;
+                k.vs[op](c.data(), a.data(), 3.0f, n);
+                for (std::size_t i = 0; i < n; ++i)
+                    ASSERT_FLOAT_EQ(c[i], ref_f(op, a[i], 3.0f));
+                k.sv[op](c.data(), 3.0f, b.data(), n);
+                for (std::size_t i = 0; i < n; ++i)
+                    ASSERT_FLOAT_EQ(c[i], ref_f(op, 3.0f, b[i]));
+            }
+        }
+    }
+}
+
+TEST(Simd, Int32KernelsMatchReferenceAtEveryLevel) {
+    RestoreCapability restore;
+    for (CpuCapability level : kLevels) {
+        if (level > detected_cpu_capability()) continue;
+        set_cpu_capability(level);
+        const auto& k = binary_kernels().i32;
+        for (std::size_t n = 0; n < 40; ++n) {
+            std::vector<std::int32_t> a(n), b(n), c(n);
+            for (std::size_t i = 0; i < n; ++i) {
+                a[i] = std::int32_t(i) * 7 - 50;
+                b[i] = std::int32_t(i % 5) + 1;
+            }
+            for (int op = 0; op < 4; ++op) {
+                k.vv[op](c.data(), a.data(), b.data(), n);
+                for (std::size_t i = 0; i < n; ++i)
+                    ASSERT_EQ(c[i], ref_i(op, a[i], b[i]))
+                        << cpu_capability_to_string(level) << " op " << op;
+                k.vs[op](c.data(), a.data(), 3, n);
+                for (std::size_t i = 0; i < n; ++i)
+                    ASSERT_EQ(c[i], ref_i(op, a[i], 3));
+            }
+        }
+    }
+}
+
+TEST(Simd, Int32TensorAddUsesIntegerKernels) {
+    Tensor a({5}, std::vector<std::int32_t>{1, 2, 3, 4, 5}, DType::Int32);
+    Tensor b({5}, std::vector<std::int32_t>{10, 20, 30, 40, 50}, DType::Int32);
+    Tensor c = a + b;
+    EXPECT_EQ(c.data<std::int32_t>()[4], 55);
+}
+
+TEST(Simd, IntegerDivisionByZeroAndMinOverMinusOneAreDefined) {
+    RestoreCapability restore;
+    const std::int32_t kMin = std::numeric_limits<std::int32_t>::min();
+    for (CpuCapability level : kLevels) {
+        if (level > detected_cpu_capability()) continue;
+        set_cpu_capability(level);
+        const auto& k = binary_kernels().i32;
+        std::vector<std::int32_t> a = {7, -7, kMin, kMin, 0}, b = {0, 0, -1, 0, 0}, c(5);
+        k.vv[3](c.data(), a.data(), b.data(), a.size());
+        EXPECT_EQ(c, (std::vector<std::int32_t>{0, 0, kMin, 0, 0})) << cpu_capability_to_string(level);
+        k.vs[3](c.data(), a.data(), -1, a.size());
+        EXPECT_EQ(c, (std::vector<std::int32_t>{-7, 7, kMin, kMin, 0}));
+        k.sv[3](c.data(), kMin, b.data(), b.size());
+        EXPECT_EQ(c, (std::vector<std::int32_t>{0, 0, kMin, 0, 0}));
+    }
+
+    // Tous les types entiers, par l'opérateur de Tensor (diffusion comprise)
+    for (DType dt : {DType::Int8, DType::UInt8, DType::Int32, DType::Int64}) {
+        const bool is_signed = dt != DType::UInt8;
+        const double lo = dt == DType::Int8  ? -128.0
+                        : dt == DType::Int32 ? double(kMin)
+                        : dt == DType::Int64 ? -9223372036854775808.0 : 0.0;
+        Tensor a({3}, std::vector<double>{lo, 9.0, 6.0}, dt);
+        Tensor b({3}, std::vector<double>{is_signed ? -1.0 : 1.0, 0.0, 4.0}, dt);
+        Tensor c = (a / b).astype(DType::Float64);
+        EXPECT_EQ(c.data<double>()[0], lo) << dtype_to_string(dt);
+        EXPECT_EQ(c.data<double>()[1], 0.0) << dtype_to_string(dt);
+        EXPECT_EQ(c.data<double>()[2], 1.0) << dtype_to_string(dt);
+        Tensor z = (a / Tensor({}, std::vector<double>{0.0}, dt)).astype(DType::Float64);
+        for (std::size_t i = 0; i < 3; ++i) EXPECT_EQ(z.data<double>()[i], 0.0);
+    }
+}
+
+TEST(Simd, RowsMayWriteOverAnOperand) {
+    RestoreCapability restore;
+    for (CpuCapability level : kLevels) {
+        if (level > detected_cpu_capability()) continue;
+        set_cpu_capability(level);
+        const auto& f = binary_kernels().f32;
+        const auto& i = binary_kernels().i32;
+        const std::size_t n = 67;
+        for (int op = 0; op < 4; ++op) {
+            std::vector<float> a(n), b(n), ref(n);
+            std::vector<std::int32_t> ai(n), bi(n), refi(n);
+            for (std::size_t k = 0; k < n; ++k) {
+                a[k]  = 0.5f * float(k) - 3.0f;
+                b[k]  = 1.0f + 0.25f * float(k);
+                ai[k] = std::int32_t(k) - 30;
+                bi[k] = std::int32_t(k % 7) + 1;
+            }
+            f.vv[op](ref.data(), a.data(), b.data(), n);
+            std::vector<float> c = a;
+            f.vv[op](c.data(), c.data(), b.data(), n);
+            EXPECT_EQ(c, ref) << cpu_capability_to_string(level) << " op " << op;
+            c = b;
+            f.vv[op](c.data(), a.data(), c.data(), n);
+            EXPECT_EQ(c, ref);
+            f.vs[op](ref.data(), a.data(), 3.0f, n);
+            c = a;
+            f.vs[op](c.data(), c.data(), 3.0f, n);
+            EXPECT_EQ(c, ref);
+
+            i.vv[op](refi.data(), ai.data(), bi.data(), n);
+            std::vector<std::int32_t> ci = ai;
+            i.vv[op](ci.data(), ci.data(), bi.data(), n);
+            EXPECT_EQ(ci, refi);
+            i.sv[op](refi.data(), 5, bi.data(), n);
+            ci = bi;
+            i.sv[op](ci.data(), 5, ci.data(), n);
+            EXPECT_EQ(ci, refi);
+        }
+    }
+
+    // Boucles portables et blocs 16 bits, par add_ / mul_out en place
+    for (DType dt : {DType::Float64, DType::Float16, DType::BFloat16, DType::Int8,
+                     DType::UInt8, DType::Int64}) {
+        std::vector<double> va(300), vb(300);
+        for (std::size_t k = 0; k < 300; ++k) {
+            va[k] = double(k % 50);
+            vb[k] = double(k % 3 + 1);
+        }
+        Tensor a({300}, va, dt), b({300}, vb, dt);
+        const Tensor prod = (a + b) * b;
+        a.add_(b);
+        mul_out(a, a, b);
+        const Tensor x = a.astype(DType::Float64), y = prod.astype(DType::Float64);
+        for (std::size_t k = 0; k < 300; ++k)
+            ASSERT_EQ(x.data<double>()[k], y.data<double>()[k]) << dtype_to_string(dt) << " " << k;
+    }
+}
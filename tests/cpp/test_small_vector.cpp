@@ -0,0 +1,98 @@
+#include <gtest/gtest.h>
+#include "napcas/small_vector.h"
+#include "napcas/tensor.h"
+#include <utility>
+#include <vector>
+
+using namespace napcas;
+
+TEST(SmallVector, InlineUpToCapacity) {
+    Shape s{2, 3, 4};
+    EXPECT_TRUE(s.is_inline());
+    EXPECT_EQ(s.size(), 3u);
+    EXPECT_EQ(s, (std::vector<std::size_t>{2, 3, 4}));
+    for (std::size_t i = 3; i < kInlineDims; ++i) s.push_back(1);
+    EXPECT_TRUE(s.is_inline());
+    EXPECT_EQ(s.back(), 1u);
+}
+
+TEST(SmallVector, SpillsToHeapAndKeepsValues) {
+    Shape s;
+    for (std::size_t i = 0; i < 20; ++i) s.push_back(i);
+    EXPECT_FALSE(s.is_inline());
+    ASSERT_EQ(s.size(), 20u);
+    for (std::size_t i = 0; i < 20; ++i) EXPECT_EQ(s[i], i);
+    // push_back d'un élément du vecteur lui-même pendant la réallocation
+    Shape t(kInlineDims, 7);
+    t.push_back(t[0]);
+    EXPECT_EQ(t.back(), 7u);
+}
+
+TEST(SmallVector, CopyMoveAndCompare) {
+    for (std::size_t n : {std::size_t(3), std::size_t(10)}) {
+        Strides a(n, -2);
+        Strides b = a;
+        EXPECT_EQ(a, b);
+        Strides c = std::move(b);
+        EXPECT_EQ(c, a);
+        EXPECT_TRUE(b.empty());
+        b = c;
+        b[0] = 5;
+        EXPECT_NE(b, c);
+        c = std::move(b);
+        EXPECT_EQ(c[0], 5);
+        EXPECT_EQ(c.size(), n);
+    }
+}
+
+TEST(SmallVector, InsertEraseResize) {
+    Shape s{1, 2, 3};
+    s.insert(s.begin(), 9);
+    EXPECT_EQ(s, (std::vector<std::size_t>{9, 1, 2, 3}));
+    s.erase(s.begin() + 1);
+    EXPECT_EQ(s, (std::vector<std::size_t>{9, 2, 3}));
+    const std::vector<std::size_t> tail{4, 5, 6, 7, 8};
+    s.insert(s.end(), tail.begin(), tail.end());
+    EXPECT_EQ(s, (std::vector<std::size_t>{9, 2, 3, 4, 5, 6, 7, 8}));
+    s.resize(2);
+    EXPECT_EQ(s, (std::vector<std::size_t>{9, 2}));
+    s.resize(4, 1);
+    EXPECT_EQ(s, (std::vector<std::size_t>{9, 2, 1, 1}));
+    std::vector<std::size_t> v = s;
+    EXPECT_EQ(v, s);
+}
+
+TEST(SmallVector, TensorCachesGeometry) {
+    Tensor x = Tensor::zeros({2, 3, 4});
+    EXPECT_EQ(x.numel(), 24u);
+    EXPECT_TRUE(x.is_contiguous());
+    Tensor t = x.transpose(0, 2);
+    EXPECT_EQ(t.numel(), 24u);
+    EXPECT_FALSE(t.is_contiguous());
+    EXPECT_TRUE(t.contiguous().is_contiguous());
+    EXPECT_TRUE(x.view({6, 4}).is_contiguous());
+    EXPECT_FALSE(x.expand({5, 2, 3, 4}).is_contiguous());
+    EXPECT_EQ(x.expand({5, 2, 3, 4}).numel(), 120u);
+    EXPECT_EQ(x.sum().numel(), 1u);
+    EXPECT_EQ(Tensor::zeros({3, 0}).numel(), 0u);
+
+    // Copie et déplacement conservent le cache
+    Tensor c = t;
+    EXPECT_FALSE(c.is_contiguous());
+    Tensor m = std::move(c);
+    EXPECT_FALSE(m.is_contiguous());
+    m = x;
+    EXPECT_TRUE(m.is_contiguous());
+}
+
+TEST(SmallVector, TensorBeyondInlineRank) {
+    Shape shape(8, 2);
+    Tensor x = Tensor::ones(shape);
+    EXPECT_FALSE(x.shape().is_inline());
+    EXPECT_EQ(x.numel(), 256u);
+    EXPECT_TRUE(x.is_contiguous());
+    Tensor p = x.permute({7, 6, 5, 4, 3, 2, 1, 0});
+    EXPECT_FALSE(p.is_contiguous());
+    Tensor s = (p + x).sum();
+    EXPECT_FLOAT_EQ(s.data<float>()[0], 512.0f);
+}
@@ -0,0 +1,70 @@
+#include <gtest/gtest.h>
+#include "napcas/tensor.h"
+
+using namespace napcas;
+
+namespace {
+Tensor arange(const std::vector<std::size_t>& shape) {
+    std::size_t n = 1;
+    for (auto s : shape) n *= s;
+    std::vector<float> data(n);
+    for (std::size_t i = 0; i < n; ++i) data[i] = float(i);
+    return Tensor(shape, data);
+}
+}
+
+TEST(Storage, CopySharesBuffer) {
+    Tensor a = Tensor::ones({4, 4});
+    Tensor b = a;
+    EXPECT_EQ(a.storage().get(), b.storage().get());
+    Tensor c = a.clone();
+    EXPECT_NE(a.storage().get(), c.storage().get());
+}
+
+TEST(Storage, ShapeOpsAreZeroCopy) {
+    Tensor a = arange({2, 3, 4});
+    EXPECT_EQ(a.reshape({6, 4}).storage().get(),   a.storage().get());
+    EXPECT_EQ(a.view({24}).storage().get(),        a.storage().get());
+    EXPECT_EQ(a.permute({2, 0, 1}).storage().get(), a.storage().get());
+    EXPECT_EQ(a.transpose(0, 2).storage().get(),   a.storage().get());
+    EXPECT_EQ(a.unsqueeze(1).storage().get(),      a.storage().get());
+    EXPECT_EQ(a.unsqueeze(1).squeeze(1).storage().get(), a.storage().get());
+    EXPECT_EQ(a.contiguous().storage().get(),      a.storage().get());
+}
+
+TEST(Storage, ViewWritesAreVisible) {
+    Tensor a = arange({2, 3});
+    Tensor v = a.view({3, 2});
+    v.data<float>()[5] = 42.0f;
+    EXPECT_FLOAT_EQ(a.data<float>()[5], 42.0f);
+}
+
+TEST(Storage, PermuteThenContiguousReadsLogicalLayout) {
+    Tensor a = arange({2, 3});
+    Tensor t = a.transpose(0, 1);
+    EXPECT_FALSE(t.is_contiguous());
+    EXPECT_EQ(t.shape(), (std::vector<std::size_t>{3, 2}));
+    Tensor c = t.contiguous();
+    EXPECT_TRUE(c.is_contiguous());
+    EXPECT_NE(c.storage().get(), a.storage().get());
+    const float expected[] = {0, 3, 1, 4, 2, 5};
+    for (int i = 0; i < 6; ++i)
+        EXPECT_FLOAT_EQ(c.data<float>()[i], expected[i]);
+}
+
+TEST(Storage, ViewRejectsIncompatibleStrides) {
+    Tensor t = arange({2, 3}).transpose(0, 1);
+    EXPECT_THROW(t.view({6}), std::runtime_error);
+    Tensor r = t.reshape({6});
+    EXPECT_NE(r.storage().get(), t.storage().get());
+    EXPECT_FLOAT_EQ(r.data<float>()[1], 3.0f);
+}
+
+TEST(Storage, AsStridedOffset) {
+    Tensor a = arange({4, 4});
+    Tensor row = a.as_strided({4}, {1}, 8);
+    EXPECT_EQ(row.storage_offset(), 8u);
+    EXPECT_FLOAT_EQ(row.data<float>()[0], 8.0f);
+    Tensor col = a.as_strided({4}, {4}, 1).clone();
+    EXPECT_FLOAT_EQ(col.data<float>()[3], 13.0f);
+}
@@ -0,0 +1,41 @@
+import numpy as np
+
+import napcas
+
+
+def _rand(*shape):
+    return np.random.default_rng(1).standard_normal(shape).astype(np.float32)
+
+
+def test_softmax_matches_numpy_on_any_dim():
+    arr = _rand(3, 4, 5)
+    t = napcas.Tensor.from_numpy(arr)
+    for dim in (0, 1, -1):
+        e = np.exp(arr - arr.max(dim, keepdims=True))
+        np.testing.assert_allclose(t.softmax(dim).numpy(), e / e.sum(dim, keepdims=True),
+                                   rtol=1e-5, atol=1e-7)
+    np.testing.assert_allclose(np.exp(t.log_softmax().numpy()), t.softmax().numpy(), rtol=1e-5)
+
+
+def test_layer_norm_and_grad_of_parameters():
+    arr = _rand(8, 16)
+    t = napcas.Tensor.from_numpy(arr)
+    w = napcas.Tensor.ones([16])
+    b = napcas.Tensor.zeros([16])
+    w.requires_grad_(True)
+    b.requires_grad_(True)
+    y = t.layer_norm(w, b)
+    mu = arr.mean(-1, keepdims=True)
+    ref = (arr - mu) / np.sqrt(arr.var(-1, keepdims=True) + 1e-5)
+    np.testing.assert_allclose(y.numpy(), ref, rtol=1e-4, atol=1e-5)
+    y.sum().backward()
+    np.testing.assert_allclose(b.grad().numpy(), np.full(16, 8.0), rtol=1e-6)
+    np.testing.assert_allclose(w.grad().numpy(), ref.sum(0), rtol=1e-4, atol=1e-4)
+
+
+def test_activations():
+    arr = _rand(100)
+    t = napcas.Tensor.from_numpy(arr)
+    np.testing.assert_array_equal(t.relu().numpy(), np.maximum(arr, 0))
+    np.testing.assert_allclose(t.silu().numpy(), arr / (1 + np.exp(-arr)), rtol=1e-5, atol=1e-7)
+    assert t.rms_norm().shape() == [100]
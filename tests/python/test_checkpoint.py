@@ -0,0 +1,23 @@
+import numpy as np
+
+import napcas
+from napcas import architecture
+
+
+def test_checkpoint_round_trip(tmp_path):
+    a = np.arange(12, dtype=np.float32).reshape(3, 4)
+    path = str(tmp_path / "t.ckpt")
+    napcas.save_checkpoint(path, {"a": napcas.Tensor.from_numpy(a),
+                                  "at": napcas.Tensor.from_numpy(a).transpose(0, 1)})
+    loaded = napcas.load_checkpoint(path)
+    np.testing.assert_array_equal(loaded["a"].numpy(), a)
+    np.testing.assert_array_equal(loaded["at"].numpy(), a.T)
+
+
+def test_module_save_load(tmp_path):
+    path = str(tmp_path / "linear.ckpt")
+    src, dst = architecture.Linear(8, 4), architecture.Linear(8, 4)
+    src.save(path)
+    dst.load(path)
+    np.testing.assert_array_equal(dst.weight.numpy(), src.weight.numpy())
+    np.testing.assert_array_equal(dst.bias.numpy(), src.bias.numpy())
@@ -0,0 +1,59 @@
+import numpy as np
+
+import napcas
+from napcas import architecture
+
+
+def _rand(*shape, seed=0):
+    return np.random.default_rng(seed).standard_normal(shape).astype(np.float32)
+
+
+def _conv_reference(x, w, b, stride, padding):
+    n, c, h, wd = x.shape
+    k, _, r, s = w.shape
+    xp = np.pad(x, ((0, 0), (0, 0), (padding, padding), (padding, padding)))
+    oh, ow = (h + 2 * padding - r) // stride + 1, (wd + 2 * padding - s) // stride + 1
+    y = np.empty((n, k, oh, ow), dtype=np.float64)
+    for i in range(oh):
+        for j in range(ow):
+            patch = xp[:, :, i * stride:i * stride + r, j * stride:j * stride + s]
+            y[:, :, i, j] = np.einsum("ncrs,kcrs->nk", patch, w) + b
+    return y
+
+
+def test_conv2d_matches_numpy_for_each_algorithm():
+    x, w, b = _rand(2, 16, 9, 7), _rand(16, 16, 3, 3, seed=1), _rand(16, seed=2)
+    expected = _conv_reference(x, w, b, 1, 1)
+    for algo in (napcas.ConvAlgorithm.Auto, napcas.ConvAlgorithm.Im2col,
+                 napcas.ConvAlgorithm.Winograd):
+        y = architecture.conv2d(napcas.Tensor.from_numpy(x), napcas.Tensor.from_numpy(w),
+                                napcas.Tensor.from_numpy(b), stride=1, padding=(1, 1),
+                                algorithm=algo)
+        np.testing.assert_allclose(y.numpy(), expected, rtol=1e-4, atol=1e-4)
+
+
+def test_conv2d_module_backward_and_channels_last():
+    conv = architecture.Conv2d(4, 8, 3, stride=2, padding=1)
+    assert conv.weight.shape() == [8, 4, 3, 3]
+    assert conv.kernel_size == [3, 3]
+    x = napcas.Tensor.from_numpy(_rand(2, 4, 8, 8))
+    conv(x).sum().backward()
+    assert conv.weight.grad().shape() == [8, 4, 3, 3]
+    assert conv.bias.grad().shape() == [8]
+
+    xl = architecture.to_channels_last(x)
+    assert architecture.is_channels_last(xl)
+    y = conv(xl)
+    assert architecture.is_channels_last(y)
+    np.testing.assert_allclose(y.numpy(), conv(x).numpy(), rtol=1e-5, atol=1e-5)
+
+
+def test_pooling_matches_numpy():
+    x = _rand(2, 3, 6, 6)
+    t = napcas.Tensor.from_numpy(x)
+    windows = x.reshape(2, 3, 3, 2, 3, 2)
+    np.testing.assert_allclose(architecture.max_pool2d(t, 2).numpy(), windows.max(axis=(3, 5)))
+    np.testing.assert_allclose(architecture.avg_pool2d(t, (2, 2)).numpy(),
+                               windows.mean(axis=(3, 5)), rtol=1e-6)
+    assert architecture.MaxPool2d(3, stride=1, padding=1)(t).shape() == [2, 3, 6, 6]
+    assert architecture.AvgPool2d(2)(t).shape() == [2, 3, 3, 3]
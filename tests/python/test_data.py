@@ -0,0 +1,69 @@
+import numpy as np
+import pytest
+
+import napcas
+from napcas import data
+
+_RECORD = np.dtype([("label", "<i8"), ("x", "<f4", (3,))])
+
+
+def _dataset(tmp_path, n, mode=data.ReadMode.Mmap):
+    rec = np.zeros(n, dtype=_RECORD)
+    rec["label"] = np.arange(n)
+    rec["x"] = np.arange(n, dtype=np.float32)[:, None] * np.array([1, 1, -1], np.float32)
+    rec["x"][:, 1] += 0.5
+    path = tmp_path / "records.bin"
+    rec.tofile(path)
+    fields = [data.Field("label", napcas.DType.Int64), data.Field("x", napcas.DType.Float32, [3])]
+    return data.RecordDataset([str(path)], fields, mode=mode)
+
+
+def _check(label, x):
+    lab = label.numpy()
+    ref = lab.astype(np.float32)[:, None] * np.array([1, 1, -1], np.float32)
+    ref[:, 1] += 0.5
+    np.testing.assert_array_equal(x.numpy(), ref)
+    return lab.tolist()
+
+
+@pytest.mark.parametrize("mode", [data.ReadMode.Mmap, data.ReadMode.Pread])
+def test_epoch_is_a_seeded_permutation(tmp_path, mode):
+    ds = _dataset(tmp_path, 50, mode)
+    assert len(ds) == 50 and ds.record_bytes == 20
+    loader = data.DataLoader(ds, batch_size=8, seed=3, num_workers=2, prefetch=2)
+    assert len(loader) == 7
+    first = [l for label, x in loader for l in _check(label, x)]
+    assert sorted(first) == list(range(50)) and first != list(range(50))
+    again = [l for label, x in data.DataLoader(ds, batch_size=8, seed=3) for l in _check(label, x)]
+    assert again == first
+    second = [l for label, _ in loader for l in label.numpy().tolist()]
+    assert loader.epoch == 1 and second != first
+
+
+def test_sequential_batches_and_drop_last(tmp_path):
+    ds = _dataset(tmp_path, 23)
+    sizes = [label.shape[0] for label, _ in data.DataLoader(ds, batch_size=5, shuffle=False)]
+    assert sizes == [5, 5, 5, 5, 3]
+    loader = data.DataLoader(ds, batch_size=5, shuffle=False, drop_last=True)
+    assert [label.shape[0] for label, _ in loader] == [5, 5, 5, 5]
+
+
+def test_held_batches_stay_valid_and_stats(tmp_path):
+    ds = _dataset(tmp_path, 40)
+    loader = data.DataLoader(ds, batch_size=4, prefetch=1)
+    held = list(loader)
+    assert len(held) == 10
+    assert sorted(l for label, x in held for l in _check(label, x)) == list(range(40))
+    stats = loader.stats()
+    assert stats.batches == 10 and stats.samples == 40 and stats.bytes == 40 * 20
+    assert 0 <= stats.stall_ns <= stats.elapsed_ns
+    assert stats.ring_size >= 10
+    loader.reset_stats()
+    assert loader.stats().batches == 0
+
+
+def test_rejects_malformed_files(tmp_path):
+    path = tmp_path / "bad.bin"
+    path.write_bytes(b"\0" * 21)
+    with pytest.raises(RuntimeError):
+        data.RecordDataset([str(path)], [data.Field("x", napcas.DType.Float32, [5])])
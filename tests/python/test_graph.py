@@ -0,0 +1,22 @@
+import numpy as np
+
+import napcas
+from napcas import architecture
+
+
+def test_graph_replay_matches_eager():
+    fc = architecture.Linear(8, 4, activation=napcas.Activation.ReLU)
+    x = np.random.default_rng(0).standard_normal((3, 8)).astype(np.float32)
+    g = napcas.Graph.capture(fc, napcas.Tensor.from_numpy(x))
+    assert g.ops == ["linear"]
+    x2 = np.random.default_rng(1).standard_normal((3, 8)).astype(np.float32)
+    y = g.replay([napcas.Tensor.from_numpy(x2)])[0]
+    np.testing.assert_allclose(y.numpy(), fc(napcas.Tensor.from_numpy(x2)).numpy(), rtol=1e-6)
+
+
+def test_graph_capture_python_function():
+    w = napcas.Tensor.ones([4])
+    g = napcas.Graph.capture(lambda ins: (ins[0] * w + ins[0]).softmax(), [napcas.Tensor.zeros([2, 4])])
+    assert g.ops == ["mul", "add", "softmax"]
+    out = g.replay([napcas.Tensor.ones([2, 4])])[0]
+    np.testing.assert_allclose(out.numpy(), np.full((2, 4), 0.25, np.float32), rtol=1e-6)
@@ -0,0 +1,38 @@
+import numpy as np
+import pytest
+
+import napcas
+
+
+def _t(values):
+    return napcas.Tensor.from_numpy(np.asarray(values, dtype=np.float32))
+
+
+def test_iadd_keeps_object_and_storage():
+    a = _t([[1, 2], [3, 4]])
+    same = a
+    version = a._version
+    a += _t([10, 20])
+    a *= _t([[2], [1]])
+    assert a is same
+    assert a._version == version + 2
+    np.testing.assert_array_equal(a.numpy(), [[22, 44], [13, 24]])
+
+
+def test_out_variant_writes_into_buffer():
+    a, b = _t([1, 2, 3]), _t([4, 5, 6])
+    out = napcas.Tensor.zeros([3])
+    view = out.numpy()
+    assert napcas.add(a, b, out=out) is out
+    np.testing.assert_array_equal(view, [5, 7, 9])
+    np.testing.assert_array_equal(napcas.mul(a, b).numpy(), [4, 10, 18])
+
+
+def test_modified_saved_tensor_is_detected():
+    x = _t([1, 2])
+    x.requires_grad_(True)
+    y = x.exp()
+    loss = y.sum()
+    y.detach().add_(_t([1, 1]))
+    with pytest.raises(RuntimeError):
+        loss.backward()
@@ -0,0 +1,17 @@
+import napcas
+
+
+def test_lazy_chain_matches_eager():
+    a = napcas.Tensor.ones([64, 32])
+    b = napcas.Tensor.ones([32])
+    c = napcas.Tensor.ones([64, 1])
+    eager = (a + b) * c - a
+    fused = ((a.lazy() + b) * c - a).eval()
+    assert fused.shape() == eager.shape() == [64, 32]
+    assert fused.dtype() == eager.dtype()
+
+
+def test_lazy_python_scalars():
+    a = napcas.Tensor.ones([8], napcas.DType.Int32)
+    assert (a.lazy() * 2 + 1).eval().dtype() == napcas.DType.Int32
+    assert (1.0 - a.lazy() / 2.0).eval().dtype() == napcas.DType.Float32
@@ -0,0 +1,27 @@
+import numpy as np
+
+import napcas
+from napcas import architecture
+
+
+def _rand(*shape, seed=0):
+    return np.random.default_rng(seed).standard_normal(shape).astype(np.float32)
+
+
+def test_fused_linear_relu_matches_numpy():
+    x, w, b = _rand(16, 8), _rand(4, 8, seed=1), _rand(4, seed=2)
+    y = architecture.linear(napcas.Tensor.from_numpy(x), napcas.Tensor.from_numpy(w),
+                            napcas.Tensor.from_numpy(b), napcas.Activation.ReLU)
+    np.testing.assert_allclose(y.numpy(), np.maximum(x @ w.T + b, 0), rtol=1e-5, atol=1e-5)
+
+
+def test_linear_module_backward_and_state_dict():
+    fc = architecture.Linear(8, 4, activation=napcas.Activation.GELU)
+    x = napcas.Tensor.from_numpy(_rand(5, 8))
+    fc(x).sum().backward()
+    assert fc.weight.grad().shape() == [4, 8]
+    assert fc.bias.grad().shape() == [4]
+
+    other = architecture.Linear(8, 4)
+    other.load_state_dict(fc.state_dict())
+    np.testing.assert_array_equal(other.weight.numpy(), fc.weight.numpy())
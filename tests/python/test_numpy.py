@@ -0,0 +1,56 @@
+import numpy as np
+
+import napcas
+
+
+def test_from_numpy_shares_memory():
+    arr = np.arange(12, dtype=np.float32).reshape(3, 4)
+    t = napcas.Tensor.from_numpy(arr)
+    assert t.shape() == [3, 4]
+    assert t.dtype() == napcas.DType.Float32
+    arr[1, 2] = -5.0
+    assert t.numpy()[1, 2] == -5.0
+
+
+def test_numpy_is_a_view_that_outlives_the_tensor():
+    view = napcas.Tensor.ones([2, 3], napcas.DType.Int64).numpy()
+    assert view.dtype == np.int64
+    assert view.sum() == 6
+
+
+def test_buffer_and_array_interface_for_strided_views():
+    arr = np.arange(6, dtype=np.float64).reshape(2, 3)
+    t = napcas.Tensor.from_numpy(arr).transpose(0, 1)
+    np.testing.assert_array_equal(np.asarray(t), arr.T)
+    np.testing.assert_array_equal(np.asarray(memoryview(t)), arr.T)
+
+
+def test_non_native_input_is_copied():
+    arr = np.arange(4, dtype=">i4")[::-1]
+    t = napcas.Tensor.from_numpy(arr)
+    np.testing.assert_array_equal(t.numpy(), [3, 2, 1, 0])
+
+
+
+def test_read_only_input_is_copied():
+    raw = np.arange(4, dtype=np.float32).tobytes()
+    arr = np.frombuffer(raw, dtype=np.float32)
+    assert not arr.flags.writeable
+    t = napcas.Tensor.from_numpy(arr)
+    t.add_(napcas.Tensor.from_numpy(np.ones(4, dtype=np.float32)))
+    np.testing.assert_array_equal(t.numpy(), [1, 2, 3, 4])
+    np.testing.assert_array_equal(arr, [0, 1, 2, 3])
+
+    # Vue en lecture seule d'un tableau inscriptible : copiée elle aussi
+    base = np.zeros(3, dtype=np.int32)
+    view = base.view()
+    view.flags.writeable = False
+    napcas.Tensor.from_numpy(view).add_(napcas.Tensor.from_numpy(np.ones(3, dtype=np.int32)))
+    np.testing.assert_array_equal(base, [0, 0, 0])
+
+
+def test_dlpack_roundtrip():
+    t = napcas.Tensor.from_numpy(np.arange(8, dtype=np.int32))
+    back = napcas.from_dlpack(t)
+    np.testing.assert_array_equal(back.numpy(), np.arange(8))
+    np.testing.assert_array_equal(np.from_dlpack(t), np.arange(8))
@@ -0,0 +1,70 @@
+import numpy as np
+
+import napcas
+from napcas import architecture, optim
+
+
+def _rand(*shape, seed=0):
+    return np.random.default_rng(seed).standard_normal(shape).astype(np.float32)
+
+
+def _regression(seed=0):
+    x = _rand(64, 4, seed=seed)
+    y = (x @ np.array([[2.0], [-1.0], [0.0], [0.5]], dtype=np.float32) + 1.0).astype(np.float32)
+    return napcas.Tensor.from_numpy(x), napcas.Tensor.from_numpy(y)
+
+
+def _mse(fc, x, y):
+    d = fc(x) - y
+    return (d * d).mean()
+
+
+def test_adam_matches_numpy_reference():
+    fc = architecture.Linear(4, 3)
+    opt = optim.Adam(fc.parameters(), lr=0.01, weight_decay=0.1)
+    w = fc.weight.numpy().astype(np.float64)
+    m, v = np.zeros_like(w), np.zeros_like(w)
+    x = napcas.Tensor.from_numpy(_rand(5, 4))
+    for t in range(1, 4):
+        opt.zero_grad()
+        fc(x).sum().backward()
+        g = fc.weight.grad().numpy() + 0.1 * w
+        m = 0.9 * m + 0.1 * g
+        v = 0.999 * v + 0.001 * g * g
+        w -= 0.01 * (m / (1 - 0.9 ** t)) / (np.sqrt(v / (1 - 0.999 ** t)) + 1e-8)
+        opt.step()
+    np.testing.assert_allclose(fc.weight.numpy(), w, rtol=1e-5, atol=1e-6)
+    np.testing.assert_allclose(opt.exp_avg(0).numpy(), m, rtol=1e-5, atol=1e-6)
+    assert opt.steps == 3
+
+
+def test_optimizers_train_a_linear_regression():
+    x, y = _regression()
+    for make in (lambda p: optim.SGD(p, lr=0.05, momentum=0.9, nesterov=True),
+                 lambda p: optim.Adam(p, lr=0.05),
+                 lambda p: optim.AdamW(p, lr=0.05, weight_decay=0.0, max_grad_norm=1.0)):
+        fc = architecture.Linear(4, 1)
+        opt = make(fc.parameters())
+        first = float(_mse(fc, x, y).numpy())
+        for _ in range(300):
+            opt.zero_grad()
+            _mse(fc, x, y).backward()
+            opt.step()
+        assert float(_mse(fc, x, y).numpy()) < first * 1e-3
+
+
+def test_zero_grad_in_place_and_clipping():
+    fc = architecture.Linear(8, 2)
+    opt = optim.SGD(fc.parameters(), lr=1.0, max_grad_norm=1e-3)
+    x = napcas.Tensor.from_numpy(_rand(3, 8))
+    fc(x).sum().backward()
+    grads = [p.grad().numpy() for p in opt.parameters()]
+    before = fc.weight.numpy()
+    norm = opt.step()
+    assert np.isclose(norm, np.sqrt(sum((g.astype(np.float64) ** 2).sum() for g in grads)))
+    assert np.linalg.norm(fc.weight.numpy() - before) <= 1e-3 * 1.001
+
+    opt.zero_grad()
+    assert np.all(fc.weight.grad().numpy() == 0)
+    opt.lr = 0.5
+    assert opt.lr == 0.5
@@ -0,0 +1,52 @@
+import json
+
+import numpy as np
+
+import napcas
+from napcas import architecture, profiler
+
+
+def _rand(*shape, seed=0):
+    return np.random.default_rng(seed).standard_normal(shape).astype(np.float32)
+
+
+def test_profile_records_ops_modules_and_backward():
+    fc = architecture.Linear(16, 8)
+    x = napcas.Tensor.from_numpy(_rand(4, 16))
+    x.requires_grad_(True)
+    with profiler.profile() as prof:
+        fc(x).sum().backward()
+    assert not profiler.enabled()
+
+    kinds = {(e.name, e.kind) for e in prof.events}
+    assert ("Linear", profiler.EventKind.Module) in kinds
+    assert ("linear", profiler.EventKind.Op) in kinds
+    assert any(k == profiler.EventKind.Backward for _, k in kinds)
+
+    op = next(e for e in prof.events if e.name == "linear")
+    assert op.input_shapes[0] == [4, 16]
+    assert op.flops == 2 * 4 * 8 * 16
+    stats = prof.summary()
+    assert [s.self_ns for s in stats] == sorted((s.self_ns for s in stats), reverse=True)
+    assert "linear" in prof.table(max_rows=10)
+
+
+def test_chrome_trace_export(tmp_path):
+    a = napcas.Tensor.from_numpy(_rand(8, 8))
+    with profiler.profile() as prof:
+        a.matmul(a)
+    path = tmp_path / "trace.json"
+    prof.export_chrome_trace(str(path))
+    trace = json.loads(path.read_text())
+    names = {e["name"] for e in trace["traceEvents"]}
+    assert "matmul" in names
+    mm = next(e for e in trace["traceEvents"] if e["name"] == "matmul")
+    assert mm["ph"] == "X" and mm["args"]["flops"] == 2 * 8 * 8 * 8
+
+
+def test_disabled_outside_profile():
+    a = napcas.Tensor.from_numpy(_rand(4, 4))
+    with profiler.profile() as prof:
+        pass
+    a + a
+    assert prof.events == []
@@ -0,0 +1,39 @@
+import numpy as np
+
+import napcas
+from napcas import architecture
+
+
+def _rand(*shape, seed=0):
+    return np.random.default_rng(seed).standard_normal(shape).astype(np.float32)
+
+
+def _relative_error(a, b):
+    return np.linalg.norm(a - b) / np.linalg.norm(b)
+
+
+def test_quantized_linear_close_to_float():
+    fc = architecture.Linear(128, 64)
+    qfc = architecture.QuantizedLinear(fc)
+    assert qfc.in_features == 128 and qfc.out_features == 64
+    assert architecture.QuantizedLinear.kernel in ("avx512_vnni", "avx2", "scalar")
+
+    w = fc.weight.numpy()
+    dq = qfc.dequantized_weight().numpy()
+    scales = np.abs(w).max(axis=1, keepdims=True) / 127
+    assert np.all(np.abs(dq - w) <= 0.5 * scales * 1.001)
+
+    x = napcas.Tensor.from_numpy(_rand(16, 128))
+    y = qfc(x).numpy()
+    assert y.shape == (16, 64)
+    assert _relative_error(y, fc(x).numpy()) < 0.03
+
+
+def test_quantized_linear_fused_relu_and_batched_input():
+    fc = architecture.Linear(32, 16, activation=napcas.Activation.ReLU)
+    qfc = architecture.QuantizedLinear(fc)
+    x = napcas.Tensor.from_numpy(_rand(2, 5, 32, seed=1))
+    y = qfc(x).numpy()
+    assert y.shape == (2, 5, 16)
+    assert (y >= 0).all()
+    np.testing.assert_allclose(y, fc(x).numpy(), atol=0.05)
@@ -0,0 +1,38 @@
+import numpy as np
+
+import napcas
+
+
+def _rand(*shape):
+    return np.random.default_rng(0).standard_normal(shape).astype(np.float32)
+
+
+def test_reductions_match_numpy():
+    arr = _rand(4, 5, 6)
+    t = napcas.Tensor.from_numpy(arr)
+    np.testing.assert_allclose(t.sum().numpy(), arr.sum(), rtol=1e-5)
+    np.testing.assert_allclose(t.sum(1).numpy(), arr.sum(1), rtol=1e-5, atol=1e-6)
+    np.testing.assert_allclose(t.mean([0, 2], keepdim=True).numpy(),
+                               arr.mean((0, 2), keepdims=True), rtol=1e-5, atol=1e-6)
+    np.testing.assert_array_equal(t.max(-1).numpy(), arr.max(-1))
+    np.testing.assert_array_equal(t.min(0).numpy(), arr.min(0))
+    np.testing.assert_array_equal(t.argmax(2).numpy(), arr.argmax(2))
+    np.testing.assert_allclose(t.var(1).numpy(), arr.var(1, ddof=1), rtol=1e-5)
+    np.testing.assert_allclose(t.std(1, correction=0).numpy(), arr.std(1), rtol=1e-5)
+
+
+def test_reductions_on_transposed_view():
+    arr = _rand(64, 48)
+    t = napcas.Tensor.from_numpy(arr).transpose(0, 1)
+    np.testing.assert_allclose(t.sum(0).numpy(), arr.T.sum(0), rtol=1e-5, atol=1e-5)
+    np.testing.assert_array_equal(t.argmin(1).numpy(), arr.T.argmin(1))
+
+
+def test_logsumexp_is_stable_and_differentiable():
+    arr = np.array([[1000.0, 1000.0], [0.0, np.log(3.0)]], dtype=np.float32)
+    t = napcas.Tensor.from_numpy(arr.copy())
+    t.requires_grad_(True)
+    lse = t.logsumexp(1)
+    np.testing.assert_allclose(lse.numpy(), [1000.0 + np.log(2.0), np.log(4.0)], rtol=1e-6)
+    lse.backward()
+    np.testing.assert_allclose(t.grad().numpy(), [[0.5, 0.5], [0.25, 0.75]], rtol=1e-6)
@@ -0,0 +1,73 @@
+import napcas
+
+
+def test_set_num_threads_roundtrip():
+    saved = napcas.get_num_threads()
+    try:
+        napcas.set_num_threads(3)
+        assert napcas.get_num_threads() == 3
+        a = napcas.Tensor.ones([512, 512])
+        b = napcas.Tensor.ones([512, 512])
+        c = a + b
+        assert c.shape() == [512, 512]
+    finally:
+        napcas.set_num_threads(saved)
+
+
+def _matmul_worker(a, b, iters):
+    for _ in range(iters):
+        a.matmul(b)
+
+
+def _run_threads(n_threads, a, b, iters):
+    import threading
+    import time
+
+    threads = [threading.Thread(target=_matmul_worker, args=(a, b, iters))
+               for _ in range(n_threads)]
+    start = time.perf_counter()
+    for t in threads:
+        t.start()
+    for t in threads:
+        t.join()
+    return time.perf_counter() - start
+
+
+def test_concurrent_python_threads_scale():
+    # Le GIL est relâché pendant matmul : N threads Python indépendants
+    # doivent s'exécuter en parallèle (pool interne limité à 1 thread)
+    import os
+
+    n = min(4, os.cpu_count() or 1)
+    saved = napcas.get_num_threads()
+    try:
+        napcas.set_num_threads(1)
+        a = napcas.Tensor.ones([192, 192])
+        b = napcas.Tensor.ones([192, 192])
+        iters = 20
+        _run_threads(1, a, b, 2)   # échauffement (allocateur, dispatch)
+        t1 = _run_threads(1, a, b, iters * n)
+        tn = _run_threads(n, a, b, iters)
+        if n >= 2:
+            assert t1 / tn > 0.6 * n, f"speedup {t1 / tn:.2f} with {n} threads"
+    finally:
+        napcas.set_num_threads(saved)
+
+
+def test_concurrent_backward_on_shared_weight():
+    import threading
+
+    w = napcas.Tensor.ones([8, 8])
+    w.requires_grad_(True)
+
+    def work():
+        for _ in range(20):
+            x = napcas.Tensor.ones([4, 8])
+            x.matmul(w).backward()
+
+    threads = [threading.Thread(target=work) for _ in range(4)]
+    for t in threads:
+        t.start()
+    for t in threads:
+        t.join()
+    assert w.grad().numpy().sum() == 4 * 20 * 4 * 64